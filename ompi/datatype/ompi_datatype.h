@@ -60,7 +60,7 @@ BEGIN_C_DECLS
 #define OMPI_DATATYPE_FLAG_DATA_FORTRAN  0xC000
 #define OMPI_DATATYPE_FLAG_DATA_LANGUAGE 0xC000
 
-#define OMPI_DATATYPE_MAX_PREDEFINED 52
+#define OMPI_DATATYPE_MAX_PREDEFINED 53
 
 #if OMPI_DATATYPE_MAX_PREDEFINED > OPAL_DATATYPE_MAX_SUPPORTED
 #error Need to increase the number of supported dataypes by OPAL (value OPAL_DATATYPE_MAX_SUPPORTED).
@@ -71,7 +71,7 @@ BEGIN_C_DECLS
  */
 struct ompi_datatype_t {
     opal_datatype_t    super;                    /**< Base opal_datatype_t superclass */
-    /* --- cacheline 5 boundary (320 bytes) was 32 bytes ago --- */
+    /* --- cacheline 6 boundary (384 bytes) was 16 bytes ago --- */
 
     int32_t            id;                       /**< OMPI-layers unique id of the type */
     int32_t            d_f_to_c_index;           /**< Fortran index for this datatype */
@@ -80,11 +80,9 @@ struct ompi_datatype_t {
     void*              args;                     /**< Data description for the user */
     opal_atomic_intptr_t packed_description;     /**< Packed description of the datatype */
     uint64_t           pml_data;                 /**< PML-specific information */
-    /* --- cacheline 6 boundary (384 bytes) --- */
     char               name[MPI_MAX_OBJECT_NAME];/**< Externally visible name */
-    /* --- cacheline 7 boundary (448 bytes) --- */
 
-    /* size: 448, cachelines: 7, members: 7 */
+    /* size: 504, cachelines: 8, members: 7 */
 };
 
 typedef struct ompi_datatype_t ompi_datatype_t;
@@ -115,8 +115,14 @@
 #define OMPI_DATATYPE_MPI_LONG                    0x32
 #define OMPI_DATATYPE_MPI_UNSIGNED_LONG           0x33
 
+/*
+ * Brain floating point (8-bit exponent, 7-bit mantissa), provided
+ * by the bfloat16 extension.
+ */
+#define OMPI_DATATYPE_MPI_BFLOAT16                0x34
+
 /* This should __ALWAYS__ stay last  */
-#define OMPI_DATATYPE_MPI_UNAVAILABLE             0x34
+#define OMPI_DATATYPE_MPI_UNAVAILABLE             0x35
 
 
 #define OMPI_DATATYPE_MPI_MAX_PREDEFINED          (OMPI_DATATYPE_MPI_UNAVAILABLE+1)
@@ -597,6 +603,10 @@ extern const ompi_datatype_t* ompi_datatype_basicDatatypes[OMPI_DATATYPE_MPI_MAX
 
 #define OMPI_DATATYPE_INITIALIZER_PACKED              OPAL_DATATYPE_INITIALIZER_UINT1
 
+/* OPAL has no bfloat16 basic type; the data only needs to be moved (and
+ * byte swapped) as a 2-byte entity, the ops interpret it. */
+#define OMPI_DATATYPE_INITIALIZER_BFLOAT16            OPAL_DATATYPE_INITIALIZER_UINT2
+
 #define OMPI_DATATYPE_INITIALIZER_BOOL                OPAL_DATATYPE_INITIALIZER_BOOL
 
 #define OMPI_DATATYPE_INITIALIZER_WCHAR               OPAL_DATATYPE_INITIALIZER_WCHAR
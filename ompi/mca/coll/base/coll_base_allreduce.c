@@ -43,6 +43,35 @@
 #include "coll_base_topo.h"
 #include "coll_base_util.h"
 
+/*
+ * fp32 accumulation for reduced-precision types (see
+ * ompi_coll_base_reduce_use_fp32): the algorithms below run in place on a
+ * widened copy of the input, and the result is narrowed into rbuf once at
+ * the end, so that rounding happens once instead of at every step.
+ */
+static float *
+allreduce_fp32_widen(const void *sbuf, void *rbuf, size_t count,
+                     struct ompi_datatype_t *dtype)
+{
+    float *fbuf = (float*)malloc(count * sizeof(float));
+    if (NULL != fbuf) {
+        ompi_coll_base_reduce_widen_fp32(fbuf, (MPI_IN_PLACE == sbuf) ? rbuf : sbuf,
+                                         count, dtype);
+    }
+    return fbuf;
+}
+
+static int
+allreduce_fp32_narrow(int ret, float *fbuf, void *rbuf, size_t count,
+                      struct ompi_datatype_t *dtype)
+{
+    if (MPI_SUCCESS == ret) {
+        ompi_coll_base_reduce_narrow_fp32(rbuf, fbuf, count, dtype);
+    }
+    free(fbuf);
+    return ret;
+}
+
 /*
  * ompi_coll_base_allreduce_intra_nonoverlapping
  *
@@ -362,6 +391,14 @@ ompi_coll_base_allreduce_intra_ring(const void *sbuf, void *rbuf, size_t count,
     OPAL_OUTPUT((ompi_coll_base_framework.framework_output,
                  "coll:base:allreduce_intra_ring rank %d, count %zu", rank, count));
 
+    if (ompi_coll_base_reduce_use_fp32(dtype, op)) {
+        float *fbuf = allreduce_fp32_widen(sbuf, rbuf, count, dtype);
+        if (NULL == fbuf) { return OMPI_ERR_OUT_OF_RESOURCE; }
+        return allreduce_fp32_narrow(ompi_coll_base_allreduce_intra_ring(MPI_IN_PLACE, fbuf, count,
+                                                                        &ompi_mpi_float.dt, op,
+                                                                        comm, module), fbuf, rbuf, count, dtype);
+    }
+
     /* Special case for size == 1 */
     if (1 == size) {
         if (MPI_IN_PLACE != sbuf) {
@@ -641,6 +678,14 @@ ompi_coll_base_allreduce_intra_ring_segmented(const void *sbuf, void *rbuf, size
     OPAL_OUTPUT((ompi_coll_base_framework.framework_output,
                  "coll:base:allreduce_intra_ring_segmented rank %d, count %zu", rank, count));
 
+    if (ompi_coll_base_reduce_use_fp32(dtype, op)) {
+        float *fbuf = allreduce_fp32_widen(sbuf, rbuf, count, dtype);
+        if (NULL == fbuf) { return OMPI_ERR_OUT_OF_RESOURCE; }
+        return allreduce_fp32_narrow(ompi_coll_base_allreduce_intra_ring_segmented(MPI_IN_PLACE, fbuf, count,
+                                                                                  &ompi_mpi_float.dt, op,
+                                                                                  comm, module, segsize), fbuf, rbuf, count, dtype);
+    }
+
     /* Special case for size == 1 */
     if (1 == size) {
         if (MPI_IN_PLACE != sbuf) {
@@ -984,6 +1029,14 @@ int ompi_coll_base_allreduce_intra_redscat_allgather(
                  "coll:base:allreduce_intra_redscat_allgather: rank %d/%d",
                  rank, comm_size));
 
+    if (ompi_coll_base_reduce_use_fp32(dtype, op)) {
+        float *fbuf = allreduce_fp32_widen(sbuf, rbuf, count, dtype);
+        if (NULL == fbuf) { return OMPI_ERR_OUT_OF_RESOURCE; }
+        return allreduce_fp32_narrow(ompi_coll_base_allreduce_intra_redscat_allgather(MPI_IN_PLACE, fbuf, count,
+                                                                                     &ompi_mpi_float.dt, op,
+                                                                                     comm, module), fbuf, rbuf, count, dtype);
+    }
+
     if (!ompi_op_is_commute(op)) {
         OPAL_OUTPUT((ompi_coll_base_framework.framework_output,
                      "coll:base:allreduce_intra_redscat_allgather: rank %d/%d "
@@ -35,6 +35,7 @@
 #include "ompi/mca/coll/coll.h"
 #include "ompi/mca/coll/base/base.h"
 #include "ompi/mca/coll/base/coll_base_functions.h"
+#include "ompi/mca/coll/base/coll_base_util.h"
 
 /*
  * The following file was created by configure.  It contains extern
@@ -133,6 +134,17 @@ ompi_request_t** ompi_coll_base_comm_get_reqs(mca_coll_base_comm_t* data, int nr
 static int mca_coll_base_register(mca_base_register_flag_t flags)
 {
     (void) mca_base_alias_register("ompi", "coll", "accelerator", "cuda", MCA_BASE_ALIAS_FLAG_DEPRECATED);
+
+    ompi_coll_base_reduce_accumulate_fp32 = false;
+    (void) mca_base_framework_var_register(&ompi_coll_base_framework, "reduce_accumulate_fp32",
+                                           "Accumulate MPI_SUM on bfloat16 and 2-byte short float "
+                                           "in fp32 in the ring and reduce-scatter based allreduce "
+                                           "and reduce_scatter algorithms. This doubles the amount "
+                                           "of data on the wire (default: false)",
+                                           MCA_BASE_VAR_TYPE_BOOL, NULL, 0,
+                                           MCA_BASE_VAR_FLAG_SETTABLE, OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_ALL_EQ,
+                                           &ompi_coll_base_reduce_accumulate_fp32);
     return OMPI_SUCCESS;
 }
 
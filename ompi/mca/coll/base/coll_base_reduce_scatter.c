@@ -482,6 +482,32 @@ ompi_coll_base_reduce_scatter_intra_ring( const void *sbuf, void *rbuf, ompi_cou
                  "coll:base:reduce_scatter_intra_ring rank %d, size %d",
                  rank, size));
 
+    /* fp32 accumulation for reduced-precision types: reduce a widened copy
+     * of the input and narrow only this rank's block at the end */
+    if (ompi_coll_base_reduce_use_fp32(dtype, op)) {
+        size_t rcount = ompi_count_array_get(rcounts, rank);
+        float *fsbuf, *frbuf;
+
+        total_count = 0;
+        for (i = 0; i < size; i++) {
+            total_count += ompi_count_array_get(rcounts, i);
+        }
+        fsbuf = (float*)malloc((total_count + rcount) * sizeof(float));
+        if (NULL == fsbuf) { return OMPI_ERR_OUT_OF_RESOURCE; }
+        frbuf = fsbuf + total_count;
+
+        ompi_coll_base_reduce_widen_fp32(fsbuf, (MPI_IN_PLACE == sbuf) ? rbuf : sbuf,
+                                         total_count, dtype);
+        ret = ompi_coll_base_reduce_scatter_intra_ring(fsbuf, frbuf, rcounts,
+                                                       &ompi_mpi_float.dt, op,
+                                                       comm, module);
+        if (MPI_SUCCESS == ret) {
+            ompi_coll_base_reduce_narrow_fp32(rbuf, frbuf, rcount, dtype);
+        }
+        free(fsbuf);
+        return ret;
+    }
+
     /* Determine the maximum number of elements per node,
        corresponding block size, and displacements array.
     */
@@ -32,6 +32,9 @@
 #include "ompi/mca/coll/base/coll_base_functions.h"
 #include "ompi/mca/topo/base/base.h"
 #include "ompi/mca/pml/pml.h"
+#include "ompi/mca/op/base/functions.h"
+#include "ompi/datatype/ompi_datatype_internal.h"
+#include "ompi/op/op.h"
 #include "coll_base_util.h"
 #include "coll_base_functions.h"
 #include <ctype.h>
@@ -357,6 +360,89 @@ static void nbc_req_constructor(ompi_coll_base_nbc_request_t *req)
 
 OBJ_CLASS_INSTANCE(ompi_coll_base_nbc_request_t, ompi_request_t, nbc_req_constructor, NULL);
 
+void ompi_coll_base_progress_queue_construct(ompi_coll_base_progress_queue_t *queue,
+                                             ompi_coll_base_progress_advance_fn_t advance,
+                                             opal_progress_callback_t progress)
+{
+    OBJ_CONSTRUCT(&queue->active, opal_list_t);
+    OBJ_CONSTRUCT(&queue->lock, opal_mutex_t);
+    queue->in_progress = false;
+    queue->registered = false;
+    queue->advance = advance;
+    queue->progress = progress;
+}
+
+void ompi_coll_base_progress_queue_destruct(ompi_coll_base_progress_queue_t *queue)
+{
+    if (queue->registered) {
+        opal_progress_unregister(queue->progress);
+        queue->registered = false;
+    }
+    OBJ_DESTRUCT(&queue->active);
+    OBJ_DESTRUCT(&queue->lock);
+}
+
+void ompi_coll_base_progress_queue_append(ompi_coll_base_progress_queue_t *queue,
+                                          ompi_request_t *request)
+{
+    request->req_complete = REQUEST_PENDING;
+    request->req_state = OMPI_REQUEST_ACTIVE;
+    request->req_status.MPI_ERROR = OMPI_SUCCESS;
+
+    OPAL_THREAD_LOCK(&queue->lock);
+    opal_list_append(&queue->active, &request->super.super);
+    if (!queue->registered) {
+        opal_progress_register(queue->progress);
+        queue->registered = true;
+    }
+    OPAL_THREAD_UNLOCK(&queue->lock);
+}
+
+int ompi_coll_base_progress_queue_progress(ompi_coll_base_progress_queue_t *queue)
+{
+    ompi_request_t *req, *next;
+    int completed = 0, err;
+
+    if (0 == opal_list_get_size(&queue->active)) {
+        return 0;
+    }
+
+    OPAL_THREAD_LOCK(&queue->lock);
+
+    /* return if invoked recursively */
+    if (queue->in_progress) {
+        OPAL_THREAD_UNLOCK(&queue->lock);
+        return 0;
+    }
+    queue->in_progress = true;
+
+    OPAL_LIST_FOREACH_SAFE(req, next, &queue->active, ompi_request_t) {
+        OPAL_THREAD_UNLOCK(&queue->lock);
+        err = queue->advance(req);
+        OPAL_THREAD_LOCK(&queue->lock);
+
+        if (OMPI_ERR_WOULD_BLOCK == err) {
+            continue;
+        }
+
+        opal_list_remove_item(&queue->active, &req->super.super);
+        OPAL_THREAD_UNLOCK(&queue->lock);
+
+        req->req_status.MPI_ERROR = err;
+        if (!REQUEST_COMPLETE(req)) {
+            ompi_request_complete(req, true);
+        }
+        completed++;
+
+        OPAL_THREAD_LOCK(&queue->lock);
+    }
+
+    queue->in_progress = false;
+    OPAL_THREAD_UNLOCK(&queue->lock);
+
+    return completed;
+}
+
 /* File reading functions */
 static void skiptonewline (FILE *fptr, int *fileline)
 {
@@ -626,3 +712,67 @@ const char* mca_coll_base_colltype_to_str(int collid)
     }
     return colltype_translation_table[collid];
 }
+
+bool ompi_coll_base_reduce_accumulate_fp32 = false;
+
+#if (defined(HAVE_SHORT_FLOAT) && SIZEOF_SHORT_FLOAT == 2) ||     \
+    (!defined(HAVE_SHORT_FLOAT) && defined(HAVE_OPAL_SHORT_FLOAT_T) && SIZEOF_OPAL_SHORT_FLOAT_T == 2)
+#define COLL_BASE_HAVE_HALF_SHORT_FLOAT 1
+#if defined(HAVE_SHORT_FLOAT)
+typedef short float coll_base_short_float_t;
+#else
+typedef opal_short_float_t coll_base_short_float_t;
+#endif
+#endif
+
+bool ompi_coll_base_reduce_use_fp32(ompi_datatype_t *dtype, ompi_op_t *op)
+{
+    if( !ompi_coll_base_reduce_accumulate_fp32 || (&ompi_mpi_op_sum.op != op) ) {
+        return false;
+    }
+    if( OMPI_DATATYPE_MPI_BFLOAT16 == dtype->id ) {
+        return true;
+    }
+#if defined(COLL_BASE_HAVE_HALF_SHORT_FLOAT)
+    if( OMPI_DATATYPE_MPI_SHORT_FLOAT == dtype->id ) {
+        return true;
+    }
+#endif
+    return false;
+}
+
+void ompi_coll_base_reduce_widen_fp32(float *dst, const void *src,
+                                      size_t count, ompi_datatype_t *dtype)
+{
+    if( OMPI_DATATYPE_MPI_BFLOAT16 == dtype->id ) {
+        const uint16_t *in = (const uint16_t *) src;
+        for( size_t i = 0; i < count; i++ ) {
+            dst[i] = ompi_op_base_bfloat16_to_float(in[i]);
+        }
+        return;
+    }
+#if defined(COLL_BASE_HAVE_HALF_SHORT_FLOAT)
+    const coll_base_short_float_t *in = (const coll_base_short_float_t *) src;
+    for( size_t i = 0; i < count; i++ ) {
+        dst[i] = (float) in[i];
+    }
+#endif
+}
+
+void ompi_coll_base_reduce_narrow_fp32(void *dst, const float *src,
+                                       size_t count, ompi_datatype_t *dtype)
+{
+    if( OMPI_DATATYPE_MPI_BFLOAT16 == dtype->id ) {
+        uint16_t *out = (uint16_t *) dst;
+        for( size_t i = 0; i < count; i++ ) {
+            out[i] = ompi_op_base_float_to_bfloat16(src[i]);
+        }
+        return;
+    }
+#if defined(COLL_BASE_HAVE_HALF_SHORT_FLOAT)
+    coll_base_short_float_t *out = (coll_base_short_float_t *) dst;
+    for( size_t i = 0; i < count; i++ ) {
+        out[i] = (coll_base_short_float_t) src[i];
+    }
+#endif
+}
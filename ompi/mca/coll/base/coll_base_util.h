@@ -32,6 +32,9 @@
 #include "ompi/mca/coll/base/coll_tags.h"
 #include "ompi/op/op.h"
 #include "ompi/mca/pml/pml.h"
+#include "opal/class/opal_list.h"
+#include "opal/mca/threads/mutex.h"
+#include "opal/runtime/opal_progress.h"
 
 BEGIN_C_DECLS
 
@@ -110,6 +113,49 @@ struct mca_coll_base_avail_coll_t {
 typedef struct mca_coll_base_avail_coll_t mca_coll_base_avail_coll_t;
 OMPI_DECLSPEC OBJ_CLASS_DECLARATION(mca_coll_base_avail_coll_t);
 
+/**
+ * Advance an active request of a progress queue without blocking. Returns
+ * OMPI_ERR_WOULD_BLOCK while the request is still in flight, and otherwise
+ * the status the request is completed with.
+ */
+typedef int (*ompi_coll_base_progress_advance_fn_t)(ompi_request_t *request);
+
+/**
+ * Requests of a component that are advanced from the progress engine, such
+ * as the started persistent collectives. The requests are linked in the
+ * queue through their opal_list_item_t. Since the opal_progress callbacks
+ * take no argument, each component registers a callback of its own
+ * (progress) that calls ompi_coll_base_progress_queue_progress on its queue.
+ */
+typedef struct ompi_coll_base_progress_queue_t {
+    opal_list_t active;
+    opal_mutex_t lock;
+    bool in_progress;
+    bool registered;
+    ompi_coll_base_progress_advance_fn_t advance;
+    opal_progress_callback_t progress;
+} ompi_coll_base_progress_queue_t;
+
+void ompi_coll_base_progress_queue_construct(ompi_coll_base_progress_queue_t *queue,
+                                             ompi_coll_base_progress_advance_fn_t advance,
+                                             opal_progress_callback_t progress);
+/* unregisters the progress callback */
+void ompi_coll_base_progress_queue_destruct(ompi_coll_base_progress_queue_t *queue);
+
+/**
+ * Mark the request as started and append it to the queue. The progress
+ * callback is registered with the first request.
+ */
+void ompi_coll_base_progress_queue_append(ompi_coll_base_progress_queue_t *queue,
+                                          ompi_request_t *request);
+
+/**
+ * Advance the requests of the queue, and complete the ones that are done.
+ * Returns the number of completed requests. Recursive calls return
+ * immediately.
+ */
+int ompi_coll_base_progress_queue_progress(ompi_coll_base_progress_queue_t *queue);
+
 /**
  * A MPI_like function doing a send and a receive simultaneously.
  * Posts a irecv, does a send, then gets irecv completion.
@@ -198,6 +244,20 @@ int ompi_coll_base_file_getnext_string(FILE *fptr, int *fileline, char** val);
 int ompi_coll_base_file_peek_next_char_is(FILE *fptr, int *fileline, int expected);
 int ompi_coll_base_file_peek_next_char_isdigit(FILE *fptr);
 
+/**
+ * Reduced-precision accumulation (coll_base_reduce_accumulate_fp32).
+ * When set, the ring and reduce-scatter based algorithms carry out
+ * MPI_SUM on bfloat16 and 2-byte short float in fp32: the input is widened
+ * once, reduced as MPI_FLOAT, and only the final result is rounded back.
+ */
+OMPI_DECLSPEC extern bool ompi_coll_base_reduce_accumulate_fp32;
+
+bool ompi_coll_base_reduce_use_fp32(ompi_datatype_t *dtype, ompi_op_t *op);
+void ompi_coll_base_reduce_widen_fp32(float *dst, const void *src,
+                                      size_t count, ompi_datatype_t *dtype);
+void ompi_coll_base_reduce_narrow_fp32(void *dst, const float *src,
+                                       size_t count, ompi_datatype_t *dtype);
+
 /* Miscellaneous function */
 const char* mca_coll_base_colltype_to_str(int collid);
 int mca_coll_base_name_to_colltype(const char* name);
@@ -44,6 +44,7 @@
 #include "opal/util/output.h"
 #include "opal/mca/smsc/smsc.h"
 #include "ompi/mca/coll/base/coll_base_functions.h"
+#include "ompi/mca/coll/base/coll_base_util.h"
 #include "coll_han_trigger.h"
 #include "ompi/mca/coll/han/coll_han_dynamic.h"
 #include "coll_han_algorithms.h"
@@ -296,6 +297,9 @@ typedef struct mca_coll_han_component_t {
     opal_free_list_t pack_buffers;
     int64_t han_packbuf_max_count;
     int64_t han_packbuf_bytes;
+
+    /* started persistent collectives, advanced from opal_progress */
+    ompi_coll_base_progress_queue_t persistent_queue;
 } mca_coll_han_component_t;
 
 /*
@@ -318,6 +322,8 @@ typedef struct mca_coll_han_single_collective_fallback_s
         mca_coll_base_module_reduce_fn_t reduce;
         mca_coll_base_module_scatter_fn_t scatter;
         mca_coll_base_module_scatterv_fn_t scatterv;
+        mca_coll_base_module_allreduce_init_fn_t allreduce_init;
+        mca_coll_base_module_bcast_init_fn_t bcast_init;
     };
     mca_coll_base_module_t* module;
 } mca_coll_han_single_collective_fallback_t;
@@ -341,6 +347,8 @@ typedef struct mca_coll_han_collectives_fallback_s
     mca_coll_han_single_collective_fallback_t gatherv;
     mca_coll_han_single_collective_fallback_t scatter;
     mca_coll_han_single_collective_fallback_t scatterv;
+    mca_coll_han_single_collective_fallback_t allreduce_init;
+    mca_coll_han_single_collective_fallback_t bcast_init;
 } mca_coll_han_collectives_fallback_t;
 
 /** Coll han module */
@@ -429,6 +437,12 @@ OBJ_CLASS_DECLARATION(mca_coll_han_module_t);
 #define previous_scatterv           fallback.scatterv.scatterv
 #define previous_scatterv_module    fallback.scatterv.module
 
+#define previous_allreduce_init         fallback.allreduce_init.allreduce_init
+#define previous_allreduce_init_module  fallback.allreduce_init.module
+
+#define previous_bcast_init         fallback.bcast_init.bcast_init
+#define previous_bcast_init_module  fallback.bcast_init.module
+
 /* macro to correctly load a fallback collective module */
 #define HAN_UNINSTALL_COLL_API(__comm, __module, __api)                                  \
     do                                                                                   \
@@ -456,6 +470,8 @@ OBJ_CLASS_DECLARATION(mca_coll_han_module_t);
         HAN_UNINSTALL_COLL_API(COMM, HANM, allgatherv);                \
         HAN_UNINSTALL_COLL_API(COMM, HANM, alltoall);                  \
         HAN_UNINSTALL_COLL_API(COMM, HANM, alltoallv);                 \
+        HAN_UNINSTALL_COLL_API(COMM, HANM, allreduce_init);            \
+        HAN_UNINSTALL_COLL_API(COMM, HANM, bcast_init);                \
         han_module->enabled = false;  /* entire module set to pass-through from now on */ \
     } while(0)
 
@@ -555,6 +571,14 @@ mca_coll_han_scatterv_intra_dynamic(SCATTERV_BASE_ARGS,
 int mca_coll_han_barrier_intra_simple(struct ompi_communicator_t *comm,
                                       mca_coll_base_module_t *module);
 
+/* Persistent collectives */
+int
+mca_coll_han_allreduce_intra_init(ALLREDUCE_INIT_ARGS);
+int
+mca_coll_han_bcast_intra_init(BCAST_INIT_ARGS);
+int mca_coll_han_persistent_advance(ompi_request_t *request);
+int mca_coll_han_persistent_progress(void);
+
 /* reordering after gather, for unordered ranks */
 void
 ompi_coll_han_reorder_gather(const void *sbuf,
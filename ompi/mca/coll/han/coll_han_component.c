@@ -139,6 +139,10 @@ static int han_open(void)
         printf("han: initializing free list got %d\n",ret);
     }
 
+    ompi_coll_base_progress_queue_construct(&mca_coll_han_component.persistent_queue,
+                                            mca_coll_han_persistent_advance,
+                                            mca_coll_han_persistent_progress);
+
     return mca_coll_han_init_dynamic_rules();
 }
 
@@ -147,6 +151,8 @@ static int han_open(void)
  */
 static int han_close(void)
 {
+    ompi_coll_base_progress_queue_destruct(&mca_coll_han_component.persistent_queue);
+
     mca_coll_han_free_dynamic_rules();
     mca_coll_han_free_algorithms();
 
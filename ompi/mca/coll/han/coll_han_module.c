@@ -60,6 +60,8 @@ static void han_module_clear(mca_coll_han_module_t *han_module)
     CLEAN_PREV_COLL(han_module, gatherv);
     CLEAN_PREV_COLL(han_module, scatter);
     CLEAN_PREV_COLL(han_module, scatterv);
+    CLEAN_PREV_COLL(han_module, allreduce_init);
+    CLEAN_PREV_COLL(han_module, bcast_init);
 
     han_module->reproducible_reduce = NULL;
     han_module->reproducible_reduce_module = NULL;
@@ -253,6 +255,8 @@ mca_coll_han_comm_query(struct ompi_communicator_t * comm, int *priority)
     if (GLOBAL_COMMUNICATOR == han_module->topologic_level) {
         /* We are on the global communicator, return topological algorithms */
         han_module->super.coll_allgatherv = NULL;
+        han_module->super.coll_allreduce_init = mca_coll_han_allreduce_intra_init;
+        han_module->super.coll_bcast_init = mca_coll_han_bcast_intra_init;
     } else {
         /* We are on a topologic sub-communicator, return only the selector */
         han_module->super.coll_allgatherv = mca_coll_han_allgatherv_intra_dynamic;
@@ -309,6 +313,8 @@ mca_coll_han_module_enable(mca_coll_base_module_t * module,
     HAN_INSTALL_COLL_API(comm, han_module, reduce);
     HAN_INSTALL_COLL_API(comm, han_module, scatter);
     HAN_INSTALL_COLL_API(comm, han_module, scatterv);
+    HAN_INSTALL_COLL_API(comm, han_module, allreduce_init);
+    HAN_INSTALL_COLL_API(comm, han_module, bcast_init);
 
     /* set reproducible algos */
     mca_coll_han_reduce_reproducible_decision(comm, module);
@@ -338,6 +344,8 @@ mca_coll_han_module_disable(mca_coll_base_module_t * module,
     HAN_UNINSTALL_COLL_API(comm, han_module, reduce);
     HAN_UNINSTALL_COLL_API(comm, han_module, scatter);
     HAN_UNINSTALL_COLL_API(comm, han_module, scatterv);
+    HAN_UNINSTALL_COLL_API(comm, han_module, allreduce_init);
+    HAN_UNINSTALL_COLL_API(comm, han_module, bcast_init);
 
     han_module_clear(han_module);
 
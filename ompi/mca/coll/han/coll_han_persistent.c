@@ -0,0 +1,382 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/**
+ * @file
+ *
+ * This files contains the hierarchical persistent collectives.
+ *
+ * The sub-communicator routing (intra-node and inter-node communicators,
+ * local leaders, root mapping) is resolved once at init time, and each
+ * stage of the hierarchical algorithm is initialized as a persistent
+ * collective on its sub-communicator. Starting the request starts the
+ * first stage; the following ones are started from the progress engine
+ * as the previous ones complete.
+ */
+
+#include "coll_han.h"
+#include "ompi/mca/coll/base/coll_base_functions.h"
+#include "ompi/request/request.h"
+#include "ompi/op/op.h"
+
+#define HAN_PERSISTENT_MAX_STAGES 3
+
+typedef struct mca_coll_han_persistent_request_t {
+    ompi_request_t super;
+
+    int nstages;
+    int cur_stage;
+    ompi_request_t *stages[HAN_PERSISTENT_MAX_STAGES];
+} mca_coll_han_persistent_request_t;
+
+static int han_persistent_start_stage(ompi_request_t **stage)
+{
+    /* a stage on a single process communicator might be a no-op request */
+    if (OMPI_REQUEST_NOOP == (*stage)->req_type) {
+        (*stage)->req_state = OMPI_REQUEST_ACTIVE;
+        return OMPI_SUCCESS;
+    }
+    return (*stage)->req_start(1, stage);
+}
+
+/*
+ * Move on to the next stages as far as the completed ones allow. Returns
+ * OMPI_ERR_WOULD_BLOCK while the current stage is still in flight.
+ */
+int mca_coll_han_persistent_advance(ompi_request_t *request)
+{
+    mca_coll_han_persistent_request_t *req = (mca_coll_han_persistent_request_t *) request;
+    int err;
+
+    while (req->cur_stage < req->nstages) {
+        ompi_request_t *stage = req->stages[req->cur_stage];
+
+        if (!REQUEST_COMPLETE(stage)) {
+            return OMPI_ERR_WOULD_BLOCK;
+        }
+
+        stage->req_state = OMPI_REQUEST_INACTIVE;
+        if (OMPI_SUCCESS != stage->req_status.MPI_ERROR) {
+            return stage->req_status.MPI_ERROR;
+        }
+
+        if (++req->cur_stage < req->nstages) {
+            err = han_persistent_start_stage(&req->stages[req->cur_stage]);
+            if (OMPI_SUCCESS != err) {
+                return err;
+            }
+        }
+    }
+
+    return OMPI_SUCCESS;
+}
+
+int mca_coll_han_persistent_progress(void)
+{
+    return ompi_coll_base_progress_queue_progress(&mca_coll_han_component.persistent_queue);
+}
+
+static int han_persistent_start(size_t count, ompi_request_t **requests)
+{
+    int err;
+
+    for (size_t i = 0; i < count; i++) {
+        mca_coll_han_persistent_request_t *req =
+            (mca_coll_han_persistent_request_t *) requests[i];
+
+        if (NULL == req) {
+            continue;
+        }
+
+        req->super.req_complete = REQUEST_PENDING;
+        req->super.req_state = OMPI_REQUEST_ACTIVE;
+        req->super.req_status.MPI_ERROR = OMPI_SUCCESS;
+        req->cur_stage = 0;
+
+        err = han_persistent_start_stage(&req->stages[0]);
+        if (OMPI_SUCCESS != err) {
+            return err;
+        }
+
+        ompi_coll_base_progress_queue_append(&mca_coll_han_component.persistent_queue,
+                                             &req->super);
+    }
+
+    mca_coll_han_persistent_progress();
+
+    return OMPI_SUCCESS;
+}
+
+static int han_persistent_cancel(ompi_request_t *request, int complete)
+{
+    return MPI_ERR_REQUEST;
+}
+
+static void han_persistent_release(mca_coll_han_persistent_request_t *req)
+{
+    for (int i = 0; i < req->nstages; i++) {
+        if (MPI_REQUEST_NULL != req->stages[i]) {
+            ompi_request_free(&req->stages[i]);
+        }
+    }
+    req->nstages = 0;
+}
+
+static int han_persistent_free(ompi_request_t **request)
+{
+    mca_coll_han_persistent_request_t *req =
+        (mca_coll_han_persistent_request_t *) *request;
+
+    if (!REQUEST_COMPLETE(&req->super)) {
+        return MPI_ERR_REQUEST;
+    }
+
+    han_persistent_release(req);
+
+    OMPI_REQUEST_FINI(&req->super);
+    OBJ_RELEASE(req);
+    *request = MPI_REQUEST_NULL;
+
+    return OMPI_SUCCESS;
+}
+
+static void han_persistent_construct(mca_coll_han_persistent_request_t *req)
+{
+    req->super.req_type = OMPI_REQUEST_COLL;
+    req->super.req_start = han_persistent_start;
+    req->super.req_free = han_persistent_free;
+    req->super.req_cancel = han_persistent_cancel;
+
+    req->nstages = 0;
+}
+
+OBJ_CLASS_INSTANCE(mca_coll_han_persistent_request_t, ompi_request_t,
+                   han_persistent_construct, NULL);
+
+static mca_coll_han_persistent_request_t *
+han_persistent_alloc(struct ompi_communicator_t *comm)
+{
+    mca_coll_han_persistent_request_t *req;
+
+    req = OBJ_NEW(mca_coll_han_persistent_request_t);
+    if (NULL == req) {
+        return NULL;
+    }
+
+    OMPI_REQUEST_INIT(&req->super, true);
+    req->super.req_mpi_object.comm = comm;
+
+    return req;
+}
+
+static void han_persistent_destroy(mca_coll_han_persistent_request_t *req)
+{
+    han_persistent_release(req);
+    OMPI_REQUEST_FINI(&req->super);
+    OBJ_RELEASE(req);
+}
+
+/*
+ * Allreduce: reduce on the low comm, allreduce on the up comm between the
+ * local leaders, then bcast on the low comm.
+ */
+int
+mca_coll_han_allreduce_intra_init(const void *sbuf,
+                                  void *rbuf,
+                                  size_t count,
+                                  struct ompi_datatype_t *dtype,
+                                  struct ompi_op_t *op,
+                                  struct ompi_communicator_t *comm,
+                                  struct ompi_info_t *info,
+                                  ompi_request_t **request,
+                                  mca_coll_base_module_t *module)
+{
+    mca_coll_han_module_t *han_module = (mca_coll_han_module_t *)module;
+    mca_coll_han_persistent_request_t *req;
+    ompi_communicator_t *low_comm, *up_comm;
+    int root_low_rank = 0, low_rank, ret;
+
+    if (!han_module->enabled || mca_coll_han_component.han_reproducible) {
+        goto prev_allreduce_init;
+    }
+
+    /* Fallback to another component if the op cannot commute */
+    if (!ompi_op_is_commute(op)) {
+        OPAL_OUTPUT_VERBOSE((30, mca_coll_han_component.han_output,
+                             "han cannot handle allreduce_init with this operation. Fall back on another component\n"));
+        goto prev_allreduce_init;
+    }
+
+    /* Create the subcommunicators */
+    if (OMPI_SUCCESS != mca_coll_han_comm_create_new(comm, han_module)) {
+        OPAL_OUTPUT_VERBOSE((30, mca_coll_han_component.han_output,
+                             "han cannot handle allreduce_init with this communicator. Drop HAN support in this communicator and fall back on another component\n"));
+        HAN_LOAD_FALLBACK_COLLECTIVES(comm, han_module);
+        goto prev_allreduce_init;
+    }
+
+    low_comm = han_module->sub_comm[INTRA_NODE];
+    up_comm = han_module->sub_comm[INTER_NODE];
+    low_rank = ompi_comm_rank(low_comm);
+
+    if (NULL == low_comm->c_coll->coll_reduce_init
+        || NULL == low_comm->c_coll->coll_bcast_init
+        || NULL == up_comm->c_coll->coll_allreduce_init) {
+        OPAL_OUTPUT_VERBOSE((30, mca_coll_han_component.han_output,
+                             "han cannot handle allreduce_init without persistent sub-collectives. Fall back on another component\n"));
+        goto prev_allreduce_init;
+    }
+
+    req = han_persistent_alloc(comm);
+    if (NULL == req) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+
+    /* Low_comm reduce */
+    if (MPI_IN_PLACE == sbuf && low_rank != root_low_rank) {
+        sbuf = rbuf;
+    }
+    ret = low_comm->c_coll->coll_reduce_init(sbuf, rbuf, count, dtype, op, root_low_rank,
+                                             low_comm, info, &req->stages[req->nstages],
+                                             low_comm->c_coll->coll_reduce_init_module);
+    if (OMPI_SUCCESS != ret) {
+        goto error;
+    }
+    req->nstages++;
+
+    /* Local roots perform a allreduce on the upper comm */
+    if (low_rank == root_low_rank) {
+        ret = up_comm->c_coll->coll_allreduce_init(MPI_IN_PLACE, rbuf, count, dtype, op,
+                                                   up_comm, info, &req->stages[req->nstages],
+                                                   up_comm->c_coll->coll_allreduce_init_module);
+        if (OMPI_SUCCESS != ret) {
+            goto error;
+        }
+        req->nstages++;
+    }
+
+    /* Low_comm bcast */
+    ret = low_comm->c_coll->coll_bcast_init(rbuf, count, dtype, root_low_rank,
+                                            low_comm, info, &req->stages[req->nstages],
+                                            low_comm->c_coll->coll_bcast_init_module);
+    if (OMPI_SUCCESS != ret) {
+        goto error;
+    }
+    req->nstages++;
+
+    *request = &req->super;
+    return OMPI_SUCCESS;
+
+ error:
+    /* Do not fallback: the other ranks might have already initialized
+     * their stages, and would be left waiting on the sub-communicators */
+    OPAL_OUTPUT_VERBOSE((30, mca_coll_han_component.han_output,
+                         "HAN/ALLREDUCE_INIT: sub-collective init failed (%d)\n", ret));
+    han_persistent_destroy(req);
+    return ret;
+
+ prev_allreduce_init:
+    return han_module->previous_allreduce_init(sbuf, rbuf, count, dtype, op, comm, info, request,
+                                               han_module->previous_allreduce_init_module);
+}
+
+/*
+ * Bcast: bcast on the up comm between the local leaders, from the leader
+ * of the root's node, then bcast on the low comm.
+ */
+int
+mca_coll_han_bcast_intra_init(void *buf,
+                              size_t count,
+                              struct ompi_datatype_t *dtype,
+                              int root,
+                              struct ompi_communicator_t *comm,
+                              struct ompi_info_t *info,
+                              ompi_request_t **request,
+                              mca_coll_base_module_t *module)
+{
+    mca_coll_han_module_t *han_module = (mca_coll_han_module_t *)module;
+    mca_coll_han_persistent_request_t *req;
+    ompi_communicator_t *low_comm, *up_comm;
+    int low_rank, low_size, root_low_rank, root_up_rank, ret;
+
+    if (!han_module->enabled) {
+        goto prev_bcast_init;
+    }
+
+    /* Create the subcommunicators */
+    if (OMPI_SUCCESS != mca_coll_han_comm_create_new(comm, han_module)) {
+        OPAL_OUTPUT_VERBOSE((30, mca_coll_han_component.han_output,
+                             "han cannot handle bcast_init with this communicator. Fall back on another component\n"));
+        HAN_LOAD_FALLBACK_COLLECTIVES(comm, han_module);
+        goto prev_bcast_init;
+    }
+
+    /* Topo must be initialized to know rank distribution which then is used to
+     * determine if han can be used */
+    mca_coll_han_topo_init(comm, han_module, 2);
+    if (han_module->are_ppn_imbalanced) {
+        OPAL_OUTPUT_VERBOSE((30, mca_coll_han_component.han_output,
+                             "han cannot handle bcast_init with this communicator (imbalance). Fall back on another component\n"));
+        HAN_UNINSTALL_COLL_API(comm, han_module, bcast_init);
+        goto prev_bcast_init;
+    }
+
+    low_comm = han_module->sub_comm[INTRA_NODE];
+    up_comm = han_module->sub_comm[INTER_NODE];
+
+    if (NULL == low_comm->c_coll->coll_bcast_init
+        || NULL == up_comm->c_coll->coll_bcast_init) {
+        OPAL_OUTPUT_VERBOSE((30, mca_coll_han_component.han_output,
+                             "han cannot handle bcast_init without persistent sub-collectives. Fall back on another component\n"));
+        goto prev_bcast_init;
+    }
+
+    low_rank = ompi_comm_rank(low_comm);
+    low_size = ompi_comm_size(low_comm);
+    mca_coll_han_get_ranks(han_module->cached_vranks, root, low_size,
+                           &root_low_rank, &root_up_rank);
+
+    req = han_persistent_alloc(comm);
+    if (NULL == req) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+
+    if (low_rank == root_low_rank) {
+        ret = up_comm->c_coll->coll_bcast_init(buf, count, dtype, root_up_rank,
+                                               up_comm, info, &req->stages[req->nstages],
+                                               up_comm->c_coll->coll_bcast_init_module);
+        if (OMPI_SUCCESS != ret) {
+            goto error;
+        }
+        req->nstages++;
+    }
+
+    ret = low_comm->c_coll->coll_bcast_init(buf, count, dtype, root_low_rank,
+                                            low_comm, info, &req->stages[req->nstages],
+                                            low_comm->c_coll->coll_bcast_init_module);
+    if (OMPI_SUCCESS != ret) {
+        goto error;
+    }
+    req->nstages++;
+
+    *request = &req->super;
+    return OMPI_SUCCESS;
+
+ error:
+    OPAL_OUTPUT_VERBOSE((30, mca_coll_han_component.han_output,
+                         "HAN/BCAST_INIT: sub-collective init failed (%d)\n", ret));
+    han_persistent_destroy(req);
+    return ret;
+
+ prev_bcast_init:
+    return han_module->previous_bcast_init(buf, count, dtype, root, comm, info, request,
+                                           han_module->previous_bcast_init_module);
+}
@@ -25,6 +25,8 @@
 #include "ompi/mca/mca.h"
 #include "ompi/request/request.h"
 #include "ompi/mca/coll/base/coll_base_functions.h"
+#include "ompi/mca/coll/base/coll_base_topo.h"
+#include "ompi/mca/coll/base/coll_base_util.h"
 #include "opal/util/output.h"
 
 /* also need the dynamic rule structures */
@@ -116,6 +118,8 @@ int ompi_coll_tuned_allreduce_intra_dec_fixed(ALLREDUCE_ARGS);
 int ompi_coll_tuned_allreduce_intra_dec_dynamic(ALLREDUCE_ARGS);
 int ompi_coll_tuned_allreduce_intra_do_this(ALLREDUCE_ARGS, int algorithm, int faninout, int segsize);
 int ompi_coll_tuned_allreduce_intra_check_forced_init (coll_tuned_force_algorithm_mca_param_indices_t *mca_param_indices);
+int ompi_coll_tuned_allreduce_intra_fixed_alg(int communicator_size, size_t total_dsize, bool commute);
+int ompi_coll_tuned_allreduce_intra_init(ALLREDUCE_INIT_ARGS);
 
 /* AlltoAll */
 int ompi_coll_tuned_alltoall_intra_dec_fixed(ALLTOALL_ARGS);
@@ -140,6 +144,10 @@ int ompi_coll_tuned_bcast_intra_dec_fixed(BCAST_ARGS);
 int ompi_coll_tuned_bcast_intra_dec_dynamic(BCAST_ARGS);
 int ompi_coll_tuned_bcast_intra_do_this(BCAST_ARGS, int algorithm, int faninout, int segsize);
 int ompi_coll_tuned_bcast_intra_check_forced_init (coll_tuned_force_algorithm_mca_param_indices_t *mca_param_indices);
+int ompi_coll_tuned_bcast_intra_fixed_alg(int communicator_size, size_t total_dsize);
+ompi_coll_tree_t *ompi_coll_tuned_bcast_intra_build_tree(struct ompi_communicator_t *comm, int root,
+                                                         int algorithm, int faninout);
+int ompi_coll_tuned_bcast_intra_init(BCAST_INIT_ARGS);
 
 /* Gather */
 int ompi_coll_tuned_gather_intra_dec_fixed(GATHER_ARGS);
@@ -183,6 +191,10 @@ int ompi_coll_tuned_scan_intra_dec_dynamic(SCAN_ARGS);
 int ompi_coll_tuned_scan_intra_do_this(SCAN_ARGS, int algorithm);
 int ompi_coll_tuned_scan_intra_check_forced_init (coll_tuned_force_algorithm_mca_param_indices_t *mca_param_indices);
 
+/* Progress of the persistent collectives (coll_tuned_persistent.c) */
+int ompi_coll_tuned_persistent_advance(ompi_request_t *request);
+int ompi_coll_tuned_persistent_progress(void);
+
 struct mca_coll_tuned_component_t {
 	/** Base coll component */
 	mca_coll_base_component_3_0_0_t super;
@@ -196,6 +208,9 @@ struct mca_coll_tuned_component_t {
 
 	/* cached decision table stuff (moved from MCW module) */
 	ompi_coll_alg_rule_t *all_base_rules;
+
+	/* started persistent collectives, advanced from opal_progress */
+	ompi_coll_base_progress_queue_t persistent_queue;
 };
 /**
  * Convenience typedef
@@ -174,3 +174,33 @@ int ompi_coll_tuned_bcast_intra_do_this(void *buf, size_t count,
         algorithm, ompi_coll_tuned_forced_max_algorithms[BCAST]));
     return (MPI_ERR_ARG);
 }
+
+/*
+ * Build the tree along which a persistent bcast pipelines its segments,
+ * following the topology of the blocking algorithm. The scatter-allgather
+ * variants have no pipelined equivalent and use the binomial tree they
+ * scatter along. The caller owns (and destroys) the returned tree.
+ */
+ompi_coll_tree_t *
+ompi_coll_tuned_bcast_intra_build_tree(struct ompi_communicator_t *comm, int root,
+                                       int algorithm, int faninout)
+{
+    int size = ompi_comm_size(comm);
+
+    switch (algorithm) {
+    case (1):
+        return ompi_coll_base_topo_build_tree(size - 1 < MAXTREEFANOUT ? size - 1 : MAXTREEFANOUT,
+                                              comm, root);
+    case (2):
+        return ompi_coll_base_topo_build_chain(faninout, comm, root);
+    case (3):
+        return ompi_coll_base_topo_build_chain(1, comm, root);
+    case (4):
+    case (5):
+        return ompi_coll_base_topo_build_tree(2, comm, root);
+    case (7):
+        return ompi_coll_base_topo_build_kmtree(comm, root, coll_tuned_bcast_knomial_radix);
+    default:
+        return ompi_coll_base_topo_build_bmtree(comm, root);
+    }
+}
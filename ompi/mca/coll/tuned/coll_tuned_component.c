@@ -126,7 +126,7 @@ mca_coll_tuned_component_t mca_coll_tuned_component = {
     0,
 
     /* Tuned component specific information */
-    NULL /* ompi_coll_alg_rule_t ptr */
+    NULL, /* ompi_coll_alg_rule_t ptr */
 };
 MCA_BASE_COMPONENT_INIT(ompi, coll, tuned)
 
@@ -259,6 +259,10 @@ static int tuned_open(void)
         }
     }
 
+    ompi_coll_base_progress_queue_construct(&mca_coll_tuned_component.persistent_queue,
+                                            ompi_coll_tuned_persistent_advance,
+                                            ompi_coll_tuned_persistent_progress);
+
     OPAL_OUTPUT_VERBOSE((COLL_TUNED_TRACING_VERBOSE, ompi_coll_tuned_stream,
         "coll:tuned:component_open: done!"));
 
@@ -278,6 +282,8 @@ static int tuned_close(void)
     OPAL_OUTPUT_VERBOSE((COLL_TUNED_TRACING_VERBOSE, ompi_coll_tuned_stream,
         "coll:tuned:component_close: done!"));
 
+    ompi_coll_base_progress_queue_destruct(&mca_coll_tuned_component.persistent_queue);
+
     if( NULL != mca_coll_tuned_component.all_base_rules ) {
         ompi_coll_tuned_free_all_rules(mca_coll_tuned_component.all_base_rules);
         mca_coll_tuned_component.all_base_rules = NULL;
@@ -45,27 +45,17 @@
  */
 
 /*
- *  allreduce_intra
+ *  allreduce_intra_fixed_alg
  *
- *  Function:   - allreduce using other MPI collectives
- *  Accepts:    - same as MPI_Allreduce()
- *  Returns:    - MPI_SUCCESS or error code
+ *  Function:   - selects the allreduce algorithm from the fixed rules
+ *  Accepts:    - communicator size, message size and op commutativity
+ *  Returns:    - algorithm number (see ompi_coll_tuned_allreduce_intra_do_this)
  */
 int
-ompi_coll_tuned_allreduce_intra_dec_fixed(const void *sbuf, void *rbuf, size_t count,
-                                          struct ompi_datatype_t *dtype,
-                                          struct ompi_op_t *op,
-                                          struct ompi_communicator_t *comm,
-                                          mca_coll_base_module_t *module)
+ompi_coll_tuned_allreduce_intra_fixed_alg(int communicator_size, size_t total_dsize,
+                                          bool commute)
 {
-    size_t dsize, total_dsize;
-    int communicator_size, alg;
-    communicator_size = ompi_comm_size(comm);
-    OPAL_OUTPUT_VERBOSE((COLL_TUNED_TRACING_VERBOSE, ompi_coll_tuned_stream,
-        "ompi_coll_tuned_allreduce_intra_dec_fixed"));
-
-    ompi_datatype_type_size(dtype, &dsize);
-    total_dsize = dsize * (ptrdiff_t)count;
+    int alg;
 
     /** Algorithms:
      *  {1, "basic_linear"},
@@ -78,7 +68,7 @@ ompi_coll_tuned_allreduce_intra_dec_fixed(const void *sbuf, void *rbuf, size_t c
      * Currently, ring, segmented ring, and rabenseifner do not support
      * non-commutative operations.
      */
-    if( !ompi_op_is_commute(op) ) {
+    if( !commute ) {
         if (communicator_size < 4) {
             if (total_dsize < 131072) {
                 alg = 3;
@@ -214,6 +204,34 @@ ompi_coll_tuned_allreduce_intra_dec_fixed(const void *sbuf, void *rbuf, size_t c
         }
     }
 
+    return alg;
+}
+
+/*
+ *  allreduce_intra
+ *
+ *  Function:   - allreduce using other MPI collectives
+ *  Accepts:    - same as MPI_Allreduce()
+ *  Returns:    - MPI_SUCCESS or error code
+ */
+int
+ompi_coll_tuned_allreduce_intra_dec_fixed(const void *sbuf, void *rbuf, size_t count,
+                                          struct ompi_datatype_t *dtype,
+                                          struct ompi_op_t *op,
+                                          struct ompi_communicator_t *comm,
+                                          mca_coll_base_module_t *module)
+{
+    size_t dsize, total_dsize;
+    int alg;
+    OPAL_OUTPUT_VERBOSE((COLL_TUNED_TRACING_VERBOSE, ompi_coll_tuned_stream,
+        "ompi_coll_tuned_allreduce_intra_dec_fixed"));
+
+    ompi_datatype_type_size(dtype, &dsize);
+    total_dsize = dsize * (ptrdiff_t)count;
+
+    alg = ompi_coll_tuned_allreduce_intra_fixed_alg(ompi_comm_size(comm), total_dsize,
+                                                    ompi_op_is_commute(op));
+
     return ompi_coll_tuned_allreduce_intra_do_this (sbuf, rbuf, count, dtype, op,
                                                     comm, module, alg, 0, 0);
 }
@@ -506,27 +524,15 @@ int ompi_coll_tuned_barrier_intra_dec_fixed(struct ompi_communicator_t *comm,
 
 
 /*
- *	bcast_intra_dec
+ *	bcast_intra_fixed_alg
  *
- *	Function:	- selects broadcast algorithm to use
- *	Accepts:	- same arguments as MPI_Bcast()
- *	Returns:	- MPI_SUCCESS or error code (passed from the bcast implementation)
+ *	Function:	- selects the broadcast algorithm from the fixed rules
+ *	Accepts:	- communicator size and message size
+ *	Returns:	- algorithm number (see ompi_coll_tuned_bcast_intra_do_this)
  */
-int ompi_coll_tuned_bcast_intra_dec_fixed(void *buff, size_t count,
-                                          struct ompi_datatype_t *datatype, int root,
-                                          struct ompi_communicator_t *comm,
-                                          mca_coll_base_module_t *module)
+int ompi_coll_tuned_bcast_intra_fixed_alg(int communicator_size, size_t total_dsize)
 {
-    size_t total_dsize, dsize;
-    int communicator_size, alg;
-	communicator_size = ompi_comm_size(comm);
-
-    ompi_datatype_type_size(datatype, &dsize);
-    total_dsize = dsize * (unsigned long)count;
-
-    OPAL_OUTPUT_VERBOSE((COLL_TUNED_TRACING_VERBOSE, ompi_coll_tuned_stream,
-        "ompi_coll_tuned_bcast_intra_dec_fixed root %d rank %d com_size %d",
-        root, ompi_comm_rank(comm), communicator_size));
+    int alg;
 
     /** Algorithms:
      *  {1, "basic_linear"},
@@ -649,6 +655,34 @@ int ompi_coll_tuned_bcast_intra_dec_fixed(void *buff, size_t count,
         }
     }
 
+    return alg;
+}
+
+/*
+ *	bcast_intra_dec
+ *
+ *	Function:	- selects broadcast algorithm to use
+ *	Accepts:	- same arguments as MPI_Bcast()
+ *	Returns:	- MPI_SUCCESS or error code (passed from the bcast implementation)
+ */
+int ompi_coll_tuned_bcast_intra_dec_fixed(void *buff, size_t count,
+                                          struct ompi_datatype_t *datatype, int root,
+                                          struct ompi_communicator_t *comm,
+                                          mca_coll_base_module_t *module)
+{
+    size_t total_dsize, dsize;
+    int communicator_size, alg;
+	communicator_size = ompi_comm_size(comm);
+
+    ompi_datatype_type_size(datatype, &dsize);
+    total_dsize = dsize * (unsigned long)count;
+
+    OPAL_OUTPUT_VERBOSE((COLL_TUNED_TRACING_VERBOSE, ompi_coll_tuned_stream,
+        "ompi_coll_tuned_bcast_intra_dec_fixed root %d rank %d com_size %d",
+        root, ompi_comm_rank(comm), communicator_size));
+
+    alg = ompi_coll_tuned_bcast_intra_fixed_alg(communicator_size, total_dsize);
+
     return ompi_coll_tuned_bcast_intra_do_this (buff, count, datatype, root,
                                                 comm, module,
                                                 alg, 0, 0);
@@ -114,6 +114,11 @@ ompi_coll_tuned_comm_query(struct ompi_communicator_t *comm, int *priority)
     tuned_module->super.coll_reduce_scatter_block = ompi_coll_tuned_reduce_scatter_block_intra_dec_fixed;
     tuned_module->super.coll_scatter    = ompi_coll_tuned_scatter_intra_dec_fixed;
 
+    /* The persistent collectives resolve the decision (fixed or dynamic)
+     * once, at init time */
+    tuned_module->super.coll_allreduce_init = ompi_coll_tuned_allreduce_intra_init;
+    tuned_module->super.coll_bcast_init     = ompi_coll_tuned_bcast_intra_init;
+
     return &(tuned_module->super);
 }
 
@@ -279,6 +284,8 @@ tuned_module_enable( mca_coll_base_module_t *module,
     TUNED_INSTALL_COLL_API(comm, tuned_module, scan);
     TUNED_INSTALL_COLL_API(comm, tuned_module, scatter);
     TUNED_INSTALL_COLL_API(comm, tuned_module, scatterv);
+    TUNED_INSTALL_COLL_API(comm, tuned_module, allreduce_init);
+    TUNED_INSTALL_COLL_API(comm, tuned_module, bcast_init);
 
     /* general n fan out tree */
     data->cached_ntree = NULL;
@@ -327,6 +334,8 @@ tuned_module_disable(mca_coll_base_module_t *module,
     TUNED_UNINSTALL_COLL_API(comm, tuned_module, scan);
     TUNED_UNINSTALL_COLL_API(comm, tuned_module, scatter);
     TUNED_UNINSTALL_COLL_API(comm, tuned_module, scatterv);
+    TUNED_UNINSTALL_COLL_API(comm, tuned_module, allreduce_init);
+    TUNED_UNINSTALL_COLL_API(comm, tuned_module, bcast_init);
 
     return OMPI_SUCCESS;
 }
@@ -0,0 +1,758 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+ * Persistent collectives
+ *
+ * MPI_Allreduce_init and MPI_Bcast_init run the decision logic (forced
+ * algorithm, file based rules, fixed rules) once, and freeze its outcome
+ * into a plan: a sequence of steps, each made of persistent point-to-point
+ * requests followed by an optional local reduction and copy. The topology,
+ * the segmentation, the temporary buffers and the point-to-point requests
+ * are all built at init time, so that every MPI_Start only restarts the
+ * requests of the first step. The following steps are started from the
+ * progress engine as the previous ones complete; neither MPI_Start nor
+ * the progress engine ever block.
+ *
+ * Not every blocking algorithm has a step-wise equivalent, so the selected
+ * algorithm is mapped to the closest plan (see the per-collective comments
+ * below).
+ */
+
+#include "ompi_config.h"
+
+#include "mpi.h"
+#include "opal/util/bit_ops.h"
+#include "ompi/constants.h"
+#include "ompi/datatype/ompi_datatype.h"
+#include "ompi/communicator/communicator.h"
+#include "ompi/request/request.h"
+#include "ompi/op/op.h"
+#include "ompi/mca/coll/coll.h"
+#include "ompi/mca/coll/base/coll_base_functions.h"
+#include "ompi/mca/coll/base/coll_base_topo.h"
+#include "ompi/mca/coll/base/coll_base_util.h"
+#include "ompi/mca/pml/pml.h"
+#include "coll_tuned.h"
+#include "coll_tuned_dynamic_rules.h"
+
+typedef struct ompi_coll_tuned_plan_step_t {
+    int nreqs;
+    ompi_request_t **reqs;
+
+    /* local work, once all the requests of the step have completed:
+     * reduce_dst = reduce_src (op) reduce_dst, then copy_src -> copy_dst */
+    char *reduce_src, *reduce_dst;
+    size_t reduce_count;
+    char *copy_src, *copy_dst;
+    size_t copy_count;
+} ompi_coll_tuned_plan_step_t;
+
+typedef struct ompi_coll_tuned_persistent_request_t {
+    ompi_request_t super;
+
+    struct ompi_communicator_t *comm;
+    struct ompi_datatype_t *dtype;
+    struct ompi_op_t *op;
+    int tag;
+
+    /* out of place allreduce: sbuf is copied into rbuf on every start */
+    const void *sbuf;
+    void *rbuf;
+    size_t count;
+
+    int nsteps;
+    int cur_step;
+    ompi_coll_tuned_plan_step_t *steps;
+
+    ompi_coll_tree_t *tree;
+    char *tmpbuf_free;
+} ompi_coll_tuned_persistent_request_t;
+
+/*
+ * Plan construction
+ */
+
+static ompi_coll_tuned_plan_step_t *
+tuned_plan_next_step(ompi_coll_tuned_persistent_request_t *req)
+{
+    ompi_coll_tuned_plan_step_t *steps;
+
+    steps = realloc(req->steps, (req->nsteps + 1) * sizeof(*steps));
+    if (NULL == steps) {
+        return NULL;
+    }
+    req->steps = steps;
+
+    memset(&steps[req->nsteps], 0, sizeof(*steps));
+    return &steps[req->nsteps++];
+}
+
+static ompi_request_t **
+tuned_plan_next_req(ompi_coll_tuned_plan_step_t *step)
+{
+    ompi_request_t **reqs;
+
+    reqs = realloc(step->reqs, (step->nreqs + 1) * sizeof(*reqs));
+    if (NULL == reqs) {
+        return NULL;
+    }
+    step->reqs = reqs;
+
+    reqs[step->nreqs] = MPI_REQUEST_NULL;
+    return &reqs[step->nreqs++];
+}
+
+static int
+tuned_plan_send(ompi_coll_tuned_persistent_request_t *req,
+                ompi_coll_tuned_plan_step_t *step,
+                char *buf, size_t count, int peer)
+{
+    ompi_request_t **preq = tuned_plan_next_req(step);
+    if (NULL == preq) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+    return MCA_PML_CALL(isend_init(buf, count, req->dtype, peer, req->tag,
+                                   MCA_PML_BASE_SEND_STANDARD, req->comm, preq));
+}
+
+static int
+tuned_plan_recv(ompi_coll_tuned_persistent_request_t *req,
+                ompi_coll_tuned_plan_step_t *step,
+                char *buf, size_t count, int peer)
+{
+    ompi_request_t **preq = tuned_plan_next_req(step);
+    if (NULL == preq) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+    return MCA_PML_CALL(irecv_init(buf, count, req->dtype, peer, req->tag,
+                                   req->comm, preq));
+}
+
+/*
+ * Request management
+ */
+
+static int tuned_persistent_start_step(ompi_coll_tuned_persistent_request_t *req)
+{
+    ompi_coll_tuned_plan_step_t *step = &req->steps[req->cur_step];
+
+    if (0 == step->nreqs) {
+        return OMPI_SUCCESS;
+    }
+    return MCA_PML_CALL(start(step->nreqs, step->reqs));
+}
+
+/*
+ * Move the plan forward as far as the completed requests allow. Returns
+ * OMPI_ERR_WOULD_BLOCK while the current step is still in flight.
+ */
+int ompi_coll_tuned_persistent_advance(ompi_request_t *request)
+{
+    ompi_coll_tuned_persistent_request_t *req = (ompi_coll_tuned_persistent_request_t *) request;
+    int err;
+
+    while (req->cur_step < req->nsteps) {
+        ompi_coll_tuned_plan_step_t *step = &req->steps[req->cur_step];
+
+        for (int i = 0; i < step->nreqs; i++) {
+            if (!REQUEST_COMPLETE(step->reqs[i])) {
+                return OMPI_ERR_WOULD_BLOCK;
+            }
+        }
+
+        err = OMPI_SUCCESS;
+        for (int i = 0; i < step->nreqs; i++) {
+            if (OMPI_SUCCESS != step->reqs[i]->req_status.MPI_ERROR) {
+                err = step->reqs[i]->req_status.MPI_ERROR;
+            }
+            step->reqs[i]->req_state = OMPI_REQUEST_INACTIVE;
+        }
+        if (OMPI_SUCCESS != err) {
+            return err;
+        }
+
+        if (0 < step->reduce_count) {
+            ompi_op_reduce(req->op, step->reduce_src, step->reduce_dst,
+                           step->reduce_count, req->dtype);
+        }
+        if (0 < step->copy_count) {
+            err = ompi_datatype_copy_content_same_ddt(req->dtype, step->copy_count,
+                                                      step->copy_dst, step->copy_src);
+            if (OMPI_SUCCESS != err) {
+                return err;
+            }
+        }
+
+        if (++req->cur_step < req->nsteps) {
+            err = tuned_persistent_start_step(req);
+            if (OMPI_SUCCESS != err) {
+                return err;
+            }
+        }
+    }
+
+    return OMPI_SUCCESS;
+}
+
+int ompi_coll_tuned_persistent_progress(void)
+{
+    return ompi_coll_base_progress_queue_progress(&mca_coll_tuned_component.persistent_queue);
+}
+
+static int tuned_persistent_start(size_t count, ompi_request_t **requests)
+{
+    int err;
+
+    for (size_t i = 0; i < count; i++) {
+        ompi_coll_tuned_persistent_request_t *req =
+            (ompi_coll_tuned_persistent_request_t *) requests[i];
+
+        if (NULL == req) {
+            continue;
+        }
+
+        req->super.req_complete = REQUEST_PENDING;
+        req->super.req_state = OMPI_REQUEST_ACTIVE;
+        req->super.req_status.MPI_ERROR = OMPI_SUCCESS;
+        req->cur_step = 0;
+
+        if (MPI_IN_PLACE != req->sbuf && req->sbuf != req->rbuf) {
+            err = ompi_datatype_copy_content_same_ddt(req->dtype, req->count,
+                                                      (char *) req->rbuf, (char *) req->sbuf);
+            if (OMPI_SUCCESS != err) {
+                return err;
+            }
+        }
+
+        if (0 == req->nsteps) {
+            ompi_request_complete(&req->super, true);
+            continue;
+        }
+
+        err = tuned_persistent_start_step(req);
+        if (OMPI_SUCCESS != err) {
+            return err;
+        }
+
+        ompi_coll_base_progress_queue_append(&mca_coll_tuned_component.persistent_queue,
+                                             &req->super);
+    }
+
+    /* small operations might complete right away */
+    ompi_coll_tuned_persistent_progress();
+
+    return OMPI_SUCCESS;
+}
+
+static int tuned_persistent_cancel(ompi_request_t *request, int complete)
+{
+    return MPI_ERR_REQUEST;
+}
+
+static void tuned_persistent_release(ompi_coll_tuned_persistent_request_t *req)
+{
+    for (int s = 0; s < req->nsteps; s++) {
+        for (int i = 0; i < req->steps[s].nreqs; i++) {
+            if (MPI_REQUEST_NULL != req->steps[s].reqs[i]) {
+                ompi_request_free(&req->steps[s].reqs[i]);
+            }
+        }
+        free(req->steps[s].reqs);
+    }
+    free(req->steps);
+    req->steps = NULL;
+    req->nsteps = 0;
+
+    if (NULL != req->tree) {
+        ompi_coll_base_topo_destroy_tree(&req->tree);
+    }
+    free(req->tmpbuf_free);
+    req->tmpbuf_free = NULL;
+
+    OBJ_RELEASE(req->dtype);
+    OBJ_RELEASE(req->op);
+}
+
+static int tuned_persistent_free(ompi_request_t **request)
+{
+    ompi_coll_tuned_persistent_request_t *req =
+        (ompi_coll_tuned_persistent_request_t *) *request;
+
+    if (!REQUEST_COMPLETE(&req->super)) {
+        return MPI_ERR_REQUEST;
+    }
+
+    tuned_persistent_release(req);
+
+    OMPI_REQUEST_FINI(&req->super);
+    OBJ_RELEASE(req);
+    *request = MPI_REQUEST_NULL;
+
+    return OMPI_SUCCESS;
+}
+
+static void tuned_persistent_construct(ompi_coll_tuned_persistent_request_t *req)
+{
+    req->super.req_type = OMPI_REQUEST_COLL;
+    req->super.req_start = tuned_persistent_start;
+    req->super.req_free = tuned_persistent_free;
+    req->super.req_cancel = tuned_persistent_cancel;
+
+    req->nsteps = 0;
+    req->steps = NULL;
+    req->tree = NULL;
+    req->tmpbuf_free = NULL;
+}
+
+OBJ_CLASS_INSTANCE(ompi_coll_tuned_persistent_request_t, ompi_request_t,
+                   tuned_persistent_construct, NULL);
+
+static ompi_coll_tuned_persistent_request_t *
+tuned_persistent_alloc(struct ompi_communicator_t *comm,
+                       struct ompi_datatype_t *dtype, struct ompi_op_t *op,
+                       const void *sbuf, void *rbuf, size_t count)
+{
+    ompi_coll_tuned_persistent_request_t *req;
+
+    req = OBJ_NEW(ompi_coll_tuned_persistent_request_t);
+    if (NULL == req) {
+        return NULL;
+    }
+
+    OMPI_REQUEST_INIT(&req->super, true);
+    req->super.req_mpi_object.comm = comm;
+
+    req->comm = comm;
+    req->dtype = dtype;
+    req->op = op;
+    OBJ_RETAIN(dtype);
+    OBJ_RETAIN(op);
+
+    req->sbuf = sbuf;
+    req->rbuf = rbuf;
+    req->count = count;
+
+    /* init calls are collective and ordered, so the tag matches everywhere */
+    req->tag = ompi_coll_base_nbc_reserve_tags(comm, 1);
+
+    return req;
+}
+
+static void tuned_persistent_destroy(ompi_coll_tuned_persistent_request_t *req)
+{
+    tuned_persistent_release(req);
+    OMPI_REQUEST_FINI(&req->super);
+    OBJ_RELEASE(req);
+}
+
+/*
+ * Same order of precedence as the dynamic decision functions: forced
+ * algorithm, then file based rules. Returns 0 if the fixed rules apply.
+ */
+static int
+tuned_persistent_decision(mca_coll_tuned_module_t *tuned_module, int coll,
+                          size_t dsize, int *faninout, int *segsize)
+{
+    coll_tuned_force_algorithm_params_t *forced = &tuned_module->user_forced[coll];
+    int alg, ignoreme;
+
+    if (forced->algorithm) {
+        *faninout = (BCAST == coll) ? forced->chain_fanout : forced->tree_fanout;
+        *segsize = forced->segsize;
+        return forced->algorithm;
+    }
+
+    if (tuned_module->com_rules[coll]) {
+        alg = ompi_coll_tuned_get_target_method_params(tuned_module->com_rules[coll],
+                                                       dsize, faninout, segsize, &ignoreme);
+        if (alg) {
+            return alg;
+        }
+    }
+
+    return 0;
+}
+
+/*
+ * Allreduce
+ *
+ * The ring based algorithms (ring, segmented ring, rabenseifner) are planned
+ * as a ring reduce-scatter followed by a ring allgather. Everything else,
+ * and non-commutative operations, are planned as recursive doubling.
+ */
+
+static int
+tuned_allreduce_plan_recursive_doubling(ompi_coll_tuned_persistent_request_t *req)
+{
+    ompi_coll_tuned_plan_step_t *step;
+    int rank, size, adjsize, extra_ranks, newrank, newremote, remote, distance, err;
+    char *tmpsend, *tmprecv, *tmpswap;
+    ptrdiff_t span, gap = 0;
+    size_t count = req->count;
+
+    rank = ompi_comm_rank(req->comm);
+    size = ompi_comm_size(req->comm);
+
+    span = opal_datatype_span(&req->dtype->super, count, &gap);
+    req->tmpbuf_free = (char *) malloc(span);
+    if (NULL == req->tmpbuf_free) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+
+    tmpsend = (char *) req->rbuf;
+    tmprecv = req->tmpbuf_free - gap;
+
+    adjsize = opal_next_poweroftwo(size);
+    adjsize >>= 1;
+
+    /* non-power-of-two: the even ranks among the first 2 * extra_ranks
+     * fold their data into the next rank, and sit out the exchanges */
+    extra_ranks = size - adjsize;
+    if (rank < (2 * extra_ranks)) {
+        if (NULL == (step = tuned_plan_next_step(req))) {
+            return OMPI_ERR_OUT_OF_RESOURCE;
+        }
+        if (0 == (rank % 2)) {
+            err = tuned_plan_send(req, step, tmpsend, count, rank + 1);
+            newrank = -1;
+        } else {
+            err = tuned_plan_recv(req, step, tmprecv, count, rank - 1);
+            step->reduce_src = tmprecv;
+            step->reduce_dst = tmpsend;
+            step->reduce_count = count;
+            newrank = rank >> 1;
+        }
+        if (OMPI_SUCCESS != err) {
+            return err;
+        }
+    } else {
+        newrank = rank - extra_ranks;
+    }
+
+    for (distance = 0x1; newrank >= 0 && distance < adjsize; distance <<= 1) {
+        newremote = newrank ^ distance;
+        remote = (newremote < extra_ranks) ?
+            (newremote * 2 + 1) : (newremote + extra_ranks);
+
+        if (NULL == (step = tuned_plan_next_step(req))) {
+            return OMPI_ERR_OUT_OF_RESOURCE;
+        }
+        err = tuned_plan_recv(req, step, tmprecv, count, remote);
+        if (OMPI_SUCCESS != err) {
+            return err;
+        }
+        err = tuned_plan_send(req, step, tmpsend, count, remote);
+        if (OMPI_SUCCESS != err) {
+            return err;
+        }
+
+        /* keep the order of the operands for non-commutative operations */
+        step->reduce_count = count;
+        if (rank < remote) {
+            step->reduce_src = tmpsend;
+            step->reduce_dst = tmprecv;
+            tmpswap = tmprecv;
+            tmprecv = tmpsend;
+            tmpsend = tmpswap;
+        } else {
+            step->reduce_src = tmprecv;
+            step->reduce_dst = tmpsend;
+        }
+    }
+
+    if (rank < (2 * extra_ranks)) {
+        if (NULL == (step = tuned_plan_next_step(req))) {
+            return OMPI_ERR_OUT_OF_RESOURCE;
+        }
+        if (0 == (rank % 2)) {
+            err = tuned_plan_recv(req, step, (char *) req->rbuf, count, rank + 1);
+            tmpsend = (char *) req->rbuf;
+        } else {
+            err = tuned_plan_send(req, step, tmpsend, count, rank - 1);
+        }
+        if (OMPI_SUCCESS != err) {
+            return err;
+        }
+    }
+
+    /* make sure that the final result ends up in rbuf */
+    if (tmpsend != (char *) req->rbuf) {
+        step = &req->steps[req->nsteps - 1];
+        step->copy_src = tmpsend;
+        step->copy_dst = (char *) req->rbuf;
+        step->copy_count = count;
+    }
+
+    return OMPI_SUCCESS;
+}
+
+static int
+tuned_allreduce_plan_ring(ompi_coll_tuned_persistent_request_t *req)
+{
+    ompi_coll_tuned_plan_step_t *step;
+    int rank, size, send_to, recv_from, err;
+    size_t early_blockcount, late_blockcount, split_rank;
+    ptrdiff_t lb, extent, span, gap = 0;
+    size_t block_count[2];
+    char *tmprecv;
+
+    rank = ompi_comm_rank(req->comm);
+    size = ompi_comm_size(req->comm);
+    send_to = (rank + 1) % size;
+    recv_from = (rank + size - 1) % size;
+
+    COLL_BASE_COMPUTE_BLOCKCOUNT(req->count, (size_t) size, split_rank,
+                                 early_blockcount, late_blockcount);
+    block_count[0] = early_blockcount;
+    block_count[1] = late_blockcount;
+
+    ompi_datatype_get_extent(req->dtype, &lb, &extent);
+
+    span = opal_datatype_span(&req->dtype->super, early_blockcount, &gap);
+    req->tmpbuf_free = (char *) malloc(span);
+    if (NULL == req->tmpbuf_free) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+    tmprecv = req->tmpbuf_free - gap;
+
+#define RING_BLOCK(b)                                                   \
+    ((char *) req->rbuf + extent * (((size_t) (b) < split_rank) ?       \
+        (ptrdiff_t) ((b) * early_blockcount) :                          \
+        (ptrdiff_t) ((b) * late_blockcount + split_rank)))
+#define RING_COUNT(b) block_count[(size_t) (b) < split_rank ? 0 : 1]
+
+    /* reduce-scatter: at step k, forward block (rank - k) and accumulate
+     * block (rank - k - 1); block (rank + 1) ends up fully reduced */
+    for (int k = 0; k < size - 1; k++) {
+        int sblock = (rank - k + size) % size;
+        int rblock = (rank - k - 1 + 2 * size) % size;
+
+        if (NULL == (step = tuned_plan_next_step(req))) {
+            return OMPI_ERR_OUT_OF_RESOURCE;
+        }
+        err = tuned_plan_recv(req, step, tmprecv, RING_COUNT(rblock), recv_from);
+        if (OMPI_SUCCESS != err) {
+            return err;
+        }
+        err = tuned_plan_send(req, step, RING_BLOCK(sblock), RING_COUNT(sblock), send_to);
+        if (OMPI_SUCCESS != err) {
+            return err;
+        }
+        step->reduce_src = tmprecv;
+        step->reduce_dst = RING_BLOCK(rblock);
+        step->reduce_count = RING_COUNT(rblock);
+    }
+
+    /* allgather: at step k, forward block (rank + 1 - k) and receive
+     * block (rank - k) straight into place */
+    for (int k = 0; k < size - 1; k++) {
+        int sblock = (rank + 1 - k + size) % size;
+        int rblock = (rank - k + size) % size;
+
+        if (NULL == (step = tuned_plan_next_step(req))) {
+            return OMPI_ERR_OUT_OF_RESOURCE;
+        }
+        err = tuned_plan_recv(req, step, RING_BLOCK(rblock), RING_COUNT(rblock), recv_from);
+        if (OMPI_SUCCESS != err) {
+            return err;
+        }
+        err = tuned_plan_send(req, step, RING_BLOCK(sblock), RING_COUNT(sblock), send_to);
+        if (OMPI_SUCCESS != err) {
+            return err;
+        }
+    }
+
+#undef RING_BLOCK
+#undef RING_COUNT
+
+    return OMPI_SUCCESS;
+}
+
+int ompi_coll_tuned_allreduce_intra_init(const void *sbuf, void *rbuf, size_t count,
+                                         struct ompi_datatype_t *dtype,
+                                         struct ompi_op_t *op,
+                                         struct ompi_communicator_t *comm,
+                                         struct ompi_info_t *info,
+                                         ompi_request_t **request,
+                                         mca_coll_base_module_t *module)
+{
+    mca_coll_tuned_module_t *tuned_module = (mca_coll_tuned_module_t *) module;
+    ompi_coll_tuned_persistent_request_t *req;
+    int size, alg, faninout = 0, segsize = 0, err = OMPI_SUCCESS;
+    size_t dsize;
+
+    size = ompi_comm_size(comm);
+
+    ompi_datatype_type_size(dtype, &dsize);
+    dsize *= count;
+
+    alg = tuned_persistent_decision(tuned_module, ALLREDUCE, dsize, &faninout, &segsize);
+    if (0 == alg) {
+        alg = ompi_coll_tuned_allreduce_intra_fixed_alg(size, dsize, ompi_op_is_commute(op));
+    }
+
+    OPAL_OUTPUT_VERBOSE((COLL_TUNED_TRACING_VERBOSE, ompi_coll_tuned_stream,
+        "coll:tuned:allreduce_intra_init algorithm %d", alg));
+
+    req = tuned_persistent_alloc(comm, dtype, op, sbuf, rbuf, count);
+    if (NULL == req) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+
+    if (0 < count) {
+        if ((4 == alg || 5 == alg || 6 == alg) && ompi_op_is_commute(op)
+            && count >= (size_t) size) {
+            err = tuned_allreduce_plan_ring(req);
+        } else {
+            err = tuned_allreduce_plan_recursive_doubling(req);
+        }
+    }
+
+    if (OMPI_SUCCESS != err) {
+        tuned_persistent_destroy(req);
+        return err;
+    }
+
+    *request = &req->super;
+    return OMPI_SUCCESS;
+}
+
+/*
+ * Bcast
+ *
+ * All algorithms are planned as a segmented pipeline along the tree of the
+ * selected algorithm (see ompi_coll_tuned_bcast_intra_build_tree). At step
+ * i, an interior rank receives segment i from its parent and forwards
+ * segment i - 1 to its children. The root and the leaves post all their
+ * segments at once.
+ */
+
+static int
+tuned_bcast_plan_pipeline(ompi_coll_tuned_persistent_request_t *req, int root,
+                          size_t segcount)
+{
+    ompi_coll_tuned_plan_step_t *step;
+    ompi_coll_tree_t *tree = req->tree;
+    int rank, num_segments, err;
+    ptrdiff_t lb, extent;
+    size_t count = req->count;
+
+    rank = ompi_comm_rank(req->comm);
+    num_segments = (int) ((count + segcount - 1) / segcount);
+
+    ompi_datatype_get_extent(req->dtype, &lb, &extent);
+
+#define SEG_BUF(i)   ((char *) req->rbuf + (ptrdiff_t) (i) * (ptrdiff_t) segcount * extent)
+#define SEG_COUNT(i) ((i) == num_segments - 1 ? count - (size_t) (i) * segcount : segcount)
+
+    if (rank == root || 0 == tree->tree_nextsize) {
+        if (NULL == (step = tuned_plan_next_step(req))) {
+            return OMPI_ERR_OUT_OF_RESOURCE;
+        }
+        for (int i = 0; i < num_segments; i++) {
+            if (rank == root) {
+                for (int c = 0; c < tree->tree_nextsize; c++) {
+                    err = tuned_plan_send(req, step, SEG_BUF(i), SEG_COUNT(i),
+                                          tree->tree_next[c]);
+                    if (OMPI_SUCCESS != err) {
+                        return err;
+                    }
+                }
+            } else {
+                err = tuned_plan_recv(req, step, SEG_BUF(i), SEG_COUNT(i),
+                                      tree->tree_prev);
+                if (OMPI_SUCCESS != err) {
+                    return err;
+                }
+            }
+        }
+        return OMPI_SUCCESS;
+    }
+
+    for (int i = 0; i <= num_segments; i++) {
+        if (NULL == (step = tuned_plan_next_step(req))) {
+            return OMPI_ERR_OUT_OF_RESOURCE;
+        }
+        if (i < num_segments) {
+            err = tuned_plan_recv(req, step, SEG_BUF(i), SEG_COUNT(i), tree->tree_prev);
+            if (OMPI_SUCCESS != err) {
+                return err;
+            }
+        }
+        if (i > 0) {
+            for (int c = 0; c < tree->tree_nextsize; c++) {
+                err = tuned_plan_send(req, step, SEG_BUF(i - 1), SEG_COUNT(i - 1),
+                                      tree->tree_next[c]);
+                if (OMPI_SUCCESS != err) {
+                    return err;
+                }
+            }
+        }
+    }
+
+#undef SEG_BUF
+#undef SEG_COUNT
+
+    return OMPI_SUCCESS;
+}
+
+int ompi_coll_tuned_bcast_intra_init(void *buff, size_t count,
+                                     struct ompi_datatype_t *datatype, int root,
+                                     struct ompi_communicator_t *comm,
+                                     struct ompi_info_t *info,
+                                     ompi_request_t **request,
+                                     mca_coll_base_module_t *module)
+{
+    mca_coll_tuned_module_t *tuned_module = (mca_coll_tuned_module_t *) module;
+    ompi_coll_tuned_persistent_request_t *req;
+    int alg, faninout = 0, segsize = 0, err = OMPI_SUCCESS;
+    size_t dsize, segcount = count;
+
+    ompi_datatype_type_size(datatype, &dsize);
+
+    alg = tuned_persistent_decision(tuned_module, BCAST, dsize * count, &faninout, &segsize);
+    if (0 == alg) {
+        alg = ompi_coll_tuned_bcast_intra_fixed_alg(ompi_comm_size(comm), dsize * count);
+    }
+
+    OPAL_OUTPUT_VERBOSE((COLL_TUNED_TRACING_VERBOSE, ompi_coll_tuned_stream,
+        "coll:tuned:bcast_intra_init algorithm %d faninout %d segsize %d",
+        alg, faninout, segsize));
+
+    /* sbuf == rbuf: nothing is copied at start */
+    req = tuned_persistent_alloc(comm, datatype, &ompi_mpi_op_no_op.op, buff, buff, count);
+    if (NULL == req) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+
+    if (0 < count && 0 < dsize) {
+        if (0 < segsize) {
+            COLL_BASE_COMPUTED_SEGCOUNT((size_t) segsize, dsize, segcount);
+        }
+
+        req->tree = ompi_coll_tuned_bcast_intra_build_tree(comm, root, alg, faninout);
+        if (NULL == req->tree) {
+            err = OMPI_ERR_OUT_OF_RESOURCE;
+        } else {
+            err = tuned_bcast_plan_pipeline(req, root, segcount);
+        }
+    }
+
+    if (OMPI_SUCCESS != err) {
+        tuned_persistent_destroy(req);
+        return err;
+    }
+
+    *request = &req->super;
+    return OMPI_SUCCESS;
+}
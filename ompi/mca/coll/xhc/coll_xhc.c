@@ -16,6 +16,7 @@
 #include "ompi/mca/coll/coll.h"
 
 #include "opal/class/opal_hash_table.h"
+#include "opal/include/opal/align.h"
 #include "opal/mca/rcache/rcache.h"
 #include "opal/mca/shmem/base/base.h"
 #include "opal/mca/smsc/smsc.h"
@@ -29,6 +30,8 @@
 
 static int xhc_alloc_bcast_cico(xhc_module_t *module,
     ompi_communicator_t *comm);
+static int xhc_alloc_xchg(xhc_module_t *module,
+    ompi_communicator_t *comm);
 
 static int xhc_print_config_info(xhc_module_t *module,
     ompi_communicator_t *comm);
@@ -137,6 +140,15 @@ int mca_coll_xhc_init_op(xhc_module_t *module,
         if(OMPI_SUCCESS != err) {RETURN_WITH_ERROR(return_code, err, end);}
     }
 
+    /* The exchange segment is shared by all exchange primitives, and is
+     * allocated by whichever of them is first initialized. All ranks
+     * initialize the same op at the same time, so this is consistent. */
+    if(XHC_COLLTYPE_IS_XCHG(colltype)
+            && NULL == module->peer_info[module->rank].xchg_seg) {
+        err = xhc_alloc_xchg(module, comm);
+        if(OMPI_SUCCESS != err) {RETURN_WITH_ERROR(return_code, err, end);}
+    }
+
     // ---
 
     /* Check if a hierarchy for this hierarchy string has already been
@@ -277,6 +289,89 @@ static int xhc_alloc_bcast_cico(xhc_module_t *module, ompi_communicator_t *comm)
     return return_code;
 }
 
+/* Each rank owns one segment for the exchange primitives, where it publishes
+ * the location of its data. It contains one control struct per primitive,
+ * a table of per-peer displacements (for the v-variants that need it), and
+ * one CICO buffer per primitive. */
+static int xhc_alloc_xchg(xhc_module_t *module, ompi_communicator_t *comm) {
+    opal_shmem_ds_t *ds_list = NULL;
+    opal_shmem_ds_t xchg_ds;
+    void *xchg_seg = NULL;
+    xhc_coll_fns_t xhc_fns;
+
+    int err, return_code = OMPI_SUCCESS;
+
+    int comm_size = ompi_comm_size(comm);
+    int rank = ompi_comm_rank(comm);
+
+    xhc_xchg_layout_t *layout = &module->xchg_layout;
+
+    size_t smsc_reg_size = 0;
+    size_t pos = 0;
+
+    if(mca_smsc_base_has_feature(MCA_SMSC_FEATURE_REQUIRE_REGISTRATION)) {
+        smsc_reg_size = mca_smsc_base_registration_data_size();
+    }
+
+    for(int t = XHC_ALLGATHER; t <= XHC_ALLTOALLV; t++) {
+        layout->ctrl_offset[t] = pos;
+        pos += OPAL_ALIGN(sizeof(xhc_xchg_ctrl_t)
+            + smsc_reg_size, XHC_ALIGN, size_t);
+    }
+
+    layout->disp_offset = pos;
+    pos += OPAL_ALIGN(comm_size * sizeof(size_t), XHC_ALIGN, size_t);
+
+    for(int t = XHC_ALLGATHER; t <= XHC_ALLTOALLV; t++) {
+        layout->cico_offset[t] = pos;
+        pos += OPAL_ALIGN(module->op_config[t].cico_max, XHC_ALIGN, size_t);
+    }
+
+    layout->size = pos;
+
+    xhc_module_set_coll_fns(comm, &module->prev_colls, &xhc_fns);
+
+    // --
+
+    ds_list = malloc(comm_size * sizeof(opal_shmem_ds_t));
+    if(!ds_list) {RETURN_WITH_ERROR(return_code, OMPI_ERR_OUT_OF_RESOURCE, end);}
+
+    xchg_seg = xhc_shmem_create(&xchg_ds, layout->size, comm, "xchg", 0, 0);
+    if(!xchg_seg) {RETURN_WITH_ERROR(return_code, OMPI_ERR_OUT_OF_RESOURCE, end);}
+
+    // Touch to allocate in the local NUMA node (see xhc_alloc_bcast_cico)
+    memset(xchg_seg, 0, layout->size);
+
+    err = comm->c_coll->coll_allgather(&xchg_ds, sizeof(opal_shmem_ds_t),
+        MPI_BYTE, ds_list, sizeof(opal_shmem_ds_t), MPI_BYTE, comm,
+        comm->c_coll->coll_allgather_module);
+    if(OMPI_SUCCESS != err) {RETURN_WITH_ERROR(return_code, err, end);}
+
+    module->peer_info[rank].xchg_ds = xchg_ds;
+    module->peer_info[rank].xchg_seg = xchg_seg;
+
+    for(int r = 0; r < comm_size; r++) {
+        if(r == rank) {continue;}
+        module->peer_info[r].xchg_ds = ds_list[r];
+    }
+
+    // --
+
+    end:
+
+    free(ds_list);
+    xhc_module_set_coll_fns(comm, &xhc_fns, NULL);
+
+    if(OMPI_SUCCESS != return_code) {
+        if(xchg_seg) {
+            opal_shmem_unlink(&xchg_ds);
+            opal_shmem_segment_detach(&xchg_ds);
+        }
+    }
+
+    return return_code;
+}
+
 void mca_coll_xhc_fini(mca_coll_xhc_module_t *module) {
     if(module->peer_info) {
         for(int r = 0; r < module->comm_size; r++) {
@@ -292,6 +387,10 @@ void mca_coll_xhc_fini(mca_coll_xhc_module_t *module) {
 
                 opal_shmem_segment_detach(&module->peer_info[r].cico_ds);
             }
+
+            if(module->peer_info[r].xchg_seg) {
+                opal_shmem_segment_detach(&module->peer_info[r].xchg_ds);
+            }
         }
 
         free(module->peer_info);
@@ -449,7 +548,7 @@ int mca_coll_xhc_read_op_config(xhc_module_t *module,
 
     /* Enforce a resonable minimum chunk size */
 
-    if(XHC_BARRIER != colltype) {
+    if(XHC_COLLTYPE_HAS_CHUNKS(colltype)) {
         bool altered_chunks = false;
         for(int i = 0; i < config->chunks_len; i++) {
             if(config->chunks[i] < XHC_MIN_CHUNK_SIZE) {
@@ -536,6 +635,14 @@ static int xhc_print_config_info(xhc_module_t *module, ompi_communicator_t *comm
                 "    Hierarchy: %s (source: %s)\n",
                 xhc_colltype_to_str(t),
                 config->hierarchy_string, xhc_config_source_to_str(config->hierarchy_source));
+        } else if(!XHC_COLLTYPE_HAS_CHUNKS(t)) {
+            printf("\n"
+                "  [%s]\n"
+                "    Hierarchy: %s (source: %s)\n"
+                "    CICO: Up to %zu bytes (source: %s)\n",
+                xhc_colltype_to_str(t),
+                config->hierarchy_string, xhc_config_source_to_str(config->hierarchy_source),
+                config->cico_max, xhc_config_source_to_str(config->cico_max_source));
         } else {
             printf("\n"
                 "  [%s]\n"
@@ -588,7 +695,7 @@ static int xhc_print_op_info(xhc_module_t *module,
             }
         }
 
-        if(XHC_BARRIER == colltype) {
+        if(!XHC_COLLTYPE_HAS_CHUNKS(colltype)) {
             printf("XHC_COMM ompi_comm=%s rank=%d op=%s loc=0x%08x members=%d [%s]\n",
                 comm->c_name, rank, xhc_colltype_to_str(colltype), comms[i].locality,
                 comms[i].size, memb_list);
@@ -652,6 +759,10 @@ static int xhc_print_op_hierarchy_dot(xhc_module_t *module,
             case XHC_REDUCE: case XHC_ALLREDUCE:
                 dir = "back"; break;
             case XHC_BARRIER:
+            case XHC_ALLGATHER: case XHC_ALLGATHERV:
+            case XHC_GATHER: case XHC_GATHERV:
+            case XHC_SCATTER: case XHC_SCATTERV:
+            case XHC_ALLTOALL: case XHC_ALLTOALLV:
                 dir = "both"; break;
             default:
                 dir = "none";
@@ -737,6 +848,14 @@ void *mca_coll_xhc_get_cico(xhc_peer_info_t *peer_info, int rank) {
     return peer_info[rank].cico_buffer;
 }
 
+void *mca_coll_xhc_get_xchg(xhc_peer_info_t *peer_info, int rank) {
+    if(NULL == peer_info[rank].xchg_seg) {
+        peer_info[rank].xchg_seg = xhc_shmem_attach(&peer_info[rank].xchg_ds);
+    }
+
+    return peer_info[rank].xchg_seg;
+}
+
 static mca_smsc_endpoint_t *xhc_smsc_ep(xhc_peer_info_t *peer_info) {
     if(!peer_info->smsc_ep) {
         peer_info->smsc_ep = MCA_SMSC_CALL(get_endpoint, &peer_info->proc->super);
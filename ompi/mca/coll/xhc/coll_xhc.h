@@ -27,8 +27,11 @@
 #include "ompi/communicator/communicator.h"
 #include "ompi/datatype/ompi_datatype.h"
 #include "ompi/op/op.h"
+#include "ompi/request/request.h"
 
+#include "opal/class/opal_free_list.h"
 #include "opal/class/opal_hash_table.h"
+#include "opal/mca/memcpy/base/base.h"
 #include "opal/mca/shmem/shmem.h"
 #include "opal/mca/smsc/smsc.h"
 #include "opal/util/minmax.h"
@@ -123,6 +126,9 @@ typedef struct xhc_comm_ctrl_t xhc_comm_ctrl_t;
 typedef struct xhc_member_ctrl_t xhc_member_ctrl_t;
 typedef struct xhc_member_info_t xhc_member_info_t;
 
+typedef struct xhc_xchg_ctrl_t xhc_xchg_ctrl_t;
+typedef struct xhc_xchg_layout_t xhc_xchg_layout_t;
+
 typedef struct xhc_sh_slice_t xhc_sh_slice_t;
 typedef struct xhc_reduce_queue_item_t xhc_rq_item_t;
 typedef struct xhc_reduce_area_t xhc_reduce_area_t;
@@ -133,6 +139,7 @@ typedef struct xhc_loc_def_t xhc_loc_def_t;
 OMPI_DECLSPEC extern mca_coll_xhc_component_t mca_coll_xhc_component;
 OMPI_DECLSPEC OBJ_CLASS_DECLARATION(mca_coll_xhc_module_t);
 OMPI_DECLSPEC OBJ_CLASS_DECLARATION(xhc_rq_item_t);
+OMPI_DECLSPEC OBJ_CLASS_DECLARATION(xhc_request_t);
 OMPI_DECLSPEC OBJ_CLASS_DECLARATION(xhc_loc_def_item_t);
 
 // ----------------------------------------
@@ -168,16 +175,48 @@ typedef enum xhc_reduce_load_balance_enum_t {
  * 1. xhc_colltype_to_universal_map[]
  * 2. xhc_colltype_to_c_coll_fn_offset_map[]
  * 3. xhc_colltype_to_c_coll_module_offset_map[]
- * 4. xhc_colltype_to_coll_base_fn_offset_map[] */
+ * 4. xhc_colltype_to_coll_base_fn_offset_map[]
+ *
+ * The exchange primitives (see coll_xhc_xchg.c) must remain
+ * contiguous, between XHC_ALLGATHER and XHC_ALLTOALLV.
+ *
+ * The request-based variants come after XHC_COLLCOUNT. They only have a
+ * fallback/API slot, and share the op config and op data (hierarchy,
+ * sequence numbers) of their blocking counterpart. */
 typedef enum XHC_COLLTYPE_T {
     XHC_BCAST = 0,
     XHC_BARRIER,
     XHC_REDUCE,
     XHC_ALLREDUCE,
 
-    XHC_COLLCOUNT
+    XHC_ALLGATHER,
+    XHC_ALLGATHERV,
+    XHC_GATHER,
+    XHC_GATHERV,
+    XHC_SCATTER,
+    XHC_SCATTERV,
+    XHC_ALLTOALL,
+    XHC_ALLTOALLV,
+
+    XHC_COLLCOUNT,
+
+    XHC_IBCAST = XHC_COLLCOUNT,
+    XHC_IBARRIER,
+    XHC_IALLREDUCE,
+    XHC_BCAST_INIT,
+    XHC_BARRIER_INIT,
+    XHC_ALLREDUCE_INIT,
+
+    XHC_COLLCOUNT_ALL
 } XHC_COLLTYPE_T;
 
+#define XHC_COLLTYPE_IS_XCHG(colltype) \
+    ((colltype) >= XHC_ALLGATHER && (colltype) <= XHC_ALLTOALLV)
+
+/* Ops without a pipeline, for which the chunk size is not applicable */
+#define XHC_COLLTYPE_HAS_CHUNKS(colltype) \
+    (XHC_BARRIER != (colltype) && !XHC_COLLTYPE_IS_XCHG(colltype))
+
 typedef enum xhc_config_source_t {
     XHC_CONFIG_SOURCE_INFO_GLOBAL = 0,
     XHC_CONFIG_SOURCE_INFO_OP,
@@ -225,6 +264,10 @@ struct mca_coll_xhc_component_t {
     } op_mca[XHC_COLLCOUNT];
 
     xhc_op_mca_t op_mca_global;
+
+    // Non-blocking & persistent requests (see coll_xhc_request.c)
+    opal_free_list_t requests;
+    ompi_coll_base_progress_queue_t active_requests;
 };
 
 struct mca_coll_xhc_module_t {
@@ -233,8 +276,8 @@ struct mca_coll_xhc_module_t {
     /* pointers to functions/modules of
      * previous coll components for fallback */
     struct xhc_coll_fns_t {
-        void (*coll_fn[XHC_COLLCOUNT])(void);
-        void *coll_module[XHC_COLLCOUNT];
+        void (*coll_fn[XHC_COLLCOUNT_ALL])(void);
+        void *coll_module[XHC_COLLCOUNT_ALL];
     } prev_colls;
 
     // copied from OMPI comm
@@ -259,8 +302,20 @@ struct mca_coll_xhc_module_t {
 
         opal_shmem_ds_t cico_ds;
         void *cico_buffer;
+
+        opal_shmem_ds_t xchg_ds;
+        void *xchg_seg;
     } *peer_info;
 
+    /* Layout of the per-rank segment shared by the exchange
+     * primitives (see xhc_alloc_xchg); same for all ranks */
+    struct xhc_xchg_layout_t {
+        size_t ctrl_offset[XHC_COLLCOUNT];
+        size_t cico_offset[XHC_COLLCOUNT];
+        size_t disp_offset;
+        size_t size;
+    } xchg_layout;
+
     // ---
 
     opal_hash_table_t hierarchy_cache;
@@ -291,6 +346,12 @@ struct mca_coll_xhc_module_t {
         bool init;
     } op_data[XHC_COLLCOUNT];
 
+    /* Request-based ops are executed one at a time, in the order that
+     * they were started in; each gets a ticket, and may proceed once
+     * all the ones before it have been retired. */
+    size_t nb_posted;
+    size_t nb_retired;
+
     bool init;
     bool error;
 };
@@ -450,6 +511,20 @@ struct xhc_member_ctrl_t {
     };
 } __attribute__((aligned(XHC_ALIGN)));
 
+/* Per-rank control struct of the exchange primitives. Each rank publishes
+ * here the location of the data it makes available to others in the op. */
+struct xhc_xchg_ctrl_t {
+    volatile xf_sig_t seq;
+
+    // below fields in same cache line as seq
+
+    volatile int method;
+    volatile xf_size_t data_len;
+    void* volatile data_vaddr;
+
+    volatile char access_token[];
+} __attribute__((aligned(XHC_ALIGN)));
+
 // -----
 
 struct xhc_reduce_queue_item_t {
@@ -502,11 +577,109 @@ typedef struct xhc_bcast_ctx_t {
     xhc_copy_data_t *region_data;
     xhc_reg_t *reg;
 
+    /* With persistent requests, the exposed region and the attachment
+     * to the source buffer are kept across ops (see xhc_bcast_release) */
+    bool persistent;
+    void *reg_vaddr;
+    void *reg_buffer;
+    int reg_rank;
+
+    // Resume point of xhc_bcast_ack_test()
+    xhc_comm_t *ack_comm;
+    int ack_member;
+
     size_t bytes_total;
     size_t bytes_avail;
     size_t bytes_done;
 } xhc_bcast_ctx_t;
 
+typedef struct xhc_barrier_ctx_t {
+    xhc_comm_t *comms;
+    xhc_peer_info_t *peer_info;
+
+    int rank;
+    int root;
+
+    xf_sig_t seq;
+
+    // Resume point of xhc_barrier_test()
+    xhc_comm_t *xc;
+    int member;
+} xhc_barrier_ctx_t;
+
+typedef struct xhc_allreduce_ctx_t {
+    const void *sbuf;
+    void *rbuf;
+    size_t count;
+    ompi_datatype_t *datatype;
+    ompi_op_t *op;
+    ompi_communicator_t *ompi_comm;
+    xhc_module_t *module;
+
+    int rank;
+    int root;
+
+    xf_sig_t seq;
+    xhc_comm_t *comms;
+
+    size_t dtype_size;
+    size_t bytes_total;
+    size_t bytes_done;
+
+    xhc_copy_method_t method;
+    xhc_reduce_load_balance_enum_t lb_policy;
+    bool out_of_order_reduce;
+
+    xhc_bcast_ctx_t bcast_ctx;
+    bool bcast_started;
+
+    // Resume point of xhc_allreduce_test()
+    int state;
+    xhc_comm_t *state_comm;
+} xhc_allreduce_ctx_t;
+
+typedef struct xhc_xchg_ctx_t {
+    xhc_module_t *module;
+    XHC_COLLTYPE_T colltype;
+
+    int rank;
+    int root;
+
+    xf_sig_t seq;
+    xhc_comm_t *comms;
+
+    xhc_xchg_ctrl_t *my_ctrl;
+    xhc_copy_method_t method;
+
+    xhc_copy_data_t *region_data;
+} xhc_xchg_ctx_t;
+
+// ----------------------------------------
+
+typedef struct xhc_request_t xhc_request_t;
+
+/* Non-blocking and persistent ops (see coll_xhc_request.c). start_fn sets
+ * up the op once the request gets its turn on the module, and test_fn
+ * advances it, returning OMPI_ERR_WOULD_BLOCK until it has completed. */
+struct xhc_request_t {
+    ompi_request_t super;
+
+    xhc_module_t *module;
+    XHC_COLLTYPE_T colltype;
+
+    int (*start_fn)(xhc_request_t *req);
+    int (*test_fn)(xhc_request_t *req);
+
+    size_t ticket;
+    bool started;
+
+    union {
+        xhc_barrier_ctx_t barrier;
+        xhc_bcast_ctx_t bcast;
+        xhc_allreduce_ctx_t allreduce;
+    } ctx;
+};
+
 // ----------------------------------------
 
 // coll_xhc_component.c
@@ -567,6 +740,7 @@ void mca_coll_xhc_module_set_coll_fns(ompi_communicator_t *comm,
 #define xhc_read_op_config(...) mca_coll_xhc_read_op_config(__VA_ARGS__)
 
 #define xhc_get_cico(...) mca_coll_xhc_get_cico(__VA_ARGS__)
+#define xhc_get_xchg(...) mca_coll_xhc_get_xchg(__VA_ARGS__)
 
 #define xhc_shmem_create(...) mca_coll_xhc_shmem_create(__VA_ARGS__)
 #define xhc_shmem_attach(...) mca_coll_xhc_shmem_attach(__VA_ARGS__)
@@ -592,6 +766,7 @@ void *mca_coll_xhc_shmem_create(opal_shmem_ds_t *seg_ds, size_t size,
 void *mca_coll_xhc_shmem_attach(opal_shmem_ds_t *seg_ds);
 
 void *mca_coll_xhc_get_cico(xhc_peer_info_t *peer_info, int rank);
+void *mca_coll_xhc_get_xchg(xhc_peer_info_t *peer_info, int rank);
 
 int mca_coll_xhc_copy_expose_region(void *base, size_t len,
     xhc_copy_data_t **region_data);
@@ -624,6 +799,19 @@ int mca_coll_xhc_hierarchy_make(xhc_module_t *module,
     ompi_communicator_t *comm, const char *hierarchy_string,
     xhc_loc_t **hierarchy_dst, int *hierarchy_len_dst);
 
+// coll_xhc_request.c
+// ------------------
+
+#define xhc_request_alloc(...) mca_coll_xhc_request_alloc(__VA_ARGS__)
+#define xhc_request_post(...) mca_coll_xhc_request_post(__VA_ARGS__)
+
+xhc_request_t *mca_coll_xhc_request_alloc(xhc_module_t *module,
+    ompi_communicator_t *comm, XHC_COLLTYPE_T colltype, bool persistent);
+int mca_coll_xhc_request_post(xhc_request_t *req);
+
+int mca_coll_xhc_request_advance(ompi_request_t *request);
+int mca_coll_xhc_progress(void);
+
 // Primitives (respective file)
 // ----------------------------
 
@@ -641,27 +829,104 @@ int mca_coll_xhc_allreduce(const void *sbuf, void *rbuf,
     size_t count, ompi_datatype_t *datatype, ompi_op_t *op,
     ompi_communicator_t *comm, mca_coll_base_module_t *module);
 
+int mca_coll_xhc_allgather(const void *sbuf, size_t scount,
+    ompi_datatype_t *sdtype, void *rbuf, size_t rcount,
+    ompi_datatype_t *rdtype, ompi_communicator_t *comm,
+    mca_coll_base_module_t *module);
+
+int mca_coll_xhc_allgatherv(const void *sbuf, size_t scount,
+    ompi_datatype_t *sdtype, void *rbuf, ompi_count_array_t rcounts,
+    ompi_disp_array_t displs, ompi_datatype_t *rdtype,
+    ompi_communicator_t *comm, mca_coll_base_module_t *module);
+
+int mca_coll_xhc_gather(const void *sbuf, size_t scount,
+    ompi_datatype_t *sdtype, void *rbuf, size_t rcount,
+    ompi_datatype_t *rdtype, int root, ompi_communicator_t *comm,
+    mca_coll_base_module_t *module);
+
+int mca_coll_xhc_gatherv(const void *sbuf, size_t scount,
+    ompi_datatype_t *sdtype, void *rbuf, ompi_count_array_t rcounts,
+    ompi_disp_array_t displs, ompi_datatype_t *rdtype, int root,
+    ompi_communicator_t *comm, mca_coll_base_module_t *module);
+
+int mca_coll_xhc_scatter(const void *sbuf, size_t scount,
+    ompi_datatype_t *sdtype, void *rbuf, size_t rcount,
+    ompi_datatype_t *rdtype, int root, ompi_communicator_t *comm,
+    mca_coll_base_module_t *module);
+
+int mca_coll_xhc_scatterv(const void *sbuf, ompi_count_array_t scounts,
+    ompi_disp_array_t displs, ompi_datatype_t *sdtype, void *rbuf,
+    size_t rcount, ompi_datatype_t *rdtype, int root,
+    ompi_communicator_t *comm, mca_coll_base_module_t *module);
+
+int mca_coll_xhc_alltoall(const void *sbuf, size_t scount,
+    ompi_datatype_t *sdtype, void *rbuf, size_t rcount,
+    ompi_datatype_t *rdtype, ompi_communicator_t *comm,
+    mca_coll_base_module_t *module);
+
+int mca_coll_xhc_alltoallv(const void *sbuf, ompi_count_array_t scounts,
+    ompi_disp_array_t sdispls, ompi_datatype_t *sdtype, void *rbuf,
+    ompi_count_array_t rcounts, ompi_disp_array_t rdispls,
+    ompi_datatype_t *rdtype, ompi_communicator_t *comm,
+    mca_coll_base_module_t *module);
+
+int mca_coll_xhc_ibcast(void *buf, size_t count, ompi_datatype_t *datatype,
+    int root, ompi_communicator_t *comm, ompi_request_t **request,
+    mca_coll_base_module_t *module);
+
+int mca_coll_xhc_ibarrier(ompi_communicator_t *comm,
+    ompi_request_t **request, mca_coll_base_module_t *module);
+
+int mca_coll_xhc_iallreduce(const void *sbuf, void *rbuf,
+    size_t count, ompi_datatype_t *datatype, ompi_op_t *op,
+    ompi_communicator_t *comm, ompi_request_t **request,
+    mca_coll_base_module_t *module);
+
+int mca_coll_xhc_bcast_init(void *buf, size_t count, ompi_datatype_t *datatype,
+    int root, ompi_communicator_t *comm, ompi_info_t *info,
+    ompi_request_t **request, mca_coll_base_module_t *module);
+
+int mca_coll_xhc_barrier_init(ompi_communicator_t *comm, ompi_info_t *info,
+    ompi_request_t **request, mca_coll_base_module_t *module);
+
+int mca_coll_xhc_allreduce_init(const void *sbuf, void *rbuf,
+    size_t count, ompi_datatype_t *datatype, ompi_op_t *op,
+    ompi_communicator_t *comm, ompi_info_t *info,
+    ompi_request_t **request, mca_coll_base_module_t *module);
+
+// coll_xhc_barrier.c
+// ------------------
+
+#define xhc_barrier_internal(...) mca_coll_xhc_barrier_internal(__VA_ARGS__)
+
+void mca_coll_xhc_barrier_internal(xhc_comm_t *comms,
+    xhc_peer_info_t *peer_info, int rank, int root, xf_sig_t seq);
+
 // coll_xhc_bcast.c
 // ----------------
 
 #define xhc_bcast_notify(...) mca_coll_xhc_bcast_notify(__VA_ARGS__)
-#define xhc_bcast_init(...) mca_coll_xhc_bcast_init(__VA_ARGS__)
+#define xhc_bcast_ctx_init(...) mca_coll_xhc_bcast_ctx_init(__VA_ARGS__)
 #define xhc_bcast_start(...) mca_coll_xhc_bcast_start(__VA_ARGS__)
 #define xhc_bcast_work(...) mca_coll_xhc_bcast_work(__VA_ARGS__)
 #define xhc_bcast_ack(...) mca_coll_xhc_bcast_ack(__VA_ARGS__)
+#define xhc_bcast_ack_test(...) mca_coll_xhc_bcast_ack_test(__VA_ARGS__)
 #define xhc_bcast_fini(...) mca_coll_xhc_bcast_fini(__VA_ARGS__)
+#define xhc_bcast_release(...) mca_coll_xhc_bcast_release(__VA_ARGS__)
 
 void mca_coll_xhc_bcast_notify(xhc_bcast_ctx_t *ctx,
     xhc_comm_t *xc, size_t bytes_ready);
 
-int mca_coll_xhc_bcast_init(void *buf, size_t count, ompi_datatype_t *datatype,
+int mca_coll_xhc_bcast_ctx_init(void *buf, size_t count, ompi_datatype_t *datatype,
     int root, ompi_communicator_t *ompi_comm, xhc_module_t *module,
-    xhc_bcast_ctx_t *ctx_dst);
+    bool persistent, xhc_bcast_ctx_t *ctx_dst);
 
 int mca_coll_xhc_bcast_start(xhc_bcast_ctx_t *ctx);
 int mca_coll_xhc_bcast_work(xhc_bcast_ctx_t *ctx);
 void mca_coll_xhc_bcast_ack(xhc_bcast_ctx_t *ctx);
+int mca_coll_xhc_bcast_ack_test(xhc_bcast_ctx_t *ctx);
 void mca_coll_xhc_bcast_fini(xhc_bcast_ctx_t *ctx);
+void mca_coll_xhc_bcast_release(xhc_bcast_ctx_t *ctx);
 
 // coll_xhc_allreduce.c
 // --------------------
@@ -672,6 +937,49 @@ int mca_coll_xhc_allreduce_internal(const void *sbuf, void *rbuf, size_t count,
     ompi_datatype_t *datatype, ompi_op_t *op, ompi_communicator_t *ompi_comm,
     mca_coll_base_module_t *module, bool require_bcast);
 
+// coll_xhc_xchg.c
+// ---------------
+
+#define xhc_xchg_dtype_flat(...) mca_coll_xhc_xchg_dtype_flat(__VA_ARGS__)
+#define xhc_xchg_pack(...) mca_coll_xhc_xchg_pack(__VA_ARGS__)
+#define xhc_xchg_unpack(...) mca_coll_xhc_xchg_unpack(__VA_ARGS__)
+#define xhc_xchg_packed_displs(...) mca_coll_xhc_xchg_packed_displs(__VA_ARGS__)
+#define xhc_xchg_pack_v(...) mca_coll_xhc_xchg_pack_v(__VA_ARGS__)
+#define xhc_xchg_unpack_v(...) mca_coll_xhc_xchg_unpack_v(__VA_ARGS__)
+#define xhc_xchg_init(...) mca_coll_xhc_xchg_init(__VA_ARGS__)
+#define xhc_xchg_publish(...) mca_coll_xhc_xchg_publish(__VA_ARGS__)
+#define xhc_xchg_publish_v(...) mca_coll_xhc_xchg_publish_v(__VA_ARGS__)
+#define xhc_xchg_peer_disp(...) mca_coll_xhc_xchg_peer_disp(__VA_ARGS__)
+#define xhc_xchg_copy_from(...) mca_coll_xhc_xchg_copy_from(__VA_ARGS__)
+#define xhc_xchg_fini(...) mca_coll_xhc_xchg_fini(__VA_ARGS__)
+
+bool mca_coll_xhc_xchg_dtype_flat(ompi_datatype_t *datatype);
+int mca_coll_xhc_xchg_pack(void *dst, const void *src,
+    size_t count, ompi_datatype_t *datatype);
+int mca_coll_xhc_xchg_unpack(void *dst, size_t count,
+    ompi_datatype_t *datatype, const void *src);
+size_t mca_coll_xhc_xchg_packed_displs(ompi_count_array_t counts,
+    int nblocks, ptrdiff_t *packed_displs);
+int mca_coll_xhc_xchg_pack_v(void *dst, const void *src,
+    ompi_count_array_t counts, ompi_disp_array_t displs,
+    const ptrdiff_t *packed_displs, int nblocks, ompi_datatype_t *datatype);
+int mca_coll_xhc_xchg_unpack_v(void *dst, ompi_count_array_t counts,
+    ompi_disp_array_t displs, const void *src,
+    const ptrdiff_t *packed_displs, int nblocks, ompi_datatype_t *datatype);
+
+void mca_coll_xhc_xchg_init(xhc_module_t *module,
+    ompi_communicator_t *ompi_comm, XHC_COLLTYPE_T colltype,
+    int root, xhc_xchg_ctx_t *ctx_dst);
+
+int mca_coll_xhc_xchg_publish(xhc_xchg_ctx_t *ctx,
+    const void *data, size_t len);
+int mca_coll_xhc_xchg_publish_v(xhc_xchg_ctx_t *ctx, const void *buf,
+    ompi_count_array_t counts, ompi_disp_array_t displs, size_t dtype_size);
+size_t mca_coll_xhc_xchg_peer_disp(xhc_xchg_ctx_t *ctx, int peer);
+int mca_coll_xhc_xchg_copy_from(xhc_xchg_ctx_t *ctx, int peer,
+    void *dst, size_t offset, size_t len);
+void mca_coll_xhc_xchg_fini(xhc_xchg_ctx_t *ctx);
+
 // ----------------------------------------
 
 /* Rollover-safe check that _flag_ has reached _thresh_,
@@ -722,7 +1030,8 @@ static inline void xhc_memcpy(void *dst, const void *src, size_t size) {
         size_t chunk = opal_min(size - copied,
             mca_coll_xhc_component.memcpy_chunk_size);
 
-        memcpy((char *) dst + copied, (char *) src + copied, chunk);
+        opal_memcpy_chunk((char *) dst + copied,
+            (char *) src + copied, chunk, size);
         copied += chunk;
     }
 }
@@ -732,6 +1041,14 @@ static inline void xhc_memcpy_offset(void *dst, const void *src,
     xhc_memcpy((char *) dst + offset, (char *) src + offset, size);
 }
 
+/* Wait for the module's outstanding request-based ops to complete.
+ * Blocking ops that share op data with them call this first. */
+static inline void xhc_request_drain(xhc_module_t *module) {
+    while(module->nb_retired != module->nb_posted) {
+        opal_progress();
+    }
+}
+
 // ----------------------------------------
 
 END_C_DECLS
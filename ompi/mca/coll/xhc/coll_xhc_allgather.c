@@ -0,0 +1,279 @@
+/*
+ * Copyright (c) 2021-2024 Computer Architecture and VLSI Systems (CARV)
+ *                         Laboratory, ICS Forth. All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+#include "mpi.h"
+
+#include "ompi/constants.h"
+#include "ompi/datatype/ompi_datatype.h"
+#include "ompi/communicator/communicator.h"
+
+#include "coll_xhc.h"
+
+// ------------------------------------------------
+
+/* Every rank publishes its block, and copies every other rank's block
+ * straight from it (see coll_xhc_xchg.c). Peers are visited starting
+ * from the next rank, to spread out the concurrent accesses. */
+static int xhc_allgather_internal(const void *sbuf, void *rbuf,
+        const ptrdiff_t *block_disp, const size_t *block_len,
+        ompi_communicator_t *ompi_comm, xhc_module_t *module,
+        XHC_COLLTYPE_T colltype) {
+
+    xhc_xchg_ctx_t ctx;
+    int err;
+
+    int rank = ompi_comm_rank(ompi_comm);
+    int comm_size = ompi_comm_size(ompi_comm);
+
+    char *my_block = (char *) rbuf + block_disp[rank];
+
+    xhc_xchg_init(module, ompi_comm, colltype, 0, &ctx);
+
+    err = xhc_xchg_publish(&ctx, (MPI_IN_PLACE == sbuf ? my_block : sbuf),
+        block_len[rank]);
+    if(OMPI_SUCCESS != err) {return err;}
+
+    if(MPI_IN_PLACE != sbuf && block_len[rank] > 0) {
+        xhc_memcpy(my_block, sbuf, block_len[rank]);
+    }
+
+    for(int i = 1; i < comm_size; i++) {
+        int peer = (rank + i) % comm_size;
+
+        err = xhc_xchg_copy_from(&ctx, peer, (char *) rbuf
+            + block_disp[peer], 0, block_len[peer]);
+        if(OMPI_SUCCESS != err) {return err;}
+    }
+
+    xhc_xchg_fini(&ctx);
+
+    return OMPI_SUCCESS;
+}
+
+// ------------------------------------------------
+
+int mca_coll_xhc_allgather(const void *sbuf, size_t scount,
+        ompi_datatype_t *sdtype, void *rbuf, size_t rcount,
+        ompi_datatype_t *rdtype, ompi_communicator_t *ompi_comm,
+        mca_coll_base_module_t *ompi_module) {
+
+    xhc_module_t *module = (xhc_module_t *) ompi_module;
+
+    ptrdiff_t *block_disp = NULL;
+    size_t *block_len = NULL;
+    size_t dtype_size;
+    int err;
+
+    const void *flat_sbuf = sbuf;
+    void *flat_rbuf = rbuf;
+    void *stmp = NULL, *rtmp = NULL;
+
+    int rank = ompi_comm_rank(ompi_comm);
+    int comm_size = ompi_comm_size(ompi_comm);
+
+    // ---
+
+    ompi_datatype_type_size(rdtype, &dtype_size);
+
+    if(!module->zcopy_support) {
+        size_t cico_size = module->op_config[XHC_ALLGATHER].cico_max;
+        if(rcount * dtype_size > cico_size) {
+            WARN_ONCE("coll:xhc: Warning: No smsc support; utilizing fallback "
+                "component for allgather greater than %zu bytes", cico_size);
+            goto _fallback;
+        }
+    }
+
+    // ---
+
+    if(!module->op_data[XHC_ALLGATHER].init) {
+        err = xhc_init_op(module, ompi_comm, XHC_ALLGATHER);
+        if(OMPI_SUCCESS != err) {goto _fallback_permanent;}
+    }
+
+    block_disp = malloc(comm_size * (sizeof(ptrdiff_t) + sizeof(size_t)));
+    if(!block_disp) {return OMPI_ERR_OUT_OF_RESOURCE;}
+
+    block_len = (size_t *) (block_disp + comm_size);
+
+    for(int r = 0; r < comm_size; r++) {
+        block_len[r] = rcount * dtype_size;
+        block_disp[r] = (ptrdiff_t) (r * block_len[r]);
+    }
+
+    if(MPI_IN_PLACE != sbuf && !xhc_xchg_dtype_flat(sdtype)) {
+        flat_sbuf = stmp = malloc(block_len[rank] + 1);
+        if(!stmp) {err = OMPI_ERR_OUT_OF_RESOURCE; goto _end;}
+
+        err = xhc_xchg_pack(stmp, sbuf, scount, sdtype);
+        if(OMPI_SUCCESS != err) {goto _end;}
+    }
+
+    if(!xhc_xchg_dtype_flat(rdtype)) {
+        flat_rbuf = rtmp = malloc(comm_size * block_len[rank] + 1);
+        if(!rtmp) {err = OMPI_ERR_OUT_OF_RESOURCE; goto _end;}
+
+        /* With MPI_IN_PLACE, the own block is published from rtmp */
+        if(MPI_IN_PLACE == sbuf) {
+            ptrdiff_t lb, extent;
+            ompi_datatype_get_extent(rdtype, &lb, &extent);
+
+            err = xhc_xchg_pack((char *) rtmp + block_disp[rank],
+                (char *) rbuf + rank * rcount * extent, rcount, rdtype);
+            if(OMPI_SUCCESS != err) {goto _end;}
+        }
+    }
+
+    err = xhc_allgather_internal(flat_sbuf, flat_rbuf, block_disp,
+        block_len, ompi_comm, module, XHC_ALLGATHER);
+
+    if(OMPI_SUCCESS == err && NULL != rtmp) {
+        err = xhc_xchg_unpack(rbuf, comm_size * rcount, rdtype, rtmp);
+    }
+
+_end:
+
+    free(block_disp);
+    free(stmp);
+    free(rtmp);
+
+    return err;
+
+    // ---
+
+_fallback_permanent:
+
+    XHC_INSTALL_FALLBACK(module,
+        ompi_comm, XHC_ALLGATHER, allgather);
+
+_fallback:
+
+    return XHC_CALL_FALLBACK(module->prev_colls, XHC_ALLGATHER, allgather,
+        sbuf, scount, sdtype, rbuf, rcount, rdtype, ompi_comm);
+}
+
+int mca_coll_xhc_allgatherv(const void *sbuf, size_t scount,
+        ompi_datatype_t *sdtype, void *rbuf, ompi_count_array_t rcounts,
+        ompi_disp_array_t displs, ompi_datatype_t *rdtype,
+        ompi_communicator_t *ompi_comm, mca_coll_base_module_t *ompi_module) {
+
+    xhc_module_t *module = (xhc_module_t *) ompi_module;
+
+    ptrdiff_t *block_disp = NULL, *packed_displs;
+    size_t *block_len = NULL;
+    size_t dtype_size;
+    int err;
+
+    const void *flat_sbuf = sbuf;
+    void *flat_rbuf = rbuf;
+    void *stmp = NULL, *rtmp = NULL;
+
+    int rank = ompi_comm_rank(ompi_comm);
+    int comm_size = ompi_comm_size(ompi_comm);
+
+    // ---
+
+    ompi_datatype_type_size(rdtype, &dtype_size);
+
+    /* All ranks know all the counts, so they
+     * all reach the same decision here */
+    if(!module->zcopy_support) {
+        size_t cico_size = module->op_config[XHC_ALLGATHERV].cico_max;
+
+        for(int r = 0; r < comm_size; r++) {
+            if(ompi_count_array_get(rcounts, r) * dtype_size > cico_size) {
+                WARN_ONCE("coll:xhc: Warning: No smsc support; utilizing fallback "
+                    "component for allgatherv greater than %zu bytes", cico_size);
+                goto _fallback;
+            }
+        }
+    }
+
+    // ---
+
+    if(!module->op_data[XHC_ALLGATHERV].init) {
+        err = xhc_init_op(module, ompi_comm, XHC_ALLGATHERV);
+        if(OMPI_SUCCESS != err) {goto _fallback_permanent;}
+    }
+
+    block_disp = malloc(comm_size * (2 * sizeof(ptrdiff_t) + sizeof(size_t)));
+    if(!block_disp) {return OMPI_ERR_OUT_OF_RESOURCE;}
+
+    packed_displs = block_disp + comm_size;
+    block_len = (size_t *) (packed_displs + comm_size);
+
+    for(int r = 0; r < comm_size; r++) {
+        block_len[r] = ompi_count_array_get(rcounts, r) * dtype_size;
+    }
+
+    if(MPI_IN_PLACE != sbuf && !xhc_xchg_dtype_flat(sdtype)) {
+        flat_sbuf = stmp = malloc(block_len[rank] + 1);
+        if(!stmp) {err = OMPI_ERR_OUT_OF_RESOURCE; goto _end;}
+
+        err = xhc_xchg_pack(stmp, sbuf, scount, sdtype);
+        if(OMPI_SUCCESS != err) {goto _end;}
+    }
+
+    if(xhc_xchg_dtype_flat(rdtype)) {
+        for(int r = 0; r < comm_size; r++) {
+            block_disp[r] = ompi_disp_array_get(displs, r) * (ptrdiff_t) dtype_size;
+        }
+    } else {
+        /* The blocks are gathered one after the other in a
+         * temporary buffer, and unpacked to rbuf at the end */
+        size_t total = xhc_xchg_packed_displs(rcounts, comm_size, packed_displs);
+
+        for(int r = 0; r < comm_size; r++) {
+            block_disp[r] = packed_displs[r] * (ptrdiff_t) dtype_size;
+        }
+
+        flat_rbuf = rtmp = malloc(total * dtype_size + 1);
+        if(!rtmp) {err = OMPI_ERR_OUT_OF_RESOURCE; goto _end;}
+
+        if(MPI_IN_PLACE == sbuf) {
+            ptrdiff_t lb, extent;
+            ompi_datatype_get_extent(rdtype, &lb, &extent);
+
+            err = xhc_xchg_pack((char *) rtmp + block_disp[rank],
+                (char *) rbuf + ompi_disp_array_get(displs, rank) * extent,
+                ompi_count_array_get(rcounts, rank), rdtype);
+            if(OMPI_SUCCESS != err) {goto _end;}
+        }
+    }
+
+    err = xhc_allgather_internal(flat_sbuf, flat_rbuf, block_disp,
+        block_len, ompi_comm, module, XHC_ALLGATHERV);
+
+    if(OMPI_SUCCESS == err && NULL != rtmp) {
+        err = xhc_xchg_unpack_v(rbuf, rcounts, displs, rtmp,
+            packed_displs, comm_size, rdtype);
+    }
+
+_end:
+
+    free(block_disp);
+    free(stmp);
+    free(rtmp);
+
+    return err;
+
+    // ---
+
+_fallback_permanent:
+
+    XHC_INSTALL_FALLBACK(module,
+        ompi_comm, XHC_ALLGATHERV, allgatherv);
+
+_fallback:
+
+    return XHC_CALL_FALLBACK(module->prev_colls, XHC_ALLGATHERV, allgatherv,
+        sbuf, scount, sdtype, rbuf, rcounts, displs, rdtype, ompi_comm);
+}
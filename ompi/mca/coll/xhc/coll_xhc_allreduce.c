@@ -27,6 +27,14 @@
 #define COMM_ALL_JOINED 0x01
 #define COMM_REDUCE_FINI 0x02
 
+// Steps of the request-based allreduce (see xhc_allreduce_test)
+enum {
+    XHC_ALLREDUCE_STATE_INIT_COMM = 0,
+    XHC_ALLREDUCE_STATE_INIT_MEMBER,
+    XHC_ALLREDUCE_STATE_REDUCE,
+    XHC_ALLREDUCE_STATE_ACK
+};
+
 OBJ_CLASS_INSTANCE(xhc_rq_item_t, opal_list_item_t, NULL, NULL);
 
 static inline char *CICO_BUFFER(xhc_comm_t *xc, int member) {
@@ -580,10 +588,8 @@ static void xhc_allreduce_disconnect_peers(xhc_comm_t *comms) {
 
 // -----------------------------
 
-static void xhc_allreduce_ack(xhc_comm_t *comms,
-        xf_sig_t seq, xhc_bcast_ctx_t *bcast_ctx) {
-
-    // Set personal ack(s), in the (all)reduce hierarchy
+// Set personal ack(s), in the (all)reduce hierarchy
+static void xhc_allreduce_ack_post(xhc_comm_t *comms, xf_sig_t seq) {
     for(xhc_comm_t *xc = comms; xc; xc = xc->up) {
         xc->my_ctrl->ack = seq;
 
@@ -594,6 +600,19 @@ static void xhc_allreduce_ack(xhc_comm_t *comms,
         xhc_prefetchw((void *) &xc->comm_ctrl->ack,
             sizeof(xc->comm_ctrl->ack), 1);
     }
+}
+
+static void xhc_allreduce_ack_comms(xhc_comm_t *comms, xf_sig_t seq) {
+    for(xhc_comm_t *xc = comms; xc; xc = xc->up) {
+        if(!xc->is_leader) {break;}
+        xc->comm_ctrl->ack = seq;
+    }
+}
+
+static void xhc_allreduce_ack(xhc_comm_t *comms,
+        xf_sig_t seq, xhc_bcast_ctx_t *bcast_ctx) {
+
+    xhc_allreduce_ack_post(comms, seq);
 
     /* Do the ACK process for the broadcast operation. This is necessary
      * in order to appropriately set of the fields in the bcast hierarchy.
@@ -607,10 +626,7 @@ static void xhc_allreduce_ack(xhc_comm_t *comms,
      * finished the collective. No need to check their member ack fields.
      * Set ack appropriately. */
 
-    for(xhc_comm_t *xc = comms; xc; xc = xc->up) {
-        if(!xc->is_leader) {break;}
-        xc->comm_ctrl->ack = seq;
-    }
+    xhc_allreduce_ack_comms(comms, seq);
 
     /* Note that relying on bcast's ack procedure like above, means that
      * comm ack will be set only after the prodedure has finished on ALL
@@ -903,27 +919,19 @@ static void xhc_allreduce_do_reduce(xhc_comm_t *xc, xhc_rq_item_t *member_item,
 
 // -----------------------------
 
-int mca_coll_xhc_allreduce_internal(const void *sbuf, void *rbuf, size_t count,
-        ompi_datatype_t *datatype, ompi_op_t *op, ompi_communicator_t *ompi_comm,
-        mca_coll_base_module_t *ompi_module, bool require_bcast) {
-
-    XHC_COLLTYPE_T colltype = (require_bcast ? XHC_ALLREDUCE : XHC_REDUCE);
-    xhc_module_t *module = (xhc_module_t *) ompi_module;
-
-    int err;
-
-    // ---
+static int xhc_allreduce_check_support(xhc_module_t *module, size_t count,
+        ompi_datatype_t *datatype, ompi_op_t *op, XHC_COLLTYPE_T colltype) {
 
     if(!ompi_datatype_is_predefined(datatype)) {
         WARN_ONCE("coll:xhc: Warning: XHC does not currently support "
             "derived datatypes; utilizing fallback component");
-        goto _fallback;
+        return OMPI_ERR_NOT_SUPPORTED;
     }
 
     if(!ompi_op_is_commute(op)) {
         WARN_ONCE("coll:xhc: Warning: (all)reduce does not support "
             "non-commutative operators; utilizing fallback component");
-        goto _fallback;
+        return OMPI_ERR_NOT_SUPPORTED;
     }
 
     if(!module->zcopy_support) {
@@ -931,114 +939,92 @@ int mca_coll_xhc_allreduce_internal(const void *sbuf, void *rbuf, size_t count,
         size_t cico_size = module->op_config[colltype].cico_max;
         if(count * dtype_size > cico_size) {
             WARN_ONCE("coll:xhc: Warning: No smsc support; utilizing fallback "
-                "component for %s greater than %zu bytes", (require_bcast ?
-                "allreduce" : "reduce"), cico_size);
-            goto _fallback;
+                "component for %s greater than %zu bytes", (XHC_REDUCE == colltype ?
+                "reduce" : "allreduce"), cico_size);
+            return OMPI_ERR_NOT_SUPPORTED;
         }
     }
 
-    if(!module->op_data[colltype].init) {
-        err = xhc_init_op(module, ompi_comm, colltype);
-        if(OMPI_SUCCESS != err) {goto _fallback_permanent;}
-    }
-
-    if(require_bcast && !module->op_data[XHC_BCAST].init) {
-        err = xhc_init_op(module, ompi_comm, XHC_BCAST);
-        if(OMPI_SUCCESS != err) {goto _fallback_permanent_bcast;}
-    }
-
-    // ---
-
-    xhc_peer_info_t *peer_info = module->peer_info;
-    xhc_op_data_t *op_data = &module->op_data[colltype];
-
-    xhc_comm_t *comms = op_data->comms;
-
-    size_t dtype_size, bytes_total;
-    ompi_datatype_type_size(datatype, &dtype_size);
-    bytes_total = count * dtype_size;
+    return OMPI_SUCCESS;
+}
 
-    xhc_copy_method_t method;
+/* Resolve the settings of the op that don't depend on the specific
+ * instance of it. Persistent requests only do this once, at creation. */
+static void xhc_allreduce_ctx_init(xhc_allreduce_ctx_t *ctx,
+        const void *sbuf, void *rbuf, size_t count, ompi_datatype_t *datatype,
+        ompi_op_t *op, ompi_communicator_t *ompi_comm, xhc_module_t *module,
+        XHC_COLLTYPE_T colltype, bool persistent) {
 
-    bool out_of_order_reduce = false;
-    xhc_reduce_load_balance_enum_t lb_policy;
+    ctx->sbuf = (MPI_IN_PLACE == sbuf ? rbuf : sbuf);
+    ctx->rbuf = rbuf;
+    ctx->count = count;
+    ctx->datatype = datatype;
+    ctx->op = op;
+    ctx->ompi_comm = ompi_comm;
+    ctx->module = module;
 
-    int rank = ompi_comm_rank(ompi_comm);
+    ctx->rank = ompi_comm_rank(ompi_comm);
+    ctx->comms = module->op_data[colltype].comms;
 
     /* Currently hard-coded. Okay for Allreduce. For reduce, it's
      * because we don't yet support non-zero root... (TODO) */
-    int root = comms->top->owner_rank;
+    ctx->root = ctx->comms->top->owner_rank;
+
+    ompi_datatype_type_size(datatype, &ctx->dtype_size);
+    ctx->bytes_total = count * ctx->dtype_size;
 
     // ---
 
     switch(mca_coll_xhc_component.dynamic_reduce) {
         case XHC_DYNAMIC_REDUCE_DISABLED:
-            out_of_order_reduce = false;
+            ctx->out_of_order_reduce = false;
             break;
 
         case XHC_DYNAMIC_REDUCE_NON_FLOAT:
-            out_of_order_reduce = !(datatype->super.flags
+            ctx->out_of_order_reduce = !(datatype->super.flags
                 & OMPI_DATATYPE_FLAG_DATA_FLOAT);
             break;
 
         case XHC_DYNAMIC_REDUCE_ALL:
-            out_of_order_reduce = true;
+            ctx->out_of_order_reduce = true;
             break;
     }
 
-    if(bytes_total <= XHC_REDUCE_IMM_SIZE) {
-        method = XHC_COPY_IMM;
-    } else if(bytes_total <= comms[0].cico_size) {
-        method = XHC_COPY_CICO;
+    if(ctx->bytes_total <= XHC_REDUCE_IMM_SIZE) {
+        ctx->method = XHC_COPY_IMM;
+    } else if(ctx->bytes_total <= ctx->comms[0].cico_size) {
+        ctx->method = XHC_COPY_CICO;
     } else {
-        method = XHC_COPY_SMSC;
+        ctx->method = XHC_COPY_SMSC;
     }
 
     /* In XHC_COPY_IMM, we force the leaders to perform the reductions,
      * to greatly simplify imm buffer management. Don't see any reason
      * for any other member to do them anyway... */
-    if(XHC_COPY_IMM == method) {lb_policy = XHC_REDUCE_LB_LEADER_ASSIST_ALL;}
-    else {lb_policy = mca_coll_xhc_component.reduce_load_balance;}
-
-    /* We require a buffer to store intermediate data. In cases like MPI_Ruduce,
-     * non-root ranks don't normally have an rbuf, so allocate an internal one.
-     * TODO: Strictly speaking, the members that won't do reductions, shouldn't
-     * require an rbuf; consult this and don't allocate one for them?? */
-    if(NULL == rbuf) {
-        if(module->rbuf_size < bytes_total) {
-            void *new_rbuf = realloc(module->rbuf, bytes_total);
-            if(!new_rbuf) {return OPAL_ERR_OUT_OF_RESOURCE;}
-
-            module->rbuf = new_rbuf;
-            module->rbuf_size = bytes_total;
-        }
+    if(XHC_COPY_IMM == ctx->method) {ctx->lb_policy = XHC_REDUCE_LB_LEADER_ASSIST_ALL;}
+    else {ctx->lb_policy = mca_coll_xhc_component.reduce_load_balance;}
 
-        rbuf = module->rbuf;
-    }
+    ctx->bcast_ctx.persistent = persistent;
+}
 
-    if(MPI_IN_PLACE == sbuf) {
-        sbuf = rbuf;
-    }
+static void xhc_allreduce_ctx_start(xhc_allreduce_ctx_t *ctx,
+        XHC_COLLTYPE_T colltype) {
 
-    // ---
+    ctx->seq = ++(ctx->module->op_data[colltype].seq);
 
-    xf_sig_t seq = ++op_data->seq;
+    ctx->bytes_done = 0;
+    ctx->bcast_started = false;
 
-    xhc_allreduce_init_local(comms, count, dtype_size, colltype, lb_policy, seq);
-    xhc_allreduce_init_comm(comms, rank, seq);
+    ctx->state = XHC_ALLREDUCE_STATE_INIT_COMM;
+    ctx->state_comm = ctx->comms;
 
-    // My conscience is clear!
-    if(require_bcast) {goto _allreduce;}
-    else {goto _reduce;}
-
-// =============================================================================
-
-_allreduce: {
-
-    xhc_bcast_ctx_t bcast_ctx;
-    bool bcast_started = false;
+    xhc_allreduce_init_local(ctx->comms, ctx->count, ctx->dtype_size,
+        colltype, ctx->lb_policy, ctx->seq);
+}
 
-    void *bcast_buf = rbuf;
+static int xhc_allreduce_bcast_init(xhc_allreduce_ctx_t *ctx) {
+    xhc_comm_t *top = ctx->comms->top;
+    void *bcast_buf = ctx->rbuf;
 
     /* In CICO, the reduced data is placed on the root's cico reduce buffer,
      * unless the root does all the reduction, in which case just have him
@@ -1049,155 +1035,366 @@ _allreduce: {
      * if bcast is also CICO, the data will end up getting placed directly
      * on the root's bcast cico buffer (not a problem for setting bcast_buf,
      * just so you know there's a bit more to it!). */
-    if(XHC_COPY_CICO == method && rank == root && !comms->top->do_all_work) {
-        bcast_buf = CICO_BUFFER(comms->top, comms->top->my_id);
+    if(XHC_COPY_CICO == ctx->method && ctx->rank == ctx->root && !top->do_all_work) {
+        bcast_buf = CICO_BUFFER(top, top->my_id);
     }
 
-    xhc_bcast_init(bcast_buf, count, datatype, root,
-        ompi_comm, module, &bcast_ctx);
+    return xhc_bcast_ctx_init(bcast_buf, ctx->count, ctx->datatype, ctx->root,
+        ctx->ompi_comm, ctx->module, ctx->bcast_ctx.persistent, &ctx->bcast_ctx);
+}
+
+/* A pass over the hierarchy, performing any reductions, propagation and
+ * broadcast steps that are possible at this time, without blocking.
+ * Returns OMPI_ERR_WOULD_BLOCK if none of them were. */
+static int xhc_allreduce_iterate(xhc_allreduce_ctx_t *ctx) {
+    xhc_peer_info_t *peer_info = ctx->module->peer_info;
+    xhc_bcast_ctx_t *bcast_ctx = &ctx->bcast_ctx;
+    xhc_comm_t *comms = ctx->comms;
+
+    size_t count = ctx->count;
+    size_t dtype_size = ctx->dtype_size;
+    xhc_copy_method_t method = ctx->method;
+
+    bool progress = false;
+    int err;
+
+    // CICO mode, copy-in phase
+    if(XHC_COPY_CICO == method && comms->bottom->reduce_ready < count) {
+        xhc_allreduce_cico_publish(comms->bottom, (void *) ctx->sbuf,
+            peer_info, ctx->rank, count, dtype_size);
+        progress = true;
+    }
 
-    /* Allreduce is not multi-sliced (no perf benefit from multi-slicing?),
-     * so init the member struct on all comms here, in blocking manner. */
     for(xhc_comm_t *xc = comms; xc; xc = xc->up) {
-        xhc_allreduce_init_member(xc, peer_info, (void *) sbuf, rbuf, count,
-            dtype_size, method, bcast_ctx.method, rank, seq, true);
+
+        if(xc->reduce_done < count) {
+            xhc_rq_item_t *member_item = NULL;
+
+            err = xhc_allreduce_reduce_get_next(xc, peer_info, count,
+                dtype_size, method, bcast_ctx->method, ctx->out_of_order_reduce,
+                ctx->seq, &member_item);
+            if(OMPI_SUCCESS != err) {return err;}
+
+            if(member_item) {
+                xhc_allreduce_do_reduce(xc, member_item, ctx->rbuf,
+                    count, ctx->datatype, dtype_size, ctx->op, method);
+                progress = true;
+            }
+        }
+
+        /* If not a leader in this comm, no propagation to
+         * do, and not participating in higher-up comms. */
         if(!xc->is_leader) {break;}
-    }
 
-    for(size_t bytes_done = 0; bytes_done < bytes_total; ) {
+        /* Leaders monitor children's progress and appropriately
+         * propagate towards upper levels. The top level leader
+         * initiates the broadcast of fully reduced chunks. */
 
-        // CICO mode, copy-in phase
-        if(XHC_COPY_CICO == method && comms->bottom->reduce_ready < count) {
-            xhc_allreduce_cico_publish(comms->bottom, (void *) sbuf,
-                peer_info, rank, count, dtype_size);
+        // ---
+
+        if(xc->op_state & COMM_REDUCE_FINI) {
+            continue;
         }
 
-        for(xhc_comm_t *xc = comms; xc; xc = xc->up) {
+        /* Check if all have joined the collective, so that we may safely
+         * access their information in member_ctrl, plus we don't waste our
+         * time attempting propagation; reductions can't have finished if
+         * not all members have joined. */
+        if(!(xc->op_state & COMM_ALL_JOINED)) {
+            if(xhc_allreduce_check_all_joined(xc, ctx->seq)) {
+                xc->op_state |= COMM_ALL_JOINED;
+            } else {continue;}
+        }
 
-            if(xc->reduce_done < count) {
-                xhc_rq_item_t *member_item = NULL;
+        /* Don't bother checking the members' shared counters (potentially
+         * expensive), if mine is about to hold the process back any way. */
+        if(!((xc->up && xc->reduce_done > xc->up->reduce_ready)
+        || (xc->is_top && xc->reduce_done * dtype_size > ctx->bytes_done)
+        || (xc->reduce_done >= count))) {
+            continue;
+        }
 
-                err = xhc_allreduce_reduce_get_next(xc, peer_info, count,
-                    dtype_size, method, bcast_ctx.method, out_of_order_reduce,
-                    seq, &member_item);
-                if(OMPI_SUCCESS != err) {return err;}
+        // ---
 
-                if(member_item) {
-                    xhc_allreduce_do_reduce(xc, member_item, rbuf,
-                        count, datatype, dtype_size, op, method);
-                }
-            }
+        size_t completed = count;
+        size_t completed_bytes;
 
-            /* If not a leader in this comm, no propagation to
-             * do, and not participating in higher-up comms. */
-            if(!xc->is_leader) {break;}
+        for(int m = 0; m < xc->size; m++) {
+            size_t member_done = (m == xc->my_id ? xc->reduce_done :
+                xhc_atomic_load_size_t(&xc->member_ctrl[m].reduce_done));
 
-            /* Leaders monitor children's progress and appropriately
-             * propagate towards upper levels. The top level leader
-             * initiates the broadcast of fully reduced chunks. */
+            /* Watch out for double evaluation here, don't perform
+             * sensitive loads inside opal_min()'s parameter list. */
+            completed = opal_min(completed, member_done);
+        }
 
-            // ---
+        completed_bytes = completed * dtype_size;
 
-            if(xc->op_state & COMM_REDUCE_FINI) {
-                continue;
+        if(xc->up && completed > xc->up->reduce_ready) {
+            /* In imm mode: copy the data into my ctrl on
+             * the next level as part of the propagation. */
+            if(XHC_COPY_IMM == method) {
+                size_t up_bytes_ready = xc->up->reduce_ready * dtype_size;
+                xhc_memcpy_offset((void *) xc->up->my_ctrl->imm_data,
+                    xc->my_info->rbuf, up_bytes_ready,
+                    completed_bytes - up_bytes_ready);
             }
 
-            /* Check if all have joined the collective, so that we may safely
-             * access their information in member_ctrl, plus we don't waste our
-             * time attempting propagation; reductions can't have finished if
-             * not all members have joined. */
-            if(!(xc->op_state & COMM_ALL_JOINED)) {
-                if(xhc_allreduce_check_all_joined(xc, seq)) {
-                    xc->op_state |= COMM_ALL_JOINED;
-                } else {continue;}
+            xhc_atomic_store_size_t(&xc->up->my_ctrl->reduce_ready,
+                (xc->up->reduce_ready = completed));
+
+            progress = true;
+        } else if(xc->is_top && completed_bytes > ctx->bytes_done) {
+            for(xhc_comm_t *bxc = bcast_ctx->comms->top; bxc; bxc = bxc->down) {
+                xhc_bcast_notify(bcast_ctx, bxc, completed_bytes);
             }
 
-            /* Don't bother checking the members' shared counters (potentially
-             * expensive), if mine is about to hold the process back any way. */
-            if(!((xc->up && xc->reduce_done > xc->up->reduce_ready)
-            || (xc->is_top && xc->reduce_done * dtype_size > bytes_done)
-            || (xc->reduce_done >= count))) {
-                continue;
+            if(xc->my_info->rbuf != ctx->rbuf) {
+                xhc_memcpy_offset(ctx->rbuf, xc->my_info->rbuf,
+                    ctx->bytes_done, completed_bytes - ctx->bytes_done);
             }
 
-            // ---
+            ctx->bytes_done = completed_bytes;
+            bcast_ctx->bytes_done = completed_bytes;
 
-            size_t completed = count;
-            size_t completed_bytes;
+            progress = true;
+        }
 
-            for(int m = 0; m < xc->size; m++) {
-                size_t member_done = (m == xc->my_id ? xc->reduce_done :
-                    xhc_atomic_load_size_t(&xc->member_ctrl[m].reduce_done));
+        /* As soon as reduction and propagation is fully finished on
+         * this comm, no reason to 'visit' it anymore. Furthermore,
+         * once all reductions are done, it's possible that members
+         * will receive (through bcast) all final data and exit the
+         * collective. And they may well enter a new collective and
+         * start initializing their member_ctrl, so it's not
+         * appropriate to keep reading their ctrl data. */
+        if(completed >= count) {
+            xc->op_state |= COMM_REDUCE_FINI;
+        }
+    }
 
-                /* Watch out for double evaluation here, don't perform
-                 * sensitive loads inside opal_min()'s parameter list. */
-                completed = opal_min(completed, member_done);
-            }
+    // Broadcast
+    // ---------
 
-            completed_bytes = completed * dtype_size;
+    if(!ctx->bcast_started) {
+        err = xhc_bcast_start(bcast_ctx);
+        if(OMPI_SUCCESS == err) {ctx->bcast_started = progress = true;}
+        else if(OMPI_ERR_WOULD_BLOCK != err) {return err;}
+    }
 
-            if(xc->up && completed > xc->up->reduce_ready) {
-                /* In imm mode: copy the data into my ctrl on
-                 * the next level as part of the propagation. */
-                if(XHC_COPY_IMM == method) {
-                    size_t up_bytes_ready = xc->up->reduce_ready * dtype_size;
-                    xhc_memcpy_offset((void *) xc->up->my_ctrl->imm_data,
-                        xc->my_info->rbuf, up_bytes_ready,
-                        completed_bytes - up_bytes_ready);
-                }
+    if(bcast_ctx->src_comm && bcast_ctx->bytes_done < bcast_ctx->bytes_total) {
+        /* Currently, in single-copy mode, even though we already have
+         * some established xpmem attachments, these might need to be
+         * re-established in bcast. Some form of small/quick caching
+         * could be implemented in get_registration to avoid this. Or
+         * the allreduce implementation could hint to broadcast that
+         * registrations are available. */
 
-                xhc_atomic_store_size_t(&xc->up->my_ctrl->reduce_ready,
-                    (xc->up->reduce_ready = completed));
-            } else if(xc->is_top && completed_bytes > bytes_done) {
-                for(xhc_comm_t *bxc = bcast_ctx.comms->top; bxc; bxc = bxc->down) {
-                    xhc_bcast_notify(&bcast_ctx, bxc, completed_bytes);
-                }
+        err = xhc_bcast_work(bcast_ctx);
 
-                if(xc->my_info->rbuf != rbuf) {
-                    xhc_memcpy_offset(rbuf, xc->my_info->rbuf,
-                        bytes_done, completed_bytes - bytes_done);
+        if(OMPI_SUCCESS == err) {progress = true;}
+        else if(OMPI_ERR_WOULD_BLOCK != err) {return err;}
+
+        ctx->bytes_done = bcast_ctx->bytes_done;
+    }
+
+    return (progress ? OMPI_SUCCESS : OMPI_ERR_WOULD_BLOCK);
+}
+
+static void xhc_allreduce_fini(xhc_allreduce_ctx_t *ctx) {
+    xhc_bcast_fini(&ctx->bcast_ctx);
+
+    /* See respective comment in xhc_bcast_fini(). Note that prefetchw is also
+     * used in Reduce, but that happens inside xhc_allreduce_slice_gc(). */
+    if(XHC_COPY_CICO == ctx->method) {
+        for(xhc_comm_t *xc = ctx->comms; xc; xc = xc->up) {
+            xhc_prefetchw(CICO_BUFFER(xc, xc->my_id), ctx->bytes_total, 2);
+            if(!xc->is_leader) {break;}
+        }
+    }
+
+    if(XHC_COPY_SMSC == ctx->method) {
+        xhc_allreduce_disconnect_peers(ctx->comms);
+    }
+}
+
+/* Non-blocking counterpart of the allreduce path in
+ * xhc_allreduce_internal(), for request-based ops. Each call
+ * resumes from where the previous one left off. */
+static int xhc_allreduce_test(xhc_allreduce_ctx_t *ctx) {
+    xhc_peer_info_t *peer_info = ctx->module->peer_info;
+    int err;
+
+    switch(ctx->state) {
+        case XHC_ALLREDUCE_STATE_INIT_COMM:
+            for(xhc_comm_t *xc = ctx->state_comm; xc && xc->is_leader;
+                    xc = ctx->state_comm = xc->up) {
+
+                if(!CHECK_FLAG(&xc->comm_ctrl->ack, ctx->seq - 1, 0)) {
+                    return OMPI_ERR_WOULD_BLOCK;
                 }
+            }
 
-                bytes_done = completed_bytes;
-                bcast_ctx.bytes_done = completed_bytes;
+            err = xhc_allreduce_bcast_init(ctx);
+            if(OMPI_SUCCESS != err) {return err;}
+
+            ctx->state = XHC_ALLREDUCE_STATE_INIT_MEMBER;
+            ctx->state_comm = ctx->comms;
+
+            /* fall through */
+
+        case XHC_ALLREDUCE_STATE_INIT_MEMBER:
+            for(xhc_comm_t *xc = ctx->state_comm; xc;
+                    xc = ctx->state_comm = xc->up) {
+
+                err = xhc_allreduce_init_member(xc, peer_info,
+                    (void *) ctx->sbuf, ctx->rbuf, ctx->count, ctx->dtype_size,
+                    ctx->method, ctx->bcast_ctx.method, ctx->rank, ctx->seq, false);
+                if(OMPI_SUCCESS != err) {return err;}
+
+                if(!xc->is_leader) {break;}
             }
 
-            /* As soon as reduction and propagation is fully finished on
-             * this comm, no reason to 'visit' it anymore. Furthermore,
-             * once all reductions are done, it's possible that members
-             * will receive (through bcast) all final data and exit the
-             * collective. And they may well enter a new collective and
-             * start initializing their member_ctrl, so it's not
-             * appropriate to keep reading their ctrl data. */
-            if(completed >= count) {
-                xc->op_state |= COMM_REDUCE_FINI;
+            ctx->state = XHC_ALLREDUCE_STATE_REDUCE;
+
+            /* fall through */
+
+        case XHC_ALLREDUCE_STATE_REDUCE:
+            while(ctx->bytes_done < ctx->bytes_total) {
+                err = xhc_allreduce_iterate(ctx);
+                if(OMPI_SUCCESS != err) {return err;}
             }
-        }
 
-        // Broadcast
-        // ---------
+            if(!ctx->bcast_started) {
+                err = xhc_bcast_start(&ctx->bcast_ctx);
+                if(OMPI_SUCCESS != err) {return err;}
+
+                ctx->bcast_started = true;
+            }
+
+            xhc_allreduce_ack_post(ctx->comms, ctx->seq);
+            ctx->state = XHC_ALLREDUCE_STATE_ACK;
+
+            /* fall through */
+
+        case XHC_ALLREDUCE_STATE_ACK:
+            // See the comments in xhc_allreduce_ack()
+            err = xhc_bcast_ack_test(&ctx->bcast_ctx);
+            if(OMPI_SUCCESS != err) {return err;}
+
+            xhc_allreduce_ack_comms(ctx->comms, ctx->seq);
+
+            break;
+
+        default:
+            assert(0);
+            return OMPI_ERROR;
+    }
+
+    xhc_allreduce_fini(ctx);
+
+    return OMPI_SUCCESS;
+}
+
+// -----------------------------
+
+int mca_coll_xhc_allreduce_internal(const void *sbuf, void *rbuf, size_t count,
+        ompi_datatype_t *datatype, ompi_op_t *op, ompi_communicator_t *ompi_comm,
+        mca_coll_base_module_t *ompi_module, bool require_bcast) {
+
+    XHC_COLLTYPE_T colltype = (require_bcast ? XHC_ALLREDUCE : XHC_REDUCE);
+    xhc_module_t *module = (xhc_module_t *) ompi_module;
+
+    int err;
+
+    // ---
+
+    err = xhc_allreduce_check_support(module, count, datatype, op, colltype);
+    if(OMPI_SUCCESS != err) {goto _fallback;}
+
+    if(!module->op_data[colltype].init) {
+        err = xhc_init_op(module, ompi_comm, colltype);
+        if(OMPI_SUCCESS != err) {goto _fallback_permanent;}
+    }
+
+    if(require_bcast && !module->op_data[XHC_BCAST].init) {
+        err = xhc_init_op(module, ompi_comm, XHC_BCAST);
+        if(OMPI_SUCCESS != err) {goto _fallback_permanent_bcast;}
+    }
 
-        if(!bcast_started) {
-            err = xhc_bcast_start(&bcast_ctx);
-            if(OMPI_SUCCESS == err) {bcast_started = true;}
-            else if(OMPI_ERR_WOULD_BLOCK != err) {return err;}
+    // The broadcast step shares its state with any ibcast/iallreduce
+    if(require_bcast) {
+        xhc_request_drain(module);
+    }
+
+    // ---
+
+    /* We require a buffer to store intermediate data. In cases like MPI_Ruduce,
+     * non-root ranks don't normally have an rbuf, so allocate an internal one.
+     * TODO: Strictly speaking, the members that won't do reductions, shouldn't
+     * require an rbuf; consult this and don't allocate one for them?? */
+    if(NULL == rbuf) {
+        size_t dtype_size; ompi_datatype_type_size(datatype, &dtype_size);
+
+        if(module->rbuf_size < count * dtype_size) {
+            void *new_rbuf = realloc(module->rbuf, count * dtype_size);
+            if(!new_rbuf) {return OPAL_ERR_OUT_OF_RESOURCE;}
+
+            module->rbuf = new_rbuf;
+            module->rbuf_size = count * dtype_size;
         }
 
-        if(bcast_ctx.src_comm && bcast_ctx.bytes_done < bcast_ctx.bytes_total) {
-            /* Currently, in single-copy mode, even though we already have
-             * some established xpmem attachments, these might need to be
-             * re-established in bcast. Some form of small/quick caching
-             * could be implemented in get_registration to avoid this. Or
-             * the allreduce implementation could hint to broadcast that
-             * registrations are available. */
+        rbuf = module->rbuf;
+    }
 
-            err = xhc_bcast_work(&bcast_ctx);
+    xhc_allreduce_ctx_t ctx = {0};
 
-            if(OMPI_SUCCESS != err && OMPI_ERR_WOULD_BLOCK != err) {
-                return err;
-            }
+    xhc_allreduce_ctx_init(&ctx, sbuf, rbuf, count, datatype,
+        op, ompi_comm, module, colltype, false);
+
+    xhc_peer_info_t *peer_info = module->peer_info;
+    xhc_comm_t *comms = ctx.comms;
+
+    size_t dtype_size = ctx.dtype_size;
+    size_t bytes_total = ctx.bytes_total;
+
+    xhc_copy_method_t method = ctx.method;
+    bool out_of_order_reduce = ctx.out_of_order_reduce;
+
+    int rank = ctx.rank;
+
+    sbuf = ctx.sbuf;
+
+    // ---
 
-            bytes_done = bcast_ctx.bytes_done;
+    xhc_allreduce_ctx_start(&ctx, colltype);
+    xf_sig_t seq = ctx.seq;
+
+    xhc_allreduce_init_comm(comms, rank, seq);
+
+    // My conscience is clear!
+    if(require_bcast) {goto _allreduce;}
+    else {goto _reduce;}
+
+// =============================================================================
+
+_allreduce: {
+
+    err = xhc_allreduce_bcast_init(&ctx);
+    if(OMPI_SUCCESS != err) {return err;}
+
+    /* Allreduce is not multi-sliced (no perf benefit from multi-slicing?),
+     * so init the member struct on all comms here, in blocking manner. */
+    for(xhc_comm_t *xc = comms; xc; xc = xc->up) {
+        xhc_allreduce_init_member(xc, peer_info, (void *) sbuf, rbuf, count,
+            dtype_size, method, ctx.bcast_ctx.method, rank, seq, true);
+        if(!xc->is_leader) {break;}
+    }
+
+    while(ctx.bytes_done < bytes_total) {
+        err = xhc_allreduce_iterate(&ctx);
+
+        if(OMPI_SUCCESS != err && OMPI_ERR_WOULD_BLOCK != err) {
+            return err;
         }
     }
 
@@ -1206,26 +1403,16 @@ _allreduce: {
     /* This is theoretically necessary, for the case that a leader has copied
      * all chunks and thus exited the loop, but hasn't yet notified some of
      * its children (e.g. because they were still active in a previous op). */
-    while(!bcast_started) {
-        err = xhc_bcast_start(&bcast_ctx);
-        if(OMPI_SUCCESS == err) {bcast_started = true;}
+    while(!ctx.bcast_started) {
+        err = xhc_bcast_start(&ctx.bcast_ctx);
+        if(OMPI_SUCCESS == err) {ctx.bcast_started = true;}
         else if(OMPI_ERR_WOULD_BLOCK != err) {return err;}
     }
 
-    xhc_allreduce_ack(comms, seq, &bcast_ctx);
+    xhc_allreduce_ack(comms, seq, &ctx.bcast_ctx);
+    xhc_allreduce_fini(&ctx);
 
-    xhc_bcast_fini(&bcast_ctx);
-
-    /* See respective comment in xhc_bcast_fini(). Note that prefetchw is also
-     * used in Reduce, but that happens inside xhc_allreduce_slice_gc(). */
-    if(XHC_COPY_CICO == method) {
-        for(xhc_comm_t *xc = comms; xc; xc = xc->up) {
-            xhc_prefetchw(CICO_BUFFER(xc, xc->my_id), bytes_total, 2);
-            if(!xc->is_leader) {break;}
-        }
-    }
-
-    goto _finish;
+    return OMPI_SUCCESS;
 }
 
 // =============================================================================
@@ -1415,3 +1602,100 @@ int mca_coll_xhc_allreduce(const void *sbuf, void *rbuf,
     return xhc_allreduce_internal(sbuf, rbuf, count,
         datatype, op, ompi_comm, ompi_module, true);
 }        
+
+// -----------------------------
+
+static int xhc_iallreduce_start(xhc_request_t *req) {
+    xhc_allreduce_ctx_start(&req->ctx.allreduce, XHC_ALLREDUCE);
+    return OMPI_SUCCESS;
+}
+
+static int xhc_iallreduce_test(xhc_request_t *req) {
+    return xhc_allreduce_test(&req->ctx.allreduce);
+}
+
+static int xhc_allreduce_request(const void *sbuf, void *rbuf, size_t count,
+        ompi_datatype_t *datatype, ompi_op_t *op, ompi_communicator_t *ompi_comm,
+        ompi_info_t *info, ompi_request_t **request, xhc_module_t *module,
+        XHC_COLLTYPE_T colltype) {
+
+    bool persistent = (XHC_ALLREDUCE_INIT == colltype);
+
+    xhc_request_t *req;
+    int err;
+
+    // ---
+
+    err = xhc_allreduce_check_support(module, count, datatype, op, XHC_ALLREDUCE);
+    if(OMPI_SUCCESS != err) {goto _fallback;}
+
+    if(!module->op_data[XHC_ALLREDUCE].init) {
+        err = xhc_init_op(module, ompi_comm, XHC_ALLREDUCE);
+        if(OMPI_SUCCESS != err) {goto _fallback_permanent;}
+    }
+
+    if(!module->op_data[XHC_BCAST].init) {
+        err = xhc_init_op(module, ompi_comm, XHC_BCAST);
+        if(OMPI_SUCCESS != err) {goto _fallback_permanent_bcast;}
+    }
+
+    // ---
+
+    req = xhc_request_alloc(module, ompi_comm, colltype, persistent);
+    if(NULL == req) {return OMPI_ERR_OUT_OF_RESOURCE;}
+
+    xhc_allreduce_ctx_init(&req->ctx.allreduce, sbuf, rbuf, count,
+        datatype, op, ompi_comm, module, XHC_ALLREDUCE, persistent);
+
+    req->start_fn = xhc_iallreduce_start;
+    req->test_fn = xhc_iallreduce_test;
+
+    *request = &req->super;
+
+    return (persistent ? OMPI_SUCCESS : xhc_request_post(req));
+
+    // ---
+
+_fallback_permanent_bcast:
+
+    XHC_INSTALL_FALLBACK(module, ompi_comm, XHC_BCAST, bcast);
+
+_fallback_permanent:
+
+    if(persistent) {
+        XHC_INSTALL_FALLBACK(module,
+            ompi_comm, XHC_ALLREDUCE_INIT, allreduce_init);
+    } else {
+        XHC_INSTALL_FALLBACK(module,
+            ompi_comm, XHC_IALLREDUCE, iallreduce);
+    }
+
+_fallback:
+
+    if(persistent) {
+        return XHC_CALL_FALLBACK(module->prev_colls, XHC_ALLREDUCE_INIT,
+            allreduce_init, sbuf, rbuf, count, datatype, op, ompi_comm,
+            info, request);
+    } else {
+        return XHC_CALL_FALLBACK(module->prev_colls, XHC_IALLREDUCE,
+            iallreduce, sbuf, rbuf, count, datatype, op, ompi_comm, request);
+    }
+}
+
+int mca_coll_xhc_iallreduce(const void *sbuf, void *rbuf,
+        size_t count, ompi_datatype_t *datatype, ompi_op_t *op,
+        ompi_communicator_t *ompi_comm, ompi_request_t **request,
+        mca_coll_base_module_t *ompi_module) {
+
+    return xhc_allreduce_request(sbuf, rbuf, count, datatype, op, ompi_comm,
+        NULL, request, (xhc_module_t *) ompi_module, XHC_IALLREDUCE);
+}
+
+int mca_coll_xhc_allreduce_init(const void *sbuf, void *rbuf,
+        size_t count, ompi_datatype_t *datatype, ompi_op_t *op,
+        ompi_communicator_t *ompi_comm, ompi_info_t *info,
+        ompi_request_t **request, mca_coll_base_module_t *ompi_module) {
+
+    return xhc_allreduce_request(sbuf, rbuf, count, datatype, op, ompi_comm,
+        info, request, (xhc_module_t *) ompi_module, XHC_ALLREDUCE_INIT);
+}
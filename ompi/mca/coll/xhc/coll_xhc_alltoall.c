@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) 2021-2024 Computer Architecture and VLSI Systems (CARV)
+ *                         Laboratory, ICS Forth. All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+#include "mpi.h"
+
+#include "ompi/constants.h"
+#include "ompi/datatype/ompi_datatype.h"
+#include "ompi/communicator/communicator.h"
+
+#include "coll_xhc.h"
+
+// ------------------------------------------------
+
+/* Every rank publishes its whole send buffer, and copies the block destined
+ * to it straight from each peer's buffer (see coll_xhc_xchg.c). Peers are
+ * visited starting from the next rank, to spread out the concurrent
+ * accesses. MPI_IN_PLACE is handled by the fallback component, as the
+ * published data would be overwritten while still being read by others. */
+
+int mca_coll_xhc_alltoall(const void *sbuf, size_t scount,
+        ompi_datatype_t *sdtype, void *rbuf, size_t rcount,
+        ompi_datatype_t *rdtype, ompi_communicator_t *ompi_comm,
+        mca_coll_base_module_t *ompi_module) {
+
+    xhc_module_t *module = (xhc_module_t *) ompi_module;
+
+    xhc_xchg_ctx_t ctx;
+    size_t block_size;
+    int err;
+
+    const void *flat_sbuf = sbuf;
+    void *flat_rbuf = rbuf;
+    void *stmp = NULL, *rtmp = NULL;
+
+    int rank = ompi_comm_rank(ompi_comm);
+    int comm_size = ompi_comm_size(ompi_comm);
+
+    // ---
+
+    if(MPI_IN_PLACE == sbuf) {
+        goto _fallback;
+    }
+
+    ompi_datatype_type_size(sdtype, &block_size);
+    block_size *= scount;
+
+    if(!module->zcopy_support) {
+        size_t cico_size = module->op_config[XHC_ALLTOALL].cico_max;
+        if(comm_size * block_size > cico_size) {
+            WARN_ONCE("coll:xhc: Warning: No smsc support; utilizing fallback "
+                "component for alltoall greater than %zu bytes", cico_size);
+            goto _fallback;
+        }
+    }
+
+    // ---
+
+    if(!module->op_data[XHC_ALLTOALL].init) {
+        err = xhc_init_op(module, ompi_comm, XHC_ALLTOALL);
+        if(OMPI_SUCCESS != err) {goto _fallback_permanent;}
+    }
+
+    /* The blocks of all ranks follow each other,
+     * in sbuf as well as in rbuf */
+    if(!xhc_xchg_dtype_flat(sdtype)) {
+        flat_sbuf = stmp = malloc(comm_size * block_size + 1);
+        if(!stmp) {return OMPI_ERR_OUT_OF_RESOURCE;}
+
+        err = xhc_xchg_pack(stmp, sbuf, comm_size * scount, sdtype);
+        if(OMPI_SUCCESS != err) {goto _end;}
+    }
+
+    if(!xhc_xchg_dtype_flat(rdtype)) {
+        flat_rbuf = rtmp = malloc(comm_size * block_size + 1);
+        if(!rtmp) {err = OMPI_ERR_OUT_OF_RESOURCE; goto _end;}
+    }
+
+    xhc_xchg_init(module, ompi_comm, XHC_ALLTOALL, 0, &ctx);
+
+    err = xhc_xchg_publish(&ctx, flat_sbuf, comm_size * block_size);
+    if(OMPI_SUCCESS != err) {goto _end;}
+
+    if(block_size > 0) {
+        xhc_memcpy((char *) flat_rbuf + rank * block_size,
+            (char *) flat_sbuf + rank * block_size, block_size);
+    }
+
+    for(int i = 1; i < comm_size; i++) {
+        int peer = (rank + i) % comm_size;
+
+        err = xhc_xchg_copy_from(&ctx, peer, (char *) flat_rbuf
+            + peer * block_size, rank * block_size, block_size);
+        if(OMPI_SUCCESS != err) {goto _end;}
+    }
+
+    xhc_xchg_fini(&ctx);
+
+    if(NULL != rtmp) {
+        err = xhc_xchg_unpack(rbuf, comm_size * rcount, rdtype, rtmp);
+    }
+
+_end:
+
+    free(stmp);
+    free(rtmp);
+
+    return err;
+
+    // ---
+
+_fallback_permanent:
+
+    XHC_INSTALL_FALLBACK(module,
+        ompi_comm, XHC_ALLTOALL, alltoall);
+
+_fallback:
+
+    return XHC_CALL_FALLBACK(module->prev_colls, XHC_ALLTOALL, alltoall,
+        sbuf, scount, sdtype, rbuf, rcount, rdtype, ompi_comm);
+}
+
+/* Without smsc support, alltoallv always falls back: each rank only knows
+ * its own counts, so the ranks can't agree on whether they fit in CICO.
+ * Each rank places the displacements of its blocks in its displacement
+ * table, where the respective peers look them up (see xhc_xchg_publish_v). */
+int mca_coll_xhc_alltoallv(const void *sbuf, ompi_count_array_t scounts,
+        ompi_disp_array_t sdispls, ompi_datatype_t *sdtype, void *rbuf,
+        ompi_count_array_t rcounts, ompi_disp_array_t rdispls,
+        ompi_datatype_t *rdtype, ompi_communicator_t *ompi_comm,
+        mca_coll_base_module_t *ompi_module) {
+
+    xhc_module_t *module = (xhc_module_t *) ompi_module;
+
+    xhc_xchg_ctx_t ctx;
+    size_t sdtype_size, rdtype_size;
+    int err;
+
+    const void *flat_sbuf = sbuf;
+    void *flat_rbuf = rbuf;
+    ompi_disp_array_t flat_sdispls = sdispls, flat_rdispls = rdispls;
+    ptrdiff_t *packed_displs = NULL;
+    void *stmp = NULL, *rtmp = NULL;
+
+    int rank = ompi_comm_rank(ompi_comm);
+    int comm_size = ompi_comm_size(ompi_comm);
+
+    // ---
+
+    if(MPI_IN_PLACE == sbuf) {
+        goto _fallback;
+    }
+
+    if(!module->zcopy_support) {
+        WARN_ONCE("coll:xhc: Warning: No smsc support; "
+            "utilizing fallback component for alltoallv");
+        goto _fallback;
+    }
+
+    // ---
+
+    if(!module->op_data[XHC_ALLTOALLV].init) {
+        err = xhc_init_op(module, ompi_comm, XHC_ALLTOALLV);
+        if(OMPI_SUCCESS != err) {goto _fallback_permanent;}
+    }
+
+    ompi_datatype_type_size(sdtype, &sdtype_size);
+    ompi_datatype_type_size(rdtype, &rdtype_size);
+
+    /* Blocks of other datatypes are packed one after the other,
+     * and the displacements refer to their packed positions */
+    packed_displs = malloc(2 * comm_size * sizeof(ptrdiff_t));
+    if(!packed_displs) {return OMPI_ERR_OUT_OF_RESOURCE;}
+
+    if(!xhc_xchg_dtype_flat(sdtype)) {
+        size_t total = xhc_xchg_packed_displs(scounts, comm_size, packed_displs);
+
+        flat_sbuf = stmp = malloc(total * sdtype_size + 1);
+        if(!stmp) {err = OMPI_ERR_OUT_OF_RESOURCE; goto _end;}
+
+        err = xhc_xchg_pack_v(stmp, sbuf, scounts, sdispls,
+            packed_displs, comm_size, sdtype);
+        if(OMPI_SUCCESS != err) {goto _end;}
+
+        ompi_disp_array_init_c(&flat_sdispls, packed_displs);
+    }
+
+    if(!xhc_xchg_dtype_flat(rdtype)) {
+        size_t total = xhc_xchg_packed_displs(rcounts,
+            comm_size, packed_displs + comm_size);
+
+        flat_rbuf = rtmp = malloc(total * rdtype_size + 1);
+        if(!rtmp) {err = OMPI_ERR_OUT_OF_RESOURCE; goto _end;}
+
+        ompi_disp_array_init_c(&flat_rdispls, packed_displs + comm_size);
+    }
+
+    xhc_xchg_init(module, ompi_comm, XHC_ALLTOALLV, 0, &ctx);
+
+    err = xhc_xchg_publish_v(&ctx, flat_sbuf, scounts, flat_sdispls, sdtype_size);
+    if(OMPI_SUCCESS != err) {goto _end;}
+
+    size_t my_len = ompi_count_array_get(scounts, rank) * sdtype_size;
+
+    if(my_len > 0) {
+        xhc_memcpy((char *) flat_rbuf + ompi_disp_array_get(flat_rdispls, rank)
+            * (ptrdiff_t) rdtype_size, (char *) flat_sbuf + ompi_disp_array_get(
+            flat_sdispls, rank) * (ptrdiff_t) sdtype_size, my_len);
+    }
+
+    for(int i = 1; i < comm_size; i++) {
+        int peer = (rank + i) % comm_size;
+
+        size_t len = ompi_count_array_get(rcounts, peer) * rdtype_size;
+        if(0 == len) {continue;}
+
+        err = xhc_xchg_copy_from(&ctx, peer, (char *) flat_rbuf
+            + ompi_disp_array_get(flat_rdispls, peer) * (ptrdiff_t) rdtype_size,
+            xhc_xchg_peer_disp(&ctx, peer), len);
+        if(OMPI_SUCCESS != err) {goto _end;}
+    }
+
+    xhc_xchg_fini(&ctx);
+
+    if(NULL != rtmp) {
+        err = xhc_xchg_unpack_v(rbuf, rcounts, rdispls, rtmp,
+            packed_displs + comm_size, comm_size, rdtype);
+    }
+
+_end:
+
+    free(packed_displs);
+    free(stmp);
+    free(rtmp);
+
+    return err;
+
+    // ---
+
+_fallback_permanent:
+
+    XHC_INSTALL_FALLBACK(module,
+        ompi_comm, XHC_ALLTOALLV, alltoallv);
+
+_fallback:
+
+    return XHC_CALL_FALLBACK(module->prev_colls, XHC_ALLTOALLV, alltoallv,
+        sbuf, scounts, sdispls, sdtype, rbuf, rcounts, rdispls, rdtype, ompi_comm);
+}
@@ -16,7 +16,7 @@
 
 #include "coll_xhc.h"
 
-static void xhc_barrier_leader(xhc_comm_t *comms, int comm_count,
+static void xhc_barrier_leader(xhc_comm_t *comms,
         xhc_peer_info_t *peer_info, int rank, int root, xf_sig_t seq) {
 
     for(xhc_comm_t *xc = comms; xc; xc = xc->up) {
@@ -64,28 +64,10 @@ static void xhc_barrier_leader(xhc_comm_t *comms, int comm_count,
  *    the same method. Ranks wait on their comm ack flag, set their
  *    own ack, and exit the collective.
  * ----------------------------------------------------------------- */
-int mca_coll_xhc_barrier(ompi_communicator_t *ompi_comm,
-        mca_coll_base_module_t *ompi_module) {
-
-    xhc_module_t *module = (xhc_module_t *) ompi_module;
-
-    if(!module->op_data[XHC_BARRIER].init) {
-        int err = xhc_init_op(module, ompi_comm, XHC_BARRIER);
-        if(OMPI_SUCCESS != err) {goto _fallback_permanent;}
-    }
-
-    xhc_peer_info_t *peer_info = module->peer_info;
-    xhc_op_data_t *data = &module->op_data[XHC_BARRIER];
-
-    xhc_comm_t *comms = data->comms;
-    int comm_count = data->comm_count;
-
-    int rank = ompi_comm_rank(ompi_comm);
-
-    xf_sig_t seq = ++data->seq;
+void mca_coll_xhc_barrier_internal(xhc_comm_t *comms,
+        xhc_peer_info_t *peer_info, int rank, int root, xf_sig_t seq) {
 
-    xhc_barrier_leader(comms, comm_count, peer_info, rank,
-        mca_coll_xhc_component.barrier_root, seq);
+    xhc_barrier_leader(comms, peer_info, rank, root, seq);
 
     // 1. Upwards SEQ Wave
     for(xhc_comm_t *xc = comms; xc; xc = xc->up) {
@@ -123,6 +105,82 @@ int mca_coll_xhc_barrier(ompi_communicator_t *ompi_comm,
 
         xc->comm_ctrl->ack = seq;
     }
+}
+
+/* Non-blocking counterpart of xhc_barrier_internal(), for request-based
+ * ops. Same three steps; each call resumes from where the last one left
+ * off, with ctx->xc/ctx->member tracking the progress of step 1. */
+static void xhc_barrier_start(xhc_barrier_ctx_t *ctx) {
+    xhc_barrier_leader(ctx->comms, ctx->peer_info,
+        ctx->rank, ctx->root, ctx->seq);
+
+    ctx->xc = ctx->comms;
+    ctx->member = 0;
+
+    ctx->xc->my_ctrl->seq = ctx->seq;
+}
+
+static int xhc_barrier_test(xhc_barrier_ctx_t *ctx) {
+    // 1. Upwards SEQ Wave
+    for(xhc_comm_t *xc = ctx->xc; xc && xc->is_leader; ) {
+        for(; ctx->member < xc->size; ctx->member++) {
+            if(ctx->member == xc->my_id) {
+                continue;
+            }
+
+            if(!CHECK_FLAG(&xc->member_ctrl[ctx->member].seq, ctx->seq, 0)) {
+                return OMPI_ERR_WOULD_BLOCK;
+            }
+        }
+
+        xc = ctx->xc = xc->up;
+        ctx->member = 0;
+
+        if(xc) {
+            xc->my_ctrl->seq = ctx->seq;
+        }
+    }
+
+    // 2. Wait for ACK (root won't wait!)
+    for(xhc_comm_t *xc = ctx->comms; xc; xc = xc->up) {
+        if(false == xc->is_leader) {
+            if(!CHECK_FLAG(&xc->comm_ctrl->ack, ctx->seq, 0)) {
+                return OMPI_ERR_WOULD_BLOCK;
+            }
+
+            break;
+        }
+    }
+
+    // 3. Trigger ACK Wave
+    for(xhc_comm_t *xc = ctx->comms; xc; xc = xc->up) {
+        if(!xc->is_leader) {
+            break;
+        }
+
+        xc->comm_ctrl->ack = ctx->seq;
+    }
+
+    return OMPI_SUCCESS;
+}
+
+int mca_coll_xhc_barrier(ompi_communicator_t *ompi_comm,
+        mca_coll_base_module_t *ompi_module) {
+
+    xhc_module_t *module = (xhc_module_t *) ompi_module;
+
+    if(!module->op_data[XHC_BARRIER].init) {
+        int err = xhc_init_op(module, ompi_comm, XHC_BARRIER);
+        if(OMPI_SUCCESS != err) {goto _fallback_permanent;}
+    }
+
+    xhc_request_drain(module);
+
+    xhc_op_data_t *data = &module->op_data[XHC_BARRIER];
+    xf_sig_t seq = ++data->seq;
+
+    xhc_barrier_internal(data->comms, module->peer_info,
+        ompi_comm_rank(ompi_comm), mca_coll_xhc_component.barrier_root, seq);
 
     return OMPI_SUCCESS;
 
@@ -138,3 +196,81 @@ _fallback_permanent:
     return XHC_CALL_FALLBACK(module->prev_colls,
         XHC_BARRIER, barrier, ompi_comm);
 }
+
+// ------------------------------------------------
+
+static int xhc_ibarrier_start(xhc_request_t *req) {
+    xhc_barrier_ctx_t *ctx = &req->ctx.barrier;
+
+    ctx->seq = ++req->module->op_data[XHC_BARRIER].seq;
+    xhc_barrier_start(ctx);
+
+    return OMPI_SUCCESS;
+}
+
+static int xhc_ibarrier_test(xhc_request_t *req) {
+    return xhc_barrier_test(&req->ctx.barrier);
+}
+
+static int xhc_barrier_request(ompi_communicator_t *ompi_comm,
+        ompi_info_t *info, ompi_request_t **request,
+        xhc_module_t *module, XHC_COLLTYPE_T colltype) {
+
+    bool persistent = (XHC_BARRIER_INIT == colltype);
+    xhc_request_t *req;
+
+    if(!module->op_data[XHC_BARRIER].init) {
+        int err = xhc_init_op(module, ompi_comm, XHC_BARRIER);
+        if(OMPI_SUCCESS != err) {goto _fallback_permanent;}
+    }
+
+    req = xhc_request_alloc(module, ompi_comm, colltype, persistent);
+    if(NULL == req) {return OMPI_ERR_OUT_OF_RESOURCE;}
+
+    req->ctx.barrier = (xhc_barrier_ctx_t) {
+        .comms = module->op_data[XHC_BARRIER].comms,
+        .peer_info = module->peer_info,
+        .rank = ompi_comm_rank(ompi_comm),
+        .root = mca_coll_xhc_component.barrier_root
+    };
+
+    req->start_fn = xhc_ibarrier_start;
+    req->test_fn = xhc_ibarrier_test;
+
+    *request = &req->super;
+
+    return (persistent ? OMPI_SUCCESS : xhc_request_post(req));
+
+    // ---
+
+_fallback_permanent:
+
+    if(persistent) {
+        XHC_INSTALL_FALLBACK(module,
+            ompi_comm, XHC_BARRIER_INIT, barrier_init);
+
+        return XHC_CALL_FALLBACK(module->prev_colls, XHC_BARRIER_INIT,
+            barrier_init, ompi_comm, info, request);
+    } else {
+        XHC_INSTALL_FALLBACK(module,
+            ompi_comm, XHC_IBARRIER, ibarrier);
+
+        return XHC_CALL_FALLBACK(module->prev_colls, XHC_IBARRIER,
+            ibarrier, ompi_comm, request);
+    }
+}
+
+int mca_coll_xhc_ibarrier(ompi_communicator_t *ompi_comm,
+        ompi_request_t **request, mca_coll_base_module_t *ompi_module) {
+
+    return xhc_barrier_request(ompi_comm, NULL, request,
+        (xhc_module_t *) ompi_module, XHC_IBARRIER);
+}
+
+int mca_coll_xhc_barrier_init(ompi_communicator_t *ompi_comm,
+        ompi_info_t *info, ompi_request_t **request,
+        mca_coll_base_module_t *ompi_module) {
+
+    return xhc_barrier_request(ompi_comm, info, request,
+        (xhc_module_t *) ompi_module, XHC_BARRIER_INIT);
+}
@@ -123,9 +123,9 @@ void mca_coll_xhc_bcast_notify(xhc_bcast_ctx_t *ctx,
 
 // ------------------------------------------------
 
-int mca_coll_xhc_bcast_init(void *buf, size_t count, ompi_datatype_t *datatype,
+int mca_coll_xhc_bcast_ctx_init(void *buf, size_t count, ompi_datatype_t *datatype,
         int root, ompi_communicator_t *ompi_comm, xhc_module_t *module,
-        xhc_bcast_ctx_t *ctx) {
+        bool persistent, xhc_bcast_ctx_t *ctx) {
 
     ctx->buf = buf;
     ctx->datacount = count;
@@ -138,8 +138,17 @@ int mca_coll_xhc_bcast_init(void *buf, size_t count, ompi_datatype_t *datatype,
 
     ctx->src_comm = NULL;
 
-    ctx->region_data = NULL;
-    ctx->reg = NULL;
+    /* A persistent ctx holds on to these from the previous
+     * op; it starts out zeroed, when the request is created */
+    if(!persistent) {
+        ctx->region_data = NULL;
+        ctx->reg = NULL;
+    }
+
+    ctx->persistent = persistent;
+
+    ctx->ack_comm = NULL;
+    ctx->ack_member = 0;
 
     ctx->bytes_done = 0;
     ctx->bytes_avail = 0;
@@ -165,9 +174,11 @@ int mca_coll_xhc_bcast_init(void *buf, size_t count, ompi_datatype_t *datatype,
         ctx->method = (module->zcopy_map_support ?
             XHC_COPY_SMSC_MAP : XHC_COPY_SMSC_NO_MAP);
 
-        int err = xhc_copy_expose_region(ctx->buf,
-            ctx->bytes_total, &ctx->region_data);
-        if(0 != err) {return OMPI_ERROR;}
+        if(NULL == ctx->region_data) {
+            int err = xhc_copy_expose_region(ctx->buf,
+                ctx->bytes_total, &ctx->region_data);
+            if(0 != err) {return OMPI_ERROR;}
+        }
     }
 
     // --
@@ -242,10 +253,25 @@ int mca_coll_xhc_bcast_work(xhc_bcast_ctx_t *ctx) {
                     break;
 
                 case XHC_COPY_SMSC_MAP:
-                    ctx->src_buffer = xhc_get_registration(
-                        &ctx->module->peer_info[src_ctrl->leader_rank],
-                        src_ctrl->data_vaddr, ctx->bytes_total, &ctx->reg);
-                    if(NULL == ctx->src_buffer) {return OMPI_ERROR;}
+                    /* A persistent op's attachment from its previous run
+                     * is still good, if the leader and buffer are the same */
+                    if(ctx->reg && (ctx->reg_rank != src_ctrl->leader_rank
+                            || ctx->reg_vaddr != src_ctrl->data_vaddr)) {
+                        xhc_return_registration(ctx->reg);
+                        ctx->reg = NULL;
+                    }
+
+                    if(NULL == ctx->reg) {
+                        ctx->reg_buffer = xhc_get_registration(
+                            &ctx->module->peer_info[src_ctrl->leader_rank],
+                            src_ctrl->data_vaddr, ctx->bytes_total, &ctx->reg);
+                        if(NULL == ctx->reg_buffer) {return OMPI_ERROR;}
+
+                        ctx->reg_rank = src_ctrl->leader_rank;
+                        ctx->reg_vaddr = src_ctrl->data_vaddr;
+                    }
+
+                    ctx->src_buffer = ctx->reg_buffer;
                     break;
 
                 case XHC_COPY_SMSC_NO_MAP:
@@ -367,13 +393,53 @@ void mca_coll_xhc_bcast_ack(xhc_bcast_ctx_t *ctx) {
     }
 }
 
-void mca_coll_xhc_bcast_fini(xhc_bcast_ctx_t *ctx) {
-    if(ctx->reg) {
-        xhc_return_registration(ctx->reg);
+/* Non-blocking counterpart of xhc_bcast_ack(), for request-based
+ * ops. Each call resumes from where the previous one left off. */
+int mca_coll_xhc_bcast_ack_test(xhc_bcast_ctx_t *ctx) {
+
+    // Set personal ack(s)
+    if(NULL == ctx->ack_comm) {
+        for(xhc_comm_t *xc = ctx->comms; xc; xc = xc->up) {
+            xc->my_ctrl->ack = ctx->seq;
+
+            if(!xc->is_leader) {
+                break;
+            }
+        }
+
+        ctx->ack_comm = ctx->comms;
+        ctx->ack_member = 0;
     }
 
-    if(ctx->region_data) {
-        xhc_copy_close_region(ctx->region_data);
+    // Gather members' acks and set comm ack
+    for(xhc_comm_t *xc = ctx->ack_comm; xc && xc->is_leader;
+            xc = ctx->ack_comm = xc->up) {
+
+        if(0 == ctx->ack_member) {
+            xhc_prefetchw((void *) &xc->comm_ctrl->ack,
+                sizeof(xc->comm_ctrl->ack), 1);
+        }
+
+        for(; ctx->ack_member < xc->size; ctx->ack_member++) {
+            if(ctx->ack_member == xc->my_id) {
+                continue;
+            }
+
+            if(!CHECK_FLAG(&xc->member_ctrl[ctx->ack_member].ack, ctx->seq, 0)) {
+                return OMPI_ERR_WOULD_BLOCK;
+            }
+        }
+
+        xc->comm_ctrl->ack = ctx->seq;
+        ctx->ack_member = 0;
+    }
+
+    return OMPI_SUCCESS;
+}
+
+void mca_coll_xhc_bcast_fini(xhc_bcast_ctx_t *ctx) {
+    if(!ctx->persistent) {
+        xhc_bcast_release(ctx);
     }
 
     /* The operation is done, all children have copied from the leader's CICO
@@ -386,6 +452,35 @@ void mca_coll_xhc_bcast_fini(xhc_bcast_ctx_t *ctx) {
     }
 }
 
+// Release the resources that a persistent ctx holds on to across ops
+void mca_coll_xhc_bcast_release(xhc_bcast_ctx_t *ctx) {
+    if(ctx->reg) {
+        xhc_return_registration(ctx->reg);
+        ctx->reg = NULL;
+    }
+
+    if(ctx->region_data) {
+        xhc_copy_close_region(ctx->region_data);
+        ctx->region_data = NULL;
+    }
+}
+
+/* Safe to alter the CICO buffer without checking any flags,
+ * because this is this rank's personal buffer. In any past
+ * ops where others copied from it, the rank has gathered
+ * acks that these copies have completed. */
+static void xhc_bcast_root_publish(xhc_bcast_ctx_t *ctx) {
+    if(ctx->rank != ctx->root) {
+        return;
+    }
+
+    if(XHC_COPY_CICO == ctx->method) {
+        xhc_memcpy(ctx->self_cico, ctx->buf, ctx->bytes_total);
+    }
+
+    ctx->bytes_done = ctx->bytes_total;
+}
+
 // ------------------------------------------------
 
 int mca_coll_xhc_bcast(void *buf, size_t count, ompi_datatype_t *datatype, int root,
@@ -421,21 +516,13 @@ int mca_coll_xhc_bcast(void *buf, size_t count, ompi_datatype_t *datatype, int r
         if(OMPI_SUCCESS != err) {goto _fallback_permanent;}
     }
 
-    err = xhc_bcast_init(buf, count, datatype,
-        root, ompi_comm, module, &ctx);
-    if(OMPI_SUCCESS != err) {return err;}
+    xhc_request_drain(module);
 
-    /* Safe to alter the CICO buffer without checking any flags,
-     * because this is this rank's personal buffer. In any past
-     * ops where others copied from it, the rank has gathered
-     * acks that these copies have completed. */
-    if(ctx.rank == root && XHC_COPY_CICO == ctx.method) {
-        xhc_memcpy(ctx.self_cico, ctx.buf, ctx.bytes_total);
-    }
+    err = xhc_bcast_ctx_init(buf, count, datatype,
+        root, ompi_comm, module, false, &ctx);
+    if(OMPI_SUCCESS != err) {return err;}
 
-    if(ctx.rank == root) {
-        ctx.bytes_done = ctx.bytes_total;
-    }
+    xhc_bcast_root_publish(&ctx);
 
     while((err = xhc_bcast_start(&ctx)) != OMPI_SUCCESS) {
         if(OMPI_ERR_WOULD_BLOCK != err) {return err;}
@@ -466,3 +553,131 @@ _fallback:
     return XHC_CALL_FALLBACK(module->prev_colls, XHC_BCAST,
         bcast, buf, count, datatype, root, ompi_comm);
 }
+
+// ------------------------------------------------
+
+static int xhc_ibcast_start(xhc_request_t *req) {
+    xhc_bcast_ctx_t *ctx = &req->ctx.bcast;
+
+    int err = xhc_bcast_ctx_init(ctx->buf, ctx->datacount, ctx->datatype,
+        ctx->root, ctx->ompi_comm, ctx->module, ctx->persistent, ctx);
+    if(OMPI_SUCCESS != err) {return err;}
+
+    xhc_bcast_root_publish(ctx);
+
+    return OMPI_SUCCESS;
+}
+
+static int xhc_ibcast_test(xhc_request_t *req) {
+    xhc_bcast_ctx_t *ctx = &req->ctx.bcast;
+    int err;
+
+    // xhc_bcast_start() is a no-op for the comms it has already handled
+    err = xhc_bcast_start(ctx);
+    if(OMPI_SUCCESS != err) {return err;}
+
+    while(ctx->bytes_done < ctx->bytes_total) {
+        err = xhc_bcast_work(ctx);
+        if(OMPI_SUCCESS != err) {return err;}
+    }
+
+    err = xhc_bcast_ack_test(ctx);
+    if(OMPI_SUCCESS != err) {return err;}
+
+    xhc_bcast_fini(ctx);
+
+    return OMPI_SUCCESS;
+}
+
+static int xhc_bcast_request(void *buf, size_t count, ompi_datatype_t *datatype,
+        int root, ompi_communicator_t *ompi_comm, ompi_info_t *info,
+        ompi_request_t **request, xhc_module_t *module,
+        XHC_COLLTYPE_T colltype) {
+
+    bool persistent = (XHC_BCAST_INIT == colltype);
+
+    xhc_request_t *req;
+    int err;
+
+    // ---
+
+    if(!ompi_datatype_is_predefined(datatype)) {
+        WARN_ONCE("coll:xhc: Warning: XHC does not currently support "
+            "derived datatypes; utilizing fallback component");
+        goto _fallback;
+    }
+
+    if(!module->zcopy_support) {
+        size_t dtype_size; ompi_datatype_type_size(datatype, &dtype_size);
+        size_t cico_size = module->op_config[XHC_BCAST].cico_max;
+        if(count * dtype_size > cico_size) {
+            WARN_ONCE("coll:xhc: Warning: No smsc support; utilizing fallback "
+                "component for bcast greater than %zu bytes", cico_size);
+            goto _fallback;
+        }
+    }
+
+    if(!module->op_data[XHC_BCAST].init) {
+        err = xhc_init_op(module, ompi_comm, XHC_BCAST);
+        if(OMPI_SUCCESS != err) {goto _fallback_permanent;}
+    }
+
+    // ---
+
+    req = xhc_request_alloc(module, ompi_comm, colltype, persistent);
+    if(NULL == req) {return OMPI_ERR_OUT_OF_RESOURCE;}
+
+    // The rest of the ctx is set up by xhc_bcast_ctx_init, in start_fn
+    req->ctx.bcast.buf = buf;
+    req->ctx.bcast.datacount = count;
+    req->ctx.bcast.datatype = datatype;
+    req->ctx.bcast.root = root;
+    req->ctx.bcast.ompi_comm = ompi_comm;
+    req->ctx.bcast.module = module;
+    req->ctx.bcast.persistent = persistent;
+
+    req->start_fn = xhc_ibcast_start;
+    req->test_fn = xhc_ibcast_test;
+
+    *request = &req->super;
+
+    return (persistent ? OMPI_SUCCESS : xhc_request_post(req));
+
+    // ---
+
+_fallback_permanent:
+
+    if(persistent) {
+        XHC_INSTALL_FALLBACK(module,
+            ompi_comm, XHC_BCAST_INIT, bcast_init);
+    } else {
+        XHC_INSTALL_FALLBACK(module,
+            ompi_comm, XHC_IBCAST, ibcast);
+    }
+
+_fallback:
+
+    if(persistent) {
+        return XHC_CALL_FALLBACK(module->prev_colls, XHC_BCAST_INIT,
+            bcast_init, buf, count, datatype, root, ompi_comm, info, request);
+    } else {
+        return XHC_CALL_FALLBACK(module->prev_colls, XHC_IBCAST,
+            ibcast, buf, count, datatype, root, ompi_comm, request);
+    }
+}
+
+int mca_coll_xhc_ibcast(void *buf, size_t count, ompi_datatype_t *datatype,
+        int root, ompi_communicator_t *ompi_comm, ompi_request_t **request,
+        mca_coll_base_module_t *ompi_module) {
+
+    return xhc_bcast_request(buf, count, datatype, root, ompi_comm,
+        NULL, request, (xhc_module_t *) ompi_module, XHC_IBCAST);
+}
+
+int mca_coll_xhc_bcast_init(void *buf, size_t count, ompi_datatype_t *datatype,
+        int root, ompi_communicator_t *ompi_comm, ompi_info_t *info,
+        ompi_request_t **request, mca_coll_base_module_t *ompi_module) {
+
+    return xhc_bcast_request(buf, count, datatype, root, ompi_comm,
+        info, request, (xhc_module_t *) ompi_module, XHC_BCAST_INIT);
+}
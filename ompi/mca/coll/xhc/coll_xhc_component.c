@@ -27,6 +27,8 @@
 typedef int (*csv_parse_conv_fn_t)(char *str, void *dst);
 typedef void (*csv_parse_destruct_fn_t)(void *data);
 
+static int xhc_open(void);
+static int xhc_close(void);
 static int xhc_register(void);
 static int xhc_var_check_exclusive(const char *param_a, const char *param_b);
 
@@ -58,7 +60,15 @@ static const COLLTYPE_T xhc_colltype_to_universal_map[XHC_COLLCOUNT] = {
     [XHC_BCAST] = BCAST,
     [XHC_BARRIER] = BARRIER,
     [XHC_REDUCE] = REDUCE,
-    [XHC_ALLREDUCE] = ALLREDUCE
+    [XHC_ALLREDUCE] = ALLREDUCE,
+    [XHC_ALLGATHER] = ALLGATHER,
+    [XHC_ALLGATHERV] = ALLGATHERV,
+    [XHC_GATHER] = GATHER,
+    [XHC_GATHERV] = GATHERV,
+    [XHC_SCATTER] = SCATTER,
+    [XHC_SCATTERV] = SCATTERV,
+    [XHC_ALLTOALL] = ALLTOALL,
+    [XHC_ALLTOALLV] = ALLTOALLV
 };
 
 static const char *xhc_config_source_to_str_map[XHC_CONFIG_SOURCE_COUNT] = {
@@ -80,6 +90,8 @@ mca_coll_xhc_component_t mca_coll_xhc_component = {
             MCA_BASE_MAKE_VERSION(component, OMPI_MAJOR_VERSION,
                 OMPI_MINOR_VERSION, OMPI_RELEASE_VERSION),
 
+            .mca_open_component = xhc_open,
+            .mca_close_component = xhc_close,
             .mca_register_component_params = xhc_register,
         },
 
@@ -111,7 +123,7 @@ mca_coll_xhc_component_t mca_coll_xhc_component = {
     .uniform_chunks_min = 4096,
 
     .op_mca = {{0}},
-    .op_mca_global = {0}
+    .op_mca_global = {0},
 };
 MCA_BASE_COMPONENT_INIT(ompi, coll, xhc)
 
@@ -145,6 +157,58 @@ static xhc_op_mca_t op_mca_default[XHC_COLLCOUNT] = {
         .hierarchy = "l3,numa,socket",
         .chunk_size = "16K",
         .cico_max = 4096
+    },
+
+    /* The exchange primitives copy directly from each peer; the hierarchy
+     * only drives the completion fan-in, and there is no pipeline. The CICO
+     * threshold applies to the data that each rank exposes to the others. */
+
+    [XHC_ALLGATHER] = {
+        .hierarchy = "numa,socket",
+        .chunk_size = "1",
+        .cico_max = 1024
+    },
+
+    [XHC_ALLGATHERV] = {
+        .hierarchy = "numa,socket",
+        .chunk_size = "1",
+        .cico_max = 1024
+    },
+
+    [XHC_GATHER] = {
+        .hierarchy = "numa,socket",
+        .chunk_size = "1",
+        .cico_max = 1024
+    },
+
+    [XHC_GATHERV] = {
+        .hierarchy = "numa,socket",
+        .chunk_size = "1",
+        .cico_max = 1024
+    },
+
+    [XHC_SCATTER] = {
+        .hierarchy = "numa,socket",
+        .chunk_size = "1",
+        .cico_max = 4096
+    },
+
+    [XHC_SCATTERV] = {
+        .hierarchy = "numa,socket",
+        .chunk_size = "1",
+        .cico_max = 4096
+    },
+
+    [XHC_ALLTOALL] = {
+        .hierarchy = "numa,socket",
+        .chunk_size = "1",
+        .cico_max = 4096
+    },
+
+    [XHC_ALLTOALLV] = {
+        .hierarchy = "numa,socket",
+        .chunk_size = "1",
+        .cico_max = 4096
     }
 };
 static xhc_op_mca_t op_mca_global_default = {0};
@@ -159,6 +223,26 @@ int mca_coll_xhc_component_init_query(bool enable_progress_threads,
     return OMPI_SUCCESS;
 }
 
+static int xhc_open(void) {
+    OBJ_CONSTRUCT(&mca_coll_xhc_component.requests, opal_free_list_t);
+    ompi_coll_base_progress_queue_construct(&mca_coll_xhc_component.active_requests,
+        mca_coll_xhc_request_advance, mca_coll_xhc_progress);
+
+    int err = opal_free_list_init(&mca_coll_xhc_component.requests,
+        sizeof(xhc_request_t), opal_cache_line_size, OBJ_CLASS(xhc_request_t),
+        0, 0, 8, -1, 8, NULL, 0, NULL, NULL, NULL);
+    if(OPAL_SUCCESS != err) {return err;}
+
+    return OMPI_SUCCESS;
+}
+
+static int xhc_close(void) {
+    ompi_coll_base_progress_queue_destruct(&mca_coll_xhc_component.active_requests);
+    OBJ_DESTRUCT(&mca_coll_xhc_component.requests);
+
+    return OMPI_SUCCESS;
+}
+
 COLLTYPE_T mca_coll_xhc_colltype_to_universal(XHC_COLLTYPE_T xhc_colltype) {
     if(xhc_colltype < 0 || xhc_colltype >= XHC_COLLCOUNT) {
         return -1;
@@ -432,7 +516,7 @@ static int xhc_register(void) {
     mca_base_var_get(vari, &var);
 
     for(int t = 0; t < XHC_COLLCOUNT; t++) {
-        if(XHC_BARRIER == t) {
+        if(!XHC_COLLTYPE_HAS_CHUNKS(t)) {
             continue;
         }
 
@@ -0,0 +1,293 @@
+/*
+ * Copyright (c) 2021-2024 Computer Architecture and VLSI Systems (CARV)
+ *                         Laboratory, ICS Forth. All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+#include "mpi.h"
+
+#include "ompi/constants.h"
+#include "ompi/datatype/ompi_datatype.h"
+#include "ompi/communicator/communicator.h"
+
+#include "coll_xhc.h"
+
+// ------------------------------------------------
+
+/* Non-root ranks publish their block, and the root copies each of them
+ * directly to its place in rbuf (see coll_xhc_xchg.c). The root is the
+ * leader on all hierarchy levels, so completion is propagated to the
+ * rest of the ranks immediately after its copies are done. */
+static int xhc_gather_internal(const void *sbuf, size_t my_len, void *rbuf,
+        const ptrdiff_t *block_disp, const size_t *block_len, int root,
+        ompi_communicator_t *ompi_comm, xhc_module_t *module,
+        XHC_COLLTYPE_T colltype) {
+
+    xhc_xchg_ctx_t ctx;
+    int err;
+
+    int rank = ompi_comm_rank(ompi_comm);
+    int comm_size = ompi_comm_size(ompi_comm);
+
+    xhc_xchg_init(module, ompi_comm, colltype, root, &ctx);
+
+    if(rank != root) {
+        err = xhc_xchg_publish(&ctx, sbuf, my_len);
+        if(OMPI_SUCCESS != err) {return err;}
+    } else {
+        err = xhc_xchg_publish(&ctx, NULL, 0);
+        if(OMPI_SUCCESS != err) {return err;}
+
+        if(MPI_IN_PLACE != sbuf && block_len[root] > 0) {
+            xhc_memcpy((char *) rbuf + block_disp[root],
+                sbuf, block_len[root]);
+        }
+
+        for(int i = 1; i < comm_size; i++) {
+            int peer = (root + i) % comm_size;
+
+            err = xhc_xchg_copy_from(&ctx, peer, (char *) rbuf
+                + block_disp[peer], 0, block_len[peer]);
+            if(OMPI_SUCCESS != err) {return err;}
+        }
+    }
+
+    xhc_xchg_fini(&ctx);
+
+    return OMPI_SUCCESS;
+}
+
+// ------------------------------------------------
+
+int mca_coll_xhc_gather(const void *sbuf, size_t scount,
+        ompi_datatype_t *sdtype, void *rbuf, size_t rcount,
+        ompi_datatype_t *rdtype, int root, ompi_communicator_t *ompi_comm,
+        mca_coll_base_module_t *ompi_module) {
+
+    xhc_module_t *module = (xhc_module_t *) ompi_module;
+
+    ptrdiff_t *block_disp = NULL;
+    size_t *block_len = NULL;
+    size_t block_size;
+    int err;
+
+    const void *flat_sbuf = sbuf;
+    void *flat_rbuf = rbuf;
+    void *stmp = NULL, *rtmp = NULL;
+
+    int rank = ompi_comm_rank(ompi_comm);
+    int comm_size = ompi_comm_size(ompi_comm);
+
+    // ---
+
+    /* The type signatures match, so the block
+     * size is the same at the root and elsewhere */
+    if(rank == root) {
+        ompi_datatype_type_size(rdtype, &block_size);
+        block_size *= rcount;
+    } else {
+        ompi_datatype_type_size(sdtype, &block_size);
+        block_size *= scount;
+    }
+
+    if(!module->zcopy_support) {
+        size_t cico_size = module->op_config[XHC_GATHER].cico_max;
+        if(block_size > cico_size) {
+            WARN_ONCE("coll:xhc: Warning: No smsc support; utilizing fallback "
+                "component for gather greater than %zu bytes", cico_size);
+            goto _fallback;
+        }
+    }
+
+    // ---
+
+    if(!module->op_data[XHC_GATHER].init) {
+        err = xhc_init_op(module, ompi_comm, XHC_GATHER);
+        if(OMPI_SUCCESS != err) {goto _fallback_permanent;}
+    }
+
+    if(MPI_IN_PLACE != sbuf && !xhc_xchg_dtype_flat(sdtype)) {
+        flat_sbuf = stmp = malloc(block_size + 1);
+        if(!stmp) {err = OMPI_ERR_OUT_OF_RESOURCE; goto _end;}
+
+        err = xhc_xchg_pack(stmp, sbuf, scount, sdtype);
+        if(OMPI_SUCCESS != err) {goto _end;}
+    }
+
+    if(rank == root) {
+        block_disp = malloc(comm_size * (sizeof(ptrdiff_t) + sizeof(size_t)));
+        if(!block_disp) {err = OMPI_ERR_OUT_OF_RESOURCE; goto _end;}
+
+        block_len = (size_t *) (block_disp + comm_size);
+
+        for(int r = 0; r < comm_size; r++) {
+            block_len[r] = block_size;
+            block_disp[r] = (ptrdiff_t) (r * block_size);
+        }
+
+        if(!xhc_xchg_dtype_flat(rdtype)) {
+            flat_rbuf = rtmp = malloc(comm_size * block_size + 1);
+            if(!rtmp) {err = OMPI_ERR_OUT_OF_RESOURCE; goto _end;}
+
+            /* Everything is unpacked at the end, including the root's own
+             * block, which is already in place in rbuf with MPI_IN_PLACE */
+            if(MPI_IN_PLACE == sbuf) {
+                ptrdiff_t lb, extent;
+                ompi_datatype_get_extent(rdtype, &lb, &extent);
+
+                err = xhc_xchg_pack((char *) rtmp + block_disp[root],
+                    (char *) rbuf + root * rcount * extent, rcount, rdtype);
+                if(OMPI_SUCCESS != err) {goto _end;}
+            }
+        }
+    }
+
+    err = xhc_gather_internal(flat_sbuf, block_size, flat_rbuf, block_disp,
+        block_len, root, ompi_comm, module, XHC_GATHER);
+
+    if(OMPI_SUCCESS == err && NULL != rtmp) {
+        err = xhc_xchg_unpack(rbuf, comm_size * rcount, rdtype, rtmp);
+    }
+
+_end:
+
+    free(block_disp);
+    free(stmp);
+    free(rtmp);
+
+    return err;
+
+    // ---
+
+_fallback_permanent:
+
+    XHC_INSTALL_FALLBACK(module,
+        ompi_comm, XHC_GATHER, gather);
+
+_fallback:
+
+    return XHC_CALL_FALLBACK(module->prev_colls, XHC_GATHER, gather,
+        sbuf, scount, sdtype, rbuf, rcount, rdtype, root, ompi_comm);
+}
+
+/* Without smsc support, gatherv always falls back: only the root knows
+ * all the counts, so the ranks can't agree on whether they fit in CICO. */
+int mca_coll_xhc_gatherv(const void *sbuf, size_t scount,
+        ompi_datatype_t *sdtype, void *rbuf, ompi_count_array_t rcounts,
+        ompi_disp_array_t displs, ompi_datatype_t *rdtype, int root,
+        ompi_communicator_t *ompi_comm, mca_coll_base_module_t *ompi_module) {
+
+    xhc_module_t *module = (xhc_module_t *) ompi_module;
+
+    ptrdiff_t *block_disp = NULL, *packed_displs = NULL;
+    size_t *block_len = NULL;
+    size_t dtype_size, my_len = 0;
+    int err;
+
+    const void *flat_sbuf = sbuf;
+    void *flat_rbuf = rbuf;
+    void *stmp = NULL, *rtmp = NULL;
+
+    int rank = ompi_comm_rank(ompi_comm);
+    int comm_size = ompi_comm_size(ompi_comm);
+
+    // ---
+
+    if(!module->zcopy_support) {
+        WARN_ONCE("coll:xhc: Warning: No smsc support; "
+            "utilizing fallback component for gatherv");
+        goto _fallback;
+    }
+
+    // ---
+
+    if(!module->op_data[XHC_GATHERV].init) {
+        err = xhc_init_op(module, ompi_comm, XHC_GATHERV);
+        if(OMPI_SUCCESS != err) {goto _fallback_permanent;}
+    }
+
+    if(MPI_IN_PLACE != sbuf) {
+        ompi_datatype_type_size(sdtype, &dtype_size);
+        my_len = scount * dtype_size;
+
+        if(!xhc_xchg_dtype_flat(sdtype)) {
+            flat_sbuf = stmp = malloc(my_len + 1);
+            if(!stmp) {err = OMPI_ERR_OUT_OF_RESOURCE; goto _end;}
+
+            err = xhc_xchg_pack(stmp, sbuf, scount, sdtype);
+            if(OMPI_SUCCESS != err) {goto _end;}
+        }
+    }
+
+    if(rank == root) {
+        block_disp = malloc(comm_size * (2 * sizeof(ptrdiff_t) + sizeof(size_t)));
+        if(!block_disp) {err = OMPI_ERR_OUT_OF_RESOURCE; goto _end;}
+
+        packed_displs = block_disp + comm_size;
+        block_len = (size_t *) (packed_displs + comm_size);
+
+        ompi_datatype_type_size(rdtype, &dtype_size);
+
+        if(xhc_xchg_dtype_flat(rdtype)) {
+            for(int r = 0; r < comm_size; r++) {
+                block_len[r] = ompi_count_array_get(rcounts, r) * dtype_size;
+                block_disp[r] = ompi_disp_array_get(displs, r) * (ptrdiff_t) dtype_size;
+            }
+        } else {
+            /* The blocks are gathered one after the other in a
+             * temporary buffer, and unpacked to rbuf at the end */
+            size_t total = xhc_xchg_packed_displs(rcounts, comm_size, packed_displs);
+
+            for(int r = 0; r < comm_size; r++) {
+                block_len[r] = ompi_count_array_get(rcounts, r) * dtype_size;
+                block_disp[r] = packed_displs[r] * (ptrdiff_t) dtype_size;
+            }
+
+            flat_rbuf = rtmp = malloc(total * dtype_size + 1);
+            if(!rtmp) {err = OMPI_ERR_OUT_OF_RESOURCE; goto _end;}
+
+            if(MPI_IN_PLACE == sbuf) {
+                ptrdiff_t lb, extent;
+                ompi_datatype_get_extent(rdtype, &lb, &extent);
+
+                err = xhc_xchg_pack((char *) rtmp + block_disp[root],
+                    (char *) rbuf + ompi_disp_array_get(displs, root) * extent,
+                    ompi_count_array_get(rcounts, root), rdtype);
+                if(OMPI_SUCCESS != err) {goto _end;}
+            }
+        }
+    }
+
+    err = xhc_gather_internal(flat_sbuf, my_len, flat_rbuf, block_disp,
+        block_len, root, ompi_comm, module, XHC_GATHERV);
+
+    if(OMPI_SUCCESS == err && NULL != rtmp) {
+        err = xhc_xchg_unpack_v(rbuf, rcounts, displs, rtmp,
+            packed_displs, comm_size, rdtype);
+    }
+
+_end:
+
+    free(block_disp);
+    free(stmp);
+    free(rtmp);
+
+    return err;
+
+    // ---
+
+_fallback_permanent:
+
+    XHC_INSTALL_FALLBACK(module,
+        ompi_comm, XHC_GATHERV, gatherv);
+
+_fallback:
+
+    return XHC_CALL_FALLBACK(module->prev_colls, XHC_GATHERV, gatherv,
+        sbuf, scount, sdtype, rbuf, rcounts, displs, rdtype, root, ompi_comm);
+}
@@ -36,25 +36,70 @@ OBJ_CLASS_INSTANCE(mca_coll_xhc_module_t, mca_coll_base_module_t,
 
 // -----------------------------
 
-static size_t xhc_colltype_to_c_coll_fn_offset_map[XHC_COLLCOUNT] = {
+static size_t xhc_colltype_to_c_coll_fn_offset_map[XHC_COLLCOUNT_ALL] = {
     [XHC_BCAST] = offsetof(mca_coll_base_comm_coll_t, coll_bcast),
     [XHC_BARRIER] = offsetof(mca_coll_base_comm_coll_t, coll_barrier),
     [XHC_REDUCE] = offsetof(mca_coll_base_comm_coll_t, coll_reduce),
-    [XHC_ALLREDUCE] = offsetof(mca_coll_base_comm_coll_t, coll_allreduce)
+    [XHC_ALLREDUCE] = offsetof(mca_coll_base_comm_coll_t, coll_allreduce),
+    [XHC_ALLGATHER] = offsetof(mca_coll_base_comm_coll_t, coll_allgather),
+    [XHC_ALLGATHERV] = offsetof(mca_coll_base_comm_coll_t, coll_allgatherv),
+    [XHC_GATHER] = offsetof(mca_coll_base_comm_coll_t, coll_gather),
+    [XHC_GATHERV] = offsetof(mca_coll_base_comm_coll_t, coll_gatherv),
+    [XHC_SCATTER] = offsetof(mca_coll_base_comm_coll_t, coll_scatter),
+    [XHC_SCATTERV] = offsetof(mca_coll_base_comm_coll_t, coll_scatterv),
+    [XHC_ALLTOALL] = offsetof(mca_coll_base_comm_coll_t, coll_alltoall),
+    [XHC_ALLTOALLV] = offsetof(mca_coll_base_comm_coll_t, coll_alltoallv),
+
+    [XHC_IBCAST] = offsetof(mca_coll_base_comm_coll_t, coll_ibcast),
+    [XHC_IBARRIER] = offsetof(mca_coll_base_comm_coll_t, coll_ibarrier),
+    [XHC_IALLREDUCE] = offsetof(mca_coll_base_comm_coll_t, coll_iallreduce),
+    [XHC_BCAST_INIT] = offsetof(mca_coll_base_comm_coll_t, coll_bcast_init),
+    [XHC_BARRIER_INIT] = offsetof(mca_coll_base_comm_coll_t, coll_barrier_init),
+    [XHC_ALLREDUCE_INIT] = offsetof(mca_coll_base_comm_coll_t, coll_allreduce_init)
 };
 
-static size_t xhc_colltype_to_c_coll_module_offset_map[XHC_COLLCOUNT] = {
+static size_t xhc_colltype_to_c_coll_module_offset_map[XHC_COLLCOUNT_ALL] = {
     [XHC_BCAST] = offsetof(mca_coll_base_comm_coll_t, coll_bcast_module),
     [XHC_BARRIER] = offsetof(mca_coll_base_comm_coll_t, coll_barrier_module),
     [XHC_REDUCE] = offsetof(mca_coll_base_comm_coll_t, coll_reduce_module),
-    [XHC_ALLREDUCE] = offsetof(mca_coll_base_comm_coll_t, coll_allreduce_module)
+    [XHC_ALLREDUCE] = offsetof(mca_coll_base_comm_coll_t, coll_allreduce_module),
+    [XHC_ALLGATHER] = offsetof(mca_coll_base_comm_coll_t, coll_allgather_module),
+    [XHC_ALLGATHERV] = offsetof(mca_coll_base_comm_coll_t, coll_allgatherv_module),
+    [XHC_GATHER] = offsetof(mca_coll_base_comm_coll_t, coll_gather_module),
+    [XHC_GATHERV] = offsetof(mca_coll_base_comm_coll_t, coll_gatherv_module),
+    [XHC_SCATTER] = offsetof(mca_coll_base_comm_coll_t, coll_scatter_module),
+    [XHC_SCATTERV] = offsetof(mca_coll_base_comm_coll_t, coll_scatterv_module),
+    [XHC_ALLTOALL] = offsetof(mca_coll_base_comm_coll_t, coll_alltoall_module),
+    [XHC_ALLTOALLV] = offsetof(mca_coll_base_comm_coll_t, coll_alltoallv_module),
+
+    [XHC_IBCAST] = offsetof(mca_coll_base_comm_coll_t, coll_ibcast_module),
+    [XHC_IBARRIER] = offsetof(mca_coll_base_comm_coll_t, coll_ibarrier_module),
+    [XHC_IALLREDUCE] = offsetof(mca_coll_base_comm_coll_t, coll_iallreduce_module),
+    [XHC_BCAST_INIT] = offsetof(mca_coll_base_comm_coll_t, coll_bcast_init_module),
+    [XHC_BARRIER_INIT] = offsetof(mca_coll_base_comm_coll_t, coll_barrier_init_module),
+    [XHC_ALLREDUCE_INIT] = offsetof(mca_coll_base_comm_coll_t, coll_allreduce_init_module)
 };
 
-static size_t xhc_colltype_to_base_module_fn_offset_map[XHC_COLLCOUNT] = {
+static size_t xhc_colltype_to_base_module_fn_offset_map[XHC_COLLCOUNT_ALL] = {
     [XHC_BCAST] = offsetof(mca_coll_base_module_t, coll_bcast),
     [XHC_BARRIER] = offsetof(mca_coll_base_module_t, coll_barrier),
     [XHC_REDUCE] = offsetof(mca_coll_base_module_t, coll_reduce),
-    [XHC_ALLREDUCE] = offsetof(mca_coll_base_module_t, coll_allreduce)
+    [XHC_ALLREDUCE] = offsetof(mca_coll_base_module_t, coll_allreduce),
+    [XHC_ALLGATHER] = offsetof(mca_coll_base_module_t, coll_allgather),
+    [XHC_ALLGATHERV] = offsetof(mca_coll_base_module_t, coll_allgatherv),
+    [XHC_GATHER] = offsetof(mca_coll_base_module_t, coll_gather),
+    [XHC_GATHERV] = offsetof(mca_coll_base_module_t, coll_gatherv),
+    [XHC_SCATTER] = offsetof(mca_coll_base_module_t, coll_scatter),
+    [XHC_SCATTERV] = offsetof(mca_coll_base_module_t, coll_scatterv),
+    [XHC_ALLTOALL] = offsetof(mca_coll_base_module_t, coll_alltoall),
+    [XHC_ALLTOALLV] = offsetof(mca_coll_base_module_t, coll_alltoallv),
+
+    [XHC_IBCAST] = offsetof(mca_coll_base_module_t, coll_ibcast),
+    [XHC_IBARRIER] = offsetof(mca_coll_base_module_t, coll_ibarrier),
+    [XHC_IALLREDUCE] = offsetof(mca_coll_base_module_t, coll_iallreduce),
+    [XHC_BCAST_INIT] = offsetof(mca_coll_base_module_t, coll_bcast_init),
+    [XHC_BARRIER_INIT] = offsetof(mca_coll_base_module_t, coll_barrier_init),
+    [XHC_ALLREDUCE_INIT] = offsetof(mca_coll_base_module_t, coll_allreduce_init)
 };
 
 static inline void (*MODULE_COLL_FN(xhc_module_t *module,
@@ -97,10 +142,14 @@ static void xhc_module_clear(xhc_module_t *module) {
 
     module->peer_info = NULL;
 
+    memset(&module->xchg_layout, 0, sizeof(module->xchg_layout));
     memset(&module->prev_colls, 0, sizeof(module->prev_colls));
     memset(&module->op_config, 0, sizeof(module->op_config));
     memset(&module->op_data, 0, sizeof(module->op_data));
 
+    module->nb_posted = 0;
+    module->nb_retired = 0;
+
     module->init = false;
     module->error = false;
 }
@@ -192,6 +241,22 @@ mca_coll_base_module_t *mca_coll_xhc_module_comm_query(ompi_communicator_t *comm
     module->super.coll_allreduce = mca_coll_xhc_allreduce;
     module->super.coll_reduce = mca_coll_xhc_reduce;
 
+    module->super.coll_allgather = mca_coll_xhc_allgather;
+    module->super.coll_allgatherv = mca_coll_xhc_allgatherv;
+    module->super.coll_gather = mca_coll_xhc_gather;
+    module->super.coll_gatherv = mca_coll_xhc_gatherv;
+    module->super.coll_scatter = mca_coll_xhc_scatter;
+    module->super.coll_scatterv = mca_coll_xhc_scatterv;
+    module->super.coll_alltoall = mca_coll_xhc_alltoall;
+    module->super.coll_alltoallv = mca_coll_xhc_alltoallv;
+
+    module->super.coll_ibcast = mca_coll_xhc_ibcast;
+    module->super.coll_ibarrier = mca_coll_xhc_ibarrier;
+    module->super.coll_iallreduce = mca_coll_xhc_iallreduce;
+    module->super.coll_bcast_init = mca_coll_xhc_bcast_init;
+    module->super.coll_barrier_init = mca_coll_xhc_barrier_init;
+    module->super.coll_allreduce_init = mca_coll_xhc_allreduce_init;
+
     return &module->super;
 }
 
@@ -214,7 +279,7 @@ int mca_coll_xhc_module_enable(mca_coll_base_module_t *ompi_module,
 
     // ---
 
-    for(int t = 0; t < XHC_COLLCOUNT; t++) {
+    for(int t = 0; t < XHC_COLLCOUNT_ALL; t++) {
         /* Don't want to save a fallback for
          * any op that we won't support */
         if(NULL == MODULE_COLL_FN(module, t)) {
@@ -240,7 +305,7 @@ int mca_coll_xhc_module_enable(mca_coll_base_module_t *ompi_module,
     /* We perform the pointer installation last, after we've
      * successfully captured all the fallback pointers we need,
      * and we know xhc_module_enable can no longer fail. */
-    for(int t = 0; t < XHC_COLLCOUNT; t++) {
+    for(int t = 0; t < XHC_COLLCOUNT_ALL; t++) {
         void (*fn)(void) = MODULE_COLL_FN(module, t);
         if(fn) {INSTALL_COLL_API(comm, t, fn, module);}
     }
@@ -264,7 +329,7 @@ void mca_coll_xhc_module_set_coll_fns(ompi_communicator_t *comm,
 
     xhc_coll_fns_t saved = {0};
 
-    for(int t = 0; t < XHC_COLLCOUNT; t++) {
+    for(int t = 0; t < XHC_COLLCOUNT_ALL; t++) {
         if(!new_fns->coll_fn[t]) {
             continue;
         }
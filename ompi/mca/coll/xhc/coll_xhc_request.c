@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2021-2024 Computer Architecture and VLSI Systems (CARV)
+ *                         Laboratory, ICS Forth. All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+#include "mpi.h"
+
+#include "ompi/constants.h"
+#include "ompi/communicator/communicator.h"
+#include "ompi/request/request.h"
+
+#include "coll_xhc.h"
+
+/* Non-blocking & Persistent Requests
+ * -----------------------------------------------------------------
+ * 1. The request-based ops use the same shared-memory control
+ *    structures and sequence numbers as their blocking counterparts.
+ *    As such, only one op may be in flight on a module at any time.
+ *    Requests are executed in the order they were started in (which
+ *    MPI requires to be the same on all ranks); each one receives a
+ *    ticket when posted, and is started once its turn comes.
+ *
+ * 2. Requests are advanced from inside opal_progress(), through
+ *    mca_coll_xhc_progress(), without ever blocking. The op-specific
+ *    test function returns OMPI_ERR_WOULD_BLOCK for as long as it
+ *    has to wait for other ranks.
+ *
+ * 3. Blocking ops that share state with a request-based op, first
+ *    drain the module's outstanding requests (xhc_request_drain).
+ *
+ * 4. Persistent requests retain their setup (support checks, hierarchy,
+ *    and, for bcast, the exposed buffer region and the attachment to the
+ *    leader's buffer) across starts. These are released when the
+ *    request is freed.
+ * ----------------------------------------------------------------- */
+
+// ------------------------------------------------
+
+static int xhc_request_start(size_t count, ompi_request_t **requests) {
+    for(size_t i = 0; i < count; i++) {
+        xhc_request_t *req = (xhc_request_t *) requests[i];
+
+        if(NULL == req) {
+            continue;
+        }
+
+        int err = xhc_request_post(req);
+        if(OMPI_SUCCESS != err) {return err;}
+    }
+
+    return OMPI_SUCCESS;
+}
+
+static int xhc_request_cancel(ompi_request_t *request, int complete) {
+    return MPI_ERR_REQUEST;
+}
+
+static int xhc_request_free(ompi_request_t **ompi_req) {
+    xhc_request_t *req = (xhc_request_t *) *ompi_req;
+
+    if(!REQUEST_COMPLETE(&req->super)) {
+        return MPI_ERR_REQUEST;
+    }
+
+    switch(req->colltype) {
+        case XHC_BCAST_INIT:
+            xhc_bcast_release(&req->ctx.bcast);
+            break;
+
+        case XHC_ALLREDUCE_INIT:
+            xhc_bcast_release(&req->ctx.allreduce.bcast_ctx);
+            break;
+
+        default:
+            break;
+    }
+
+    OMPI_REQUEST_FINI(&req->super);
+    opal_free_list_return(&mca_coll_xhc_component.requests,
+        (opal_free_list_item_t *) req);
+
+    *ompi_req = MPI_REQUEST_NULL;
+
+    return OMPI_SUCCESS;
+}
+
+static void xhc_request_construct(xhc_request_t *req) {
+    req->super.req_type = OMPI_REQUEST_COLL;
+    req->super.req_start = xhc_request_start;
+    req->super.req_free = xhc_request_free;
+    req->super.req_cancel = xhc_request_cancel;
+}
+
+OBJ_CLASS_INSTANCE(xhc_request_t, ompi_request_t,
+    xhc_request_construct, NULL);
+
+// ------------------------------------------------
+
+xhc_request_t *mca_coll_xhc_request_alloc(xhc_module_t *module,
+        ompi_communicator_t *comm, XHC_COLLTYPE_T colltype, bool persistent) {
+
+    opal_free_list_item_t *item = opal_free_list_wait(
+        &mca_coll_xhc_component.requests);
+    if(NULL == item) {return NULL;}
+
+    xhc_request_t *req = (xhc_request_t *) item;
+
+    OMPI_REQUEST_INIT(&req->super, persistent);
+    req->super.req_mpi_object.comm = comm;
+
+    req->module = module;
+    req->colltype = colltype;
+
+    req->start_fn = NULL;
+    req->test_fn = NULL;
+
+    req->started = false;
+
+    memset(&req->ctx, 0, sizeof(req->ctx));
+
+    return req;
+}
+
+int mca_coll_xhc_request_post(xhc_request_t *req) {
+    xhc_module_t *module = req->module;
+
+    req->started = false;
+
+    /* The ticket sets the order of the requests on the module; the
+     * queue may hold them in any order */
+    OPAL_THREAD_LOCK(&mca_coll_xhc_component.active_requests.lock);
+    req->ticket = module->nb_posted++;
+    OPAL_THREAD_UNLOCK(&mca_coll_xhc_component.active_requests.lock);
+
+    ompi_coll_base_progress_queue_append(
+        &mca_coll_xhc_component.active_requests, &req->super);
+
+    /* Give it a push right away; small ops
+     * might even complete without waiting */
+    mca_coll_xhc_progress();
+
+    return OMPI_SUCCESS;
+}
+
+// ------------------------------------------------
+
+/* Called by the progress queue, which runs it in one thread at a time */
+int mca_coll_xhc_request_advance(ompi_request_t *request) {
+    xhc_request_t *req = (xhc_request_t *) request;
+    xhc_module_t *module = req->module;
+    int err = OMPI_SUCCESS;
+
+    // Not its turn yet
+    if(req->ticket != module->nb_retired) {
+        return OMPI_ERR_WOULD_BLOCK;
+    }
+
+    if(!req->started) {
+        err = req->start_fn(req);
+        req->started = true;
+    }
+
+    if(OMPI_SUCCESS == err) {
+        err = req->test_fn(req);
+    }
+
+    if(OMPI_ERR_WOULD_BLOCK != err) {
+        module->nb_retired++;
+    }
+
+    return err;
+}
+
+int mca_coll_xhc_progress(void) {
+    return ompi_coll_base_progress_queue_progress(
+        &mca_coll_xhc_component.active_requests);
+}
@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2021-2024 Computer Architecture and VLSI Systems (CARV)
+ *                         Laboratory, ICS Forth. All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+#include "mpi.h"
+
+#include "ompi/constants.h"
+#include "ompi/datatype/ompi_datatype.h"
+#include "ompi/communicator/communicator.h"
+
+#include "coll_xhc.h"
+
+// ------------------------------------------------
+
+/* The root publishes its send buffer, and every other rank copies its own
+ * block straight from it (see coll_xhc_xchg.c). The root is the leader on
+ * all hierarchy levels, and learns that it may reuse its buffer once all
+ * ranks' completion signals have been gathered to it. */
+
+int mca_coll_xhc_scatter(const void *sbuf, size_t scount,
+        ompi_datatype_t *sdtype, void *rbuf, size_t rcount,
+        ompi_datatype_t *rdtype, int root, ompi_communicator_t *ompi_comm,
+        mca_coll_base_module_t *ompi_module) {
+
+    xhc_module_t *module = (xhc_module_t *) ompi_module;
+
+    xhc_xchg_ctx_t ctx;
+    size_t block_size;
+    int err;
+
+    const void *flat_sbuf = sbuf;
+    void *tmp = NULL;
+
+    int rank = ompi_comm_rank(ompi_comm);
+    int comm_size = ompi_comm_size(ompi_comm);
+
+    // ---
+
+    /* The type signatures match, so the block
+     * size is the same at the root and elsewhere */
+    if(rank == root) {
+        ompi_datatype_type_size(sdtype, &block_size);
+        block_size *= scount;
+    } else {
+        ompi_datatype_type_size(rdtype, &block_size);
+        block_size *= rcount;
+    }
+
+    if(!module->zcopy_support) {
+        size_t cico_size = module->op_config[XHC_SCATTER].cico_max;
+        if(comm_size * block_size > cico_size) {
+            WARN_ONCE("coll:xhc: Warning: No smsc support; utilizing fallback "
+                "component for scatter greater than %zu bytes", cico_size);
+            goto _fallback;
+        }
+    }
+
+    // ---
+
+    if(!module->op_data[XHC_SCATTER].init) {
+        err = xhc_init_op(module, ompi_comm, XHC_SCATTER);
+        if(OMPI_SUCCESS != err) {goto _fallback_permanent;}
+    }
+
+    if(rank == root && !xhc_xchg_dtype_flat(sdtype)) {
+        /* The blocks of all ranks follow each other in sbuf */
+        flat_sbuf = tmp = malloc(comm_size * block_size + 1);
+        if(!tmp) {return OMPI_ERR_OUT_OF_RESOURCE;}
+
+        err = xhc_xchg_pack(tmp, sbuf, comm_size * scount, sdtype);
+        if(OMPI_SUCCESS != err) {goto _end;}
+    } else if(rank != root && !xhc_xchg_dtype_flat(rdtype)) {
+        tmp = malloc(block_size + 1);
+        if(!tmp) {return OMPI_ERR_OUT_OF_RESOURCE;}
+    }
+
+    xhc_xchg_init(module, ompi_comm, XHC_SCATTER, root, &ctx);
+
+    if(rank == root) {
+        err = xhc_xchg_publish(&ctx, flat_sbuf, comm_size * block_size);
+        if(OMPI_SUCCESS != err) {goto _end;}
+
+        if(MPI_IN_PLACE != rbuf && block_size > 0) {
+            const char *my_block = (char *) flat_sbuf + root * block_size;
+
+            if(xhc_xchg_dtype_flat(rdtype)) {
+                xhc_memcpy(rbuf, my_block, block_size);
+            } else {
+                err = xhc_xchg_unpack(rbuf, rcount, rdtype, my_block);
+                if(OMPI_SUCCESS != err) {goto _end;}
+            }
+        }
+    } else {
+        err = xhc_xchg_publish(&ctx, NULL, 0);
+        if(OMPI_SUCCESS != err) {goto _end;}
+
+        err = xhc_xchg_copy_from(&ctx, root, (NULL != tmp ? tmp : rbuf),
+            rank * block_size, block_size);
+        if(OMPI_SUCCESS != err) {goto _end;}
+    }
+
+    xhc_xchg_fini(&ctx);
+
+    if(rank != root && NULL != tmp) {
+        err = xhc_xchg_unpack(rbuf, rcount, rdtype, tmp);
+    }
+
+_end:
+
+    free(tmp);
+
+    return err;
+
+    // ---
+
+_fallback_permanent:
+
+    XHC_INSTALL_FALLBACK(module,
+        ompi_comm, XHC_SCATTER, scatter);
+
+_fallback:
+
+    return XHC_CALL_FALLBACK(module->prev_colls, XHC_SCATTER, scatter,
+        sbuf, scount, sdtype, rbuf, rcount, rdtype, root, ompi_comm);
+}
+
+/* Without smsc support, scatterv always falls back: only the root knows
+ * all the counts, so the ranks can't agree on whether they fit in CICO.
+ * The other ranks don't know the displacements either; the root places
+ * them in its displacement table (see xhc_xchg_publish_v). */
+int mca_coll_xhc_scatterv(const void *sbuf, ompi_count_array_t scounts,
+        ompi_disp_array_t displs, ompi_datatype_t *sdtype, void *rbuf,
+        size_t rcount, ompi_datatype_t *rdtype, int root,
+        ompi_communicator_t *ompi_comm, mca_coll_base_module_t *ompi_module) {
+
+    xhc_module_t *module = (xhc_module_t *) ompi_module;
+
+    xhc_xchg_ctx_t ctx;
+    size_t dtype_size;
+    int err;
+
+    const void *flat_sbuf = sbuf;
+    ompi_disp_array_t flat_displs = displs;
+    ptrdiff_t *packed_displs = NULL;
+    void *tmp = NULL;
+
+    int rank = ompi_comm_rank(ompi_comm);
+    int comm_size = ompi_comm_size(ompi_comm);
+
+    // ---
+
+    if(!module->zcopy_support) {
+        WARN_ONCE("coll:xhc: Warning: No smsc support; "
+            "utilizing fallback component for scatterv");
+        goto _fallback;
+    }
+
+    // ---
+
+    if(!module->op_data[XHC_SCATTERV].init) {
+        err = xhc_init_op(module, ompi_comm, XHC_SCATTERV);
+        if(OMPI_SUCCESS != err) {goto _fallback_permanent;}
+    }
+
+    if(rank == root) {
+        ompi_datatype_type_size(sdtype, &dtype_size);
+
+        if(!xhc_xchg_dtype_flat(sdtype)) {
+            /* The blocks are packed one after the other */
+            packed_displs = malloc(comm_size * sizeof(ptrdiff_t));
+            if(!packed_displs) {return OMPI_ERR_OUT_OF_RESOURCE;}
+
+            size_t total = xhc_xchg_packed_displs(scounts, comm_size, packed_displs);
+
+            flat_sbuf = tmp = malloc(total * dtype_size + 1);
+            if(!tmp) {err = OMPI_ERR_OUT_OF_RESOURCE; goto _end;}
+
+            err = xhc_xchg_pack_v(tmp, sbuf, scounts, displs,
+                packed_displs, comm_size, sdtype);
+            if(OMPI_SUCCESS != err) {goto _end;}
+
+            ompi_disp_array_init_c(&flat_displs, packed_displs);
+        }
+    } else {
+        ompi_datatype_type_size(rdtype, &dtype_size);
+
+        if(!xhc_xchg_dtype_flat(rdtype)) {
+            tmp = malloc(rcount * dtype_size + 1);
+            if(!tmp) {return OMPI_ERR_OUT_OF_RESOURCE;}
+        }
+    }
+
+    xhc_xchg_init(module, ompi_comm, XHC_SCATTERV, root, &ctx);
+
+    if(rank == root) {
+        err = xhc_xchg_publish_v(&ctx, flat_sbuf, scounts, flat_displs, dtype_size);
+        if(OMPI_SUCCESS != err) {goto _end;}
+
+        size_t my_count = ompi_count_array_get(scounts, root);
+        const char *my_block = (char *) flat_sbuf
+            + ompi_disp_array_get(flat_displs, root) * (ptrdiff_t) dtype_size;
+
+        if(MPI_IN_PLACE != rbuf && my_count > 0) {
+            if(xhc_xchg_dtype_flat(rdtype)) {
+                xhc_memcpy(rbuf, my_block, my_count * dtype_size);
+            } else {
+                err = xhc_xchg_unpack(rbuf, rcount, rdtype, my_block);
+                if(OMPI_SUCCESS != err) {goto _end;}
+            }
+        }
+    } else {
+        err = xhc_xchg_publish(&ctx, NULL, 0);
+        if(OMPI_SUCCESS != err) {goto _end;}
+
+        err = xhc_xchg_copy_from(&ctx, root, (NULL != tmp ? tmp : rbuf),
+            xhc_xchg_peer_disp(&ctx, root), rcount * dtype_size);
+        if(OMPI_SUCCESS != err) {goto _end;}
+    }
+
+    xhc_xchg_fini(&ctx);
+
+    if(rank != root && NULL != tmp) {
+        err = xhc_xchg_unpack(rbuf, rcount, rdtype, tmp);
+    }
+
+_end:
+
+    free(packed_displs);
+    free(tmp);
+
+    return err;
+
+    // ---
+
+_fallback_permanent:
+
+    XHC_INSTALL_FALLBACK(module,
+        ompi_comm, XHC_SCATTERV, scatterv);
+
+_fallback:
+
+    return XHC_CALL_FALLBACK(module->prev_colls, XHC_SCATTERV, scatterv,
+        sbuf, scounts, displs, sdtype, rbuf, rcount, rdtype, root, ompi_comm);
+}
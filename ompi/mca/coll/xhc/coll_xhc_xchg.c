@@ -0,0 +1,385 @@
+/*
+ * Copyright (c) 2021-2024 Computer Architecture and VLSI Systems (CARV)
+ *                         Laboratory, ICS Forth. All rights reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+#include "mpi.h"
+
+#include "ompi/constants.h"
+#include "ompi/datatype/ompi_datatype.h"
+#include "ompi/communicator/communicator.h"
+#include "opal/datatype/opal_convertor.h"
+#include "opal/util/minmax.h"
+
+#include "coll_xhc.h"
+
+/* Data Exchange Primitives (Allgather, Gather, Scatter, Alltoall)
+ * -----------------------------------------------------------------
+ * 1. Each rank publishes the data it contributes to the op in its
+ *    per-rank exchange segment: small data is copied in the segment's
+ *    CICO buffer, larger data is exposed for single-copy access through
+ *    opal/smsc. The rank's exchange ctrl seq field signals this.
+ *
+ * 2. Ranks copy the parts they need directly from the peers' published
+ *    data, as soon as each peer has published it. With XPMEM-like smsc
+ *    modules, the peers' buffers are attached through the persistent
+ *    registration cache, and are reused across ops.
+ *
+ * 3. A hierarchical seq/ack wave (see xhc_barrier_internal) signals that
+ *    all ranks have completed their copies. It is the point after which
+ *    each rank may reuse its buffers and its exchange segment.
+ * ----------------------------------------------------------------- */
+
+// ------------------------------------------------
+
+static inline xhc_xchg_ctrl_t *xhc_xchg_ctrl(xhc_module_t *module,
+        void *xchg_seg, XHC_COLLTYPE_T colltype) {
+
+    return (xhc_xchg_ctrl_t *) ((char *) xchg_seg
+        + module->xchg_layout.ctrl_offset[colltype]);
+}
+
+static inline xhc_xchg_ctrl_t *xhc_xchg_peer_ctrl(xhc_xchg_ctx_t *ctx,
+        int peer) {
+
+    void *xchg_seg = xhc_get_xchg(ctx->module->peer_info, peer);
+    if(NULL == xchg_seg) {return NULL;}
+
+    xhc_xchg_ctrl_t *ctrl = xhc_xchg_ctrl(ctx->module,
+        xchg_seg, ctx->colltype);
+
+    /* No need for windowed comparison; the peer won't move on to
+     * the next op before we've signaled completion of this one */
+    WAIT_FLAG(&ctrl->seq, ctx->seq, 0);
+    xhc_atomic_rmb();
+
+    return ctrl;
+}
+
+// ------------------------------------------------
+
+/* The data of contiguous predefined types can be exchanged in place, as a
+ * flat byte array (size == extent). Other types are packed to, or unpacked
+ * from, a temporary buffer (see xhc_xchg_pack). The type signatures match
+ * across ranks, so the exchanged bytes are the same either way, and each
+ * rank may decide on its own, without agreement with its peers. */
+bool mca_coll_xhc_xchg_dtype_flat(ompi_datatype_t *datatype) {
+    if(!ompi_datatype_is_predefined(datatype)) {
+        return false;
+    }
+
+    size_t dtype_size;
+    ptrdiff_t dtype_extent;
+
+    ompi_datatype_type_size(datatype, &dtype_size);
+    ompi_datatype_type_extent(datatype, &dtype_extent);
+
+    return ((ptrdiff_t) dtype_size == dtype_extent);
+}
+
+// Pack 'count' elements of 'datatype' at 'src' to the flat buffer 'dst'
+int mca_coll_xhc_xchg_pack(void *dst, const void *src,
+        size_t count, ompi_datatype_t *datatype) {
+
+    opal_convertor_t convertor;
+    struct iovec iov;
+    uint32_t iov_count = 1;
+    size_t max_data;
+
+    ompi_datatype_type_size(datatype, &max_data);
+    max_data *= count;
+
+    if(0 == max_data) {
+        return OMPI_SUCCESS;
+    }
+
+    OBJ_CONSTRUCT(&convertor, opal_convertor_t);
+    opal_convertor_copy_and_prepare_for_send(ompi_mpi_local_convertor,
+        &datatype->super, count, src, 0, &convertor);
+
+    iov.iov_base = dst;
+    iov.iov_len = max_data;
+
+    opal_convertor_pack(&convertor, &iov, &iov_count, &max_data);
+    OBJ_DESTRUCT(&convertor);
+
+    return (max_data == iov.iov_len ? OMPI_SUCCESS : OMPI_ERROR);
+}
+
+// Unpack 'count' elements of 'datatype' from the flat buffer 'src' to 'dst'
+int mca_coll_xhc_xchg_unpack(void *dst, size_t count,
+        ompi_datatype_t *datatype, const void *src) {
+
+    opal_convertor_t convertor;
+    struct iovec iov;
+    uint32_t iov_count = 1;
+    size_t max_data;
+
+    ompi_datatype_type_size(datatype, &max_data);
+    max_data *= count;
+
+    if(0 == max_data) {
+        return OMPI_SUCCESS;
+    }
+
+    OBJ_CONSTRUCT(&convertor, opal_convertor_t);
+    opal_convertor_copy_and_prepare_for_recv(ompi_mpi_local_convertor,
+        &datatype->super, count, dst, 0, &convertor);
+
+    iov.iov_base = (void *) src;
+    iov.iov_len = max_data;
+
+    opal_convertor_unpack(&convertor, &iov, &iov_count, &max_data);
+    OBJ_DESTRUCT(&convertor);
+
+    return (max_data == iov.iov_len ? OMPI_SUCCESS : OMPI_ERROR);
+}
+
+/* Displacements (in elements) of the blocks described by 'counts' when
+ * packed one after the other; returns the total number of elements */
+size_t mca_coll_xhc_xchg_packed_displs(ompi_count_array_t counts,
+        int nblocks, ptrdiff_t *packed_displs) {
+
+    size_t total = 0;
+
+    for(int r = 0; r < nblocks; r++) {
+        packed_displs[r] = (ptrdiff_t) total;
+        total += ompi_count_array_get(counts, r);
+    }
+
+    return total;
+}
+
+/* Pack the blocks described by 'counts' and 'displs' (in extents of
+ * 'datatype') to 'dst', at 'packed_displs' (see xhc_xchg_packed_displs) */
+int mca_coll_xhc_xchg_pack_v(void *dst, const void *src,
+        ompi_count_array_t counts, ompi_disp_array_t displs,
+        const ptrdiff_t *packed_displs, int nblocks,
+        ompi_datatype_t *datatype) {
+
+    size_t dtype_size;
+    ptrdiff_t lb, extent;
+    int err;
+
+    ompi_datatype_type_size(datatype, &dtype_size);
+    ompi_datatype_get_extent(datatype, &lb, &extent);
+
+    for(int r = 0; r < nblocks; r++) {
+        err = xhc_xchg_pack((char *) dst + packed_displs[r] * (ptrdiff_t) dtype_size,
+            (char *) src + ompi_disp_array_get(displs, r) * extent,
+            ompi_count_array_get(counts, r), datatype);
+        if(OMPI_SUCCESS != err) {return err;}
+    }
+
+    return OMPI_SUCCESS;
+}
+
+// The reverse of xhc_xchg_pack_v
+int mca_coll_xhc_xchg_unpack_v(void *dst, ompi_count_array_t counts,
+        ompi_disp_array_t displs, const void *src,
+        const ptrdiff_t *packed_displs, int nblocks,
+        ompi_datatype_t *datatype) {
+
+    size_t dtype_size;
+    ptrdiff_t lb, extent;
+    int err;
+
+    ompi_datatype_type_size(datatype, &dtype_size);
+    ompi_datatype_get_extent(datatype, &lb, &extent);
+
+    for(int r = 0; r < nblocks; r++) {
+        err = xhc_xchg_unpack((char *) dst + ompi_disp_array_get(displs, r) * extent,
+            ompi_count_array_get(counts, r), datatype,
+            (char *) src + packed_displs[r] * (ptrdiff_t) dtype_size);
+        if(OMPI_SUCCESS != err) {return err;}
+    }
+
+    return OMPI_SUCCESS;
+}
+
+void mca_coll_xhc_xchg_init(xhc_module_t *module,
+        ompi_communicator_t *ompi_comm, XHC_COLLTYPE_T colltype,
+        int root, xhc_xchg_ctx_t *ctx) {
+
+    xhc_op_data_t *data = &module->op_data[colltype];
+
+    ctx->module = module;
+    ctx->colltype = colltype;
+
+    ctx->rank = ompi_comm_rank(ompi_comm);
+    ctx->root = root;
+
+    ctx->seq = ++(data->seq);
+    ctx->comms = data->comms;
+
+    ctx->my_ctrl = xhc_xchg_ctrl(module,
+        module->peer_info[ctx->rank].xchg_seg, colltype);
+
+    ctx->method = XHC_COPY_CICO;
+    ctx->region_data = NULL;
+}
+
+// Make 'len' bytes at 'data' available to the other ranks
+int mca_coll_xhc_xchg_publish(xhc_xchg_ctx_t *ctx,
+        const void *data, size_t len) {
+
+    xhc_module_t *module = ctx->module;
+    xhc_xchg_ctrl_t *ctrl = ctx->my_ctrl;
+
+    char *xchg_seg = module->peer_info[ctx->rank].xchg_seg;
+
+    /* Safe to modify the segment without checking any flags; all
+     * peers have signaled completion of the previous op, at its end. */
+
+    if(len <= module->op_config[ctx->colltype].cico_max) {
+        ctx->method = XHC_COPY_CICO;
+
+        if(len > 0) {
+            xhc_memcpy(xchg_seg + module->xchg_layout.cico_offset[ctx->colltype],
+                data, len);
+        }
+    } else {
+        ctx->method = (module->zcopy_map_support ?
+            XHC_COPY_SMSC_MAP : XHC_COPY_SMSC_NO_MAP);
+
+        int err = xhc_copy_expose_region((void *) data,
+            len, &ctx->region_data);
+        if(0 != err) {return OMPI_ERROR;}
+
+        ctrl->data_vaddr = (void *) data;
+
+        if(NULL != ctx->region_data) {
+            xhc_copy_region_post((void *) ctrl->access_token,
+                ctx->region_data);
+        }
+    }
+
+    ctrl->method = ctx->method;
+    ctrl->data_len = len;
+
+    /* Make sure the above stores complete
+     * before the one to the control flag */
+    xhc_atomic_wmb();
+
+    ctrl->seq = ctx->seq;
+
+    return OMPI_SUCCESS;
+}
+
+/* Publish the blocks described by 'counts' and 'displs' (in elements), as
+ * a single region that spans all of them. The displacement of each rank's
+ * block inside the region is placed in the displacement table, for the
+ * respective rank to look it up (see xhc_xchg_peer_disp). */
+int mca_coll_xhc_xchg_publish_v(xhc_xchg_ctx_t *ctx, const void *buf,
+        ompi_count_array_t counts, ompi_disp_array_t displs,
+        size_t dtype_size) {
+
+    xhc_module_t *module = ctx->module;
+
+    size_t *disps = (size_t *) ((char *) module->peer_info[ctx->rank].xchg_seg
+        + module->xchg_layout.disp_offset);
+
+    ptrdiff_t lo = PTRDIFF_MAX, hi = PTRDIFF_MIN;
+
+    for(int r = 0; r < module->comm_size; r++) {
+        size_t count = ompi_count_array_get(counts, r);
+        if(0 == count) {continue;}
+
+        ptrdiff_t disp = ompi_disp_array_get(displs, r) * (ptrdiff_t) dtype_size;
+
+        lo = opal_min(lo, disp);
+        hi = opal_max(hi, disp + (ptrdiff_t) (count * dtype_size));
+    }
+
+    if(lo > hi) {
+        lo = hi = 0;
+    }
+
+    for(int r = 0; r < module->comm_size; r++) {
+        disps[r] = (0 == ompi_count_array_get(counts, r) ? 0 :
+            (size_t) (ompi_disp_array_get(displs, r) * (ptrdiff_t) dtype_size - lo));
+    }
+
+    return xhc_xchg_publish(ctx, (char *) buf + lo, (size_t) (hi - lo));
+}
+
+size_t mca_coll_xhc_xchg_peer_disp(xhc_xchg_ctx_t *ctx, int peer) {
+    xhc_xchg_ctrl_t *ctrl = xhc_xchg_peer_ctrl(ctx, peer);
+    if(NULL == ctrl) {return 0;}
+
+    size_t *disps = (size_t *) ((char *) ctx->module->peer_info[peer].xchg_seg
+        + ctx->module->xchg_layout.disp_offset);
+
+    return disps[ctx->rank];
+}
+
+// Copy 'len' bytes, from 'offset' inside the data that 'peer' has published
+int mca_coll_xhc_xchg_copy_from(xhc_xchg_ctx_t *ctx, int peer,
+        void *dst, size_t offset, size_t len) {
+
+    xhc_peer_info_t *peer_info = ctx->module->peer_info;
+
+    xhc_xchg_ctrl_t *ctrl = xhc_xchg_peer_ctrl(ctx, peer);
+    if(NULL == ctrl) {return OMPI_ERR_OUT_OF_RESOURCE;}
+
+    if(0 == len) {
+        return OMPI_SUCCESS;
+    }
+
+    assert(offset + len <= ctrl->data_len);
+
+    switch(ctrl->method) {
+        case XHC_COPY_CICO: {
+            char *src = (char *) peer_info[peer].xchg_seg
+                + ctx->module->xchg_layout.cico_offset[ctx->colltype];
+
+            xhc_memcpy(dst, src + offset, len);
+            break;
+        }
+
+        case XHC_COPY_SMSC_MAP: {
+            xhc_reg_t *reg;
+
+            char *src = xhc_get_registration(&peer_info[peer],
+                ctrl->data_vaddr, ctrl->data_len, &reg);
+            if(NULL == src) {return OMPI_ERROR;}
+
+            xhc_memcpy(dst, src + offset, len);
+            xhc_return_registration(reg);
+
+            break;
+        }
+
+        case XHC_COPY_SMSC_NO_MAP: {
+            int err = xhc_copy_from(&peer_info[peer], dst,
+                (char *) ctrl->data_vaddr + offset, len,
+                (void *) ctrl->access_token);
+            if(0 != err) {return OMPI_ERROR;}
+
+            break;
+        }
+
+        default:
+            assert(0);
+            return OMPI_ERROR;
+    }
+
+    return OMPI_SUCCESS;
+}
+
+void mca_coll_xhc_xchg_fini(xhc_xchg_ctx_t *ctx) {
+    /* Gather completion towards the root (the leader on all levels), and
+     * release all ranks once everybody's done copying from everybody */
+    xhc_barrier_internal(ctx->comms, ctx->module->peer_info,
+        ctx->rank, ctx->root, ctx->seq);
+
+    if(ctx->region_data) {
+        xhc_copy_close_region(ctx->region_data);
+    }
+}
@@ -195,6 +195,10 @@ struct ompio_file_t {
        Note: Neither f_sharedfp nor f_sharedfp_component seemed appropriate for this.
     */
     void                  *f_sharedfp_data;
+    /* Place for the selected fbtl module to hang its per-file data */
+    void                  *f_fbtl_data;
+    /* Place for the selected fcoll module to hang its per-file data */
+    void                  *f_fcoll_data;
 
     /* File View parameters */
     struct ompio_fview_t   f_fview;
@@ -147,6 +147,8 @@ int mca_common_ompio_file_open (ompi_communicator_t *comm,
         opal_output(1, "mca_fs_base_file_select() failed\n");
         goto fn_fail;
     }
+    ompio_fh->f_fbtl_data = NULL;
+    ompio_fh->f_fcoll_data = NULL;
     if (OMPI_SUCCESS != (ret = mca_fbtl_base_file_select (ompio_fh,
                                                           NULL))) {
         opal_output(1, "mca_fbtl_base_file_select() failed\n");
@@ -55,6 +55,36 @@ static int read_heap_sort (mca_io_ompio_local_io_array *io_array,
                            int num_entries,
                            int *sorted);
 
+/* The aggregator reads the next cycle into one buffer while the
+ * previous cycle is scattered from the other one */
+#define READ_ALL_NUM_CYCLE_BUFS 2
+
+typedef struct read_all_cycle_t {
+    char                        *global_buf;
+    int                        **blocklen_per_process;
+    MPI_Aint                   **displs_per_process;
+    ptrdiff_t                   *disp_index;
+    mca_io_ompio_local_io_array *file_offsets_for_agg;
+    int                         *sorted_file_offsets;
+    MPI_Aint                    *memory_displacements;
+    int                          entries_per_aggregator;
+    int                          bytes_received;   /* by this process in the cycle */
+    ompi_request_t              *read_req;
+} read_all_cycle_t;
+
+static int read_all_prepare_cycle (ompio_file_t *fh,
+                                   read_all_cycle_t *cycle,
+                                   MPI_Aint bytes_to_read_in_cycle,
+                                   bool is_aggregator,
+                                   bool use_accelerator_buffer,
+                                   struct iovec *global_iov_array,
+                                   int *sorted,
+                                   size_t *fview_count,
+                                   size_t *current_index_ptr,
+                                   MPI_Aint *bytes_remaining_ptr);
+static int read_all_start_read (ompio_file_t *fh, read_all_cycle_t *cycle,
+                                bool use_accelerator_buffer);
+
 
 
 int
@@ -65,36 +95,27 @@ mca_common_ompio_base_file_read_all (struct ompio_file_t *fh,
                                      ompi_status_public_t *status)
 {
     MPI_Aint total_bytes = 0;          /* total bytes to be read */
-    MPI_Aint bytes_to_read_in_cycle = 0; /* left to be read in a cycle*/
     MPI_Aint bytes_per_cycle = 0;      /* total read in each cycle by each process*/
     int index = 0, ret=OMPI_SUCCESS;
     int cycles = 0;
-    int i=0, j=0, l=0;
-    int n=0; /* current position in total_bytes_per_process array */
+    int i=0, l=0, k=0;
     MPI_Aint bytes_remaining = 0; /* how many bytes have been read from the current
                                      value from total_bytes_per_process */
-    int *sorted_file_offsets=NULL, entries_per_aggregator=0;
-    int bytes_received = 0;
-    int blocks = 0;
     /* iovec structure and count of the buffer passed in */
     uint32_t iov_count = 0;
     struct iovec *decoded_iov = NULL;
     int iov_index = 0;
     size_t current_position = 0;
     struct iovec *local_iov_array=NULL, *global_iov_array=NULL;
-    MPI_Aint *memory_displacements=NULL;
     /* global iovec at the readers that contain the iovecs created from
        file_set_view */
     uint32_t total_fview_count = 0;
     size_t local_count = 0;
     int temp_local_count = 0;
     size_t *fview_count = NULL;
-    ptrdiff_t *disp_index=NULL, *temp_disp_index=NULL;
-    size_t current_index=0, temp_index=0;
-    int **blocklen_per_process=NULL;
-    MPI_Aint **displs_per_process=NULL;
-    char *global_buf = NULL;
-    mca_io_ompio_local_io_array *file_offsets_for_agg=NULL;
+    size_t current_index=0;
+    /* the data of the cycle being scattered, and of the one being read */
+    read_all_cycle_t cycles_data[READ_ALL_NUM_CYCLE_BUFS];
 
     /* array that contains the sorted indices of the global_iov */
     int *sorted = NULL;
@@ -120,6 +141,11 @@ mca_common_ompio_base_file_read_all (struct ompio_file_t *fh,
     mca_common_ompio_print_entry nentry;
 #endif
 
+    memset (cycles_data, 0, sizeof(cycles_data));
+    for (k = 0; k < READ_ALL_NUM_CYCLE_BUFS; k++) {
+        cycles_data[k].read_req = MPI_REQUEST_NULL;
+    }
+
     /**************************************************************************
      ** 1. In case the data is not contiguous in memory, decode it into an iovec
      **************************************************************************/
@@ -344,32 +370,6 @@ mca_common_ompio_base_file_read_all (struct ompio_file_t *fh,
     cycles = ceil((double)total_bytes/bytes_per_cycle);
 
     if ( my_aggregator == fh->f_rank) {
-      disp_index = (ptrdiff_t *)malloc (fh->f_procs_per_group * sizeof (ptrdiff_t));
-      if (NULL == disp_index) {
-            opal_output (1, "OUT OF MEMORY\n");
-            ret = OMPI_ERR_OUT_OF_RESOURCE;
-            goto exit;
-        }
-
-        blocklen_per_process = (int **)malloc (fh->f_procs_per_group * sizeof (int*));
-        if (NULL == blocklen_per_process) {
-            opal_output (1, "OUT OF MEMORY\n");
-            ret = OMPI_ERR_OUT_OF_RESOURCE;
-            goto exit;
-        }
-
-        displs_per_process = (MPI_Aint **)malloc (fh->f_procs_per_group * sizeof (MPI_Aint*));
-        if (NULL == displs_per_process){
-            opal_output (1, "OUT OF MEMORY\n");
-            ret = OMPI_ERR_OUT_OF_RESOURCE;
-            goto exit;
-        }
-
-        for (i=0;i<fh->f_procs_per_group;i++){
-            blocklen_per_process[i] = NULL;
-            displs_per_process[i] = NULL;
-        }
-
 	send_req = (MPI_Request *) malloc (fh->f_procs_per_group * sizeof(MPI_Request));
 	if (NULL == send_req){
 	    opal_output ( 1, "OUT OF MEMORY\n");
@@ -377,24 +377,6 @@ mca_common_ompio_base_file_read_all (struct ompio_file_t *fh,
 	    goto exit;
 	}
 
-        if (use_accelerator_buffer) {
-            opal_output_verbose(10, ompi_fcoll_base_framework.framework_output,
-                                "Allocating GPU device buffer for aggregation\n");
-            ret = opal_accelerator.mem_alloc(MCA_ACCELERATOR_NO_DEVICE_ID, (void**)&global_buf,
-                                             bytes_per_cycle);
-            if (OPAL_SUCCESS != ret) {
-                opal_output(1, "Could not allocate accelerator memory");
-                ret = OMPI_ERR_OUT_OF_RESOURCE;
-                goto exit;
-            }
-        } else {global_buf = (char *) malloc (bytes_per_cycle);
-            if (NULL == global_buf){
-                opal_output(1, "OUT OF MEMORY\n");
-                ret = OMPI_ERR_OUT_OF_RESOURCE;
-                goto exit;
-            }
-	}
-
 	sendtype = (ompi_datatype_t **) malloc (fh->f_procs_per_group * sizeof(ompi_datatype_t *));
 	if (NULL == sendtype) {
             opal_output (1, "OUT OF MEMORY\n");
@@ -405,408 +387,85 @@ mca_common_ompio_base_file_read_all (struct ompio_file_t *fh,
 	for(l=0;l<fh->f_procs_per_group;l++){
             sendtype[l] = MPI_DATATYPE_NULL;
 	}
-    }
-
-
 
+        for (k = 0; k < READ_ALL_NUM_CYCLE_BUFS; k++) {
+            read_all_cycle_t *cycle = &cycles_data[k];
 
-#if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
-    start_rexch = MPI_Wtime();
-#endif
-    n = 0;
-    bytes_remaining = 0;
-    current_index = 0;
-
-    for (index = 0; index < cycles; index++) {
-        /**********************************************************************
-         ***  7a. Getting ready for next cycle: initializing and freeing buffers
-	 **********************************************************************/
-        if (my_aggregator == fh->f_rank) {
-             if (NULL != fh->f_io_array) {
-                free (fh->f_io_array);
-                fh->f_io_array = NULL;
+            cycle->disp_index = (ptrdiff_t *)malloc (fh->f_procs_per_group * sizeof (ptrdiff_t));
+            cycle->blocklen_per_process = (int **)calloc (fh->f_procs_per_group, sizeof (int*));
+            cycle->displs_per_process = (MPI_Aint **)calloc (fh->f_procs_per_group, sizeof (MPI_Aint*));
+            if (NULL == cycle->disp_index || NULL == cycle->blocklen_per_process ||
+                NULL == cycle->displs_per_process) {
+                opal_output (1, "OUT OF MEMORY\n");
+                ret = OMPI_ERR_OUT_OF_RESOURCE;
+                goto exit;
             }
-            fh->f_num_of_io_entries = 0;
 
-            if (NULL != sendtype){
-                for (i =0; i< fh->f_procs_per_group; i++) {
-		    if ( MPI_DATATYPE_NULL != sendtype[i] ) {
-                        ompi_datatype_destroy(&sendtype[i]);
-                        sendtype[i] = MPI_DATATYPE_NULL;
-                    }
-		}
+            /* A single cycle needs a single buffer */
+            if (1 == k && 2 > cycles) {
+                continue;
             }
 
-            for(l=0;l<fh->f_procs_per_group;l++){
-                disp_index[l] =  1;
-
-                if (NULL != blocklen_per_process[l]){
-                    free(blocklen_per_process[l]);
-                    blocklen_per_process[l] = NULL;
-                }
-                if (NULL != displs_per_process[l]){
-                    free(displs_per_process[l]);
-                    displs_per_process[l] = NULL;
-                }
-                blocklen_per_process[l] = (int *) calloc (1, sizeof(int));
-                if (NULL == blocklen_per_process[l]) {
-                    opal_output (1, "OUT OF MEMORY for blocklen\n");
+            if (use_accelerator_buffer) {
+                opal_output_verbose(10, ompi_fcoll_base_framework.framework_output,
+                                    "Allocating GPU device buffer for aggregation\n");
+                ret = opal_accelerator.mem_alloc(MCA_ACCELERATOR_NO_DEVICE_ID, (void**)&cycle->global_buf,
+                                                 bytes_per_cycle);
+                if (OPAL_SUCCESS != ret) {
+                    opal_output(1, "Could not allocate accelerator memory");
                     ret = OMPI_ERR_OUT_OF_RESOURCE;
                     goto exit;
                 }
-                displs_per_process[l] = (MPI_Aint *) calloc (1, sizeof(MPI_Aint));
-                if (NULL == displs_per_process[l]){
-                    opal_output (1, "OUT OF MEMORY for displs\n");
+            } else {
+                cycle->global_buf = (char *) malloc (bytes_per_cycle);
+                if (NULL == cycle->global_buf){
+                    opal_output(1, "OUT OF MEMORY\n");
                     ret = OMPI_ERR_OUT_OF_RESOURCE;
                     goto exit;
                 }
-            }
-
-            if (NULL != sorted_file_offsets){
-                free(sorted_file_offsets);
-                sorted_file_offsets = NULL;
-            }
-
-            if(NULL != file_offsets_for_agg){
-                free(file_offsets_for_agg);
-                file_offsets_for_agg = NULL;
-            }
-            if (NULL != memory_displacements){
-                free(memory_displacements);
-                memory_displacements = NULL;
-            }
-        }  /* (my_aggregator == fh->f_rank */
-
-        /**************************************************************************
-         ***  7b. Determine the number of bytes to be actually read in this cycle
-	 **************************************************************************/
-        if (cycles-1 == index) {
-            bytes_to_read_in_cycle = total_bytes - bytes_per_cycle*index;
-        }
-        else {
-            bytes_to_read_in_cycle = bytes_per_cycle;
-        }
-
-#if DEBUG_ON
-        if (my_aggregator == fh->f_rank) {
-            printf ("****%d: CYCLE %d   Bytes %d**********\n",
-                    fh->f_rank,
-                    index,
-                    bytes_to_write_in_cycle);
-        }
-#endif
-
-        /*****************************************************************
-         *** 7c. Calculate how much data will be contributed in this cycle
-	 ***     by each process
-         *****************************************************************/
-        bytes_received = 0;
-
-        while (bytes_to_read_in_cycle) {
-            /* This next block identifies which process is the holder
-            ** of the sorted[current_index] element;
-            */
-            blocks = fview_count[0];
-            for (j=0 ; j<fh->f_procs_per_group ; j++) {
-                if (sorted[current_index] < blocks) {
-                    n = j;
-                    break;
-                }
-                else {
-                    blocks += fview_count[j+1];
-                }
-            }
-
-            if (bytes_remaining) {
-                /* Finish up a partially used buffer from the previous  cycle */
-                if (bytes_remaining <= bytes_to_read_in_cycle) {
-                    /* Data fits completely into the block */
-                    if (my_aggregator == fh->f_rank) {
-                        blocklen_per_process[n][disp_index[n] - 1] = bytes_remaining;
-                        displs_per_process[n][disp_index[n] - 1] =
-                            (ptrdiff_t)global_iov_array[sorted[current_index]].iov_base +
-                            (global_iov_array[sorted[current_index]].iov_len - bytes_remaining);
-
-                        blocklen_per_process[n] = (int *) realloc
-                            ((void *)blocklen_per_process[n], (disp_index[n]+1)*sizeof(int));
-                        displs_per_process[n] = (MPI_Aint *) realloc
-                            ((void *)displs_per_process[n], (disp_index[n]+1)*sizeof(MPI_Aint));
-                        blocklen_per_process[n][disp_index[n]] = 0;
-                        displs_per_process[n][disp_index[n]] = 0;
-                        disp_index[n] += 1;
-                    }
-                    if (fh->f_procs_in_group[n] == fh->f_rank) {
-                        bytes_received += bytes_remaining;
-                    }
-                    current_index ++;
-                    bytes_to_read_in_cycle -= bytes_remaining;
-                    bytes_remaining = 0;
-                    continue;
-                }
-                else {
-                     /* the remaining data from the previous cycle is larger than the
-                        bytes_to_write_in_cycle, so we have to segment again */
-                    if (my_aggregator == fh->f_rank) {
-                        blocklen_per_process[n][disp_index[n] - 1] = bytes_to_read_in_cycle;
-                        displs_per_process[n][disp_index[n] - 1] =
-                            (ptrdiff_t)global_iov_array[sorted[current_index]].iov_base +
-                            (global_iov_array[sorted[current_index]].iov_len
-                             - bytes_remaining);
-                    }
-                    if (fh->f_procs_in_group[n] == fh->f_rank) {
-                        bytes_received += bytes_to_read_in_cycle;
-                    }
-                    bytes_remaining -= bytes_to_read_in_cycle;
-                    bytes_to_read_in_cycle = 0;
-                    break;
-                }
-            }
-            else {
-                /* No partially used entry available, have to start a new one */
-                if (bytes_to_read_in_cycle <
-                    (MPI_Aint) global_iov_array[sorted[current_index]].iov_len) {
-                    /* This entry has more data than we can sendin one cycle */
-                    if (my_aggregator == fh->f_rank) {
-                        blocklen_per_process[n][disp_index[n] - 1] = bytes_to_read_in_cycle;
-                        displs_per_process[n][disp_index[n] - 1] =
-                            (ptrdiff_t)global_iov_array[sorted[current_index]].iov_base ;
-                    }
-
-                    if (fh->f_procs_in_group[n] == fh->f_rank) {
-                        bytes_received += bytes_to_read_in_cycle;
-                    }
-                    bytes_remaining = global_iov_array[sorted[current_index]].iov_len -
-                        bytes_to_read_in_cycle;
-                    bytes_to_read_in_cycle = 0;
-                    break;
-                }
-                else {
-                    /* Next data entry is less than bytes_to_write_in_cycle */
-                    if (my_aggregator ==  fh->f_rank) {
-                        blocklen_per_process[n][disp_index[n] - 1] =
-                            global_iov_array[sorted[current_index]].iov_len;
-                        displs_per_process[n][disp_index[n] - 1] = (ptrdiff_t)
-                            global_iov_array[sorted[current_index]].iov_base;
-                        blocklen_per_process[n] =
-                            (int *) realloc ((void *)blocklen_per_process[n], (disp_index[n]+1)*sizeof(int));
-                        displs_per_process[n] = (MPI_Aint *)realloc
-                            ((void *)displs_per_process[n], (disp_index[n]+1)*sizeof(MPI_Aint));
-                        blocklen_per_process[n][disp_index[n]] = 0;
-                        displs_per_process[n][disp_index[n]] = 0;
-                        disp_index[n] += 1;
-                    }
-                    if (fh->f_procs_in_group[n] == fh->f_rank) {
-                        bytes_received +=
-                            global_iov_array[sorted[current_index]].iov_len;
-                    }
-                    bytes_to_read_in_cycle -=
-                        global_iov_array[sorted[current_index]].iov_len;
-                    current_index ++;
-                    continue;
-                }
-            }
-        } /* end while (bytes_to_read_in_cycle) */
-
-        /*************************************************************************
-	 *** 7d. Calculate the displacement on where to put the data and allocate
-         ***     the receive buffer (global_buf)
-	 *************************************************************************/
-        if (my_aggregator == fh->f_rank) {
-            entries_per_aggregator=0;
-            for (i=0;i<fh->f_procs_per_group; i++){
-                for (j=0;j<disp_index[i];j++){
-                    if (blocklen_per_process[i][j] > 0)
-                        entries_per_aggregator++ ;
-                }
-            }
-            if (entries_per_aggregator > 0){
-                file_offsets_for_agg = (mca_io_ompio_local_io_array *)
-                    malloc(entries_per_aggregator*sizeof(mca_io_ompio_local_io_array));
-                if (NULL == file_offsets_for_agg) {
-                    opal_output (1, "OUT OF MEMORY\n");
-                    ret = OMPI_ERR_OUT_OF_RESOURCE;
-                    goto exit;
-                }
-                sorted_file_offsets = (int *)
-                    malloc (entries_per_aggregator*sizeof(int));
-                if (NULL == sorted_file_offsets){
-                    opal_output (1, "OUT OF MEMORY\n");
-                    ret =  OMPI_ERR_OUT_OF_RESOURCE;
-                    goto exit;
-                }
-                /*Moving file offsets to an IO array!*/
-                temp_index = 0;
-                for (i=0;i<fh->f_procs_per_group; i++){
-                    for(j=0;j<disp_index[i];j++){
-                        if (blocklen_per_process[i][j] > 0){
-                            file_offsets_for_agg[temp_index].length =
-                                blocklen_per_process[i][j];
-                            file_offsets_for_agg[temp_index].process_id = i;
-                            file_offsets_for_agg[temp_index].offset =
-                                displs_per_process[i][j];
-                            temp_index++;
-                        }
-                    }
-                }
-            }
-            else{
-                continue;
-            }
-
-             /* Sort the displacements for each aggregator */
-            read_heap_sort (file_offsets_for_agg,
-                            entries_per_aggregator,
-                            sorted_file_offsets);
-
-            memory_displacements = (MPI_Aint *) malloc
-                (entries_per_aggregator * sizeof(MPI_Aint));
-            memory_displacements[sorted_file_offsets[0]] = 0;
-            for (i=1; i<entries_per_aggregator; i++){
-                memory_displacements[sorted_file_offsets[i]] =
-                    memory_displacements[sorted_file_offsets[i-1]] +
-                    file_offsets_for_agg[sorted_file_offsets[i-1]].length;
-            }
-
-             /**********************************************************
-	     *** 7e. Create the io array, and pass it to fbtl
-	     *********************************************************/
-            fh->f_io_array = (mca_common_ompio_io_array_t *) malloc
-                (entries_per_aggregator * sizeof (mca_common_ompio_io_array_t));
-            if (NULL == fh->f_io_array) {
-                opal_output(1, "OUT OF MEMORY\n");
-                ret = OMPI_ERR_OUT_OF_RESOURCE;
-                goto exit;
-            }
-
-            fh->f_num_of_io_entries = 0;
-            fh->f_io_array[0].offset =
-                (IOVBASE_TYPE *)(intptr_t)file_offsets_for_agg[sorted_file_offsets[0]].offset;
-            fh->f_io_array[0].length =
-                file_offsets_for_agg[sorted_file_offsets[0]].length;
-            fh->f_io_array[0].memory_address =
-                global_buf+memory_displacements[sorted_file_offsets[0]];
-            fh->f_num_of_io_entries++;
-            for (i=1;i<entries_per_aggregator;i++){
-                if (file_offsets_for_agg[sorted_file_offsets[i-1]].offset +
-                    file_offsets_for_agg[sorted_file_offsets[i-1]].length ==
-                    file_offsets_for_agg[sorted_file_offsets[i]].offset){
-                    fh->f_io_array[fh->f_num_of_io_entries - 1].length +=
-                        file_offsets_for_agg[sorted_file_offsets[i]].length;
-                }
-                else{
-                    fh->f_io_array[fh->f_num_of_io_entries].offset =
-                        (IOVBASE_TYPE *)(intptr_t)file_offsets_for_agg[sorted_file_offsets[i]].offset;
-                    fh->f_io_array[fh->f_num_of_io_entries].length =
-                        file_offsets_for_agg[sorted_file_offsets[i]].length;
-                    fh->f_io_array[fh->f_num_of_io_entries].memory_address =
-                        global_buf+memory_displacements[sorted_file_offsets[i]];
-                    fh->f_num_of_io_entries++;
+                if (NULL != fh->f_fbtl->fbtl_register_buf) {
+                    fh->f_fbtl->fbtl_register_buf (fh, cycle->global_buf, bytes_per_cycle);
                 }
             }
+        }
 
+        /* The reads are completed through ompi_request_wait */
+        mca_common_ompio_register_progress ();
+    }
 
 #if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
-            start_read_time = MPI_Wtime();
+    start_rexch = MPI_Wtime();
 #endif
+    bytes_remaining = 0;
+    current_index = 0;
 
-            if (fh->f_num_of_io_entries) {
-                if (use_accelerator_buffer) {
-		    mca_ompio_request_t *ompio_req = NULL;
-		    mca_common_ompio_request_alloc (&ompio_req, MCA_OMPIO_REQUEST_READ);
-
-                    ret = mca_common_ompio_file_iread_pregen(fh, (ompi_request_t *) ompio_req);
-                    if(0 > ret) {
-                        opal_output (1, "common_ompio_file_read_all: mca_common_ompio_iread_pregen failed\n");
-                        ompio_req->req_ompi.req_status.MPI_ERROR = ret;
-                        ompio_req->req_ompi.req_status._ucount = 0;
-                    }
-		    ret = ompi_request_wait ((ompi_request_t**)&ompio_req, MPI_STATUS_IGNORE);
-		    if (OMPI_SUCCESS != ret){
-			goto exit;
-		    }
-                } else {
-                    if ( 0 >  fh->f_fbtl->fbtl_preadv (fh)) {
-                        opal_output (1, "READ FAILED\n");
-                        ret = OMPI_ERROR;
-                        goto exit;
-                    }
-                }
-            }
-
+    /* Start reading the first cycle */
+    if (0 < cycles) {
 #if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
-            end_read_time = MPI_Wtime();
-            read_time += end_read_time - start_read_time;
+        start_read_time = MPI_Wtime();
 #endif
-            /**********************************************************
-             ******************** DONE READING ************************
-             *********************************************************/
-
-            temp_disp_index = (ptrdiff_t *)calloc (1, fh->f_procs_per_group * sizeof (ptrdiff_t));
-            if (NULL == temp_disp_index) {
-                opal_output (1, "OUT OF MEMORY\n");
-                ret = OMPI_ERR_OUT_OF_RESOURCE;
-                goto exit;
-            }
-            for (i=0; i<entries_per_aggregator; i++){
-                temp_index =
-                    file_offsets_for_agg[sorted_file_offsets[i]].process_id;
-                displs_per_process[temp_index][temp_disp_index[temp_index]] =
-                    memory_displacements[sorted_file_offsets[i]];
-                if (temp_disp_index[temp_index] < disp_index[temp_index]){
-                    temp_disp_index[temp_index] += 1;
-                }
-                else{
-                    printf("temp_disp_index[%zu]: %ld is greater than disp_index[%zu]: %ld\n",
-                           temp_index, (long) temp_disp_index[temp_index],
-                           temp_index, (long) disp_index[temp_index]);
-                }
-            }
-            if (NULL != temp_disp_index){
-                free(temp_disp_index);
-                temp_disp_index = NULL;
-            }
-
+        ret = read_all_prepare_cycle (fh, &cycles_data[0],
+                                      (1 == cycles) ? total_bytes : bytes_per_cycle,
+                                      my_aggregator == fh->f_rank, use_accelerator_buffer,
+                                      global_iov_array, sorted, fview_count,
+                                      &current_index, &bytes_remaining);
+        if (OMPI_SUCCESS != ret){
+            goto exit;
+        }
 #if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
-            start_rcomm_time = MPI_Wtime();
+        end_read_time = MPI_Wtime();
+        read_time += end_read_time - start_read_time;
 #endif
-            for (i=0;i<fh->f_procs_per_group;i++){
-                size_t datatype_size;
-                send_req[i] = MPI_REQUEST_NULL;
-                if ( 0 < disp_index[i] ) {
-                    ompi_datatype_create_hindexed(disp_index[i],
-                                                  blocklen_per_process[i],
-                                                  displs_per_process[i],
-                                                  MPI_BYTE,
-                                                  &sendtype[i]);
-                    ompi_datatype_commit(&sendtype[i]);
-                    opal_datatype_type_size(&sendtype[i]->super, &datatype_size);
+    }
 
-                    if(datatype_size) {
-                        ret = MCA_PML_CALL (isend(global_buf,
-                                                  1,
-                                                  sendtype[i],
-                                                  fh->f_procs_in_group[i],
-                                                  COMMON_OMPIO_SHUFFLE_TAG,
-                                                  MCA_PML_BASE_SEND_STANDARD,
-                                                  fh->f_comm,
-                                                  &send_req[i]));
-                        if(OMPI_SUCCESS != ret){
-                            goto exit;
-                        }
-                    }
-                }
-            }
-#if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
-            end_rcomm_time = MPI_Wtime();
-            rcomm_time += end_rcomm_time - start_rcomm_time;
-#endif
-        }
+    for (index = 0; index < cycles; index++) {
+        read_all_cycle_t *cycle = &cycles_data[index % READ_ALL_NUM_CYCLE_BUFS];
 
         /**********************************************************
          *** 7f.  Scatter the Data from the readers
          *********************************************************/
-        if(bytes_received) {
-            size_t remaining            = bytes_received;
+        if(cycle->bytes_received) {
+            size_t remaining            = cycle->bytes_received;
             int block_index             = -1;
             int blocklength_size        = INIT_LEN;
 
@@ -859,6 +518,10 @@ mca_common_ompio_base_file_read_all (struct ompio_file_t *fh,
                                           MPI_BYTE,
                                           &newType);
             ompi_datatype_commit(&newType);
+            free (blocklength_proc);
+            free (displs_proc);
+            blocklength_proc = NULL;
+            displs_proc = NULL;
 
 #if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
             start_rcomm_time = MPI_Wtime();
@@ -880,13 +543,89 @@ mca_common_ompio_base_file_read_all (struct ompio_file_t *fh,
             }
         }
 
-        if (my_aggregator == fh->f_rank){
+        if (my_aggregator == fh->f_rank && 0 < cycle->entries_per_aggregator) {
+#if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
+            start_read_time = MPI_Wtime();
+#endif
+            ret = ompi_request_wait (&cycle->read_req, MPI_STATUS_IGNORE);
+            if (OMPI_SUCCESS != ret){
+                opal_output (1, "READ FAILED\n");
+                goto exit;
+            }
+#if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
+            end_read_time = MPI_Wtime();
+            read_time += end_read_time - start_read_time;
+            start_rcomm_time = MPI_Wtime();
+#endif
+            for (i=0;i<fh->f_procs_per_group;i++){
+                size_t datatype_size;
+                send_req[i] = MPI_REQUEST_NULL;
+                if ( 0 < cycle->disp_index[i] ) {
+                    ompi_datatype_create_hindexed(cycle->disp_index[i],
+                                                  cycle->blocklen_per_process[i],
+                                                  cycle->displs_per_process[i],
+                                                  MPI_BYTE,
+                                                  &sendtype[i]);
+                    ompi_datatype_commit(&sendtype[i]);
+                    opal_datatype_type_size(&sendtype[i]->super, &datatype_size);
+
+                    if(datatype_size) {
+                        ret = MCA_PML_CALL (isend(cycle->global_buf,
+                                                  1,
+                                                  sendtype[i],
+                                                  fh->f_procs_in_group[i],
+                                                  COMMON_OMPIO_SHUFFLE_TAG,
+                                                  MCA_PML_BASE_SEND_STANDARD,
+                                                  fh->f_comm,
+                                                  &send_req[i]));
+                        if(OMPI_SUCCESS != ret){
+                            goto exit;
+                        }
+                    }
+                }
+            }
+#if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
+            end_rcomm_time = MPI_Wtime();
+            rcomm_time += end_rcomm_time - start_rcomm_time;
+#endif
+        }
+
+        /**********************************************************
+         *** 7g. Start reading the next cycle into the other buffer,
+         ***     while this one is being scattered
+         *********************************************************/
+        if (index + 1 < cycles) {
+#if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
+            start_read_time = MPI_Wtime();
+#endif
+            ret = read_all_prepare_cycle (fh, &cycles_data[(index + 1) % READ_ALL_NUM_CYCLE_BUFS],
+                                          (cycles - 2 == index) ?
+                                          total_bytes - bytes_per_cycle * (index + 1) : bytes_per_cycle,
+                                          my_aggregator == fh->f_rank, use_accelerator_buffer,
+                                          global_iov_array, sorted, fview_count,
+                                          &current_index, &bytes_remaining);
+            if (OMPI_SUCCESS != ret){
+                goto exit;
+            }
+#if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
+            end_read_time = MPI_Wtime();
+            read_time += end_read_time - start_read_time;
+#endif
+        }
+
+        if (my_aggregator == fh->f_rank && 0 < cycle->entries_per_aggregator) {
             ret = ompi_request_wait_all (fh->f_procs_per_group,
                                          send_req,
                                          MPI_STATUS_IGNORE);
             if (OMPI_SUCCESS != ret){
                 goto exit;
             }
+            for (i =0; i< fh->f_procs_per_group; i++) {
+                if ( MPI_DATATYPE_NULL != sendtype[i] ) {
+                    ompi_datatype_destroy(&sendtype[i]);
+                    sendtype[i] = MPI_DATATYPE_NULL;
+                }
+            }
         }
 
         ret = ompi_request_wait (&recv_req, MPI_STATUS_IGNORE);
@@ -895,7 +634,7 @@ mca_common_ompio_base_file_read_all (struct ompio_file_t *fh,
         }
 
 #if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
-        if(bytes_received) {
+        if(cycle->bytes_received) {
             end_rcomm_time = MPI_Wtime();
             rcomm_time += end_rcomm_time - start_rcomm_time;
         }
@@ -920,14 +659,6 @@ mca_common_ompio_base_file_read_all (struct ompio_file_t *fh,
 #endif
 
 exit:
-    if (NULL != global_buf) {
-	if (use_accelerator_buffer) {
-	    opal_accelerator.mem_release(MCA_ACCELERATOR_NO_DEVICE_ID, global_buf);
-	} else {
-	    free (global_buf);
-	}
-        global_buf = NULL;
-    }
     if (NULL != sorted) {
         free (sorted);
         sorted = NULL;
@@ -965,19 +696,41 @@ exit:
     }
 
     if (my_aggregator == fh->f_rank) {
+        for (k = 0; k < READ_ALL_NUM_CYCLE_BUFS; k++) {
+            read_all_cycle_t *cycle = &cycles_data[k];
 
-        if (NULL != sorted_file_offsets){
-            free(sorted_file_offsets);
-            sorted_file_offsets = NULL;
-        }
-        if (NULL != file_offsets_for_agg){
-            free(file_offsets_for_agg);
-            file_offsets_for_agg = NULL;
-        }
-        if (NULL != memory_displacements){
-            free(memory_displacements);
-            memory_displacements= NULL;
+            /* Don't pull the buffer from under a read still in flight */
+            if (MPI_REQUEST_NULL != cycle->read_req) {
+                ompi_request_wait (&cycle->read_req, MPI_STATUS_IGNORE);
+            }
+            if (NULL != cycle->global_buf) {
+                if (use_accelerator_buffer) {
+                    opal_accelerator.mem_release(MCA_ACCELERATOR_NO_DEVICE_ID, cycle->global_buf);
+                } else {
+                    if (NULL != fh->f_fbtl->fbtl_deregister_buf) {
+                        fh->f_fbtl->fbtl_deregister_buf (fh, cycle->global_buf);
+                    }
+                    free (cycle->global_buf);
+                }
+            }
+            free (cycle->sorted_file_offsets);
+            free (cycle->file_offsets_for_agg);
+            free (cycle->memory_displacements);
+            free (cycle->disp_index);
+            if (NULL != cycle->blocklen_per_process) {
+                for (l = 0; l < fh->f_procs_per_group; l++) {
+                    free (cycle->blocklen_per_process[l]);
+                }
+                free (cycle->blocklen_per_process);
+            }
+            if (NULL != cycle->displs_per_process) {
+                for (l = 0; l < fh->f_procs_per_group; l++) {
+                    free (cycle->displs_per_process[l]);
+                }
+                free (cycle->displs_per_process);
+            }
         }
+
         if (NULL != sendtype){
             for (i = 0; i < fh->f_procs_per_group; i++) {
                 if ( MPI_DATATYPE_NULL != sendtype[i] ) {
@@ -988,41 +741,362 @@ exit:
             sendtype=NULL;
         }
 
-        if (NULL != disp_index){
-            free(disp_index);
-            disp_index = NULL;
+        if ( NULL != send_req ) {
+            free ( send_req );
+            send_req = NULL;
         }
+    }
+    return ret;
+}
 
-        if ( NULL != blocklen_per_process){
-            for(l=0;l<fh->f_procs_per_group;l++){
-                if (NULL != blocklen_per_process[l]){
-                    free(blocklen_per_process[l]);
-                    blocklen_per_process[l] = NULL;
-                }
+
+/*
+ * Work out the data of the next cycle from the sorted global iovec, and
+ * have the aggregator start reading it into the cycle's buffer. The
+ * read completes through cycle->read_req.
+ */
+static int read_all_prepare_cycle (ompio_file_t *fh,
+                                   read_all_cycle_t *cycle,
+                                   MPI_Aint bytes_to_read_in_cycle,
+                                   bool is_aggregator,
+                                   bool use_accelerator_buffer,
+                                   struct iovec *global_iov_array,
+                                   int *sorted,
+                                   size_t *fview_count,
+                                   size_t *current_index_ptr,
+                                   MPI_Aint *bytes_remaining_ptr)
+{
+    int **blocklen_per_process = cycle->blocklen_per_process;
+    MPI_Aint **displs_per_process = cycle->displs_per_process;
+    ptrdiff_t *disp_index = cycle->disp_index, *temp_disp_index = NULL;
+    size_t current_index = *current_index_ptr, temp_index = 0;
+    MPI_Aint bytes_remaining = *bytes_remaining_ptr;
+    mca_io_ompio_local_io_array *file_offsets_for_agg = NULL;
+    int *sorted_file_offsets = NULL, entries_per_aggregator = 0;
+    MPI_Aint *memory_displacements = NULL;
+    int bytes_received = 0;
+    int blocks = 0, n = 0;
+    int i, j, l, ret = OMPI_SUCCESS;
+
+    cycle->bytes_received = 0;
+    cycle->entries_per_aggregator = 0;
+
+    /**********************************************************************
+     ***  7a. Getting ready for the cycle: initializing and freeing buffers
+     **********************************************************************/
+    if (is_aggregator) {
+        for(l=0;l<fh->f_procs_per_group;l++){
+            disp_index[l] =  1;
+
+            free(blocklen_per_process[l]);
+            free(displs_per_process[l]);
+            blocklen_per_process[l] = (int *) calloc (1, sizeof(int));
+            displs_per_process[l] = (MPI_Aint *) calloc (1, sizeof(MPI_Aint));
+            if (NULL == blocklen_per_process[l] || NULL == displs_per_process[l]) {
+                opal_output (1, "OUT OF MEMORY for blocklen\n");
+                return OMPI_ERR_OUT_OF_RESOURCE;
             }
+        }
+
+        free(cycle->sorted_file_offsets);
+        free(cycle->file_offsets_for_agg);
+        free(cycle->memory_displacements);
+        cycle->sorted_file_offsets = NULL;
+        cycle->file_offsets_for_agg = NULL;
+        cycle->memory_displacements = NULL;
+    }
 
-            free(blocklen_per_process);
-            blocklen_per_process = NULL;
+#if DEBUG_ON
+    if (is_aggregator) {
+        printf ("****%d: CYCLE Bytes %ld**********\n",
+                fh->f_rank,
+                (long) bytes_to_read_in_cycle);
+    }
+#endif
+
+    /*****************************************************************
+     *** 7c. Calculate how much data will be contributed in this cycle
+     ***     by each process
+     *****************************************************************/
+    while (bytes_to_read_in_cycle) {
+        /* This next block identifies which process is the holder
+        ** of the sorted[current_index] element;
+        */
+        blocks = fview_count[0];
+        for (j=0 ; j<fh->f_procs_per_group ; j++) {
+            if (sorted[current_index] < blocks) {
+                n = j;
+                break;
+            }
+            else {
+                blocks += fview_count[j+1];
+            }
         }
 
-        if (NULL != displs_per_process){
-            for (l=0; i<fh->f_procs_per_group; l++){
-                if (NULL != displs_per_process[l]){
-                    free(displs_per_process[l]);
-                    displs_per_process[l] = NULL;
+        if (bytes_remaining) {
+            /* Finish up a partially used buffer from the previous  cycle */
+            if (bytes_remaining <= bytes_to_read_in_cycle) {
+                /* Data fits completely into the block */
+                if (is_aggregator) {
+                    blocklen_per_process[n][disp_index[n] - 1] = bytes_remaining;
+                    displs_per_process[n][disp_index[n] - 1] =
+                        (ptrdiff_t)global_iov_array[sorted[current_index]].iov_base +
+                        (global_iov_array[sorted[current_index]].iov_len - bytes_remaining);
+
+                    blocklen_per_process[n] = (int *) realloc
+                        ((void *)blocklen_per_process[n], (disp_index[n]+1)*sizeof(int));
+                    displs_per_process[n] = (MPI_Aint *) realloc
+                        ((void *)displs_per_process[n], (disp_index[n]+1)*sizeof(MPI_Aint));
+                    blocklen_per_process[n][disp_index[n]] = 0;
+                    displs_per_process[n][disp_index[n]] = 0;
+                    disp_index[n] += 1;
                 }
+                if (fh->f_procs_in_group[n] == fh->f_rank) {
+                    bytes_received += bytes_remaining;
+                }
+                current_index ++;
+                bytes_to_read_in_cycle -= bytes_remaining;
+                bytes_remaining = 0;
+                continue;
+            }
+            else {
+                /* the remaining data from the previous cycle is larger than the
+                   bytes_to_write_in_cycle, so we have to segment again */
+                if (is_aggregator) {
+                    blocklen_per_process[n][disp_index[n] - 1] = bytes_to_read_in_cycle;
+                    displs_per_process[n][disp_index[n] - 1] =
+                        (ptrdiff_t)global_iov_array[sorted[current_index]].iov_base +
+                        (global_iov_array[sorted[current_index]].iov_len
+                         - bytes_remaining);
+                }
+                if (fh->f_procs_in_group[n] == fh->f_rank) {
+                    bytes_received += bytes_to_read_in_cycle;
+                }
+                bytes_remaining -= bytes_to_read_in_cycle;
+                bytes_to_read_in_cycle = 0;
+                break;
             }
-            free(displs_per_process);
-            displs_per_process = NULL;
         }
-        if ( NULL != send_req ) {
-            free ( send_req );
-            send_req = NULL;
+        else {
+            /* No partially used entry available, have to start a new one */
+            if (bytes_to_read_in_cycle <
+                (MPI_Aint) global_iov_array[sorted[current_index]].iov_len) {
+                /* This entry has more data than we can sendin one cycle */
+                if (is_aggregator) {
+                    blocklen_per_process[n][disp_index[n] - 1] = bytes_to_read_in_cycle;
+                    displs_per_process[n][disp_index[n] - 1] =
+                        (ptrdiff_t)global_iov_array[sorted[current_index]].iov_base ;
+                }
+
+                if (fh->f_procs_in_group[n] == fh->f_rank) {
+                    bytes_received += bytes_to_read_in_cycle;
+                }
+                bytes_remaining = global_iov_array[sorted[current_index]].iov_len -
+                    bytes_to_read_in_cycle;
+                bytes_to_read_in_cycle = 0;
+                break;
+            }
+            else {
+                /* Next data entry is less than bytes_to_write_in_cycle */
+                if (is_aggregator) {
+                    blocklen_per_process[n][disp_index[n] - 1] =
+                        global_iov_array[sorted[current_index]].iov_len;
+                    displs_per_process[n][disp_index[n] - 1] = (ptrdiff_t)
+                        global_iov_array[sorted[current_index]].iov_base;
+                    blocklen_per_process[n] =
+                        (int *) realloc ((void *)blocklen_per_process[n], (disp_index[n]+1)*sizeof(int));
+                    displs_per_process[n] = (MPI_Aint *)realloc
+                        ((void *)displs_per_process[n], (disp_index[n]+1)*sizeof(MPI_Aint));
+                    blocklen_per_process[n][disp_index[n]] = 0;
+                    displs_per_process[n][disp_index[n]] = 0;
+                    disp_index[n] += 1;
+                }
+                if (fh->f_procs_in_group[n] == fh->f_rank) {
+                    bytes_received +=
+                        global_iov_array[sorted[current_index]].iov_len;
+                }
+                bytes_to_read_in_cycle -=
+                    global_iov_array[sorted[current_index]].iov_len;
+                current_index ++;
+                continue;
+            }
         }
+    } /* end while (bytes_to_read_in_cycle) */
+
+    *current_index_ptr = current_index;
+    *bytes_remaining_ptr = bytes_remaining;
+    cycle->bytes_received = bytes_received;
+
+    if (!is_aggregator) {
+        return OMPI_SUCCESS;
     }
-    return ret;
+
+    /*************************************************************************
+     *** 7d. Calculate the displacement on where to put the data
+     *************************************************************************/
+    for (i=0;i<fh->f_procs_per_group; i++){
+        for (j=0;j<disp_index[i];j++){
+            if (blocklen_per_process[i][j] > 0)
+                entries_per_aggregator++ ;
+        }
+    }
+    if (0 == entries_per_aggregator) {
+        return OMPI_SUCCESS;
+    }
+
+    file_offsets_for_agg = (mca_io_ompio_local_io_array *)
+        malloc(entries_per_aggregator*sizeof(mca_io_ompio_local_io_array));
+    sorted_file_offsets = (int *)
+        malloc (entries_per_aggregator*sizeof(int));
+    memory_displacements = (MPI_Aint *) malloc
+        (entries_per_aggregator * sizeof(MPI_Aint));
+    cycle->file_offsets_for_agg = file_offsets_for_agg;
+    cycle->sorted_file_offsets = sorted_file_offsets;
+    cycle->memory_displacements = memory_displacements;
+    if (NULL == file_offsets_for_agg || NULL == sorted_file_offsets ||
+        NULL == memory_displacements) {
+        opal_output (1, "OUT OF MEMORY\n");
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+
+    /*Moving file offsets to an IO array!*/
+    temp_index = 0;
+    for (i=0;i<fh->f_procs_per_group; i++){
+        for(j=0;j<disp_index[i];j++){
+            if (blocklen_per_process[i][j] > 0){
+                file_offsets_for_agg[temp_index].length =
+                    blocklen_per_process[i][j];
+                file_offsets_for_agg[temp_index].process_id = i;
+                file_offsets_for_agg[temp_index].offset =
+                    displs_per_process[i][j];
+                temp_index++;
+            }
+        }
+    }
+
+    /* Sort the displacements for each aggregator */
+    read_heap_sort (file_offsets_for_agg,
+                    entries_per_aggregator,
+                    sorted_file_offsets);
+
+    memory_displacements[sorted_file_offsets[0]] = 0;
+    for (i=1; i<entries_per_aggregator; i++){
+        memory_displacements[sorted_file_offsets[i]] =
+            memory_displacements[sorted_file_offsets[i-1]] +
+            file_offsets_for_agg[sorted_file_offsets[i-1]].length;
+    }
+
+    /**********************************************************
+     *** 7e. Create the io array, and pass it to fbtl
+     *********************************************************/
+    fh->f_io_array = (mca_common_ompio_io_array_t *) malloc
+        (entries_per_aggregator * sizeof (mca_common_ompio_io_array_t));
+    if (NULL == fh->f_io_array) {
+        opal_output(1, "OUT OF MEMORY\n");
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+
+    fh->f_num_of_io_entries = 0;
+    fh->f_io_array[0].offset =
+        (IOVBASE_TYPE *)(intptr_t)file_offsets_for_agg[sorted_file_offsets[0]].offset;
+    fh->f_io_array[0].length =
+        file_offsets_for_agg[sorted_file_offsets[0]].length;
+    fh->f_io_array[0].memory_address =
+        cycle->global_buf+memory_displacements[sorted_file_offsets[0]];
+    fh->f_num_of_io_entries++;
+    for (i=1;i<entries_per_aggregator;i++){
+        if (file_offsets_for_agg[sorted_file_offsets[i-1]].offset +
+            file_offsets_for_agg[sorted_file_offsets[i-1]].length ==
+            file_offsets_for_agg[sorted_file_offsets[i]].offset){
+            fh->f_io_array[fh->f_num_of_io_entries - 1].length +=
+                file_offsets_for_agg[sorted_file_offsets[i]].length;
+        }
+        else{
+            fh->f_io_array[fh->f_num_of_io_entries].offset =
+                (IOVBASE_TYPE *)(intptr_t)file_offsets_for_agg[sorted_file_offsets[i]].offset;
+            fh->f_io_array[fh->f_num_of_io_entries].length =
+                file_offsets_for_agg[sorted_file_offsets[i]].length;
+            fh->f_io_array[fh->f_num_of_io_entries].memory_address =
+                cycle->global_buf+memory_displacements[sorted_file_offsets[i]];
+            fh->f_num_of_io_entries++;
+        }
+    }
+
+    ret = read_all_start_read (fh, cycle, use_accelerator_buffer);
+
+    free (fh->f_io_array);
+    fh->f_io_array = NULL;
+    fh->f_num_of_io_entries = 0;
+    if (OMPI_SUCCESS != ret) {
+        return ret;
+    }
+    cycle->entries_per_aggregator = entries_per_aggregator;
+
+    /* The data of each process is now described by its position in the
+     * cycle's buffer rather than in the file */
+    temp_disp_index = (ptrdiff_t *)calloc (1, fh->f_procs_per_group * sizeof (ptrdiff_t));
+    if (NULL == temp_disp_index) {
+        opal_output (1, "OUT OF MEMORY\n");
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+    for (i=0; i<entries_per_aggregator; i++){
+        temp_index =
+            file_offsets_for_agg[sorted_file_offsets[i]].process_id;
+        displs_per_process[temp_index][temp_disp_index[temp_index]] =
+            memory_displacements[sorted_file_offsets[i]];
+        if (temp_disp_index[temp_index] < disp_index[temp_index]){
+            temp_disp_index[temp_index] += 1;
+        }
+        else{
+            printf("temp_disp_index[%zu]: %ld is greater than disp_index[%zu]: %ld\n",
+                   temp_index, (long) temp_disp_index[temp_index],
+                   temp_index, (long) disp_index[temp_index]);
+        }
+    }
+    free(temp_disp_index);
+
+    return OMPI_SUCCESS;
 }
 
+/* Start the read of the current io array. Errors are reported through
+ * the request, so that they surface where the read is waited for. */
+static int read_all_start_read (ompio_file_t *fh, read_all_cycle_t *cycle,
+                                bool use_accelerator_buffer)
+{
+    mca_ompio_request_t *ompio_req = NULL;
+    ssize_t ret_temp = 0;
+    int ret = OMPI_SUCCESS;
+
+    mca_common_ompio_request_alloc (&ompio_req, MCA_OMPIO_REQUEST_READ);
+    if (NULL == ompio_req) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+
+    if (use_accelerator_buffer) {
+        ret = mca_common_ompio_file_iread_pregen(fh, (ompi_request_t *) ompio_req);
+    } else if (NULL != fh->f_fbtl->fbtl_ipreadv) {
+        ret = fh->f_fbtl->fbtl_ipreadv (fh, (ompi_request_t *) ompio_req);
+    } else {
+        /* No overlap without non-blocking reads */
+        ret_temp = fh->f_fbtl->fbtl_preadv (fh);
+        ret = (0 > ret_temp) ? OMPI_ERROR : OMPI_SUCCESS;
+        if (OMPI_SUCCESS == ret) {
+            ompio_req->req_ompi.req_status.MPI_ERROR = OMPI_SUCCESS;
+            ompio_req->req_ompi.req_status._ucount = ret_temp;
+            ompi_request_complete (&ompio_req->req_ompi, false);
+        }
+    }
+
+    if (0 > ret) {
+        opal_output (1, "common_ompio_file_read_all: starting the read failed\n");
+        ompio_req->req_ompi.req_status.MPI_ERROR = OMPI_ERROR;
+        ompio_req->req_ompi.req_status._ucount = 0;
+        ompi_request_complete (&ompio_req->req_ompi, false);
+    }
+
+    cycle->read_req = (ompi_request_t *) ompio_req;
+    return OMPI_SUCCESS;
+}
 
 static int read_heap_sort (mca_io_ompio_local_io_array *io_array,
                            int num_entries,
@@ -355,6 +355,11 @@ int mca_common_ompio_set_view (ompio_file_t *fh,
         /* user requested using an info object to disable collective buffering. */
         preferred = mca_fcoll_base_component_lookup ("individual");
     }
+    if ( NULL != fh->f_fcoll ) {
+        /* Give the module selected for the previous view a chance to
+           release its per-file data */
+        mca_fcoll_base_file_unselect (fh);
+    }
     ret = mca_fcoll_base_file_select (fh, (mca_base_component_t *)preferred);
     if ( OMPI_SUCCESS != ret ) {
         opal_output(1, "mca_common_ompio_set_view: mca_fcoll_base_file_select() failed\n");
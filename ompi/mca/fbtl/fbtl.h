@@ -139,6 +139,14 @@ typedef void (*mca_fbtl_base_module_request_free_fn_t)
 typedef bool (*mca_fbtl_base_module_check_atomicity_fn_t)
     (struct ompio_file_t *file);
 
+/* Optional: tell the module about a buffer that will be used for many
+ * I/O operations on this file (e.g. the collective I/O aggregation
+ * buffers of fcoll), so that it can register it with the I/O backend */
+typedef int (*mca_fbtl_base_module_register_buf_fn_t)
+    (struct ompio_file_t *file, void *buf, size_t len);
+typedef void (*mca_fbtl_base_module_deregister_buf_fn_t)
+    (struct ompio_file_t *file, void *buf);
+
 /*
  * ***********************************************************************
  * ***************************  module structure *************************
@@ -161,6 +169,10 @@ struct mca_fbtl_base_module_1_0_0_t {
     mca_fbtl_base_module_progress_fn_t        fbtl_progress;
     mca_fbtl_base_module_request_free_fn_t    fbtl_request_free;
     mca_fbtl_base_module_check_atomicity_fn_t fbtl_check_atomicity;
+
+    /* Optional, may be NULL */
+    mca_fbtl_base_module_register_buf_fn_t    fbtl_register_buf;
+    mca_fbtl_base_module_deregister_buf_fn_t  fbtl_deregister_buf;
 };
 typedef struct mca_fbtl_base_module_1_0_0_t mca_fbtl_base_module_1_0_0_t;
 typedef mca_fbtl_base_module_1_0_0_t mca_fbtl_base_module_t;
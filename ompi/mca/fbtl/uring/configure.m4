@@ -0,0 +1,45 @@
+# -*- shell-script -*-
+#
+# Copyright (c) 2025      The University of Tennessee and The University
+#                         of Tennessee Research Foundation.  All rights
+#                         reserved.
+# $COPYRIGHT$
+#
+# Additional copyrights may follow
+#
+# $HEADER$
+#
+
+# MCA_fbtl_uring_CONFIG(action-if-can-compile,
+#                        [action-if-cant-compile])
+# ------------------------------------------------
+AC_DEFUN([MCA_ompi_fbtl_uring_CONFIG],[
+    AC_CONFIG_FILES([ompi/mca/fbtl/uring/Makefile])
+
+    OPAL_VAR_SCOPE_PUSH([fbtl_uring_happy])
+
+    AC_ARG_WITH([liburing],
+        [AS_HELP_STRING([--with-liburing(=DIR)],
+             [Build io_uring support for the fbtl framework, optionally adding DIR/include, DIR/lib, and DIR/lib64 to the search path for headers and libraries])])
+
+    OAC_CHECK_PACKAGE([liburing],
+                      [fbtl_uring],
+                      [liburing.h],
+                      [uring],
+                      [io_uring_queue_init],
+                      [fbtl_uring_happy="yes"],
+                      [fbtl_uring_happy="no"])
+
+    AS_IF([test "$fbtl_uring_happy" = "yes"],
+          [$1],
+          [AS_IF([test ! -z "$with_liburing" && test "$with_liburing" != "no"],
+                 [AC_MSG_ERROR([io_uring support requested but not found.  Aborting])])
+           $2])
+
+    # substitute in the things needed to build uring
+    AC_SUBST([fbtl_uring_CPPFLAGS])
+    AC_SUBST([fbtl_uring_LDFLAGS])
+    AC_SUBST([fbtl_uring_LIBS])
+
+    OPAL_VAR_SCOPE_POP
+])dnl
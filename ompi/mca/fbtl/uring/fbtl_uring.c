@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+#include "mpi.h"
+
+#include <string.h>
+
+#include "ompi/mca/fbtl/fbtl.h"
+#include "ompi/mca/fbtl/base/base.h"
+#include "ompi/mca/fbtl/uring/fbtl_uring.h"
+
+/*
+ * *******************************************************************
+ * ************************ actions structure ************************
+ * *******************************************************************
+ */
+static mca_fbtl_base_module_1_0_0_t uring =  {
+    mca_fbtl_uring_module_init,     /* initialise after being selected */
+    mca_fbtl_uring_module_finalize, /* close a module on a communicator */
+    mca_fbtl_uring_preadv,          /* blocking read */
+    mca_fbtl_uring_ipreadv,         /* non-blocking read*/
+    mca_fbtl_uring_pwritev,         /* blocking write */
+    mca_fbtl_uring_ipwritev,        /* non-blocking write */
+    mca_fbtl_uring_progress,        /* module specific progress */
+    mca_fbtl_uring_request_free,    /* free module specific data items on the request */
+    mca_fbtl_base_check_atomicity,  /* check whether atomicity is supported on this fs */
+    mca_fbtl_uring_register_buf,    /* register a long-lived I/O buffer */
+    mca_fbtl_uring_deregister_buf   /* deregister it */
+};
+/*
+ * *******************************************************************
+ * ************************* structure ends **************************
+ * *******************************************************************
+ */
+
+int mca_fbtl_uring_component_init_query(bool enable_progress_threads,
+                                        bool enable_mpi_threads)
+{
+    /* Nothing to do */
+   return OMPI_SUCCESS;
+}
+
+struct mca_fbtl_base_module_1_0_0_t *
+mca_fbtl_uring_component_file_query (ompio_file_t *fh, int *priority)
+{
+    *priority = mca_fbtl_uring_priority;
+
+    /* io_uring is only of use on local file systems; parallel file
+     * systems come with their own fbtl or go through the kernel client,
+     * where posix aio is as good. */
+    if (UFS != fh->f_fstype) {
+        return NULL;
+    }
+
+    return &uring;
+}
+
+int mca_fbtl_uring_component_file_unquery (ompio_file_t *file)
+{
+   /* This function might be needed for some purposes later. for now it
+    * does not have anything to do since there are no steps which need
+    * to be undone if this module is not selected */
+
+   return OMPI_SUCCESS;
+}
+
+int mca_fbtl_uring_module_init (ompio_file_t *file)
+{
+    mca_fbtl_uring_file_t *urf;
+    int ret;
+
+    urf = (mca_fbtl_uring_file_t *) calloc (1, sizeof (mca_fbtl_uring_file_t));
+    if (NULL == urf) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+
+    urf->urf_entries = (0 < mca_fbtl_uring_entries) ? (unsigned) mca_fbtl_uring_entries
+                                                    : FBTL_URING_DEFAULT_ENTRIES;
+    ret = io_uring_queue_init (urf->urf_entries, &urf->urf_ring, 0);
+    if (0 > ret) {
+        opal_output (1, "mca_fbtl_uring_module_init: io_uring_queue_init() failed: %s",
+                     strerror(-ret));
+        free (urf);
+        return OMPI_ERROR;
+    }
+
+    OBJ_CONSTRUCT(&urf->urf_lock, opal_mutex_t);
+    file->f_fbtl_data = urf;
+
+    /* The file descriptor is not open yet at this point; it is
+     * registered with the ring on the first operation */
+    return OMPI_SUCCESS;
+}
+
+
+int mca_fbtl_uring_module_finalize (ompio_file_t *file)
+{
+    mca_fbtl_uring_file_t *urf = (mca_fbtl_uring_file_t *) file->f_fbtl_data;
+
+    if (NULL != urf) {
+        /* Tearing down the ring also drops the registered file
+         * and buffers */
+        io_uring_queue_exit (&urf->urf_ring);
+        OBJ_DESTRUCT(&urf->urf_lock);
+        free (urf);
+        file->f_fbtl_data = NULL;
+    }
+
+    return OMPI_SUCCESS;
+}
+
+/* Registered buffers can only be replaced as a whole, so every change to
+ * the set re-registers it. This happens once per collective operation,
+ * and is amortized over the cycles that use the buffers. */
+static void uring_update_buffers (mca_fbtl_uring_file_t *urf)
+{
+    int ret;
+
+    if (urf->urf_bufs_registered) {
+        io_uring_unregister_buffers (&urf->urf_ring);
+        urf->urf_bufs_registered = false;
+    }
+
+    if (0 == urf->urf_num_bufs) {
+        return;
+    }
+
+    ret = io_uring_register_buffers (&urf->urf_ring, urf->urf_bufs, urf->urf_num_bufs);
+    if (0 > ret) {
+        /* Most likely RLIMIT_MEMLOCK; plain reads/writes still work */
+        opal_output_verbose (10, ompi_fbtl_base_framework.framework_output,
+                             "mca_fbtl_uring: could not register %d buffers: %s",
+                             urf->urf_num_bufs, strerror(-ret));
+        return;
+    }
+
+    urf->urf_bufs_registered = true;
+}
+
+int mca_fbtl_uring_register_buf (ompio_file_t *file, void *buf, size_t len)
+{
+    mca_fbtl_uring_file_t *urf = (mca_fbtl_uring_file_t *) file->f_fbtl_data;
+
+    if (!mca_fbtl_uring_fixed_buffers || NULL == urf || NULL == buf || 0 == len) {
+        return OMPI_SUCCESS;
+    }
+
+    OPAL_THREAD_LOCK(&urf->urf_lock);
+
+    if (FBTL_URING_MAX_FIXED_BUFS == urf->urf_num_bufs) {
+        OPAL_THREAD_UNLOCK(&urf->urf_lock);
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+
+    /* The registration may not change under in-flight fixed operations */
+    mca_fbtl_uring_drain (urf);
+
+    urf->urf_bufs[urf->urf_num_bufs].iov_base = buf;
+    urf->urf_bufs[urf->urf_num_bufs].iov_len  = len;
+    urf->urf_num_bufs++;
+    uring_update_buffers (urf);
+
+    OPAL_THREAD_UNLOCK(&urf->urf_lock);
+
+    return OMPI_SUCCESS;
+}
+
+void mca_fbtl_uring_deregister_buf (ompio_file_t *file, void *buf)
+{
+    mca_fbtl_uring_file_t *urf = (mca_fbtl_uring_file_t *) file->f_fbtl_data;
+
+    if (NULL == urf) {
+        return;
+    }
+
+    OPAL_THREAD_LOCK(&urf->urf_lock);
+
+    for (int i = 0; i < urf->urf_num_bufs; i++) {
+        if (urf->urf_bufs[i].iov_base == buf) {
+            mca_fbtl_uring_drain (urf);
+
+            urf->urf_bufs[i] = urf->urf_bufs[urf->urf_num_bufs - 1];
+            urf->urf_num_bufs--;
+            uring_update_buffers (urf);
+            break;
+        }
+    }
+
+    OPAL_THREAD_UNLOCK(&urf->urf_lock);
+}
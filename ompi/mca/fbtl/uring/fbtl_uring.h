@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#ifndef MCA_FBTL_URING_H
+#define MCA_FBTL_URING_H
+
+#include <liburing.h>
+
+#include "ompi_config.h"
+#include "ompi/mca/mca.h"
+#include "ompi/mca/fbtl/fbtl.h"
+#include "ompi/mca/common/ompio/common_ompio.h"
+#include "ompi/mca/common/ompio/common_ompio_request.h"
+#include "opal/mca/threads/mutex.h"
+
+extern int mca_fbtl_uring_priority;
+extern int mca_fbtl_uring_entries;
+extern bool mca_fbtl_uring_fixed_buffers;
+
+#define FBTL_URING_BASE_PRIORITY     1
+#define FBTL_URING_DEFAULT_ENTRIES   256
+#define FBTL_URING_MAX_FIXED_BUFS    16
+/* Largest transfer handed to a single sqe; larger io entries are
+ * completed through several consecutive operations */
+#define FBTL_URING_MAX_IO            (1UL << 30)
+
+BEGIN_C_DECLS
+
+int mca_fbtl_uring_component_init_query(bool enable_progress_threads,
+                                        bool enable_mpi_threads);
+struct mca_fbtl_base_module_1_0_0_t *
+mca_fbtl_uring_component_file_query (ompio_file_t *file, int *priority);
+int mca_fbtl_uring_component_file_unquery (ompio_file_t *file);
+
+int mca_fbtl_uring_module_init (ompio_file_t *file);
+int mca_fbtl_uring_module_finalize (ompio_file_t *file);
+
+OMPI_DECLSPEC extern mca_fbtl_base_component_2_0_0_t mca_fbtl_uring_component;
+/*
+ * ******************************************************************
+ * ********* functions which are implemented in this module *********
+ * ******************************************************************
+ */
+
+ssize_t mca_fbtl_uring_preadv (ompio_file_t *file );
+ssize_t mca_fbtl_uring_pwritev (ompio_file_t *file );
+ssize_t mca_fbtl_uring_ipreadv (ompio_file_t *file,
+                                ompi_request_t *request);
+ssize_t mca_fbtl_uring_ipwritev (ompio_file_t *file,
+                                 ompi_request_t *request);
+
+bool mca_fbtl_uring_progress     (mca_ompio_request_t *req);
+void mca_fbtl_uring_request_free (mca_ompio_request_t *req);
+
+int  mca_fbtl_uring_register_buf   (ompio_file_t *file, void *buf, size_t len);
+void mca_fbtl_uring_deregister_buf (ompio_file_t *file, void *buf);
+
+struct mca_fbtl_uring_file_t;
+/* Wait for all the operations in flight on the ring; called with the
+ * file lock held */
+void mca_fbtl_uring_drain (struct mca_fbtl_uring_file_t *urf);
+
+/* Per-file state, hung off ompio_file_t::f_fbtl_data. The ring is shared
+ * by all the operations on the file; completions are routed to their
+ * operation through the sqe user data. */
+struct mca_fbtl_uring_file_t {
+    struct io_uring  urf_ring;
+    opal_mutex_t     urf_lock;          /* protects the ring and the fields below */
+    unsigned         urf_entries;       /* size of the submission queue */
+    unsigned         urf_inflight;      /* submitted sqes not yet reaped */
+    bool             urf_fd_registered; /* the file is registered at index 0 */
+    bool             urf_fd_failed;     /* registering the file failed, don't retry */
+    struct iovec     urf_bufs[FBTL_URING_MAX_FIXED_BUFS];
+    int              urf_num_bufs;
+    bool             urf_bufs_registered;
+};
+typedef struct mca_fbtl_uring_file_t mca_fbtl_uring_file_t;
+
+struct mca_fbtl_uring_request_data_t;
+
+/* One io entry of an operation; resubmitted until done, since reads and
+ * writes may complete partially */
+struct mca_fbtl_uring_sub_t {
+    char                                 *urs_buf;
+    size_t                                urs_len;     /* bytes left */
+    off_t                                 urs_offset;
+    struct mca_fbtl_uring_request_data_t *urs_req;
+};
+typedef struct mca_fbtl_uring_sub_t mca_fbtl_uring_sub_t;
+
+struct mca_fbtl_uring_request_data_t {
+    mca_fbtl_uring_file_t *urd_file;
+    int                    urd_fd;          /* used if the file is not registered */
+    int                    urd_type;        /* read or write */
+    int                    urd_count;       /* number of io entries */
+    int                    urd_next;        /* next entry to submit */
+    int                    urd_open;        /* entries submitted, not yet completed */
+    int                    urd_error;       /* first error, as a negative errno */
+    ssize_t                urd_total_len;   /* total amount of data transferred */
+    mca_fbtl_uring_sub_t  *urd_subs;
+    mca_fbtl_uring_sub_t **urd_resubmit;    /* partially completed entries */
+    int                    urd_num_resubmit;
+};
+typedef struct mca_fbtl_uring_request_data_t mca_fbtl_uring_request_data_t;
+
+/* define constants for read/write operations */
+#define FBTL_URING_READ  1
+#define FBTL_URING_WRITE 2
+
+/*
+ * ******************************************************************
+ * ************ functions implemented in this module end ************
+ * ******************************************************************
+ */
+
+END_C_DECLS
+
+#endif /* MCA_FBTL_URING_H */
@@ -0,0 +1,380 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+#include "fbtl_uring.h"
+
+#include <errno.h>
+#include <string.h>
+
+#include "mpi.h"
+#include "ompi/constants.h"
+#include "ompi/mca/fbtl/fbtl.h"
+
+/*
+ * Every io entry of an operation becomes one sqe (two or more, if it is
+ * larger than FBTL_URING_MAX_IO or completes partially). Submission is
+ * batched: each progress call fills as many sqes as the ring has room
+ * for, and hands them to the kernel with a single io_uring_submit().
+ * Completions of all the operations on a file are reaped by whichever
+ * operation progresses first, and routed through the sqe user data.
+ */
+
+static int uring_find_fixed_buf (mca_fbtl_uring_file_t *urf, const char *buf, size_t len)
+{
+    if (!urf->urf_bufs_registered) {
+        return -1;
+    }
+
+    for (int i = 0; i < urf->urf_num_bufs; i++) {
+        const char *base = (const char *) urf->urf_bufs[i].iov_base;
+        if (buf >= base && buf + len <= base + urf->urf_bufs[i].iov_len) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+static void uring_reap_one (mca_fbtl_uring_file_t *urf, struct io_uring_cqe *cqe)
+{
+    mca_fbtl_uring_sub_t *sub = (mca_fbtl_uring_sub_t *) io_uring_cqe_get_data (cqe);
+    mca_fbtl_uring_request_data_t *data = sub->urs_req;
+    int res = cqe->res;
+
+    io_uring_cqe_seen (&urf->urf_ring, cqe);
+    urf->urf_inflight--;
+    data->urd_open--;
+
+    if (0 > res) {
+        if (-EAGAIN == res || -EINTR == res) {
+            data->urd_resubmit[data->urd_num_resubmit++] = sub;
+        } else if (0 == data->urd_error) {
+            data->urd_error = res;
+        }
+        return;
+    }
+
+    data->urd_total_len += res;
+
+    /* A read returning 0 is end of file; the operation is short */
+    if (0 == res && FBTL_URING_READ == data->urd_type) {
+        return;
+    }
+
+    if ((size_t) res < sub->urs_len) {
+        /* Partial completion */
+        sub->urs_buf    += res;
+        sub->urs_len    -= res;
+        sub->urs_offset += res;
+        data->urd_resubmit[data->urd_num_resubmit++] = sub;
+    }
+}
+
+static void uring_reap (mca_fbtl_uring_file_t *urf)
+{
+    struct io_uring_cqe *cqe;
+
+    while (0 < urf->urf_inflight && 0 == io_uring_peek_cqe (&urf->urf_ring, &cqe)) {
+        uring_reap_one (urf, cqe);
+    }
+}
+
+void mca_fbtl_uring_drain (mca_fbtl_uring_file_t *urf)
+{
+    struct io_uring_cqe *cqe;
+
+    while (0 < urf->urf_inflight) {
+        if (0 != io_uring_wait_cqe (&urf->urf_ring, &cqe)) {
+            break;
+        }
+        uring_reap_one (urf, cqe);
+    }
+}
+
+static int uring_submit (mca_fbtl_uring_request_data_t *data)
+{
+    mca_fbtl_uring_file_t *urf = data->urd_file;
+    int queued = 0, ret;
+
+    /* Stop feeding the operation once it has failed */
+    while (0 == data->urd_error && urf->urf_inflight < urf->urf_entries) {
+        mca_fbtl_uring_sub_t *sub;
+        struct io_uring_sqe *sqe;
+        unsigned len;
+        int fd, buf_index;
+
+        if (0 < data->urd_num_resubmit) {
+            sub = data->urd_resubmit[--data->urd_num_resubmit];
+        } else if (data->urd_next < data->urd_count) {
+            sub = &data->urd_subs[data->urd_next++];
+            if (0 == sub->urs_len) {
+                continue;
+            }
+        } else {
+            break;
+        }
+
+        sqe = io_uring_get_sqe (&urf->urf_ring);
+        if (NULL == sqe) {
+            /* Put it back, and try again once the kernel has
+             * consumed the queued entries */
+            data->urd_resubmit[data->urd_num_resubmit++] = sub;
+            break;
+        }
+
+        len = (unsigned) (sub->urs_len > FBTL_URING_MAX_IO ? FBTL_URING_MAX_IO : sub->urs_len);
+        fd  = urf->urf_fd_registered ? 0 : data->urd_fd;
+        buf_index = uring_find_fixed_buf (urf, sub->urs_buf, len);
+
+        if (FBTL_URING_WRITE == data->urd_type) {
+            if (0 <= buf_index) {
+                io_uring_prep_write_fixed (sqe, fd, sub->urs_buf, len, sub->urs_offset, buf_index);
+            } else {
+                io_uring_prep_write (sqe, fd, sub->urs_buf, len, sub->urs_offset);
+            }
+        } else {
+            if (0 <= buf_index) {
+                io_uring_prep_read_fixed (sqe, fd, sub->urs_buf, len, sub->urs_offset, buf_index);
+            } else {
+                io_uring_prep_read (sqe, fd, sub->urs_buf, len, sub->urs_offset);
+            }
+        }
+        if (urf->urf_fd_registered) {
+            io_uring_sqe_set_flags (sqe, IOSQE_FIXED_FILE);
+        }
+        io_uring_sqe_set_data (sqe, sub);
+
+        urf->urf_inflight++;
+        data->urd_open++;
+        queued++;
+    }
+
+    if (0 == queued) {
+        return OMPI_SUCCESS;
+    }
+
+    ret = io_uring_submit (&urf->urf_ring);
+    if (0 > ret) {
+        opal_output (1, "mca_fbtl_uring: io_uring_submit() failed: %s", strerror(-ret));
+        return OMPI_ERROR;
+    }
+
+    return OMPI_SUCCESS;
+}
+
+static bool uring_done (mca_fbtl_uring_request_data_t *data)
+{
+    if (0 != data->urd_open) {
+        return false;
+    }
+    if (0 != data->urd_error) {
+        return true;
+    }
+    return (data->urd_next == data->urd_count && 0 == data->urd_num_resubmit);
+}
+
+static void uring_free_data (mca_fbtl_uring_request_data_t *data)
+{
+    free (data->urd_subs);
+    free (data->urd_resubmit);
+    free (data);
+}
+
+/* Set up an operation over the file's io array and start it */
+static mca_fbtl_uring_request_data_t *uring_post (ompio_file_t *fh, int type)
+{
+    mca_fbtl_uring_file_t *urf = (mca_fbtl_uring_file_t *) fh->f_fbtl_data;
+    mca_fbtl_uring_request_data_t *data;
+    int ret;
+
+    data = (mca_fbtl_uring_request_data_t *) calloc (1, sizeof (mca_fbtl_uring_request_data_t));
+    if (NULL == data) {
+        return NULL;
+    }
+
+    data->urd_file  = urf;
+    data->urd_fd    = fh->fd;
+    data->urd_type  = type;
+    data->urd_count = fh->f_num_of_io_entries;
+    if (0 == data->urd_count) {
+        /* Nothing to transfer: done on the first progress call */
+        return data;
+    }
+
+    data->urd_subs  = (mca_fbtl_uring_sub_t *) malloc (data->urd_count * sizeof (mca_fbtl_uring_sub_t));
+    data->urd_resubmit = (mca_fbtl_uring_sub_t **) malloc (data->urd_count *
+                                                           sizeof (mca_fbtl_uring_sub_t *));
+    if (NULL == data->urd_subs || NULL == data->urd_resubmit) {
+        uring_free_data (data);
+        return NULL;
+    }
+
+    for (int i = 0; i < data->urd_count; i++) {
+        data->urd_subs[i].urs_buf    = (char *) fh->f_io_array[i].memory_address;
+        data->urd_subs[i].urs_len    = fh->f_io_array[i].length;
+        data->urd_subs[i].urs_offset = (off_t) (intptr_t) fh->f_io_array[i].offset;
+        data->urd_subs[i].urs_req    = data;
+    }
+
+    OPAL_THREAD_LOCK(&urf->urf_lock);
+
+    if (!urf->urf_fd_registered && !urf->urf_fd_failed) {
+        ret = io_uring_register_files (&urf->urf_ring, &fh->fd, 1);
+        if (0 == ret) {
+            urf->urf_fd_registered = true;
+        } else {
+            urf->urf_fd_failed = true;
+        }
+    }
+
+    ret = uring_submit (data);
+
+    OPAL_THREAD_UNLOCK(&urf->urf_lock);
+
+    if (OMPI_SUCCESS != ret) {
+        /* Entries already handed to the kernel still point to data */
+        OPAL_THREAD_LOCK(&urf->urf_lock);
+        mca_fbtl_uring_drain (urf);
+        OPAL_THREAD_UNLOCK(&urf->urf_lock);
+        uring_free_data (data);
+        return NULL;
+    }
+
+    return data;
+}
+
+/* Advance an operation; with wait, block until at least one completion
+ * arrives if no progress could be made otherwise */
+static bool uring_progress (mca_fbtl_uring_request_data_t *data, bool wait)
+{
+    mca_fbtl_uring_file_t *urf = data->urd_file;
+    struct io_uring_cqe *cqe;
+    bool done;
+
+    OPAL_THREAD_LOCK(&urf->urf_lock);
+
+    uring_reap (urf);
+    if (OMPI_SUCCESS != uring_submit (data) && 0 == data->urd_error) {
+        data->urd_error = -EIO;
+    }
+
+    done = uring_done (data);
+    if (!done && wait && 0 < urf->urf_inflight
+        && 0 == io_uring_wait_cqe (&urf->urf_ring, &cqe)) {
+        uring_reap_one (urf, cqe);
+        done = uring_done (data);
+    }
+
+    OPAL_THREAD_UNLOCK(&urf->urf_lock);
+
+    return done;
+}
+
+static ssize_t uring_blocking (ompio_file_t *fh, int type)
+{
+    mca_fbtl_uring_request_data_t *data;
+    ssize_t ret;
+
+    if (0 == fh->f_num_of_io_entries) {
+        return 0;
+    }
+
+    data = uring_post (fh, type);
+    if (NULL == data) {
+        return OMPI_ERROR;
+    }
+
+    while (!uring_progress (data, true)) {
+        /* keep going */
+    }
+
+    if (0 != data->urd_error) {
+        opal_output (1, "mca_fbtl_uring: %s failed: %s",
+                     (FBTL_URING_WRITE == type) ? "write" : "read",
+                     strerror(-data->urd_error));
+        ret = OMPI_ERROR;
+    } else {
+        ret = data->urd_total_len;
+    }
+
+    uring_free_data (data);
+    return ret;
+}
+
+static ssize_t uring_nonblocking (ompio_file_t *fh, ompi_request_t *request, int type)
+{
+    mca_ompio_request_t *req = (mca_ompio_request_t *) request;
+    mca_fbtl_uring_request_data_t *data;
+
+    data = uring_post (fh, type);
+    if (NULL == data) {
+        opal_output (1, "mca_fbtl_uring: could not post %s",
+                     (FBTL_URING_WRITE == type) ? "write" : "read");
+        return OMPI_ERROR;
+    }
+
+    req->req_data = data;
+    req->req_progress_fn = mca_fbtl_uring_progress;
+    req->req_free_fn     = mca_fbtl_uring_request_free;
+
+    return OMPI_SUCCESS;
+}
+
+ssize_t mca_fbtl_uring_preadv (ompio_file_t *fh)
+{
+    return uring_blocking (fh, FBTL_URING_READ);
+}
+
+ssize_t mca_fbtl_uring_pwritev (ompio_file_t *fh)
+{
+    return uring_blocking (fh, FBTL_URING_WRITE);
+}
+
+ssize_t mca_fbtl_uring_ipreadv (ompio_file_t *fh, ompi_request_t *request)
+{
+    return uring_nonblocking (fh, request, FBTL_URING_READ);
+}
+
+ssize_t mca_fbtl_uring_ipwritev (ompio_file_t *fh, ompi_request_t *request)
+{
+    return uring_nonblocking (fh, request, FBTL_URING_WRITE);
+}
+
+bool mca_fbtl_uring_progress (mca_ompio_request_t *req)
+{
+    mca_fbtl_uring_request_data_t *data = (mca_fbtl_uring_request_data_t *) req->req_data;
+
+    if (!uring_progress (data, false)) {
+        return false;
+    }
+
+    req->req_ompi.req_status.MPI_ERROR = (0 == data->urd_error) ? OMPI_SUCCESS : OMPI_ERROR;
+    req->req_ompi.req_status._ucount = data->urd_total_len;
+    return true;
+}
+
+void mca_fbtl_uring_request_free (mca_ompio_request_t *req)
+{
+    /* Free the fbtl specific data structures */
+    mca_fbtl_uring_request_data_t *data = (mca_fbtl_uring_request_data_t *) req->req_data;
+
+    if (NULL != data) {
+        /* Don't leave the kernel writing into freed memory */
+        if (0 < data->urd_open) {
+            OPAL_THREAD_LOCK(&data->urd_file->urf_lock);
+            mca_fbtl_uring_drain (data->urd_file);
+            OPAL_THREAD_UNLOCK(&data->urd_file->urf_lock);
+        }
+        uring_free_data (data);
+        req->req_data = NULL;
+    }
+}
@@ -0,0 +1,521 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+#include "fcoll_vulcan.h"
+#include "fcoll_vulcan_internal.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "mpi.h"
+#include "ompi/constants.h"
+#include "ompi/communicator/communicator.h"
+#include "ompi/file/file.h"
+#include "ompi/mca/io/io.h"
+#include "ompi/mca/fcoll/base/base.h"
+#include "opal/mca/base/mca_base_pvar.h"
+#include "opal/util/info.h"
+
+/*
+ * Adaptive aggregator selection.
+ *
+ * The static heuristics of common_ompio pick the number of aggregators
+ * before anything is known about the bandwidth the file system delivers
+ * to them. In adaptive mode, the first fcoll_vulcan_adaptive_probes
+ * collective writes on a view are run with different aggregator counts
+ * (the static choice, twice as many, half as many, four times as
+ * many...), aligned to the stripe count of the file. Each probe measures
+ * the achieved bandwidth of the whole operation and of each aggregator.
+ * Once the probes are done, the count that did best is used for the rest
+ * of the view, by writes and reads alike.
+ *
+ * Aggregators are placed one per NUMA domain, spread over the nodes,
+ * before any domain gets a second one. Domains in which an aggregator
+ * was markedly slower than the others during the last probe (e.g.
+ * because they share their node with other busy processes) are only
+ * used once the other domains are exhausted.
+ */
+
+typedef struct adaptive_key_t {
+    int rank;
+    int index_in_domain;   /* position of the rank within its NUMA domain */
+    int busy;
+    int domain_in_node;    /* position of the NUMA domain within its node */
+    int node;
+} adaptive_key_t;
+
+static int adaptive_key_cmp (const void *a, const void *b)
+{
+    const adaptive_key_t *ka = (const adaptive_key_t *) a;
+    const adaptive_key_t *kb = (const adaptive_key_t *) b;
+
+    if (ka->index_in_domain != kb->index_in_domain) {
+        return ka->index_in_domain - kb->index_in_domain;
+    }
+    if (ka->busy != kb->busy) {
+        return ka->busy - kb->busy;
+    }
+    if (ka->domain_in_node != kb->domain_in_node) {
+        return ka->domain_in_node - kb->domain_in_node;
+    }
+    if (ka->node != kb->node) {
+        return ka->node - kb->node;
+    }
+    return ka->rank - kb->rank;
+}
+
+static int adaptive_int_cmp (const void *a, const void *b)
+{
+    return *(const int *) a - *(const int *) b;
+}
+
+static int adaptive_double_cmp (const void *a, const void *b)
+{
+    double da = *(const double *) a, db = *(const double *) b;
+    return (da > db) - (da < db);
+}
+
+/* Find the lowest rank of the file communicator sharing the node, and
+ * the NUMA domain, with each rank */
+static int adaptive_discover_topology (ompio_file_t *fh, mca_fcoll_vulcan_adaptive_t *ad)
+{
+    ompi_communicator_t *node_comm = MPI_COMM_NULL, *numa_comm = MPI_COMM_NULL;
+    opal_info_t comm_info;
+    int local[2], *all = NULL;
+    int i, ret;
+
+    OBJ_CONSTRUCT(&comm_info, opal_info_t);
+
+    ret = ompi_comm_split_type (fh->f_comm, MPI_COMM_TYPE_SHARED, 0, &comm_info, &node_comm);
+    if (OMPI_SUCCESS != ret) {
+        goto exit;
+    }
+    local[0] = fh->f_rank;
+    ret = node_comm->c_coll->coll_allreduce (MPI_IN_PLACE, &local[0], 1, MPI_INT, MPI_MIN,
+                                             node_comm, node_comm->c_coll->coll_allreduce_module);
+    if (OMPI_SUCCESS != ret) {
+        goto exit;
+    }
+
+    /* Processes that are not bound get MPI_COMM_NULL, and count as a
+     * NUMA domain spanning the whole node */
+    ret = ompi_comm_split_type (fh->f_comm, OMPI_COMM_TYPE_NUMA, 0, &comm_info, &numa_comm);
+    if (OMPI_SUCCESS != ret) {
+        goto exit;
+    }
+    local[1] = local[0];
+    if (MPI_COMM_NULL != numa_comm) {
+        local[1] = fh->f_rank;
+        ret = numa_comm->c_coll->coll_allreduce (MPI_IN_PLACE, &local[1], 1, MPI_INT, MPI_MIN,
+                                                 numa_comm, numa_comm->c_coll->coll_allreduce_module);
+        if (OMPI_SUCCESS != ret) {
+            goto exit;
+        }
+    }
+
+    all = (int *) malloc (2 * fh->f_size * sizeof(int));
+    if (NULL == all) {
+        ret = OMPI_ERR_OUT_OF_RESOURCE;
+        goto exit;
+    }
+    ret = fh->f_comm->c_coll->coll_allgather (local, 2, MPI_INT, all, 2, MPI_INT, fh->f_comm,
+                                              fh->f_comm->c_coll->coll_allgather_module);
+    if (OMPI_SUCCESS != ret) {
+        goto exit;
+    }
+
+    for (i = 0; i < fh->f_size; i++) {
+        ad->node_of[i]   = all[2*i];
+        ad->domain_of[i] = all[2*i+1];
+    }
+
+exit:
+    free (all);
+    if (MPI_COMM_NULL != numa_comm) {
+        ompi_comm_free (&numa_comm);
+    }
+    if (MPI_COMM_NULL != node_comm) {
+        ompi_comm_free (&node_comm);
+    }
+    OBJ_DESTRUCT(&comm_info);
+    return ret;
+}
+
+/* Aggregators that do not map evenly onto the stripes of the file end up
+ * sharing storage targets unevenly */
+static int adaptive_align_to_stripes (ompio_file_t *fh, int num_aggrs)
+{
+    int stripe_count = fh->f_stripe_count;
+
+    if (0 >= stripe_count || 1 >= num_aggrs) {
+        return num_aggrs;
+    }
+    if (num_aggrs >= stripe_count) {
+        return (num_aggrs / stripe_count) * stripe_count;
+    }
+    /* the largest divisor of the stripe count not above num_aggrs */
+    while (0 != stripe_count % num_aggrs) {
+        num_aggrs--;
+    }
+    return num_aggrs;
+}
+
+/* Aggregator count of the given probe: base, 2*base, base/2, 4*base,
+ * base/4, ... */
+static int adaptive_probe_count (ompio_file_t *fh, int base, int probe)
+{
+    int shift = (probe + 1) / 2;
+    int num_aggrs = base;
+
+    if (0 < shift) {
+        num_aggrs = (probe & 1) ? base << shift : base >> shift;
+    }
+    if (num_aggrs < 1) {
+        num_aggrs = 1;
+    }
+    if (num_aggrs > fh->f_size) {
+        num_aggrs = fh->f_size;
+    }
+
+    return adaptive_align_to_stripes (fh, num_aggrs);
+}
+
+static int adaptive_place (ompio_file_t *fh, mca_fcoll_vulcan_adaptive_t *ad, int num_aggrs)
+{
+    adaptive_key_t *keys = NULL;
+    int *count_in_domain = NULL, *count_in_node = NULL, *domain_in_node = NULL;
+    int i, ret = OMPI_SUCCESS;
+
+    keys = (adaptive_key_t *) malloc (fh->f_size * sizeof(adaptive_key_t));
+    /* indexed by the lowest rank of a domain, resp. node */
+    count_in_domain = (int *) calloc (fh->f_size, sizeof(int));
+    count_in_node   = (int *) calloc (fh->f_size, sizeof(int));
+    domain_in_node  = (int *) calloc (fh->f_size, sizeof(int));
+    if (NULL == keys || NULL == count_in_domain || NULL == count_in_node ||
+        NULL == domain_in_node) {
+        ret = OMPI_ERR_OUT_OF_RESOURCE;
+        goto exit;
+    }
+
+    for (i = 0; i < fh->f_size; i++) {
+        if (ad->domain_of[i] == i) {
+            domain_in_node[i] = count_in_node[ad->node_of[i]]++;
+        }
+    }
+    for (i = 0; i < fh->f_size; i++) {
+        keys[i].rank            = i;
+        keys[i].index_in_domain = count_in_domain[ad->domain_of[i]]++;
+        keys[i].busy            = ad->busy[i] ? 1 : 0;
+        keys[i].domain_in_node  = domain_in_node[ad->domain_of[i]];
+        keys[i].node            = ad->node_of[i];
+    }
+    qsort (keys, fh->f_size, sizeof(adaptive_key_t), adaptive_key_cmp);
+
+    ad->num_aggrs = num_aggrs;
+    for (i = 0; i < num_aggrs; i++) {
+        ad->aggr_list[i] = keys[i].rank;
+    }
+    qsort (ad->aggr_list, num_aggrs, sizeof(int), adaptive_int_cmp);
+
+exit:
+    free (keys);
+    free (count_in_domain);
+    free (count_in_node);
+    free (domain_in_node);
+    return ret;
+}
+
+int mca_fcoll_vulcan_adaptive_init (ompio_file_t *fh)
+{
+    mca_fcoll_vulcan_adaptive_t *ad;
+
+    if (0 >= mca_fcoll_vulcan_adaptive_probes) {
+        return OMPI_SUCCESS;
+    }
+
+    ad = (mca_fcoll_vulcan_adaptive_t *) calloc (1, sizeof(mca_fcoll_vulcan_adaptive_t));
+    if (NULL == ad) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+    ad->node_of   = (int *) malloc (fh->f_size * sizeof(int));
+    ad->domain_of = (int *) malloc (fh->f_size * sizeof(int));
+    ad->busy      = (bool *) calloc (fh->f_size, sizeof(bool));
+    ad->aggr_list = (int *) malloc (fh->f_size * sizeof(int));
+    if (NULL == ad->node_of || NULL == ad->domain_of || NULL == ad->busy ||
+        NULL == ad->aggr_list) {
+        fh->f_fcoll_data = ad;
+        mca_fcoll_vulcan_adaptive_fini (fh);
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+    /* the topology is discovered by the first collective operation */
+    ad->node_of[0] = -1;
+
+    fh->f_fcoll_data = ad;
+    return OMPI_SUCCESS;
+}
+
+void mca_fcoll_vulcan_adaptive_fini (ompio_file_t *fh)
+{
+    mca_fcoll_vulcan_adaptive_t *ad = (mca_fcoll_vulcan_adaptive_t *) fh->f_fcoll_data;
+
+    if (NULL == ad) {
+        return;
+    }
+
+    free (ad->node_of);
+    free (ad->domain_of);
+    free (ad->busy);
+    free (ad->aggr_list);
+    free (ad);
+    fh->f_fcoll_data = NULL;
+}
+
+/*
+ * Called collectively after mca_fcoll_vulcan_get_configuration(). Unless
+ * the user fixed the number of aggregators, replaces the aggregator list
+ * with the one of the current probe (if probe is true and probing is not
+ * over) or with the final layout.
+ */
+int mca_fcoll_vulcan_adaptive_configure (ompio_file_t *fh, int num_io_procs, bool probe)
+{
+    mca_fcoll_vulcan_adaptive_t *ad = (mca_fcoll_vulcan_adaptive_t *) fh->f_fcoll_data;
+    int *aggr_list, ret;
+
+    if (NULL == ad) {
+        return OMPI_SUCCESS;
+    }
+    ad->probing = false;
+    if (-1 != num_io_procs || (!ad->settled && !probe)) {
+        return OMPI_SUCCESS;
+    }
+
+    if (!ad->settled) {
+        if (-1 == ad->node_of[0]) {
+            ret = adaptive_discover_topology (fh, ad);
+            if (OMPI_SUCCESS != ret) {
+                return ret;
+            }
+        }
+        ad->probe_num_aggrs = adaptive_probe_count (fh, fh->f_num_aggrs, ad->probes_done);
+        ret = adaptive_place (fh, ad, ad->probe_num_aggrs);
+        if (OMPI_SUCCESS != ret) {
+            return ret;
+        }
+        ad->probing    = true;
+        ad->start_time = MPI_Wtime();
+    }
+
+    aggr_list = (int *) malloc (ad->num_aggrs * sizeof(int));
+    if (NULL == aggr_list) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+    memcpy (aggr_list, ad->aggr_list, ad->num_aggrs * sizeof(int));
+    free (fh->f_aggr_list);
+    fh->f_aggr_list = aggr_list;
+    fh->f_num_aggrs = ad->num_aggrs;
+
+    return OMPI_SUCCESS;
+}
+
+/* Cycles that end on a stripe boundary keep an aggregator's writes from
+ * straddling two storage targets */
+size_t mca_fcoll_vulcan_adaptive_cycle_size (ompio_file_t *fh, size_t bytes_per_cycle)
+{
+    if (NULL == fh->f_fcoll_data || 0 == fh->f_stripe_size ||
+        bytes_per_cycle <= fh->f_stripe_size) {
+        return bytes_per_cycle;
+    }
+
+    return (bytes_per_cycle / fh->f_stripe_size) * fh->f_stripe_size;
+}
+
+/*
+ * Called collectively at the end of a probe, with the number of bytes
+ * this process wrote as an aggregator and the time it took (both 0 if it
+ * is not an aggregator).
+ */
+int mca_fcoll_vulcan_adaptive_record (ompio_file_t *fh, double io_bytes, double io_time)
+{
+    mca_fcoll_vulcan_adaptive_t *ad = (mca_fcoll_vulcan_adaptive_t *) fh->f_fcoll_data;
+    double local[3], *all = NULL, *aggr_bw = NULL;
+    double total_bytes = 0.0, max_time = 0.0, bw, median;
+    bool *busy_domain = NULL;
+    int i, num_bw = 0, ret;
+
+    if (NULL == ad || !ad->probing) {
+        return OMPI_SUCCESS;
+    }
+    ad->probing = false;
+
+    local[0] = io_bytes;
+    local[1] = io_time;
+    local[2] = MPI_Wtime() - ad->start_time;
+
+    all = (double *) malloc (3 * fh->f_size * sizeof(double));
+    aggr_bw = (double *) malloc (fh->f_size * sizeof(double));
+    busy_domain = (bool *) calloc (fh->f_size, sizeof(bool));
+    if (NULL == all || NULL == aggr_bw || NULL == busy_domain) {
+        ret = OMPI_ERR_OUT_OF_RESOURCE;
+        goto exit;
+    }
+    ret = fh->f_comm->c_coll->coll_allgather (local, 3, MPI_DOUBLE, all, 3, MPI_DOUBLE, fh->f_comm,
+                                              fh->f_comm->c_coll->coll_allgather_module);
+    if (OMPI_SUCCESS != ret) {
+        goto exit;
+    }
+
+    for (i = 0; i < fh->f_size; i++) {
+        total_bytes += all[3*i];
+        if (all[3*i+2] > max_time) {
+            max_time = all[3*i+2];
+        }
+        if (0.0 < all[3*i] && 0.0 < all[3*i+1]) {
+            aggr_bw[num_bw++] = all[3*i] / all[3*i+1];
+        }
+    }
+
+    bw = (0.0 < max_time) ? total_bytes / max_time : 0.0;
+    if (0 == ad->probes_done || bw > ad->best_bw) {
+        ad->best_bw        = bw;
+        ad->best_num_aggrs = ad->probe_num_aggrs;
+    }
+
+    /* Mark the domains of the aggregators that fell behind */
+    if (0 < num_bw) {
+        qsort (aggr_bw, num_bw, sizeof(double), adaptive_double_cmp);
+        median = aggr_bw[num_bw / 2];
+        for (i = 0; i < fh->f_size; i++) {
+            if (0.0 < all[3*i] && 0.0 < all[3*i+1] && all[3*i] / all[3*i+1] < 0.5 * median) {
+                busy_domain[ad->domain_of[i]] = true;
+            }
+        }
+        for (i = 0; i < fh->f_size; i++) {
+            ad->busy[i] = busy_domain[ad->domain_of[i]];
+        }
+    }
+
+    opal_output_verbose(10, ompi_fcoll_base_framework.framework_output,
+                        "vulcan adaptive: probe %d with %d aggregators achieved %.2f MB/s\n",
+                        ad->probes_done, ad->probe_num_aggrs, bw / (1024.0 * 1024.0));
+
+    if (++ad->probes_done >= mca_fcoll_vulcan_adaptive_probes) {
+        ret = adaptive_place (fh, ad, ad->best_num_aggrs);
+        if (OMPI_SUCCESS != ret) {
+            goto exit;
+        }
+        ad->settled = true;
+        opal_output_verbose(10, ompi_fcoll_base_framework.framework_output,
+                            "vulcan adaptive: using %d aggregators (%.2f MB/s)\n",
+                            ad->num_aggrs, ad->best_bw / (1024.0 * 1024.0));
+    }
+
+exit:
+    free (all);
+    free (aggr_bw);
+    free (busy_domain);
+    return ret;
+}
+
+/*
+ * Performance variables, bound to MPI_File handles
+ */
+
+static mca_fcoll_vulcan_adaptive_t *adaptive_lookup (void *obj_handle)
+{
+    ompi_file_t *file = (ompi_file_t *) obj_handle;
+    ompio_file_t *fh;
+
+    if (NULL == file || NULL == file->f_io_selected_data ||
+        0 != strcmp (file->f_io_selected_component.v3_0_0.io_version.mca_component_name, "ompio")) {
+        return NULL;
+    }
+    fh = &((mca_common_ompio_data_t *) file->f_io_selected_data)->ompio_fh;
+    if (fh->f_fcoll_component != (mca_base_component_t *) &mca_fcoll_vulcan_component) {
+        return NULL;
+    }
+
+    return (mca_fcoll_vulcan_adaptive_t *) fh->f_fcoll_data;
+}
+
+static int adaptive_file_size_notify (mca_base_pvar_t *pvar, mca_base_pvar_event_t event,
+                                      void *obj_handle, int *count)
+{
+    if (MCA_BASE_PVAR_HANDLE_BIND == event) {
+        /* one value per process of the file's communicator */
+        *count = ompi_comm_size (((ompi_file_t *) obj_handle)->f_comm);
+    }
+
+    return OMPI_SUCCESS;
+}
+
+static int adaptive_get_num_aggrs (const struct mca_base_pvar_t *pvar, void *value, void *obj_handle)
+{
+    mca_fcoll_vulcan_adaptive_t *ad = adaptive_lookup (obj_handle);
+
+    *(unsigned *) value = (NULL != ad && ad->settled) ? (unsigned) ad->num_aggrs : 0;
+    return OMPI_SUCCESS;
+}
+
+static int adaptive_get_layout (const struct mca_base_pvar_t *pvar, void *value, void *obj_handle)
+{
+    mca_fcoll_vulcan_adaptive_t *ad = adaptive_lookup (obj_handle);
+    int size = ompi_comm_size (((ompi_file_t *) obj_handle)->f_comm);
+    int *values = (int *) value;
+
+    memset (values, 0, size * sizeof(int));
+    if (NULL != ad && ad->settled) {
+        for (int i = 0; i < ad->num_aggrs; i++) {
+            values[ad->aggr_list[i]] = 1;
+        }
+    }
+
+    return OMPI_SUCCESS;
+}
+
+static int adaptive_get_bandwidth (const struct mca_base_pvar_t *pvar, void *value, void *obj_handle)
+{
+    mca_fcoll_vulcan_adaptive_t *ad = adaptive_lookup (obj_handle);
+
+    *(double *) value = (NULL != ad) ? ad->best_bw : 0.0;
+    return OMPI_SUCCESS;
+}
+
+void mca_fcoll_vulcan_adaptive_register_pvars (void)
+{
+    (void) mca_base_component_pvar_register (&mca_fcoll_vulcan_component.fcollm_version,
+                                             "adaptive_num_aggregators", "Number of aggregators chosen "
+                                             "for the current view of a file by the adaptive mode "
+                                             "(0 while it is still probing)",
+                                             OPAL_INFO_LVL_4, MCA_BASE_PVAR_CLASS_SIZE,
+                                             MCA_BASE_VAR_TYPE_UNSIGNED_INT, NULL, MCA_BASE_VAR_BIND_MPI_FILE,
+                                             MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                             adaptive_get_num_aggrs, NULL, NULL, NULL);
+
+    (void) mca_base_component_pvar_register (&mca_fcoll_vulcan_component.fcollm_version,
+                                             "adaptive_layout", "For each process of the communicator "
+                                             "of a file, 1 if it is one of the aggregators chosen by "
+                                             "the adaptive mode, 0 otherwise",
+                                             OPAL_INFO_LVL_4, MCA_BASE_PVAR_CLASS_STATE,
+                                             MCA_BASE_VAR_TYPE_INT, NULL, MCA_BASE_VAR_BIND_MPI_FILE,
+                                             MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                             adaptive_get_layout, NULL, adaptive_file_size_notify, NULL);
+
+    (void) mca_base_component_pvar_register (&mca_fcoll_vulcan_component.fcollm_version,
+                                             "adaptive_bandwidth", "Best bandwidth in bytes per second "
+                                             "achieved by the collective writes probing the aggregator "
+                                             "count of a file",
+                                             OPAL_INFO_LVL_4, MCA_BASE_PVAR_CLASS_HIGHWATERMARK,
+                                             MCA_BASE_VAR_TYPE_DOUBLE, NULL, MCA_BASE_VAR_BIND_MPI_FILE,
+                                             MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                             adaptive_get_bandwidth, NULL, NULL, NULL);
+}
@@ -32,6 +32,7 @@
 
 #include "ompi_config.h"
 #include "fcoll_vulcan.h"
+#include "fcoll_vulcan_internal.h"
 #include "mpi.h"
 
 /*
@@ -45,6 +46,7 @@ const char *mca_fcoll_vulcan_component_version_string =
  */
 int mca_fcoll_vulcan_priority = 10;
 int mca_fcoll_vulcan_async_io = 0;
+int mca_fcoll_vulcan_adaptive_probes = 0;
 
 /*
  * Local function
@@ -99,5 +101,19 @@ vulcan_register(void)
                                            OPAL_INFO_LVL_9,
                                            MCA_BASE_VAR_SCOPE_READONLY, &mca_fcoll_vulcan_async_io);
 
+    mca_fcoll_vulcan_adaptive_probes = 0;
+    (void) mca_base_component_var_register(&mca_fcoll_vulcan_component.fcollm_version,
+                                           "adaptive_probes", "Number of collective writes on a file view "
+                                           "used to measure the bandwidth achieved with different numbers "
+                                           "of aggregators, before settling on the best one and on a "
+                                           "NUMA-aware placement for the subsequent operations. Only used "
+                                           "if the number of aggregators is not set explicitly. "
+                                           "0: disabled (default), 3 is a good starting point.",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY, &mca_fcoll_vulcan_adaptive_probes);
+
+    mca_fcoll_vulcan_adaptive_register_pvars ();
+
     return OMPI_SUCCESS;
 }
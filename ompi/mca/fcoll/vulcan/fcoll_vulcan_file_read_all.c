@@ -117,6 +117,7 @@ int mca_fcoll_vulcan_file_read_all (struct ompio_file_t *fh,
     /* since we want to overlap 2 iterations, define the bytes_per_cycle to be half of what
        the user requested */
     bytes_per_cycle = bytes_per_cycle/2;
+    bytes_per_cycle = (int) mca_fcoll_vulcan_adaptive_cycle_size (fh, bytes_per_cycle);
 
     /**************************************************************************
      ** 1. Decode user buffer into an iovec
@@ -137,6 +138,11 @@ int mca_fcoll_vulcan_file_read_all (struct ompio_file_t *fh,
     if (OMPI_SUCCESS != ret){
         goto exit;
     }
+    /* Reads do not probe, but use the layout found by the writes */
+    ret = mca_fcoll_vulcan_adaptive_configure (fh, vulcan_num_io_procs, false);
+    if (OMPI_SUCCESS != ret){
+        goto exit;
+    }
     opal_output_verbose(10, ompi_fcoll_base_framework.framework_output,
                         "Using %d aggregators for the read_all operation \n", fh->f_num_aggrs);
 
@@ -416,6 +422,12 @@ int mca_fcoll_vulcan_file_read_all (struct ompio_file_t *fh,
                     ret = OMPI_ERR_OUT_OF_RESOURCE;
                     goto exit;
                 }
+                /* The buffers are reused for every cycle; let the fbtl
+                 * pin them if it can do I/O on registered memory */
+                if (NULL != fh->f_fbtl->fbtl_register_buf) {
+                    fh->f_fbtl->fbtl_register_buf (fh, aggr_data[i]->global_buf, bytes_per_cycle);
+                    fh->f_fbtl->fbtl_register_buf (fh, aggr_data[i]->prev_global_buf, bytes_per_cycle);
+                }
             }
 
             aggr_data[i]->recvtype = (ompi_datatype_t **) malloc (fh->f_procs_per_group  *
@@ -588,6 +600,10 @@ exit :
                     opal_accelerator.mem_release(MCA_ACCELERATOR_NO_DEVICE_ID, aggr_data[i]->global_buf);
                     opal_accelerator.mem_release(MCA_ACCELERATOR_NO_DEVICE_ID, aggr_data[i]->prev_global_buf);
                 } else {
+                    if (NULL != fh->f_fbtl->fbtl_deregister_buf) {
+                        fh->f_fbtl->fbtl_deregister_buf (fh, aggr_data[i]->global_buf);
+                        fh->f_fbtl->fbtl_deregister_buf (fh, aggr_data[i]->prev_global_buf);
+                    }
                     free (aggr_data[i]->global_buf);
                     free (aggr_data[i]->prev_global_buf);
                 }
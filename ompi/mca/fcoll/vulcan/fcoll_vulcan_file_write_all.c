@@ -72,6 +72,8 @@ int mca_fcoll_vulcan_file_write_all (struct ompio_file_t *fh,
     ompi_request_t **reqs = NULL;
     ompi_request_t *req_iwrite = MPI_REQUEST_NULL;
     mca_io_ompio_aggregator_data **aggr_data=NULL;
+    mca_fcoll_vulcan_adaptive_t *adaptive = (mca_fcoll_vulcan_adaptive_t *) fh->f_fcoll_data;
+    double start_io_time = 0.0;
     
     ptrdiff_t *displs = NULL;
     int vulcan_num_io_procs;
@@ -124,6 +126,7 @@ int mca_fcoll_vulcan_file_write_all (struct ompio_file_t *fh,
     /* since we want to overlap 2 iterations, define the bytes_per_cycle to be half of what
        the user requested */
     bytes_per_cycle =bytes_per_cycle/2;
+    bytes_per_cycle = (int) mca_fcoll_vulcan_adaptive_cycle_size (fh, bytes_per_cycle);
     
     ret =   mca_common_ompio_decode_datatype ((struct ompio_file_t *) fh,
                                               datatype,
@@ -145,6 +148,10 @@ int mca_fcoll_vulcan_file_write_all (struct ompio_file_t *fh,
     if (OMPI_SUCCESS != ret){
         goto exit;
     }
+    ret = mca_fcoll_vulcan_adaptive_configure (fh, vulcan_num_io_procs, true);
+    if (OMPI_SUCCESS != ret){
+        goto exit;
+    }
     opal_output_verbose(10, ompi_fcoll_base_framework.framework_output,
         "Using %d aggregators for the write_all operation \n", fh->f_num_aggrs);
 
@@ -428,6 +435,12 @@ int mca_fcoll_vulcan_file_write_all (struct ompio_file_t *fh,
                     ret = OMPI_ERR_OUT_OF_RESOURCE;
                     goto exit;
                 }
+                /* The buffers are reused for every cycle; let the fbtl
+                 * pin them if it can do I/O on registered memory */
+                if (NULL != fh->f_fbtl->fbtl_register_buf) {
+                    fh->f_fbtl->fbtl_register_buf (fh, aggr_data[i]->global_buf, bytes_per_cycle);
+                    fh->f_fbtl->fbtl_register_buf (fh, aggr_data[i]->prev_global_buf, bytes_per_cycle);
+                }
             }
         
             aggr_data[i]->recvtype = (ompi_datatype_t **) malloc (fh->f_procs_per_group  * 
@@ -463,6 +476,7 @@ int mca_fcoll_vulcan_file_write_all (struct ompio_file_t *fh,
             l++;
         }
     }
+    start_io_time = MPI_Wtime();
 
     // In fact it should be: if ((1 == mca_fcoll_vulcan_async_io) && (NULL != fh->f_fbtl->fbtl_ipwritev))
     // But we've already tested that.
@@ -553,6 +567,19 @@ int mca_fcoll_vulcan_file_write_all (struct ompio_file_t *fh,
             }
         }
     }
+
+    if (NULL != adaptive && adaptive->probing) {
+        double io_bytes = 0.0, io_time = 0.0;
+
+        if (NOT_AGGR_INDEX != aggr_index) {
+            io_bytes = (double) aggr_data[aggr_index]->total_bytes;
+            io_time  = MPI_Wtime() - start_io_time;
+        }
+        ret = mca_fcoll_vulcan_adaptive_record (fh, io_bytes, io_time);
+        if (OMPI_SUCCESS != ret){
+            goto exit;
+        }
+    }
         
 #if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
     end_exch = MPI_Wtime();
@@ -596,6 +623,10 @@ exit :
                     opal_accelerator.mem_release(MCA_ACCELERATOR_NO_DEVICE_ID, aggr_data[i]->global_buf);
                     opal_accelerator.mem_release(MCA_ACCELERATOR_NO_DEVICE_ID, aggr_data[i]->prev_global_buf);
                 } else {
+                    if (NULL != fh->f_fbtl->fbtl_deregister_buf) {
+                        fh->f_fbtl->fbtl_deregister_buf (fh, aggr_data[i]->global_buf);
+                        fh->f_fbtl->fbtl_deregister_buf (fh, aggr_data[i]->prev_global_buf);
+                    }
                     free (aggr_data[i]->global_buf);
                     free (aggr_data[i]->prev_global_buf);
                 }
@@ -42,6 +42,31 @@ typedef struct mca_io_ompio_aggregator_data {
 } mca_io_ompio_aggregator_data;
 
 
+/* Per-file state of the adaptive aggregator selection, hung off
+ * ompio_file_t::f_fcoll_data. The first collective writes on a view are
+ * probes with different aggregator counts; the count that achieved the
+ * highest bandwidth is used from then on. */
+typedef struct mca_fcoll_vulcan_adaptive_t {
+    int     probes_done;      /* number of probe calls completed */
+    int     probe_num_aggrs;  /* aggregator count of the current probe */
+    bool    settled;          /* probing is over, num_aggrs/aggr_list are final */
+    double  best_bw;          /* best bandwidth achieved so far, bytes/s */
+    int     best_num_aggrs;
+    /* Topology, for each rank of the file communicator: the lowest rank
+     * on the same node and in the same NUMA domain */
+    int    *node_of;
+    int    *domain_of;
+    /* Ranks whose NUMA domain showed less than half the median
+     * aggregator bandwidth in the last probe */
+    bool   *busy;
+    /* Current layout */
+    int     num_aggrs;
+    int    *aggr_list;
+    /* The current call is a probe; it started at start_time */
+    bool    probing;
+    double  start_time;
+} mca_fcoll_vulcan_adaptive_t;
+
 #define SWAP_REQUESTS(_r1,_r2) { \
     ompi_request_t **_t=_r1;     \
     _r1=_r2;                     \
@@ -73,6 +98,13 @@ int mca_fcoll_vulcan_break_file_view (struct iovec *decoded_iov, int iov_count,
 int mca_fcoll_vulcan_get_configuration (ompio_file_t *fh, int num_io_procs,
                                         size_t max_data);
 
+int mca_fcoll_vulcan_adaptive_init (ompio_file_t *fh);
+void mca_fcoll_vulcan_adaptive_fini (ompio_file_t *fh);
+int mca_fcoll_vulcan_adaptive_configure (ompio_file_t *fh, int num_io_procs, bool probe);
+size_t mca_fcoll_vulcan_adaptive_cycle_size (ompio_file_t *fh, size_t bytes_per_cycle);
+int mca_fcoll_vulcan_adaptive_record (ompio_file_t *fh, double io_bytes, double io_time);
+void mca_fcoll_vulcan_adaptive_register_pvars (void);
+
 int mca_fcoll_vulcan_minmax (ompio_file_t *fh, struct iovec *iov, int iov_count,
 			     int num_aggregators, long *new_stripe_size);
 
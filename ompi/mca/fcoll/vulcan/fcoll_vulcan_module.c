@@ -23,6 +23,7 @@
 
 #include "ompi_config.h"
 #include "fcoll_vulcan.h"
+#include "fcoll_vulcan_internal.h"
 
 #include <stdio.h>
 
@@ -84,11 +85,12 @@ int mca_fcoll_vulcan_component_file_unquery (ompio_file_t *file)
 
 int mca_fcoll_vulcan_module_init (ompio_file_t *file)
 {
-    return OMPI_SUCCESS;
+    return mca_fcoll_vulcan_adaptive_init (file);
 }
 
 
 int mca_fcoll_vulcan_module_finalize (ompio_file_t *file)
 {
+    mca_fcoll_vulcan_adaptive_fini (file);
     return OMPI_SUCCESS;
 }
@@ -21,6 +21,7 @@
 #include "ompi/op/op.h"
 #include "ompi/mca/op/op.h"
 #include "ompi/mca/op/base/base.h"
+#include "ompi/mca/op/base/functions.h"
 #include "ompi/mca/op/avx/op_avx.h"
 
 #include <immintrin.h>
@@ -751,6 +752,484 @@ static void OP_CONCAT(ompi_op_avx_2buff_##op##_double,PREPEND)(const void *_in,
     // not defined - OP_AVX_FLOAT_FUNC(xor)
     // not defined - OP_AVX_DOUBLE_FUNC(xor)
 
+/*
+ * The logical and the MAXLOC/MINLOC kernels below depend on 256-bit integer
+ * support, so they are only generated by the AVX2 and AVX512 flavors of this
+ * file. Everywhere else the op/base implementations are used instead.
+ */
+#if defined(GENERATE_AVX2_CODE) || defined(GENERATE_AVX512_CODE)
+#define OP_AVX_GENERATE_LOC_LOGICAL 1
+#endif
+
+/*
+ *  This macro is for logical operations (out op in).
+ *
+ *  Support ops: land, lor, lxor for signed/unsigned 8,16,32,64
+ *
+ *  Each element is turned into a truth value (non-zero or not) and the
+ *  result is stored as 0 or 1, matching the op/base implementation.
+ */
+#define OP_AVX_AVX512_LOGICAL_land(a, b) ((a) & (b))
+#define OP_AVX_AVX512_LOGICAL_lor(a, b)  ((a) | (b))
+#define OP_AVX_AVX512_LOGICAL_lxor(a, b) ((a) ^ (b))
+
+/* a and b are set for the elements equal to 0 */
+#define OP_AVX_AVX2_LOGICAL_land(a, b, one) _mm256_andnot_si256(_mm256_or_si256((a), (b)), (one))
+#define OP_AVX_AVX2_LOGICAL_lor(a, b, one)  _mm256_andnot_si256(_mm256_and_si256((a), (b)), (one))
+#define OP_AVX_AVX2_LOGICAL_lxor(a, b, one) _mm256_and_si256(_mm256_xor_si256((a), (b)), (one))
+
+#if defined(GENERATE_AVX512_CODE) && defined(OMPI_MCA_OP_HAVE_AVX512) && (1 == OMPI_MCA_OP_HAVE_AVX512)
+#if __AVX512F__ && __AVX512BW__
+#define OP_AVX_AVX512_LOGICAL_FUNC(name, type_size, type)               \
+    if( OMPI_OP_AVX_HAS_FLAGS(OMPI_OP_AVX_HAS_AVX512F_FLAG|OMPI_OP_AVX_HAS_AVX512BW_FLAG) ) { \
+        __m512i one = _mm512_set1_epi##type_size(1);                    \
+        types_per_step = (512 / 8) / sizeof(type);                      \
+        for (; left_over >= types_per_step; left_over -= types_per_step) { \
+            __m512i vecA = _mm512_loadu_si512((__m512i*)in);            \
+            in += types_per_step;                                       \
+            __m512i vecB = _mm512_loadu_si512((__m512i*)out);           \
+            uint64_t maskA = _mm512_test_epi##type_size##_mask(vecA, vecA); \
+            uint64_t maskB = _mm512_test_epi##type_size##_mask(vecB, vecB); \
+            __m512i res = _mm512_maskz_mov_epi##type_size(OP_AVX_AVX512_LOGICAL_##name(maskA, maskB), one); \
+            _mm512_storeu_si512((__m512i*)out, res);                    \
+            out += types_per_step;                                      \
+        }                                                               \
+        if( 0 == left_over ) return;                                    \
+    }
+#else
+#error Target architecture lacks AVX512F and AVX512BW support needed for _mm512_test_epi8_mask and _mm512_maskz_mov_epi8
+#endif  /* __AVX512F__ && __AVX512BW__ */
+#else
+#define OP_AVX_AVX512_LOGICAL_FUNC(name, type_size, type) {}
+#endif  /* defined(OMPI_MCA_OP_HAVE_AVX512) && (1 == OMPI_MCA_OP_HAVE_AVX512) */
+
+#if defined(GENERATE_AVX2_CODE) && defined(OMPI_MCA_OP_HAVE_AVX2) && (1 == OMPI_MCA_OP_HAVE_AVX2)
+#if __AVX2__
+#define OP_AVX_AVX2_LOGICAL_FUNC(name, type_size, type)                 \
+    if( OMPI_OP_AVX_HAS_FLAGS(OMPI_OP_AVX_HAS_AVX2_FLAG | OMPI_OP_AVX_HAS_AVX_FLAG) ) { \
+        __m256i zero = _mm256_setzero_si256();                          \
+        __m256i one = _mm256_sub_epi##type_size(zero, _mm256_cmpeq_epi##type_size(zero, zero)); \
+        types_per_step = (256 / 8) / sizeof(type);                      \
+        for( ; left_over >= types_per_step; left_over -= types_per_step ) { \
+            __m256i vecA = _mm256_loadu_si256((__m256i*)in);            \
+            in += types_per_step;                                       \
+            __m256i vecB = _mm256_loadu_si256((__m256i*)out);           \
+            __m256i zeroA = _mm256_cmpeq_epi##type_size(vecA, zero);    \
+            __m256i zeroB = _mm256_cmpeq_epi##type_size(vecB, zero);    \
+            __m256i res = OP_AVX_AVX2_LOGICAL_##name(zeroA, zeroB, one); \
+            _mm256_storeu_si256((__m256i*)out, res);                    \
+            out += types_per_step;                                      \
+        }                                                               \
+        if( 0 == left_over ) return;                                    \
+    }
+#else
+#error Target architecture lacks AVX2 support needed for _mm256_cmpeq_epi8 and _mm256_sub_epi8
+#endif  /* __AVX2__ */
+#else
+#define OP_AVX_AVX2_LOGICAL_FUNC(name, type_size, type) {}
+#endif  /* defined(OMPI_MCA_OP_HAVE_AVX2) && (1 == OMPI_MCA_OP_HAVE_AVX2) */
+
+#define OP_AVX_LOGICAL_FUNC(name, type_size, type)                      \
+static void OP_CONCAT(ompi_op_avx_2buff_##name##_##type,PREPEND)(const void *_in, void *_out, int *count, \
+                                                       struct ompi_datatype_t **dtype, \
+                                                       struct ompi_op_base_module_1_0_0_t *module) \
+{                                                                       \
+    int types_per_step, left_over = *count;                             \
+    type *in = (type*)_in, *out = (type*)_out;                          \
+    OP_AVX_AVX512_LOGICAL_FUNC(name, type_size, type);                  \
+    OP_AVX_AVX2_LOGICAL_FUNC(name, type_size, type);                    \
+    while( left_over > 0 ) {                                            \
+        int how_much = (left_over > 8) ? 8 : left_over;                 \
+        switch(how_much) {                                              \
+        case 8: out[7] = current_func(out[7], in[7]);                   \
+        case 7: out[6] = current_func(out[6], in[6]);                   \
+        case 6: out[5] = current_func(out[5], in[5]);                   \
+        case 5: out[4] = current_func(out[4], in[4]);                   \
+        case 4: out[3] = current_func(out[3], in[3]);                   \
+        case 3: out[2] = current_func(out[2], in[2]);                   \
+        case 2: out[1] = current_func(out[1], in[1]);                   \
+        case 1: out[0] = current_func(out[0], in[0]);                   \
+        }                                                               \
+        left_over -= how_much;                                          \
+        out += how_much;                                                \
+        in += how_much;                                                 \
+    }                                                                   \
+}
+
+/*
+ *  This macro is for minloc and maxloc (out op in).
+ *
+ *  Support types: 2int, float_int (32-bit value and index), and
+ *                 double_int (64-bit value, 32-bit index and padding)
+ *
+ *  The pairs are processed in their interleaved (value, index) layout: the
+ *  values are compared in place, the resulting mask is extended from the
+ *  value lane to the whole pair and used to blend the input pairs. Where
+ *  the values are equal the smallest index is kept, as in op/base.
+ *  Unordered comparisons (NaN) keep the pair already in out.
+ */
+typedef struct { int v; int k; } ompi_op_avx_2int_t;
+typedef struct { float v; int k; } ompi_op_avx_float_int_t;
+typedef struct { double v; int k; } ompi_op_avx_double_int_t;
+
+#define OP_AVX_CMP_gt _CMP_GT_OQ
+#define OP_AVX_CMP_lt _CMP_LT_OQ
+#define OP_AVX_CMP_eq _CMP_EQ_OQ
+
+#define OP_AVX_AVX512_CMPINT_gt _MM_CMPINT_NLE
+#define OP_AVX_AVX512_CMPINT_lt _MM_CMPINT_LT
+#define OP_AVX_AVX512_CMPINT_eq _MM_CMPINT_EQ
+
+#define OP_AVX_AVX512_LOC_2int(a, b, cmp) \
+    _mm512_cmp_epi32_mask((a), (b), OP_AVX_AVX512_CMPINT_##cmp)
+#define OP_AVX_AVX512_LOC_float_int(a, b, cmp) \
+    _mm512_cmp_ps_mask(_mm512_castsi512_ps(a), _mm512_castsi512_ps(b), OP_AVX_CMP_##cmp)
+#define OP_AVX_AVX512_LOC_double_int(a, b, cmp) \
+    _mm512_cmp_pd_mask(_mm512_castsi512_pd(a), _mm512_castsi512_pd(b), OP_AVX_CMP_##cmp)
+
+#define OP_AVX_AVX2_CMPINT_gt(a, b) _mm256_cmpgt_epi32((a), (b))
+#define OP_AVX_AVX2_CMPINT_lt(a, b) _mm256_cmpgt_epi32((b), (a))
+#define OP_AVX_AVX2_CMPINT_eq(a, b) _mm256_cmpeq_epi32((a), (b))
+
+#define OP_AVX_AVX2_LOC_2int(a, b, cmp) OP_AVX_AVX2_CMPINT_##cmp(a, b)
+#define OP_AVX_AVX2_LOC_float_int(a, b, cmp) \
+    _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b), OP_AVX_CMP_##cmp))
+#define OP_AVX_AVX2_LOC_double_int(a, b, cmp) \
+    _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b), OP_AVX_CMP_##cmp))
+
+/*
+ * Pairs with a 32-bit value (_32) have the values in the even 32-bit lanes
+ * and the indexes in the odd ones. Pairs with a 64-bit value (_64) have the
+ * values in the even 64-bit lanes, while the odd ones hold the index in
+ * their low half, followed by padding.
+ */
+#if defined(GENERATE_AVX512_CODE) && defined(OMPI_MCA_OP_HAVE_AVX512) && (1 == OMPI_MCA_OP_HAVE_AVX512)
+#if __AVX512F__
+#define OP_AVX_AVX512_LOC_FUNC_32(type_name, cmp)                       \
+    if( OMPI_OP_AVX_HAS_FLAGS(OMPI_OP_AVX_HAS_AVX512F_FLAG) ) {         \
+        types_per_step = (512 / 8) / sizeof(*out);                      \
+        for (; left_over >= types_per_step; left_over -= types_per_step) { \
+            __m512i vecA = _mm512_loadu_si512((__m512i*)in);            \
+            in += types_per_step;                                       \
+            __m512i vecB = _mm512_loadu_si512((__m512i*)out);           \
+            __mmask16 take = OP_AVX_AVX512_LOC_##type_name(vecA, vecB, cmp) & 0x5555; \
+            __mmask16 tie = OP_AVX_AVX512_LOC_##type_name(vecA, vecB, eq) & 0x5555; \
+            __m512i res = _mm512_mask_blend_epi32(take | (take << 1), vecB, vecA); \
+            res = _mm512_mask_min_epi32(res, tie << 1, vecA, vecB);     \
+            _mm512_storeu_si512((__m512i*)out, res);                    \
+            out += types_per_step;                                      \
+        }                                                               \
+        if( 0 == left_over ) return;                                    \
+    }
+#define OP_AVX_AVX512_LOC_FUNC_64(type_name, cmp)                       \
+    if( OMPI_OP_AVX_HAS_FLAGS(OMPI_OP_AVX_HAS_AVX512F_FLAG) ) {         \
+        types_per_step = (512 / 8) / sizeof(*out);                      \
+        for (; left_over >= types_per_step; left_over -= types_per_step) { \
+            __m512i vecA = _mm512_loadu_si512((__m512i*)in);            \
+            in += types_per_step;                                       \
+            __m512i vecB = _mm512_loadu_si512((__m512i*)out);           \
+            __mmask8 take = OP_AVX_AVX512_LOC_##type_name(vecA, vecB, cmp) & 0x55; \
+            __mmask8 tie = OP_AVX_AVX512_LOC_##type_name(vecA, vecB, eq) & 0x55; \
+            __m512i res = _mm512_mask_blend_epi64(take | (take << 1), vecB, vecA); \
+            res = _mm512_mask_blend_epi64(tie << 1, res, _mm512_min_epi32(vecA, vecB)); \
+            _mm512_storeu_si512((__m512i*)out, res);                    \
+            out += types_per_step;                                      \
+        }                                                               \
+        if( 0 == left_over ) return;                                    \
+    }
+#else
+#error Target architecture lacks AVX512F support needed for _mm512_mask_blend_epi32 and _mm512_mask_min_epi32
+#endif  /* __AVX512F__ */
+#else
+#define OP_AVX_AVX512_LOC_FUNC_32(type_name, cmp) {}
+#define OP_AVX_AVX512_LOC_FUNC_64(type_name, cmp) {}
+#endif  /* defined(OMPI_MCA_OP_HAVE_AVX512) && (1 == OMPI_MCA_OP_HAVE_AVX512) */
+
+#if defined(GENERATE_AVX2_CODE) && defined(OMPI_MCA_OP_HAVE_AVX2) && (1 == OMPI_MCA_OP_HAVE_AVX2)
+#if __AVX2__
+#define OP_AVX_AVX2_LOC_FUNC(type_name, cmp, dup, index_lanes)         \
+    if( OMPI_OP_AVX_HAS_FLAGS(OMPI_OP_AVX_HAS_AVX2_FLAG | OMPI_OP_AVX_HAS_AVX_FLAG) ) { \
+        types_per_step = (256 / 8) / sizeof(*out);                      \
+        for( ; left_over >= types_per_step; left_over -= types_per_step ) { \
+            __m256i vecA = _mm256_loadu_si256((__m256i*)in);            \
+            in += types_per_step;                                       \
+            __m256i vecB = _mm256_loadu_si256((__m256i*)out);           \
+            __m256i take = _mm256_shuffle_epi32(OP_AVX_AVX2_LOC_##type_name(vecA, vecB, cmp), dup); \
+            __m256i tie = _mm256_shuffle_epi32(OP_AVX_AVX2_LOC_##type_name(vecA, vecB, eq), dup); \
+            __m256i res = _mm256_blendv_epi8(vecB, vecA, take);         \
+            res = _mm256_blend_epi32(res, _mm256_blendv_epi8(res, _mm256_min_epi32(vecA, vecB), tie), \
+                                     index_lanes);                      \
+            _mm256_storeu_si256((__m256i*)out, res);                    \
+            out += types_per_step;                                      \
+        }                                                               \
+        if( 0 == left_over ) return;                                    \
+    }
+#else
+#error Target architecture lacks AVX2 support needed for _mm256_blendv_epi8 and _mm256_min_epi32
+#endif  /* __AVX2__ */
+#else
+#define OP_AVX_AVX2_LOC_FUNC(type_name, cmp, dup, index_lanes) {}
+#endif  /* defined(OMPI_MCA_OP_HAVE_AVX2) && (1 == OMPI_MCA_OP_HAVE_AVX2) */
+
+/*
+ * The comparison masks are extended from the value lanes to the whole pair
+ * with dup, and index_lanes selects the 32-bit lanes holding the indexes.
+ */
+#define OP_AVX_AVX2_LOC_FUNC_32(type_name, cmp) \
+    OP_AVX_AVX2_LOC_FUNC(type_name, cmp, _MM_SHUFFLE(2, 2, 0, 0), 0xAA)
+#define OP_AVX_AVX2_LOC_FUNC_64(type_name, cmp) \
+    OP_AVX_AVX2_LOC_FUNC(type_name, cmp, _MM_SHUFFLE(1, 0, 1, 0), 0x44)
+
+#define OP_AVX_LOC_FUNC(name, type_name, width, cmp, op)                \
+static void OP_CONCAT(ompi_op_avx_2buff_##name##_##type_name,PREPEND)(const void *_in, void *_out, int *count, \
+                                                       struct ompi_datatype_t **dtype, \
+                                                       struct ompi_op_base_module_1_0_0_t *module) \
+{                                                                       \
+    int types_per_step, left_over = *count;                             \
+    ompi_op_avx_##type_name##_t *in = (ompi_op_avx_##type_name##_t*)_in; \
+    ompi_op_avx_##type_name##_t *out = (ompi_op_avx_##type_name##_t*)_out; \
+    OP_AVX_AVX512_LOC_FUNC_##width(type_name, cmp);                     \
+    OP_AVX_AVX2_LOC_FUNC_##width(type_name, cmp);                       \
+    for( ; left_over > 0; left_over--, in++, out++ ) {                  \
+        if( in->v op out->v ) {                                         \
+            out->v = in->v;                                             \
+            out->k = in->k;                                             \
+        } else if( in->v == out->v ) {                                  \
+            out->k = (out->k < in->k ? out->k : in->k);                 \
+        }                                                               \
+    }                                                                   \
+}
+
+#if defined(OP_AVX_GENERATE_LOC_LOGICAL)
+/*************************************************************************
+ * Logical AND
+ *************************************************************************/
+#undef current_func
+#define current_func(a, b) ((a) && (b))
+    OP_AVX_LOGICAL_FUNC(land, 8,    int8_t)
+    OP_AVX_LOGICAL_FUNC(land, 8,   uint8_t)
+    OP_AVX_LOGICAL_FUNC(land, 16,  int16_t)
+    OP_AVX_LOGICAL_FUNC(land, 16, uint16_t)
+    OP_AVX_LOGICAL_FUNC(land, 32,  int32_t)
+    OP_AVX_LOGICAL_FUNC(land, 32, uint32_t)
+    OP_AVX_LOGICAL_FUNC(land, 64,  int64_t)
+    OP_AVX_LOGICAL_FUNC(land, 64, uint64_t)
+
+/*************************************************************************
+ * Logical OR
+ *************************************************************************/
+#undef current_func
+#define current_func(a, b) ((a) || (b))
+    OP_AVX_LOGICAL_FUNC(lor, 8,    int8_t)
+    OP_AVX_LOGICAL_FUNC(lor, 8,   uint8_t)
+    OP_AVX_LOGICAL_FUNC(lor, 16,  int16_t)
+    OP_AVX_LOGICAL_FUNC(lor, 16, uint16_t)
+    OP_AVX_LOGICAL_FUNC(lor, 32,  int32_t)
+    OP_AVX_LOGICAL_FUNC(lor, 32, uint32_t)
+    OP_AVX_LOGICAL_FUNC(lor, 64,  int64_t)
+    OP_AVX_LOGICAL_FUNC(lor, 64, uint64_t)
+
+/*************************************************************************
+ * Logical XOR
+ *************************************************************************/
+#undef current_func
+#define current_func(a, b) ((a ? 1 : 0) ^ (b ? 1: 0))
+    OP_AVX_LOGICAL_FUNC(lxor, 8,    int8_t)
+    OP_AVX_LOGICAL_FUNC(lxor, 8,   uint8_t)
+    OP_AVX_LOGICAL_FUNC(lxor, 16,  int16_t)
+    OP_AVX_LOGICAL_FUNC(lxor, 16, uint16_t)
+    OP_AVX_LOGICAL_FUNC(lxor, 32,  int32_t)
+    OP_AVX_LOGICAL_FUNC(lxor, 32, uint32_t)
+    OP_AVX_LOGICAL_FUNC(lxor, 64,  int64_t)
+    OP_AVX_LOGICAL_FUNC(lxor, 64, uint64_t)
+
+/*************************************************************************
+ * Max location
+ *************************************************************************/
+    OP_AVX_LOC_FUNC(maxloc, 2int,       32, gt, >)
+    OP_AVX_LOC_FUNC(maxloc, float_int,  32, gt, >)
+    OP_AVX_LOC_FUNC(maxloc, double_int, 64, gt, >)
+
+/*************************************************************************
+ * Min location
+ *************************************************************************/
+    OP_AVX_LOC_FUNC(minloc, 2int,       32, lt, <)
+    OP_AVX_LOC_FUNC(minloc, float_int,  32, lt, <)
+    OP_AVX_LOC_FUNC(minloc, double_int, 64, lt, <)
+#endif  /* defined(OP_AVX_GENERATE_LOC_LOGICAL) */
+
+/*
+ * Half precision (bfloat16 and, when short float is a 2-byte type, IEEE
+ * fp16) kernels, only in the AVX2 and AVX512 flavors of this file.
+ *
+ * The elements are widened to float, combined, and rounded back to
+ * nearest-even. bfloat16 is widened and narrowed with integer shifts, which
+ * only needs AVX512F/AVX2 (no AVX512_BF16). fp16 relies on vcvtph2ps and
+ * vcvtps2ph, which AVX512F provides; the AVX2 flavor does not assume F16C
+ * and leaves fp16 to op/base.
+ *
+ * The vector operations take (out, in) in the same order as the scalar
+ * loop, so that max and min return in when out is not greater (smaller),
+ * including on NaNs and on -0.0/+0.0, as op/base does.
+ */
+#if defined(GENERATE_AVX2_CODE) || defined(GENERATE_AVX512_CODE)
+#define OP_AVX_GENERATE_HALF 1
+#if defined(GENERATE_AVX512_CODE) &&                                            \
+    ((defined(HAVE_SHORT_FLOAT) && SIZEOF_SHORT_FLOAT == 2) ||                  \
+     (!defined(HAVE_SHORT_FLOAT) && defined(HAVE_OPAL_SHORT_FLOAT_T) && SIZEOF_OPAL_SHORT_FLOAT_T == 2))
+#define OP_AVX_GENERATE_FP16 1
+#endif
+#endif
+
+#define OP_AVX_HALF_SCALAR_max(a, b) ((a) > (b) ? (a) : (b))
+#define OP_AVX_HALF_SCALAR_min(a, b) ((a) < (b) ? (a) : (b))
+#define OP_AVX_HALF_SCALAR_add(a, b) ((a) + (b))
+#define OP_AVX_HALF_SCALAR_mul(a, b) ((a) * (b))
+
+#if defined(GENERATE_AVX512_CODE) && defined(OMPI_MCA_OP_HAVE_AVX512) && (1 == OMPI_MCA_OP_HAVE_AVX512)
+#if __AVX512F__ && __AVX512BW__ && __AVX512VL__
+static inline __m512 ompi_op_avx512_widen_bfloat16(__m256i v)
+{
+    return _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_cvtepu16_epi32(v), 16));
+}
+
+static inline __m256i ompi_op_avx512_narrow_bfloat16(__m512 f)
+{
+    __m512i u = _mm512_castps_si512(f);
+    __m512i lsb = _mm512_and_si512(_mm512_srli_epi32(u, 16), _mm512_set1_epi32(1));
+    __m512i r = _mm512_srli_epi32(_mm512_add_epi32(u, _mm512_add_epi32(lsb, _mm512_set1_epi32(0x7fff))), 16);
+    /* keep NaNs quiet instead of rounding them up to infinity */
+    __mmask16 nan = _mm512_cmp_ps_mask(f, f, _CMP_UNORD_Q);
+    r = _mm512_mask_or_epi32(r, nan, _mm512_srli_epi32(u, 16), _mm512_set1_epi32(0x40));
+    return _mm512_cvtepi32_epi16(r);
+}
+
+#if defined(OP_AVX_GENERATE_FP16)
+static inline __m512 ompi_op_avx512_widen_short_float(__m256i v)
+{
+    return _mm512_cvtph_ps(v);
+}
+
+static inline __m256i ompi_op_avx512_narrow_short_float(__m512 f)
+{
+    return _mm512_cvtps_ph(f, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+}
+#endif  /* defined(OP_AVX_GENERATE_FP16) */
+
+/* The remainder is handled with masked loads and stores */
+#define OP_AVX_AVX512_HALF_FUNC(op, type_name)                          \
+    if( OMPI_OP_AVX_HAS_FLAGS(OMPI_OP_AVX_HAS_AVX512F_FLAG|OMPI_OP_AVX_HAS_AVX512BW_FLAG) ) { \
+        types_per_step = (512 / 8) / sizeof(float);                     \
+        for (; left_over >= types_per_step; left_over -= types_per_step) { \
+            __m512 vecA = ompi_op_avx512_widen_##type_name(_mm256_loadu_si256((__m256i*)in)); \
+            __m512 vecB = ompi_op_avx512_widen_##type_name(_mm256_loadu_si256((__m256i*)out)); \
+            in += types_per_step;                                       \
+            __m512 res = _mm512_##op##_ps(vecB, vecA);                  \
+            _mm256_storeu_si256((__m256i*)out, ompi_op_avx512_narrow_##type_name(res)); \
+            out += types_per_step;                                      \
+        }                                                               \
+        if( left_over > 0 ) {                                           \
+            __mmask16 tail = (__mmask16)((1U << left_over) - 1);        \
+            __m512 vecA = ompi_op_avx512_widen_##type_name(_mm256_maskz_loadu_epi16(tail, in)); \
+            __m512 vecB = ompi_op_avx512_widen_##type_name(_mm256_maskz_loadu_epi16(tail, out)); \
+            __m512 res = _mm512_##op##_ps(vecB, vecA);                  \
+            _mm256_mask_storeu_epi16(out, tail, ompi_op_avx512_narrow_##type_name(res)); \
+        }                                                               \
+        return;                                                         \
+    }
+#else
+#error Target architecture lacks AVX512F, AVX512BW and AVX512VL support needed for _mm512_cvtepu16_epi32 and _mm256_maskz_loadu_epi16
+#endif  /* __AVX512F__ && __AVX512BW__ && __AVX512VL__ */
+#else
+#define OP_AVX_AVX512_HALF_FUNC(op, type_name) {}
+#endif  /* defined(OMPI_MCA_OP_HAVE_AVX512) && (1 == OMPI_MCA_OP_HAVE_AVX512) */
+
+#if defined(GENERATE_AVX2_CODE) && defined(OMPI_MCA_OP_HAVE_AVX2) && (1 == OMPI_MCA_OP_HAVE_AVX2)
+#if __AVX2__
+static inline __m256 ompi_op_avx2_widen_bfloat16(__m128i v)
+{
+    return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtepu16_epi32(v), 16));
+}
+
+static inline __m128i ompi_op_avx2_narrow_bfloat16(__m256 f)
+{
+    __m256i u = _mm256_castps_si256(f);
+    __m256i lsb = _mm256_and_si256(_mm256_srli_epi32(u, 16), _mm256_set1_epi32(1));
+    __m256i r = _mm256_srli_epi32(_mm256_add_epi32(u, _mm256_add_epi32(lsb, _mm256_set1_epi32(0x7fff))), 16);
+    /* keep NaNs quiet instead of rounding them up to infinity */
+    __m256i nan = _mm256_castps_si256(_mm256_cmp_ps(f, f, _CMP_UNORD_Q));
+    r = _mm256_blendv_epi8(r, _mm256_or_si256(_mm256_srli_epi32(u, 16), _mm256_set1_epi32(0x40)), nan);
+    /* packus works within 128-bit lanes; gather the two low quadwords */
+    r = _mm256_permute4x64_epi64(_mm256_packus_epi32(r, r), _MM_SHUFFLE(3, 1, 2, 0));
+    return _mm256_castsi256_si128(r);
+}
+
+#define OP_AVX_AVX2_HALF_FUNC_bfloat16(op)                              \
+    if( OMPI_OP_AVX_HAS_FLAGS(OMPI_OP_AVX_HAS_AVX2_FLAG | OMPI_OP_AVX_HAS_AVX_FLAG) ) { \
+        types_per_step = (256 / 8) / sizeof(float);                     \
+        for( ; left_over >= types_per_step; left_over -= types_per_step ) { \
+            __m256 vecA = ompi_op_avx2_widen_bfloat16(_mm_loadu_si128((__m128i*)in)); \
+            __m256 vecB = ompi_op_avx2_widen_bfloat16(_mm_loadu_si128((__m128i*)out)); \
+            in += types_per_step;                                       \
+            __m256 res = _mm256_##op##_ps(vecB, vecA);                  \
+            _mm_storeu_si128((__m128i*)out, ompi_op_avx2_narrow_bfloat16(res)); \
+            out += types_per_step;                                      \
+        }                                                               \
+        if( 0 == left_over ) return;                                    \
+    }
+#else
+#error Target architecture lacks AVX2 support needed for _mm256_cvtepu16_epi32 and _mm256_packus_epi32
+#endif  /* __AVX2__ */
+#else
+#define OP_AVX_AVX2_HALF_FUNC_bfloat16(op) {}
+#endif  /* defined(OMPI_MCA_OP_HAVE_AVX2) && (1 == OMPI_MCA_OP_HAVE_AVX2) */
+#define OP_AVX_AVX2_HALF_FUNC_short_float(op) {}
+
+#define OP_AVX_HALF_FUNC(op, type_name, type, to_float, from_float)     \
+static void OP_CONCAT(ompi_op_avx_2buff_##op##_##type_name,PREPEND)(const void *_in, void *_out, int *count, \
+                                                              struct ompi_datatype_t **dtype, \
+                                                              struct ompi_op_base_module_1_0_0_t *module) \
+{                                                                       \
+    int types_per_step, left_over = *count;                             \
+    type *in = (type*)_in, *out = (type*)_out;                          \
+    OP_AVX_AVX512_HALF_FUNC(op, type_name);                             \
+    OP_AVX_AVX2_HALF_FUNC_##type_name(op);                              \
+    for( ; left_over > 0; left_over--, in++, out++ ) {                  \
+        *out = from_float(OP_AVX_HALF_SCALAR_##op(to_float(*out), to_float(*in))); \
+    }                                                                   \
+}
+
+#if defined(OP_AVX_GENERATE_HALF)
+#define OP_AVX_BFLOAT16_FUNC(op) \
+    OP_AVX_HALF_FUNC(op, bfloat16, uint16_t, ompi_op_base_bfloat16_to_float, ompi_op_base_float_to_bfloat16)
+
+/*************************************************************************
+ * bfloat16
+ *************************************************************************/
+    OP_AVX_BFLOAT16_FUNC(max)
+    OP_AVX_BFLOAT16_FUNC(min)
+    OP_AVX_BFLOAT16_FUNC(add)
+    OP_AVX_BFLOAT16_FUNC(mul)
+#endif  /* defined(OP_AVX_GENERATE_HALF) */
+
+#if defined(OP_AVX_GENERATE_FP16)
+#if defined(HAVE_SHORT_FLOAT)
+typedef short float ompi_op_avx_short_float_t;
+#else
+typedef opal_short_float_t ompi_op_avx_short_float_t;
+#endif
+#define OP_AVX_SHORT_FLOAT_FUNC(op) \
+    OP_AVX_HALF_FUNC(op, short_float, ompi_op_avx_short_float_t, (float), (ompi_op_avx_short_float_t))
+
+/*************************************************************************
+ * short float (fp16)
+ *************************************************************************/
+    OP_AVX_SHORT_FLOAT_FUNC(max)
+    OP_AVX_SHORT_FLOAT_FUNC(min)
+    OP_AVX_SHORT_FLOAT_FUNC(add)
+    OP_AVX_SHORT_FLOAT_FUNC(mul)
+#endif  /* defined(OP_AVX_GENERATE_FP16) */
+
 /*
  *  This is a three buffer (2 input and 1 output) version of the reduction
  *  routines, needed for some optimizations.
@@ -1339,6 +1818,355 @@ static void OP_CONCAT(ompi_op_avx_3buff_##op##_double,PREPEND)(const void *_in1,
     // not defined - OP_AVX_FLOAT_FUNC_3(xor)
     // not defined - OP_AVX_DOUBLE_FUNC_3(xor)
 
+/*
+ *  Three buffer versions of the logical operations (out = in1 op in2).
+ */
+#if defined(GENERATE_AVX512_CODE) && defined(OMPI_MCA_OP_HAVE_AVX512) && (1 == OMPI_MCA_OP_HAVE_AVX512)
+#if __AVX512F__ && __AVX512BW__
+#define OP_AVX_AVX512_LOGICAL_FUNC_3(name, type_size, type)             \
+    if( OMPI_OP_AVX_HAS_FLAGS(OMPI_OP_AVX_HAS_AVX512F_FLAG|OMPI_OP_AVX_HAS_AVX512BW_FLAG) ) { \
+        __m512i one = _mm512_set1_epi##type_size(1);                    \
+        types_per_step = (512 / 8) / sizeof(type);                      \
+        for (; left_over >= types_per_step; left_over -= types_per_step) { \
+            __m512i vecA = _mm512_loadu_si512((__m512i*)in1);           \
+            __m512i vecB = _mm512_loadu_si512((__m512i*)in2);           \
+            in1 += types_per_step;                                      \
+            in2 += types_per_step;                                      \
+            uint64_t maskA = _mm512_test_epi##type_size##_mask(vecA, vecA); \
+            uint64_t maskB = _mm512_test_epi##type_size##_mask(vecB, vecB); \
+            __m512i res = _mm512_maskz_mov_epi##type_size(OP_AVX_AVX512_LOGICAL_##name(maskA, maskB), one); \
+            _mm512_storeu_si512((__m512i*)out, res);                    \
+            out += types_per_step;                                      \
+        }                                                               \
+        if( 0 == left_over ) return;                                    \
+    }
+#else
+#error Target architecture lacks AVX512F and AVX512BW support needed for _mm512_test_epi8_mask and _mm512_maskz_mov_epi8
+#endif  /* __AVX512F__ && __AVX512BW__ */
+#else
+#define OP_AVX_AVX512_LOGICAL_FUNC_3(name, type_size, type) {}
+#endif  /* defined(OMPI_MCA_OP_HAVE_AVX512) && (1 == OMPI_MCA_OP_HAVE_AVX512) */
+
+#if defined(GENERATE_AVX2_CODE) && defined(OMPI_MCA_OP_HAVE_AVX2) && (1 == OMPI_MCA_OP_HAVE_AVX2)
+#if __AVX2__
+#define OP_AVX_AVX2_LOGICAL_FUNC_3(name, type_size, type)               \
+    if( OMPI_OP_AVX_HAS_FLAGS(OMPI_OP_AVX_HAS_AVX2_FLAG | OMPI_OP_AVX_HAS_AVX_FLAG) ) { \
+        __m256i zero = _mm256_setzero_si256();                          \
+        __m256i one = _mm256_sub_epi##type_size(zero, _mm256_cmpeq_epi##type_size(zero, zero)); \
+        types_per_step = (256 / 8) / sizeof(type);                      \
+        for( ; left_over >= types_per_step; left_over -= types_per_step ) { \
+            __m256i vecA = _mm256_loadu_si256((__m256i*)in1);           \
+            __m256i vecB = _mm256_loadu_si256((__m256i*)in2);           \
+            in1 += types_per_step;                                      \
+            in2 += types_per_step;                                      \
+            __m256i zeroA = _mm256_cmpeq_epi##type_size(vecA, zero);    \
+            __m256i zeroB = _mm256_cmpeq_epi##type_size(vecB, zero);    \
+            __m256i res = OP_AVX_AVX2_LOGICAL_##name(zeroA, zeroB, one); \
+            _mm256_storeu_si256((__m256i*)out, res);                    \
+            out += types_per_step;                                      \
+        }                                                               \
+        if( 0 == left_over ) return;                                    \
+    }
+#else
+#error Target architecture lacks AVX2 support needed for _mm256_cmpeq_epi8 and _mm256_sub_epi8
+#endif  /* __AVX2__ */
+#else
+#define OP_AVX_AVX2_LOGICAL_FUNC_3(name, type_size, type) {}
+#endif  /* defined(OMPI_MCA_OP_HAVE_AVX2) && (1 == OMPI_MCA_OP_HAVE_AVX2) */
+
+#define OP_AVX_LOGICAL_FUNC_3(name, type_size, type)                    \
+static void OP_CONCAT(ompi_op_avx_3buff_##name##_##type,PREPEND)(const void *_in1, const void *_in2, \
+                                                               void *_out, int *count, \
+                                                               struct ompi_datatype_t **dtype, \
+                                                               struct ompi_op_base_module_1_0_0_t *module) \
+{                                                                       \
+    int types_per_step, left_over = *count;                             \
+    type *in1 = (type*)_in1, *in2 = (type*)_in2, *out = (type*)_out;    \
+    OP_AVX_AVX512_LOGICAL_FUNC_3(name, type_size, type);                \
+    OP_AVX_AVX2_LOGICAL_FUNC_3(name, type_size, type);                  \
+    while( left_over > 0 ) {                                            \
+        int how_much = (left_over > 8) ? 8 : left_over;                 \
+        switch(how_much) {                                              \
+        case 8: out[7] = current_func(in1[7], in2[7]);                  \
+        case 7: out[6] = current_func(in1[6], in2[6]);                  \
+        case 6: out[5] = current_func(in1[5], in2[5]);                  \
+        case 5: out[4] = current_func(in1[4], in2[4]);                  \
+        case 4: out[3] = current_func(in1[3], in2[3]);                  \
+        case 3: out[2] = current_func(in1[2], in2[2]);                  \
+        case 2: out[1] = current_func(in1[1], in2[1]);                  \
+        case 1: out[0] = current_func(in1[0], in2[0]);                  \
+        }                                                               \
+        left_over -= how_much;                                          \
+        out += how_much;                                                \
+        in1 += how_much;                                                \
+        in2 += how_much;                                                \
+    }                                                                   \
+}
+
+/*
+ *  Three buffer versions of minloc and maxloc (out = in1 op in2). The pair
+ *  from in1 is selected when its value wins or ties, then on ties the index
+ *  is replaced by the smallest one.
+ */
+#if defined(GENERATE_AVX512_CODE) && defined(OMPI_MCA_OP_HAVE_AVX512) && (1 == OMPI_MCA_OP_HAVE_AVX512)
+#if __AVX512F__
+#define OP_AVX_AVX512_LOC_FUNC_3_32(type_name, cmp)                     \
+    if( OMPI_OP_AVX_HAS_FLAGS(OMPI_OP_AVX_HAS_AVX512F_FLAG) ) {         \
+        types_per_step = (512 / 8) / sizeof(*out);                      \
+        for (; left_over >= types_per_step; left_over -= types_per_step) { \
+            __m512i vecA = _mm512_loadu_si512((__m512i*)in1);           \
+            __m512i vecB = _mm512_loadu_si512((__m512i*)in2);           \
+            in1 += types_per_step;                                      \
+            in2 += types_per_step;                                      \
+            __mmask16 tie = OP_AVX_AVX512_LOC_##type_name(vecA, vecB, eq) & 0x5555; \
+            __mmask16 take = (OP_AVX_AVX512_LOC_##type_name(vecA, vecB, cmp) & 0x5555) | tie; \
+            __m512i res = _mm512_mask_blend_epi32(take | (take << 1), vecB, vecA); \
+            res = _mm512_mask_min_epi32(res, tie << 1, vecA, vecB);     \
+            _mm512_storeu_si512((__m512i*)out, res);                    \
+            out += types_per_step;                                      \
+        }                                                               \
+        if( 0 == left_over ) return;                                    \
+    }
+#define OP_AVX_AVX512_LOC_FUNC_3_64(type_name, cmp)                     \
+    if( OMPI_OP_AVX_HAS_FLAGS(OMPI_OP_AVX_HAS_AVX512F_FLAG) ) {         \
+        types_per_step = (512 / 8) / sizeof(*out);                      \
+        for (; left_over >= types_per_step; left_over -= types_per_step) { \
+            __m512i vecA = _mm512_loadu_si512((__m512i*)in1);           \
+            __m512i vecB = _mm512_loadu_si512((__m512i*)in2);           \
+            in1 += types_per_step;                                      \
+            in2 += types_per_step;                                      \
+            __mmask8 tie = OP_AVX_AVX512_LOC_##type_name(vecA, vecB, eq) & 0x55; \
+            __mmask8 take = (OP_AVX_AVX512_LOC_##type_name(vecA, vecB, cmp) & 0x55) | tie; \
+            __m512i res = _mm512_mask_blend_epi64(take | (take << 1), vecB, vecA); \
+            res = _mm512_mask_blend_epi64(tie << 1, res, _mm512_min_epi32(vecA, vecB)); \
+            _mm512_storeu_si512((__m512i*)out, res);                    \
+            out += types_per_step;                                      \
+        }                                                               \
+        if( 0 == left_over ) return;                                    \
+    }
+#else
+#error Target architecture lacks AVX512F support needed for _mm512_mask_blend_epi32 and _mm512_mask_min_epi32
+#endif  /* __AVX512F__ */
+#else
+#define OP_AVX_AVX512_LOC_FUNC_3_32(type_name, cmp) {}
+#define OP_AVX_AVX512_LOC_FUNC_3_64(type_name, cmp) {}
+#endif  /* defined(OMPI_MCA_OP_HAVE_AVX512) && (1 == OMPI_MCA_OP_HAVE_AVX512) */
+
+#if defined(GENERATE_AVX2_CODE) && defined(OMPI_MCA_OP_HAVE_AVX2) && (1 == OMPI_MCA_OP_HAVE_AVX2)
+#if __AVX2__
+#define OP_AVX_AVX2_LOC_FUNC_3(type_name, cmp, dup, index_lanes)       \
+    if( OMPI_OP_AVX_HAS_FLAGS(OMPI_OP_AVX_HAS_AVX2_FLAG | OMPI_OP_AVX_HAS_AVX_FLAG) ) { \
+        types_per_step = (256 / 8) / sizeof(*out);                      \
+        for( ; left_over >= types_per_step; left_over -= types_per_step ) { \
+            __m256i vecA = _mm256_loadu_si256((__m256i*)in1);           \
+            __m256i vecB = _mm256_loadu_si256((__m256i*)in2);           \
+            in1 += types_per_step;                                      \
+            in2 += types_per_step;                                      \
+            __m256i tie = _mm256_shuffle_epi32(OP_AVX_AVX2_LOC_##type_name(vecA, vecB, eq), dup); \
+            __m256i take = _mm256_or_si256(_mm256_shuffle_epi32(OP_AVX_AVX2_LOC_##type_name(vecA, vecB, cmp), \
+                                                                dup), tie); \
+            __m256i res = _mm256_blendv_epi8(vecB, vecA, take);         \
+            res = _mm256_blend_epi32(res, _mm256_blendv_epi8(res, _mm256_min_epi32(vecA, vecB), tie), \
+                                     index_lanes);                      \
+            _mm256_storeu_si256((__m256i*)out, res);                    \
+            out += types_per_step;                                      \
+        }                                                               \
+        if( 0 == left_over ) return;                                    \
+    }
+#else
+#error Target architecture lacks AVX2 support needed for _mm256_blendv_epi8 and _mm256_min_epi32
+#endif  /* __AVX2__ */
+#else
+#define OP_AVX_AVX2_LOC_FUNC_3(type_name, cmp, dup, index_lanes) {}
+#endif  /* defined(OMPI_MCA_OP_HAVE_AVX2) && (1 == OMPI_MCA_OP_HAVE_AVX2) */
+
+#define OP_AVX_AVX2_LOC_FUNC_3_32(type_name, cmp) \
+    OP_AVX_AVX2_LOC_FUNC_3(type_name, cmp, _MM_SHUFFLE(2, 2, 0, 0), 0xAA)
+#define OP_AVX_AVX2_LOC_FUNC_3_64(type_name, cmp) \
+    OP_AVX_AVX2_LOC_FUNC_3(type_name, cmp, _MM_SHUFFLE(1, 0, 1, 0), 0x44)
+
+#define OP_AVX_LOC_FUNC_3(name, type_name, width, cmp, op)              \
+static void OP_CONCAT(ompi_op_avx_3buff_##name##_##type_name,PREPEND)(const void *_in1, const void *_in2, \
+                                                               void *_out, int *count, \
+                                                               struct ompi_datatype_t **dtype, \
+                                                               struct ompi_op_base_module_1_0_0_t *module) \
+{                                                                       \
+    int types_per_step, left_over = *count;                             \
+    ompi_op_avx_##type_name##_t *in1 = (ompi_op_avx_##type_name##_t*)_in1; \
+    ompi_op_avx_##type_name##_t *in2 = (ompi_op_avx_##type_name##_t*)_in2; \
+    ompi_op_avx_##type_name##_t *out = (ompi_op_avx_##type_name##_t*)_out; \
+    OP_AVX_AVX512_LOC_FUNC_3_##width(type_name, cmp);                   \
+    OP_AVX_AVX2_LOC_FUNC_3_##width(type_name, cmp);                     \
+    for( ; left_over > 0; left_over--, in1++, in2++, out++ ) {          \
+        if( in1->v op in2->v ) {                                        \
+            out->v = in1->v;                                            \
+            out->k = in1->k;                                            \
+        } else if( in1->v == in2->v ) {                                 \
+            out->v = in1->v;                                            \
+            out->k = (in2->k < in1->k ? in2->k : in1->k);               \
+        } else {                                                        \
+            out->v = in2->v;                                            \
+            out->k = in2->k;                                            \
+        }                                                               \
+    }                                                                   \
+}
+
+#if defined(OP_AVX_GENERATE_LOC_LOGICAL)
+/*************************************************************************
+ * Logical AND
+ *************************************************************************/
+#undef current_func
+#define current_func(a, b) ((a) && (b))
+    OP_AVX_LOGICAL_FUNC_3(land, 8,    int8_t)
+    OP_AVX_LOGICAL_FUNC_3(land, 8,   uint8_t)
+    OP_AVX_LOGICAL_FUNC_3(land, 16,  int16_t)
+    OP_AVX_LOGICAL_FUNC_3(land, 16, uint16_t)
+    OP_AVX_LOGICAL_FUNC_3(land, 32,  int32_t)
+    OP_AVX_LOGICAL_FUNC_3(land, 32, uint32_t)
+    OP_AVX_LOGICAL_FUNC_3(land, 64,  int64_t)
+    OP_AVX_LOGICAL_FUNC_3(land, 64, uint64_t)
+
+/*************************************************************************
+ * Logical OR
+ *************************************************************************/
+#undef current_func
+#define current_func(a, b) ((a) || (b))
+    OP_AVX_LOGICAL_FUNC_3(lor, 8,    int8_t)
+    OP_AVX_LOGICAL_FUNC_3(lor, 8,   uint8_t)
+    OP_AVX_LOGICAL_FUNC_3(lor, 16,  int16_t)
+    OP_AVX_LOGICAL_FUNC_3(lor, 16, uint16_t)
+    OP_AVX_LOGICAL_FUNC_3(lor, 32,  int32_t)
+    OP_AVX_LOGICAL_FUNC_3(lor, 32, uint32_t)
+    OP_AVX_LOGICAL_FUNC_3(lor, 64,  int64_t)
+    OP_AVX_LOGICAL_FUNC_3(lor, 64, uint64_t)
+
+/*************************************************************************
+ * Logical XOR
+ *************************************************************************/
+#undef current_func
+#define current_func(a, b) ((a ? 1 : 0) ^ (b ? 1: 0))
+    OP_AVX_LOGICAL_FUNC_3(lxor, 8,    int8_t)
+    OP_AVX_LOGICAL_FUNC_3(lxor, 8,   uint8_t)
+    OP_AVX_LOGICAL_FUNC_3(lxor, 16,  int16_t)
+    OP_AVX_LOGICAL_FUNC_3(lxor, 16, uint16_t)
+    OP_AVX_LOGICAL_FUNC_3(lxor, 32,  int32_t)
+    OP_AVX_LOGICAL_FUNC_3(lxor, 32, uint32_t)
+    OP_AVX_LOGICAL_FUNC_3(lxor, 64,  int64_t)
+    OP_AVX_LOGICAL_FUNC_3(lxor, 64, uint64_t)
+
+/*************************************************************************
+ * Max location
+ *************************************************************************/
+    OP_AVX_LOC_FUNC_3(maxloc, 2int,       32, gt, >)
+    OP_AVX_LOC_FUNC_3(maxloc, float_int,  32, gt, >)
+    OP_AVX_LOC_FUNC_3(maxloc, double_int, 64, gt, >)
+
+/*************************************************************************
+ * Min location
+ *************************************************************************/
+    OP_AVX_LOC_FUNC_3(minloc, 2int,       32, lt, <)
+    OP_AVX_LOC_FUNC_3(minloc, float_int,  32, lt, <)
+    OP_AVX_LOC_FUNC_3(minloc, double_int, 64, lt, <)
+#endif  /* defined(OP_AVX_GENERATE_LOC_LOGICAL) */
+
+/*
+ * Half precision kernels (see OP_AVX_HALF_FUNC).
+ */
+#if defined(GENERATE_AVX512_CODE) && defined(OMPI_MCA_OP_HAVE_AVX512) && (1 == OMPI_MCA_OP_HAVE_AVX512)
+#if __AVX512F__ && __AVX512BW__ && __AVX512VL__
+#define OP_AVX_AVX512_HALF_FUNC_3(op, type_name)                        \
+    if( OMPI_OP_AVX_HAS_FLAGS(OMPI_OP_AVX_HAS_AVX512F_FLAG|OMPI_OP_AVX_HAS_AVX512BW_FLAG) ) { \
+        types_per_step = (512 / 8) / sizeof(float);                     \
+        for (; left_over >= types_per_step; left_over -= types_per_step) { \
+            __m512 vecA = ompi_op_avx512_widen_##type_name(_mm256_loadu_si256((__m256i*)in1)); \
+            __m512 vecB = ompi_op_avx512_widen_##type_name(_mm256_loadu_si256((__m256i*)in2)); \
+            in1 += types_per_step;                                      \
+            in2 += types_per_step;                                      \
+            __m512 res = _mm512_##op##_ps(vecA, vecB);                  \
+            _mm256_storeu_si256((__m256i*)out, ompi_op_avx512_narrow_##type_name(res)); \
+            out += types_per_step;                                      \
+        }                                                               \
+        if( left_over > 0 ) {                                           \
+            __mmask16 tail = (__mmask16)((1U << left_over) - 1);        \
+            __m512 vecA = ompi_op_avx512_widen_##type_name(_mm256_maskz_loadu_epi16(tail, in1)); \
+            __m512 vecB = ompi_op_avx512_widen_##type_name(_mm256_maskz_loadu_epi16(tail, in2)); \
+            __m512 res = _mm512_##op##_ps(vecA, vecB);                  \
+            _mm256_mask_storeu_epi16(out, tail, ompi_op_avx512_narrow_##type_name(res)); \
+        }                                                               \
+        return;                                                         \
+    }
+#else
+#error Target architecture lacks AVX512F, AVX512BW and AVX512VL support needed for _mm512_cvtepu16_epi32 and _mm256_maskz_loadu_epi16
+#endif  /* __AVX512F__ && __AVX512BW__ && __AVX512VL__ */
+#else
+#define OP_AVX_AVX512_HALF_FUNC_3(op, type_name) {}
+#endif  /* defined(OMPI_MCA_OP_HAVE_AVX512) && (1 == OMPI_MCA_OP_HAVE_AVX512) */
+
+#if defined(GENERATE_AVX2_CODE) && defined(OMPI_MCA_OP_HAVE_AVX2) && (1 == OMPI_MCA_OP_HAVE_AVX2)
+#if __AVX2__
+#define OP_AVX_AVX2_HALF_FUNC_3_bfloat16(op)                            \
+    if( OMPI_OP_AVX_HAS_FLAGS(OMPI_OP_AVX_HAS_AVX2_FLAG | OMPI_OP_AVX_HAS_AVX_FLAG) ) { \
+        types_per_step = (256 / 8) / sizeof(float);                     \
+        for( ; left_over >= types_per_step; left_over -= types_per_step ) { \
+            __m256 vecA = ompi_op_avx2_widen_bfloat16(_mm_loadu_si128((__m128i*)in1)); \
+            __m256 vecB = ompi_op_avx2_widen_bfloat16(_mm_loadu_si128((__m128i*)in2)); \
+            in1 += types_per_step;                                      \
+            in2 += types_per_step;                                      \
+            __m256 res = _mm256_##op##_ps(vecA, vecB);                  \
+            _mm_storeu_si128((__m128i*)out, ompi_op_avx2_narrow_bfloat16(res)); \
+            out += types_per_step;                                      \
+        }                                                               \
+        if( 0 == left_over ) return;                                    \
+    }
+#else
+#error Target architecture lacks AVX2 support needed for _mm256_cvtepu16_epi32 and _mm256_packus_epi32
+#endif  /* __AVX2__ */
+#else
+#define OP_AVX_AVX2_HALF_FUNC_3_bfloat16(op) {}
+#endif  /* defined(OMPI_MCA_OP_HAVE_AVX2) && (1 == OMPI_MCA_OP_HAVE_AVX2) */
+#define OP_AVX_AVX2_HALF_FUNC_3_short_float(op) {}
+
+#define OP_AVX_HALF_FUNC_3(op, type_name, type, to_float, from_float)   \
+static void OP_CONCAT(ompi_op_avx_3buff_##op##_##type_name,PREPEND)(const void *_in1, const void *_in2, \
+                                                              void *_out, int *count, \
+                                                              struct ompi_datatype_t **dtype, \
+                                                              struct ompi_op_base_module_1_0_0_t *module) \
+{                                                                       \
+    int types_per_step, left_over = *count;                             \
+    type *in1 = (type*)_in1, *in2 = (type*)_in2, *out = (type*)_out;    \
+    OP_AVX_AVX512_HALF_FUNC_3(op, type_name);                           \
+    OP_AVX_AVX2_HALF_FUNC_3_##type_name(op);                            \
+    for( ; left_over > 0; left_over--, in1++, in2++, out++ ) {          \
+        *out = from_float(OP_AVX_HALF_SCALAR_##op(to_float(*in1), to_float(*in2))); \
+    }                                                                   \
+}
+
+#if defined(OP_AVX_GENERATE_HALF)
+#define OP_AVX_BFLOAT16_FUNC_3(op) \
+    OP_AVX_HALF_FUNC_3(op, bfloat16, uint16_t, ompi_op_base_bfloat16_to_float, ompi_op_base_float_to_bfloat16)
+
+/*************************************************************************
+ * bfloat16
+ *************************************************************************/
+    OP_AVX_BFLOAT16_FUNC_3(max)
+    OP_AVX_BFLOAT16_FUNC_3(min)
+    OP_AVX_BFLOAT16_FUNC_3(add)
+    OP_AVX_BFLOAT16_FUNC_3(mul)
+#endif  /* defined(OP_AVX_GENERATE_HALF) */
+
+#if defined(OP_AVX_GENERATE_FP16)
+#define OP_AVX_SHORT_FLOAT_FUNC_3(op) \
+    OP_AVX_HALF_FUNC_3(op, short_float, ompi_op_avx_short_float_t, (float), (ompi_op_avx_short_float_t))
+
+/*************************************************************************
+ * short float (fp16)
+ *************************************************************************/
+    OP_AVX_SHORT_FLOAT_FUNC_3(max)
+    OP_AVX_SHORT_FLOAT_FUNC_3(min)
+    OP_AVX_SHORT_FLOAT_FUNC_3(add)
+    OP_AVX_SHORT_FLOAT_FUNC_3(mul)
+#endif  /* defined(OP_AVX_GENERATE_FP16) */
+
 /** C integer ***********************************************************/
 #define C_INTEGER_8_16_32(name, ftype)                                                         \
     [OMPI_OP_BASE_TYPE_INT8_T]   = OP_CONCAT(ompi_op_avx_##ftype##_##name##_int8_t,PREPEND),   \
@@ -1367,10 +2195,34 @@ static void OP_CONCAT(ompi_op_avx_3buff_##op##_double,PREPEND)(const void *_in1,
 #define FLOAT(name, ftype) OP_CONCAT(ompi_op_avx_##ftype##_##name##_float,PREPEND)
 #define DOUBLE(name, ftype) OP_CONCAT(ompi_op_avx_##ftype##_##name##_double,PREPEND)
 
+#if defined(OP_AVX_GENERATE_FP16)
+#define SHORT_FLOAT(name, ftype) OP_CONCAT(ompi_op_avx_##ftype##_##name##_short_float,PREPEND)
+#else
+#define SHORT_FLOAT(name, ftype) NULL
+#endif
+#if defined(OP_AVX_GENERATE_HALF)
+#define BFLOAT16(name, ftype) OP_CONCAT(ompi_op_avx_##ftype##_##name##_bfloat16,PREPEND)
+#else
+#define BFLOAT16(name, ftype) NULL
+#endif
+
 #define FLOATING_POINT(name, ftype)                                         \
-    [OMPI_OP_BASE_TYPE_SHORT_FLOAT] = NULL,                                 \
+    [OMPI_OP_BASE_TYPE_SHORT_FLOAT] = SHORT_FLOAT(name, ftype),             \
     [OMPI_OP_BASE_TYPE_FLOAT] = FLOAT(name, ftype),                         \
-    [OMPI_OP_BASE_TYPE_DOUBLE] = DOUBLE(name, ftype)
+    [OMPI_OP_BASE_TYPE_DOUBLE] = DOUBLE(name, ftype),                       \
+    [OMPI_OP_BASE_TYPE_BFLOAT16] = BFLOAT16(name, ftype)
+
+/** Logical and MAXLOC/MINLOC, only in the AVX2 and AVX512 flavors ********/
+#if defined(OP_AVX_GENERATE_LOC_LOGICAL)
+#define C_INTEGER_LOGICAL(name, ftype) C_INTEGER(name, ftype)
+#define TWOLOC(name, ftype)                                                                    \
+    [OMPI_OP_BASE_TYPE_FLOAT_INT] = OP_CONCAT(ompi_op_avx_##ftype##_##name##_float_int,PREPEND),   \
+    [OMPI_OP_BASE_TYPE_DOUBLE_INT] = OP_CONCAT(ompi_op_avx_##ftype##_##name##_double_int,PREPEND), \
+    [OMPI_OP_BASE_TYPE_2INT] = OP_CONCAT(ompi_op_avx_##ftype##_##name##_2int,PREPEND)
+#else
+#define C_INTEGER_LOGICAL(name, ftype) NULL
+#define TWOLOC(name, ftype) NULL
+#endif
 
 /*
  * MPI_OP_NULL
@@ -1411,7 +2263,7 @@ ompi_op_base_handler_fn_t OP_CONCAT(ompi_op_avx_functions, PREPEND)[OMPI_OP_BASE
     },
     /* Corresponds to MPI_LAND */
     [OMPI_OP_BASE_FORTRAN_LAND] = {
-        NULL,
+        C_INTEGER_LOGICAL(land, 2buff),
     },
     /* Corresponds to MPI_BAND */
     [OMPI_OP_BASE_FORTRAN_BAND] = {
@@ -1419,7 +2271,7 @@ ompi_op_base_handler_fn_t OP_CONCAT(ompi_op_avx_functions, PREPEND)[OMPI_OP_BASE
     },
     /* Corresponds to MPI_LOR */
     [OMPI_OP_BASE_FORTRAN_LOR] = {
-        NULL,
+        C_INTEGER_LOGICAL(lor, 2buff),
     },
     /* Corresponds to MPI_BOR */
     [OMPI_OP_BASE_FORTRAN_BOR] = {
@@ -1427,12 +2279,20 @@ ompi_op_base_handler_fn_t OP_CONCAT(ompi_op_avx_functions, PREPEND)[OMPI_OP_BASE
     },
     /* Corresponds to MPI_LXOR */
     [OMPI_OP_BASE_FORTRAN_LXOR] = {
-        NULL,
+        C_INTEGER_LOGICAL(lxor, 2buff),
     },
     /* Corresponds to MPI_BXOR */
     [OMPI_OP_BASE_FORTRAN_BXOR] = {
         C_INTEGER(bxor, 2buff),
     },
+    /* Corresponds to MPI_MAXLOC */
+    [OMPI_OP_BASE_FORTRAN_MAXLOC] = {
+        TWOLOC(maxloc, 2buff),
+    },
+    /* Corresponds to MPI_MINLOC */
+    [OMPI_OP_BASE_FORTRAN_MINLOC] = {
+        TWOLOC(minloc, 2buff),
+    },
     /* Corresponds to MPI_REPLACE */
     [OMPI_OP_BASE_FORTRAN_REPLACE] = {
         /* (MPI_ACCUMULATE is handled differently than the other
@@ -1474,7 +2334,7 @@ ompi_op_base_3buff_handler_fn_t OP_CONCAT(ompi_op_avx_3buff_functions, PREPEND)[
     },
     /* Corresponds to MPI_LAND */
     [OMPI_OP_BASE_FORTRAN_LAND] ={
-        NULL,
+        C_INTEGER_LOGICAL(land, 3buff),
     },
     /* Corresponds to MPI_BAND */
     [OMPI_OP_BASE_FORTRAN_BAND] = {
@@ -1482,7 +2342,7 @@ ompi_op_base_3buff_handler_fn_t OP_CONCAT(ompi_op_avx_3buff_functions, PREPEND)[
     },
     /* Corresponds to MPI_LOR */
     [OMPI_OP_BASE_FORTRAN_LOR] = {
-        NULL,
+        C_INTEGER_LOGICAL(lor, 3buff),
     },
     /* Corresponds to MPI_BOR */
     [OMPI_OP_BASE_FORTRAN_BOR] = {
@@ -1490,12 +2350,20 @@ ompi_op_base_3buff_handler_fn_t OP_CONCAT(ompi_op_avx_3buff_functions, PREPEND)[
     },
     /* Corresponds to MPI_LXOR */
     [OMPI_OP_BASE_FORTRAN_LXOR] = {
-        NULL,
+        C_INTEGER_LOGICAL(lxor, 3buff),
     },
     /* Corresponds to MPI_BXOR */
     [OMPI_OP_BASE_FORTRAN_BXOR] = {
         C_INTEGER(xor, 3buff),
     },
+    /* Corresponds to MPI_MAXLOC */
+    [OMPI_OP_BASE_FORTRAN_MAXLOC] = {
+        TWOLOC(maxloc, 3buff),
+    },
+    /* Corresponds to MPI_MINLOC */
+    [OMPI_OP_BASE_FORTRAN_MINLOC] = {
+        TWOLOC(minloc, 3buff),
+    },
     /* Corresponds to MPI_REPLACE */
     [OMPI_OP_BASE_FORTRAN_REPLACE] = {
         /* MPI_ACCUMULATE is handled differently than the other
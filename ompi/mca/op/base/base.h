@@ -93,6 +93,14 @@ int ompi_op_base_op_select(struct ompi_op_t *op);
  */
 OMPI_DECLSPEC int ompi_op_base_op_unselect(struct ompi_op_t *op);
 
+/**
+ * Set up and tear down the helper threads of large local reductions
+ * (see op_base_threads.c). The threads themselves are only started on
+ * first use.
+ */
+int ompi_op_base_reduce_threads_open(void);
+int ompi_op_base_reduce_threads_close(void);
+
 OMPI_DECLSPEC extern mca_base_framework_t ompi_op_base_framework;
 
 END_C_DECLS
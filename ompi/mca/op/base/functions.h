@@ -24,6 +24,10 @@
 #define OMPI_OP_BASE_FUNCTIONS_H
 
 #include "ompi_config.h"
+
+#include <stdint.h>
+#include <string.h>
+
 #include "ompi/mca/op/op.h"
 
 
@@ -38,6 +42,33 @@ OMPI_DECLSPEC extern ompi_op_base_handler_fn_t
 OMPI_DECLSPEC extern ompi_op_base_3buff_handler_fn_t
     ompi_op_base_3buff_functions[OMPI_OP_BASE_FORTRAN_OP_MAX][OMPI_OP_BASE_TYPE_MAX];
 
+/**
+ * bfloat16 <-> float conversions.  A bfloat16 is the upper half of
+ * the bit pattern of a float, so widening is exact; narrowing rounds
+ * to nearest even, and keeps NaNs quiet (rather than letting the
+ * rounding turn them into infinities).
+ */
+static inline float ompi_op_base_bfloat16_to_float(uint16_t v)
+{
+    uint32_t u = (uint32_t) v << 16;
+    float f;
+
+    memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+static inline uint16_t ompi_op_base_float_to_bfloat16(float f)
+{
+    uint32_t u;
+
+    memcpy(&u, &f, sizeof(u));
+    if ((u & 0x7fffffffu) > 0x7f800000u) {
+        return (uint16_t) ((u >> 16) | 0x0040u);
+    }
+    u += 0x7fffu + ((u >> 16) & 1u);
+    return (uint16_t) (u >> 16);
+}
+
 END_C_DECLS
 
 #endif /* OMPI_OP_BASE_FUNCTIONS_H */
@@ -29,6 +29,7 @@
 #include "ompi/constants.h"
 #include "ompi/mca/op/op.h"
 #include "ompi/mca/op/base/base.h"
+#include "ompi/op/op.h"
 
 
 /*
@@ -59,5 +60,50 @@ OBJ_CLASS_INSTANCE(ompi_op_base_module_t, opal_object_t,
 OBJ_CLASS_INSTANCE(ompi_op_base_module_1_0_0_t, opal_object_t,
                    module_constructor_1_0_0, NULL);
 
-MCA_BASE_FRAMEWORK_DECLARE(ompi, op, NULL, NULL, NULL, NULL,
-                           mca_op_base_static_components, 0);
+static int ompi_op_base_register(mca_base_register_flag_t flags)
+{
+    ompi_op_base_reduce_threads = 0;
+    (void) mca_base_framework_var_register(&ompi_op_base_framework, "reduce_threads",
+                                           "Number of helper threads that large reductions "
+                                           "on intrinsic operations are split across; 0 "
+                                           "disables them (default: 0)",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0,
+                                           MCA_BASE_VAR_FLAG_SETTABLE, OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_LOCAL,
+                                           &ompi_op_base_reduce_threads);
+    if (ompi_op_base_reduce_threads < 0) {
+        ompi_op_base_reduce_threads = 0;
+    }
+
+    ompi_op_base_reduce_threads_min_size = 16 * 1024 * 1024;
+    (void) mca_base_framework_var_register(&ompi_op_base_framework, "reduce_threads_min_size",
+                                           "Size in bytes from which reductions are split "
+                                           "across the helper threads of op_base_reduce_threads "
+                                           "(default: 16MB)",
+                                           MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0,
+                                           MCA_BASE_VAR_FLAG_SETTABLE, OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_LOCAL,
+                                           &ompi_op_base_reduce_threads_min_size);
+
+    return OMPI_SUCCESS;
+}
+
+static int ompi_op_base_open(mca_base_open_flag_t flags)
+{
+    int ret = ompi_op_base_reduce_threads_open();
+    if (OMPI_SUCCESS != ret) {
+        return ret;
+    }
+
+    return mca_base_framework_components_open(&ompi_op_base_framework, flags);
+}
+
+static int ompi_op_base_close(void)
+{
+    (void) ompi_op_base_reduce_threads_close();
+
+    return mca_base_framework_components_close(&ompi_op_base_framework, NULL);
+}
+
+MCA_BASE_FRAMEWORK_DECLARE(ompi, op, NULL, ompi_op_base_register, ompi_op_base_open,
+                           ompi_op_base_close, mca_op_base_static_components, 0);
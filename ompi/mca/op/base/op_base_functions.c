@@ -28,6 +28,7 @@
 #endif
 
 #include "ompi/mca/op/op.h"
+#include "ompi/mca/op/base/functions.h"
 
 
 /*
@@ -72,6 +73,46 @@
       }                                                                  \
   }
 
+/*
+ * bfloat16 has no C type: each element is widened to float, combined,
+ * and rounded back (see functions.h).
+ *
+ * This macro is for (out = out op in).
+ */
+#define BFLOAT16_OP_FUNC(name, op) \
+  static void ompi_op_base_2buff_##name##_bfloat16(const void *in, void *out, int *count, \
+                                                   struct ompi_datatype_t **dtype, \
+                                                   struct ompi_op_base_module_1_0_0_t *module) \
+  {                                                                      \
+      int i;                                                             \
+      const uint16_t *a = (const uint16_t *) in;                         \
+      uint16_t *b = (uint16_t *) out;                                    \
+      for (i = *count; i > 0; i--, ++a, ++b) {                           \
+          *b = ompi_op_base_float_to_bfloat16(ompi_op_base_bfloat16_to_float(*b) op \
+                                              ompi_op_base_bfloat16_to_float(*a)); \
+      }                                                                  \
+  }
+
+/*
+ * This macro is for (out = op(out, in)) on bfloat16. As current_func on
+ * float, out is kept only when (out op in) holds, so that in is returned
+ * on NaNs and on -0.0/+0.0.
+ */
+#define BFLOAT16_FUNC_FUNC(name, op) \
+  static void ompi_op_base_2buff_##name##_bfloat16(const void *in, void *out, int *count, \
+                                                   struct ompi_datatype_t **dtype, \
+                                                   struct ompi_op_base_module_1_0_0_t *module) \
+  {                                                                      \
+      int i;                                                             \
+      const uint16_t *a = (const uint16_t *) in;                         \
+      uint16_t *b = (uint16_t *) out;                                    \
+      for (i = *count; i > 0; i--, ++a, ++b) {                           \
+          float fa = ompi_op_base_bfloat16_to_float(*a);                 \
+          float fb = ompi_op_base_bfloat16_to_float(*b);                 \
+          *b = (fb op fa) ? *b : *a;                                     \
+      }                                                                  \
+  }
+
 /*
  * Since all the functions in this file are essentially identical, we
  * use a macro to substitute in names and types.  The core operation
@@ -192,6 +233,7 @@ FUNC_FUNC(max, short_float, opal_short_float_t)
 FUNC_FUNC(max, float, float)
 FUNC_FUNC(max, double, double)
 FUNC_FUNC(max, long_double, long double)
+BFLOAT16_FUNC_FUNC(max, >)
 #if OMPI_HAVE_FORTRAN_REAL
 FUNC_FUNC(max, fortran_real, ompi_fortran_real_t)
 #endif
@@ -258,6 +300,7 @@ FUNC_FUNC(min, short_float, opal_short_float_t)
 FUNC_FUNC(min, float, float)
 FUNC_FUNC(min, double, double)
 FUNC_FUNC(min, long_double, long double)
+BFLOAT16_FUNC_FUNC(min, <)
 #if OMPI_HAVE_FORTRAN_REAL
 FUNC_FUNC(min, fortran_real, ompi_fortran_real_t)
 #endif
@@ -321,6 +364,7 @@ OP_FUNC(sum, short_float, opal_short_float_t, +=)
 OP_FUNC(sum, float, float, +=)
 OP_FUNC(sum, double, double, +=)
 OP_FUNC(sum, long_double, long double, +=)
+BFLOAT16_OP_FUNC(sum, +)
 #if OMPI_HAVE_FORTRAN_REAL
 OP_FUNC(sum, fortran_real, ompi_fortran_real_t, +=)
 #endif
@@ -393,6 +437,7 @@ OP_FUNC(prod, short_float, opal_short_float_t, *=)
 OP_FUNC(prod, float, float, *=)
 OP_FUNC(prod, double, double, *=)
 OP_FUNC(prod, long_double, long double, *=)
+BFLOAT16_OP_FUNC(prod, *)
 #if OMPI_HAVE_FORTRAN_REAL
 OP_FUNC(prod, fortran_real, ompi_fortran_real_t, *=)
 #endif
@@ -723,6 +768,42 @@ LOC_FUNC(minloc, long_double_int, <)
         }                                                               \
     }
 
+/*
+ * bfloat16 versions of the above (see BFLOAT16_OP_FUNC).
+ */
+#define BFLOAT16_OP_FUNC_3BUF(name, op) \
+    static void ompi_op_base_3buff_##name##_bfloat16(const void * restrict in1, \
+                                                     const void * restrict in2, void * restrict out, int *count, \
+                                                     struct ompi_datatype_t **dtype, \
+                                                     struct ompi_op_base_module_1_0_0_t *module) \
+    {                                                                   \
+        int i;                                                          \
+        const uint16_t *a1 = (const uint16_t *) in1;                    \
+        const uint16_t *a2 = (const uint16_t *) in2;                    \
+        uint16_t *b = (uint16_t *) out;                                 \
+        for (i = *count; i > 0; i--) {                                  \
+            *(b++) = ompi_op_base_float_to_bfloat16(ompi_op_base_bfloat16_to_float(*(a1++)) op \
+                                                    ompi_op_base_bfloat16_to_float(*(a2++))); \
+        }                                                               \
+    }
+
+#define BFLOAT16_FUNC_FUNC_3BUF(name, op) \
+    static void ompi_op_base_3buff_##name##_bfloat16(const void * restrict in1, \
+                                                     const void * restrict in2, void * restrict out, int *count, \
+                                                     struct ompi_datatype_t **dtype, \
+                                                     struct ompi_op_base_module_1_0_0_t *module) \
+    {                                                                   \
+        int i;                                                          \
+        const uint16_t *a1 = (const uint16_t *) in1;                    \
+        const uint16_t *a2 = (const uint16_t *) in2;                    \
+        uint16_t *b = (uint16_t *) out;                                 \
+        for (i = *count; i > 0; i--, ++a1, ++a2, ++b) {                 \
+            float f1 = ompi_op_base_bfloat16_to_float(*a1);             \
+            float f2 = ompi_op_base_bfloat16_to_float(*a2);             \
+            *b = (f1 op f2) ? *a1 : *a2;                                \
+        }                                                               \
+    }
+
 /*
  * Since all the functions in this file are essentially identical, we
  * use a macro to substitute in names and types.  The core operation
@@ -852,6 +933,7 @@ FUNC_FUNC_3BUF(max, short_float, opal_short_float_t)
 FUNC_FUNC_3BUF(max, float, float)
 FUNC_FUNC_3BUF(max, double, double)
 FUNC_FUNC_3BUF(max, long_double, long double)
+BFLOAT16_FUNC_FUNC_3BUF(max, >)
 #if OMPI_HAVE_FORTRAN_REAL
 FUNC_FUNC_3BUF(max, fortran_real, ompi_fortran_real_t)
 #endif
@@ -918,6 +1000,7 @@ FUNC_FUNC_3BUF(min, short_float, opal_short_float_t)
 FUNC_FUNC_3BUF(min, float, float)
 FUNC_FUNC_3BUF(min, double, double)
 FUNC_FUNC_3BUF(min, long_double, long double)
+BFLOAT16_FUNC_FUNC_3BUF(min, <)
 #if OMPI_HAVE_FORTRAN_REAL
 FUNC_FUNC_3BUF(min, fortran_real, ompi_fortran_real_t)
 #endif
@@ -981,6 +1064,7 @@ OP_FUNC_3BUF(sum, short_float, opal_short_float_t, +)
 OP_FUNC_3BUF(sum, float, float, +)
 OP_FUNC_3BUF(sum, double, double, +)
 OP_FUNC_3BUF(sum, long_double, long double, +)
+BFLOAT16_OP_FUNC_3BUF(sum, +)
 #if OMPI_HAVE_FORTRAN_REAL
 OP_FUNC_3BUF(sum, fortran_real, ompi_fortran_real_t, +)
 #endif
@@ -1053,6 +1137,7 @@ OP_FUNC_3BUF(prod, short_float, opal_short_float_t, *)
 OP_FUNC_3BUF(prod, float, float, *)
 OP_FUNC_3BUF(prod, double, double, *)
 OP_FUNC_3BUF(prod, long_double, long double, *)
+BFLOAT16_OP_FUNC_3BUF(prod, *)
 #if OMPI_HAVE_FORTRAN_REAL
 OP_FUNC_3BUF(prod, fortran_real, ompi_fortran_real_t, *)
 #endif
@@ -1460,6 +1545,7 @@ LOC_FUNC_3BUF(minloc, long_double_int, <)
 #define FLOAT(name, ftype) ompi_op_base_##ftype##_##name##_float
 #define DOUBLE(name, ftype) ompi_op_base_##ftype##_##name##_double
 #define LONG_DOUBLE(name, ftype) ompi_op_base_##ftype##_##name##_long_double
+#define BFLOAT16(name, ftype) ompi_op_base_##ftype##_##name##_bfloat16
 
 #define FLOATING_POINT(name, ftype)                                                            \
   [OMPI_OP_BASE_TYPE_SHORT_FLOAT] = SHORT_FLOAT(name, ftype),                                  \
@@ -1467,7 +1553,8 @@ LOC_FUNC_3BUF(minloc, long_double_int, <)
   [OMPI_OP_BASE_TYPE_DOUBLE] = DOUBLE(name, ftype),                                            \
   FLOATING_POINT_FORTRAN_REAL(name, ftype),                                                    \
   [OMPI_OP_BASE_TYPE_DOUBLE_PRECISION] = FLOATING_POINT_FORTRAN_DOUBLE_PRECISION(name, ftype), \
-  [OMPI_OP_BASE_TYPE_LONG_DOUBLE] = LONG_DOUBLE(name, ftype)
+  [OMPI_OP_BASE_TYPE_LONG_DOUBLE] = LONG_DOUBLE(name, ftype),                                  \
+  [OMPI_OP_BASE_TYPE_BFLOAT16] = BFLOAT16(name, ftype)
 
 /** Fortran logical *****************************************************/
 
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+ * Helper threads for large local reductions.
+ *
+ * When op_base_reduce_threads is non-zero, intrinsic reductions of at
+ * least op_base_reduce_threads_min_size bytes are cut into chunks that
+ * are processed by the calling thread and by a pool of helper threads
+ * (see opal/runtime/opal_helper_threads.h), created on first use.
+ *
+ * The pool runs one reduction at a time; a thread that finds it busy
+ * performs its reduction serially.
+ */
+
+#include "ompi_config.h"
+
+#include "opal/runtime/opal_helper_threads.h"
+
+#include "ompi/constants.h"
+#include "ompi/op/op.h"
+#include "ompi/mca/op/base/base.h"
+
+int ompi_op_base_reduce_threads = 0;
+size_t ompi_op_base_reduce_threads_min_size = 16 * 1024 * 1024;
+
+/* Each participant gets a few chunks, so that a helper that is slow to
+ * wake up does not hold back the whole reduction. Chunks are never
+ * smaller than OP_THREADS_MIN_CHUNK bytes. */
+#define OP_THREADS_CHUNKS_PER_THREAD 4
+#define OP_THREADS_MIN_CHUNK (256 * 1024)
+
+typedef struct {
+    ompi_op_t *op;
+    const void *source1;   /* NULL for a 2-buffer reduction */
+    const void *source2;
+    void *target;
+    ompi_datatype_t *dtype;
+    ptrdiff_t extent;
+    size_t count;
+    size_t chunk_count;
+} op_threads_job_t;
+
+static opal_helper_threads_t op_threads;
+
+static void op_threads_work(void *arg, int32_t chunk)
+{
+    const op_threads_job_t *job = (const op_threads_job_t *) arg;
+    size_t first = (size_t) chunk * job->chunk_count;
+    size_t count = job->count - first;
+    ptrdiff_t shift = (ptrdiff_t) first * job->extent;
+
+    if (count > job->chunk_count) {
+        count = job->chunk_count;
+    }
+
+    if (NULL == job->source1) {
+        ompi_op_reduce_serial(job->op, (const char *) job->source2 + shift,
+                              (char *) job->target + shift, count, job->dtype);
+    } else {
+        ompi_3buff_op_reduce_serial(job->op, (char *) job->source1 + shift,
+                                    (char *) job->source2 + shift,
+                                    (char *) job->target + shift, count, job->dtype);
+    }
+}
+
+int ompi_op_base_reduce_threads_open(void)
+{
+    opal_helper_threads_init(&op_threads, "op:base:reduce_threads",
+                             ompi_op_base_framework.framework_output);
+
+    return OMPI_SUCCESS;
+}
+
+int ompi_op_base_reduce_threads_close(void)
+{
+    opal_helper_threads_fini(&op_threads);
+
+    return OMPI_SUCCESS;
+}
+
+int ompi_op_base_reduce_threaded(struct ompi_op_t *op, const void *source1,
+                                 const void *source2, void *target,
+                                 size_t count, ompi_datatype_t *dtype)
+{
+    op_threads_job_t job;
+    size_t min_chunk_count, nparts, nchunks;
+    ptrdiff_t lb, extent;
+    int nhelpers;
+
+    if (0 == dtype->super.size) {
+        return OMPI_ERR_NOT_SUPPORTED;
+    }
+
+    nhelpers = opal_helper_threads_acquire(&op_threads, ompi_op_base_reduce_threads);
+    if (nhelpers < 0) {
+        return nhelpers;
+    }
+
+    ompi_datatype_get_extent(dtype, &lb, &extent);
+
+    nparts = (size_t) (nhelpers + 1) * OP_THREADS_CHUNKS_PER_THREAD;
+    min_chunk_count = (OP_THREADS_MIN_CHUNK + dtype->super.size - 1) / dtype->super.size;
+
+    job.op = op;
+    job.source1 = source1;
+    job.source2 = source2;
+    job.target = target;
+    job.dtype = dtype;
+    job.extent = extent;
+    job.count = count;
+    job.chunk_count = (count + nparts - 1) / nparts;
+    if (job.chunk_count < min_chunk_count) {
+        job.chunk_count = min_chunk_count;
+    }
+    nchunks = (count + job.chunk_count - 1) / job.chunk_count;
+
+    if (nchunks < 2) {
+        opal_helper_threads_release(&op_threads);
+        return OMPI_ERR_NOT_SUPPORTED;
+    }
+
+    opal_helper_threads_run(&op_threads, op_threads_work, &job, (int32_t) nchunks);
+    opal_helper_threads_release(&op_threads);
+
+    return OMPI_SUCCESS;
+}
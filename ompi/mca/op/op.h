@@ -199,6 +199,9 @@ enum {
     /** 2 location C: wchar_t */
     OMPI_OP_BASE_TYPE_WCHAR,
 
+    /** bfloat16 (MPIX_BFLOAT16) */
+    OMPI_OP_BASE_TYPE_BFLOAT16,
+
     /** Maximum type */
     OMPI_OP_BASE_TYPE_MAX
 };
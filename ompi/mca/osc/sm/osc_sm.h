@@ -57,6 +57,10 @@ struct ompi_osc_sm_component_t {
     unsigned int priority;
 
     char *backing_directory;
+
+    /** Use native atomics for accumulate operations on single
+     * predefined datatypes (default for the window info key) */
+    bool acc_single_intrinsic;
 };
 typedef struct ompi_osc_sm_component_t ompi_osc_sm_component_t;
 OMPI_DECLSPEC extern ompi_osc_sm_component_t mca_osc_sm_component;
@@ -76,6 +80,11 @@ struct ompi_osc_sm_module_t {
     void *segment_base;
     bool noncontig;
 
+    /** accumulate operations only use a single predefined datatype so
+     * they can be executed with native atomics instead of the target's
+     * accumulate lock */
+    bool acc_single_intrinsic;
+
     size_t *sizes;
     void **bases;
     ptrdiff_t *disp_units;
@@ -20,6 +20,96 @@
 
 #include "osc_sm.h"
 
+/**
+ * Check whether an accumulate operation on the given datatype can be
+ * executed with native atomics on the shared segment. This is only
+ * the case if the user asserted that accumulate operations will only
+ * use single predefined datatypes (acc_single_intrinsic) since the
+ * lock-based path is not atomic with respect to the atomic path. Each
+ * element is updated atomically and every call completes before
+ * returning so the accumulate_ordering guarantees are preserved.
+ */
+static inline bool ompi_osc_sm_acc_use_atomics (ompi_osc_sm_module_t *module, struct ompi_op_t *op,
+                                                struct ompi_datatype_t *dt, const void *remote_address)
+{
+    const size_t size = dt->super.size;
+
+    if (!module->acc_single_intrinsic || !ompi_datatype_is_predefined (dt) || !ompi_op_is_intrinsic (op)) {
+        return false;
+    }
+
+    return (4 == size || 8 == size) && 0 == ((uintptr_t) remote_address & (size - 1));
+}
+
+#define OSC_SM_DEFINE_ATOMIC_ELEMENT_OP(bits)                                                       \
+    static inline void ompi_osc_sm_atomic_element_##bits (struct ompi_op_t *op,                     \
+                                                          struct ompi_datatype_t *dt,               \
+                                                          const void *origin, void *result,         \
+                                                          void *target)                             \
+    {                                                                                               \
+        opal_atomic_int##bits##_t *addr = (opal_atomic_int##bits##_t *) target;                     \
+        const bool is_int = OMPI_DATATYPE_FLAG_DATA_INT                                             \
+            == (dt->super.flags & OMPI_DATATYPE_FLAG_DATA_TYPE);                                    \
+        int##bits##_t value = 0, old_value, new_value;                                              \
+                                                                                                    \
+        if (NULL != origin) {                                                                       \
+            memcpy (&value, origin, sizeof (value));                                                \
+        }                                                                                           \
+                                                                                                    \
+        if (&ompi_mpi_op_no_op.op == op) {                                                          \
+            old_value = *addr;                                                                      \
+        } else if (&ompi_mpi_op_replace.op == op) {                                                 \
+            old_value = opal_atomic_swap_##bits (addr, value);                                      \
+        } else if (is_int && OMPI_OP_SUM == op->op_type) {                                          \
+            old_value = opal_atomic_fetch_add_##bits (addr, value);                                 \
+        } else if (is_int && OMPI_OP_BAND == op->op_type) {                                         \
+            old_value = opal_atomic_fetch_and_##bits (addr, value);                                 \
+        } else if (is_int && OMPI_OP_BOR == op->op_type) {                                          \
+            old_value = opal_atomic_fetch_or_##bits (addr, value);                                  \
+        } else if (is_int && OMPI_OP_BXOR == op->op_type) {                                         \
+            old_value = opal_atomic_fetch_xor_##bits (addr, value);                                 \
+        } else {                                                                                    \
+            /* no native instruction for this op/type combination. apply the op to a     \
+             * local copy and publish it with compare-and-swap */                                   \
+            old_value = *addr;                                                                      \
+            do {                                                                                    \
+                new_value = old_value;                                                              \
+                ompi_op_reduce (op, &value, &new_value, 1, dt);                                     \
+            } while (!opal_atomic_compare_exchange_strong_##bits (addr, &old_value, new_value));    \
+        }                                                                                           \
+                                                                                                    \
+        if (NULL != result) {                                                                       \
+            memcpy (result, &old_value, sizeof (old_value));                                        \
+        }                                                                                           \
+    }
+
+OSC_SM_DEFINE_ATOMIC_ELEMENT_OP(32)
+OSC_SM_DEFINE_ATOMIC_ELEMENT_OP(64)
+
+/**
+ * Execute an accumulate (or fetching accumulate if result_addr is not
+ * NULL) of count contiguous elements of a predefined datatype using
+ * native atomics. origin_addr may be NULL for MPI_NO_OP.
+ */
+static void ompi_osc_sm_atomic_accumulate (const void *origin_addr, void *result_addr, size_t count,
+                                           struct ompi_datatype_t *dt, void *remote_address,
+                                           struct ompi_op_t *op)
+{
+    const size_t size = dt->super.size;
+
+    for (size_t i = 0 ; i < count ; ++i) {
+        const void *origin = (NULL != origin_addr) ? (const char *) origin_addr + i * size : NULL;
+        void *result = (NULL != result_addr) ? (char *) result_addr + i * size : NULL;
+        void *target = (char *) remote_address + i * size;
+
+        if (4 == size) {
+            ompi_osc_sm_atomic_element_32 (op, dt, origin, result, target);
+        } else {
+            ompi_osc_sm_atomic_element_64 (op, dt, origin, result, target);
+        }
+    }
+}
+
 int
 ompi_osc_sm_rput(const void *origin_addr,
                  size_t origin_count,
@@ -127,6 +217,13 @@ ompi_osc_sm_raccumulate(const void *origin_addr,
 
     remote_address = ((char*) (module->bases[target])) + module->disp_units[target] * target_disp;
 
+    if (origin_dt == target_dt && origin_count == target_count &&
+        ompi_osc_sm_acc_use_atomics (module, op, target_dt, remote_address)) {
+        ompi_osc_sm_atomic_accumulate (origin_addr, NULL, target_count, target_dt, remote_address, op);
+        ret = OMPI_SUCCESS;
+        goto done;
+    }
+
     opal_atomic_lock(&module->node_states[target].accumulate_lock);
     if (op == &ompi_mpi_op_replace.op) {
         ret = ompi_datatype_sndrcv((void *)origin_addr, origin_count, origin_dt,
@@ -138,6 +235,7 @@ ompi_osc_sm_raccumulate(const void *origin_addr,
     }
     opal_atomic_unlock(&module->node_states[target].accumulate_lock);
 
+ done:
     /* the only valid field of RMA request status is the MPI_ERROR field.
      * ompi_request_empty has status MPI_SUCCESS and indicates the request is
      * complete. */
@@ -178,6 +276,15 @@ ompi_osc_sm_rget_accumulate(const void *origin_addr,
 
     remote_address = ((char*) (module->bases[target])) + module->disp_units[target] * target_disp;
 
+    if (result_dt == target_dt && result_count == target_count &&
+        (op == &ompi_mpi_op_no_op.op || (origin_dt == target_dt && origin_count == target_count)) &&
+        ompi_osc_sm_acc_use_atomics (module, op, target_dt, remote_address)) {
+        ompi_osc_sm_atomic_accumulate ((op == &ompi_mpi_op_no_op.op) ? NULL : origin_addr, result_addr,
+                                       target_count, target_dt, remote_address, op);
+        ret = OMPI_SUCCESS;
+        goto done_atomic;
+    }
+
     opal_atomic_lock(&module->node_states[target].accumulate_lock);
 
     ret = ompi_datatype_sndrcv(remote_address, target_count, target_dt,
@@ -196,6 +303,7 @@ ompi_osc_sm_rget_accumulate(const void *origin_addr,
  done:
     opal_atomic_unlock(&module->node_states[target].accumulate_lock);
 
+ done_atomic:
     /* the only valid field of RMA request status is the MPI_ERROR field.
      * ompi_request_empty has status MPI_SUCCESS and indicates the request is
      * complete. */
@@ -293,6 +401,13 @@ ompi_osc_sm_accumulate(const void *origin_addr,
 
     remote_address = ((char*) (module->bases[target])) + module->disp_units[target] * target_disp;
 
+    if (origin_dt == target_dt && origin_count == target_count &&
+        ompi_osc_sm_acc_use_atomics (module, op, target_dt, remote_address)) {
+        ompi_osc_sm_atomic_accumulate (origin_addr, NULL, target_count, target_dt, remote_address, op);
+        ret = OMPI_SUCCESS;
+        goto done;
+    }
+
     opal_atomic_lock(&module->node_states[target].accumulate_lock);
     if (op == &ompi_mpi_op_replace.op) {
         ret = ompi_datatype_sndrcv((void *)origin_addr, origin_count, origin_dt,
@@ -304,6 +419,7 @@ ompi_osc_sm_accumulate(const void *origin_addr,
     }
     opal_atomic_unlock(&module->node_states[target].accumulate_lock);
 
+ done:
     return ret;
 }
 
@@ -337,6 +453,15 @@ ompi_osc_sm_get_accumulate(const void *origin_addr,
 
     remote_address = ((char*) (module->bases[target])) + module->disp_units[target] * target_disp;
 
+    if (result_dt == target_dt && result_count == target_count &&
+        (op == &ompi_mpi_op_no_op.op || (origin_dt == target_dt && origin_count == target_count)) &&
+        ompi_osc_sm_acc_use_atomics (module, op, target_dt, remote_address)) {
+        ompi_osc_sm_atomic_accumulate ((op == &ompi_mpi_op_no_op.op) ? NULL : origin_addr, result_addr,
+                                       target_count, target_dt, remote_address, op);
+        ret = OMPI_SUCCESS;
+        goto done_atomic;
+    }
+
     opal_atomic_lock(&module->node_states[target].accumulate_lock);
 
     ret = ompi_datatype_sndrcv(remote_address, target_count, target_dt,
@@ -355,6 +480,7 @@ ompi_osc_sm_get_accumulate(const void *origin_addr,
  done:
     opal_atomic_unlock(&module->node_states[target].accumulate_lock);
 
+ done_atomic:
     return ret;
 }
 
@@ -383,6 +509,24 @@ ompi_osc_sm_compare_and_swap(const void *origin_addr,
 
     ompi_datatype_type_size(dt, &size);
 
+    if (ompi_osc_sm_acc_use_atomics (module, &ompi_mpi_op_replace.op, dt, remote_address)) {
+        if (4 == size) {
+            int32_t value, new_value;
+            memcpy (&value, compare_addr, sizeof (value));
+            memcpy (&new_value, origin_addr, sizeof (new_value));
+            (void) opal_atomic_compare_exchange_strong_32 ((opal_atomic_int32_t *) remote_address, &value, new_value);
+            memcpy (result_addr, &value, sizeof (value));
+        } else {
+            int64_t value, new_value;
+            memcpy (&value, compare_addr, sizeof (value));
+            memcpy (&new_value, origin_addr, sizeof (new_value));
+            (void) opal_atomic_compare_exchange_strong_64 ((opal_atomic_int64_t *) remote_address, &value, new_value);
+            memcpy (result_addr, &value, sizeof (value));
+        }
+
+        return OMPI_SUCCESS;
+    }
+
     opal_atomic_lock(&module->node_states[target].accumulate_lock);
 
     /* fetch */
@@ -421,6 +565,12 @@ ompi_osc_sm_fetch_and_op(const void *origin_addr,
 
     remote_address = ((char*) (module->bases[target])) + module->disp_units[target] * target_disp;
 
+    if (ompi_osc_sm_acc_use_atomics (module, op, dt, remote_address)) {
+        ompi_osc_sm_atomic_accumulate ((op == &ompi_mpi_op_no_op.op) ? NULL : origin_addr, result_addr, 1,
+                                       dt, remote_address, op);
+        return OMPI_SUCCESS;
+    }
+
     opal_atomic_lock(&module->node_states[target].accumulate_lock);
 
     /* fetch */
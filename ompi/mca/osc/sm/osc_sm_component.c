@@ -110,6 +110,27 @@ ompi_osc_sm_module_t ompi_osc_sm_module_template = {
     }
 };
 
+static bool check_config_value_bool (char *key, opal_info_t *info)
+{
+    int ret, flag, param;
+    bool result = false;
+    const bool *flag_value = &result;
+
+    if (NULL != info) {
+        ret = opal_info_get_bool (info, key, &result, &flag);
+        if (OMPI_SUCCESS == ret && flag) {
+            return result;
+        }
+    }
+
+    param = mca_base_var_find("ompi", "osc", "sm", key);
+    if (0 <= param) {
+        (void) mca_base_var_get_value(param, &flag_value, NULL, NULL);
+    }
+
+    return flag_value[0];
+}
+
 static int component_register (void)
 {
     char *description_str;
@@ -137,6 +158,18 @@ static int component_register (void)
                                           &mca_osc_sm_component.priority);
     free(description_str);
 
+    mca_osc_sm_component.acc_single_intrinsic = false;
+    opal_asprintf(&description_str, "Execute MPI_Accumulate, MPI_Fetch_and_op, etc using native atomics on "
+                  "the shared segment instead of a per-target lock. Only valid for codes that will not use "
+                  "anything more than a single predefined datatype in accumulate operations. Info key of "
+                  "same name overrides this value (default: %s)",
+                  mca_osc_sm_component.acc_single_intrinsic ? "true" : "false");
+    (void) mca_base_component_var_register(&mca_osc_sm_component.super.osc_version, "acc_single_intrinsic",
+                                           description_str, MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                           OPAL_INFO_LVL_5, MCA_BASE_VAR_SCOPE_GROUP,
+                                           &mca_osc_sm_component.acc_single_intrinsic);
+    free(description_str);
+
     return OPAL_SUCCESS;
 }
 
@@ -230,6 +263,12 @@ component_select(struct ompi_win_t *win, void **base, size_t size, ptrdiff_t dis
 
     module->flavor = flavor;
 
+    /* accumulate operations that do not fit the native atomic path
+     * (derived datatypes, user ops, ...) still use the target's
+     * accumulate lock. mixing both on the same location is not atomic
+     * so the fast path must be requested explicitly. */
+    module->acc_single_intrinsic = check_config_value_bool ("acc_single_intrinsic", info);
+
     /* create the segment */
     if (1 == comm_size) {
         module->segment_base = NULL;
@@ -602,6 +641,8 @@ ompi_osc_sm_get_info(struct ompi_win_t *win, struct opal_info_t **info_used)
                       (module->noncontig) ? "true" : "false");
     }
 
+    opal_info_set(info, "acc_single_intrinsic", module->acc_single_intrinsic ? "true" : "false");
+
     *info_used = info;
 
     return OMPI_SUCCESS;
@@ -28,6 +28,7 @@
 #include "ompi_config.h"
 #include "ompi/mca/pml/base/pml_base_request.h"
 #include "opal/datatype/opal_convertor.h"
+#include "opal/runtime/opal_progress.h"
 #include "ompi/peruse/peruse-internal.h"
 
 BEGIN_C_DECLS
@@ -105,6 +106,7 @@ OMPI_DECLSPEC OBJ_CLASS_DECLARATION(mca_pml_base_recv_request_t);
                                                                                 \
         (request)->req_base.req_ompi.req_complete = REQUEST_PENDING;            \
         (request)->req_base.req_ompi.req_state = OMPI_REQUEST_ACTIVE;           \
+        opal_progress_work_posted();                                            \
     } while (0)
 
 /**
@@ -33,6 +33,7 @@
 #include "ompi/mca/pml/pml.h"
 #include "ompi/mca/pml/base/pml_base_request.h"
 #include "opal/datatype/opal_convertor.h"
+#include "opal/runtime/opal_progress.h"
 #include "ompi/peruse/peruse-internal.h"
 
 BEGIN_C_DECLS
@@ -150,6 +151,7 @@ OMPI_DECLSPEC OBJ_CLASS_DECLARATION( mca_pml_base_send_request_t );
         (request)->req_base.req_ompi.req_status._cancelled = 0;         \
         (request)->req_base.req_ompi.req_status.MPI_ERROR = OMPI_SUCCESS; \
         MCA_PML_BASE_SEND_REQUEST_RESET(request);             \
+        opal_progress_work_posted();                          \
     } while (0)
 
 /**
@@ -22,7 +22,7 @@ AC_DEFUN([MCA_ompi_pml_ob1_POST_CONFIG], [
 # ------------------------------------------------
 # We can always build, unless we were explicitly disabled.
 AC_DEFUN([MCA_ompi_pml_ob1_CONFIG],[
-    OPAL_VAR_SCOPE_PUSH([pml_ob1_matching_engine])
+    OPAL_VAR_SCOPE_PUSH([pml_ob1_matching_engine pml_ob1_match_stats])
     AC_ARG_WITH([pml-ob1-matching], [AS_HELP_STRING([--with-pml-ob1-matching=type],
                                                     [Configure pml/ob1 to use an alternate matching engine. Only valid on x86_64 systems.
                                                      Valid values are: none, default, arrays, fuzzy-byte, fuzzy-short, fuzzy-word, vector (default: none)])])
@@ -60,6 +60,13 @@ AC_DEFUN([MCA_ompi_pml_ob1_CONFIG],[
 
     AC_DEFINE_UNQUOTED([MCA_PML_OB1_CUSTOM_MATCHING], [$pml_ob1_matching_engine], [Custom matching engine to use in pml/ob1])
 
+    AC_ARG_ENABLE([pml-ob1-match-stats], [AS_HELP_STRING([--enable-pml-ob1-match-stats],
+                                                         [Enable the pml/ob1 matching queue statistics, exposed as MPI_T performance variables (default: disabled)])])
+    AS_IF([test "$enable_pml_ob1_match_stats" = "yes"],
+          [pml_ob1_match_stats=1],
+          [pml_ob1_match_stats=0])
+    AC_DEFINE_UNQUOTED([MCA_PML_OB1_MATCH_STATS], [$pml_ob1_match_stats], [Whether pml/ob1 keeps matching queue statistics])
+
     AC_CONFIG_FILES([ompi/mca/pml/ob1/Makefile])
     [$1]
 ])dnl
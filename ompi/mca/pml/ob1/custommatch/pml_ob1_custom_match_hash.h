@@ -0,0 +1,346 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+ * Hash-indexed exact matching. Posted receives and unexpected fragments
+ * are chained in buckets indexed by a hash of (source, tag), so matching
+ * a fully specified envelope only looks at the entries sharing its
+ * bucket. It is meant for communicators asserting mpi_assert_no_any_source
+ * and mpi_assert_no_any_tag, but still matches wildcard receives
+ * correctly, if slowly: they are kept on a separate queue of the posted
+ * receives, and are matched against the unexpected fragments in arrival
+ * order.
+ *
+ * Unlike the other engines in this directory this one is not selected
+ * at configure time. It is used per communicator, next to the configured
+ * engine, hence the custom_match_hash_ prefix.
+ */
+
+#ifndef PML_OB1_CUSTOM_MATCH_HASH_H
+#define PML_OB1_CUSTOM_MATCH_HASH_H
+
+#include "ompi_config.h"
+
+#include <inttypes.h>
+#include <stdlib.h>
+
+#include "opal/util/output.h"
+#include "ompi/constants.h"
+#include "mpi.h"
+
+#define CUSTOM_MATCH_HASH_BUCKETS 256
+
+typedef struct custom_match_hash_node
+{
+    int tag;
+    int src;
+    uint64_t order;                           /* posting order (prq only) */
+    struct custom_match_hash_node* next;      /* bucket (or wildcard queue) */
+    struct custom_match_hash_node* prev;
+    struct custom_match_hash_node* all_next;  /* arrival order (umq only) */
+    struct custom_match_hash_node* all_prev;
+    void* value;
+} custom_match_hash_node;
+
+typedef struct custom_match_hash_list
+{
+    custom_match_hash_node* head;
+    custom_match_hash_node* tail;
+} custom_match_hash_list;
+
+static inline unsigned custom_match_hash_bucket(int tag, int src)
+{
+    return ((uint32_t) src * 0x9e3779b1u + (uint32_t) tag) & (CUSTOM_MATCH_HASH_BUCKETS - 1);
+}
+
+static inline void custom_match_hash_list_append(custom_match_hash_list* list, custom_match_hash_node* elem)
+{
+    elem->next = NULL;
+    elem->prev = list->tail;
+    if(list->tail) {
+        list->tail->next = elem;
+    } else {
+        list->head = elem;
+    }
+    list->tail = elem;
+}
+
+static inline void custom_match_hash_list_remove(custom_match_hash_list* list, custom_match_hash_node* elem)
+{
+    if(elem->prev) {
+        elem->prev->next = elem->next;
+    } else {
+        list->head = elem->next;
+    }
+    if(elem->next) {
+        elem->next->prev = elem->prev;
+    } else {
+        list->tail = elem->prev;
+    }
+}
+
+static inline custom_match_hash_node* custom_match_hash_node_get(custom_match_hash_node** pool)
+{
+    custom_match_hash_node* elem = *pool;
+
+    if(elem) {
+        *pool = elem->next;
+        return elem;
+    }
+    return (custom_match_hash_node*) malloc(sizeof(custom_match_hash_node));
+}
+
+static inline void custom_match_hash_node_put(custom_match_hash_node** pool, custom_match_hash_node* elem)
+{
+    elem->value = NULL;
+    elem->next = *pool;
+    *pool = elem;
+}
+
+static inline void custom_match_hash_node_free_all(custom_match_hash_node* elem)
+{
+    while(elem) {
+        custom_match_hash_node* next = elem->next;
+        free(elem);
+        elem = next;
+    }
+}
+
+static inline int custom_match_hash_envelope(int tag, int src, int match_tag, int match_src)
+{
+    return (match_src == src || OMPI_ANY_SOURCE == match_src) &&
+        (match_tag == tag || (OMPI_ANY_TAG == match_tag && tag >= 0));
+}
+
+/*
+ * Posted receive queue
+ */
+
+typedef struct custom_match_hash_prq
+{
+    custom_match_hash_list buckets[CUSTOM_MATCH_HASH_BUCKETS];
+    custom_match_hash_list wild;    /* receives with a wildcard, in posting order */
+    custom_match_hash_node* pool;
+    uint64_t order;
+    int size;
+} custom_match_hash_prq;
+
+static inline custom_match_hash_prq* custom_match_hash_prq_init(void)
+{
+    return (custom_match_hash_prq*) calloc(1, sizeof(custom_match_hash_prq));
+}
+
+static inline void custom_match_hash_prq_destroy(custom_match_hash_prq* list)
+{
+    for(int i = 0; i < CUSTOM_MATCH_HASH_BUCKETS; i++) {
+        custom_match_hash_node_free_all(list->buckets[i].head);
+    }
+    custom_match_hash_node_free_all(list->wild.head);
+    custom_match_hash_node_free_all(list->pool);
+    free(list);
+}
+
+static inline custom_match_hash_list* custom_match_hash_prq_list(custom_match_hash_prq* list, int tag, int source)
+{
+    if(OMPI_ANY_SOURCE == source || OMPI_ANY_TAG == tag) {
+        return &list->wild;
+    }
+    return &list->buckets[custom_match_hash_bucket(tag, source)];
+}
+
+static inline void custom_match_hash_prq_append(custom_match_hash_prq* list, void* payload, int tag, int source)
+{
+    custom_match_hash_node* elem = custom_match_hash_node_get(&list->pool);
+
+    elem->tag = tag;
+    elem->src = source;
+    elem->order = list->order++;
+    elem->value = payload;
+    custom_match_hash_list_append(custom_match_hash_prq_list(list, tag, source), elem);
+    list->size++;
+}
+
+static inline int custom_match_hash_prq_cancel(custom_match_hash_prq* list, void* req, int tag, int source)
+{
+    custom_match_hash_list* bucket = custom_match_hash_prq_list(list, tag, source);
+
+    for(custom_match_hash_node* elem = bucket->head; elem; elem = elem->next) {
+        if(elem->value == req) {
+            custom_match_hash_list_remove(bucket, elem);
+            custom_match_hash_node_put(&list->pool, elem);
+            list->size--;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* Find the first posted receive matching an incoming envelope, and
+ * dequeue it */
+static inline void* custom_match_hash_prq_find_dequeue_verify(custom_match_hash_prq* list, int tag, int peer)
+{
+    custom_match_hash_list* bucket = &list->buckets[custom_match_hash_bucket(tag, peer)];
+    custom_match_hash_node *elem, *match = NULL;
+    void* payload;
+
+    for(elem = bucket->head; elem; elem = elem->next) {
+        if(elem->tag == tag && elem->src == peer) {
+            match = elem;
+            break;
+        }
+    }
+
+    for(elem = list->wild.head; elem; elem = elem->next) {
+        if(NULL != match && elem->order > match->order) {
+            break;
+        }
+        if(custom_match_hash_envelope(tag, peer, elem->tag, elem->src)) {
+            match = elem;
+            bucket = &list->wild;
+            break;
+        }
+    }
+
+    if(NULL == match) {
+        return NULL;
+    }
+
+    payload = match->value;
+    custom_match_hash_list_remove(bucket, match);
+    custom_match_hash_node_put(&list->pool, match);
+    list->size--;
+    return payload;
+}
+
+static inline int custom_match_hash_prq_size(custom_match_hash_prq* list)
+{
+    return list->size;
+}
+
+static inline void custom_match_hash_prq_dump(custom_match_hash_prq* list)
+{
+    for(int i = 0; i < CUSTOM_MATCH_HASH_BUCKETS; i++) {
+        for(custom_match_hash_node* elem = list->buckets[i].head; elem; elem = elem->next) {
+            opal_output(0, "[bucket %d] req %p peer %d tag %d order %" PRIu64, i,
+                        elem->value, elem->src, elem->tag, elem->order);
+        }
+    }
+    for(custom_match_hash_node* elem = list->wild.head; elem; elem = elem->next) {
+        opal_output(0, "[wildcard] req %p peer %d tag %d order %" PRIu64,
+                    elem->value, elem->src, elem->tag, elem->order);
+    }
+}
+
+/*
+ * Unexpected message queue
+ */
+
+typedef struct custom_match_hash_umq
+{
+    custom_match_hash_list buckets[CUSTOM_MATCH_HASH_BUCKETS];
+    custom_match_hash_node* first;  /* all the fragments, in arrival order */
+    custom_match_hash_node* last;
+    custom_match_hash_node* pool;
+    int size;
+} custom_match_hash_umq;
+
+static inline custom_match_hash_umq* custom_match_hash_umq_init(void)
+{
+    return (custom_match_hash_umq*) calloc(1, sizeof(custom_match_hash_umq));
+}
+
+static inline void custom_match_hash_umq_destroy(custom_match_hash_umq* list)
+{
+    for(int i = 0; i < CUSTOM_MATCH_HASH_BUCKETS; i++) {
+        custom_match_hash_node_free_all(list->buckets[i].head);
+    }
+    custom_match_hash_node_free_all(list->pool);
+    free(list);
+}
+
+static inline void custom_match_hash_umq_append(custom_match_hash_umq* list, int tag, int source, void* payload)
+{
+    custom_match_hash_node* elem = custom_match_hash_node_get(&list->pool);
+
+    elem->tag = tag;
+    elem->src = source;
+    elem->value = payload;
+    custom_match_hash_list_append(&list->buckets[custom_match_hash_bucket(tag, source)], elem);
+
+    elem->all_next = NULL;
+    elem->all_prev = list->last;
+    if(list->last) {
+        list->last->all_next = elem;
+    } else {
+        list->first = elem;
+    }
+    list->last = elem;
+    list->size++;
+}
+
+/* Find the earliest fragment matching a receive, leaving it in the queue */
+static inline void* custom_match_hash_umq_find_verify_hold(custom_match_hash_umq* list, int tag, int peer,
+                                                           custom_match_hash_node** hold_elem)
+{
+    custom_match_hash_node* elem;
+
+    if(OMPI_ANY_SOURCE != peer && OMPI_ANY_TAG != tag) {
+        for(elem = list->buckets[custom_match_hash_bucket(tag, peer)].head; elem; elem = elem->next) {
+            if(elem->tag == tag && elem->src == peer) {
+                *hold_elem = elem;
+                return elem->value;
+            }
+        }
+        return NULL;
+    }
+
+    for(elem = list->first; elem; elem = elem->all_next) {
+        if(custom_match_hash_envelope(elem->tag, elem->src, tag, peer)) {
+            *hold_elem = elem;
+            return elem->value;
+        }
+    }
+    return NULL;
+}
+
+static inline void custom_match_hash_umq_remove_hold(custom_match_hash_umq* list, custom_match_hash_node* elem)
+{
+    custom_match_hash_list_remove(&list->buckets[custom_match_hash_bucket(elem->tag, elem->src)], elem);
+
+    if(elem->all_prev) {
+        elem->all_prev->all_next = elem->all_next;
+    } else {
+        list->first = elem->all_next;
+    }
+    if(elem->all_next) {
+        elem->all_next->all_prev = elem->all_prev;
+    } else {
+        list->last = elem->all_prev;
+    }
+
+    custom_match_hash_node_put(&list->pool, elem);
+    list->size--;
+}
+
+static inline int custom_match_hash_umq_size(custom_match_hash_umq* list)
+{
+    return list->size;
+}
+
+static inline void custom_match_hash_umq_dump(custom_match_hash_umq* list)
+{
+    for(custom_match_hash_node* elem = list->first; elem; elem = elem->all_next) {
+        opal_output(0, "frag %p peer %d tag %d", elem->value, elem->src, elem->tag);
+    }
+}
+
+#endif
@@ -242,8 +242,28 @@ mca_pml_ob1_set_allow_overtake(opal_infosubscriber_t* obj,
     return "false";
 }
 
+static const char*
+mca_pml_ob1_set_matching_engine(opal_infosubscriber_t* obj,
+                                const char* key,
+                                const char* value)
+{
+    ompi_communicator_t *ompi_comm = (ompi_communicator_t *) obj;
+    mca_pml_ob1_comm_t *pml_comm = ompi_comm->c_pml_comm;
+
+    /* The hash queues match any receive, wildcards included, so there is
+     * no need to ever switch back: refuse to. */
+    if (0 == strcmp (value, "hash") && NULL == pml_comm->hash_prq) {
+        OB1_MATCHING_LOCK(&pml_comm->matching_lock);
+        (void) mca_pml_ob1_comm_init_hash (pml_comm);
+        OB1_MATCHING_UNLOCK(&pml_comm->matching_lock);
+    }
+
+    return (NULL != pml_comm->hash_prq) ? "hash" : "lists";
+}
+
 int mca_pml_ob1_add_comm(ompi_communicator_t* comm)
 {
+    const char *default_engine = "lists";
     /* allocate pml specific comm data */
     mca_pml_ob1_comm_t* pml_comm = OBJ_NEW(mca_pml_ob1_comm_t);
     mca_pml_ob1_recv_frag_t *frag, *next_frag;
@@ -265,6 +285,23 @@ int mca_pml_ob1_add_comm(ompi_communicator_t* comm)
     mca_pml_ob1_comm_init_size(pml_comm, comm->c_remote_group->grp_proc_count);
     comm->c_pml_comm = pml_comm;
 
+    ompi_comm_assert_subscribe (comm, OMPI_COMM_ASSERT_NO_ANY_TAG);
+    if (mca_pml_ob1.matching_shards > 1) {
+        /* sharding is an optimization, keep the communicator usable without it */
+        (void) mca_pml_ob1_comm_init_shards (pml_comm, comm, mca_pml_ob1.matching_shards);
+    }
+
+    /* Without wildcards every receive has an exact (source, tag) key, and
+     * hash matching is the engine of choice. The callback also selects the
+     * initial engine. */
+    if (MCA_PML_OB1_MATCHING_HASH == mca_pml_ob1.matching_engine ||
+        (MCA_PML_OB1_MATCHING_AUTO == mca_pml_ob1.matching_engine &&
+         OMPI_COMM_CHECK_ASSERT_NO_ANY_SOURCE(comm) && OMPI_COMM_CHECK_ASSERT_NO_ANY_TAG(comm))) {
+        default_engine = "hash";
+    }
+    opal_infosubscribe_subscribe (&comm->super, "ompi_pml_ob1_matching", default_engine,
+                                  mca_pml_ob1_set_matching_engine);
+
     /* Register the subscriber alert for the mpi_assert_allow_overtaking info. */
     opal_infosubscribe_subscribe (&comm->super, "mpi_assert_allow_overtaking",
                                   "false", mca_pml_ob1_set_allow_overtake);
@@ -317,11 +354,21 @@ int mca_pml_ob1_add_comm(ompi_communicator_t* comm)
         pml_proc = mca_pml_ob1_peer_lookup(comm, hdr->hdr_src);
 
         if (OMPI_COMM_CHECK_ASSERT_ALLOW_OVERTAKE(comm)) {
+            if (NULL != pml_comm->hash_umq) {
+                custom_match_hash_umq_append(pml_comm->hash_umq, hdr->hdr_tag, hdr->hdr_src, frag);
+            } else {
 #if !MCA_PML_OB1_CUSTOM_MATCH
-            opal_list_append( &pml_proc->unexpected_frags, (opal_list_item_t*)frag );
+                if (NULL != pml_comm->shards) {
+                    mca_pml_ob1_shard_append_unexpected (pml_comm, mca_pml_ob1_comm_shard (pml_comm, hdr->hdr_src, hdr->hdr_tag),
+                                                         frag);
+                } else {
+                    opal_list_append( &pml_proc->unexpected_frags, (opal_list_item_t*)frag );
+                }
 #else
-            custom_match_umq_append(pml_comm->umq, hdr->hdr_tag, hdr->hdr_src, frag);
+                custom_match_umq_append(pml_comm->umq, hdr->hdr_tag, hdr->hdr_src, frag);
 #endif
+            }
+            MCA_PML_OB1_STATS_UNEXPECTED(pml_comm, 1, mca_pml_ob1_compute_segment_length_base (frag->segments, frag->num_segments, 0));
             PERUSE_TRACE_MSG_EVENT(PERUSE_COMM_MSG_INSERT_IN_UNEX_Q, comm,
                                    hdr->hdr_src, hdr->hdr_tag, PERUSE_RECV);
             continue;
@@ -332,11 +379,21 @@ int mca_pml_ob1_add_comm(ompi_communicator_t* comm)
         add_fragment_to_unexpected:
             /* We're now expecting the next sequence number. */
             pml_proc->expected_sequence++;
+            if (NULL != pml_comm->hash_umq) {
+                custom_match_hash_umq_append(pml_comm->hash_umq, hdr->hdr_tag, hdr->hdr_src, frag);
+            } else {
 #if !MCA_PML_OB1_CUSTOM_MATCH
-            opal_list_append( &pml_proc->unexpected_frags, (opal_list_item_t*)frag );
+                if (NULL != pml_comm->shards) {
+                    mca_pml_ob1_shard_append_unexpected (pml_comm, mca_pml_ob1_comm_shard (pml_comm, hdr->hdr_src, hdr->hdr_tag),
+                                                         frag);
+                } else {
+                    opal_list_append( &pml_proc->unexpected_frags, (opal_list_item_t*)frag );
+                }
 #else
-            custom_match_umq_append(pml_comm->umq, hdr->hdr_tag, hdr->hdr_src, frag);
+                custom_match_umq_append(pml_comm->umq, hdr->hdr_tag, hdr->hdr_src, frag);
 #endif
+            }
+            MCA_PML_OB1_STATS_UNEXPECTED(pml_comm, 1, mca_pml_ob1_compute_segment_length_base (frag->segments, frag->num_segments, 0));
             PERUSE_TRACE_MSG_EVENT(PERUSE_COMM_MSG_INSERT_IN_UNEX_Q, comm,
                                    hdr->hdr_src, hdr->hdr_tag, PERUSE_RECV);
             /* And now the ugly part. As some fragments can be inserted in the cant_match list,
@@ -355,6 +412,7 @@ int mca_pml_ob1_add_comm(ompi_communicator_t* comm)
         } else {
             ompi_pml_ob1_append_frag_to_ordered_list(&pml_proc->frags_cant_match, frag,
                                         pml_proc->expected_sequence);
+            MCA_PML_OB1_STATS_OUT_OF_SEQUENCE(pml_comm);
         }
     }
     return OMPI_SUCCESS;
@@ -677,8 +735,30 @@ int mca_pml_ob1_dump(struct ompi_communicator_t* comm, int verbose)
         opal_output(0, "expected MPI_ANY_SOURCE fragments\n");
         mca_pml_ob1_dump_frag_list(&pml_comm->wild_receives, true);
     }
+
+    if (NULL != pml_comm->shards) {
+        for( uint32_t s = 0; s <= pml_comm->shard_mask; s++ ) {
+            mca_pml_ob1_match_shard_t *shard = pml_comm->shards + s;
+
+            if( opal_list_get_size(&shard->posted) ) {
+                opal_output(0, "[Shard %u] expected receives\n", s);
+                mca_pml_ob1_dump_frag_list(&shard->posted, true);
+            }
+            if( opal_list_get_size(&shard->unexpected) ) {
+                opal_output(0, "[Shard %u] unexpected frag\n", s);
+                mca_pml_ob1_dump_frag_list(&shard->unexpected, false);
+            }
+        }
+    }
 #endif
 
+    if (NULL != pml_comm->hash_prq) {
+        opal_output(0, "expected receives (hash matching)\n");
+        custom_match_hash_prq_dump(pml_comm->hash_prq);
+        opal_output(0, "unexpected frag (hash matching)\n");
+        custom_match_hash_umq_dump(pml_comm->hash_umq);
+    }
+
 #if MCA_PML_OB1_CUSTOM_MATCH
      opal_output(0, "expected receives\n");
      custom_match_prq_dump(pml_comm->prq);
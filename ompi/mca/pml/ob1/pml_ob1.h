@@ -47,6 +47,18 @@
 
 BEGIN_C_DECLS
 
+/**
+ * Selection of the matching engine of the communicators. The lists are
+ * the per-peer queues, or the engine selected at configure time
+ * (--with-pml-ob1-matching).
+ */
+enum mca_pml_ob1_matching_engine_t {
+    MCA_PML_OB1_MATCHING_AUTO,  /**< hash when no wildcards are asserted, or the queues grow long */
+    MCA_PML_OB1_MATCHING_LISTS,
+    MCA_PML_OB1_MATCHING_HASH,
+};
+typedef enum mca_pml_ob1_matching_engine_t mca_pml_ob1_matching_engine_t;
+
 /**
  * OB1 PML module
  */
@@ -63,6 +75,9 @@ struct mca_pml_ob1_t {
     size_t rdma_retries_limit;
     int max_rdma_per_request;
     int max_send_per_range;
+    int matching_shards;    /* number of matching shards per communicator (0: disabled) */
+    int matching_engine;    /* matching engine selection (mca_pml_ob1_matching_engine_t) */
+    int hash_matching_threshold; /* posted queue depth switching to hash matching (auto engine) */
     bool use_all_rdma;
 
     /* lock queue access */
@@ -28,6 +28,8 @@
 
 #include "pml_ob1.h"
 #include "pml_ob1_comm.h"
+#include "pml_ob1_recvreq.h"
+#include "pml_ob1_recvfrag.h"
 
 
 
@@ -68,6 +70,11 @@ static void mca_pml_ob1_comm_construct(mca_pml_ob1_comm_t* comm)
 {
 #if !MCA_PML_OB1_CUSTOM_MATCH
     OBJ_CONSTRUCT(&comm->wild_receives, opal_list_t);
+    comm->shards = NULL;
+    comm->peer_locks = NULL;
+    comm->shard_mask = 0;
+    comm->shard_by_source = comm->shard_by_tag = false;
+    comm->unexpected_stamp = 0;
 #else
     comm->prq = custom_match_prq_init();
     comm->umq = custom_match_umq_init();
@@ -78,6 +85,11 @@ static void mca_pml_ob1_comm_construct(mca_pml_ob1_comm_t* comm)
     comm->procs = NULL;
     comm->last_probed = 0;
     comm->num_procs = 0;
+    comm->hash_prq = NULL;
+    comm->hash_umq = NULL;
+#if MCA_PML_OB1_MATCH_STATS
+    memset (&comm->stats, 0, sizeof (comm->stats));
+#endif
 }
 
 
@@ -95,10 +107,24 @@ static void mca_pml_ob1_comm_destruct(mca_pml_ob1_comm_t* comm)
 
 #if !MCA_PML_OB1_CUSTOM_MATCH
     OBJ_DESTRUCT(&comm->wild_receives);
+    if (NULL != comm->shards) {
+        for (uint32_t i = 0 ; i <= comm->shard_mask ; ++i) {
+            OBJ_DESTRUCT(&comm->shards[i].lock);
+            OBJ_DESTRUCT(&comm->shards[i].posted);
+            OBJ_DESTRUCT(&comm->shards[i].unexpected);
+            OBJ_DESTRUCT(&comm->peer_locks[i]);
+        }
+        free (comm->shards);
+        free (comm->peer_locks);
+    }
 #else
     custom_match_prq_destroy(comm->prq);
     custom_match_umq_destroy(comm->umq);
 #endif
+    if (NULL != comm->hash_prq) {
+        custom_match_hash_prq_destroy(comm->hash_prq);
+        custom_match_hash_umq_destroy(comm->hash_umq);
+    }
     OBJ_DESTRUCT(&comm->matching_lock);
     OBJ_DESTRUCT(&comm->proc_lock);
 }
@@ -122,6 +148,184 @@ int mca_pml_ob1_comm_init_size (mca_pml_ob1_comm_t* comm, size_t size)
     return OMPI_SUCCESS;
 }
 
+int mca_pml_ob1_comm_init_shards (mca_pml_ob1_comm_t *comm, ompi_communicator_t *ompi_comm, int num_shards)
+{
+#if !MCA_PML_OB1_CUSTOM_MATCH
+    uint32_t count = 1;
+
+    if (num_shards <= 1) {
+        return OMPI_SUCCESS;
+    }
+
+    while (count < (uint32_t) num_shards && count < MCA_PML_OB1_MAX_SHARDS) {
+        count <<= 1;
+    }
+
+    comm->shards = (mca_pml_ob1_match_shard_t *) calloc (count, sizeof (comm->shards[0]));
+    comm->peer_locks = (opal_mutex_t *) calloc (count, sizeof (comm->peer_locks[0]));
+    if (NULL == comm->shards || NULL == comm->peer_locks) {
+        free (comm->shards);
+        free (comm->peer_locks);
+        comm->shards = NULL;
+        comm->peer_locks = NULL;
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+
+    for (uint32_t i = 0 ; i < count ; ++i) {
+        OBJ_CONSTRUCT(&comm->shards[i].lock, opal_mutex_t);
+        OBJ_CONSTRUCT(&comm->shards[i].posted, opal_list_t);
+        OBJ_CONSTRUCT(&comm->shards[i].unexpected, opal_list_t);
+        OBJ_CONSTRUCT(&comm->peer_locks[i], opal_mutex_t);
+    }
+    comm->shard_mask = count - 1;
+
+    /* Key on whatever the application promised never to wildcard. Without
+     * any promise key on both, and let the wildcard receives fall back to
+     * the communicator-wide queue. The assertions only select the key:
+     * a receive using a wildcard that is part of the key is always
+     * matched through the fallback, so a communicator whose assertions
+     * change later still matches correctly. */
+    comm->shard_by_source = !OMPI_COMM_CHECK_ASSERT_NO_ANY_TAG(ompi_comm) ||
+        OMPI_COMM_CHECK_ASSERT_NO_ANY_SOURCE(ompi_comm);
+    comm->shard_by_tag = !OMPI_COMM_CHECK_ASSERT_NO_ANY_SOURCE(ompi_comm) ||
+        OMPI_COMM_CHECK_ASSERT_NO_ANY_TAG(ompi_comm);
+#endif
+
+    return OMPI_SUCCESS;
+}
+
+#if !MCA_PML_OB1_CUSTOM_MATCH
+static int mca_pml_ob1_recv_sequence_cmp (const void *a, const void *b)
+{
+    const mca_pml_ob1_recv_request_t *ra = *(mca_pml_ob1_recv_request_t * const *) a;
+    const mca_pml_ob1_recv_request_t *rb = *(mca_pml_ob1_recv_request_t * const *) b;
+
+    /* the sequence wraps around at 32 bits */
+    return (int32_t) ((uint32_t) ra->req_recv.req_base.req_sequence -
+                      (uint32_t) rb->req_recv.req_base.req_sequence);
+}
+
+/* Move the posted receives, in posting order, and the unexpected fragments
+ * to the hash queues. The fragments keep their per-peer order, which is
+ * all the ordering MPI defines. */
+static int mca_pml_ob1_comm_move_to_hash (mca_pml_ob1_comm_t *comm)
+{
+    mca_pml_ob1_recv_request_t **reqs;
+    mca_pml_ob1_recv_frag_t *frag;
+    opal_list_item_t *item;
+    size_t count = opal_list_get_size (&comm->wild_receives), n = 0;
+
+    for (size_t i = 0 ; i < comm->num_procs ; ++i) {
+        if (NULL != comm->procs[i]) {
+            count += opal_list_get_size (&comm->procs[i]->specific_receives);
+        }
+    }
+
+    reqs = (mca_pml_ob1_recv_request_t **) malloc ((count + 1) * sizeof (reqs[0]));
+    if (NULL == reqs) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+
+    while (NULL != (item = opal_list_remove_first (&comm->wild_receives))) {
+        reqs[n++] = (mca_pml_ob1_recv_request_t *) item;
+    }
+
+    for (size_t i = 0 ; i < comm->num_procs ; ++i) {
+        mca_pml_ob1_comm_proc_t *proc = comm->procs[i];
+
+        if (NULL == proc) {
+            continue;
+        }
+        while (NULL != (item = opal_list_remove_first (&proc->specific_receives))) {
+            reqs[n++] = (mca_pml_ob1_recv_request_t *) item;
+        }
+        while (NULL != (item = opal_list_remove_first (&proc->unexpected_frags))) {
+            frag = (mca_pml_ob1_recv_frag_t *) item;
+            custom_match_hash_umq_append (comm->hash_umq, frag->hdr.hdr_match.hdr_tag,
+                                          frag->hdr.hdr_match.hdr_src, frag);
+        }
+    }
+
+    qsort (reqs, n, sizeof (reqs[0]), mca_pml_ob1_recv_sequence_cmp);
+    for (size_t i = 0 ; i < n ; ++i) {
+        custom_match_hash_prq_append (comm->hash_prq, reqs[i], reqs[i]->req_recv.req_base.req_tag,
+                                      reqs[i]->req_recv.req_base.req_peer);
+    }
+
+    free (reqs);
+    return OMPI_SUCCESS;
+}
+#endif
+
+int mca_pml_ob1_comm_init_hash (mca_pml_ob1_comm_t *comm)
+{
+    int rc = OMPI_SUCCESS;
+
+    if (NULL != comm->hash_prq) {
+        return OMPI_SUCCESS;
+    }
+
+#if MCA_PML_OB1_CUSTOM_MATCH
+    /* the engines selected at configure time cannot be walked */
+    if (custom_match_prq_size (comm->prq) || custom_match_umq_size (comm->umq)) {
+        return OMPI_ERR_NOT_SUPPORTED;
+    }
+#else
+    if (NULL != comm->shards) {
+        return OMPI_ERR_NOT_SUPPORTED;
+    }
+#endif
+
+    comm->hash_prq = custom_match_hash_prq_init();
+    comm->hash_umq = custom_match_hash_umq_init();
+    if (NULL != comm->hash_prq && NULL != comm->hash_umq) {
+#if !MCA_PML_OB1_CUSTOM_MATCH
+        rc = mca_pml_ob1_comm_move_to_hash (comm);
+#endif
+        if (OMPI_SUCCESS == rc) {
+            return OMPI_SUCCESS;
+        }
+    } else {
+        rc = OMPI_ERR_OUT_OF_RESOURCE;
+    }
+
+    free (comm->hash_prq);
+    free (comm->hash_umq);
+    comm->hash_prq = NULL;
+    comm->hash_umq = NULL;
+    return rc;
+}
+
+void mca_pml_ob1_comm_lock_all (mca_pml_ob1_comm_t *comm)
+{
+#if !MCA_PML_OB1_CUSTOM_MATCH
+    if (NULL != comm->shards) {
+        for (uint32_t i = 0 ; i <= comm->shard_mask ; ++i) {
+            OB1_MATCHING_LOCK(&comm->peer_locks[i]);
+        }
+        for (uint32_t i = 0 ; i <= comm->shard_mask ; ++i) {
+            OB1_MATCHING_LOCK(&comm->shards[i].lock);
+        }
+    }
+#endif
+    OB1_MATCHING_LOCK(&comm->matching_lock);
+}
+
+void mca_pml_ob1_comm_unlock_all (mca_pml_ob1_comm_t *comm)
+{
+    OB1_MATCHING_UNLOCK(&comm->matching_lock);
+#if !MCA_PML_OB1_CUSTOM_MATCH
+    if (NULL != comm->shards) {
+        for (uint32_t i = comm->shard_mask + 1 ; i > 0 ; --i) {
+            OB1_MATCHING_UNLOCK(&comm->shards[i - 1].lock);
+        }
+        for (uint32_t i = comm->shard_mask + 1 ; i > 0 ; --i) {
+            OB1_MATCHING_UNLOCK(&comm->peer_locks[i - 1]);
+        }
+    }
+#endif
+}
+
 mca_pml_ob1_comm_proc_t *mca_pml_ob1_peer_create (ompi_communicator_t *comm, mca_pml_ob1_comm_t *pml_comm, int rank)
 {
     mca_pml_ob1_comm_proc_t *proc = OBJ_NEW(mca_pml_ob1_comm_proc_t);
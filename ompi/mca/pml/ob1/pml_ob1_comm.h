@@ -36,6 +36,7 @@
 typedef struct mca_pml_ob1_comm_proc_t mca_pml_ob1_comm_proc_t;
 
 #include "custommatch/pml_ob1_custom_match.h"
+#include "custommatch/pml_ob1_custom_match_hash.h"
 
 BEGIN_C_DECLS
 
@@ -57,6 +58,43 @@ OBJ_CLASS_DECLARATION(mca_pml_ob1_comm_proc_t);
 
 #define MCA_PML_OB1_PROC_REQUIRES_EXT_MATCH(proc) (-1 == (proc)->comm_index)
 
+#define MCA_PML_OB1_MAX_SHARDS 256
+
+#define MCA_PML_OB1_SEARCH_HIST_BINS 8
+
+/**
+ * Matching statistics of a communicator, exposed as performance variables
+ * when built with --enable-pml-ob1-match-stats. They are updated under the
+ * matching lock, or with atomics on sharded communicators, whose queues are
+ * protected by several locks.
+ */
+struct mca_pml_ob1_match_stats_t {
+    opal_atomic_int64_t posted;           /**< receives in the posted queues */
+    opal_atomic_int64_t posted_hwm;
+    opal_atomic_int64_t unexpected;       /**< fragments in the unexpected queues */
+    opal_atomic_int64_t unexpected_hwm;
+    opal_atomic_int64_t unexpected_bytes; /**< data buffered in the unexpected fragments */
+    opal_atomic_int64_t out_of_sequence;  /**< fragments received out of sequence */
+    /** posted receives examined per incoming message: bin 0 counts the
+     * searches of no receive, bin i > 0 those of [2^(i-1), 2^i) receives,
+     * and the last bin all the longer ones */
+    opal_atomic_int64_t search_length[MCA_PML_OB1_SEARCH_HIST_BINS];
+};
+typedef struct mca_pml_ob1_match_stats_t mca_pml_ob1_match_stats_t;
+
+/**
+ * One shard of the sharded matching queues. A shard holds the posted
+ * receives and the unexpected fragments whose envelope hashes to it, each
+ * in posting (respectively arrival) order, and is protected by its own
+ * lock.
+ */
+struct mca_pml_ob1_match_shard_t {
+    opal_mutex_t lock;
+    opal_list_t posted;          /**< unmatched receives */
+    opal_list_t unexpected;      /**< unexpected fragments */
+};
+typedef struct mca_pml_ob1_match_shard_t mca_pml_ob1_match_shard_t;
+
 /**
  *  Cached on ompi_communicator_t to hold queues/state
  *  used by the PML<->PTL interface for matching logic.
@@ -67,6 +105,18 @@ struct mca_pml_comm_t {
     opal_mutex_t matching_lock;   /**< matching lock */
 #if !MCA_PML_OB1_CUSTOM_MATCH
     opal_list_t wild_receives;    /**< queue of unmatched wild (source process not specified) receives */
+    /* Sharded matching (NULL shards if not in use). The peer locks replace
+     * the matching lock for the sequence numbers and the out-of-sequence
+     * fragments of the peers hashing to them, the shard locks protect
+     * the shard queues, and the matching lock only protects
+     * wild_receives, which then holds the receives whose wildcard does
+     * not allow to select a shard. Locks are taken in this order. */
+    mca_pml_ob1_match_shard_t *shards;
+    opal_mutex_t *peer_locks;
+    uint32_t shard_mask;          /**< number of shards minus one */
+    bool shard_by_source;         /**< the source is part of the shard key */
+    bool shard_by_tag;            /**< the tag is part of the shard key */
+    opal_atomic_int64_t unexpected_stamp; /**< arrival order of the unexpected fragments */
 #endif
     opal_mutex_t proc_lock;
     mca_pml_ob1_comm_proc_t * volatile * procs;
@@ -75,6 +125,13 @@ struct mca_pml_comm_t {
 #if MCA_PML_OB1_CUSTOM_MATCH
     custom_match_prq* prq;
     custom_match_umq* umq;
+#endif
+    /* Hash-indexed exact matching (NULL if not in use). When set these
+     * replace the queues above, and are protected by the matching lock. */
+    custom_match_hash_prq *hash_prq;
+    custom_match_hash_umq *hash_umq;
+#if MCA_PML_OB1_MATCH_STATS
+    mca_pml_ob1_match_stats_t stats;
 #endif
 };
 typedef struct mca_pml_comm_t mca_pml_ob1_comm_t;
@@ -107,6 +164,133 @@ static inline mca_pml_ob1_comm_proc_t *mca_pml_ob1_peer_lookup (struct ompi_comm
     return pml_comm->procs[rank];
 }
 
+#if MCA_PML_OB1_MATCH_STATS
+/* Add delta to a statistic and return the new value. Without sharding the
+ * statistics are only updated under the matching lock. */
+static inline int64_t mca_pml_ob1_stats_add (mca_pml_ob1_comm_t *comm, opal_atomic_int64_t *stat, int64_t delta)
+{
+#if !MCA_PML_OB1_CUSTOM_MATCH
+    if (NULL != comm->shards) {
+        return opal_atomic_add_fetch_64 (stat, delta);
+    }
+#endif
+    return (*stat += delta);
+}
+
+static inline void mca_pml_ob1_stats_hwm (mca_pml_ob1_comm_t *comm, opal_atomic_int64_t *hwm, int64_t value)
+{
+#if !MCA_PML_OB1_CUSTOM_MATCH
+    if (NULL != comm->shards) {
+        (void) opal_atomic_fetch_max_64 (hwm, value);
+        return;
+    }
+#endif
+    if (value > *hwm) {
+        *hwm = value;
+    }
+}
+
+static inline void mca_pml_ob1_stats_posted (mca_pml_ob1_comm_t *comm, int64_t delta)
+{
+    int64_t posted = mca_pml_ob1_stats_add (comm, &comm->stats.posted, delta);
+
+    mca_pml_ob1_stats_hwm (comm, &comm->stats.posted_hwm, posted);
+}
+
+static inline void mca_pml_ob1_stats_unexpected (mca_pml_ob1_comm_t *comm, int64_t delta, size_t bytes)
+{
+    int64_t unexpected = mca_pml_ob1_stats_add (comm, &comm->stats.unexpected, delta);
+
+    (void) mca_pml_ob1_stats_add (comm, &comm->stats.unexpected_bytes, delta * (int64_t) bytes);
+    mca_pml_ob1_stats_hwm (comm, &comm->stats.unexpected_hwm, unexpected);
+}
+
+static inline void mca_pml_ob1_stats_search (mca_pml_ob1_comm_t *comm, size_t length)
+{
+    int bin = 0;
+
+    while (length && bin < MCA_PML_OB1_SEARCH_HIST_BINS - 1) {
+        length >>= 1;
+        ++bin;
+    }
+    (void) mca_pml_ob1_stats_add (comm, &comm->stats.search_length[bin], 1);
+}
+
+#define MCA_PML_OB1_STATS_POSTED(comm, delta) mca_pml_ob1_stats_posted ((comm), (delta))
+#define MCA_PML_OB1_STATS_UNEXPECTED(comm, delta, bytes) mca_pml_ob1_stats_unexpected ((comm), (delta), (bytes))
+#define MCA_PML_OB1_STATS_SEARCH(comm, length) mca_pml_ob1_stats_search ((comm), (length))
+#define MCA_PML_OB1_STATS_OUT_OF_SEQUENCE(comm) ((void) mca_pml_ob1_stats_add ((comm), &(comm)->stats.out_of_sequence, 1))
+#else
+#define MCA_PML_OB1_STATS_POSTED(comm, delta)
+#define MCA_PML_OB1_STATS_UNEXPECTED(comm, delta, bytes)
+#define MCA_PML_OB1_STATS_SEARCH(comm, length) ((void) (length))
+#define MCA_PML_OB1_STATS_OUT_OF_SEQUENCE(comm)
+#endif
+
+/**
+ * Lock serializing the matching of the fragments coming from a peer.
+ */
+static inline opal_mutex_t *mca_pml_ob1_comm_peer_lock (mca_pml_ob1_comm_t *comm, int src)
+{
+#if !MCA_PML_OB1_CUSTOM_MATCH
+    if (NULL != comm->shards) {
+        return comm->peer_locks + ((uint32_t) src & comm->shard_mask);
+    }
+#endif
+    return &comm->matching_lock;
+}
+
+#if !MCA_PML_OB1_CUSTOM_MATCH
+/**
+ * Whether a receive for (src, tag) can be matched within a single shard,
+ * i.e. none of its wildcards is part of the shard key.
+ */
+static inline bool mca_pml_ob1_comm_shard_local (const mca_pml_ob1_comm_t *comm, int src, int tag)
+{
+    return !((comm->shard_by_source && OMPI_ANY_SOURCE == src) ||
+             (comm->shard_by_tag && OMPI_ANY_TAG == tag));
+}
+
+static inline mca_pml_ob1_match_shard_t *mca_pml_ob1_comm_shard (mca_pml_ob1_comm_t *comm, int src, int tag)
+{
+    uint32_t key = 0;
+
+    /* multiplying by an odd constant keeps consecutive ranks (or tags
+     * for a given rank) on distinct shards */
+    if (comm->shard_by_source) {
+        key = (uint32_t) src * 0x9e3779b1u;
+    }
+    if (comm->shard_by_tag) {
+        key += (uint32_t) tag;
+    }
+
+    return comm->shards + (key & comm->shard_mask);
+}
+#endif
+
+/**
+ * Set up sharded matching on a communicator with the given number of
+ * shards (rounded up to a power of two). The shard key is selected from
+ * the communicator's no_any_source and no_any_tag assertions.
+ */
+int mca_pml_ob1_comm_init_shards (mca_pml_ob1_comm_t *comm, ompi_communicator_t *ompi_comm, int num_shards);
+
+/**
+ * Switch the communicator to hash-indexed exact matching, moving the
+ * pending receives and unexpected fragments to the hash queues. Called
+ * with the matching lock held. Sharded communicators, and communicators
+ * with pending messages in an engine selected at configure time, cannot
+ * be switched (OMPI_ERR_NOT_SUPPORTED).
+ */
+int mca_pml_ob1_comm_init_hash (mca_pml_ob1_comm_t *comm);
+
+/**
+ * Take (release) every matching lock of the communicator, for the
+ * operations walking all of its queues.
+ */
+void mca_pml_ob1_comm_lock_all (mca_pml_ob1_comm_t *comm);
+void mca_pml_ob1_comm_unlock_all (mca_pml_ob1_comm_t *comm);
+
 /**
  * Initialize an instance of mca_pml_ob1_comm_t based on the communicator size.
  *
@@ -144,6 +144,64 @@ static int mca_pml_ob1_comm_size_notify (mca_base_pvar_t *pvar, mca_base_pvar_ev
     return OMPI_SUCCESS;
 }
 
+/* Count per peer the elements of the queues of a communicator using hash
+ * matching */
+static void mca_pml_ob1_count_hash_queues (mca_pml_ob1_comm_t *pml_comm, unsigned *values, int comm_size,
+                                           bool posted)
+{
+    custom_match_hash_node *elem;
+
+    memset (values, 0, comm_size * sizeof (values[0]));
+
+    if (!posted) {
+        for (elem = pml_comm->hash_umq->first ; elem ; elem = elem->all_next) {
+            if (0 <= elem->src && elem->src < comm_size) {
+                values[elem->src]++;
+            }
+        }
+        return;
+    }
+
+    for (int b = 0 ; b <= CUSTOM_MATCH_HASH_BUCKETS ; ++b) {
+        elem = (CUSTOM_MATCH_HASH_BUCKETS == b) ? pml_comm->hash_prq->wild.head :
+            pml_comm->hash_prq->buckets[b].head;
+        for ( ; elem ; elem = elem->next) {
+            if (0 <= elem->src && elem->src < comm_size) {
+                values[elem->src]++;
+            }
+        }
+    }
+}
+
+#if !MCA_PML_OB1_CUSTOM_MATCH
+/* Count per peer the elements of the shard queues of a sharded communicator */
+static void mca_pml_ob1_count_shard_queues (mca_pml_ob1_comm_t *pml_comm, unsigned *values, int comm_size,
+                                            bool posted)
+{
+    memset (values, 0, comm_size * sizeof (values[0]));
+
+    for (uint32_t s = 0 ; s <= pml_comm->shard_mask ; ++s) {
+        if (posted) {
+            mca_pml_ob1_recv_request_t *req;
+            OPAL_LIST_FOREACH(req, &pml_comm->shards[s].posted, mca_pml_ob1_recv_request_t) {
+                int peer = req->req_recv.req_base.req_peer;
+                if (0 <= peer && peer < comm_size) {
+                    values[peer]++;
+                }
+            }
+        } else {
+            mca_pml_ob1_recv_frag_t *frag;
+            OPAL_LIST_FOREACH(frag, &pml_comm->shards[s].unexpected, mca_pml_ob1_recv_frag_t) {
+                int src = frag->hdr.hdr_match.hdr_src;
+                if (0 <= src && src < comm_size) {
+                    values[src]++;
+                }
+            }
+        }
+    }
+}
+#endif
+
 static int mca_pml_ob1_get_unex_msgq_size (const struct mca_base_pvar_t *pvar, void *value, void *obj_handle)
 {
     ompi_communicator_t *comm = (ompi_communicator_t *) obj_handle;
@@ -153,6 +211,17 @@ static int mca_pml_ob1_get_unex_msgq_size (const struct mca_base_pvar_t *pvar, v
     mca_pml_ob1_comm_proc_t *pml_proc;
     int i;
 
+    if (NULL != pml_comm->hash_umq) {
+        mca_pml_ob1_count_hash_queues (pml_comm, values, comm_size, false);
+        return OMPI_SUCCESS;
+    }
+#if !MCA_PML_OB1_CUSTOM_MATCH
+    if (NULL != pml_comm->shards) {
+        mca_pml_ob1_count_shard_queues (pml_comm, values, comm_size, false);
+        return OMPI_SUCCESS;
+    }
+#endif
+
     for (i = 0 ; i < comm_size ; ++i) {
         pml_proc = pml_comm->procs[i];
         if (pml_proc) {
@@ -179,6 +248,17 @@ static int mca_pml_ob1_get_posted_recvq_size (const struct mca_base_pvar_t *pvar
     mca_pml_ob1_comm_proc_t *pml_proc;
     int i;
 
+    if (NULL != pml_comm->hash_prq) {
+        mca_pml_ob1_count_hash_queues (pml_comm, values, comm_size, true);
+        return OMPI_SUCCESS;
+    }
+#if !MCA_PML_OB1_CUSTOM_MATCH
+    if (NULL != pml_comm->shards) {
+        mca_pml_ob1_count_shard_queues (pml_comm, values, comm_size, true);
+        return OMPI_SUCCESS;
+    }
+#endif
+
     for (i = 0 ; i < comm_size ; ++i) {
         pml_proc = pml_comm->procs[i];
 
@@ -197,8 +277,44 @@ static int mca_pml_ob1_get_posted_recvq_size (const struct mca_base_pvar_t *pvar
     return OMPI_SUCCESS;
 }
 
+#if MCA_PML_OB1_MATCH_STATS
+static int mca_pml_ob1_match_stat_notify (mca_base_pvar_t *pvar, mca_base_pvar_event_t event, void *obj_handle, int *count)
+{
+    if (MCA_BASE_PVAR_HANDLE_BIND == event) {
+        *count = ((uintptr_t) pvar->ctx == offsetof(mca_pml_ob1_match_stats_t, search_length)) ?
+            MCA_PML_OB1_SEARCH_HIST_BINS : 1;
+    }
+
+    return OMPI_SUCCESS;
+}
+
+/* The statistics are read without the matching lock: the values may be
+ * slightly out of date, but each one is consistent. */
+static int mca_pml_ob1_get_match_stat (const struct mca_base_pvar_t *pvar, void *value, void *obj_handle)
+{
+    ompi_communicator_t *comm = (ompi_communicator_t *) obj_handle;
+    mca_pml_ob1_comm_t *pml_comm = comm->c_pml_comm;
+    size_t offset = (uintptr_t) pvar->ctx;
+    int count = (offset == offsetof(mca_pml_ob1_match_stats_t, search_length)) ?
+        MCA_PML_OB1_SEARCH_HIST_BINS : 1;
+
+    memcpy (value, (char *) &pml_comm->stats + offset, count * sizeof (int64_t));
+
+    return OMPI_SUCCESS;
+}
+#endif
+
+static const mca_base_var_enum_value_t mca_pml_ob1_matching_engine_values[] = {
+    {MCA_PML_OB1_MATCHING_AUTO, "auto"},
+    {MCA_PML_OB1_MATCHING_LISTS, "lists"},
+    {MCA_PML_OB1_MATCHING_HASH, "hash"},
+    {0, NULL}
+};
+
 static int mca_pml_ob1_component_register(void)
 {
+    mca_base_var_enum_t *matching_engine_enum;
+
     mca_pml_ob1_param_register_int("verbose", 0, &mca_pml_ob1_verbose);
 
     mca_pml_ob1_param_register_int("free_list_num", 4, &mca_pml_ob1.free_list_num);
@@ -219,6 +335,41 @@ static int mca_pml_ob1_component_register(void)
 
     mca_pml_ob1_param_register_uint("unexpected_limit", 128, &mca_pml_ob1.unexpected_limit);
 
+    mca_pml_ob1.matching_shards = 0;
+    (void) mca_base_component_var_register(&mca_pml_ob1_component.pmlm_version, "matching_shards",
+                                           "Number of shards the matching queues of each communicator are split "
+                                           "into, by hash of the source and tag, each with its own lock. Reduces "
+                                           "the contention between threads receiving on the same communicator. "
+                                           "The mpi_assert_no_any_source and mpi_assert_no_any_tag info keys "
+                                           "select a key that avoids the wildcard fallback (default: 0, disabled)",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0, OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_READONLY, &mca_pml_ob1.matching_shards);
+
+    mca_pml_ob1.matching_engine = MCA_PML_OB1_MATCHING_LISTS;
+    (void) mca_base_var_enum_create("pml_ob1_matching_engine", mca_pml_ob1_matching_engine_values,
+                                    &matching_engine_enum);
+    (void) mca_base_component_var_register(&mca_pml_ob1_component.pmlm_version, "matching_engine",
+                                           "Matching engine of the communicators: \"lists\" for the per-peer "
+                                           "queues (or the engine selected at configure time), \"hash\" for "
+                                           "hash tables indexed by source and tag, \"auto\" for hash matching "
+                                           "on the communicators asserting mpi_assert_no_any_source and "
+                                           "mpi_assert_no_any_tag, or whose posted receive queues grow past "
+                                           "hash_matching_threshold. The ompi_pml_ob1_matching info key selects "
+                                           "the engine of a communicator. Not used on sharded communicators "
+                                           "(default: lists)",
+                                           MCA_BASE_VAR_TYPE_INT, matching_engine_enum, 0, 0, OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_READONLY, &mca_pml_ob1.matching_engine);
+    OBJ_RELEASE(matching_engine_enum);
+
+    mca_pml_ob1.hash_matching_threshold = 64;
+    (void) mca_base_component_var_register(&mca_pml_ob1_component.pmlm_version, "hash_matching_threshold",
+                                           "Number of receives posted for a peer (or with MPI_ANY_SOURCE) above "
+                                           "which the automatic engine selection switches a communicator to hash "
+                                           "matching. Only the per-peer queues can be switched once in use, not "
+                                           "the engines selected at configure time (default: 64, 0: never)",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0, OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_READONLY, &mca_pml_ob1.hash_matching_threshold);
+
     mca_pml_ob1.use_all_rdma = false;
     (void) mca_base_component_var_register(&mca_pml_ob1_component.pmlm_version, "use_all_rdma",
                                            "Use all available RDMA btls for the RDMA and RDMA pipeline protocols "
@@ -244,6 +395,51 @@ static int mca_pml_ob1_component_register(void)
                                            MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_CONTINUOUS,
                                            mca_pml_ob1_get_posted_recvq_size, NULL, mca_pml_ob1_comm_size_notify, NULL);
 
+#if MCA_PML_OB1_MATCH_STATS
+    (void)mca_base_component_pvar_register(&mca_pml_ob1_component.pmlm_version,
+                                           "posted_recvq_hwm", "Highest number of unmatched receives "
+                                           "posted in a communicator", OPAL_INFO_LVL_4, MPI_T_PVAR_CLASS_HIGHWATERMARK,
+                                           MCA_BASE_VAR_TYPE_UINT64_T, NULL, MPI_T_BIND_MPI_COMM,
+                                           MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                           mca_pml_ob1_get_match_stat, NULL, mca_pml_ob1_match_stat_notify,
+                                           (void *) offsetof(mca_pml_ob1_match_stats_t, posted_hwm));
+
+    (void)mca_base_component_pvar_register(&mca_pml_ob1_component.pmlm_version,
+                                           "unexpected_msgq_hwm", "Highest number of unexpected messages "
+                                           "queued in a communicator", OPAL_INFO_LVL_4, MPI_T_PVAR_CLASS_HIGHWATERMARK,
+                                           MCA_BASE_VAR_TYPE_UINT64_T, NULL, MPI_T_BIND_MPI_COMM,
+                                           MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                           mca_pml_ob1_get_match_stat, NULL, mca_pml_ob1_match_stat_notify,
+                                           (void *) offsetof(mca_pml_ob1_match_stats_t, unexpected_hwm));
+
+    (void)mca_base_component_pvar_register(&mca_pml_ob1_component.pmlm_version,
+                                           "unexpected_bytes", "Number of bytes buffered in the unexpected "
+                                           "messages of a communicator", OPAL_INFO_LVL_4, MPI_T_PVAR_CLASS_SIZE,
+                                           MCA_BASE_VAR_TYPE_UINT64_T, NULL, MPI_T_BIND_MPI_COMM,
+                                           MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                           mca_pml_ob1_get_match_stat, NULL, mca_pml_ob1_match_stat_notify,
+                                           (void *) offsetof(mca_pml_ob1_match_stats_t, unexpected_bytes));
+
+    (void)mca_base_component_pvar_register(&mca_pml_ob1_component.pmlm_version,
+                                           "out_of_sequence_frags", "Number of messages received out of "
+                                           "sequence in a communicator", OPAL_INFO_LVL_4, MPI_T_PVAR_CLASS_COUNTER,
+                                           MCA_BASE_VAR_TYPE_UINT64_T, NULL, MPI_T_BIND_MPI_COMM,
+                                           MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                           mca_pml_ob1_get_match_stat, NULL, mca_pml_ob1_match_stat_notify,
+                                           (void *) offsetof(mca_pml_ob1_match_stats_t, out_of_sequence));
+
+    (void)mca_base_component_pvar_register(&mca_pml_ob1_component.pmlm_version,
+                                           "match_search_length", "Histogram of the number of posted receives "
+                                           "examined to match an incoming message in a communicator: 0, then "
+                                           "[2^(i-1), 2^i) for the bin i, the last bin holding the longer searches. "
+                                           "Not recorded with hash matching, nor the engines selected at configure time",
+                                           OPAL_INFO_LVL_4, MPI_T_PVAR_CLASS_COUNTER,
+                                           MCA_BASE_VAR_TYPE_UINT64_T, NULL, MPI_T_BIND_MPI_COMM,
+                                           MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                           mca_pml_ob1_get_match_stat, NULL, mca_pml_ob1_match_stat_notify,
+                                           (void *) offsetof(mca_pml_ob1_match_stats_t, search_length));
+#endif
+
     mca_pml_ob1_accelerator_events_max = 400;
     (void) mca_base_component_var_register(&mca_pml_ob1_component.pmlm_version, "accelerator_events_max",
                                            "Number of events created by the ob1 component internally",
@@ -88,7 +88,34 @@ append_frag_to_list(opal_list_t *queue, mca_btl_base_module_t *btl,
     opal_list_append(queue, (opal_list_item_t*)frag);
 }
 
-#if MCA_PML_OB1_CUSTOM_MATCH
+static void
+append_frag_to_hash(custom_match_hash_umq *queue, mca_btl_base_module_t *btl,
+                    const mca_pml_ob1_match_hdr_t *hdr, const mca_btl_base_segment_t *segments,
+                    size_t num_segments, mca_pml_ob1_recv_frag_t* frag)
+{
+    if(NULL == frag) {
+        MCA_PML_OB1_RECV_FRAG_ALLOC(frag);
+        MCA_PML_OB1_RECV_FRAG_INIT(frag, hdr, segments, num_segments, btl);
+    }
+    custom_match_hash_umq_append(queue, hdr->hdr_tag, hdr->hdr_src, frag);
+}
+
+#if !MCA_PML_OB1_CUSTOM_MATCH
+
+static void
+append_frag_to_shard(mca_pml_ob1_comm_t *comm, mca_pml_ob1_match_shard_t *shard,
+                     mca_btl_base_module_t *btl, const mca_pml_ob1_match_hdr_t *hdr,
+                     const mca_btl_base_segment_t *segments, size_t num_segments,
+                     mca_pml_ob1_recv_frag_t* frag)
+{
+    if(NULL == frag) {
+        MCA_PML_OB1_RECV_FRAG_ALLOC(frag);
+        MCA_PML_OB1_RECV_FRAG_INIT(frag, hdr, segments, num_segments, btl);
+    }
+    mca_pml_ob1_shard_append_unexpected(comm, shard, frag);
+}
+
+#else
 
 static void
 append_frag_to_umq(custom_match_umq *queue, mca_btl_base_module_t *btl,
@@ -351,7 +378,7 @@ int mca_pml_ob1_revoke_comm( struct ompi_communicator_t* ompi_comm, bool coll_on
 
     OBJ_CONSTRUCT(&nack_list, opal_list_t);
 
-    OPAL_THREAD_LOCK(&comm->matching_lock);
+    mca_pml_ob1_comm_lock_all(comm);
     /* these assignments need to be here because we need the matching_lock */
     ompi_comm->coll_revoked = true;
     if( !coll_only ) ompi_comm->comm_revoked = true;
@@ -363,6 +390,36 @@ int mca_pml_ob1_revoke_comm( struct ompi_communicator_t* ompi_comm, bool coll_on
     }
 #endif /* OPAL_ENABLE_DEBUG */
 
+    if (NULL != comm->hash_umq) {
+        custom_match_hash_node *elem, *next;
+        for (elem = comm->hash_umq->first; NULL != elem; elem = next) {
+            mca_pml_ob1_recv_frag_t* frag = (mca_pml_ob1_recv_frag_t*)elem->value;
+            next = elem->all_next;
+            if( pml_ob1_frag_is_revoked(ompi_comm, frag) ) {
+                custom_match_hash_umq_remove_hold(comm->hash_umq, elem);
+                MCA_PML_OB1_STATS_UNEXPECTED(comm, -1, mca_pml_ob1_compute_segment_length_base (frag->segments, frag->num_segments, 0));
+                opal_list_append(&nack_list, &frag->super.super);
+            }
+        }
+    }
+
+#if !MCA_PML_OB1_CUSTOM_MATCH
+    /* the unexpected fragments of a sharded communicator are in the shards */
+    for (i = 0; NULL != comm->shards && i <= comm->shard_mask; i++) {
+        opal_list_t* frags_list = &comm->shards[i].unexpected;
+        for( it = opal_list_get_first(frags_list);
+             it != opal_list_get_end(frags_list);
+             it = opal_list_get_next(it) ) {
+            mca_pml_ob1_recv_frag_t* frag = (mca_pml_ob1_recv_frag_t*)it;
+            if( pml_ob1_frag_is_revoked(ompi_comm, frag) ) {
+                it = opal_list_remove_item( frags_list, it );
+                MCA_PML_OB1_STATS_UNEXPECTED(comm, -1, mca_pml_ob1_compute_segment_length_base (frag->segments, frag->num_segments, 0));
+                opal_list_append(&nack_list, &frag->super.super);
+            }
+        }
+    }
+#endif
+
     /* loop over all procs in that comm */
     for (i = 0; i < comm->num_procs; i++) {
         proc = comm->procs[i];
@@ -380,6 +437,7 @@ int mca_pml_ob1_revoke_comm( struct ompi_communicator_t* ompi_comm, bool coll_on
             mca_pml_ob1_recv_frag_t* frag = (mca_pml_ob1_recv_frag_t*)it;
             if( pml_ob1_frag_is_revoked(ompi_comm, frag) ) {
                 it = opal_list_remove_item( frags_list, it );
+                MCA_PML_OB1_STATS_UNEXPECTED(comm, -1, mca_pml_ob1_compute_segment_length_base (frag->segments, frag->num_segments, 0));
                 opal_list_append(&nack_list, &frag->super.super);
             }
         }
@@ -413,7 +471,7 @@ int mca_pml_ob1_revoke_comm( struct ompi_communicator_t* ompi_comm, bool coll_on
         if( verbose > 15) mca_pml_ob1_dump(ompi_comm, verbose);
     }
 #endif
-    OPAL_THREAD_UNLOCK(&comm->matching_lock);
+    mca_pml_ob1_comm_unlock_all(comm);
     while( NULL != (it = opal_list_remove_first(&nack_list)) ) {
         mca_pml_ob1_recv_frag_t* frag = (mca_pml_ob1_recv_frag_t*)it;
         mca_pml_ob1_hdr_t* hdr = (mca_pml_ob1_hdr_t*)frag->segments->seg_addr.pval;
@@ -459,6 +517,7 @@ void mca_pml_ob1_recv_frag_callback_match (mca_btl_base_module_t *btl,
     mca_pml_ob1_recv_request_t *match = NULL;
     mca_pml_ob1_comm_t *comm;
     mca_pml_ob1_comm_proc_t *proc;
+    opal_mutex_t *peer_lock;
     size_t num_segments = descriptor->des_segment_count;
     size_t bytes_received = 0;
 
@@ -487,6 +546,7 @@ void mca_pml_ob1_recv_frag_callback_match (mca_btl_base_module_t *btl,
 
     /* source sequence number */
     proc = mca_pml_ob1_peer_lookup (comm_ptr, hdr->hdr_src);
+    peer_lock = mca_pml_ob1_comm_peer_lock (comm, hdr->hdr_src);
 
     /* We generate the MSG_ARRIVED event as soon as the PML is aware
      * of a matching fragment arrival. Independing if it is received
@@ -504,14 +564,14 @@ void mca_pml_ob1_recv_frag_callback_match (mca_btl_base_module_t *btl,
      * end points) from being processed, and potentially "losing"
      * the fragment.
      */
-    OB1_MATCHING_LOCK(&comm->matching_lock);
+    OB1_MATCHING_LOCK(peer_lock);
 
 #if OPAL_ENABLE_FT_MPI
     if( OPAL_UNLIKELY((ompi_comm_is_revoked(comm_ptr) && !ompi_request_tag_is_ft(hdr->hdr_tag)) ||
                       (ompi_comm_coll_revoked(comm_ptr) && ompi_request_tag_is_collective(hdr->hdr_tag))) ) {
         /* if it's a TYPE_MATCH, the sender is not expecting anything from us
          * so we are done. */
-        OPAL_THREAD_UNLOCK(&comm->matching_lock);
+        OPAL_THREAD_UNLOCK(peer_lock);
         OPAL_OUTPUT_VERBOSE((15, ompi_ftmpi_output_handle,
             "ob1_revoke_comm: dropping silently frag from %d", hdr->hdr_src));
         return;
@@ -529,7 +589,8 @@ void mca_pml_ob1_recv_frag_callback_match (mca_btl_base_module_t *btl,
             MCA_PML_OB1_RECV_FRAG_INIT(frag, hdr, segments, num_segments, btl);
             ompi_pml_ob1_append_frag_to_ordered_list(&proc->frags_cant_match, frag, proc->expected_sequence);
             SPC_RECORD(OMPI_SPC_OUT_OF_SEQUENCE, 1);
-            OB1_MATCHING_UNLOCK(&comm->matching_lock);
+            MCA_PML_OB1_STATS_OUT_OF_SEQUENCE(comm);
+            OB1_MATCHING_UNLOCK(peer_lock);
             return;
         }
 
@@ -554,7 +615,7 @@ void mca_pml_ob1_recv_frag_callback_match (mca_btl_base_module_t *btl,
                            hdr->hdr_src, hdr->hdr_tag, PERUSE_RECV);
 
     /* release matching lock before processing fragment */
-    OB1_MATCHING_UNLOCK(&comm->matching_lock);
+    OB1_MATCHING_UNLOCK(peer_lock);
 
     if(OPAL_LIKELY(match)) {
         bytes_received = segments->seg_len - OMPI_PML_OB1_MATCH_HDR_LEN;
@@ -623,7 +684,7 @@ void mca_pml_ob1_recv_frag_callback_match (mca_btl_base_module_t *btl,
     if(NULL != proc->frags_cant_match) {
         mca_pml_ob1_recv_frag_t* frag;
 
-        OB1_MATCHING_LOCK(&comm->matching_lock);
+        OB1_MATCHING_LOCK(peer_lock);
         if((frag = ompi_pml_ob1_check_cantmatch_for_match(proc))) {
             /* mca_pml_ob1_recv_frag_match_proc() will release the lock. */
             mca_pml_ob1_recv_frag_match_proc(frag->btl, comm_ptr, proc,
@@ -631,7 +692,7 @@ void mca_pml_ob1_recv_frag_callback_match (mca_btl_base_module_t *btl,
                                              frag->segments, frag->num_segments,
                                              frag->hdr.hdr_match.hdr_common.hdr_type, frag);
         } else {
-            OB1_MATCHING_UNLOCK(&comm->matching_lock);
+            OB1_MATCHING_UNLOCK(peer_lock);
         }
     }
 }
@@ -646,9 +707,12 @@ int mca_pml_ob1_merge_cant_match( ompi_communicator_t * ompi_comm )
     mca_pml_ob1_comm_proc_t* proc;
     int cnt = 0;
 
-    OB1_MATCHING_LOCK(&pml_comm->matching_lock);
     for (uint32_t i = 0; i < pml_comm->num_procs; i++) {
+        opal_mutex_t *peer_lock = mca_pml_ob1_comm_peer_lock(pml_comm, i);
+
+        OB1_MATCHING_LOCK(peer_lock);
         if ((NULL == (proc = pml_comm->procs[i])) || (NULL != proc->frags_cant_match)) {
+            OB1_MATCHING_UNLOCK(peer_lock);
             continue;
         }
 
@@ -661,11 +725,11 @@ int mca_pml_ob1_merge_cant_match( ompi_communicator_t * ompi_comm )
                                              &frag->hdr.hdr_match,
                                              frag->segments, frag->num_segments,
                                              frag->hdr.hdr_match.hdr_common.hdr_type, frag);
-            OB1_MATCHING_LOCK(&pml_comm->matching_lock);
+            OB1_MATCHING_LOCK(peer_lock);
             cnt++;
         }
+        OB1_MATCHING_UNLOCK(peer_lock);
     }
-    OB1_MATCHING_UNLOCK(&pml_comm->matching_lock);
     return cnt;
 }
 
@@ -868,6 +932,7 @@ static mca_pml_ob1_recv_request_t *match_incomming(const mca_pml_ob1_match_hdr_t
     mca_pml_ob1_recv_request_t *specific_recv, *wild_recv;
     mca_pml_sequence_t wild_recv_seq, specific_recv_seq;
     int tag = hdr->hdr_tag;
+    size_t examined = 0;
 
     specific_recv = get_posted_recv(&proc->specific_receives);
     wild_recv = get_posted_recv(&comm->wild_receives);
@@ -894,11 +959,13 @@ static mca_pml_ob1_recv_request_t *match_incomming(const mca_pml_ob1_match_hdr_t
             seq = &specific_recv_seq;
         }
 
+        ++examined;
         req_tag = (*match)->req_recv.req_base.req_tag;
         if(req_tag == tag || (req_tag == OMPI_ANY_TAG && tag >= 0)) {
             opal_list_remove_item(queue, (opal_list_item_t*)(*match));
             PERUSE_TRACE_COMM_EVENT(PERUSE_COMM_REQ_REMOVE_FROM_POSTED_Q,
                     &((*match)->req_recv.req_base), PERUSE_RECV);
+            MCA_PML_OB1_STATS_SEARCH(comm, examined);
             return *match;
         }
 
@@ -906,6 +973,7 @@ static mca_pml_ob1_recv_request_t *match_incomming(const mca_pml_ob1_match_hdr_t
         *seq = (*match) ? (*match)->req_recv.req_base.req_sequence : PML_MAX_SEQ;
     }
 
+    MCA_PML_OB1_STATS_SEARCH(comm, examined);
     return NULL;
 #else
     return custom_match_prq_find_dequeue_verify(comm->prq, hdr->hdr_tag, hdr->hdr_src);
@@ -919,20 +987,82 @@ static mca_pml_ob1_recv_request_t *match_incomming_no_any_source (const mca_pml_
 {
     mca_pml_ob1_recv_request_t *recv_req;
     int tag = hdr->hdr_tag;
+    size_t examined = 0;
 
     OPAL_LIST_FOREACH(recv_req, &proc->specific_receives, mca_pml_ob1_recv_request_t) {
         int req_tag = recv_req->req_recv.req_base.req_tag;
 
+        ++examined;
         if (req_tag == tag || (req_tag == OMPI_ANY_TAG && tag >= 0)) {
             opal_list_remove_item (&proc->specific_receives, (opal_list_item_t *) recv_req);
             PERUSE_TRACE_COMM_EVENT(PERUSE_COMM_REQ_REMOVE_FROM_POSTED_Q,
                     &(recv_req->req_recv.req_base), PERUSE_RECV);
+            MCA_PML_OB1_STATS_SEARCH(comm, examined);
             return recv_req;
         }
     }
 
+    MCA_PML_OB1_STATS_SEARCH(comm, examined);
     return NULL;
 }
+
+/* Called with the shard lock held, in addition to the peer lock. */
+static mca_pml_ob1_recv_request_t *match_incomming_sharded (const mca_pml_ob1_match_hdr_t *hdr,
+                                                            mca_pml_ob1_comm_t *comm,
+                                                            mca_pml_ob1_match_shard_t *shard)
+{
+    mca_pml_ob1_recv_request_t *recv_req, *specific_recv = NULL, *match = NULL;
+    int src = hdr->hdr_src, tag = hdr->hdr_tag;
+    size_t examined = 0;
+
+    OPAL_LIST_FOREACH(recv_req, &shard->posted, mca_pml_ob1_recv_request_t) {
+        ++examined;
+        if (recv_req_match_envelope (recv_req, src, tag)) {
+            specific_recv = recv_req;
+            break;
+        }
+    }
+
+    /* Receives are only added to wild_receives with all the shard locks
+     * held, so it cannot grow while we hold ours. */
+    if (OPAL_LIKELY(0 == opal_list_get_size (&comm->wild_receives))) {
+        if (NULL != specific_recv) {
+            opal_list_remove_item (&shard->posted, (opal_list_item_t *) specific_recv);
+            PERUSE_TRACE_COMM_EVENT(PERUSE_COMM_REQ_REMOVE_FROM_POSTED_Q,
+                                    &(specific_recv->req_recv.req_base), PERUSE_RECV);
+        }
+        MCA_PML_OB1_STATS_SEARCH(comm, examined);
+        return specific_recv;
+    }
+
+    /* the earliest posted of the two receives wins */
+    OB1_MATCHING_LOCK(&comm->matching_lock);
+    OPAL_LIST_FOREACH(recv_req, &comm->wild_receives, mca_pml_ob1_recv_request_t) {
+        ++examined;
+        if (recv_req_match_envelope (recv_req, src, tag)) {
+            if (NULL == specific_recv ||
+                recv_req->req_recv.req_base.req_sequence < specific_recv->req_recv.req_base.req_sequence) {
+                opal_list_remove_item (&comm->wild_receives, (opal_list_item_t *) recv_req);
+                match = recv_req;
+            }
+            break;
+        }
+    }
+    OB1_MATCHING_UNLOCK(&comm->matching_lock);
+
+    if (NULL == match && NULL != specific_recv) {
+        opal_list_remove_item (&shard->posted, (opal_list_item_t *) specific_recv);
+        match = specific_recv;
+    }
+
+    if (NULL != match) {
+        PERUSE_TRACE_COMM_EVENT(PERUSE_COMM_REQ_REMOVE_FROM_POSTED_Q,
+                                &(match->req_recv.req_base), PERUSE_RECV);
+    }
+
+    MCA_PML_OB1_STATS_SEARCH(comm, examined);
+    return match;
+}
 #endif
 
 static mca_pml_ob1_recv_request_t *match_one (mca_btl_base_module_t *btl,
@@ -942,6 +1072,7 @@ static mca_pml_ob1_recv_request_t *match_one (mca_btl_base_module_t *btl,
                                               mca_pml_ob1_comm_proc_t *proc,
                                               mca_pml_ob1_recv_frag_t* frag)
 {
+    opal_mutex_t *shard_lock = NULL;
 #if SPC_ENABLE == 1
     opal_timer_t timer = 0;
 #endif
@@ -949,20 +1080,37 @@ static mca_pml_ob1_recv_request_t *match_one (mca_btl_base_module_t *btl,
 
     mca_pml_ob1_recv_request_t *match;
     mca_pml_ob1_comm_t *comm = (mca_pml_ob1_comm_t *)comm_ptr->c_pml_comm;
+#if !MCA_PML_OB1_CUSTOM_MATCH
+    mca_pml_ob1_match_shard_t *shard = NULL;
+
+    if (NULL != comm->shards) {
+        /* the peer lock, held by the caller until we are done, keeps the
+         * messages of the peer in order across shards */
+        shard = mca_pml_ob1_comm_shard (comm, hdr->hdr_src, hdr->hdr_tag);
+        shard_lock = &shard->lock;
+        OB1_MATCHING_LOCK(shard_lock);
+    }
+#endif
 
     do {
+        if (NULL != comm->hash_prq) {
+            match = custom_match_hash_prq_find_dequeue_verify (comm->hash_prq, hdr->hdr_tag, hdr->hdr_src);
 #if MCA_PML_OB1_CUSTOM_MATCH
-        match = match_incomming(hdr, comm, proc);
+        } else {
+            match = match_incomming(hdr, comm, proc);
 #else
-        if (!OMPI_COMM_CHECK_ASSERT_NO_ANY_SOURCE (comm_ptr)) {
+        } else if (NULL != shard) {
+            match = match_incomming_sharded (hdr, comm, shard);
+        } else if (!OMPI_COMM_CHECK_ASSERT_NO_ANY_SOURCE (comm_ptr)) {
             match = match_incomming(hdr, comm, proc);
         } else {
             match = match_incomming_no_any_source (hdr, comm, proc);
-        }
 #endif
+        }
 
         /* if match found, process data */
         if(OPAL_LIKELY(NULL != match)) {
+            MCA_PML_OB1_STATS_POSTED(comm, -1);
             match->req_recv.req_base.req_proc = proc->ompi_proc;
 
             if(OPAL_UNLIKELY(MCA_PML_REQUEST_PROBE == match->req_recv.req_base.req_type)) {
@@ -988,29 +1136,48 @@ static mca_pml_ob1_recv_request_t *match_one (mca_btl_base_module_t *btl,
                                                        num_segments);
                 /* this frag is already processed, so we want to break out
                    of the loop and not end up back on the unexpected queue. */
+                if (NULL != shard_lock) {
+                    OB1_MATCHING_UNLOCK(shard_lock);
+                }
                 SPC_TIMER_STOP(OMPI_SPC_MATCH_TIME, &timer);
                 return NULL;
             }
 
             PERUSE_TRACE_COMM_EVENT(PERUSE_COMM_MSG_MATCH_POSTED_REQ,
                                     &(match->req_recv.req_base), PERUSE_RECV);
+            if (NULL != shard_lock) {
+                OB1_MATCHING_UNLOCK(shard_lock);
+            }
             SPC_TIMER_STOP(OMPI_SPC_MATCH_TIME, &timer);
             return match;
         }
 
         /* if no match found, place on unexpected queue */
+        if (NULL != comm->hash_umq) {
+            append_frag_to_hash(comm->hash_umq, btl, hdr, segments,
+                                num_segments, frag);
 #if MCA_PML_OB1_CUSTOM_MATCH
-        append_frag_to_umq(comm->umq, btl, hdr, segments,
-                            num_segments, frag);
+        } else {
+            append_frag_to_umq(comm->umq, btl, hdr, segments,
+                                num_segments, frag);
 #else
-        append_frag_to_list(&proc->unexpected_frags, btl, hdr, segments,
-                            num_segments, frag);
+        } else if (NULL != shard) {
+            append_frag_to_shard(comm, shard, btl, hdr, segments,
+                                 num_segments, frag);
+        } else {
+            append_frag_to_list(&proc->unexpected_frags, btl, hdr, segments,
+                                num_segments, frag);
 #endif
+        }
         SPC_RECORD(OMPI_SPC_UNEXPECTED, 1);
         SPC_RECORD(OMPI_SPC_UNEXPECTED_IN_QUEUE, 1);
+        MCA_PML_OB1_STATS_UNEXPECTED(comm, 1, mca_pml_ob1_compute_segment_length_base (segments, num_segments, 0));
         SPC_UPDATE_WATERMARK(OMPI_SPC_MAX_UNEXPECTED_IN_QUEUE, OMPI_SPC_UNEXPECTED_IN_QUEUE);
         PERUSE_TRACE_MSG_EVENT(PERUSE_COMM_MSG_INSERT_IN_UNEX_Q, comm_ptr,
                                hdr->hdr_src, hdr->hdr_tag, PERUSE_RECV);
+        if (NULL != shard_lock) {
+            OB1_MATCHING_UNLOCK(shard_lock);
+        }
         SPC_TIMER_STOP(OMPI_SPC_MATCH_TIME, &timer);
         return NULL;
     } while(true);
@@ -1058,6 +1225,7 @@ static int mca_pml_ob1_recv_frag_match (mca_btl_base_module_t *btl,
     ompi_communicator_t *comm_ptr;
     mca_pml_ob1_comm_t *comm;
     mca_pml_ob1_comm_proc_t *proc;
+    opal_mutex_t *peer_lock;
 
     /* communicator pointer */
     comm_ptr = ompi_comm_lookup(hdr->hdr_ctx);
@@ -1077,6 +1245,7 @@ static int mca_pml_ob1_recv_frag_match (mca_btl_base_module_t *btl,
 
     /* source sequence number */
     proc = mca_pml_ob1_peer_lookup (comm_ptr, hdr->hdr_src);
+    peer_lock = mca_pml_ob1_comm_peer_lock (comm, hdr->hdr_src);
 
     /* We generate the MSG_ARRIVED event as soon as the PML is aware
      * of a matching fragment arrival. Independing if it is received
@@ -1094,12 +1263,12 @@ static int mca_pml_ob1_recv_frag_match (mca_btl_base_module_t *btl,
      * end points) from being processed, and potentially "losing"
      * the fragment.
      */
-    OB1_MATCHING_LOCK(&comm->matching_lock);
+    OB1_MATCHING_LOCK(peer_lock);
 
 #if OPAL_ENABLE_FT_MPI
     if( OPAL_UNLIKELY((ompi_comm_is_revoked(comm_ptr) && !ompi_request_tag_is_ft(hdr->hdr_tag) )) ||
                       (ompi_comm_coll_revoked(comm_ptr) && ompi_request_tag_is_collective(hdr->hdr_tag)) ) {
-        OPAL_THREAD_UNLOCK(&comm->matching_lock);
+        OPAL_THREAD_UNLOCK(peer_lock);
         if( MCA_PML_OB1_HDR_TYPE_MATCH != hdr->hdr_common.hdr_type ) {
             assert( MCA_PML_OB1_HDR_TYPE_RGET == hdr->hdr_common.hdr_type ||
                     MCA_PML_OB1_HDR_TYPE_RNDV == hdr->hdr_common.hdr_type );
@@ -1131,8 +1300,9 @@ static int mca_pml_ob1_recv_frag_match (mca_btl_base_module_t *btl,
             SPC_RECORD(OMPI_SPC_OUT_OF_SEQUENCE, 1);
             SPC_RECORD(OMPI_SPC_OOS_IN_QUEUE, 1);
             SPC_UPDATE_WATERMARK(OMPI_SPC_MAX_OOS_IN_QUEUE, OMPI_SPC_OOS_IN_QUEUE);
+            MCA_PML_OB1_STATS_OUT_OF_SEQUENCE(comm);
 
-            OB1_MATCHING_UNLOCK(&comm->matching_lock);
+            OB1_MATCHING_UNLOCK(peer_lock);
             return OMPI_SUCCESS;
         }
     }
@@ -1163,6 +1333,7 @@ mca_pml_ob1_recv_frag_match_proc (mca_btl_base_module_t *btl,
     /* local variables */
     mca_pml_ob1_comm_t *comm = (mca_pml_ob1_comm_t *)comm_ptr->c_pml_comm;
     mca_pml_ob1_recv_request_t *match = NULL;
+    opal_mutex_t *peer_lock = mca_pml_ob1_comm_peer_lock (comm, hdr->hdr_src);
 
     /* If we are here, this is the sequence number we were expecting,
      * so we can try matching it to already posted receives.
@@ -1193,7 +1364,7 @@ mca_pml_ob1_recv_frag_match_proc (mca_btl_base_module_t *btl,
                            hdr->hdr_src, hdr->hdr_tag, PERUSE_RECV);
 
     /* release matching lock before processing fragment */
-    OB1_MATCHING_UNLOCK(&comm->matching_lock);
+    OB1_MATCHING_UNLOCK(peer_lock);
 
     if(OPAL_LIKELY(match)) {
         switch(type) {
@@ -1218,7 +1389,7 @@ mca_pml_ob1_recv_frag_match_proc (mca_btl_base_module_t *btl,
      * may now be used to form new matches
      */
     if(OPAL_UNLIKELY(NULL != proc->frags_cant_match)) {
-        OB1_MATCHING_LOCK(&comm->matching_lock);
+        OB1_MATCHING_LOCK(peer_lock);
         if((frag = ompi_pml_ob1_check_cantmatch_for_match(proc))) {
             hdr = &frag->hdr.hdr_match;
             segments = frag->segments;
@@ -1227,7 +1398,7 @@ mca_pml_ob1_recv_frag_match_proc (mca_btl_base_module_t *btl,
             type = hdr->hdr_common.hdr_type;
             goto match_this_frag;
         }
-        OB1_MATCHING_UNLOCK(&comm->matching_lock);
+        OB1_MATCHING_UNLOCK(peer_lock);
     }
 
     return OMPI_SUCCESS;
@@ -46,6 +46,7 @@ struct mca_pml_ob1_recv_frag_t {
     mca_pml_ob1_hdr_t hdr;
     size_t num_segments;
     struct mca_pml_ob1_recv_frag_t* range;
+    int64_t stamp;          /**< arrival order on a sharded communicator */
     mca_btl_base_module_t* btl;
     mca_btl_base_segment_t segments[MCA_BTL_DES_MAX_SEGMENTS];
     mca_pml_ob1_buffer_t buffers[MCA_BTL_DES_MAX_SEGMENTS];
@@ -183,6 +184,22 @@ void ompi_pml_ob1_append_frag_to_ordered_list(mca_pml_ob1_recv_frag_t** queue,
                                                   mca_pml_ob1_recv_frag_t* frag,
                                                   uint16_t seq);
 
+#if !MCA_PML_OB1_CUSTOM_MATCH
+/**
+ * Append an unexpected fragment to a shard of a sharded communicator. The
+ * stamp orders the fragments across shards, for the wildcard receives
+ * that have to search all of them. Must be called with the shard lock
+ * held.
+ */
+static inline void mca_pml_ob1_shard_append_unexpected (mca_pml_ob1_comm_t *comm,
+                                                        mca_pml_ob1_match_shard_t *shard,
+                                                        mca_pml_ob1_recv_frag_t *frag)
+{
+    frag->stamp = OPAL_THREAD_FETCH_ADD64(&comm->unexpected_stamp, 1);
+    opal_list_append (&shard->unexpected, (opal_list_item_t *) frag);
+}
+#endif
+
 void mca_pml_ob1_handle_cid (ompi_communicator_t *comm, int src, mca_pml_ob1_cid_hdr_t *hdr_cid);
 
 extern void mca_pml_ob1_dump_cant_match(mca_pml_ob1_recv_frag_t* queue);
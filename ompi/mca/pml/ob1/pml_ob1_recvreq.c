@@ -99,28 +99,49 @@ static int mca_pml_ob1_recv_request_cancel(struct ompi_request_t* ompi_request,
     mca_pml_ob1_recv_request_t* request = (mca_pml_ob1_recv_request_t*)ompi_request;
     ompi_communicator_t *comm = request->req_recv.req_base.req_comm;
     mca_pml_ob1_comm_t *ob1_comm = comm->c_pml_comm;
+    opal_mutex_t *match_lock = &ob1_comm->matching_lock;
+#if !MCA_PML_OB1_CUSTOM_MATCH
+    mca_pml_ob1_match_shard_t *shard = NULL;
+
+    if (NULL != ob1_comm->shards &&
+        mca_pml_ob1_comm_shard_local (ob1_comm, request->req_recv.req_base.req_peer,
+                                      request->req_recv.req_base.req_tag)) {
+        shard = mca_pml_ob1_comm_shard (ob1_comm, request->req_recv.req_base.req_peer,
+                                        request->req_recv.req_base.req_tag);
+        match_lock = &shard->lock;
+    }
+#endif
 
     /* The rest should be protected behind the match logic lock */
-    OB1_MATCHING_LOCK(&ob1_comm->matching_lock);
+    OB1_MATCHING_LOCK(match_lock);
     if( REQUEST_COMPLETE(ompi_request) ) {
-        OB1_MATCHING_UNLOCK(&ob1_comm->matching_lock);
+        OB1_MATCHING_UNLOCK(match_lock);
         return OMPI_SUCCESS;
     }
     if( !request->req_match_received ) { /* the match has not been already done */
         assert( OMPI_ANY_TAG == ompi_request->req_status.MPI_TAG ); /* not matched isn't it */
+        if( NULL != ob1_comm->hash_prq ) {
+            custom_match_hash_prq_cancel(ob1_comm->hash_prq, request,
+                                         request->req_recv.req_base.req_tag,
+                                         request->req_recv.req_base.req_peer);
 #if MCA_PML_OB1_CUSTOM_MATCH
-        custom_match_prq_cancel(ob1_comm->prq, request);
+        } else {
+            custom_match_prq_cancel(ob1_comm->prq, request);
 #else
-        if( request->req_recv.req_base.req_peer == OMPI_ANY_SOURCE ) {
+        } else if( NULL != shard ) {
+            opal_list_remove_item( &shard->posted, (opal_list_item_t*)request );
+        } else if( request->req_recv.req_base.req_peer == OMPI_ANY_SOURCE ||
+                   NULL != ob1_comm->shards ) {
             opal_list_remove_item( &ob1_comm->wild_receives, (opal_list_item_t*)request );
         } else {
             mca_pml_ob1_comm_proc_t* proc = mca_pml_ob1_peer_lookup (comm, request->req_recv.req_base.req_peer);
             opal_list_remove_item(&proc->specific_receives, (opal_list_item_t*)request);
-        }
 #endif
+        }
+        MCA_PML_OB1_STATS_POSTED(ob1_comm, -1);
         PERUSE_TRACE_COMM_EVENT( PERUSE_COMM_REQ_REMOVE_FROM_POSTED_Q,
                                 &(request->req_recv.req_base), PERUSE_RECV );
-        OB1_MATCHING_UNLOCK(&ob1_comm->matching_lock);
+        OB1_MATCHING_UNLOCK(match_lock);
 #if OPAL_ENABLE_FT_MPI
         opal_output_verbose(10, ompi_ftmpi_output_handle,
                             "Recv_request_cancel: cancel granted for request %p because it has not matched\n",
@@ -128,7 +149,7 @@ static int mca_pml_ob1_recv_request_cancel(struct ompi_request_t* ompi_request,
 #endif
     }
     else { /* it has matched */
-        OB1_MATCHING_UNLOCK(&ob1_comm->matching_lock);
+        OB1_MATCHING_UNLOCK(match_lock);
 #if OPAL_ENABLE_FT_MPI
         if( ompi_comm_is_proc_active( comm, request->req_recv.req_base.req_peer,
                                               OMPI_COMM_IS_INTER(comm) ) ) {
@@ -1255,6 +1276,140 @@ recv_req_match_wild( mca_pml_ob1_recv_request_t* req,
 #endif
 }
 
+#if !MCA_PML_OB1_CUSTOM_MATCH
+static inline mca_pml_ob1_recv_frag_t*
+recv_req_match_unexpected( const mca_pml_ob1_recv_request_t *req, opal_list_t *unexpected )
+{
+    mca_pml_ob1_recv_frag_t* frag;
+
+    OPAL_LIST_FOREACH(frag, unexpected, mca_pml_ob1_recv_frag_t) {
+        if( recv_req_match_envelope(req, frag->hdr.hdr_match.hdr_src, frag->hdr.hdr_match.hdr_tag) ) {
+            return frag;
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Match a receive against the unexpected fragments of a sharded
+ * communicator. A receive that cannot be matched within a single shard
+ * (NULL shard) is matched with all the shard locks held, against the
+ * earliest arrived of the matching fragments of every shard.
+ */
+static mca_pml_ob1_recv_frag_t*
+recv_req_match_sharded( const mca_pml_ob1_recv_request_t *req,
+                        mca_pml_ob1_comm_t *comm,
+                        mca_pml_ob1_match_shard_t *shard,
+                        opal_list_t **unexpected )
+{
+    mca_pml_ob1_recv_frag_t *frag, *match = NULL;
+
+    if (NULL != shard) {
+        *unexpected = &shard->unexpected;
+        return recv_req_match_unexpected(req, &shard->unexpected);
+    }
+
+    for (uint32_t i = 0; i <= comm->shard_mask; i++) {
+        frag = recv_req_match_unexpected(req, &comm->shards[i].unexpected);
+        if (NULL != frag && (NULL == match || frag->stamp < match->stamp)) {
+            match = frag;
+            *unexpected = &comm->shards[i].unexpected;
+        }
+    }
+
+    return match;
+}
+#endif
+
+/*
+ * Set the request's proc and convertor when the match does not go through
+ * the per-peer queues. A wildcard receive that did not match is prepared
+ * on match, as below.
+ */
+static inline void
+recv_req_prepare_proc( ompi_communicator_t *comm, mca_pml_ob1_recv_request_t *req,
+                       const mca_pml_ob1_recv_frag_t *frag )
+{
+    mca_pml_ob1_comm_proc_t* proc;
+
+    if (req->req_recv.req_base.req_peer != OMPI_ANY_SOURCE) {
+        proc = mca_pml_ob1_peer_lookup (comm, req->req_recv.req_base.req_peer);
+        req->req_recv.req_base.req_proc = proc->ompi_proc;
+        prepare_recv_req_converter(req);
+    } else if (NULL != frag) {
+        proc = mca_pml_ob1_peer_lookup (comm, frag->hdr.hdr_match.hdr_src);
+        req->req_recv.req_base.req_proc = proc->ompi_proc;
+        prepare_recv_req_converter(req);
+    }
+#if !OPAL_ENABLE_HETEROGENEOUS_SUPPORT
+    else {
+        /* the local proc will do until the match */
+        req->req_recv.req_base.req_proc = ompi_proc_local_proc;
+        prepare_recv_req_converter(req);
+    }
+#endif  /* !OPAL_ENABLE_HETEROGENEOUS_SUPPORT */
+}
+
+#if !MCA_PML_OB1_CUSTOM_MATCH
+/*
+ * With the automatic engine selection, switch a communicator whose posted
+ * receives pile up on a queue to hash matching. Called with the matching
+ * lock held.
+ */
+static inline void
+recv_req_check_queue_depth( mca_pml_ob1_comm_t *comm, opal_list_t *queue )
+{
+    if (OPAL_UNLIKELY(MCA_PML_OB1_MATCHING_AUTO == mca_pml_ob1.matching_engine &&
+                      0 < mca_pml_ob1.hash_matching_threshold && NULL == comm->shards &&
+                      opal_list_get_size(queue) >= (size_t) mca_pml_ob1.hash_matching_threshold)) {
+        (void) mca_pml_ob1_comm_init_hash(comm);
+    }
+}
+#endif
+
+/*
+ * Take the matching lock(s) protecting the queues the request is matched
+ * against. Returns the request's shard if it has one.
+ */
+static inline mca_pml_ob1_match_shard_t*
+recv_req_match_lock( mca_pml_ob1_comm_t *comm, const mca_pml_ob1_recv_request_t *req )
+{
+#if !MCA_PML_OB1_CUSTOM_MATCH
+    if (NULL != comm->shards) {
+        int peer = req->req_recv.req_base.req_peer, tag = req->req_recv.req_base.req_tag;
+
+        if (mca_pml_ob1_comm_shard_local(comm, peer, tag)) {
+            mca_pml_ob1_match_shard_t *shard = mca_pml_ob1_comm_shard(comm, peer, tag);
+            OB1_MATCHING_LOCK(&shard->lock);
+            return shard;
+        }
+
+        for (uint32_t i = 0; i <= comm->shard_mask; i++) {
+            OB1_MATCHING_LOCK(&comm->shards[i].lock);
+        }
+    }
+#endif
+    OB1_MATCHING_LOCK(&comm->matching_lock);
+    return NULL;
+}
+
+static inline void
+recv_req_match_unlock( mca_pml_ob1_comm_t *comm, mca_pml_ob1_match_shard_t *shard )
+{
+    if (NULL != shard) {
+        OB1_MATCHING_UNLOCK(&shard->lock);
+        return;
+    }
+
+    OB1_MATCHING_UNLOCK(&comm->matching_lock);
+#if !MCA_PML_OB1_CUSTOM_MATCH
+    if (NULL != comm->shards) {
+        for (uint32_t i = comm->shard_mask + 1; i > 0; i--) {
+            OB1_MATCHING_UNLOCK(&comm->shards[i - 1].lock);
+        }
+    }
+#endif
+}
 
 void mca_pml_ob1_recv_req_start(mca_pml_ob1_recv_request_t *req)
 {
@@ -1263,13 +1418,15 @@ void mca_pml_ob1_recv_req_start(mca_pml_ob1_recv_request_t *req)
     mca_pml_ob1_comm_proc_t* proc;
     mca_pml_ob1_recv_frag_t* frag;
     mca_pml_ob1_hdr_t* hdr;
+    mca_pml_ob1_match_shard_t *shard;
 #if MCA_PML_OB1_CUSTOM_MATCH
     custom_match_umq_node* hold_prev;
     custom_match_umq_node* hold_elem;
     int hold_index;
 #else
-    opal_list_t *queue;
+    opal_list_t *queue = NULL, *unexpected = NULL;
 #endif
+    custom_match_hash_node *hash_hold = NULL;
 
     /* init/re-init the request */
     req->req_lock = 0;
@@ -1283,7 +1440,7 @@ void mca_pml_ob1_recv_req_start(mca_pml_ob1_recv_request_t *req)
 
     MCA_PML_BASE_RECV_START(&req->req_recv);
 
-    OB1_MATCHING_LOCK(&ob1_comm->matching_lock);
+    shard = recv_req_match_lock(ob1_comm, req);
     /**
      * The laps of time between the ACTIVATE event and the SEARCH_UNEX one include
      * the cost of the request lock.
@@ -1292,7 +1449,17 @@ void mca_pml_ob1_recv_req_start(mca_pml_ob1_recv_request_t *req)
                             &(req->req_recv.req_base), PERUSE_RECV);
 
     /* assign sequence number */
+#if !MCA_PML_OB1_CUSTOM_MATCH
+    if (NULL != ob1_comm->shards) {
+        /* a shard lock only serializes the receives of its shard */
+        req->req_recv.req_base.req_sequence =
+            (uint32_t) OPAL_THREAD_FETCH_ADD32((opal_atomic_int32_t *) &ob1_comm->recv_sequence, 1);
+    } else {
+        req->req_recv.req_base.req_sequence = ob1_comm->recv_sequence++;
+    }
+#else
     req->req_recv.req_base.req_sequence = ob1_comm->recv_sequence++;
+#endif
 
 #if OPAL_ENABLE_FT_MPI
     /* if the communicator is not in a good state (revoked or coll_revoked), do not
@@ -1308,7 +1475,7 @@ void mca_pml_ob1_recv_req_start(mca_pml_ob1_recv_request_t *req)
             recv_request_pml_complete( req );
             PERUSE_TRACE_COMM_EVENT(PERUSE_COMM_SEARCH_UNEX_Q_END,
                                     &(req->req_recv.req_base), PERUSE_RECV);
-            OB1_MATCHING_UNLOCK(&ob1_comm->matching_lock);
+            recv_req_match_unlock(ob1_comm, shard);
             return;
         }
     }
@@ -1316,12 +1483,25 @@ void mca_pml_ob1_recv_req_start(mca_pml_ob1_recv_request_t *req)
 
 
     /* attempt to match posted recv */
+    if (NULL != ob1_comm->hash_umq) {
+        frag = custom_match_hash_umq_find_verify_hold(ob1_comm->hash_umq, req->req_recv.req_base.req_tag,
+                                                      req->req_recv.req_base.req_peer, &hash_hold);
+        recv_req_prepare_proc(comm, req, frag);
+    } else
+#if !MCA_PML_OB1_CUSTOM_MATCH
+    if (NULL != ob1_comm->shards) {
+        frag = recv_req_match_sharded(req, ob1_comm, shard, &unexpected);
+        queue = (NULL != shard) ? &shard->posted : &ob1_comm->wild_receives;
+        recv_req_prepare_proc(comm, req, frag);
+    } else
+#endif
     if(req->req_recv.req_base.req_peer == OMPI_ANY_SOURCE) {
 #if MCA_PML_OB1_CUSTOM_MATCH
         frag = recv_req_match_wild(req, &proc, &hold_prev, &hold_elem, &hold_index);
 #else
         frag = recv_req_match_wild(req, &proc);
         queue = &ob1_comm->wild_receives;
+        unexpected = (NULL != frag) ? &proc->unexpected_frags : NULL;
 #endif
 #if !OPAL_ENABLE_HETEROGENEOUS_SUPPORT
         /* As we are in a homogeneous environment we know that all remote
@@ -1342,6 +1522,7 @@ void mca_pml_ob1_recv_req_start(mca_pml_ob1_recv_request_t *req)
 #else
         frag = recv_req_match_specific_proc(req, proc);
         queue = &proc->specific_receives;
+        unexpected = &proc->unexpected_frags;
 #endif
         /* wildcard recv will be prepared on match */
         prepare_recv_req_converter(req);
@@ -1353,16 +1534,25 @@ void mca_pml_ob1_recv_req_start(mca_pml_ob1_recv_request_t *req)
         /* We didn't find any matches.  Record this irecv so we can match
            it when the message comes in. */
         if(OPAL_LIKELY(req->req_recv.req_base.req_type != MCA_PML_REQUEST_IPROBE &&
-                       req->req_recv.req_base.req_type != MCA_PML_REQUEST_IMPROBE))
+                       req->req_recv.req_base.req_type != MCA_PML_REQUEST_IMPROBE)) {
+            if (NULL != ob1_comm->hash_prq) {
+                custom_match_hash_prq_append(ob1_comm->hash_prq, req,
+                                             req->req_recv.req_base.req_tag,
+                                             req->req_recv.req_base.req_peer);
+            } else {
 #if MCA_PML_OB1_CUSTOM_MATCH
-            custom_match_prq_append(ob1_comm->prq, req,
-                                    req->req_recv.req_base.req_tag,
-                                    req->req_recv.req_base.req_peer);
+                custom_match_prq_append(ob1_comm->prq, req,
+                                        req->req_recv.req_base.req_tag,
+                                        req->req_recv.req_base.req_peer);
 #else
-            append_recv_req_to_queue(queue, req);
+                append_recv_req_to_queue(queue, req);
+                recv_req_check_queue_depth(ob1_comm, queue);
 #endif
+            }
+            MCA_PML_OB1_STATS_POSTED(ob1_comm, 1);
+        }
         req->req_match_received = false;
-        OB1_MATCHING_UNLOCK(&ob1_comm->matching_lock);
+        recv_req_match_unlock(ob1_comm, shard);
     } else {
         if(OPAL_LIKELY(!IS_PROB_REQ(req))) {
             PERUSE_TRACE_COMM_EVENT(PERUSE_COMM_REQ_MATCH_UNEX,
@@ -1378,14 +1568,18 @@ void mca_pml_ob1_recv_req_start(mca_pml_ob1_recv_request_t *req)
             PERUSE_TRACE_COMM_EVENT(PERUSE_COMM_SEARCH_UNEX_Q_END,
                                     &(req->req_recv.req_base), PERUSE_RECV);
 
+            if (NULL != hash_hold) {
+                custom_match_hash_umq_remove_hold(ob1_comm->hash_umq, hash_hold);
+            } else {
 #if MCA_PML_OB1_CUSTOM_MATCH
-            custom_match_umq_remove_hold(req->req_recv.req_base.req_comm->c_pml_comm->umq, hold_prev, hold_elem, hold_index);
+                custom_match_umq_remove_hold(req->req_recv.req_base.req_comm->c_pml_comm->umq, hold_prev, hold_elem, hold_index);
 #else
-            opal_list_remove_item(&proc->unexpected_frags,
-                                  (opal_list_item_t*)frag);
+                opal_list_remove_item(unexpected, (opal_list_item_t*)frag);
 #endif
+            }
             SPC_RECORD(OMPI_SPC_UNEXPECTED_IN_QUEUE, -1);
-            OB1_MATCHING_UNLOCK(&ob1_comm->matching_lock);
+            MCA_PML_OB1_STATS_UNEXPECTED(ob1_comm, -1, mca_pml_ob1_compute_segment_length_base (frag->segments, frag->num_segments, 0));
+            recv_req_match_unlock(ob1_comm, shard);
 
             switch(hdr->hdr_common.hdr_type) {
             case MCA_PML_OB1_HDR_TYPE_MATCH:
@@ -1414,21 +1608,25 @@ void mca_pml_ob1_recv_req_start(mca_pml_ob1_recv_request_t *req)
                "recreated" as a receive request, and the frag will be
                restarted with this request during mrecv */
 
+            if (NULL != hash_hold) {
+                custom_match_hash_umq_remove_hold(ob1_comm->hash_umq, hash_hold);
+            } else {
 #if MCA_PML_OB1_CUSTOM_MATCH
-            custom_match_umq_remove_hold(req->req_recv.req_base.req_comm->c_pml_comm->umq, hold_prev, hold_elem, hold_index);
+                custom_match_umq_remove_hold(req->req_recv.req_base.req_comm->c_pml_comm->umq, hold_prev, hold_elem, hold_index);
 #else
-            opal_list_remove_item(&proc->unexpected_frags,
-                                  (opal_list_item_t*)frag);
+                opal_list_remove_item(unexpected, (opal_list_item_t*)frag);
 #endif
+            }
             SPC_RECORD(OMPI_SPC_UNEXPECTED_IN_QUEUE, -1);
-            OB1_MATCHING_UNLOCK(&ob1_comm->matching_lock);
+            MCA_PML_OB1_STATS_UNEXPECTED(ob1_comm, -1, mca_pml_ob1_compute_segment_length_base (frag->segments, frag->num_segments, 0));
+            recv_req_match_unlock(ob1_comm, shard);
 
             req->req_recv.req_base.req_addr = frag;
             mca_pml_ob1_recv_request_matched_probe(req, frag->btl,
                                                    frag->segments, frag->num_segments);
 
         } else {
-            OB1_MATCHING_UNLOCK(&ob1_comm->matching_lock);
+            recv_req_match_unlock(ob1_comm, shard);
             mca_pml_ob1_recv_request_matched_probe(req, frag->btl,
                                                    frag->segments, frag->num_segments);
         }
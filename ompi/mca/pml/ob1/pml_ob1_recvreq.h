@@ -224,6 +224,19 @@ recv_request_pml_complete_check(mca_pml_ob1_recv_request_t *recvreq)
 extern void mca_pml_ob1_recv_req_start(mca_pml_ob1_recv_request_t *req);
 #define MCA_PML_OB1_RECV_REQUEST_START(r) mca_pml_ob1_recv_req_start(r)
 
+/**
+ * Whether a message with the given envelope matches the request.
+ */
+static inline bool recv_req_match_envelope(const mca_pml_ob1_recv_request_t *req,
+                                           int src, int tag)
+{
+    int req_peer = req->req_recv.req_base.req_peer;
+    int req_tag = req->req_recv.req_base.req_tag;
+
+    return (req_peer == src || OMPI_ANY_SOURCE == req_peer) &&
+        (req_tag == tag || (OMPI_ANY_TAG == req_tag && tag >= 0));
+}
+
 static inline void prepare_recv_req_converter(mca_pml_ob1_recv_request_t *req)
 {
     if( req->req_recv.req_base.req_datatype->super.size | req->req_recv.req_base.req_count ) {
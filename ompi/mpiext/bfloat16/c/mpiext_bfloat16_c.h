@@ -0,0 +1,12 @@
+/*
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ */
+
+OMPI_DECLSPEC extern struct ompi_predefined_datatype_t ompi_mpi_bfloat16;
+
+#define MPIX_BFLOAT16                OMPI_PREDEFINED_GLOBAL(MPI_Datatype, ompi_mpi_bfloat16)
@@ -0,0 +1,27 @@
+# -*- shell-script -*-
+#
+# $COPYRIGHT$
+#
+# Additional copyrights may follow
+#
+# $HEADER$
+#
+
+# OMPI_MPIEXT_bfloat16_CONFIG([action-if-found], [action-if-not-found])
+# -----------------------------------------------------------
+AC_DEFUN([OMPI_MPIEXT_bfloat16_CONFIG],[
+    AC_CONFIG_FILES([
+        ompi/mpiext/bfloat16/Makefile
+        ompi/mpiext/bfloat16/c/Makefile
+    ])
+
+    # The datatype is always built into the library; no compiler type
+    # is required, as the reduction operations interpret the bits.
+    AS_IF([test "$ENABLE_bfloat16" = "1" || \
+           test "$ENABLE_EXT_ALL" = "1"],
+          [$1],
+          [$2])
+])
+
+# This extension provides only header files for datatype handles.
+AC_DEFUN([OMPI_MPIEXT_bfloat16_HAVE_OBJECT], [0])
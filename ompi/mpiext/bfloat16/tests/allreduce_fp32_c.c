@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+ * Check the fp32 accumulation of the MPIX_BFLOAT16 MPI_SUM reductions
+ * (coll_base_reduce_accumulate_fp32). Rank 0 contributes 1.0 and the
+ * other ranks half an ulp of 1.0 each: rounding at every step leaves 1.0
+ * unchanged, while a single rounding of the exact sum does not. Run with
+ * at least 3 processes, e.g. for the ring allreduce:
+ *
+ *   mpirun -n 4 --mca coll_base_reduce_accumulate_fp32 1 \
+ *          --mca coll_tuned_use_dynamic_rules 1 \
+ *          --mca coll_tuned_allreduce_algorithm 4 \
+ *          --mca coll_tuned_reduce_scatter_algorithm 3 ./allreduce_fp32_c
+ *
+ * and with the allreduce algorithms 5 (segmented ring) and 6
+ * (rabenseifner).
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mpi.h"
+#include "mpi-ext.h"
+
+#define COUNT_PER_RANK 4099
+
+/* round to nearest-even; the sums below are finite */
+static uint16_t float_to_bf16(float f)
+{
+    uint32_t u, low;
+    uint16_t v;
+
+    memcpy(&u, &f, sizeof(u));
+    v = (uint16_t) (u >> 16);
+    low = u & 0xffff;
+    if ((low > 0x8000) || ((0x8000 == low) && (v & 1))) {
+        v++;
+    }
+    return v;
+}
+
+static uint16_t contribution(int rank, int i)
+{
+    /* 1.0 + i % 4 ulps on rank 0, and half an ulp of 1.0 (2^-8) elsewhere */
+    return (0 == rank) ? (uint16_t) (0x3f80 + i % 4) : 0x3b80;
+}
+
+static uint16_t expected(int size, int i)
+{
+    /* the exact sum; 2^-8 is exact in float as long as size <= 2^16 */
+    return float_to_bf16((1.0f + (float) (i % 4) / 128.0f) + (float) (size - 1) / 256.0f);
+}
+
+static int check(const char *name, const uint16_t *buf, int count, int first, int size)
+{
+    for (int i = 0; i < count; i++) {
+        if (buf[i] != expected(size, first + i)) {
+            printf("%s: element %d is 0x%04x instead of 0x%04x\n", name, first + i, buf[i],
+                   expected(size, first + i));
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    int rank, size, count, errors = 0, all_errors, *rcounts;
+    uint16_t *sbuf, *rbuf;
+
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    /* the blocks of the ring algorithms do not all have the same size */
+    count = COUNT_PER_RANK * size + 3;
+    sbuf = (uint16_t *) malloc(count * sizeof(uint16_t));
+    rbuf = (uint16_t *) malloc(count * sizeof(uint16_t));
+    rcounts = (int *) malloc(size * sizeof(int));
+    for (int i = 0; i < count; i++) {
+        sbuf[i] = contribution(rank, i);
+    }
+
+    MPI_Allreduce(sbuf, rbuf, count, MPIX_BFLOAT16, MPI_SUM, MPI_COMM_WORLD);
+    errors += check("MPI_Allreduce", rbuf, count, 0, size);
+
+    memcpy(rbuf, sbuf, count * sizeof(uint16_t));
+    MPI_Allreduce(MPI_IN_PLACE, rbuf, count, MPIX_BFLOAT16, MPI_SUM, MPI_COMM_WORLD);
+    errors += check("MPI_Allreduce in place", rbuf, count, 0, size);
+
+    for (int i = 0; i < size; i++) {
+        rcounts[i] = COUNT_PER_RANK;
+    }
+    MPI_Reduce_scatter(sbuf, rbuf, rcounts, MPIX_BFLOAT16, MPI_SUM, MPI_COMM_WORLD);
+    errors += check("MPI_Reduce_scatter", rbuf, COUNT_PER_RANK, rank * COUNT_PER_RANK, size);
+
+    MPI_Allreduce(&errors, &all_errors, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+    if (0 == rank) {
+        printf("%s\n", (0 == all_errors) ? "success" : "failure");
+    }
+
+    free(sbuf);
+    free(rbuf);
+    free(rcounts);
+    MPI_Finalize();
+
+    return (0 == all_errors) ? 0 : 1;
+}
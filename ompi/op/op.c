@@ -235,6 +235,8 @@ int ompi_op_init(void)
     ompi_op_ddt_map[OMPI_DATATYPE_MPI_LONG] = OMPI_OP_BASE_TYPE_LONG;
     ompi_op_ddt_map[OMPI_DATATYPE_MPI_UNSIGNED_LONG] = OMPI_OP_BASE_TYPE_UNSIGNED_LONG;
 
+    ompi_op_ddt_map[OMPI_DATATYPE_MPI_BFLOAT16] = OMPI_OP_BASE_TYPE_BFLOAT16;
+
     /* Create the intrinsic ops */
 
     if (OMPI_SUCCESS !=
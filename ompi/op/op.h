@@ -228,6 +228,29 @@ typedef struct ompi_predefined_op_t ompi_predefined_op_t;
  */
 OMPI_DECLSPEC extern int ompi_op_ddt_map[OMPI_DATATYPE_MAX_PREDEFINED];
 
+/**
+ * Number of helper threads that large intrinsic reductions are split
+ * across (op_base_reduce_threads MCA parameter; 0 disables them), and
+ * the reduction size in bytes from which they are used
+ * (op_base_reduce_threads_min_size).
+ */
+OMPI_DECLSPEC extern int ompi_op_base_reduce_threads;
+OMPI_DECLSPEC extern size_t ompi_op_base_reduce_threads_min_size;
+
+/**
+ * Split an intrinsic reduction across the calling thread and the op
+ * framework's helper threads (see ompi/mca/op/base/op_base_threads.c).
+ * source1 is NULL for a 2-buffer reduction.
+ *
+ * @retval OMPI_SUCCESS The reduction was performed.
+ * @retval other The reduction was not performed, and should be carried
+ *               out serially by the caller (e.g. the helper threads are
+ *               in use by another thread).
+ */
+OMPI_DECLSPEC int ompi_op_base_reduce_threaded(struct ompi_op_t *op, const void *source1,
+                                               const void *source2, void *target,
+                                               size_t count, ompi_datatype_t *dtype);
+
 /**
  * Global variable for MPI_OP_NULL (_addr flavor is for F03 bindings)
  */
@@ -510,8 +533,12 @@ static inline bool ompi_op_is_valid(ompi_op_t * op, ompi_datatype_t * ddt,
  * given to it; it makes no provision for errors (in the name of
  * optimization).  If you give it an intrinsic op with a datatype that
  * is not defined to have that operation, it is likely to seg fault.
+ *
+ * ompi_op_reduce_serial() always runs on the calling thread;
+ * ompi_op_reduce() may hand large intrinsic reductions to the op
+ * framework's helper threads.
  */
-static inline void ompi_op_reduce(ompi_op_t * op, const void *source,
+static inline void ompi_op_reduce_serial(ompi_op_t * op, const void *source,
                                   void *target, size_t full_count,
                                   ompi_datatype_t * dtype)
 {
@@ -540,7 +567,7 @@ static inline void ompi_op_reduce(ompi_op_t * op, const void *source,
             }
             shift = done_count * ext;
             // Recurse one level in iterations of 'int'
-            ompi_op_reduce(op, (const char*)source + shift, (char*)target + shift, iter_count, dtype);
+            ompi_op_reduce_serial(op, (const char*)source + shift, (char*)target + shift, iter_count, dtype);
             done_count += iter_count;
         }
         return;
@@ -609,6 +636,20 @@ static inline void ompi_op_reduce(ompi_op_t * op, const void *source,
     return;
 }
 
+static inline void ompi_op_reduce(ompi_op_t * op, const void *source,
+                                  void *target, size_t full_count,
+                                  ompi_datatype_t * dtype)
+{
+    if (OPAL_UNLIKELY(0 < ompi_op_base_reduce_threads) &&
+        (full_count * dtype->super.size >= ompi_op_base_reduce_threads_min_size) &&
+        ompi_op_is_intrinsic(op) &&
+        OMPI_SUCCESS == ompi_op_base_reduce_threaded(op, NULL, source, target,
+                                                     full_count, dtype)) {
+        return;
+    }
+    ompi_op_reduce_serial(op, source, target, full_count, dtype);
+}
+
 static inline void ompi_3buff_op_user (ompi_op_t *op, void * restrict source1, void * restrict source2,
                                        void * restrict result, size_t full_count, struct ompi_datatype_t *dtype)
 {
@@ -643,7 +684,7 @@ static inline void ompi_3buff_op_user (ompi_op_t *op, void * restrict source1, v
  *
  * Otherwise, this function is the same as ompi_op_reduce.
  */
-static inline void ompi_3buff_op_reduce(ompi_op_t * op, void *source1,
+static inline void ompi_3buff_op_reduce_serial(ompi_op_t * op, void *source1,
                                         void *source2, void *target,
                                         size_t full_count, ompi_datatype_t * dtype)
 {
@@ -669,8 +710,8 @@ static inline void ompi_3buff_op_reduce(ompi_op_t * op, void *source1,
             }
             shift = done_count * ext;
             // Recurse one level in iterations of 'int'
-            ompi_3buff_op_reduce(op, (char*)source1 + shift, (char *)source2 + shift,
-                                (char*)target + shift, iter_count, dtype);
+            ompi_3buff_op_reduce_serial(op, (char*)source1 + shift, (char *)source2 + shift,
+                                        (char*)target + shift, iter_count, dtype);
             done_count += iter_count;
         }
         return;
@@ -687,6 +728,20 @@ static inline void ompi_3buff_op_reduce(ompi_op_t * op, void *source1,
     }
 }
 
+static inline void ompi_3buff_op_reduce(ompi_op_t * op, void *source1,
+                                        void *source2, void *target,
+                                        size_t full_count, ompi_datatype_t * dtype)
+{
+    if (OPAL_UNLIKELY(0 < ompi_op_base_reduce_threads) &&
+        (full_count * dtype->super.size >= ompi_op_base_reduce_threads_min_size) &&
+        ompi_op_is_intrinsic(op) &&
+        OMPI_SUCCESS == ompi_op_base_reduce_threaded(op, source1, source2, target,
+                                                     full_count, dtype)) {
+        return;
+    }
+    ompi_3buff_op_reduce_serial(op, source1, source2, target, full_count, dtype);
+}
+
 END_C_DECLS
 
 #endif /* OMPI_OP_H */
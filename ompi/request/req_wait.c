@@ -31,6 +31,42 @@
 #include "ompi/request/request_default.h"
 #include "ompi/request/grequest.h"
 
+/*
+ * Attach a sync to a pending request, or detach it from a request that
+ * has not completed yet. Both return false if the request completed.
+ * Without threads requests only complete from within opal_progress()
+ * called by this thread, so plain loads and stores are enough.
+ */
+static inline bool ompi_request_sync_attach(ompi_request_t *request, ompi_wait_sync_t *sync,
+                                            bool threads)
+{
+    void *_tmp_ptr = REQUEST_PENDING;
+
+    if (!threads) {
+        if (REQUEST_PENDING != request->req_complete) {
+            return false;
+        }
+        request->req_complete = sync;
+        return true;
+    }
+    return OPAL_ATOMIC_COMPARE_EXCHANGE_STRONG_PTR(&request->req_complete, &_tmp_ptr, sync);
+}
+
+static inline bool ompi_request_sync_detach(ompi_request_t *request, ompi_wait_sync_t *sync,
+                                            bool threads)
+{
+    void *_tmp_ptr = sync;
+
+    if (!threads) {
+        if (sync != request->req_complete) {
+            return false;
+        }
+        request->req_complete = REQUEST_PENDING;
+        return true;
+    }
+    return OPAL_ATOMIC_COMPARE_EXCHANGE_STRONG_PTR(&request->req_complete, &_tmp_ptr, REQUEST_PENDING);
+}
+
 int ompi_request_default_wait(
     ompi_request_t ** req_ptr,
     ompi_status_public_t * status)
@@ -230,17 +266,29 @@ int ompi_request_default_wait_all( size_t count,
     ompi_request_t *request;
     int mpi_error = OMPI_SUCCESS;
     ompi_wait_sync_t sync;
+    bool threads = opal_using_threads();
 
     if (OPAL_UNLIKELY(0 == count)) {
         return OMPI_SUCCESS;
     }
 
+    /* If everything already completed there is nothing to wait for:
+     * skip attaching the sync to the requests */
+    for (i = 0; i < count; i++) {
+        request = requests[i];
+        if (request->req_state != OMPI_REQUEST_INACTIVE && !REQUEST_COMPLETE(request)) {
+            break;
+        }
+    }
+    if (i == count) {
+        WAIT_SYNC_INIT(&sync, 0);
+        goto finish;
+    }
+
 recheck:
     WAIT_SYNC_INIT(&sync, count);
     rptr = requests;
     for (i = 0; i < count; i++) {
-        void *_tmp_ptr = REQUEST_PENDING;
-
         request = *rptr++;
 
         if( request->req_state == OMPI_REQUEST_INACTIVE ) {
@@ -248,7 +296,7 @@ recheck:
             continue;
         }
 
-        if (REQUEST_COMPLETE(request) || !OPAL_ATOMIC_COMPARE_EXCHANGE_STRONG_PTR(&request->req_complete, &_tmp_ptr, &sync)) {
+        if (REQUEST_COMPLETE(request) || !ompi_request_sync_attach(request, &sync, threads)) {
             if( OPAL_LIKELY( REQUEST_COMPLETE(request) ) ) {
                 if( OPAL_UNLIKELY( MPI_SUCCESS != request->req_status.MPI_ERROR ) ) {
                     failed++;
@@ -288,15 +336,13 @@ recheck:
          */
         rptr = requests;
         for (i = 0; i < count; i++) {
-            void *_tmp_ptr = &sync;
-
             request = *rptr++;
 
             if( request->req_state == OMPI_REQUEST_INACTIVE ) {
                 continue;
             }
 
-            OPAL_ATOMIC_COMPARE_EXCHANGE_STRONG_PTR(&request->req_complete, &_tmp_ptr, REQUEST_PENDING);
+            (void) ompi_request_sync_detach(request, &sync, threads);
         }
         /* The sync is now ready for rearming */
         WAIT_SYNC_RELEASE(&sync);
@@ -312,8 +358,6 @@ recheck:
 
         /* fill out status and free request if required */
         for( i = 0; i < count; i++, rptr++ ) {
-            void *_tmp_ptr = &sync;
-
             request = *rptr;
 
             if( request->req_state == OMPI_REQUEST_INACTIVE ) {
@@ -328,7 +372,7 @@ recheck:
                  * mark the request as pending then it is neither failed nor complete, and
                  * we must stop altering it.
                  */
-                if( OPAL_ATOMIC_COMPARE_EXCHANGE_STRONG_PTR(&request->req_complete, &_tmp_ptr, REQUEST_PENDING ) ) {
+                if( ompi_request_sync_detach(request, &sync, threads) ) {
                     /*
                      * Per MPI 2.2 p 60:
                      * Allows requests to be marked as MPI_ERR_PENDING if they are
@@ -376,8 +420,6 @@ recheck:
         int rc;
         /* free request if required */
         for( i = 0; i < count; i++, rptr++ ) {
-            void *_tmp_ptr = &sync;
-
             request = *rptr;
 
             if( request->req_state == OMPI_REQUEST_INACTIVE ) {
@@ -392,7 +434,7 @@ recheck:
                 /* If the request is still pending due to a failed request
                  * then skip it in this loop.
                  */
-                 if( OPAL_ATOMIC_COMPARE_EXCHANGE_STRONG_PTR(&request->req_complete, &_tmp_ptr, REQUEST_PENDING ) ) {
+                 if( ompi_request_sync_detach(request, &sync, threads) ) {
                     /*
                      * Per MPI 2.2 p 60:
                      * Allows requests to be marked as MPI_ERR_PENDING if they are
@@ -463,12 +505,34 @@ int ompi_request_default_wait_some(size_t count,
     ompi_request_t *request = NULL;
     ompi_wait_sync_t sync;
     size_t sync_sets = 0, sync_unsets = 0;
+    bool threads = opal_using_threads();
 
     if (OPAL_UNLIKELY(0 == count)) {
         *outcount = MPI_UNDEFINED;
         return OMPI_SUCCESS;
     }
 
+    /* Collect the requests that already completed with plain loads. If
+     * there are any, they are all we return, and the sync never needs to
+     * be attached to (and detached from) the pending ones. */
+    num_requests_null_inactive = 0;
+    num_requests_done = 0;
+    for (size_t i = 0; i < count; i++) {
+        request = requests[i];
+        if( request->req_state == OMPI_REQUEST_INACTIVE ) {
+            num_requests_null_inactive++;
+        } else if( REQUEST_COMPLETE(request) ) {
+            indices[num_requests_done++] = i;
+        }
+    }
+    if(num_requests_null_inactive == count) {
+        *outcount = MPI_UNDEFINED;
+        return rc;
+    }
+    if( 0 != num_requests_done ) {
+        goto harvest;
+    }
+
   recheck:
     WAIT_SYNC_INIT(&sync, 1);
 
@@ -479,8 +543,6 @@ int ompi_request_default_wait_some(size_t count,
     num_requests_done = 0;
     num_active_reqs = 0;
     for (size_t i = 0; i < count; i++, rptr++) {
-        void *_tmp_ptr = REQUEST_PENDING;
-
         request = *rptr;
         /*
          * Check for null or completed persistent request.
@@ -490,7 +552,7 @@ int ompi_request_default_wait_some(size_t count,
             num_requests_null_inactive++;
             continue;
         }
-        indices[num_active_reqs] = OPAL_ATOMIC_COMPARE_EXCHANGE_STRONG_PTR(&request->req_complete, &_tmp_ptr, &sync);
+        indices[num_active_reqs] = ompi_request_sync_attach(request, &sync, threads);
         if( !indices[num_active_reqs] ) {
             /* If the request is completed go ahead and mark it as such */
             if( REQUEST_COMPLETE(request) ) {
@@ -527,8 +589,6 @@ int ompi_request_default_wait_some(size_t count,
     num_requests_done = 0;
     num_active_reqs = 0;
     for (size_t i = 0; i < count; i++, rptr++) {
-        void *_tmp_ptr = &sync;
-
         request = *rptr;
 
         if( request->req_state == OMPI_REQUEST_INACTIVE ) {
@@ -549,7 +609,7 @@ int ompi_request_default_wait_some(size_t count,
          */
         if( !indices[num_active_reqs] ) {
             indices[num_requests_done++] = i;
-        } else if( !OPAL_ATOMIC_COMPARE_EXCHANGE_STRONG_PTR(&request->req_complete, &_tmp_ptr, REQUEST_PENDING) ) {
+        } else if( !ompi_request_sync_detach(request, &sync, threads) ) {
             indices[num_requests_done++] = i;
         }
 #if OPAL_ENABLE_FT_MPI
@@ -580,6 +640,7 @@ int ompi_request_default_wait_some(size_t count,
         goto recheck;
     }
 
+  harvest:
     *outcount = num_requests_done;
 
     /* make sure we get the correct status */
@@ -489,8 +489,11 @@ static inline void ompi_request_wait_completion(ompi_request_t *req)
      }
      opal_atomic_rmb();
     } else {
+        int idle = 0;
         while(!REQUEST_COMPLETE(req)) {
-            opal_progress();
+            /* without threads the request can only complete from within
+             * opal_progress(), no need for a wake-up */
+            opal_progress_idle(opal_progress(), &idle, NULL);
 #if OPAL_ENABLE_FT_MPI
             /* Check to make sure that process failure did not break the
              * request. */
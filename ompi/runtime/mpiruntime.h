@@ -217,6 +217,16 @@ OMPI_DECLSPEC int ompi_mpi_abort(struct ompi_communicator_t* comm,
  */
 int ompi_init_preconnect_mpi(void);
 
+/**
+ * Start the asynchronous progress thread, if mpi_async_progress is set
+ */
+int ompi_mpi_async_progress_start(void);
+
+/**
+ * Stop the asynchronous progress thread, if it is running
+ */
+void ompi_mpi_async_progress_stop(void);
+
 /**
  * Called to disable MPI dynamic process support.  It should be called
  * by transports and/or environments where MPI dynamic process
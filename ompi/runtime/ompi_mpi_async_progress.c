@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+ * Asynchronous progress thread.
+ *
+ * When mpi_async_progress is set, a thread calls opal_progress() for
+ * the lifetime of the MPI library, so that rendezvous and RDMA
+ * protocols, shared memory transfers and nonblocking collective
+ * schedules keep moving while the application computes. Since the
+ * thread enters the PML and the BTLs concurrently with the application,
+ * enabling it turns on the same internal locking as
+ * MPI_THREAD_MULTIPLE; with the thread disabled the locks stay elided.
+ *
+ * The thread is pinned to mpi_async_progress_core if set. Otherwise it
+ * goes on another hardware thread of the core the application runs on,
+ * if the process is bound to one, or failing that on a core of the
+ * process' binding that the application does not use. If neither exists
+ * the thread is left unbound.
+ */
+
+#include "ompi_config.h"
+
+#include "opal/class/opal_object.h"
+#include "opal/mca/hwloc/base/base.h"
+#include "opal/mca/threads/threads.h"
+#include "opal/runtime/opal_progress.h"
+#include "opal/sys/atomic.h"
+#include "opal/util/output.h"
+#include "opal/util/show_help.h"
+
+#include "ompi/constants.h"
+#include "ompi/runtime/mpiruntime.h"
+#include "ompi/runtime/params.h"
+
+static struct {
+    opal_thread_t thread;
+    hwloc_cpuset_t cpuset;  /* NULL if unbound */
+    opal_atomic_int32_t running;
+    bool started;
+} async_progress;
+
+static void *async_progress_main(opal_object_t *obj)
+{
+    if (NULL != async_progress.cpuset) {
+        (void) hwloc_set_cpubind(opal_hwloc_topology, async_progress.cpuset,
+                                 HWLOC_CPUBIND_THREAD);
+    }
+
+    while (async_progress.running) {
+        opal_progress();
+    }
+
+    return OPAL_THREAD_CANCELLED;
+}
+
+/* Choose the processing unit(s) for the progress thread. Must be called
+ * from the application thread. */
+static hwloc_cpuset_t async_progress_pick_cpuset(void)
+{
+    hwloc_cpuset_t bound = NULL, current = NULL, set = NULL;
+    hwloc_obj_t core;
+    int ncores;
+
+    if (OPAL_SUCCESS != opal_hwloc_base_get_topology()) {
+        return NULL;
+    }
+
+    if (0 <= ompi_mpi_async_progress_core) {
+        core = hwloc_get_obj_by_type(opal_hwloc_topology, HWLOC_OBJ_CORE,
+                                     ompi_mpi_async_progress_core);
+        if (NULL == core) {
+            opal_show_help("help-mpi-runtime.txt", "async-progress:bad-core", true,
+                           ompi_mpi_async_progress_core);
+            return NULL;
+        }
+        return hwloc_bitmap_dup(core->cpuset);
+    }
+
+    bound = hwloc_bitmap_alloc();
+    current = hwloc_bitmap_alloc();
+    if (NULL == bound || NULL == current
+        || 0 != hwloc_get_cpubind(opal_hwloc_topology, bound, HWLOC_CPUBIND_PROCESS)
+        || 0 != hwloc_get_last_cpu_location(opal_hwloc_topology, current,
+                                            HWLOC_CPUBIND_THREAD)) {
+        goto done;
+    }
+
+    /* a sibling hardware thread of the application's core, within the
+     * binding of the process */
+    core = hwloc_get_next_obj_covering_cpuset_by_type(opal_hwloc_topology, current,
+                                                      HWLOC_OBJ_CORE, NULL);
+    if (NULL != core && hwloc_bitmap_weight(core->cpuset) > 1) {
+        set = hwloc_bitmap_dup(core->cpuset);
+        hwloc_bitmap_andnot(set, set, current);
+        hwloc_bitmap_and(set, set, bound);
+        if (!hwloc_bitmap_iszero(set)) {
+            hwloc_bitmap_singlify(set);
+            goto done;
+        }
+        hwloc_bitmap_free(set);
+        set = NULL;
+    }
+
+    /* otherwise the last core of the binding the application is not on */
+    ncores = hwloc_get_nbobjs_inside_cpuset_by_type(opal_hwloc_topology, bound,
+                                                    HWLOC_OBJ_CORE);
+    for (int i = ncores - 1; i >= 0; i--) {
+        core = hwloc_get_obj_inside_cpuset_by_type(opal_hwloc_topology, bound,
+                                                   HWLOC_OBJ_CORE, i);
+        if (NULL != core && !hwloc_bitmap_intersects(core->cpuset, current)) {
+            set = hwloc_bitmap_dup(core->cpuset);
+            break;
+        }
+    }
+
+done:
+    if (NULL != bound) {
+        hwloc_bitmap_free(bound);
+    }
+    if (NULL != current) {
+        hwloc_bitmap_free(current);
+    }
+    return set;
+}
+
+int ompi_mpi_async_progress_start(void)
+{
+    int ret;
+
+    if (!ompi_mpi_async_progress || async_progress.started) {
+        return OMPI_SUCCESS;
+    }
+
+    async_progress.cpuset = async_progress_pick_cpuset();
+    async_progress.running = 1;
+
+    OBJ_CONSTRUCT(&async_progress.thread, opal_thread_t);
+    async_progress.thread.t_run = async_progress_main;
+    async_progress.thread.t_arg = NULL;
+
+    opal_atomic_wmb();
+
+    ret = opal_thread_start(&async_progress.thread);
+    if (OPAL_SUCCESS != ret) {
+        OBJ_DESTRUCT(&async_progress.thread);
+        if (NULL != async_progress.cpuset) {
+            hwloc_bitmap_free(async_progress.cpuset);
+            async_progress.cpuset = NULL;
+        }
+        return ret;
+    }
+
+    async_progress.started = true;
+
+    return OMPI_SUCCESS;
+}
+
+void ompi_mpi_async_progress_stop(void)
+{
+    if (!async_progress.started) {
+        return;
+    }
+
+    async_progress.running = 0;
+    opal_atomic_wmb();
+    (void) opal_thread_join(&async_progress.thread, NULL);
+    OBJ_DESTRUCT(&async_progress.thread);
+
+    if (NULL != async_progress.cpuset) {
+        hwloc_bitmap_free(async_progress.cpuset);
+        async_progress.cpuset = NULL;
+    }
+
+    async_progress.started = false;
+}
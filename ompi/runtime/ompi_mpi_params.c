@@ -79,6 +79,9 @@ bool ompi_mpi_preconnect_mpi = false;
 bool ompi_async_mpi_init = false;
 bool ompi_async_mpi_finalize = false;
 
+bool ompi_mpi_async_progress = false;
+int ompi_mpi_async_progress_core = -1;
+
 #define OMPI_ADD_PROCS_CUTOFF_DEFAULT 0
 uint32_t ompi_add_procs_cutoff = OMPI_ADD_PROCS_CUTOFF_DEFAULT;
 bool ompi_mpi_dynamics_enabled = true;
@@ -351,6 +354,22 @@ int ompi_mpi_register_params(void)
                                  MCA_BASE_VAR_SCOPE_READONLY,
                                  &ompi_async_mpi_finalize);
 
+    ompi_mpi_async_progress = false;
+    (void) mca_base_var_register("ompi", "mpi", NULL, "async_progress",
+                                 "Progress communications from a dedicated thread, so that large nonblocking transfers and nonblocking collectives advance outside of MPI calls.  Enables the same internal locking as MPI_THREAD_MULTIPLE",
+                                 MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                 OPAL_INFO_LVL_5,
+                                 MCA_BASE_VAR_SCOPE_READONLY,
+                                 &ompi_mpi_async_progress);
+
+    ompi_mpi_async_progress_core = -1;
+    (void) mca_base_var_register("ompi", "mpi", NULL, "async_progress_core",
+                                 "Core (logical index) to bind the progress thread to (-1 = a spare hardware thread or core of the process binding, if any)",
+                                 MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                 OPAL_INFO_LVL_5,
+                                 MCA_BASE_VAR_SCOPE_READONLY,
+                                 &ompi_mpi_async_progress_core);
+
     value = mca_base_var_find ("opal", "opal", NULL, "abort_delay");
     if (0 <= value) {
         (void) mca_base_var_register_synonym(value, "ompi", "mpi", NULL, "abort_delay",
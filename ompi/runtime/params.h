@@ -159,6 +159,17 @@ OMPI_DECLSPEC extern bool ompi_async_mpi_init;
 /* EXPERIMENTAL: do not perform an RTE barrier at the beginning of MPI_Finalize */
 OMPI_DECLSPEC extern bool ompi_async_mpi_finalize;
 
+/**
+ * Whether to run a thread progressing communications in the background
+ */
+OMPI_DECLSPEC extern bool ompi_mpi_async_progress;
+
+/**
+ * Core (logical index) the progress thread is bound to, or -1 to pick
+ * one automatically
+ */
+OMPI_DECLSPEC extern int ompi_mpi_async_progress_core;
+
 #if OPAL_ENABLE_FT_MPI
 OMPI_DECLSPEC extern int ompi_ftmpi_output_handle;
 OMPI_DECLSPEC extern bool ompi_ftmpi_enabled;
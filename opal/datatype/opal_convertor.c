@@ -242,6 +242,18 @@ opal_convertor_t *opal_convertor_create(int32_t remote_arch, int32_t mode)
  *        1 if everything went fine and the data was completely converted
  *       -1 something wrong occurs.
  */
+/* Large conversions of non-contiguous homogeneous data into (from) a single
+ * buffer can be split across the helper threads, see opal_convertor_parallel.c */
+static inline bool opal_convertor_use_parallel(const opal_convertor_t *pConv,
+                                               const struct iovec *iov, uint32_t out_size)
+{
+    return (0 != opal_ddt_pack_threads) && (1 == out_size) && (NULL != iov[0].iov_base)
+           && (iov[0].iov_len >= opal_ddt_pack_threads_min_size)
+           && ((pConv->local_size - pConv->bConverted) >= opal_ddt_pack_threads_min_size)
+           && (pConv->flags & CONVERTOR_HOMOGENEOUS)
+           && !(pConv->flags & (CONVERTOR_ACCELERATOR | CONVERTOR_WITH_CHECKSUM));
+}
+
 int32_t opal_convertor_pack(opal_convertor_t *pConv, struct iovec *iov, uint32_t *out_size,
                             size_t *max_data)
 {
@@ -289,6 +301,11 @@ int32_t opal_convertor_pack(opal_convertor_t *pConv, struct iovec *iov, uint32_t
         return 1;
     }
 
+    if (OPAL_UNLIKELY(opal_convertor_use_parallel(pConv, iov, *out_size))
+        && (OPAL_SUCCESS == opal_convertor_parallel(pConv, iov, out_size, max_data))) {
+        return (pConv->flags & CONVERTOR_COMPLETED) ? 1 : 0;
+    }
+
     return pConv->fAdvance(pConv, iov, out_size, max_data);
 }
 
@@ -332,6 +349,11 @@ int32_t opal_convertor_unpack(opal_convertor_t *pConv, struct iovec *iov, uint32
         return 1;
     }
 
+    if (OPAL_UNLIKELY(opal_convertor_use_parallel(pConv, iov, *out_size))
+        && (OPAL_SUCCESS == opal_convertor_parallel(pConv, iov, out_size, max_data))) {
+        return (pConv->flags & CONVERTOR_COMPLETED) ? 1 : 0;
+    }
+
     return pConv->fAdvance(pConv, iov, out_size, max_data);
 }
 
@@ -433,7 +455,11 @@ int32_t opal_convertor_set_position_nocheck(opal_convertor_t *convertor, size_t
         rc = opal_convertor_create_stack_with_pos_contig(convertor, (*position),
                                                          opal_datatype_local_sizes);
     } else {
-        if ((0 == (*position)) || ((*position) < convertor->bConverted)) {
+        /* The strided functions and the cached raw iovecs track the position with
+         * bConverted only, the stack is not up to date and has to be rebuilt from
+         * the beginning. */
+        if ((0 == (*position)) || ((*position) < convertor->bConverted)
+            || (convertor->flags & CONVERTOR_STACKLESS)) {
             rc = opal_convertor_create_stack_at_begining(convertor, opal_datatype_local_sizes);
             if (0 == (*position)) {
                 return rc;
@@ -549,6 +575,13 @@ size_t opal_convertor_compute_remote_size(opal_convertor_t *pConvertor)
         opal_convertor_create_stack_at_begining(convertor, opal_datatype_local_sizes);          \
     }
 
+/* The strided functions copy with plain memcpy, so they are only used for host memory */
+static inline bool opal_convertor_use_strided(const opal_convertor_t *convertor)
+{
+    return opal_ddt_strided && (0 != convertor->pDesc->strided.count)
+           && !(convertor->flags & CONVERTOR_ACCELERATOR);
+}
+
 static void opal_convertor_accelerator_init(opal_convertor_t *convertor, const void *addr)
 {
     uint64_t flags = 0;
@@ -598,6 +631,9 @@ int32_t opal_convertor_prepare_for_recv(opal_convertor_t *convertor,
         } else {
             if (convertor->pDesc->flags & OPAL_DATATYPE_FLAG_CONTIGUOUS) {
                 convertor->fAdvance = opal_unpack_homogeneous_contig;
+            } else if (opal_convertor_use_strided(convertor)) {
+                convertor->fAdvance = opal_unpack_strided;
+                convertor->flags |= CONVERTOR_STACKLESS;
             } else {
                 convertor->fAdvance = opal_generic_simple_unpack;
             }
@@ -649,6 +685,9 @@ int32_t opal_convertor_prepare_for_send(opal_convertor_t *convertor,
                 } else {
                     convertor->fAdvance = opal_pack_homogeneous_contig_with_gaps;
                 }
+            } else if (opal_convertor_use_strided(convertor)) {
+                convertor->fAdvance = opal_pack_strided;
+                convertor->flags |= CONVERTOR_STACKLESS;
             } else {
                 convertor->fAdvance = opal_generic_simple_pack;
             }
@@ -48,6 +48,22 @@ opal_convertor_master_t *opal_convertor_find_or_create_master(uint32_t remote_ar
  */
 void opal_convertor_destroy_masters(void);
 
+/*
+ * Pack or unpack a large part of a message into (from) iov[0] with the help of
+ * the datatype helper threads. Returns OPAL_SUCCESS if the data was converted,
+ * otherwise the convertor is left untouched and the caller should convert the
+ * data itself.
+ */
+int opal_convertor_parallel(opal_convertor_t *pConv, struct iovec *iov, uint32_t *out_size,
+                            size_t *max_data);
+
+/*
+ * Set up and stop the datatype helper threads, which report on output. The
+ * threads themselves are only started on first use.
+ */
+void opal_convertor_parallel_init(int output);
+void opal_convertor_parallel_finalize(void);
+
 END_C_DECLS
 
 #endif /* OPAL_CONVERTOR_INTERNAL_HAS_BEEN_INCLUDED */
@@ -0,0 +1,206 @@
+/* -*- Mode: C; c-basic-offset:4 ; -*- */
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+ * Multi-threaded pack and unpack.
+ *
+ * When mpi_ddt_pack_threads is non-zero, a pack or unpack of at least
+ * mpi_ddt_pack_threads_min_size bytes of a non-contiguous homogeneous
+ * message into (from) a single buffer is cut into ranges of the packed
+ * stream. Each range gets its own convertor, positioned at the beginning
+ * of the range with opal_convertor_set_position, and the ranges are handed
+ * out on demand to the calling thread and to a pool of helper threads,
+ * created on first use. The ranges start on predefined element
+ * boundaries, so no two threads ever write the same element. Once all the
+ * ranges are done the state of the convertor of the last range becomes
+ * the state of the caller's convertor, which then continues as if it had
+ * done the whole conversion itself.
+ *
+ * The ranges are processed by the calling thread and by a pool of helper
+ * threads (see opal/runtime/opal_helper_threads.h), created on first use.
+ * The pool runs one conversion at a time; a thread that finds it busy
+ * converts its data serially.
+ */
+
+#include "opal_config.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "opal/class/opal_object.h"
+#include "opal/runtime/opal_helper_threads.h"
+#include "opal/sys/atomic.h"
+
+#include "opal/datatype/opal_convertor.h"
+#include "opal/datatype/opal_convertor_internal.h"
+#include "opal/datatype/opal_datatype_internal.h"
+
+int opal_ddt_pack_threads = 0;
+size_t opal_ddt_pack_threads_min_size = 16 * 1024 * 1024;
+
+/* Each participant gets a few ranges, so that a helper that is slow to
+ * wake up does not hold back the whole conversion. Ranges are never
+ * smaller than CONVERTOR_THREADS_MIN_RANGE bytes. */
+#define CONVERTOR_THREADS_RANGES_PER_THREAD 4
+#define CONVERTOR_THREADS_MIN_RANGE (1024 * 1024)
+
+typedef struct {
+    opal_convertor_t *convs; /* one per range */
+    size_t *bounds;          /* nranges + 1 positions in the packed stream */
+    unsigned char *buffer;   /* packed data of the first range */
+    opal_atomic_int32_t failed_ranges;
+} convertor_threads_job_t;
+
+static opal_helper_threads_t convertor_threads;
+
+static void convertor_threads_work(void *arg, int32_t range)
+{
+    convertor_threads_job_t *job = (convertor_threads_job_t *) arg;
+    opal_convertor_t *conv = &job->convs[range];
+    struct iovec iov;
+    uint32_t iov_count = 1;
+    size_t max_data;
+
+    iov.iov_base = (IOVBASE_TYPE *) (job->buffer + (job->bounds[range] - job->bounds[0]));
+    iov.iov_len = job->bounds[range + 1] - job->bounds[range];
+    max_data = iov.iov_len;
+
+    conv->fAdvance(conv, &iov, &iov_count, &max_data);
+    if (OPAL_UNLIKELY(max_data != (job->bounds[range + 1] - job->bounds[range]))) {
+        opal_atomic_add_fetch_32(&job->failed_ranges, 1);
+    }
+}
+
+void opal_convertor_parallel_init(int output)
+{
+    opal_helper_threads_init(&convertor_threads, "datatype:pack_threads", output);
+}
+
+void opal_convertor_parallel_finalize(void)
+{
+    opal_helper_threads_fini(&convertor_threads);
+}
+
+/* Cut [start, start + length) into ranges starting on predefined element
+ * boundaries, and position a convertor at the beginning of each of them.
+ * Returns the number of ranges. */
+static int32_t convertor_threads_split(opal_convertor_t *pConv, size_t length, int32_t nranges,
+                                       opal_convertor_t *convs, size_t *bounds)
+{
+    size_t start = pConv->bConverted, range_length = length / nranges, position;
+    opal_convertor_t scout;
+    int32_t count = 1;
+
+    /* The first range continues from the current state, including a
+     * predefined element left incomplete by the previous call */
+    OBJ_CONSTRUCT(&convs[0], opal_convertor_t);
+    opal_convertor_clone(pConv, &convs[0], 1);
+    convs[0].partial_length = pConv->partial_length;
+    bounds[0] = start;
+
+    OBJ_CONSTRUCT(&scout, opal_convertor_t);
+    opal_convertor_clone(pConv, &scout, 1);
+    scout.partial_length = pConv->partial_length;
+
+    for (int32_t i = 1; i < nranges; i++) {
+        position = start + i * range_length;
+        opal_convertor_set_position(&scout, &position);
+        /* move back to the beginning of the current predefined element, the
+         * stack of the convertor already points to it */
+        position = scout.bConverted - scout.partial_length;
+        if (position <= bounds[count - 1]) {
+            continue; /* a predefined element larger than a range */
+        }
+        OBJ_CONSTRUCT(&convs[count], opal_convertor_t);
+        opal_convertor_clone(&scout, &convs[count], 1);
+        convs[count].bConverted = position;
+        bounds[count++] = position;
+    }
+    bounds[count] = start + length;
+
+    OBJ_DESTRUCT(&scout);
+    return count;
+}
+
+int opal_convertor_parallel(opal_convertor_t *pConv, struct iovec *iov, uint32_t *out_size,
+                            size_t *max_data)
+{
+    convertor_threads_job_t job;
+    opal_convertor_t *convs, *last;
+    size_t length, *bounds;
+    int32_t nranges;
+    int nhelpers, rc = OPAL_SUCCESS;
+
+    length = pConv->local_size - pConv->bConverted;
+    if (length > iov[0].iov_len) {
+        length = iov[0].iov_len;
+    }
+
+    nhelpers = opal_helper_threads_acquire(&convertor_threads, opal_ddt_pack_threads);
+    if (nhelpers < 0) {
+        return nhelpers;
+    }
+
+    nranges = (nhelpers + 1) * CONVERTOR_THREADS_RANGES_PER_THREAD;
+    if ((size_t) nranges > length / CONVERTOR_THREADS_MIN_RANGE) {
+        nranges = (int32_t) (length / CONVERTOR_THREADS_MIN_RANGE);
+    }
+    if (nranges < 2) {
+        opal_helper_threads_release(&convertor_threads);
+        return OPAL_ERR_NOT_SUPPORTED;
+    }
+
+    convs = (opal_convertor_t *) malloc(nranges * sizeof(opal_convertor_t));
+    bounds = (size_t *) malloc((nranges + 1) * sizeof(size_t));
+    if (NULL == convs || NULL == bounds) {
+        free(convs);
+        free(bounds);
+        opal_helper_threads_release(&convertor_threads);
+        return OPAL_ERR_OUT_OF_RESOURCE;
+    }
+    nranges = convertor_threads_split(pConv, length, nranges, convs, bounds);
+
+    job.convs = convs;
+    job.bounds = bounds;
+    job.buffer = (unsigned char *) iov[0].iov_base;
+    job.failed_ranges = 0;
+
+    opal_helper_threads_run(&convertor_threads, convertor_threads_work, &job, nranges);
+
+    if (OPAL_UNLIKELY(0 != job.failed_ranges)) {
+        /* the caller's convertor is untouched, it can redo the whole conversion */
+        rc = OPAL_ERROR;
+    } else {
+        /* continue from where the last range stopped */
+        last = &convs[nranges - 1];
+        memcpy(pConv->pStack, last->pStack, sizeof(dt_stack_t) * (last->stack_pos + 1));
+        pConv->stack_pos = last->stack_pos;
+        pConv->bConverted = last->bConverted;
+        pConv->partial_length = last->partial_length;
+        if (pConv->bConverted == pConv->local_size) {
+            pConv->flags |= CONVERTOR_COMPLETED;
+        }
+        iov[0].iov_len = length;
+        *out_size = 1;
+        *max_data = length;
+    }
+
+    for (int32_t i = 0; i < nranges; i++) {
+        OBJ_DESTRUCT(&convs[i]);
+    }
+    free(convs);
+    free(bounds);
+
+    opal_helper_threads_release(&convertor_threads);
+
+    return rc;
+}
@@ -17,9 +17,11 @@
 #include "opal_config.h"
 
 #include <stddef.h>
+#include <stdlib.h>
 
 #include "opal/datatype/opal_convertor_internal.h"
 #include "opal/datatype/opal_datatype_internal.h"
+#include "opal/sys/atomic.h"
 #include "opal_stdint.h"
 
 #if OPAL_ENABLE_DEBUG
@@ -56,13 +58,230 @@ static inline int opal_convertor_merge_iov(struct iovec *iov, uint32_t *iov_coun
     return 0;
 }
 
+/*
+ * Cached iovec representation of the datatypes.
+ *
+ * The contiguous segments of one instance of a committed datatype are
+ * the same for every convertor and every count, only shifted by the
+ * extent from one instance to the next. The first time a datatype goes
+ * through opal_convertor_raw its segments are collected, by walking the
+ * description once for a single instance, into a template attached to the
+ * datatype (raw_cache) and freed with it. The following calls build the iovecs
+ * from the template: the position follows from the number of bytes
+ * already converted, so neither the description nor the convertor stack
+ * are used. Datatypes with more than mpi_ddt_raw_cache_max_segments
+ * segments per instance are not cached, the template would be as large
+ * as the iovecs themselves.
+ */
+size_t opal_ddt_raw_cache_max_segments = 4096;
+
+typedef struct {
+    uint32_t nseg;
+    ptrdiff_t *disp; /* of each segment, from the beginning of the user buffer */
+    size_t *start;   /* position of each segment in the packed data, nseg + 1 entries */
+} opal_datatype_raw_template_t;
+
+/* stored for the datatypes that cannot be cached, so they are only tried once */
+static opal_datatype_raw_template_t opal_datatype_raw_no_template;
+
+static int32_t opal_convertor_raw_generic(opal_convertor_t *pConvertor, struct iovec *iov,
+                                          uint32_t *iov_count, size_t *length);
+
+#define OPAL_DATATYPE_RAW_TEMPLATE_IOVEC 64
+
+static opal_datatype_raw_template_t *opal_datatype_raw_template_build(const opal_datatype_t *pData)
+{
+    struct iovec iov[OPAL_DATATYPE_RAW_TEMPLATE_IOVEC];
+    opal_datatype_raw_template_t *tmpl = NULL;
+    ptrdiff_t *disp = NULL, *tmp_disp;
+    size_t *len = NULL, *tmp_len, max_data, position = 0;
+    uint32_t iov_count, nseg = 0, max_seg = 0;
+    opal_convertor_t *pConv;
+    int32_t rc;
+
+    pConv = opal_convertor_create(opal_local_arch, 0);
+    if (OPAL_UNLIKELY(NULL == pConv)) {
+        return NULL;
+    }
+    if (OPAL_SUCCESS != opal_convertor_prepare_for_send(pConv, pData, 1, NULL)) {
+        goto cleanup;
+    }
+
+    do {
+        iov_count = OPAL_DATATYPE_RAW_TEMPLATE_IOVEC;
+        rc = opal_convertor_raw_generic(pConv, iov, &iov_count, &max_data);
+        for (uint32_t i = 0; i < iov_count; i++) {
+            if ((0 != nseg)
+                && ((disp[nseg - 1] + (ptrdiff_t) len[nseg - 1]) == (ptrdiff_t) iov[i].iov_base)) {
+                len[nseg - 1] += iov[i].iov_len; /* merge with the previous segment */
+                continue;
+            }
+            if (nseg == max_seg) {
+                if (nseg >= opal_ddt_raw_cache_max_segments) {
+                    goto cleanup;
+                }
+                max_seg = (0 == max_seg) ? OPAL_DATATYPE_RAW_TEMPLATE_IOVEC : 2 * max_seg;
+                tmp_disp = (ptrdiff_t *) realloc(disp, max_seg * sizeof(ptrdiff_t));
+                if (NULL == tmp_disp) {
+                    goto cleanup;
+                }
+                disp = tmp_disp;
+                tmp_len = (size_t *) realloc(len, max_seg * sizeof(size_t));
+                if (NULL == tmp_len) {
+                    goto cleanup;
+                }
+                len = tmp_len;
+            }
+            disp[nseg] = (ptrdiff_t) iov[i].iov_base;
+            len[nseg++] = iov[i].iov_len;
+        }
+    } while (1 != rc);
+
+    if ((0 == nseg) || (nseg > opal_ddt_raw_cache_max_segments)) {
+        goto cleanup;
+    }
+
+    tmpl = (opal_datatype_raw_template_t *) malloc(sizeof(opal_datatype_raw_template_t)
+                                                   + nseg * sizeof(ptrdiff_t)
+                                                   + (nseg + 1) * sizeof(size_t));
+    if (NULL == tmpl) {
+        goto cleanup;
+    }
+    tmpl->nseg = nseg;
+    tmpl->disp = (ptrdiff_t *) (tmpl + 1);
+    tmpl->start = (size_t *) (tmpl->disp + nseg);
+    for (uint32_t i = 0; i < nseg; i++) {
+        tmpl->disp[i] = disp[i];
+        tmpl->start[i] = position;
+        position += len[i];
+    }
+    tmpl->start[nseg] = position;
+    if (position != pData->size) {
+        free(tmpl);
+        tmpl = NULL;
+    }
+
+cleanup:
+    free(disp);
+    free(len);
+    OBJ_RELEASE(pConv);
+    return tmpl;
+}
+
+/* Return the template of a datatype, building it on first use, or NULL if
+ * the datatype cannot be cached. Threads racing on the first use may each
+ * build a template, only the first one is attached to the datatype. The
+ * predefined datatypes may be read-only, and are never cached. */
+static const opal_datatype_raw_template_t *opal_datatype_raw_template(const opal_datatype_t *pData)
+{
+    /* the cache is not part of the description, it can be set on a const datatype */
+    opal_datatype_t *datatype = (opal_datatype_t *) pData;
+    opal_datatype_raw_template_t *tmpl;
+    intptr_t expected = 0;
+
+    if (0 == opal_ddt_raw_cache_max_segments) {
+        return NULL;
+    }
+
+    tmpl = (opal_datatype_raw_template_t *) datatype->raw_cache;
+    if (OPAL_LIKELY(NULL != tmpl)) {
+        opal_atomic_rmb();
+    } else {
+        if (opal_datatype_is_predefined(pData) || !opal_datatype_is_committed(pData)
+            || (0 == pData->size)) {
+            return NULL;
+        }
+
+        tmpl = opal_datatype_raw_template_build(pData);
+        if (NULL == tmpl) {
+            tmpl = &opal_datatype_raw_no_template;
+        }
+        if (!opal_atomic_compare_exchange_strong_ptr(&datatype->raw_cache, &expected,
+                                                     (intptr_t) tmpl)) {
+            if (&opal_datatype_raw_no_template != tmpl) {
+                free(tmpl); /* another thread was faster */
+            }
+            tmpl = (opal_datatype_raw_template_t *) expected;
+        }
+    }
+
+    return (&opal_datatype_raw_no_template == tmpl) ? NULL : tmpl;
+}
+
+void opal_datatype_raw_cache_release(opal_datatype_t *pData)
+{
+    opal_datatype_raw_template_t *tmpl = (opal_datatype_raw_template_t *) pData->raw_cache;
+
+    if ((NULL != tmpl) && (&opal_datatype_raw_no_template != tmpl)) {
+        free(tmpl);
+    }
+    pData->raw_cache = 0;
+}
+
+/* opal_convertor_raw from the template of the datatype */
+static int32_t opal_convertor_raw_cached(opal_convertor_t *pConvertor,
+                                         const opal_datatype_raw_template_t *tmpl,
+                                         struct iovec *iov, uint32_t *iov_count, size_t *length)
+{
+    const opal_datatype_t *pData = pConvertor->pDesc;
+    ptrdiff_t extent = pData->ub - pData->lb;
+    size_t count, rem, blength, sum_iov_len = 0;
+    uint32_t seg, last, mid, index = 0;
+    unsigned char *source_base;
+
+    /* where we are: instance of the datatype, segment, offset in the segment */
+    count = pConvertor->bConverted / pData->size;
+    rem = pConvertor->bConverted - count * pData->size;
+    for (seg = 0, last = tmpl->nseg - 1; seg < last;) {
+        mid = (seg + last + 1) / 2;
+        if (tmpl->start[mid] <= rem) {
+            seg = mid;
+        } else {
+            last = mid - 1;
+        }
+    }
+    rem -= tmpl->start[seg];
+    source_base = pConvertor->pBaseBuf + count * extent;
+
+    iov[index].iov_len = 0;
+    while ((pConvertor->bConverted + sum_iov_len) < pConvertor->local_size) {
+        blength = tmpl->start[seg + 1] - tmpl->start[seg] - rem;
+        OPAL_DATATYPE_SAFEGUARD_POINTER(source_base + tmpl->disp[seg] + rem, blength,
+                                        pConvertor->pBaseBuf, pConvertor->pDesc,
+                                        pConvertor->count);
+        if (opal_convertor_merge_iov(iov, iov_count,
+                                     (IOVBASE_TYPE *) (source_base + tmpl->disp[seg] + rem),
+                                     blength, &index)) {
+            goto complete_loop; /* no more iovec available */
+        }
+        sum_iov_len += blength;
+        rem = 0;
+        if (++seg == tmpl->nseg) {
+            seg = 0;
+            source_base += extent;
+        }
+    }
+    index++; /* account for the currently updating iovec */
+
+complete_loop:
+    pConvertor->flags |= CONVERTOR_STACKLESS;
+    pConvertor->bConverted += sum_iov_len;
+    *length = sum_iov_len;
+    *iov_count = index;
+    if (pConvertor->bConverted == pConvertor->local_size) {
+        pConvertor->flags |= CONVERTOR_COMPLETED;
+        return 1;
+    }
+    return 0;
+}
+
 /**
  * This function always work in local representation. This means no representation
  * conversion (i.e. no heterogeneity) is taken into account, and that all
  * length we're working on are local.
  */
-int32_t opal_convertor_raw(opal_convertor_t *pConvertor, struct iovec *iov, uint32_t *iov_count,
-                           size_t *length)
+static int32_t opal_convertor_raw_generic(opal_convertor_t *pConvertor, struct iovec *iov,
+                                          uint32_t *iov_count, size_t *length)
 {
     const opal_datatype_t *pData = pConvertor->pDesc;
     dt_stack_t *pStack; /* pointer to the position on the stack */
@@ -280,3 +499,19 @@ complete_loop:
                     pConvertor->stack_pos, pStack->index, pStack->count, (long) pStack->disp););
     return 0;
 }
+
+int32_t opal_convertor_raw(opal_convertor_t *pConvertor, struct iovec *iov, uint32_t *iov_count,
+                           size_t *length)
+{
+    const opal_datatype_raw_template_t *tmpl;
+
+    /* The template can only be used from the beginning, or if the convertor
+     * never relied on its stack */
+    if (!(pConvertor->flags & (CONVERTOR_COMPLETED | CONVERTOR_NO_OP))
+        && ((0 == pConvertor->bConverted) || (pConvertor->flags & CONVERTOR_STACKLESS))
+        && (NULL != (tmpl = opal_datatype_raw_template(pConvertor->pDesc)))) {
+        assert((*iov_count) > 0);
+        return opal_convertor_raw_cached(pConvertor, tmpl, iov, iov_count, length);
+    }
+    return opal_convertor_raw_generic(pConvertor, iov, iov_count, length);
+}
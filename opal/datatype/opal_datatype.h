@@ -42,6 +42,7 @@
 #include <stddef.h>
 
 #include "opal/class/opal_object.h"
+#include "opal/sys/atomic.h"
 
 BEGIN_C_DECLS
 
@@ -109,6 +110,33 @@ struct dt_type_desc_t {
 };
 typedef struct dt_type_desc_t dt_type_desc_t;
 
+#define OPAL_DATATYPE_STRIDED_SEGS 3
+
+/**
+ * Shape of the datatypes handled by the strided pack and unpack functions:
+ * a group of up to OPAL_DATATYPE_STRIDED_SEGS contiguous segments, repeated
+ * count times with a fixed stride. It is computed when the datatype is
+ * committed; a count of zero means the datatype does not have this shape.
+ *
+ * Datatypes with more than one strided dimension, such as 3-D subarrays,
+ * have ndim inner dimensions: a group is then a single segment, seg[0],
+ * repeated along the dimensions stored in the following entries, innermost
+ * first. seg[1 + d].len is the number of repetitions along dimension d and
+ * seg[1 + d].disp the distance between two of them.
+ */
+struct opal_datatype_strided_t {
+    ptrdiff_t disp;   /**< displacement of the first group */
+    ptrdiff_t stride; /**< distance between the beginning of two consecutive groups */
+    uint32_t count;   /**< number of groups in the datatype */
+    uint16_t nseg;    /**< number of segments in each group */
+    uint16_t ndim;    /**< number of inner dimensions of each group */
+    struct {
+        int32_t disp; /**< displacement from the beginning of the group */
+        uint32_t len; /**< length in bytes */
+    } seg[OPAL_DATATYPE_STRIDED_SEGS];
+};
+typedef struct opal_datatype_strided_t opal_datatype_strided_t;
+
 /*
  * The datatype description.
  */
@@ -141,9 +169,12 @@ struct opal_datatype_t {
                          layer). This field should never be initialized in homogeneous
                          environments */
     /* --- cacheline 5 boundary (320 bytes) was 32-36 bytes ago --- */
+    opal_datatype_strided_t strided; /**< shape for the strided pack/unpack functions */
+    opal_atomic_intptr_t raw_cache;  /**< iovec template of opal_convertor_raw, built on
+                                          first use (see opal_convertor_raw.c) */
 
-    /* size: 352, cachelines: 6, members: 15 */
-    /* last cacheline: 28-32 bytes */
+    /* size: 400, cachelines: 7, members: 16 */
+    /* last cacheline: 16 bytes */
 };
 
 typedef struct opal_datatype_t opal_datatype_t;
@@ -44,6 +44,7 @@ int32_t opal_datatype_clone(const opal_datatype_t *src_type, opal_datatype_t *de
 
     dest_type->flags &= (~OPAL_DATATYPE_FLAG_PREDEFINED);
     dest_type->ptypes = NULL;
+    dest_type->raw_cache = 0;
     dest_type->desc.desc = temp;
 
     /**
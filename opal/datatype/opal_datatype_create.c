@@ -55,6 +55,8 @@ static void opal_datatype_construct(opal_datatype_t *pData)
 
     pData->ptypes = NULL;
     pData->loops = 0;
+    memset(&pData->strided, 0, sizeof(opal_datatype_strided_t));
+    pData->raw_cache = 0;
 }
 
 static void opal_datatype_destruct(opal_datatype_t *datatype)
@@ -85,6 +87,8 @@ static void opal_datatype_destruct(opal_datatype_t *datatype)
         datatype->ptypes = NULL;
     }
 
+    opal_datatype_raw_cache_release(datatype);
+
     /* make sure the name is set to empty */
     datatype->name[0] = '\0';
 }
@@ -594,6 +594,16 @@ extern bool opal_ddt_copy_debug;
 extern bool opal_ddt_unpack_debug;
 extern bool opal_ddt_pack_debug;
 extern bool opal_ddt_raw_debug;
+extern bool opal_ddt_strided;
+extern int opal_ddt_pack_threads;
+extern size_t opal_ddt_pack_threads_min_size;
+extern size_t opal_ddt_raw_cache_max_segments;
+
+/* Compute pData->strided from the optimized description */
+void opal_datatype_strided_shape(opal_datatype_t *pData);
+
+/* Free the cached raw iovec template of a datatype */
+void opal_datatype_raw_cache_release(opal_datatype_t *pData);
 
 END_C_DECLS
 #endif /* OPAL_DATATYPE_INTERNAL_H_HAS_BEEN_INCLUDED */
@@ -46,6 +46,7 @@ bool opal_ddt_pack_debug = false;
 bool opal_ddt_position_debug = false;
 bool opal_ddt_copy_debug = false;
 bool opal_ddt_raw_debug = false;
+bool opal_ddt_strided = false;
 int opal_ddt_verbose = -1; /* Has the datatype verbose it's own output stream */
 
 /* Using this macro implies that at this point _all_ information needed
@@ -169,9 +170,50 @@ OPAL_DECLSPEC const opal_datatype_t *opal_datatype_basicDatatypes[OPAL_DATATYPE_
 
 int opal_datatype_register_params(void)
 {
-#if OPAL_ENABLE_DEBUG
     int ret;
 
+    ret = mca_base_var_register(
+        "opal", "mpi", NULL, "ddt_strided",
+        "Whether to use the pack and unpack functions specialized for strided datatypes "
+        "(vectors, subarrays with a single strided dimension, small structures with gaps) "
+        "instead of the generic ones",
+        MCA_BASE_VAR_TYPE_BOOL, NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE, OPAL_INFO_LVL_5,
+        MCA_BASE_VAR_SCOPE_LOCAL, &opal_ddt_strided);
+    if (0 > ret) {
+        return ret;
+    }
+
+    ret = mca_base_var_register(
+        "opal", "mpi", NULL, "ddt_pack_threads",
+        "Number of helper threads splitting large packs and unpacks of non-contiguous data "
+        "with the calling thread (0 = disabled)",
+        MCA_BASE_VAR_TYPE_INT, NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE, OPAL_INFO_LVL_5,
+        MCA_BASE_VAR_SCOPE_LOCAL, &opal_ddt_pack_threads);
+    if (0 > ret) {
+        return ret;
+    }
+
+    ret = mca_base_var_register(
+        "opal", "mpi", NULL, "ddt_pack_threads_min_size",
+        "Minimum number of bytes packed or unpacked in a single call for the helper threads "
+        "to be used",
+        MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE, OPAL_INFO_LVL_5,
+        MCA_BASE_VAR_SCOPE_LOCAL, &opal_ddt_pack_threads_min_size);
+    if (0 > ret) {
+        return ret;
+    }
+
+    ret = mca_base_var_register(
+        "opal", "mpi", NULL, "ddt_raw_cache_max_segments",
+        "Maximum number of contiguous segments in one instance of a datatype for its iovec "
+        "representation to be cached by opal_convertor_raw (0 = no caching)",
+        MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE, OPAL_INFO_LVL_5,
+        MCA_BASE_VAR_SCOPE_LOCAL, &opal_ddt_raw_cache_max_segments);
+    if (0 > ret) {
+        return ret;
+    }
+
+#if OPAL_ENABLE_DEBUG
     ret = mca_base_var_register(
         "opal", "mpi", NULL, "ddt_unpack_debug",
         "Whether to output debugging information in the ddt unpack functions (nonzero = enabled)",
@@ -239,6 +281,8 @@ static void opal_datatype_finalize(void)
     /* As they are statically allocated they cannot be released. But we
      * can call OBJ_DESTRUCT, just to free all internally allocated resources.
      */
+    opal_convertor_parallel_finalize();
+
     /* clear all master convertors */
     opal_convertor_destroy_masters();
 
@@ -283,6 +327,8 @@ int32_t opal_datatype_init(void)
         opal_output_set_verbosity(opal_datatype_dfd, opal_ddt_verbose);
     }
 
+    opal_convertor_parallel_init(opal_datatype_dfd);
+
     opal_finalize_register_cleanup(opal_datatype_finalize);
 
     return OPAL_SUCCESS;
@@ -0,0 +1,468 @@
+/* -*- Mode: C; c-basic-offset:4 ; -*- */
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+ * Pack and unpack functions for strided datatypes.
+ *
+ * When a datatype is committed, opal_datatype_strided_shape() checks if its
+ * optimized description is a group of at most OPAL_DATATYPE_STRIDED_SEGS
+ * contiguous segments repeated with a fixed stride. This covers vectors,
+ * subarrays with a single strided dimension, small structures with gaps
+ * and vectors of such structures. Nests of loops around a single block, as
+ * built for subarrays and darrays with more strided dimensions, become an
+ * N-dimensional shape: affine dimensions are merged, and the remaining
+ * ones are walked with plain counters. For these datatypes the position in
+ * the user buffer follows from the number of bytes already converted, so
+ * the functions below neither interpret the description nor use the
+ * convertor stack. Groups made of a single segment, and the rows of the
+ * N-dimensional shapes, are copied by kernels specialized on the segment
+ * length, for which the compiler generates fixed size (vector) loads and
+ * stores instead of calls to memcpy.
+ */
+
+#include "opal_config.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "opal/datatype/opal_convertor.h"
+#include "opal/datatype/opal_convertor_internal.h"
+#include "opal/datatype/opal_datatype_internal.h"
+#include "opal/datatype/opal_datatype_memcpy.h"
+#include "opal/datatype/opal_datatype_prototypes.h"
+
+/* Add a dimension of an N-D shape, innermost first, merging it with the
+ * previous one when they are affine. Returns false if there are too many
+ * dimensions. */
+static bool opal_strided_add_dim(size_t *row, size_t *counts, ptrdiff_t *strides, size_t *ndims,
+                                 size_t count, ptrdiff_t stride)
+{
+    if (1 == count) {
+        return true;
+    }
+    if ((0 == *ndims) && (stride == (ptrdiff_t) *row)) {
+        *row *= count;
+        return true;
+    }
+    if ((0 != *ndims) && (stride == (ptrdiff_t) counts[*ndims - 1] * strides[*ndims - 1])) {
+        counts[*ndims - 1] *= count;
+        return true;
+    }
+    if (OPAL_DATATYPE_STRIDED_SEGS == *ndims) {
+        return false;
+    }
+    counts[*ndims] = count;
+    strides[*ndims] = stride;
+    (*ndims)++;
+    return true;
+}
+
+void opal_datatype_strided_shape(opal_datatype_t *pData)
+{
+    const dt_elem_desc_t *desc = pData->opt_desc.desc;
+    size_t used = pData->opt_desc.used, first, last, group = 0, depth, i;
+    opal_datatype_strided_t shape;
+
+    memset(&pData->strided, 0, sizeof(opal_datatype_strided_t));
+    memset(&shape, 0, sizeof(opal_datatype_strided_t));
+    if ((pData->flags & OPAL_DATATYPE_FLAG_CONTIGUOUS) || (0 == used) || (0 == pData->size)) {
+        return;
+    }
+
+    /* loops around the whole description, each one around the next one */
+    for (depth = 0; OPAL_DATATYPE_LOOP == desc[depth].elem.common.type; depth++) {
+        if (((2 * depth + 1) >= used) || (desc[depth].loop.items != (used - 1 - 2 * depth))) {
+            return;
+        }
+    }
+    first = depth;
+    last = used - depth;
+
+    if ((1 == (last - first)) && (desc[first].elem.common.flags & OPAL_DATATYPE_FLAG_DATA)) {
+        /* a single block, repeated by its count and by the loops */
+        const ddt_elem_desc_t *elem = &desc[first].elem;
+        size_t row = elem->blocklen * opal_datatype_basicDatatypes[elem->common.type]->size;
+        size_t counts[OPAL_DATATYPE_STRIDED_SEGS], ndims = 0;
+        ptrdiff_t strides[OPAL_DATATYPE_STRIDED_SEGS];
+
+        if (!opal_strided_add_dim(&row, counts, strides, &ndims, elem->count, elem->extent)) {
+            return;
+        }
+        for (i = depth; i-- > 0;) {
+            if (!opal_strided_add_dim(&row, counts, strides, &ndims, desc[i].loop.loops,
+                                      desc[i].loop.extent)) {
+                return;
+            }
+        }
+        if ((0 == row) || (row > UINT32_MAX)) {
+            return;
+        }
+        shape.disp = elem->disp;
+        shape.nseg = 1;
+        shape.seg[0].disp = 0;
+        shape.seg[0].len = (uint32_t) row;
+        group = row;
+        if (0 == ndims) {
+            shape.count = 1;
+            shape.stride = 0;
+            goto check_and_return;
+        }
+        /* the outermost dimension repeats the groups, the others are inside */
+        ndims--;
+        if (counts[ndims] > UINT32_MAX) {
+            return;
+        }
+        shape.count = (uint32_t) counts[ndims];
+        shape.stride = strides[ndims];
+        for (i = 0; i < ndims; i++) {
+            if ((counts[i] > UINT32_MAX) || (strides[i] < INT32_MIN) || (strides[i] > INT32_MAX)) {
+                return;
+            }
+            shape.seg[1 + i].disp = (int32_t) strides[i];
+            shape.seg[1 + i].len = (uint32_t) counts[i];
+            group *= counts[i];
+        }
+        shape.ndim = (uint16_t) ndims;
+        goto check_and_return;
+    }
+
+    if (1 < depth) {
+        return;
+    }
+    if (1 == depth) {
+        /* a loop around the whole description, with only data inside */
+        shape.count = desc[0].loop.loops;
+        shape.stride = desc[0].loop.extent;
+    } else {
+        /* a single group */
+        shape.count = 1;
+        shape.stride = 0;
+    }
+
+    if ((last - first) > OPAL_DATATYPE_STRIDED_SEGS) {
+        return;
+    }
+    for (i = first; i < last; i++) {
+        const ddt_elem_desc_t *elem = &desc[i].elem;
+        size_t len;
+        ptrdiff_t disp;
+
+        if (!(elem->common.flags & OPAL_DATATYPE_FLAG_DATA)) {
+            return;
+        }
+        len = elem->blocklen * opal_datatype_basicDatatypes[elem->common.type]->size;
+        if (1 != elem->count) {
+            if (elem->extent != (ptrdiff_t) len) {
+                return;
+            }
+            len *= elem->count;
+        }
+        if (first == i) {
+            shape.disp = elem->disp;
+        }
+        disp = elem->disp - shape.disp;
+        if ((0 == len) || (disp < INT32_MIN) || (disp > INT32_MAX) || (len > UINT32_MAX)) {
+            return;
+        }
+        shape.seg[shape.nseg].disp = (int32_t) disp;
+        shape.seg[shape.nseg].len = (uint32_t) len;
+        shape.nseg++;
+        group += len;
+    }
+
+check_and_return:
+    if ((0 == shape.count) || (0 == group) || ((shape.count * group) != pData->size)) {
+        return;
+    }
+    pData->strided = shape;
+}
+
+typedef void (*opal_strided_kernel_t)(unsigned char *dst, ptrdiff_t dst_stride,
+                                      const unsigned char *src, ptrdiff_t src_stride,
+                                      size_t count, size_t len);
+
+#define OPAL_STRIDED_KERNEL(LEN)                                                        \
+    static void opal_strided_kernel_##LEN(unsigned char *dst, ptrdiff_t dst_stride,     \
+                                          const unsigned char *src, ptrdiff_t src_stride, \
+                                          size_t count, size_t len)                     \
+    {                                                                                   \
+        (void) len;                                                                     \
+        for (size_t i = 0; i < count; i++) {                                            \
+            MEMCPY(dst, src, LEN);                                                      \
+            dst += dst_stride;                                                          \
+            src += src_stride;                                                          \
+        }                                                                               \
+    }
+
+OPAL_STRIDED_KERNEL(4)
+OPAL_STRIDED_KERNEL(8)
+OPAL_STRIDED_KERNEL(12)
+OPAL_STRIDED_KERNEL(16)
+OPAL_STRIDED_KERNEL(24)
+OPAL_STRIDED_KERNEL(32)
+OPAL_STRIDED_KERNEL(64)
+
+static void opal_strided_kernel_any(unsigned char *dst, ptrdiff_t dst_stride,
+                                    const unsigned char *src, ptrdiff_t src_stride, size_t count,
+                                    size_t len)
+{
+    opal_memcpy_strided(dst, dst_stride, src, src_stride, len, count);
+}
+
+static inline opal_strided_kernel_t opal_strided_kernel(size_t len)
+{
+    switch (len) {
+    case 4:
+        return opal_strided_kernel_4;
+    case 8:
+        return opal_strided_kernel_8;
+    case 12:
+        return opal_strided_kernel_12;
+    case 16:
+        return opal_strided_kernel_16;
+    case 24:
+        return opal_strided_kernel_24;
+    case 32:
+        return opal_strided_kernel_32;
+    case 64:
+        return opal_strided_kernel_64;
+    default:
+        return opal_strided_kernel_any;
+    }
+}
+
+/* Copy count full groups between the user memory and the packed buffer */
+static inline void opal_strided_copy_groups(const opal_datatype_strided_t *shape,
+                                            unsigned char *memory, unsigned char *packed,
+                                            size_t count, const bool pack)
+{
+    if (1 == shape->nseg) {
+        size_t len = shape->seg[0].len;
+        opal_strided_kernel_t kernel = opal_strided_kernel(len);
+
+        memory += shape->seg[0].disp;
+        if (pack) {
+            kernel(packed, len, memory, shape->stride, count, len);
+        } else {
+            kernel(memory, shape->stride, packed, len, count, len);
+        }
+        return;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        for (uint32_t seg = 0; seg < shape->nseg; seg++) {
+            if (pack) {
+                MEMCPY(packed, memory + shape->seg[seg].disp, shape->seg[seg].len);
+            } else {
+                MEMCPY(memory + shape->seg[seg].disp, packed, shape->seg[seg].len);
+            }
+            packed += shape->seg[seg].len;
+        }
+        memory += shape->stride;
+    }
+}
+
+/* N-D shapes: the rows, seg[0], are copied one line along the innermost
+ * dimension at a time, and the position in the other dimensions is kept
+ * in counters */
+static inline int32_t opal_strided_convert_nd(opal_convertor_t *pConv, struct iovec *iov,
+                                              uint32_t *out_size, size_t *max_data,
+                                              const bool pack)
+{
+    const opal_datatype_t *pData = pConv->pDesc;
+    const opal_datatype_strided_t *shape = &pData->strided;
+    const uint32_t ndim = shape->ndim;
+    ptrdiff_t extent = pData->ub - pData->lb;
+    size_t row = shape->seg[0].len, line = shape->seg[1].len;
+    size_t initial_bytes_converted = pConv->bConverted;
+    opal_strided_kernel_t kernel = opal_strided_kernel(row);
+    uint32_t idx, d;
+
+    for (idx = 0; (idx < (*out_size)) && (pConv->bConverted < pConv->local_size); idx++) {
+        unsigned char *packed = (unsigned char *) iov[idx].iov_base, *base, *memory;
+        size_t space = pConv->local_size - pConv->bConverted, count, rem, rows, grp, n;
+        size_t pos[OPAL_DATATYPE_STRIDED_SEGS - 1];
+
+        if (space > iov[idx].iov_len) {
+            space = iov[idx].iov_len;
+        }
+        iov[idx].iov_len = space;
+
+        /* where we are: instance of the datatype, group, position along each
+         * inner dimension, offset in the row */
+        count = pConv->bConverted / pData->size;
+        rem = pConv->bConverted - count * pData->size;
+        base = pConv->pBaseBuf + count * extent + shape->disp;
+        rows = rem / row;
+        rem -= rows * row;
+        for (d = 0; d < ndim; d++) {
+            pos[d] = rows % shape->seg[1 + d].len;
+            rows /= shape->seg[1 + d].len;
+        }
+        grp = rows;
+        pConv->bConverted += space;
+
+        while (0 != space) {
+            memory = base + (ptrdiff_t) grp * shape->stride;
+            for (d = 0; d < ndim; d++) {
+                memory += (ptrdiff_t) pos[d] * shape->seg[1 + d].disp;
+            }
+
+            if ((0 == rem) && (row <= space)) {
+                n = space / row;
+                if (n > (line - pos[0])) {
+                    n = line - pos[0];
+                }
+                if (pack) {
+                    kernel(packed, row, memory, shape->seg[1].disp, n, row);
+                } else {
+                    kernel(memory, shape->seg[1].disp, packed, row, n, row);
+                }
+                packed += n * row;
+                space -= n * row;
+                pos[0] += n;
+            } else {
+                /* a partial row */
+                n = row - rem;
+                if (n > space) {
+                    n = space;
+                }
+                if (pack) {
+                    MEMCPY(packed, memory + rem, n);
+                } else {
+                    MEMCPY(memory + rem, packed, n);
+                }
+                packed += n;
+                space -= n;
+                rem += n;
+                if (rem == row) {
+                    rem = 0;
+                    pos[0]++;
+                }
+            }
+
+            for (d = 0; (d < ndim) && (pos[d] == shape->seg[1 + d].len); d++) {
+                pos[d] = 0;
+                if ((d + 1) < ndim) {
+                    pos[d + 1]++;
+                } else {
+                    grp++;
+                }
+            }
+            if (grp == shape->count) {
+                grp = 0;
+                base += extent;
+            }
+        }
+    }
+
+    *out_size = idx;
+    *max_data = pConv->bConverted - initial_bytes_converted;
+    if (pConv->bConverted == pConv->local_size) {
+        pConv->flags |= CONVERTOR_COMPLETED;
+        return 1;
+    }
+    return 0;
+}
+
+static inline int32_t opal_strided_convert(opal_convertor_t *pConv, struct iovec *iov,
+                                           uint32_t *out_size, size_t *max_data, const bool pack)
+{
+    const opal_datatype_t *pData = pConv->pDesc;
+    const opal_datatype_strided_t *shape = &pData->strided;
+    ptrdiff_t extent = pData->ub - pData->lb;
+    size_t group = pData->size / shape->count;
+    size_t initial_bytes_converted = pConv->bConverted;
+    uint32_t idx;
+
+    if (0 != shape->ndim) {
+        return opal_strided_convert_nd(pConv, iov, out_size, max_data, pack);
+    }
+
+    for (idx = 0; (idx < (*out_size)) && (pConv->bConverted < pConv->local_size); idx++) {
+        unsigned char *packed = (unsigned char *) iov[idx].iov_base, *memory;
+        size_t space = pConv->local_size - pConv->bConverted, count, rem, grp, n;
+        uint32_t seg;
+
+        if (space > iov[idx].iov_len) {
+            space = iov[idx].iov_len;
+        }
+        iov[idx].iov_len = space;
+
+        /* where we are: instance of the datatype, group, offset in the group */
+        count = pConv->bConverted / pData->size;
+        rem = pConv->bConverted - count * pData->size;
+        grp = rem / group;
+        rem -= grp * group;
+        memory = pConv->pBaseBuf + count * extent + shape->disp;
+        pConv->bConverted += space;
+
+        while (0 != space) {
+            if ((0 == rem) && (group <= space)) {
+                count = space / group;
+                if (count > (shape->count - grp)) {
+                    count = shape->count - grp;
+                }
+                opal_strided_copy_groups(shape, memory + grp * shape->stride, packed, count, pack);
+                packed += count * group;
+                space -= count * group;
+                grp += count;
+            } else {
+                /* a partial group, one segment at a time */
+                unsigned char *group_memory = memory + grp * shape->stride;
+
+                for (seg = 0; rem >= shape->seg[seg].len; seg++) {
+                    rem -= shape->seg[seg].len;
+                }
+                for (; (seg < shape->nseg) && (0 != space); seg++, rem = 0) {
+                    n = shape->seg[seg].len - rem;
+                    if (n > space) {
+                        n = space;
+                    }
+                    if (pack) {
+                        MEMCPY(packed, group_memory + shape->seg[seg].disp + rem, n);
+                    } else {
+                        MEMCPY(group_memory + shape->seg[seg].disp + rem, packed, n);
+                    }
+                    packed += n;
+                    space -= n;
+                }
+                grp++; /* only matters if the group is complete, i.e. space is left */
+            }
+            if (grp == shape->count) {
+                grp = 0;
+                memory += extent;
+            }
+        }
+    }
+
+    *out_size = idx;
+    *max_data = pConv->bConverted - initial_bytes_converted;
+    if (pConv->bConverted == pConv->local_size) {
+        pConv->flags |= CONVERTOR_COMPLETED;
+        return 1;
+    }
+    return 0;
+}
+
+int32_t opal_pack_strided(opal_convertor_t *pConv, struct iovec *iov, uint32_t *out_size,
+                          size_t *max_data)
+{
+    return opal_strided_convert(pConv, iov, out_size, max_data, true);
+}
+
+int32_t opal_unpack_strided(opal_convertor_t *pConv, struct iovec *iov, uint32_t *out_size,
+                            size_t *max_data)
+{
+    return opal_strided_convert(pConv, iov, out_size, max_data, false);
+}
@@ -52,6 +52,7 @@
 #include "opal/mca/btl/base/btl_base_error.h"
 #include "opal/mca/btl/btl.h"
 #include "opal/mca/btl/sm/btl_sm_types.h"
+#include "opal/mca/memcpy/base/base.h"
 #include "opal/mca/mpool/base/base.h"
 #include "opal/mca/rcache/base/base.h"
 #include "opal/mca/rcache/base/rcache_base_vma.h"
@@ -80,12 +81,36 @@ OPAL_DECLSPEC extern mca_btl_sm_t mca_btl_sm;
 /* local rank in the group */
 #define MCA_BTL_SM_LOCAL_RANK opal_process_info.my_local_rank
 
+#if OPAL_HAVE_THREAD_LOCAL
+extern opal_thread_local int mca_btl_sm_my_lane;
+#endif
+
+/**
+ * Lane of the calling thread.
+ *
+ * Threads are assigned lanes round-robin the first time they use the btl. The
+ * lane is used for the fifos of the peers this thread sends to, and is the
+ * first lane the thread progresses.
+ */
+static inline int mca_btl_sm_lane_index(void)
+{
+#if OPAL_HAVE_THREAD_LOCAL
+    if (OPAL_UNLIKELY(-1 == mca_btl_sm_my_lane)) {
+        mca_btl_sm_my_lane = opal_atomic_fetch_add_32(&mca_btl_sm_component.next_lane, 1)
+                             % mca_btl_sm_component.num_lanes;
+    }
+    return mca_btl_sm_my_lane;
+#else
+    return 0;
+#endif
+}
+
 /* memcpy is faster at larger sizes but is undefined if the
    pointers are aliased (TODO -- readd alias check) */
 static inline void sm_memmove(void *dst, void *src, size_t size)
 {
     if (size >= (size_t) mca_btl_sm_component.memcpy_limit) {
-        memcpy(dst, src, size);
+        opal_memcpy(dst, src, size);
     } else {
         memmove(dst, src, size);
     }
@@ -157,6 +182,23 @@ mca_btl_base_descriptor_t *mca_btl_sm_alloc(struct mca_btl_base_module_t *btl,
  */
 int mca_btl_sm_free(struct mca_btl_base_module_t *btl, mca_btl_base_descriptor_t *des);
 
+/**
+ * Block the calling thread until a message may have arrived.
+ *
+ * @param timeout_us (IN)  Maximum time to block in microseconds, or -1
+ *
+ * Returns OPAL_ERR_NOT_SUPPORTED if idle waiting is not enabled
+ * (btl_sm_idle_wait) or not available on this system. Wake-ups may be
+ * spurious; the caller must progress and check for completion.
+ */
+int mca_btl_sm_doorbell_wait(int timeout_us);
+
+/**
+ * Wake up the threads of this process blocked in
+ * mca_btl_sm_doorbell_wait(), if any.
+ */
+void mca_btl_sm_doorbell_wake_self(void);
+
 static inline bool mca_btl_is_self_endpoint(mca_btl_base_endpoint_t *endpoint) {
     return endpoint->peer_smp_rank == MCA_BTL_SM_LOCAL_RANK;
 }
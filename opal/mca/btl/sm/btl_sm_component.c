@@ -52,6 +52,15 @@
 
 #include <fcntl.h>
 #include <sys/mman.h>
+#include <time.h>
+
+#if HAVE_LINUX_FUTEX_H && HAVE_SYS_SYSCALL_H
+#    include <linux/futex.h>
+#    include <sys/syscall.h>
+#    define MCA_BTL_SM_HAVE_FUTEX 1
+#else
+#    define MCA_BTL_SM_HAVE_FUTEX 0
+#endif
 
 #ifdef HAVE_SYS_PRCTL_H
 #    include <sys/prctl.h>
@@ -62,6 +71,10 @@
 #    define MAP_ANONYMOUS MAP_ANON
 #endif
 
+#if OPAL_HAVE_THREAD_LOCAL
+opal_thread_local int mca_btl_sm_my_lane = -1;
+#endif
+
 static int mca_btl_sm_component_progress(void);
 static int mca_btl_sm_component_open(void);
 static int mca_btl_sm_component_close(void);
@@ -190,6 +203,28 @@ static int mca_btl_sm_component_register(void)
                                            MCA_BASE_VAR_SCOPE_LOCAL,
                                            &mca_btl_sm_component.fbox_size);
 
+    mca_btl_sm_component.num_lanes = 1;
+    (void) mca_base_component_var_register(&mca_btl_sm_component.super.btl_version, "num_lanes",
+                                           "Number of receive lanes (fifos and sets of fast boxes) "
+                                           "per process. Threads send on and progress their own "
+                                           "lane, so more lanes let more threads progress "
+                                           "concurrently with MPI_THREAD_MULTIPLE (default: 1)",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0,
+                                           MCA_BASE_VAR_FLAG_SETTABLE, OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_LOCAL,
+                                           &mca_btl_sm_component.num_lanes);
+
+    mca_btl_sm_component.idle_wait = false;
+    (void) mca_base_component_var_register(&mca_btl_sm_component.super.btl_version, "idle_wait",
+                                           "Allow idle threads to block until a message arrives "
+                                           "instead of polling. Senders always check for "
+                                           "blocked receivers, so this may differ between "
+                                           "processes. Only available on Linux (default: false)",
+                                           MCA_BASE_VAR_TYPE_BOOL, NULL, 0,
+                                           MCA_BASE_VAR_FLAG_SETTABLE, OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_LOCAL,
+                                           &mca_btl_sm_component.idle_wait);
+
     if (0 == access("/dev/shm", W_OK)) {
         mca_btl_sm_component.backing_directory = "/dev/shm";
     } else {
@@ -257,6 +292,9 @@ static int mca_btl_sm_component_close(void)
     OBJ_DESTRUCT(&mca_btl_sm_component.pending_endpoints);
     OBJ_DESTRUCT(&mca_btl_sm_component.pending_fragments);
 
+    free(mca_btl_sm_component.lanes);
+    mca_btl_sm_component.lanes = NULL;
+
     mca_btl_sm_component.my_segment = NULL;
 
     if (mca_btl_sm_component.mpool) {
@@ -274,6 +312,8 @@ static int mca_btl_base_sm_modex_send(void)
 
     modex_size = sizeof(modex) - sizeof(modex.seg_ds);
 
+    modex.num_lanes = mca_btl_sm_component.num_lanes;
+
         modex.seg_ds_size = opal_shmem_sizeof_shmem_ds(&mca_btl_sm_component.seg_ds);
         memmove(&modex.seg_ds, &mca_btl_sm_component.seg_ds, modex.seg_ds_size);
         modex_size += modex.seg_ds_size;
@@ -335,8 +375,36 @@ mca_btl_sm_component_init(int *num_btls, bool enable_progress_threads, bool enab
         component->segment_size = 2ul << MCA_BTL_SM_OFFSET_BITS;
     }
 
+    if (component->num_lanes < 1) {
+        component->num_lanes = 1;
+    } else if (component->num_lanes > MCA_BTL_SM_MAX_LANES) {
+        component->num_lanes = MCA_BTL_SM_MAX_LANES;
+    }
+
+    if (!enable_mpi_threads && component->num_lanes > 1) {
+        BTL_VERBOSE(("multiple lanes are only useful with threads. using a single lane."));
+        component->num_lanes = 1;
+    }
+
     /* no fast boxes allocated initially */
-    component->num_fbox_in_endpoints = 0;
+    component->lanes = (mca_btl_sm_lane_t *) calloc(component->num_lanes,
+                                                    sizeof(mca_btl_sm_lane_t));
+    if (NULL == component->lanes) {
+        free(btls);
+        return NULL;
+    }
+    component->next_lane = 0;
+
+    /* one doorbell bit per local process */
+    component->doorbell_words = (MCA_BTL_SM_NUM_LOCAL_PEERS + 1 + 63) / 64;
+    component->doorbell_size = sizeof(mca_btl_sm_doorbell_t)
+                               + component->doorbell_words * sizeof(int64_t);
+    component->doorbell_size = (component->doorbell_size + MCA_BTL_SM_FIFO_SIZE - 1)
+                               & ~((size_t) MCA_BTL_SM_FIFO_SIZE - 1);
+
+#if !MCA_BTL_SM_HAVE_FUTEX
+    component->idle_wait = false;
+#endif
 
     bool have_smsc = (NULL != mca_smsc);
     if (have_smsc) {
@@ -402,8 +470,8 @@ mca_btl_sm_component_init(int *num_btls, bool enable_progress_threads, bool enab
         goto failed;
     }
 
-    /* initialize my fifo */
-    sm_fifo_init((struct sm_fifo_t *) component->my_segment);
+    /* initialize my fifos */
+    sm_fifo_init((struct sm_fifo_t *) component->my_segment, component->num_lanes);
 
     rc = mca_btl_base_sm_modex_send();
     if (OPAL_SUCCESS != rc) {
@@ -430,6 +498,29 @@ failed:
     return NULL;
 }
 
+/**
+ * Start polling the fast box of an endpoint
+ *
+ * @param ep (IN)       Sm BTL endpoint
+ *
+ * The fast boxes are distributed over the lanes by peer. The fragment that
+ * sets up the fast box may arrive on any lane, so the lane the fast box
+ * belongs to may be progressed by another thread at the same time.
+ * Fast boxes that ring the doorbell before they are set up are retried.
+ */
+static void mca_btl_sm_lane_add_fbox_in(struct mca_btl_base_endpoint_t *ep)
+{
+    mca_btl_sm_lane_t *lane = mca_btl_sm_component.lanes
+                              + ep->peer_smp_rank % mca_btl_sm_component.num_lanes;
+
+    /* the fast box is found through the doorbell. make sure it is set up
+     * before the lane looks at it */
+    opal_atomic_wmb();
+    OPAL_THREAD_LOCK(&mca_btl_sm_component.lock);
+    ++lane->num_fbox_in_endpoints;
+    OPAL_THREAD_UNLOCK(&mca_btl_sm_component.lock);
+}
+
 void mca_btl_sm_poll_handle_frag(mca_btl_sm_hdr_t *hdr, struct mca_btl_base_endpoint_t *endpoint)
 {
     if (hdr->flags & MCA_BTL_SM_FLAG_COMPLETE) {
@@ -464,22 +555,21 @@ void mca_btl_sm_poll_handle_frag(mca_btl_sm_hdr_t *hdr, struct mca_btl_base_endp
 
     if (OPAL_UNLIKELY(MCA_BTL_SM_FLAG_SETUP_FBOX & hdr->flags)) {
         mca_btl_sm_endpoint_setup_fbox_recv(endpoint, relative2virtual(hdr->fbox_base));
-        mca_btl_sm_component.fbox_in_endpoints[mca_btl_sm_component.num_fbox_in_endpoints++]
-            = endpoint;
+        mca_btl_sm_lane_add_fbox_in(endpoint);
     }
 
     hdr->flags = MCA_BTL_SM_FLAG_COMPLETE;
     sm_fifo_write_back(hdr, endpoint);
 }
 
-static int mca_btl_sm_poll_fifo(void)
+static int mca_btl_sm_poll_fifo(sm_fifo_t *fifo)
 {
     struct mca_btl_base_endpoint_t *endpoint;
     mca_btl_sm_hdr_t *hdr;
 
     /* poll the fifo until it is empty or a limit has been hit (8 is arbitrary) */
     for (int fifo_count = 0; fifo_count < 31; ++fifo_count) {
-        hdr = sm_fifo_read(mca_btl_sm_component.my_fifo, &endpoint);
+        hdr = sm_fifo_read(fifo, &endpoint);
         if (NULL == hdr) {
             return fifo_count;
         }
@@ -547,32 +637,141 @@ static void mca_btl_sm_progress_endpoints(void)
     OPAL_THREAD_UNLOCK(&mca_btl_sm_component.lock);
 }
 
-static int mca_btl_sm_component_progress(void)
+/**
+ * Progress a receive lane
+ *
+ * @param lane (IN)     Receive lane
+ *
+ * Only one thread at a time progresses a lane. Other threads skip it.
+ */
+static int mca_btl_sm_progress_lane(mca_btl_sm_lane_t *lane)
 {
-    static opal_atomic_int32_t lock = 0;
     int count = 0;
 
     if (opal_using_threads()) {
-        if (opal_atomic_swap_32(&lock, 1)) {
+        if (opal_atomic_swap_32(&lane->lock, 1)) {
             return 0;
         }
     }
 
     /* check for messages in fast boxes */
-    if (mca_btl_sm_component.num_fbox_in_endpoints) {
-        count = mca_btl_sm_check_fboxes();
+    if (lane->num_fbox_in_endpoints) {
+        count = mca_btl_sm_check_fboxes(lane);
     }
 
     mca_btl_sm_progress_endpoints();
 
-    if (SM_FIFO_FREE == mca_btl_sm_component.my_fifo->fifo_head) {
-        lock = 0;
+    if (SM_FIFO_FREE == lane->fifo->fifo_head) {
+        lane->lock = 0;
         return count;
     }
 
-    count += mca_btl_sm_poll_fifo();
+    count += mca_btl_sm_poll_fifo(lane->fifo);
     opal_atomic_mb();
-    lock = 0;
+    lane->lock = 0;
 
     return count;
 }
+
+static int mca_btl_sm_component_progress(void)
+{
+    const int num_lanes = mca_btl_sm_component.num_lanes;
+    int count, my_lane;
+
+    if (1 == num_lanes) {
+        return mca_btl_sm_progress_lane(mca_btl_sm_component.lanes);
+    }
+
+    /* start with this thread's lane, which receives the completions of
+     * its sends, then help with the lanes no other thread is progressing */
+    my_lane = mca_btl_sm_lane_index();
+    count = mca_btl_sm_progress_lane(mca_btl_sm_component.lanes + my_lane);
+    for (int i = 1; i < num_lanes; ++i) {
+        count += mca_btl_sm_progress_lane(mca_btl_sm_component.lanes
+                                          + (my_lane + i) % num_lanes);
+    }
+
+    return count;
+}
+
+#if MCA_BTL_SM_HAVE_FUTEX
+static inline long mca_btl_sm_futex(opal_atomic_int32_t *addr, int op, int32_t val,
+                                    const struct timespec *timeout)
+{
+    /* the segment is shared between processes so this can't be a private futex */
+    return syscall(SYS_futex, addr, op, val, timeout, NULL, 0);
+}
+#endif
+
+void mca_btl_sm_doorbell_wake_slow(mca_btl_sm_doorbell_t *wake)
+{
+#if MCA_BTL_SM_HAVE_FUTEX
+    (void) opal_atomic_add_fetch_32(&wake->seq, 1);
+    (void) mca_btl_sm_futex(&wake->seq, FUTEX_WAKE, INT_MAX, NULL);
+#endif
+}
+
+/* check for anything to receive without receiving it */
+static bool mca_btl_sm_have_pending(void)
+{
+    for (int i = 0; i < mca_btl_sm_component.num_lanes; ++i) {
+        mca_btl_sm_lane_t *lane = mca_btl_sm_component.lanes + i;
+
+        if (SM_FIFO_FREE != lane->fifo->fifo_head) {
+            return true;
+        }
+
+        for (int j = 0; j < mca_btl_sm_component.doorbell_words; ++j) {
+            if (0 != lane->doorbell->bits[j]) {
+                return true;
+            }
+        }
+    }
+
+    return 0 != opal_list_get_size(&mca_btl_sm_component.pending_endpoints);
+}
+
+int mca_btl_sm_doorbell_wait(int timeout_us)
+{
+#if MCA_BTL_SM_HAVE_FUTEX
+    mca_btl_sm_doorbell_t *wake;
+    struct timespec ts, *tsp = NULL;
+    int32_t seq;
+
+    if (!mca_btl_sm_component.idle_wait || NULL == mca_btl_sm_component.lanes) {
+        return OPAL_ERR_NOT_SUPPORTED;
+    }
+
+    wake = mca_btl_sm_component.lanes[0].doorbell;
+    seq = wake->seq;
+
+    /* announce the sleeper before looking for messages. a sender either
+     * sees it, or its message is seen here. pairs with the barrier in
+     * mca_btl_sm_doorbell_wake() */
+    (void) opal_atomic_add_fetch_32(&wake->sleepers, 1);
+    opal_atomic_mb();
+
+    if (!mca_btl_sm_have_pending()) {
+        if (0 <= timeout_us) {
+            ts.tv_sec = timeout_us / 1000000;
+            ts.tv_nsec = (long) (timeout_us % 1000000) * 1000;
+            tsp = &ts;
+        }
+        /* returns right away if a sender bumped seq in the meantime */
+        (void) mca_btl_sm_futex(&wake->seq, FUTEX_WAIT, seq, tsp);
+    }
+
+    (void) opal_atomic_add_fetch_32(&wake->sleepers, -1);
+
+    return OPAL_SUCCESS;
+#else
+    return OPAL_ERR_NOT_SUPPORTED;
+#endif
+}
+
+void mca_btl_sm_doorbell_wake_self(void)
+{
+    if (NULL != mca_btl_sm_component.lanes) {
+        mca_btl_sm_doorbell_wake(mca_btl_sm_component.lanes[0].doorbell);
+    }
+}
@@ -17,6 +17,7 @@
 
 #include "opal/mca/btl/sm/btl_sm_types.h"
 #include "opal/mca/btl/sm/btl_sm_virtual.h"
+#include "opal/util/bit_ops.h"
 #include "opal/util/minmax.h"
 
 #define MCA_BTL_SM_POLL_COUNT          31
@@ -99,6 +100,44 @@ static inline unsigned int mca_btl_sm_fbox_out_free(mca_btl_sm_fbox_out_t *fbox_
 }
 
 void mca_btl_sm_poll_handle_frag(mca_btl_sm_hdr_t *hdr, mca_btl_base_endpoint_t *endpoint);
+void mca_btl_sm_doorbell_wake_slow(mca_btl_sm_doorbell_t *wake);
+
+/**
+ * Wake up the threads of a peer blocked waiting for messages, if any.
+ * Whether a peer may block (btl_sm_idle_wait) is its own setting, so the
+ * sleepers count of the peer is checked whatever the local one is.
+ */
+static inline void mca_btl_sm_doorbell_wake(mca_btl_sm_doorbell_t *wake)
+{
+    /* the message must be visible before sleepers is read. pairs with the
+     * barrier in mca_btl_sm_doorbell_wait() */
+    opal_atomic_mb();
+    if (OPAL_UNLIKELY(0 != wake->sleepers)) {
+        mca_btl_sm_doorbell_wake_slow(wake);
+    }
+}
+
+/**
+ * Let the peer know there is data in our fast box.
+ */
+static inline void mca_btl_sm_doorbell_ring(mca_btl_base_endpoint_t *ep)
+{
+    const int bit = MCA_BTL_SM_LOCAL_RANK;
+    opal_atomic_int64_t *word = ep->doorbell->bits + (bit >> 6);
+    const int64_t mask = (int64_t) (1ull << (bit & 63));
+
+    /* the bit is often still set from an earlier message. avoid writing to
+     * the shared cache line in that case. the fast box header must be
+     * visible before the bit is read: if the receiver clears the bit after
+     * this read it then finds the header. a write barrier does not order
+     * the load, so this takes a full one */
+    opal_atomic_mb();
+    if (!(*word & mask)) {
+        (void) opal_atomic_fetch_or_64(word, mask);
+    }
+
+    mca_btl_sm_doorbell_wake(ep->wake);
+}
 
 static inline void mca_btl_sm_fbox_set_header(mca_btl_sm_fbox_hdr_t *hdr, uint16_t tag,
                                               uint16_t seq, uint32_t size)
@@ -235,6 +274,8 @@ static inline bool mca_btl_sm_fbox_sendi(mca_btl_base_endpoint_t *ep, unsigned c
     mca_btl_sm_fbox_set_header(MCA_BTL_SM_FBOX_HDR(dst), tag, ep->fbox_out.seq++,
                                (uint32_t) data_size);
 
+    mca_btl_sm_doorbell_ring(ep);
+
     return true;
 }
 
@@ -292,28 +333,57 @@ static inline bool mca_btl_sm_poll_fbox(mca_btl_base_endpoint_t *ep)
     return true;
 }
 
-static inline int mca_btl_sm_check_fboxes(void)
+static inline int mca_btl_sm_check_fboxes(mca_btl_sm_lane_t *lane)
 {
+    mca_btl_sm_doorbell_t *doorbell = lane->doorbell;
     int total_processed = 0;
 
-    for (unsigned int i = 0; i < mca_btl_sm_component.num_fbox_in_endpoints; ++i) {
-        mca_btl_base_endpoint_t *ep = mca_btl_sm_component.fbox_in_endpoints[i];
+    for (int i = 0; i < mca_btl_sm_component.doorbell_words; ++i) {
+        uint64_t ready;
 
-        int frag_count = 0;
-        for (int j = 0 ; j < MCA_BTL_SM_POLL_COUNT ; ++j) {
-            if (!mca_btl_sm_poll_fbox(ep)) {
-                break;
-            }
-            ++frag_count;
+        if (0 == doorbell->bits[i]) {
+            continue;
         }
 
-        if (frag_count) {
-            BTL_VERBOSE(("finished processing at offset %x", ep->fbox_in.start));
+        /* clear the bits before polling. a sender ringing after this point
+         * is picked up on the next call */
+        ready = (uint64_t) opal_atomic_swap_64(doorbell->bits + i, 0);
+
+        while (ready) {
+            const int bit = opal_lobit64(ready);
+            mca_btl_base_endpoint_t *ep = mca_btl_sm_component.endpoints + (i << 6) + bit;
+            int frag_count = 0;
+
+            ready &= ready - 1;
+
+            if (OPAL_UNLIKELY(NULL == ep->fbox_in.buffer)) {
+                /* the fragment setting up this fast box has not been processed yet */
+                (void) opal_atomic_fetch_or_64(doorbell->bits + i, (int64_t) (1ull << bit));
+                continue;
+            }
+
+            opal_atomic_rmb();
 
-            /* let the sender know where we stopped */
-            opal_atomic_mb();
-            ep->fbox_in.metadata->start = ep->fbox_in.start;
-            total_processed += frag_count;
+            for (int j = 0 ; j < MCA_BTL_SM_POLL_COUNT ; ++j) {
+                if (!mca_btl_sm_poll_fbox(ep)) {
+                    break;
+                }
+                ++frag_count;
+            }
+
+            if (MCA_BTL_SM_POLL_COUNT == frag_count) {
+                /* there may be more, come back next time */
+                (void) opal_atomic_fetch_or_64(doorbell->bits + i, (int64_t) (1ull << bit));
+            }
+
+            if (frag_count) {
+                BTL_VERBOSE(("finished processing at offset %x", ep->fbox_in.start));
+
+                /* let the sender know where we stopped */
+                opal_atomic_mb();
+                ep->fbox_in.metadata->start = ep->fbox_in.start;
+                total_processed += frag_count;
+            }
         }
     }
 
@@ -56,6 +56,48 @@
 /* large enough to ensure the fifo is on its own cache line */
 #define MCA_BTL_SM_FIFO_SIZE 128
 
+/* upper limit on the number of receive lanes (the lane is stored in a uint8_t) */
+#define MCA_BTL_SM_MAX_LANES 64
+
+/**
+ * sm_fifo_lane:
+ *
+ * @brief returns the fifo of a lane
+ *
+ * @param[in]   fifo - first fifo of the process (lane 0)
+ * @param[in]   lane - lane index
+ *
+ * The fifos of all the lanes are at the start of the segment, one per
+ * MCA_BTL_SM_FIFO_SIZE bytes.
+ */
+static inline sm_fifo_t *sm_fifo_lane(sm_fifo_t *fifo, int lane)
+{
+    return (sm_fifo_t *) ((char *) fifo + lane * MCA_BTL_SM_FIFO_SIZE);
+}
+
+/**
+ * sm_doorbell_lane:
+ *
+ * @brief returns the doorbell of a lane
+ *
+ * @param[in]   segment_base - start of the segment
+ * @param[in]   num_lanes    - number of lanes of the segment's owner
+ * @param[in]   lane         - lane index
+ *
+ * The doorbells follow the fifos.
+ */
+static inline mca_btl_sm_doorbell_t *sm_doorbell_lane(char *segment_base, int num_lanes, int lane)
+{
+    return (mca_btl_sm_doorbell_t *) (segment_base + (size_t) num_lanes * MCA_BTL_SM_FIFO_SIZE
+                                      + (size_t) lane * mca_btl_sm_component.doorbell_size);
+}
+
+/* size of the fifos and doorbells at the start of the segment */
+static inline size_t sm_segment_header_size(int num_lanes)
+{
+    return (size_t) num_lanes * (MCA_BTL_SM_FIFO_SIZE + mca_btl_sm_component.doorbell_size);
+}
+
 /**
  * sm_fifo_read:
  *
@@ -106,14 +148,22 @@ static inline mca_btl_sm_hdr_t *sm_fifo_read(sm_fifo_t *fifo, struct mca_btl_bas
     return hdr;
 }
 
-static inline void sm_fifo_init(sm_fifo_t *fifo)
+static inline void sm_fifo_init(sm_fifo_t *fifo, int num_lanes)
 {
-    /* due to a compiler bug in Oracle C 5.15 the following line was broken into two. Not
-     * ideal but oh well. See #5814 */
-    /* fifo->fifo_head = fifo->fifo_tail = SM_FIFO_FREE; */
-    fifo->fifo_head = SM_FIFO_FREE;
-    fifo->fifo_tail = SM_FIFO_FREE;
-    fifo->fbox_available = mca_btl_sm_component.fbox_max;
+    for (int i = 0; i < num_lanes; ++i) {
+        sm_fifo_t *lane_fifo = sm_fifo_lane(fifo, i);
+        /* due to a compiler bug in Oracle C 5.15 the following line was broken into two. Not
+         * ideal but oh well. See #5814 */
+        /* fifo->fifo_head = fifo->fifo_tail = SM_FIFO_FREE; */
+        lane_fifo->fifo_head = SM_FIFO_FREE;
+        lane_fifo->fifo_tail = SM_FIFO_FREE;
+        /* fast boxes are accounted for in the first fifo */
+        lane_fifo->fbox_available = (0 == i) ? mca_btl_sm_component.fbox_max : 0;
+        mca_btl_sm_component.lanes[i].fifo = lane_fifo;
+
+        mca_btl_sm_component.lanes[i].doorbell = sm_doorbell_lane((char *) fifo, num_lanes, i);
+        memset(mca_btl_sm_component.lanes[i].doorbell, 0, mca_btl_sm_component.doorbell_size);
+    }
     mca_btl_sm_component.my_fifo = fifo;
 }
 
@@ -146,11 +196,17 @@ static inline void sm_fifo_write(sm_fifo_t *fifo, fifo_value_t value)
  * @param[in]  ep  - endpoint to write the fragment to
  *
  * This function is used to send a fragment to a remote peer. {hdr} must belong
- * to the current process.
+ * to the current process. Without a fast box the fragment goes to the peer's
+ * lane of the calling thread.
  */
 static inline bool sm_fifo_write_ep(mca_btl_sm_hdr_t *hdr, struct mca_btl_base_endpoint_t *ep)
 {
     fifo_value_t rhdr = virtual2relative((char *) hdr);
+    int lane = mca_btl_sm_lane_index();
+
+    /* completions come back to the lane of the sending thread */
+    hdr->lane = (uint8_t) lane;
+
     if (ep->fbox_out.buffer) {
         /* if there is a fast box for this peer then use the fast box to send the fragment header.
          * this is done to ensure fragment ordering */
@@ -159,7 +215,8 @@ static inline bool sm_fifo_write_ep(mca_btl_sm_hdr_t *hdr, struct mca_btl_base_e
     }
     mca_btl_sm_try_fbox_setup(ep, hdr);
     hdr->next = SM_FIFO_FREE;
-    sm_fifo_write(ep->fifo, rhdr);
+    sm_fifo_write(sm_fifo_lane(ep->fifo, lane % ep->num_lanes), rhdr);
+    mca_btl_sm_doorbell_wake(ep->wake);
 
     return true;
 }
@@ -173,12 +230,14 @@ static inline bool sm_fifo_write_ep(mca_btl_sm_hdr_t *hdr, struct mca_btl_base_e
  * @param[in]  ep  - endpoint the fragment belongs to
  *
  * This function is used to return a fragment to the sending process. It differs from
- * sm_fifo_write_ep in that it uses the {ep} to produce the relative address.
+ * sm_fifo_write_ep in that it uses the {ep} to produce the relative address, and
+ * in that the fragment goes back to the lane it was sent from.
  */
 static inline void sm_fifo_write_back(mca_btl_sm_hdr_t *hdr, struct mca_btl_base_endpoint_t *ep)
 {
     hdr->next = SM_FIFO_FREE;
-    sm_fifo_write(ep->fifo, virtual2relativepeer(ep, (char *) hdr));
+    sm_fifo_write(sm_fifo_lane(ep->fifo, hdr->lane), virtual2relativepeer(ep, (char *) hdr));
+    mca_btl_sm_doorbell_wake(ep->wake);
 }
 
 #endif /* MCA_BTL_SM_FIFO_H */
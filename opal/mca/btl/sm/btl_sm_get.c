@@ -43,7 +43,7 @@ int mca_btl_sm_get(mca_btl_base_module_t *btl, mca_btl_base_endpoint_t *endpoint
             return ret;
         }
     } else {
-        memcpy(local_address, (void *)(uintptr_t) remote_address, size);
+        opal_memcpy(local_address, (void *)(uintptr_t) remote_address, size);
     }
 
     /* always call the callback function */
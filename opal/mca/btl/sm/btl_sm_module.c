@@ -65,6 +65,7 @@ mca_btl_sm_t mca_btl_sm = {
 static int sm_btl_first_time_init(mca_btl_sm_t *sm_btl, int n)
 {
     mca_btl_sm_component_t *component = &mca_btl_sm_component;
+    size_t header_size;
     int rc;
 
     /* generate the endpoints */
@@ -75,16 +76,15 @@ static int sm_btl_first_time_init(mca_btl_sm_t *sm_btl, int n)
     }
     component->endpoints[n].peer_smp_rank = -1;
 
-    component->fbox_in_endpoints = calloc(n + 1, sizeof(void *));
-    if (NULL == component->fbox_in_endpoints) {
-        free(component->endpoints);
-        return OPAL_ERR_OUT_OF_RESOURCE;
+    for (int i = 0; i < component->num_lanes; ++i) {
+        component->lanes[i].num_fbox_in_endpoints = 0;
     }
 
-    component->mpool = mca_mpool_basic_create((void *) (component->my_segment
-                                                        + MCA_BTL_SM_FIFO_SIZE),
+    /* the fifos and doorbells of all lanes are at the start of the segment */
+    header_size = sm_segment_header_size(component->num_lanes);
+    component->mpool = mca_mpool_basic_create((void *) (component->my_segment + header_size),
                                               (unsigned long) (mca_btl_sm_component.segment_size
-                                                               - MCA_BTL_SM_FIFO_SIZE),
+                                                               - header_size),
                                               64);
     if (NULL == component->mpool) {
         free(component->endpoints);
@@ -140,6 +140,12 @@ static int sm_btl_first_time_init(mca_btl_sm_t *sm_btl, int n)
         }
     }
 
+    /* let idle threads block on the doorbell */
+    if (component->idle_wait) {
+        (void) opal_progress_register_blocker(mca_btl_sm_doorbell_wait,
+                                              mca_btl_sm_doorbell_wake_self);
+    }
+
     /* set flag indicating btl has been inited */
     sm_btl->btl_inited = true;
 
@@ -201,13 +207,20 @@ static int init_sm_endpoint(struct mca_btl_base_endpoint_t **ep_out, struct opal
 
         OBJ_CONSTRUCT(&ep->lock, opal_mutex_t);
 
+        ep->num_lanes = modex->num_lanes;
+
         free(modex);
     } else {
         /* set up the segment base so we can calculate a virtual to real for local pointers */
         ep->segment_base = component->my_segment;
+        ep->num_lanes = component->num_lanes;
     }
 
     ep->fifo = (struct sm_fifo_t *) ep->segment_base;
+    /* fast box messages from this process go to one lane of the peer */
+    ep->doorbell = sm_doorbell_lane(ep->segment_base, ep->num_lanes,
+                                    MCA_BTL_SM_LOCAL_RANK % ep->num_lanes);
+    ep->wake = sm_doorbell_lane(ep->segment_base, ep->num_lanes, 0);
 
     return OPAL_SUCCESS;
 }
@@ -335,6 +348,10 @@ static int sm_finalize(struct mca_btl_base_module_t *btl)
         return OPAL_SUCCESS;
     }
 
+    if (component->idle_wait) {
+        (void) opal_progress_unregister_blocker(mca_btl_sm_doorbell_wait);
+    }
+
     for (int i = 0; i < (int) (1 + MCA_BTL_SM_NUM_LOCAL_PEERS); ++i) {
         fini_sm_endpoint(component->endpoints + i);
     }
@@ -344,8 +361,9 @@ static int sm_finalize(struct mca_btl_base_module_t *btl)
 
     sm_btl->btl_inited = false;
 
-    free(component->fbox_in_endpoints);
-    component->fbox_in_endpoints = NULL;
+    for (int i = 0; i < component->num_lanes; ++i) {
+        component->lanes[i].num_fbox_in_endpoints = 0;
+    }
 
     opal_shmem_unlink(&mca_btl_sm_component.seg_ds);
     opal_shmem_segment_detach(&mca_btl_sm_component.seg_ds);
@@ -491,8 +509,8 @@ static struct mca_btl_base_descriptor_t *sm_prepare_src(struct mca_btl_base_modu
             frag->base.des_segment_count = 2;
         } else {
             /* NTH: the covertor adds some latency so we bypass it here */
-            memcpy((void *) ((uintptr_t) frag->segments[0].seg_addr.pval + reserve), data_ptr,
-                   *size);
+            opal_memcpy((void *) ((uintptr_t) frag->segments[0].seg_addr.pval + reserve), data_ptr,
+                        *size);
             frag->segments[0].seg_len = total_size;
         }
     }
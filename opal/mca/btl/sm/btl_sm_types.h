@@ -42,6 +42,7 @@
  */
 struct mca_btl_sm_modex_t {
     uint64_t segment_base;
+    int num_lanes;
     int seg_ds_size;
     /* seg_ds needs to be the last element */
     opal_shmem_ds_t seg_ds;
@@ -82,7 +83,10 @@ typedef struct mca_btl_base_endpoint_t {
     char *segment_base;            /**< start of the peer's segment (in the address space
                                     *   of this process) */
 
-    struct sm_fifo_t *fifo; /**< */
+    struct sm_fifo_t *fifo; /**< first receive fifo (lane 0) of the peer */
+    int num_lanes;          /**< number of receive fifos of the peer */
+    struct mca_btl_sm_doorbell_t *doorbell; /**< doorbell rung after writing to the fast box */
+    struct mca_btl_sm_doorbell_t *wake;     /**< doorbell with the peer's wake-up words */
 
     opal_mutex_t lock; /**< lock to protect endpoint structures from concurrent
                         *   access */
@@ -100,6 +104,35 @@ typedef mca_btl_base_endpoint_t mca_btl_sm_endpoint_t;
 
 OBJ_CLASS_DECLARATION(mca_btl_sm_endpoint_t);
 
+/**
+ * Doorbell of a receive lane, in the shared memory segment of the receiver.
+ * Senders set their bit after writing to their fast box so the receiver only
+ * polls the fast boxes that have data. The wake-up words are only used in
+ * the doorbell of the first lane.
+ */
+struct mca_btl_sm_doorbell_t {
+    opal_atomic_int32_t seq;      /**< futex word, bumped to wake up blocked receivers */
+    opal_atomic_int32_t sleepers; /**< number of threads blocked on seq */
+    uint8_t padding[56];
+    opal_atomic_int64_t bits[];   /**< one bit per local sender */
+};
+typedef struct mca_btl_sm_doorbell_t mca_btl_sm_doorbell_t;
+
+/**
+ * Receive lane. Each lane has its own fifo in the shared memory segment and
+ * polls its own set of fast boxes, so that threads can progress different
+ * lanes at the same time.
+ */
+struct mca_btl_sm_lane_t {
+    opal_atomic_int32_t lock;                     /**< held while the lane is progressed */
+    unsigned int num_fbox_in_endpoints;           /**< number of fast boxes of this lane */
+    struct sm_fifo_t *fifo;                       /**< this lane's fifo */
+    mca_btl_sm_doorbell_t *doorbell;              /**< this lane's doorbell */
+    /* keep the lanes on separate cache lines */
+    uint8_t padding[64 - 2 * sizeof(int32_t) - 2 * sizeof(void *)];
+};
+typedef struct mca_btl_sm_lane_t mca_btl_sm_lane_t;
+
 /**
  * Shared Memory (SM) BTL module.
  */
@@ -131,9 +164,14 @@ struct mca_btl_sm_component_t {
 
     mca_btl_base_endpoint_t
         *endpoints; /**< array of local endpoints (one for each local peer including myself) */
-    mca_btl_base_endpoint_t **fbox_in_endpoints; /**< array of fast box in endpoints */
-    unsigned int num_fbox_in_endpoints;          /**< number of fast boxes to poll */
-    struct sm_fifo_t *my_fifo;                   /**< pointer to the local fifo */
+    struct sm_fifo_t *my_fifo;                   /**< pointer to the local fifo (lane 0) */
+
+    int num_lanes;                  /**< number of receive lanes of this process */
+    mca_btl_sm_lane_t *lanes;       /**< receive lanes */
+    opal_atomic_int32_t next_lane;  /**< next lane to hand out to a thread */
+    int doorbell_words;             /**< number of 64-bit words in each doorbell */
+    size_t doorbell_size;           /**< size of the doorbell of each lane */
+    bool idle_wait;                 /**< idle threads may block in the doorbell */
 
     opal_list_t pending_endpoints; /**< list of endpoints with pending fragments */
     opal_list_t pending_fragments; /**< fragments pending remote completion */
@@ -193,6 +231,8 @@ struct mca_btl_sm_hdr_t {
     mca_btl_base_tag_t tag;
     /** sm send flags (inline, complete, setup fbox, etc) */
     uint8_t flags;
+    /** lane of the sending process the fragment is returned to */
+    uint8_t lane;
     /** length of data following this header */
     int32_t len;
     /** io vector containing pointer to single-copy data */
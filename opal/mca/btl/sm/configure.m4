@@ -22,6 +22,9 @@
 AC_DEFUN([MCA_opal_btl_sm_CONFIG],[
     AC_CONFIG_FILES([opal/mca/btl/sm/Makefile])
 
+    # futexes let idle receivers block until a message arrives
+    AC_CHECK_HEADERS([linux/futex.h sys/syscall.h])
+
     # always happy
     $1
 
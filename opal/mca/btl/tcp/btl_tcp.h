@@ -133,6 +133,7 @@ struct mca_btl_tcp_component_t {
     opal_free_list_t tcp_frag_user;
 
     int tcp_enable_progress_thread; /** Support for tcp progress thread flag */
+    opal_atomic_int32_t tcp_blocker_registered; /**< idle threads may block on the event loop */
 
     opal_event_t tcp_recv_thread_async_event;
     opal_mutex_t tcp_frag_eager_mutex;
@@ -198,6 +199,12 @@ extern mca_btl_base_module_t **mca_btl_tcp_component_init(int *num_btl_modules,
                                                           bool allow_multi_user_threads,
                                                           bool have_hidden_threads);
 
+/**
+ * Let idle threads block on the event loop of opal_progress(), once a
+ * connection carries traffic. Does nothing with a progress thread.
+ */
+extern void mca_btl_tcp_component_register_blocker(void);
+
 /**
  * Cleanup any resources held by the BTL.
  *
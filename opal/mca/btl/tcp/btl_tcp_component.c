@@ -363,6 +363,7 @@ static int mca_btl_tcp_component_open(void)
     mca_btl_tcp_component.tcp_num_btls = 0;
     mca_btl_tcp_component.tcp_addr_count = 0;
     mca_btl_tcp_component.tcp_btls = NULL;
+    mca_btl_tcp_component.tcp_blocker_registered = 0;
 
     /* initialize objects */
     OBJ_CONSTRUCT(&mca_btl_tcp_component.local_ifs, opal_list_t);
@@ -405,6 +406,10 @@ static int mca_btl_tcp_component_close(void)
 {
     mca_btl_tcp_event_t *event, *next;
 
+    if (mca_btl_tcp_component.tcp_blocker_registered) {
+        (void) opal_progress_unregister_blocker(opal_progress_event_block);
+    }
+
     /**
      * If we have a progress thread we should shut it down before
      * moving forward with the TCP tearing down process.
@@ -1341,6 +1346,24 @@ mca_btl_base_module_t **mca_btl_tcp_component_init(int *num_btl_modules,
     return btls;
 }
 
+/*
+ * Without progress thread the sockets are in the event base of
+ * opal_progress(): idle threads can block on it. Only do so once a
+ * connection is established, as until then the messages go through other
+ * components (or other libraries), which the event loop does not watch.
+ */
+void mca_btl_tcp_component_register_blocker(void)
+{
+    int32_t expected = 0;
+
+    if (mca_btl_tcp_event_base == opal_sync_event_base
+        && opal_atomic_compare_exchange_strong_32(&mca_btl_tcp_component.tcp_blocker_registered,
+                                                  &expected, 1)) {
+        (void) opal_progress_register_blocker(opal_progress_event_block,
+                                              opal_progress_event_wake);
+    }
+}
+
 /**
  * Called by the event engine when the listening socket has
  * a connection event. Accept the incoming connection request
@@ -607,6 +607,7 @@ static void mca_btl_tcp_endpoint_connected(mca_btl_base_endpoint_t *btl_endpoint
     btl_endpoint->endpoint_state = MCA_BTL_TCP_CONNECTED;
     btl_endpoint->endpoint_retries = 0;
     MCA_BTL_TCP_ENDPOINT_DUMP(1, btl_endpoint, true, "READY [endpoint_connected]");
+    mca_btl_tcp_component_register_blocker();
 
     if (opal_list_get_size(&btl_endpoint->endpoint_frags) > 0) {
         if (NULL == btl_endpoint->endpoint_send_frag) {
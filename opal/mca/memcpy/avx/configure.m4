@@ -0,0 +1,129 @@
+# -*- shell-script -*-
+#
+# Copyright (c) 2025      The University of Tennessee and The University
+#                         of Tennessee Research Foundation.  All rights
+#                         reserved.
+# $COPYRIGHT$
+#
+# Additional copyrights may follow
+#
+# $HEADER$
+#
+
+# MCA_opal_memcpy_avx_CONFIG([action-if-can-compile],
+#                            [action-if-cant-compile])
+# ------------------------------------------------
+# Build on x86 if the compiler provides the AVX2 or AVX512 streaming stores,
+# possibly with additional flags. The ISA is checked again at runtime.
+AC_DEFUN([MCA_opal_memcpy_avx_CONFIG],[
+    AC_CONFIG_FILES([opal/mca/memcpy/avx/Makefile])
+
+    MCA_BUILD_MEMCPY_AVX2_FLAGS=""
+    MCA_BUILD_MEMCPY_AVX512_FLAGS=""
+    memcpy_avx2_support=0
+    memcpy_avx512_support=0
+
+    OPAL_VAR_SCOPE_PUSH([memcpy_avx_cflags_save memcpy_avx_check])
+
+    case "${host}" in
+        x86_64-*x32|i?86-*|x86_64*|amd64*)
+            memcpy_avx_check="yes";;
+        *)
+            memcpy_avx_check="no";;
+    esac
+    AS_IF([test "$memcpy_avx_check" = "yes"],
+          [AC_LANG_PUSH([C])
+
+           #
+           # Check for AVX512 streaming stores
+           #
+           AC_MSG_CHECKING([for AVX512 streaming stores (no additional flags)])
+           AC_LINK_IFELSE(
+               [AC_LANG_PROGRAM([[#include <immintrin.h>]],
+                                [[
+#if defined(__ICC) && !defined(__AVX512F__)
+#error "icc needs the -m flags to provide the AVX* detection macros"
+#endif
+    int A[32];
+    _mm512_stream_si512((void*)A, _mm512_loadu_si512((void*)&(A[16])))
+                                ]])],
+               [memcpy_avx512_support=1
+                AC_MSG_RESULT([yes])],
+               [AC_MSG_RESULT([no])])
+           AS_IF([test $memcpy_avx512_support -eq 0],
+                 [AC_MSG_CHECKING([for AVX512 streaming stores (with -mavx512f)])
+                  memcpy_avx_cflags_save="$CFLAGS"
+                  CFLAGS="-mavx512f $CFLAGS"
+                  AC_LINK_IFELSE(
+                      [AC_LANG_PROGRAM([[#include <immintrin.h>]],
+                                       [[
+#if defined(__ICC) && !defined(__AVX512F__)
+#error "icc needs the -m flags to provide the AVX* detection macros"
+#endif
+    int A[32];
+    _mm512_stream_si512((void*)A, _mm512_loadu_si512((void*)&(A[16])))
+                                       ]])],
+                      [memcpy_avx512_support=1
+                       MCA_BUILD_MEMCPY_AVX512_FLAGS="-mavx512f"
+                       AC_MSG_RESULT([yes])],
+                      [AC_MSG_RESULT([no])])
+                  CFLAGS="$memcpy_avx_cflags_save"
+                 ])
+
+           #
+           # Check for AVX2 streaming stores
+           #
+           AC_MSG_CHECKING([for AVX2 streaming stores (no additional flags)])
+           AC_LINK_IFELSE(
+               [AC_LANG_PROGRAM([[#include <immintrin.h>]],
+                                [[
+#if defined(__ICC) && !defined(__AVX2__)
+#error "icc needs the -m flags to provide the AVX* detection macros"
+#endif
+    int A[16];
+    _mm256_stream_si256((__m256i*)A, _mm256_loadu_si256((__m256i*)&(A[8])))
+                                ]])],
+               [memcpy_avx2_support=1
+                AC_MSG_RESULT([yes])],
+               [AC_MSG_RESULT([no])])
+           AS_IF([test $memcpy_avx2_support -eq 0],
+                 [AC_MSG_CHECKING([for AVX2 streaming stores (with -mavx2)])
+                  memcpy_avx_cflags_save="$CFLAGS"
+                  CFLAGS="-mavx2 $CFLAGS"
+                  AC_LINK_IFELSE(
+                      [AC_LANG_PROGRAM([[#include <immintrin.h>]],
+                                       [[
+#if defined(__ICC) && !defined(__AVX2__)
+#error "icc needs the -m flags to provide the AVX* detection macros"
+#endif
+    int A[16];
+    _mm256_stream_si256((__m256i*)A, _mm256_loadu_si256((__m256i*)&(A[8])))
+                                       ]])],
+                      [memcpy_avx2_support=1
+                       MCA_BUILD_MEMCPY_AVX2_FLAGS="-mavx2"
+                       AC_MSG_RESULT([yes])],
+                      [AC_MSG_RESULT([no])])
+                  CFLAGS="$memcpy_avx_cflags_save"
+                 ])
+
+           AC_LANG_POP([C])
+          ])
+    AC_DEFINE_UNQUOTED([OPAL_MCA_MEMCPY_HAVE_AVX512],
+                       [$memcpy_avx512_support],
+                       [AVX512 memcpy supported in the current build])
+    AC_DEFINE_UNQUOTED([OPAL_MCA_MEMCPY_HAVE_AVX2],
+                       [$memcpy_avx2_support],
+                       [AVX2 memcpy supported in the current build])
+    AM_CONDITIONAL([MCA_BUILD_opal_memcpy_has_avx512_support],
+                   [test "$memcpy_avx512_support" = "1"])
+    AM_CONDITIONAL([MCA_BUILD_opal_memcpy_has_avx2_support],
+                   [test "$memcpy_avx2_support" = "1"])
+    AC_SUBST(MCA_BUILD_MEMCPY_AVX512_FLAGS)
+    AC_SUBST(MCA_BUILD_MEMCPY_AVX2_FLAGS)
+
+    OPAL_VAR_SCOPE_POP
+
+    AS_IF([test $memcpy_avx2_support -eq 1 || test $memcpy_avx512_support -eq 1],
+          [$1],
+          [$2])
+])dnl
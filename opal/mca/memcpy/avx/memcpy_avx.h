@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#ifndef MCA_MEMCPY_AVX_EXPORT_H
+#define MCA_MEMCPY_AVX_EXPORT_H
+
+#include "opal_config.h"
+
+#include "opal/mca/memcpy/memcpy.h"
+
+BEGIN_C_DECLS
+
+#define OPAL_MEMCPY_AVX_HAS_AVX512F_FLAG 0x00000100
+#define OPAL_MEMCPY_AVX_HAS_AVX2_FLAG    0x00000020
+
+/* Values of the variant parameter */
+#define OPAL_MEMCPY_AVX_VARIANT_ISA    0 /* the widest supported by the processor */
+#define OPAL_MEMCPY_AVX_VARIANT_AVX2   1
+#define OPAL_MEMCPY_AVX_VARIANT_AVX512 2
+#define OPAL_MEMCPY_AVX_VARIANT_AUTO   3 /* the fastest, measured at startup */
+
+typedef struct {
+    opal_memcpy_base_component_t super;
+
+    uint32_t supported; /* AVX capabilities of the processor */
+    int variant;
+    int priority;
+} opal_memcpy_avx_component_t;
+
+OPAL_DECLSPEC extern opal_memcpy_avx_component_t mca_memcpy_avx_component;
+
+#if OPAL_MCA_MEMCPY_HAVE_AVX512
+void *opal_memcpy_avx512_copy(void *dst, const void *src, size_t len);
+#endif
+#if OPAL_MCA_MEMCPY_HAVE_AVX2
+void *opal_memcpy_avx2_copy(void *dst, const void *src, size_t len);
+#endif
+
+END_C_DECLS
+
+#endif /* MCA_MEMCPY_AVX_EXPORT_H */
@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/** @file
+ *
+ * Copies of large buffers with AVX2 or AVX512 non-temporal stores. The
+ * variant is chosen from the processor capabilities, or by measuring the
+ * bandwidth of each of them and of the C library memcpy at startup.
+ */
+
+#include "opal_config.h"
+
+#include <stdint.h>
+
+#include "opal/constants.h"
+#include "opal/mca/memcpy/avx/memcpy_avx.h"
+#include "opal/mca/memcpy/base/base.h"
+#include "opal/util/output.h"
+
+/* the benchmark of the auto variant copies at most this many bytes */
+#define MEMCPY_AVX_BENCHMARK_MAX (64 * 1024 * 1024)
+
+static int memcpy_avx_component_register(void);
+static int memcpy_avx_component_query(mca_base_module_t **module, int *priority);
+
+static opal_memcpy_base_module_t memcpy_avx_module = {
+    .copy = NULL,
+};
+
+static mca_base_var_enum_value_t memcpy_avx_variants[] = {
+    {OPAL_MEMCPY_AVX_VARIANT_ISA, "isa"},
+    {OPAL_MEMCPY_AVX_VARIANT_AVX2, "avx2"},
+    {OPAL_MEMCPY_AVX_VARIANT_AVX512, "avx512"},
+    {OPAL_MEMCPY_AVX_VARIANT_AUTO, "auto"},
+    {0, NULL},
+};
+
+/**
+ * Same detection as in the op/avx component, limited to the features
+ * this component uses.
+ */
+#if defined(__INTEL_COMPILER) && (__INTEL_COMPILER >= 1300)
+
+#include <immintrin.h>
+
+static uint32_t has_intel_AVX_features(void)
+{
+    uint32_t flags = 0;
+
+    flags |= _may_i_use_cpu_feature(_FEATURE_AVX512F) ? OPAL_MEMCPY_AVX_HAS_AVX512F_FLAG : 0;
+    flags |= _may_i_use_cpu_feature(_FEATURE_AVX2)    ? OPAL_MEMCPY_AVX_HAS_AVX2_FLAG    : 0;
+    return flags;
+}
+#else /* non-Intel compiler */
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+static void run_cpuid(uint32_t eax, uint32_t ecx, uint32_t* abcd)
+{
+#if defined(_MSC_VER)
+    __cpuidex(abcd, eax, ecx);
+#else
+    uint32_t ebx = 0, edx = 0;
+#if defined( __i386__ ) && defined ( __PIC__ )
+    /* in case of PIC under 32-bit EBX cannot be clobbered */
+    __asm__ ( "movl %%ebx, %%edi \n\t cpuid \n\t xchgl %%ebx, %%edi" : "=D" (ebx),
+#else
+    __asm__ ( "cpuid" : "+b" (ebx),
+#endif  /* defined( __i386__ ) && defined ( __PIC__ ) */
+              "+a" (eax), "+c" (ecx), "=d" (edx) );
+    abcd[0] = eax; abcd[1] = ebx; abcd[2] = ecx; abcd[3] = edx;
+#endif
+}
+
+static uint32_t has_intel_AVX_features(void)
+{
+    const uint32_t avx512f_mask = (1U << 16);  // AVX512F (EAX = 7, ECX = 0) : EBX
+    const uint32_t avx2_mask    = (1U << 5);   // AVX2    (EAX = 7, ECX = 0) : EBX
+    uint32_t flags = 0, abcd[4];
+
+#if defined(__APPLE__)
+    uint32_t fma_movbe_osxsave_mask = ((1U << 12) | (1U << 22) | (1U << 27));  /* FMA(12) + MOVBE (22) OSXSAVE (27) */
+    run_cpuid( 1, 0, abcd );
+    // OS supports extended processor state management ?
+    if ( (abcd[2] & fma_movbe_osxsave_mask) != fma_movbe_osxsave_mask )
+        return 0;
+#endif  /* defined(__APPLE__) */
+
+    run_cpuid( 7, 0, abcd );
+    flags |= (abcd[1] & avx512f_mask) ? OPAL_MEMCPY_AVX_HAS_AVX512F_FLAG : 0;
+    flags |= (abcd[1] & avx2_mask)    ? OPAL_MEMCPY_AVX_HAS_AVX2_FLAG    : 0;
+    return flags;
+}
+#endif /* non-Intel compiler */
+
+opal_memcpy_avx_component_t mca_memcpy_avx_component = {
+    .super = {
+        .memcpyc_version = {
+            OPAL_MEMCPY_BASE_VERSION_2_0_0,
+
+            .mca_component_name = "avx",
+            MCA_BASE_MAKE_VERSION(component, OPAL_MAJOR_VERSION, OPAL_MINOR_VERSION,
+                                  OPAL_RELEASE_VERSION),
+            .mca_query_component = memcpy_avx_component_query,
+            .mca_register_component_params = memcpy_avx_component_register,
+        },
+        .memcpyc_data = {
+            /* The component is checkpoint ready */
+            MCA_BASE_METADATA_PARAM_CHECKPOINT
+        },
+    },
+    .variant = OPAL_MEMCPY_AVX_VARIANT_ISA,
+    .priority = 20,
+};
+MCA_BASE_COMPONENT_INIT(opal, memcpy, avx)
+
+static int memcpy_avx_component_register(void)
+{
+    mca_base_var_enum_t *new_enum = NULL;
+
+    mca_memcpy_avx_component.supported = has_intel_AVX_features();
+
+    (void) mca_base_var_enum_create("memcpy_avx_variants", memcpy_avx_variants, &new_enum);
+    (void) mca_base_component_var_register(&mca_memcpy_avx_component.super.memcpyc_version,
+                                           "variant",
+                                           "Instruction set used for the copies: \"isa\" the widest "
+                                           "supported by the processor, \"avx2\", \"avx512\", or "
+                                           "\"auto\" the fastest of them and of the C library "
+                                           "memcpy, measured at startup",
+                                           MCA_BASE_VAR_TYPE_INT, new_enum, 0, 0,
+                                           OPAL_INFO_LVL_5, MCA_BASE_VAR_SCOPE_LOCAL,
+                                           &mca_memcpy_avx_component.variant);
+    OBJ_RELEASE(new_enum);
+
+    (void) mca_base_component_var_register(&mca_memcpy_avx_component.super.memcpyc_version,
+                                           "priority", "Priority of the avx memcpy component",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0, OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_LOCAL,
+                                           &mca_memcpy_avx_component.priority);
+
+    return OPAL_SUCCESS;
+}
+
+static int memcpy_avx_component_query(mca_base_module_t **module, int *priority)
+{
+    opal_memcpy_base_module_copy_fn_t candidates[2], copy = NULL;
+    int variant = mca_memcpy_avx_component.variant, count = 0;
+
+    *module = NULL;
+
+#if OPAL_MCA_MEMCPY_HAVE_AVX512
+    if ((mca_memcpy_avx_component.supported & OPAL_MEMCPY_AVX_HAS_AVX512F_FLAG)
+        && (OPAL_MEMCPY_AVX_VARIANT_AVX2 != variant)) {
+        candidates[count++] = opal_memcpy_avx512_copy;
+    }
+#endif
+#if OPAL_MCA_MEMCPY_HAVE_AVX2
+    if ((mca_memcpy_avx_component.supported & OPAL_MEMCPY_AVX_HAS_AVX2_FLAG)
+        && (OPAL_MEMCPY_AVX_VARIANT_AVX512 != variant)) {
+        candidates[count++] = opal_memcpy_avx2_copy;
+    }
+#endif
+    if (0 == count) {
+        return OPAL_ERR_NOT_AVAILABLE;
+    }
+
+    if (OPAL_MEMCPY_AVX_VARIANT_AUTO != variant) {
+        copy = candidates[0];
+    } else {
+        size_t len = opal_memcpy_base_nt_threshold;
+        double bw, best;
+
+        /* twice the threshold, to measure copies that do not fit in the cache */
+        len = (len > MEMCPY_AVX_BENCHMARK_MAX / 2) ? MEMCPY_AVX_BENCHMARK_MAX : 2 * len;
+        best = opal_memcpy_base_benchmark(opal_memcpy_base_copy, len);
+        for (int i = 0; i < count; i++) {
+            bw = opal_memcpy_base_benchmark(candidates[i], len);
+            if (bw > best) {
+                best = bw;
+                copy = candidates[i];
+            }
+        }
+        if (NULL == copy) {
+            /* the C library is faster on this machine */
+            return OPAL_ERR_NOT_AVAILABLE;
+        }
+    }
+
+    memcpy_avx_module.copy = copy;
+    *module = (mca_base_module_t *) &memcpy_avx_module;
+    *priority = mca_memcpy_avx_component.priority;
+    return OPAL_SUCCESS;
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+ * Built once per ISA, with GENERATE_AVX2_CODE or GENERATE_AVX512_CODE and
+ * the matching compiler flags.
+ *
+ * The destination is aligned on the vector size, as the streaming stores
+ * require, and the source is read with unaligned loads. The streaming stores
+ * are weakly ordered, hence the sfence before returning.
+ */
+
+#include "opal_config.h"
+
+#include <immintrin.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "opal/mca/memcpy/avx/memcpy_avx.h"
+
+/* how far ahead of the loads to prefetch the source */
+#define MEMCPY_AVX_PREFETCH_DISTANCE 1024
+
+#if defined(GENERATE_AVX512_CODE)
+void *opal_memcpy_avx512_copy(void *dst, const void *src, size_t len)
+{
+    unsigned char *d = (unsigned char *) dst;
+    const unsigned char *s = (const unsigned char *) src;
+    size_t head = (64 - ((uintptr_t) d & 63)) & 63;
+
+    if (head > len) {
+        head = len;
+    }
+    memcpy(d, s, head);
+    d += head;
+    s += head;
+    len -= head;
+
+    for (; len >= 256; len -= 256, s += 256, d += 256) {
+        __m512i v0, v1, v2, v3;
+
+        _mm_prefetch((const char *) (s + MEMCPY_AVX_PREFETCH_DISTANCE), _MM_HINT_NTA);
+        _mm_prefetch((const char *) (s + MEMCPY_AVX_PREFETCH_DISTANCE + 128), _MM_HINT_NTA);
+        v0 = _mm512_loadu_si512((const void *) (s));
+        v1 = _mm512_loadu_si512((const void *) (s + 64));
+        v2 = _mm512_loadu_si512((const void *) (s + 128));
+        v3 = _mm512_loadu_si512((const void *) (s + 192));
+        _mm512_stream_si512((void *) (d), v0);
+        _mm512_stream_si512((void *) (d + 64), v1);
+        _mm512_stream_si512((void *) (d + 128), v2);
+        _mm512_stream_si512((void *) (d + 192), v3);
+    }
+    _mm_sfence();
+
+    memcpy(d, s, len);
+    return dst;
+}
+#endif /* defined(GENERATE_AVX512_CODE) */
+
+#if defined(GENERATE_AVX2_CODE)
+void *opal_memcpy_avx2_copy(void *dst, const void *src, size_t len)
+{
+    unsigned char *d = (unsigned char *) dst;
+    const unsigned char *s = (const unsigned char *) src;
+    size_t head = (32 - ((uintptr_t) d & 31)) & 31;
+
+    if (head > len) {
+        head = len;
+    }
+    memcpy(d, s, head);
+    d += head;
+    s += head;
+    len -= head;
+
+    for (; len >= 128; len -= 128, s += 128, d += 128) {
+        __m256i v0, v1, v2, v3;
+
+        _mm_prefetch((const char *) (s + MEMCPY_AVX_PREFETCH_DISTANCE), _MM_HINT_NTA);
+        v0 = _mm256_loadu_si256((const __m256i *) (s));
+        v1 = _mm256_loadu_si256((const __m256i *) (s + 32));
+        v2 = _mm256_loadu_si256((const __m256i *) (s + 64));
+        v3 = _mm256_loadu_si256((const __m256i *) (s + 96));
+        _mm256_stream_si256((__m256i *) (d), v0);
+        _mm256_stream_si256((__m256i *) (d + 32), v1);
+        _mm256_stream_si256((__m256i *) (d + 64), v2);
+        _mm256_stream_si256((__m256i *) (d + 96), v3);
+    }
+    _mm_sfence();
+
+    memcpy(d, s, len);
+    return dst;
+}
+#endif /* defined(GENERATE_AVX2_CODE) */
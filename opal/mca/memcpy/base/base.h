@@ -28,9 +28,41 @@ BEGIN_C_DECLS
  */
 OPAL_DECLSPEC extern mca_base_framework_t opal_memcpy_base_framework;
 
+/**
+ * The selected module. Before the selection, and when no component is
+ * available, it copies with the C library memcpy.
+ */
+OPAL_DECLSPEC extern opal_memcpy_base_module_t opal_memcpy_base_module;
+
+/**
+ * Copies of at least this many bytes go through the selected module.
+ * SIZE_MAX until a component is selected; defaults to the size of the
+ * last level cache.
+ */
+OPAL_DECLSPEC extern size_t opal_memcpy_base_nt_threshold;
+extern size_t opal_memcpy_base_nt_threshold_param;
+
+/**
+ * Select the best memcpy component. Called once the framework is open.
+ */
+OPAL_DECLSPEC int opal_memcpy_base_select(void);
+
+/**
+ * Bandwidth of a copy function, in bytes per microsecond, measured on
+ * buffers of len bytes. Used by the components to pick the fastest of
+ * their implementations.
+ */
+OPAL_DECLSPEC double opal_memcpy_base_benchmark(opal_memcpy_base_module_copy_fn_t copy,
+                                                size_t len);
+
+/**
+ * The C library memcpy, as a module function.
+ */
+OPAL_DECLSPEC void *opal_memcpy_base_copy(void *dst, const void *src, size_t len);
+
 END_C_DECLS
 
 /* include implementation to call */
-#include MCA_timer_IMPLEMENTATION_HEADER
+#include "opal/mca/memcpy/base/memcpy_base_default.h"
 
 #endif /* OPAL_BASE_MEMCPY_H */
@@ -12,7 +12,52 @@
 #ifndef OPAL_MCA_MEMCPY_BASE_MEMCPY_BASE_NULL_H
 #define OPAL_MCA_MEMCPY_BASE_MEMCPY_BASE_NULL_H
 
-#define opal_memcpy(dst, src, length) memcpy((dst), (src), (length));
+#include <stddef.h>
+#include <string.h>
+
+#include "opal/prefetch.h"
+
+static inline void *opal_memcpy(void *dst, const void *src, size_t length)
+{
+    if (OPAL_LIKELY(length < opal_memcpy_base_nt_threshold)) {
+        return memcpy(dst, src, length);
+    }
+    return opal_memcpy_base_module.copy(dst, src, length);
+}
+
+/* Copy one chunk of a transfer of total bytes that is split by the caller.
+ * The choice of the copy function follows the size of the whole transfer:
+ * the chunks are usually smaller than the threshold, while the transfer as
+ * a whole still streams through the cache. */
+static inline void *opal_memcpy_chunk(void *dst, const void *src, size_t length, size_t total)
+{
+    if (OPAL_LIKELY(total < opal_memcpy_base_nt_threshold)) {
+        return memcpy(dst, src, length);
+    }
+    return opal_memcpy_base_module.copy(dst, src, length);
+}
+
+/* Copy count blocks of length bytes between strided buffers. The hardware
+ * prefetchers follow each block but not the jump to the next one, so the
+ * beginning of the next source block is prefetched while copying the
+ * current one. */
+static inline void opal_memcpy_strided(void *dst, ptrdiff_t dst_stride, const void *src,
+                                       ptrdiff_t src_stride, size_t length, size_t count)
+{
+    unsigned char *_dst = (unsigned char *) dst;
+    const unsigned char *_src = (const unsigned char *) src;
+
+    for (size_t _i = 0; _i < count; _i++) {
+        if (_i + 1 < count) {
+            for (size_t _off = 0; (_off < length) && (_off < 256); _off += 64) {
+                OPAL_PREFETCH(_src + src_stride + _off, 0, 0);
+            }
+        }
+        opal_memcpy(_dst, _src, length);
+        _dst += dst_stride;
+        _src += src_stride;
+    }
+}
 
 #define opal_memcpy_tov(dst_iov, src, count)                              \
     do {                                                                  \
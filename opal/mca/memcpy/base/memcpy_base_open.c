@@ -11,6 +11,9 @@
 
 #include "opal_config.h"
 
+#include <stdint.h>
+#include <string.h>
+
 #include "opal/constants.h"
 #include "opal/mca/base/base.h"
 #include "opal/mca/mca.h"
@@ -27,6 +30,39 @@
 /*
  * Globals
  */
-/* Use default register/open/close functions */
-MCA_BASE_FRAMEWORK_DECLARE(opal, memcpy, NULL, NULL, NULL, NULL, mca_memcpy_base_static_components,
-                           0);
+void *opal_memcpy_base_copy(void *dst, const void *src, size_t len)
+{
+    return memcpy(dst, src, len);
+}
+
+opal_memcpy_base_module_t opal_memcpy_base_module = {
+    .copy = opal_memcpy_base_copy,
+};
+
+size_t opal_memcpy_base_nt_threshold = SIZE_MAX;
+
+/* 0 means the size of the last level cache */
+size_t opal_memcpy_base_nt_threshold_param = 0;
+
+static int opal_memcpy_base_register(mca_base_register_flag_t flags)
+{
+    (void) mca_base_framework_var_register(
+        &opal_memcpy_base_framework, "nt_threshold",
+        "Size in bytes from which copies use the selected memcpy component, usually "
+        "with non-temporal stores (0 = size of the last level cache)",
+        MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE, OPAL_INFO_LVL_5,
+        MCA_BASE_VAR_SCOPE_LOCAL, &opal_memcpy_base_nt_threshold_param);
+
+    return OPAL_SUCCESS;
+}
+
+static int opal_memcpy_base_close(void)
+{
+    opal_memcpy_base_module.copy = opal_memcpy_base_copy;
+    opal_memcpy_base_nt_threshold = SIZE_MAX;
+
+    return mca_base_framework_components_close(&opal_memcpy_base_framework, NULL);
+}
+
+MCA_BASE_FRAMEWORK_DECLARE(opal, memcpy, "OPAL memory copy", opal_memcpy_base_register, NULL,
+                           opal_memcpy_base_close, mca_memcpy_base_static_components, 0);
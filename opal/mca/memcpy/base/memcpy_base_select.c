@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "opal_config.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef HAVE_UNISTD_H
+#    include <unistd.h>
+#endif
+
+#include "opal/constants.h"
+#include "opal/mca/base/base.h"
+#include "opal/mca/mca.h"
+#include "opal/mca/memcpy/base/base.h"
+#include "opal/mca/memcpy/memcpy.h"
+#include "opal/mca/timer/base/base.h"
+#include "opal/util/output.h"
+
+#define OPAL_MEMCPY_BASE_DEFAULT_LLC (8 * 1024 * 1024)
+
+/* The topology is usually not loaded this early, so ask the C library */
+static size_t opal_memcpy_base_llc_size(void)
+{
+    long size = 0;
+
+#if defined(_SC_LEVEL3_CACHE_SIZE)
+    size = sysconf(_SC_LEVEL3_CACHE_SIZE);
+#endif
+#if defined(_SC_LEVEL2_CACHE_SIZE)
+    if (0 >= size) {
+        size = sysconf(_SC_LEVEL2_CACHE_SIZE);
+    }
+#endif
+    return (0 < size) ? (size_t) size : OPAL_MEMCPY_BASE_DEFAULT_LLC;
+}
+
+int opal_memcpy_base_select(void)
+{
+    opal_memcpy_base_component_t *best_component = NULL;
+    opal_memcpy_base_module_t *best_module = NULL;
+
+    /* the components need the threshold to tune their module */
+    opal_memcpy_base_nt_threshold = (0 != opal_memcpy_base_nt_threshold_param)
+                                        ? opal_memcpy_base_nt_threshold_param
+                                        : opal_memcpy_base_llc_size();
+
+    if (OPAL_SUCCESS
+        != mca_base_select("memcpy", opal_memcpy_base_framework.framework_output,
+                           &opal_memcpy_base_framework.framework_components,
+                           (mca_base_module_t **) &best_module,
+                           (mca_base_component_t **) &best_component, NULL)) {
+        /* no component, all the copies go to the C library */
+        opal_memcpy_base_nt_threshold = SIZE_MAX;
+        return OPAL_SUCCESS;
+    }
+
+    opal_memcpy_base_module = *best_module;
+    opal_output_verbose(10, opal_memcpy_base_framework.framework_output,
+                        "memcpy: using %s for copies of %" PRIsize_t " bytes and more",
+                        best_component->memcpyc_version.mca_component_name,
+                        opal_memcpy_base_nt_threshold);
+
+    return OPAL_SUCCESS;
+}
+
+double opal_memcpy_base_benchmark(opal_memcpy_base_module_copy_fn_t copy, size_t len)
+{
+    opal_timer_t start, elapsed, best = (opal_timer_t) -1;
+    void *src = NULL, *dst = NULL;
+
+    if ((0 != posix_memalign(&src, 64, len)) || (0 != posix_memalign(&dst, 64, len))) {
+        free(src);
+        return 0.0;
+    }
+    /* touch the pages, the first copy would measure the page faults */
+    memset(src, 1, len);
+    memset(dst, 0, len);
+
+    for (int i = 0; i < 4; i++) {
+        start = opal_timer_base_get_usec();
+        copy(dst, src, len);
+        elapsed = opal_timer_base_get_usec() - start;
+        if (elapsed < best) {
+            best = elapsed;
+        }
+    }
+
+    free(src);
+    free(dst);
+    return (double) len / (double) (0 == best ? 1 : best);
+}
@@ -12,21 +12,7 @@ dnl
 dnl $HEADER$
 dnl
 
-dnl we only want one
-m4_define(MCA_opal_memcpy_CONFIGURE_MODE, STOP_AT_FIRST)
-
+dnl the components are selected at runtime, build all the ones that can
 AC_DEFUN([MCA_opal_memcpy_CONFIG],[
-        memcpy_base_include=
-
-        # first, compile all the components
         MCA_CONFIGURE_FRAMEWORK($1, $2, 1)
-
-        # someone should have set this...
-        if test "$memcpy_base_include" = "" ; then
-            memcpy_base_include="base/memcpy_base_default.h"
-        fi
-
-        AC_DEFINE_UNQUOTED([MCA_memcpy_IMPLEMENTATION_HEADER],
-                           ["opal/mca/memcpy/$memcpy_base_include"],
-                           [Header to include for memcpy implementation])
 ])
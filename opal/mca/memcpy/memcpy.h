@@ -15,6 +15,10 @@
 /**
  * @file
  *
+ * Copies of large contiguous buffers. The selected module is used by
+ * opal_memcpy() for copies of at least opal_memcpy_base_nt_threshold
+ * bytes, where writing around the caches (non-temporal stores) pays off.
+ * Smaller copies always go to the C library memcpy.
  */
 
 #ifndef OPAL_MCA_MEMCPY_MEMCPY_H
@@ -25,8 +29,26 @@
 #include "opal/mca/base/base.h"
 #include "opal/mca/mca.h"
 
+BEGIN_C_DECLS
+
 /**
- * Structure for memcpy components.
+ * Copy len bytes from src to dst. The buffers do not overlap.
+ */
+typedef void *(*opal_memcpy_base_module_copy_fn_t)(void *dst, const void *src, size_t len);
+
+/**
+ * Structure for memcpy modules.
+ */
+struct opal_memcpy_base_module_1_0_0_t {
+    /** Copy of a large buffer */
+    opal_memcpy_base_module_copy_fn_t copy;
+};
+typedef struct opal_memcpy_base_module_1_0_0_t opal_memcpy_base_module_1_0_0_t;
+typedef struct opal_memcpy_base_module_1_0_0_t opal_memcpy_base_module_t;
+
+/**
+ * Structure for memcpy components. The component returns its module and
+ * priority from mca_query_component.
  */
 struct opal_memcpy_base_component_2_0_0_t {
     /** MCA base component */
@@ -39,10 +61,13 @@ struct opal_memcpy_base_component_2_0_0_t {
  * Convenience typedef
  */
 typedef struct opal_memcpy_base_component_2_0_0_t opal_memcpy_base_component_2_0_0_t;
+typedef struct opal_memcpy_base_component_2_0_0_t opal_memcpy_base_component_t;
 
 /*
  * Macro for use in components that are of type memcpy
  */
 #define OPAL_MEMCPY_BASE_VERSION_2_0_0 OPAL_MCA_BASE_VERSION_2_1_0("memcpy", 2, 0, 0)
 
+END_C_DECLS
+
 #endif /* OPAL_MCA_MEMCPY_MEMCPY_H */
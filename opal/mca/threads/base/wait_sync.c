@@ -116,9 +116,10 @@ check_status:
     opal_thread_internal_mutex_unlock(&sync->lock);
 
     OPAL_THREAD_ADD_FETCH32(&num_thread_in_progress, 1);
+    int idle = 0;
     while (sync->count > 0) { /* progress till completion */
         /* don't progress with the sync lock locked or you'll deadlock */
-        opal_progress();
+        opal_progress_idle(opal_progress(), &idle, &sync->count);
     }
     OPAL_THREAD_ADD_FETCH32(&num_thread_in_progress, -1);
 
@@ -100,8 +100,9 @@ static inline int sync_wait_st(ompi_wait_sync_t *sync)
     assert(NULL == sync->next);
     opal_threads_base_wait_sync_list = sync;
 
+    int idle = 0;
     while (sync->count > 0) {
-        opal_progress();
+        opal_progress_idle(opal_progress(), &idle, &sync->count);
     }
     opal_threads_base_wait_sync_list = NULL;
 
@@ -150,6 +151,8 @@ static inline void wait_sync_update(ompi_wait_sync_t *sync, int updates, int sta
         opal_atomic_wmb();
         opal_atomic_swap_32(&sync->count, 0);
     }
+    /* the thread waiting on the sync may be blocked in opal_progress */
+    opal_progress_wake();
     WAIT_SYNC_SIGNAL(sync);
 }
 
@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "opal_config.h"
+
+#include <stdlib.h>
+
+#include "opal/class/opal_object.h"
+#include "opal/constants.h"
+#include "opal/mca/hwloc/base/base.h"
+#include "opal/mca/threads/threads.h"
+#include "opal/sys/atomic.h"
+#include "opal/util/output.h"
+
+#include "opal/runtime/opal_helper_threads.h"
+
+typedef struct opal_helper_thread_t {
+    opal_thread_t thread;
+    hwloc_cpuset_t cpuset; /* NULL if unbound */
+    opal_helper_threads_t *pool;
+} opal_helper_thread_t;
+
+static void helper_threads_work(opal_helper_threads_t *pool, opal_helper_threads_fn_t fn,
+                                void *arg, int32_t nitems)
+{
+    int32_t item;
+
+    while ((item = opal_atomic_fetch_add_32(&pool->next_item, 1)) < nitems) {
+        fn(arg, item);
+
+        opal_atomic_wmb();
+        opal_atomic_add_fetch_32(&pool->done_items, 1);
+    }
+}
+
+static void *helper_threads_main(opal_object_t *obj)
+{
+    opal_helper_thread_t *helper = (opal_helper_thread_t *) ((opal_thread_t *) obj)->t_arg;
+    opal_helper_threads_t *pool = helper->pool;
+    opal_helper_threads_fn_t fn;
+    uint64_t seen = 0;
+    int32_t nitems;
+    void *arg;
+
+    if (NULL != helper->cpuset) {
+        if (0 != hwloc_set_cpubind(opal_hwloc_topology, helper->cpuset, HWLOC_CPUBIND_THREAD)) {
+            opal_output_verbose(10, pool->output, "%s: failed to bind helper thread",
+                                pool->name);
+        }
+    }
+
+    opal_mutex_lock(&pool->lock);
+
+    while (true) {
+        while (!pool->shutdown && (!pool->job_open || seen == pool->generation)) {
+            opal_cond_wait(&pool->cond, &pool->lock);
+        }
+
+        if (pool->shutdown) {
+            break;
+        }
+
+        /* Joining is only possible while the job is open, and the
+         * caller does not return before all joined helpers leave */
+        seen = pool->generation;
+        fn = pool->fn;
+        arg = pool->arg;
+        nitems = pool->nitems;
+        opal_atomic_add_fetch_32(&pool->active, 1);
+
+        opal_mutex_unlock(&pool->lock);
+
+        helper_threads_work(pool, fn, arg, nitems);
+        opal_atomic_add_fetch_32(&pool->active, -1);
+
+        opal_mutex_lock(&pool->lock);
+    }
+
+    opal_mutex_unlock(&pool->lock);
+
+    return OPAL_THREAD_CANCELLED;
+}
+
+/* Pick a core for each helper, inside the process' binding and apart
+ * from the one the calling thread currently runs on */
+static void helper_threads_assign_cores(opal_helper_threads_t *pool)
+{
+    hwloc_cpuset_t bound, current;
+    int ncores, next = 0;
+
+    if (OPAL_SUCCESS != opal_hwloc_base_get_topology()) {
+        return;
+    }
+
+    bound = hwloc_bitmap_alloc();
+    current = hwloc_bitmap_alloc();
+
+    if (NULL == bound || NULL == current
+        || 0 != hwloc_get_cpubind(opal_hwloc_topology, bound, HWLOC_CPUBIND_PROCESS)
+        || 0 != hwloc_get_last_cpu_location(opal_hwloc_topology, current,
+                                            HWLOC_CPUBIND_THREAD)) {
+        goto done;
+    }
+
+    ncores = hwloc_get_nbobjs_inside_cpuset_by_type(opal_hwloc_topology, bound, HWLOC_OBJ_CORE);
+    if (ncores <= pool->nhelpers) {
+        opal_output_verbose(10, pool->output,
+                            "%s: %d cores available for %d helper threads, leaving them unbound",
+                            pool->name, ncores, pool->nhelpers);
+        goto done;
+    }
+
+    for (int i = 0; i < ncores && next < pool->nhelpers; i++) {
+        hwloc_obj_t core = hwloc_get_obj_inside_cpuset_by_type(opal_hwloc_topology, bound,
+                                                               HWLOC_OBJ_CORE, i);
+        if (NULL == core || hwloc_bitmap_intersects(core->cpuset, current)) {
+            continue;
+        }
+        pool->helpers[next++].cpuset = hwloc_bitmap_dup(core->cpuset);
+    }
+
+done:
+    if (NULL != bound) {
+        hwloc_bitmap_free(bound);
+    }
+    if (NULL != current) {
+        hwloc_bitmap_free(current);
+    }
+}
+
+static int helper_threads_start(opal_helper_threads_t *pool, int nthreads)
+{
+    if (nthreads <= 0) {
+        return OPAL_ERR_NOT_SUPPORTED;
+    }
+
+    pool->helpers = (opal_helper_thread_t *) calloc(nthreads, sizeof(opal_helper_thread_t));
+    if (NULL == pool->helpers) {
+        return OPAL_ERR_OUT_OF_RESOURCE;
+    }
+    pool->nallocated = pool->nhelpers = nthreads;
+
+    helper_threads_assign_cores(pool);
+
+    for (int i = 0; i < pool->nhelpers; i++) {
+        opal_helper_thread_t *helper = &pool->helpers[i];
+
+        OBJ_CONSTRUCT(&helper->thread, opal_thread_t);
+        helper->thread.t_run = helper_threads_main;
+        helper->thread.t_arg = helper;
+        helper->pool = pool;
+
+        if (OPAL_SUCCESS != opal_thread_start(&helper->thread)) {
+            OBJ_DESTRUCT(&helper->thread);
+            pool->nhelpers = i;
+            break;
+        }
+    }
+
+    opal_output_verbose(10, pool->output, "%s: started %d helper threads", pool->name,
+                        pool->nhelpers);
+
+    return (pool->nhelpers > 0 ? OPAL_SUCCESS : OPAL_ERROR);
+}
+
+void opal_helper_threads_init(opal_helper_threads_t *pool, const char *name, int output)
+{
+    OBJ_CONSTRUCT(&pool->busy, opal_mutex_t);
+    OBJ_CONSTRUCT(&pool->lock, opal_mutex_t);
+    opal_cond_init(&pool->cond);
+
+    pool->fn = NULL;
+    pool->arg = NULL;
+    pool->nitems = 0;
+    pool->job_open = false;
+    pool->generation = 0;
+    pool->shutdown = false;
+    pool->next_item = 0;
+    pool->done_items = 0;
+    pool->active = 0;
+    pool->helpers = NULL;
+    pool->nallocated = 0;
+    pool->nhelpers = 0;
+    pool->started = false;
+    pool->failed = false;
+    pool->name = name;
+    pool->output = output;
+}
+
+void opal_helper_threads_fini(opal_helper_threads_t *pool)
+{
+    if (pool->started) {
+        opal_mutex_lock(&pool->lock);
+        pool->shutdown = true;
+        opal_cond_broadcast(&pool->cond);
+        opal_mutex_unlock(&pool->lock);
+
+        for (int i = 0; i < pool->nhelpers; i++) {
+            opal_thread_join(&pool->helpers[i].thread, NULL);
+            OBJ_DESTRUCT(&pool->helpers[i].thread);
+        }
+    }
+
+    if (NULL != pool->helpers) {
+        for (int i = 0; i < pool->nallocated; i++) {
+            if (NULL != pool->helpers[i].cpuset) {
+                hwloc_bitmap_free(pool->helpers[i].cpuset);
+            }
+        }
+        free(pool->helpers);
+        pool->helpers = NULL;
+    }
+
+    pool->nallocated = 0;
+    pool->nhelpers = 0;
+    pool->started = false;
+
+    opal_cond_destroy(&pool->cond);
+    OBJ_DESTRUCT(&pool->lock);
+    OBJ_DESTRUCT(&pool->busy);
+}
+
+int opal_helper_threads_acquire(opal_helper_threads_t *pool, int nthreads)
+{
+    if (0 != opal_mutex_trylock(&pool->busy)) {
+        return OPAL_ERR_WOULD_BLOCK;
+    }
+
+    if (!pool->started && !pool->failed) {
+        pool->started = true;
+        if (OPAL_SUCCESS != helper_threads_start(pool, nthreads)) {
+            pool->failed = true;
+        }
+    }
+
+    if (pool->failed || 0 == pool->nhelpers) {
+        opal_mutex_unlock(&pool->busy);
+        return OPAL_ERR_NOT_SUPPORTED;
+    }
+
+    return pool->nhelpers;
+}
+
+void opal_helper_threads_run(opal_helper_threads_t *pool, opal_helper_threads_fn_t fn, void *arg,
+                             int32_t nitems)
+{
+    opal_mutex_lock(&pool->lock);
+
+    pool->fn = fn;
+    pool->arg = arg;
+    pool->nitems = nitems;
+    pool->next_item = 0;
+    pool->done_items = 0;
+    pool->job_open = true;
+    pool->generation++;
+
+    opal_cond_broadcast(&pool->cond);
+    opal_mutex_unlock(&pool->lock);
+
+    helper_threads_work(pool, fn, arg, nitems);
+
+    while (pool->done_items < nitems) {
+        opal_atomic_rmb();
+    }
+
+    /* Close the job to late helpers, and wait for the
+     * ones that joined it to stop touching its counters */
+    opal_mutex_lock(&pool->lock);
+    pool->job_open = false;
+    opal_mutex_unlock(&pool->lock);
+
+    while (0 < pool->active) {
+        opal_atomic_rmb();
+    }
+
+    opal_atomic_rmb();
+}
+
+void opal_helper_threads_release(opal_helper_threads_t *pool)
+{
+    opal_mutex_unlock(&pool->busy);
+}
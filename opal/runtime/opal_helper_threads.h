@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/**
+ * @file
+ *
+ * Pools of helper threads that share a job with the calling thread.
+ *
+ * A job is a number of independent items, handed out on demand to the
+ * calling thread and to the helpers of the pool. The helpers are created
+ * on first use, and each of them is pinned to its own core of the
+ * process' binding, away from the core the calling thread runs on. If the
+ * binding does not hold enough cores, the helpers are left unbound.
+ *
+ * A pool runs one job at a time: opal_helper_threads_acquire() fails when
+ * another thread holds it, and the caller is expected to do the work
+ * serially instead.
+ */
+
+#ifndef OPAL_HELPER_THREADS_H
+#define OPAL_HELPER_THREADS_H
+
+#include "opal_config.h"
+
+#include "opal/mca/threads/condition.h"
+#include "opal/mca/threads/mutex.h"
+#include "opal/sys/atomic.h"
+
+BEGIN_C_DECLS
+
+/**
+ * Process item of the job described by arg. Called concurrently for
+ * different items.
+ */
+typedef void (*opal_helper_threads_fn_t)(void *arg, int32_t item);
+
+struct opal_helper_thread_t;
+
+struct opal_helper_threads_t {
+    /* Serializes users of the pool */
+    opal_mutex_t busy;
+
+    /* Protects the job, job_open, generation and shutdown */
+    opal_mutex_t lock;
+    opal_cond_t cond;
+
+    opal_helper_threads_fn_t fn;
+    void *arg;
+    int32_t nitems;
+    bool job_open;
+    uint64_t generation;
+    bool shutdown;
+
+    opal_atomic_int32_t next_item;
+    opal_atomic_int32_t done_items;
+    opal_atomic_int32_t active;
+
+    struct opal_helper_thread_t *helpers;
+    int nallocated;
+    int nhelpers;
+    bool started;
+    bool failed;
+
+    const char *name; /* prefix of the verbose messages */
+    int output;       /* output stream of the verbose messages */
+};
+typedef struct opal_helper_threads_t opal_helper_threads_t;
+
+/**
+ * Initialize a pool. No thread is created until the first
+ * opal_helper_threads_acquire().
+ */
+OPAL_DECLSPEC void opal_helper_threads_init(opal_helper_threads_t *pool, const char *name,
+                                            int output);
+
+/**
+ * Stop the helper threads of a pool and release its resources.
+ */
+OPAL_DECLSPEC void opal_helper_threads_fini(opal_helper_threads_t *pool);
+
+/**
+ * Reserve a pool for a job, starting nthreads helper threads if the pool
+ * is used for the first time.
+ *
+ * @retval >0 the number of helper threads; the pool must be released
+ *         with opal_helper_threads_release()
+ * @retval OPAL_ERR_WOULD_BLOCK the pool is running another job
+ * @retval OPAL_ERR_NOT_SUPPORTED no helper thread could be started
+ */
+OPAL_DECLSPEC int opal_helper_threads_acquire(opal_helper_threads_t *pool, int nthreads);
+
+/**
+ * Process the nitems items of a job with the calling thread and the
+ * helpers of an acquired pool. Returns once all the items are processed
+ * and no helper touches the job anymore.
+ */
+OPAL_DECLSPEC void opal_helper_threads_run(opal_helper_threads_t *pool,
+                                           opal_helper_threads_fn_t fn, void *arg,
+                                           int32_t nitems);
+
+/**
+ * Release a pool reserved with opal_helper_threads_acquire().
+ */
+OPAL_DECLSPEC void opal_helper_threads_release(opal_helper_threads_t *pool);
+
+END_C_DECLS
+
+#endif /* OPAL_HELPER_THREADS_H */
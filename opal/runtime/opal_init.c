@@ -196,6 +196,11 @@ int opal_init(int *pargc, char ***pargv)
         return opal_init_error("opal_init framework open", ret);
     }
 
+    /* select the memcpy used for large copies, before the datatype engine needs it */
+    if (OPAL_SUCCESS != (ret = opal_memcpy_base_select())) {
+        return opal_init_error("opal_memcpy_base_select", ret);
+    }
+
     /* Intitialize Accelerator framework
      * The datatype convertor code has a dependency on the accelerator framework
      * being initialized. */
@@ -80,6 +80,55 @@ int opal_register_params(void)
     }
 #endif
 
+    opal_progress_max_backoff = 0;
+    int ret2;
+    ret2 = mca_base_var_register("opal", "opal", "progress", "max_backoff",
+                                 "Largest number of consecutive calls to opal_progress() for which "
+                                 "an idle progress callback is skipped. Idle callbacks are polled "
+                                 "again as soon as new work is posted (0 = poll every callback on "
+                                 "every call)",
+                                 MCA_BASE_VAR_TYPE_INT, NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE,
+                                 OPAL_INFO_LVL_8, MCA_BASE_VAR_SCOPE_LOCAL,
+                                 &opal_progress_max_backoff);
+    if (0 > ret2) {
+        return ret2;
+    }
+
+    opal_progress_idle_spins = 0;
+    ret2 = mca_base_var_register("opal", "opal", "progress", "idle_spins",
+                                 "Number of consecutive calls to opal_progress() without any event "
+                                 "after which a thread waiting for completion blocks until a message "
+                                 "may have arrived. Requires a component able to block (e.g. "
+                                 "btl_sm_idle_wait, or btl/tcp without progress thread) (0 = never "
+                                 "block)",
+                                 MCA_BASE_VAR_TYPE_INT, NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE,
+                                 OPAL_INFO_LVL_5, MCA_BASE_VAR_SCOPE_LOCAL,
+                                 &opal_progress_idle_spins);
+    if (0 > ret2) {
+        return ret2;
+    }
+
+    opal_progress_idle_timeout = 1000;
+    ret2 = mca_base_var_register("opal", "opal", "progress", "idle_timeout",
+                                 "Longest time in microseconds an idle thread blocks before "
+                                 "polling again (-1 = no limit)",
+                                 MCA_BASE_VAR_TYPE_INT, NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE,
+                                 OPAL_INFO_LVL_5, MCA_BASE_VAR_SCOPE_LOCAL,
+                                 &opal_progress_idle_timeout);
+    if (0 > ret2) {
+        return ret2;
+    }
+
+    opal_progress_timing = false;
+    ret2 = mca_base_var_register("opal", "opal", "progress", "timing",
+                                 "Measure the time spent in each progress callback, reported through "
+                                 "the opal_progress_callback_time performance variable",
+                                 MCA_BASE_VAR_TYPE_BOOL, NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE,
+                                 OPAL_INFO_LVL_8, MCA_BASE_VAR_SCOPE_LOCAL, &opal_progress_timing);
+    if (0 > ret2) {
+        return ret2;
+    }
+
 #if OPAL_ENABLE_DEBUG
     opal_progress_debug = false;
     int ret;
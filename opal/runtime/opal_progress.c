@@ -28,6 +28,7 @@
 #include "opal_config.h"
 
 #include "opal/constants.h"
+#include "opal/mca/base/mca_base_pvar.h"
 #include "opal/mca/base/mca_base_var.h"
 #include "opal/mca/threads/threads.h"
 #include "opal/mca/timer/base/base.h"
@@ -49,21 +50,60 @@ bool opal_progress_debug = false;
  */
 static int opal_progress_event_flag = OPAL_EVLOOP_ONCE | OPAL_EVLOOP_NONBLOCK;
 int opal_progress_spin_count = 10000;
+int opal_progress_max_backoff = 0;
+bool opal_progress_timing = false;
+opal_atomic_uint32_t opal_progress_work_epoch = 0;
+int opal_progress_idle_spins = 0;
+int opal_progress_idle_timeout = 1000;
+opal_atomic_int32_t opal_progress_blocked = 0;
+
+/* consecutive idle calls before a callback starts backing off */
+#define OPAL_PROGRESS_IDLE_THRESHOLD 8
+/* number of callbacks exposed through the performance variables */
+#define OPAL_PROGRESS_PVAR_CALLBACKS 32
+/* maximum number of blocking functions, and the longest time spent in
+ * one of them when several are registered */
+#define OPAL_PROGRESS_MAX_BLOCKERS 4
+#define OPAL_PROGRESS_BLOCK_SLICE 100
 
 /*
  * Local variables
  */
 static opal_atomic_lock_t progress_lock;
 
-/* callbacks to progress */
+/* Adaptive polling state and statistics of a callback */
+typedef struct opal_progress_cb_state_t {
+    uint64_t calls;     /* number of calls */
+    uint64_t events;    /* number of events reported */
+    uint64_t skipped;   /* calls skipped while backing off */
+    uint64_t time;      /* time spent in the callback, in timer ticks */
+    uint32_t idle;      /* consecutive idle calls */
+    uint32_t backoff;   /* calls skipped after each idle one */
+    uint32_t countdown; /* calls left to skip */
+    uint32_t epoch;     /* work epoch seen by the last call */
+} opal_progress_cb_state_t;
+
+/* callbacks to progress, and their state (same index) */
 static volatile opal_progress_callback_t *callbacks = NULL;
+static opal_progress_cb_state_t *callbacks_state = NULL;
 static size_t callbacks_len = 0;
 static size_t callbacks_size = 0;
 
 static volatile opal_progress_callback_t *callbacks_lp = NULL;
+static opal_progress_cb_state_t *callbacks_lp_state = NULL;
 static size_t callbacks_lp_len = 0;
 static size_t callbacks_lp_size = 0;
 
+/* ways to block idle threads. one thread blocks at a time, holding
+ * block_lock */
+static struct {
+    opal_progress_block_fn_t block;
+    opal_progress_wake_fn_t wake;
+} blockers[OPAL_PROGRESS_MAX_BLOCKERS];
+static volatile int num_blockers = 0;
+static unsigned int next_blocker = 0;
+static opal_atomic_lock_t block_lock;
+
 /* do we want to yield() if nothing happened */
 bool opal_progress_yield_when_idle = false;
 
@@ -99,8 +139,11 @@ static int fake_cb(void)
 
 static int _opal_progress_unregister(opal_progress_callback_t cb,
                                      volatile opal_progress_callback_t *callback_array,
+                                     opal_progress_cb_state_t *states,
                                      size_t *callback_array_len);
 
+static void opal_progress_register_pvars(void);
+
 static void opal_progress_finalize(void)
 {
     /* free memory associated with the callbacks */
@@ -109,12 +152,16 @@ static void opal_progress_finalize(void)
     callbacks_len = 0;
     callbacks_size = 0;
     free((void *) callbacks);
+    free(callbacks_state);
     callbacks = NULL;
+    callbacks_state = NULL;
 
     callbacks_lp_len = 0;
     callbacks_lp_size = 0;
     free((void *) callbacks_lp);
+    free(callbacks_lp_state);
     callbacks_lp = NULL;
+    callbacks_lp_state = NULL;
 
     opal_atomic_unlock(&progress_lock);
 }
@@ -124,6 +171,7 @@ int opal_progress_init(void)
 {
     /* reentrant issues */
     opal_atomic_lock_init(&progress_lock, OPAL_ATOMIC_LOCK_UNLOCKED);
+    opal_atomic_lock_init(&block_lock, OPAL_ATOMIC_LOCK_UNLOCKED);
 
     /* set the event tick rate */
     opal_progress_set_event_poll_rate(10000);
@@ -138,12 +186,18 @@ int opal_progress_init(void)
 
     callbacks = malloc(callbacks_size * sizeof(callbacks[0]));
     callbacks_lp = malloc(callbacks_lp_size * sizeof(callbacks_lp[0]));
+    callbacks_state = calloc(callbacks_size, sizeof(callbacks_state[0]));
+    callbacks_lp_state = calloc(callbacks_lp_size, sizeof(callbacks_lp_state[0]));
 
-    if (NULL == callbacks || NULL == callbacks_lp) {
+    if (NULL == callbacks || NULL == callbacks_lp || NULL == callbacks_state
+        || NULL == callbacks_lp_state) {
         free((void *) callbacks);
         free((void *) callbacks_lp);
+        free(callbacks_state);
+        free(callbacks_lp_state);
         callbacks_size = callbacks_lp_size = 0;
         callbacks = callbacks_lp = NULL;
+        callbacks_state = callbacks_lp_state = NULL;
         return OPAL_ERR_OUT_OF_RESOURCE;
     }
 
@@ -163,17 +217,21 @@ int opal_progress_init(void)
     OPAL_OUTPUT(
         (debug_output, "progress: initialized poll rate to: %ld", (long) event_progress_delta));
 
+    opal_progress_register_pvars();
+
     opal_finalize_register_cleanup(opal_progress_finalize);
 
     return OPAL_SUCCESS;
 }
 
+/* only one thread runs the event loop at a time */
+static opal_atomic_int32_t event_loop_lock = 0;
+
 static int opal_progress_events(void)
 {
-    static opal_atomic_int32_t lock = 0;
     int events = 0;
 
-    if (opal_progress_event_flag != 0 && !OPAL_THREAD_SWAP_32(&lock, 1)) {
+    if (opal_progress_event_flag != 0 && !OPAL_THREAD_SWAP_32(&event_loop_lock, 1)) {
 #if OPAL_PROGRESS_USE_TIMERS
 #    if OPAL_PROGRESS_ONLY_USEC_NATIVE
         opal_timer_t now = opal_timer_base_get_usec();
@@ -196,7 +254,112 @@ static int opal_progress_events(void)
             events += opal_event_loop(opal_sync_event_base, opal_progress_event_flag);
         }
 #endif /* OPAL_PROGRESS_USE_TIMERS */
-        lock = 0;
+        event_loop_lock = 0;
+    }
+
+    return events;
+}
+
+static opal_event_t event_block_timer;
+static bool event_block_timer_set = false;
+
+static void opal_progress_event_timeout(int fd, short flags, void *arg)
+{
+    /* only there to bound the time spent in the event loop */
+}
+
+int opal_progress_event_block(int timeout_us)
+{
+    struct timeval tv;
+
+    if (OPAL_THREAD_SWAP_32(&event_loop_lock, 1)) {
+        return OPAL_ERR_RESOURCE_BUSY;
+    }
+
+    if (0 <= timeout_us) {
+        if (!event_block_timer_set) {
+            opal_event_evtimer_set(opal_sync_event_base, &event_block_timer,
+                                   opal_progress_event_timeout, NULL);
+            event_block_timer_set = true;
+        }
+        tv.tv_sec = timeout_us / 1000000;
+        tv.tv_usec = timeout_us % 1000000;
+        opal_event_evtimer_add(&event_block_timer, &tv);
+    }
+
+    (void) opal_event_loop(opal_sync_event_base, OPAL_EVLOOP_ONCE);
+
+    if (0 <= timeout_us) {
+        opal_event_evtimer_del(&event_block_timer);
+    }
+
+    event_loop_lock = 0;
+
+    return OPAL_SUCCESS;
+}
+
+void opal_progress_event_wake(void)
+{
+    opal_event_base_loopbreak(opal_sync_event_base);
+}
+
+static inline opal_timer_t opal_progress_now(void)
+{
+#if OPAL_PROGRESS_ONLY_USEC_NATIVE
+    return opal_timer_base_get_usec();
+#else
+    return opal_timer_base_get_cycles();
+#endif
+}
+
+/*
+ * Call the callbacks, keeping their statistics and skipping those that
+ * have been idle for a while. The skip count of a callback doubles on
+ * every idle call, up to opal_progress_max_backoff, and drops back to
+ * zero as soon as it reports events or new work is posted. The state is
+ * updated without atomics: a race only makes the heuristic slightly
+ * less accurate.
+ */
+static int opal_progress_adaptive(volatile opal_progress_callback_t *cbs,
+                                  opal_progress_cb_state_t *states, size_t len)
+{
+    uint32_t epoch = opal_progress_work_epoch;
+    int events = 0;
+
+    for (size_t i = 0; i < len; ++i) {
+        opal_progress_cb_state_t *state = states + i;
+        int ret;
+
+        if (state->countdown > 0) {
+            if (state->epoch == epoch) {
+                --state->countdown;
+                ++state->skipped;
+                continue;
+            }
+            state->countdown = state->backoff = state->idle = 0;
+        }
+        state->epoch = epoch;
+
+        if (opal_progress_timing) {
+            opal_timer_t start = opal_progress_now();
+            ret = (cbs[i])();
+            state->time += opal_progress_now() - start;
+        } else {
+            ret = (cbs[i])();
+        }
+
+        ++state->calls;
+        events += ret;
+        if (ret > 0) {
+            state->events += ret;
+            state->idle = state->backoff = 0;
+        } else if (opal_progress_max_backoff > 0 && ++state->idle >= OPAL_PROGRESS_IDLE_THRESHOLD) {
+            state->backoff = state->backoff ? 2 * state->backoff : 1;
+            if (state->backoff > (uint32_t) opal_progress_max_backoff) {
+                state->backoff = opal_progress_max_backoff;
+            }
+            state->countdown = state->backoff;
+        }
     }
 
     return events;
@@ -216,12 +379,17 @@ static int opal_progress_events(void)
 int opal_progress(void)
 {
     static uint32_t num_calls = 0;
+    bool adaptive = opal_progress_max_backoff > 0 || opal_progress_timing;
     size_t i;
     int events = 0;
 
     /* progress all registered callbacks */
-    for (i = 0; i < callbacks_len; ++i) {
-        events += (callbacks[i])();
+    if (OPAL_UNLIKELY(adaptive)) {
+        events += opal_progress_adaptive(callbacks, callbacks_state, callbacks_len);
+    } else {
+        for (i = 0; i < callbacks_len; ++i) {
+            events += (callbacks[i])();
+        }
     }
 
     /* Run low priority callbacks and events once every 8 calls to opal_progress().
@@ -231,8 +399,12 @@ int opal_progress(void)
      * it's not a problem.
      */
     if (((num_calls++) & 0x7) == 0) {
-        for (i = 0; i < callbacks_lp_len; ++i) {
-            events += (callbacks_lp[i])();
+        if (OPAL_UNLIKELY(adaptive)) {
+            events += opal_progress_adaptive(callbacks_lp, callbacks_lp_state, callbacks_lp_len);
+        } else {
+            for (i = 0; i < callbacks_lp_len; ++i) {
+                events += (callbacks_lp[i])();
+            }
         }
 
         opal_progress_events();
@@ -366,7 +538,8 @@ static int opal_progress_find_cb(opal_progress_callback_t cb,
 }
 
 static int _opal_progress_register(opal_progress_callback_t cb,
-                                   volatile opal_progress_callback_t **cbs, size_t *cbs_size,
+                                   volatile opal_progress_callback_t **cbs,
+                                   opal_progress_cb_state_t **states, size_t *cbs_size,
                                    size_t *cbs_len)
 {
     int ret = OPAL_SUCCESS;
@@ -378,11 +551,16 @@ static int _opal_progress_register(opal_progress_callback_t cb,
     /* see if we need to allocate more space */
     if (*cbs_len + 1 > *cbs_size) {
         opal_progress_callback_t *tmp, *old;
+        opal_progress_cb_state_t *tmp_states, *old_states;
 
         tmp = (opal_progress_callback_t *) malloc(sizeof(tmp[0]) * 2 * *cbs_size);
-        if (tmp == NULL) {
+        tmp_states = (opal_progress_cb_state_t *) calloc(2 * *cbs_size, sizeof(tmp_states[0]));
+        if (tmp == NULL || tmp_states == NULL) {
+            free(tmp);
+            free(tmp_states);
             return OPAL_ERR_TEMP_OUT_OF_RESOURCE;
         }
+        memcpy(tmp_states, *states, sizeof(tmp_states[0]) * *cbs_size);
 
         if (*cbs) {
             /* copy old callbacks */
@@ -399,12 +577,17 @@ static int _opal_progress_register(opal_progress_callback_t cb,
         old = (opal_progress_callback_t *) opal_atomic_swap_ptr((opal_atomic_intptr_t *) cbs,
                                                                 (intptr_t) tmp);
 
+        old_states = (opal_progress_cb_state_t *) opal_atomic_swap_ptr((opal_atomic_intptr_t *) states,
+                                                                       (intptr_t) tmp_states);
+
         opal_atomic_wmb();
 
         free(old);
+        free(old_states);
         *cbs_size *= 2;
     }
 
+    memset(states[0] + *cbs_len, 0, sizeof(states[0][0]));
     cbs[0][*cbs_len] = cb;
     ++*cbs_len;
 
@@ -419,9 +602,9 @@ int opal_progress_register(opal_progress_callback_t cb)
 
     opal_atomic_lock(&progress_lock);
 
-    (void) _opal_progress_unregister(cb, callbacks_lp, &callbacks_lp_len);
+    (void) _opal_progress_unregister(cb, callbacks_lp, callbacks_lp_state, &callbacks_lp_len);
 
-    ret = _opal_progress_register(cb, &callbacks, &callbacks_size, &callbacks_len);
+    ret = _opal_progress_register(cb, &callbacks, &callbacks_state, &callbacks_size, &callbacks_len);
 
     opal_atomic_unlock(&progress_lock);
 
@@ -434,9 +617,10 @@ int opal_progress_register_lp(opal_progress_callback_t cb)
 
     opal_atomic_lock(&progress_lock);
 
-    (void) _opal_progress_unregister(cb, callbacks, &callbacks_len);
+    (void) _opal_progress_unregister(cb, callbacks, callbacks_state, &callbacks_len);
 
-    ret = _opal_progress_register(cb, &callbacks_lp, &callbacks_lp_size, &callbacks_lp_len);
+    ret = _opal_progress_register(cb, &callbacks_lp, &callbacks_lp_state, &callbacks_lp_size,
+                                  &callbacks_lp_len);
 
     opal_atomic_unlock(&progress_lock);
 
@@ -445,6 +629,7 @@ int opal_progress_register_lp(opal_progress_callback_t cb)
 
 static int _opal_progress_unregister(opal_progress_callback_t cb,
                                      volatile opal_progress_callback_t *callback_array,
+                                     opal_progress_cb_state_t *states,
                                      size_t *callback_array_len)
 {
     int ret = opal_progress_find_cb(cb, callback_array, *callback_array_len);
@@ -461,6 +646,7 @@ static int _opal_progress_unregister(opal_progress_callback_t cb,
          * opal_progress(). */
         (void) opal_atomic_swap_ptr((opal_atomic_intptr_t *) (callback_array + i),
                                     (intptr_t) callback_array[i + 1]);
+        states[i] = states[i + 1];
     }
 
     --*callback_array_len;
@@ -475,15 +661,197 @@ int opal_progress_unregister(opal_progress_callback_t cb)
 
     opal_atomic_lock(&progress_lock);
 
-    ret = _opal_progress_unregister(cb, callbacks, &callbacks_len);
+    ret = _opal_progress_unregister(cb, callbacks, callbacks_state, &callbacks_len);
 
     if (OPAL_SUCCESS != ret) {
         /* if not in the high-priority array try to remove from the lp array.
          * a callback will never be in both. */
-        ret = _opal_progress_unregister(cb, callbacks_lp, &callbacks_lp_len);
+        ret = _opal_progress_unregister(cb, callbacks_lp, callbacks_lp_state, &callbacks_lp_len);
+    }
+
+    opal_atomic_unlock(&progress_lock);
+
+    return ret;
+}
+
+int opal_progress_register_blocker(opal_progress_block_fn_t block, opal_progress_wake_fn_t wake)
+{
+    int ret = OPAL_ERR_OUT_OF_RESOURCE;
+
+    opal_atomic_lock(&progress_lock);
+
+    if (OPAL_PROGRESS_MAX_BLOCKERS > num_blockers) {
+        blockers[num_blockers].block = block;
+        blockers[num_blockers].wake = wake;
+        opal_atomic_wmb();
+        ++num_blockers;
+        ret = OPAL_SUCCESS;
+    }
+
+    opal_atomic_unlock(&progress_lock);
+
+    return ret;
+}
+
+int opal_progress_unregister_blocker(opal_progress_block_fn_t block)
+{
+    int ret = OPAL_ERR_NOT_FOUND;
+
+    opal_atomic_lock(&progress_lock);
+    /* no thread may be blocked in the function, or about to */
+    opal_atomic_lock(&block_lock);
+
+    for (int i = 0; i < num_blockers; ++i) {
+        if (blockers[i].block == block) {
+            for (int j = i; j < num_blockers - 1; ++j) {
+                blockers[j] = blockers[j + 1];
+            }
+            --num_blockers;
+            ret = OPAL_SUCCESS;
+            break;
+        }
     }
 
+    opal_atomic_unlock(&block_lock);
     opal_atomic_unlock(&progress_lock);
 
     return ret;
 }
+
+void opal_progress_block(opal_atomic_int32_t *pending)
+{
+    int timeout = opal_progress_idle_timeout;
+    int n = num_blockers;
+
+    /* the blocking functions can not be entered concurrently (the event
+     * loop in particular); other idle threads keep polling */
+    if (0 == n || opal_atomic_trylock(&block_lock)) {
+        return;
+    }
+
+    /* announce the sleeper before checking the wait one last time. the
+     * waker either sees it, or its update is seen here */
+    (void) opal_atomic_add_fetch_32(&opal_progress_blocked, 1);
+    opal_atomic_mb();
+
+    if (NULL == pending || 0 < *pending) {
+        n = num_blockers;
+        if (1 == n) {
+            (void) blockers[0].block(timeout);
+        } else if (1 < n) {
+            /* only one of them can be waited on: take turns, and bound the
+             * time the others are not watched */
+            if (0 > timeout || OPAL_PROGRESS_BLOCK_SLICE < timeout) {
+                timeout = OPAL_PROGRESS_BLOCK_SLICE;
+            }
+            (void) blockers[next_blocker++ % n].block(timeout);
+        }
+    }
+
+    (void) opal_atomic_add_fetch_32(&opal_progress_blocked, -1);
+    opal_atomic_unlock(&block_lock);
+}
+
+void opal_progress_wake_blocked(void)
+{
+    for (int i = 0; i < num_blockers; ++i) {
+        if (NULL != blockers[i].wake) {
+            blockers[i].wake();
+        }
+    }
+}
+
+/*
+ * Performance variables: one value per callback, the high priority
+ * callbacks first, in registration order, then the low priority ones.
+ */
+enum {
+    OPAL_PROGRESS_PVAR_CALLS,
+    OPAL_PROGRESS_PVAR_EVENTS,
+    OPAL_PROGRESS_PVAR_SKIPPED,
+    OPAL_PROGRESS_PVAR_TIME,
+};
+
+static int opal_progress_pvar_notify(mca_base_pvar_t *pvar, mca_base_pvar_event_t event,
+                                     void *obj_handle, int *count)
+{
+    if (MCA_BASE_PVAR_HANDLE_BIND == event) {
+        *count = OPAL_PROGRESS_PVAR_CALLBACKS;
+    }
+
+    return OPAL_SUCCESS;
+}
+
+static int opal_progress_pvar_read(const mca_base_pvar_t *pvar, void *value, void *obj_handle)
+{
+    int which = (int) (uintptr_t) pvar->ctx;
+    size_t len = callbacks_len + callbacks_lp_len;
+
+    for (size_t i = 0; i < OPAL_PROGRESS_PVAR_CALLBACKS; ++i) {
+        const opal_progress_cb_state_t *state = NULL;
+        uint64_t v = 0;
+
+        if (i < len) {
+            state = (i < callbacks_len) ? callbacks_state + i : callbacks_lp_state + i - callbacks_len;
+        }
+
+        if (OPAL_PROGRESS_PVAR_TIME == which) {
+            double usec = 0.0;
+            if (NULL != state) {
+#if OPAL_PROGRESS_ONLY_USEC_NATIVE
+                usec = (double) state->time;
+#else
+                usec = (double) state->time * 1000000.0 / (double) opal_timer_base_get_freq();
+#endif
+            }
+            ((double *) value)[i] = usec;
+            continue;
+        }
+
+        if (NULL != state) {
+            v = (OPAL_PROGRESS_PVAR_CALLS == which) ? state->calls :
+                (OPAL_PROGRESS_PVAR_EVENTS == which) ? state->events : state->skipped;
+        }
+        ((unsigned long long *) value)[i] = v;
+    }
+
+    return OPAL_SUCCESS;
+}
+
+static void opal_progress_register_pvars(void)
+{
+    (void) mca_base_pvar_register("opal", "opal", "progress", "callback_calls",
+                                  "Number of calls to each progress callback (only counted with "
+                                  "opal_progress_max_backoff or opal_progress_timing set)",
+                                  OPAL_INFO_LVL_5, MCA_BASE_PVAR_CLASS_COUNTER,
+                                  MCA_BASE_VAR_TYPE_UNSIGNED_LONG_LONG, NULL,
+                                  MCA_BASE_VAR_BIND_NO_OBJECT,
+                                  MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                  opal_progress_pvar_read, NULL, opal_progress_pvar_notify,
+                                  (void *) (uintptr_t) OPAL_PROGRESS_PVAR_CALLS);
+    (void) mca_base_pvar_register("opal", "opal", "progress", "callback_events",
+                                  "Number of events reported by each progress callback (only counted "
+                                  "with opal_progress_max_backoff or opal_progress_timing set)",
+                                  OPAL_INFO_LVL_5, MCA_BASE_PVAR_CLASS_COUNTER,
+                                  MCA_BASE_VAR_TYPE_UNSIGNED_LONG_LONG, NULL,
+                                  MCA_BASE_VAR_BIND_NO_OBJECT,
+                                  MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                  opal_progress_pvar_read, NULL, opal_progress_pvar_notify,
+                                  (void *) (uintptr_t) OPAL_PROGRESS_PVAR_EVENTS);
+    (void) mca_base_pvar_register("opal", "opal", "progress", "callback_skipped",
+                                  "Number of calls skipped by each idle progress callback backing off",
+                                  OPAL_INFO_LVL_5, MCA_BASE_PVAR_CLASS_COUNTER,
+                                  MCA_BASE_VAR_TYPE_UNSIGNED_LONG_LONG, NULL,
+                                  MCA_BASE_VAR_BIND_NO_OBJECT,
+                                  MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                  opal_progress_pvar_read, NULL, opal_progress_pvar_notify,
+                                  (void *) (uintptr_t) OPAL_PROGRESS_PVAR_SKIPPED);
+    (void) mca_base_pvar_register("opal", "opal", "progress", "callback_time",
+                                  "Time spent in each progress callback, in microseconds (only "
+                                  "measured with opal_progress_timing set)",
+                                  OPAL_INFO_LVL_5, MCA_BASE_PVAR_CLASS_TIMER,
+                                  MCA_BASE_VAR_TYPE_DOUBLE, NULL, MCA_BASE_VAR_BIND_NO_OBJECT,
+                                  MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                  opal_progress_pvar_read, NULL, opal_progress_pvar_notify,
+                                  (void *) (uintptr_t) OPAL_PROGRESS_PVAR_TIME);
+}
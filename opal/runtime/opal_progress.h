@@ -169,6 +169,54 @@ OPAL_DECLSPEC int opal_progress_register_lp(opal_progress_callback_t cb);
  */
 OPAL_DECLSPEC int opal_progress_unregister(opal_progress_callback_t cb);
 
+/**
+ * Blocking function typedef
+ *
+ * Blocks the calling thread until a message may have arrived on the
+ * component that registered it, for at most timeout_us microseconds.
+ * Spurious returns are allowed. Returns an error if blocking is not
+ * possible at this time.
+ */
+typedef int (*opal_progress_block_fn_t)(int timeout_us);
+
+/**
+ * Wake-up function typedef
+ *
+ * Interrupts the corresponding opal_progress_block_fn_t, if a thread
+ * is blocked in it.
+ */
+typedef void (*opal_progress_wake_fn_t)(void);
+
+/**
+ * Register a way for idle waiting threads to block
+ *
+ * Components able to block until messages arrive (e.g. on a futex or a
+ * file descriptor) register it here. Waiting threads only block after
+ * opal_progress_idle_spins consecutive idle calls to opal_progress().
+ */
+OPAL_DECLSPEC int opal_progress_register_blocker(opal_progress_block_fn_t block,
+                                                 opal_progress_wake_fn_t wake);
+
+OPAL_DECLSPEC int opal_progress_unregister_blocker(opal_progress_block_fn_t block);
+
+/**
+ * Block until a message may have arrived, or until the timeout
+ * (opal_progress_idle_timeout) expires. Does not block if *pending is
+ * zero once the thread announced it is about to block, so that
+ * opal_progress_wake() cannot be missed.
+ */
+OPAL_DECLSPEC void opal_progress_block(opal_atomic_int32_t *pending);
+
+OPAL_DECLSPEC void opal_progress_wake_blocked(void);
+
+/**
+ * Blocking and wake-up functions for the OPAL event library, for
+ * components driven by file descriptors in opal_sync_event_base
+ */
+OPAL_DECLSPEC int opal_progress_event_block(int timeout_us);
+
+OPAL_DECLSPEC void opal_progress_event_wake(void);
+
 #if OPAL_ENABLE_DEBUG
 OPAL_DECLSPEC extern bool opal_progress_debug;
 #endif
@@ -178,6 +226,70 @@ OPAL_DECLSPEC extern int opal_progress_spin_count;
 /* do we want to call sched_yield() if nothing happened */
 OPAL_DECLSPEC extern bool opal_progress_yield_when_idle;
 
+/* largest number of consecutive calls an idle callback is skipped (0
+ * polls every callback on every call) */
+OPAL_DECLSPEC extern int opal_progress_max_backoff;
+
+/* measure the time spent in each callback */
+OPAL_DECLSPEC extern bool opal_progress_timing;
+
+OPAL_DECLSPEC extern opal_atomic_uint32_t opal_progress_work_epoch;
+
+/* idle calls to opal_progress() before a waiting thread blocks (0 never
+ * blocks), and longest time it blocks, in microseconds */
+OPAL_DECLSPEC extern int opal_progress_idle_spins;
+OPAL_DECLSPEC extern int opal_progress_idle_timeout;
+
+/* number of threads in opal_progress_block() */
+OPAL_DECLSPEC extern opal_atomic_int32_t opal_progress_blocked;
+
+/**
+ * Account for an opal_progress() call made while waiting
+ *
+ * @param events (IN)   Value returned by opal_progress()
+ * @param idle (INOUT)  Consecutive idle calls, 0 when the wait starts
+ * @param pending (IN)  Non-zero while the wait is not satisfied, or NULL
+ *
+ * Blocks the calling thread once it made opal_progress_idle_spins
+ * consecutive calls without events.
+ */
+static inline void opal_progress_idle(int events, int *idle, opal_atomic_int32_t *pending)
+{
+    if (OPAL_LIKELY(0 == opal_progress_idle_spins)) {
+        return;
+    }
+    if (events > 0) {
+        *idle = 0;
+    } else if (++*idle >= opal_progress_idle_spins) {
+        *idle = 0;
+        opal_progress_block(pending);
+    }
+}
+
+/**
+ * Wake up the threads blocked in opal_progress_block(), if any. Called
+ * when a wait may be satisfied by something else than a message.
+ */
+static inline void opal_progress_wake(void)
+{
+    if (OPAL_UNLIKELY(0 != opal_progress_blocked)) {
+        opal_progress_wake_blocked();
+    }
+}
+
+/**
+ * Note that new work was posted
+ *
+ * Callbacks backing off because they have been idle are polled again
+ * on the next call to opal_progress().
+ */
+static inline void opal_progress_work_posted(void)
+{
+    if (OPAL_UNLIKELY(opal_progress_max_backoff > 0)) {
+        ++opal_progress_work_epoch;
+    }
+}
+
 /**
  * Progress until flag is true or poll iterations completed
  */
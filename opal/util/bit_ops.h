@@ -158,4 +158,28 @@ static inline int opal_next_poweroftwo_inclusive(int value)
     return power2;
 }
 
+/**
+ * Returns the position of the lowest set bit of a 64-bit value
+ *
+ * @param value The value to examine (must not be 0)
+ *
+ * @returns pos Position of the lowest set bit
+ *
+ * WARNING: *NO* error checking is performed.  This is meant to be a
+ * fast inline function.
+ */
+static inline int opal_lobit64(uint64_t value)
+{
+    int pos;
+
+#if OPAL_C_HAVE_BUILTIN_CLZ
+    pos = __builtin_ctzll(value);
+#else
+    for (pos = 0; !(value & 1); ++pos, value >>= 1) /* empty */
+        ;
+#endif
+
+    return pos;
+}
+
 #endif /* OPAL_BIT_OPS_H */
@@ -21,7 +21,7 @@ verbose=0
 
 echo "=========Signed Integer type all operations & all sizes========"
 echo ""
-for op in max min sum prod band bor bxor; do
+for op in max min sum prod band bor bxor land lor lxor; do
     echo -e "\n===Operation  $op test==="
     for type_size in 8 16 32 64; do
         for size in 0 1 7 15 31 63 127 130; do
@@ -40,7 +40,7 @@ echo -e "\n\n"
 
 echo "=========Unsigned Integer type all operations & all sizes========"
 echo ""
-for op in max min sum prod band bor bxor; do
+for op in max min sum prod band bor bxor land lor lxor; do
     echo -e "\n===Operation  $op test==="
     for type_size in 8 16 32 64; do
         for size in 0 1 7 15 31 63 127 130; do
@@ -79,3 +79,64 @@ for op in max min sum prod; do
     done
 done
 
+
+echo "========MAXLOC/MINLOC on MPI_2INT, MPI_FLOAT_INT and MPI_DOUBLE_INT========="
+echo ""
+for op in maxloc minloc; do
+    for type in "i -s 32" "f" "d"; do
+        for size in 0 1 7 15; do
+            foo=$((1024 * 1024 + $size))
+            for align in "" "-1 1 -2 3"; do
+                echo -e "Test $Yellow pair type $type $align $NC Total_num_elements = $foo"
+                cmd="$mpirun -n 1 reduce_local -l $foo -u $foo -t $type -o $op $align"
+                if test $verbose -eq 1 ; then echo $cmd; fi
+                eval $cmd
+            done
+        done
+        # small counts, below and around the vector width
+        cmd="$mpirun -n 1 reduce_local -l 1 -u 64 -i 8 -t $type -o $op"
+        if test $verbose -eq 1 ; then echo $cmd; fi
+        eval $cmd
+    done
+done
+
+echo "========MPIX_BFLOAT16 and 2-byte short float all operations========="
+echo ""
+for op in max min sum prod; do
+    for type in "b" "f -s 16"; do
+        for size in 0 1 7 15; do
+            foo=$((1024 * 1024 + $size))
+            for align in "" "-1 1 -2 3"; do
+                echo -e "Test $Yellow half precision type $type $align $NC Total_num_elements = $foo"
+                cmd="$mpirun -n 1 reduce_local -l $foo -u $foo -t $type -o $op $align"
+                if test $verbose -eq 1 ; then echo $cmd; fi
+                eval $cmd
+            done
+        done
+        # small counts, below and around the vector width
+        cmd="$mpirun -n 1 reduce_local -l 1 -u 64 -i 8 -t $type -o $op"
+        if test $verbose -eq 1 ; then echo $cmd; fi
+        eval $cmd
+    done
+done
+
+echo "========Reductions split across the op/base helper threads========="
+echo ""
+# The minimum size is lowered so that all the counts below are split in
+# several chunks; reduce_local checks each chunk against the serial result.
+threads="--mca op_base_reduce_threads 3 --mca op_base_reduce_threads_min_size 65536"
+for type in "i -s 8" "i -s 32" "u -s 16" "u -s 64" "f -s 32" "d -s 64"; do
+    case "$type" in
+        i*|u*) ops="sum max band lxor" ;;
+        *) ops="sum max" ;;
+    esac
+    for op in $ops; do
+        for size in 0 1 130; do
+            foo=$((4 * 1024 * 1024 + $size))
+            echo -e "Test $Yellow helper threads $type $NC Total_num_elements = $foo"
+            cmd="$mpirun $threads -n 1 reduce_local -l $foo -u $foo -t $type -o $op -1 1 -2 3"
+            if test $verbose -eq 1 ; then echo $cmd; fi
+            eval $cmd
+        done
+    done
+done
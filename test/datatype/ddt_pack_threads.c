@@ -0,0 +1,223 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+#include "ompi/datatype/ompi_datatype.h"
+#include "opal/datatype/opal_convertor.h"
+#include "opal/mca/base/mca_base_var.h"
+#include "opal/runtime/opal.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Compare the packs and unpacks split across the datatype helper threads
+ * (mpi_ddt_pack_threads) with serial ones, for large non-contiguous
+ * datatypes. The threaded conversions are done in a single call, and in a
+ * call following a small one that leaves a basic element incomplete in the
+ * convertor (partial_length != 0).
+ */
+
+#define NB_THREADS   3
+#define MIN_SIZE     (1024 * 1024)
+#define FIRST_CHUNK  13
+#define USER_PATTERN 0xa5
+
+static int threads_var = -1, strided_var = -1;
+
+static void set_threads(int value)
+{
+    mca_base_var_set_value(threads_var, &value, sizeof(value), MCA_BASE_VAR_SOURCE_SET, NULL);
+}
+
+static void set_strided(bool value)
+{
+    mca_base_var_set_value(strided_var, &value, sizeof(value), MCA_BASE_VAR_SOURCE_SET, NULL);
+}
+
+/**
+ * Pack (send) or unpack count datatypes between user and packed, first
+ * first bytes and then the rest in a single call. Returns the number of
+ * bytes converted. partial is set to the partial_length of the convertor
+ * after the first call.
+ */
+static size_t convert(ompi_datatype_t *dtype, int count, char *user, char *packed, bool send,
+                      size_t first, size_t *partial)
+{
+    opal_convertor_t *convertor;
+    size_t max_data, length = 0, size;
+    struct iovec iov;
+    uint32_t iov_count;
+
+    convertor = opal_convertor_create(opal_local_arch, 0);
+    if (send) {
+        opal_convertor_prepare_for_send(convertor, &dtype->super, count, user);
+    } else {
+        opal_convertor_prepare_for_recv(convertor, &dtype->super, count, user);
+    }
+    opal_convertor_get_packed_size(convertor, &size);
+
+    *partial = 0;
+    if (0 != first) {
+        iov.iov_base = packed;
+        iov.iov_len = first;
+        iov_count = 1;
+        max_data = first;
+        if (send) {
+            opal_convertor_pack(convertor, &iov, &iov_count, &max_data);
+        } else {
+            opal_convertor_unpack(convertor, &iov, &iov_count, &max_data);
+        }
+        length = max_data;
+        *partial = convertor->partial_length;
+    }
+
+    iov.iov_base = packed + length;
+    iov.iov_len = size - length;
+    iov_count = 1;
+    max_data = iov.iov_len;
+    if (send) {
+        opal_convertor_pack(convertor, &iov, &iov_count, &max_data);
+    } else {
+        opal_convertor_unpack(convertor, &iov, &iov_count, &max_data);
+    }
+    length += max_data;
+
+    OBJ_RELEASE(convertor);
+    return length;
+}
+
+static int test_datatype(const char *name, ompi_datatype_t *dtype, int count, bool strided)
+{
+    ptrdiff_t lb, extent, true_lb, true_extent;
+    char *src, *dst, *dst_ref, *packed, *packed_ref;
+    size_t size, length, done, partial;
+    int errors = 0;
+
+    ompi_datatype_commit(&dtype);
+    ompi_datatype_type_size(dtype, &size);
+    size *= count;
+    ompi_datatype_get_extent(dtype, &lb, &extent);
+    ompi_datatype_get_true_extent(dtype, &true_lb, &true_extent);
+    length = (count - 1) * extent + true_extent;
+
+    printf("%s%s: count %d size %" PRIsize_t "\n", name, strided ? " (strided)" : "", count,
+           size);
+
+    src = (char *) malloc(length);
+    dst = (char *) malloc(length);
+    dst_ref = (char *) malloc(length);
+    packed = (char *) malloc(size);
+    packed_ref = (char *) malloc(size);
+    for (size_t i = 0; i < length; i++) {
+        src[i] = (char) (i * 7 + 1);
+    }
+
+    set_strided(strided);
+
+    /* reference: a serial conversion */
+    set_threads(0);
+    convert(dtype, count, src - true_lb, packed_ref, true, 0, &partial);
+    memset(dst_ref, USER_PATTERN, length);
+    convert(dtype, count, dst_ref - true_lb, packed_ref, false, 0, &partial);
+
+    set_threads(NB_THREADS);
+    for (size_t first = 0; first <= FIRST_CHUNK; first += FIRST_CHUNK) {
+        memset(packed, 0, size);
+        done = convert(dtype, count, src - true_lb, packed, true, first, &partial);
+        if (done != size) {
+            printf("  pack (first %" PRIsize_t ") stopped at %" PRIsize_t "\n", first, done);
+            errors++;
+        }
+        if ((0 != first) && !strided && (0 == partial)) {
+            printf("  pack: no partial element after %" PRIsize_t " bytes\n", first);
+            errors++;
+        }
+        if (0 != memcmp(packed, packed_ref, size)) {
+            printf("  pack (first %" PRIsize_t ") differs from the serial pack\n", first);
+            errors++;
+        }
+
+        memset(dst, USER_PATTERN, length);
+        done = convert(dtype, count, dst - true_lb, packed_ref, false, first, &partial);
+        if (done != size) {
+            printf("  unpack (first %" PRIsize_t ") stopped at %" PRIsize_t "\n", first, done);
+            errors++;
+        }
+        if ((0 != first) && !strided && (0 == partial)) {
+            printf("  unpack: no partial element after %" PRIsize_t " bytes\n", first);
+            errors++;
+        }
+        if (0 != memcmp(dst, dst_ref, length)) {
+            printf("  unpack (first %" PRIsize_t ") differs from the serial unpack\n", first);
+            errors++;
+        }
+    }
+
+    free(src);
+    free(dst);
+    free(dst_ref);
+    free(packed);
+    free(packed_ref);
+    return errors;
+}
+
+int main(int argc, char *argv[])
+{
+    ompi_datatype_t *dtype, *base, *types[3];
+    ptrdiff_t disps[3];
+    int blens[3], errors = 0;
+    size_t min_size = MIN_SIZE;
+
+    opal_init(NULL, NULL);
+    ompi_datatype_init();
+
+    threads_var = mca_base_var_find("opal", "mpi", NULL, "ddt_pack_threads");
+    strided_var = mca_base_var_find("opal", "mpi", NULL, "ddt_strided");
+    if ((0 > threads_var) || (0 > strided_var)) {
+        printf("mpi_ddt_pack_threads or mpi_ddt_strided is not registered\n");
+        return 1;
+    }
+    mca_base_var_set_value(mca_base_var_find("opal", "mpi", NULL, "ddt_pack_threads_min_size"),
+                           &min_size, sizeof(min_size), MCA_BASE_VAR_SOURCE_SET, NULL);
+
+    /* about 8MB of packed data for each datatype */
+    ompi_datatype_create_vector(350000, 3, 5, MPI_DOUBLE, &dtype);
+    errors += test_datatype("vector of 3 double", dtype, 1, false);
+    errors += test_datatype("vector of 3 double", dtype, 1, true);
+    ompi_datatype_destroy(&dtype);
+
+    blens[0] = 1;
+    blens[1] = 2;
+    blens[2] = 3;
+    disps[0] = 0;
+    disps[1] = 8;
+    disps[2] = 28;
+    types[0] = MPI_INT;
+    types[1] = MPI_DOUBLE;
+    types[2] = MPI_SHORT;
+    ompi_datatype_create_struct(3, blens, disps, types, &base);
+    ompi_datatype_create_vector(1000, 1, 2, base, &dtype);
+    errors += test_datatype("vector of struct int, 2 double, 3 short", dtype, 300, false);
+    ompi_datatype_destroy(&dtype);
+    ompi_datatype_destroy(&base);
+
+    /* clean-ups all data allocations */
+    opal_finalize_util();
+
+    if (0 != errors) {
+        printf("%d errors\n", errors);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,316 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+#include "ddt_lib.h"
+#include "ompi/datatype/ompi_datatype.h"
+#include "opal/datatype/opal_convertor.h"
+#include "opal/mca/base/mca_base_var.h"
+#include "opal/runtime/opal.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Compare the iovecs built by opal_convertor_raw from the template cached on
+ * the datatype (mpi_ddt_raw_cache_max_segments) with the ones built from the
+ * description. The iovecs are collected a few at a time, so that the
+ * conversion is split over many calls, and from positions set with
+ * opal_convertor_set_position on a new convertor, or on one that already
+ * went through opal_convertor_raw. Both are checked against the iovecs of a
+ * single uncached conversion, after merging the adjacent entries.
+ */
+
+static int cache_var = -1;
+static size_t default_max_segments;
+
+static const uint32_t iov_nums[] = {1, 2, 3, 5, 7, 256};
+#define NB_IOV_NUMS (sizeof(iov_nums) / sizeof(iov_nums[0]))
+#define MAX_IOV_NUM 256
+
+/* iovecs of the call done before moving the convertor, 0 for a new one */
+static const uint32_t firsts[] = {0, 1, 3};
+#define NB_FIRSTS (sizeof(firsts) / sizeof(firsts[0]))
+
+typedef struct {
+    struct iovec *iov;
+    size_t count;
+} iov_list_t;
+
+static void set_max_segments(size_t value)
+{
+    mca_base_var_set_value(cache_var, &value, sizeof(value), MCA_BASE_VAR_SOURCE_SET, NULL);
+}
+
+static void iov_list_append(iov_list_t *list, const struct iovec *iov)
+{
+    if (0 != list->count) {
+        struct iovec *last = list->iov + list->count - 1;
+
+        if (((char *) last->iov_base + last->iov_len) == iov->iov_base) {
+            last->iov_len += iov->iov_len;
+            return;
+        }
+    }
+    list->iov[list->count++] = *iov;
+}
+
+/**
+ * Collect in list the iovecs of count datatypes, iov_num at a time. If first
+ * is not 0, a call with first iovecs is done before moving the convertor to
+ * position. Returns the number of errors; start is set to the position the
+ * convertor was moved to, and stackless tells if the cached iovecs were used.
+ */
+static int collect(ompi_datatype_t *dtype, int count, char *buf, uint32_t iov_num,
+                   uint32_t first, size_t position, iov_list_t *list, size_t *start,
+                   bool *stackless)
+{
+    struct iovec iov[MAX_IOV_NUM];
+    opal_convertor_t *convertor;
+    size_t length, total, sum;
+    uint32_t iov_count;
+    int done = 0, errors = 0;
+
+    convertor = opal_convertor_create(opal_local_arch, 0);
+    opal_convertor_prepare_for_send(convertor, &dtype->super, count, buf);
+    opal_convertor_get_packed_size(convertor, &total);
+
+    if (0 != first) {
+        iov_count = first;
+        done = opal_convertor_raw(convertor, iov, &iov_count, &length);
+    }
+    *start = position;
+    if ((0 != first) || (0 != position)) {
+        opal_convertor_set_position(convertor, start);
+        done = 0;
+    }
+
+    list->count = 0;
+    for (length = *start; !done;) {
+        iov_count = iov_num;
+        done = opal_convertor_raw(convertor, iov, &iov_count, &sum);
+        if ((iov_count > iov_num) || ((0 == iov_count) && !done)) {
+            printf("  %" PRIu32 " iovecs returned for %" PRIu32 "\n", iov_count, iov_num);
+            errors++;
+            break;
+        }
+        for (uint32_t i = 0; i < iov_count; i++) {
+            iov_list_append(list, &iov[i]);
+            length += iov[i].iov_len;
+            sum -= iov[i].iov_len;
+        }
+        if (0 != sum) {
+            printf("  the length does not match the iovecs\n");
+            errors++;
+        }
+    }
+    if (length != total) {
+        printf("  stopped at %" PRIsize_t " instead of %" PRIsize_t "\n", length, total);
+        errors++;
+    }
+    *stackless = (0 != (convertor->flags & CONVERTOR_STACKLESS));
+    OBJ_RELEASE(convertor);
+    return errors;
+}
+
+/* compare list with the part of ref starting at position bytes */
+static int compare(const char *what, const iov_list_t *ref, const iov_list_t *list,
+                   size_t position, uint32_t iov_num, uint32_t first)
+{
+    struct iovec expected;
+    size_t i = 0, j = 0;
+
+    while ((i < ref->count) && (position >= ref->iov[i].iov_len)) {
+        position -= ref->iov[i++].iov_len;
+    }
+    for (; i < ref->count; i++, j++, position = 0) {
+        expected.iov_base = (char *) ref->iov[i].iov_base + position;
+        expected.iov_len = ref->iov[i].iov_len - position;
+        if ((j == list->count) || (expected.iov_base != list->iov[j].iov_base)
+            || (expected.iov_len != list->iov[j].iov_len)) {
+            break;
+        }
+    }
+    if ((i == ref->count) && (j == list->count)) {
+        return 0;
+    }
+    printf("  %s (%" PRIu32 " iovecs, first %" PRIu32 "): iovec %" PRIsize_t " differs\n", what,
+           iov_num, first, j);
+    return 1;
+}
+
+static int test_datatype(const char *name, ompi_datatype_t *dtype, int count)
+{
+    ptrdiff_t lb, extent, true_lb, true_extent;
+    size_t size, length, start, positions[6];
+    iov_list_t ref, list;
+    bool stackless;
+    int errors = 0;
+    char *buf;
+
+    ompi_datatype_commit(&dtype);
+    ompi_datatype_type_size(dtype, &size);
+    size *= count;
+    ompi_datatype_get_extent(dtype, &lb, &extent);
+    ompi_datatype_get_true_extent(dtype, &true_lb, &true_extent);
+    length = (count - 1) * extent + true_extent;
+
+    printf("%s: count %d size %" PRIsize_t "\n", name, count, size);
+
+    buf = (char *) malloc(length);
+    ref.iov = (struct iovec *) malloc(size * sizeof(struct iovec));
+    list.iov = (struct iovec *) malloc(size * sizeof(struct iovec));
+
+    /* positions inside the basic elements are moved back to their beginning */
+    positions[0] = 1;
+    positions[1] = 5;
+    positions[2] = size / 3;
+    positions[3] = size / 2 + 3;
+    positions[4] = size - 9;
+    positions[5] = size - 1;
+
+    /* reference: a single conversion from the description */
+    set_max_segments(0);
+    errors += collect(dtype, count, buf - true_lb, MAX_IOV_NUM, 0, 0, &ref, &start, &stackless);
+
+    for (int cached = 0; cached < 2; cached++) {
+        const char *what = cached ? "cached" : "uncached";
+
+        set_max_segments(cached ? default_max_segments : 0);
+        for (size_t n = 0; n < NB_IOV_NUMS; n++) {
+            errors += collect(dtype, count, buf - true_lb, iov_nums[n], 0, 0, &list, &start,
+                              &stackless);
+            errors += compare(what, &ref, &list, 0, iov_nums[n], 0);
+            if (stackless != cached) {
+                printf("  %s (%" PRIu32 " iovecs): the template was %sused\n", what, iov_nums[n],
+                       stackless ? "" : "not ");
+                errors++;
+            }
+
+            for (size_t p = 0; p < sizeof(positions) / sizeof(positions[0]); p++) {
+                if (positions[p] >= size) {
+                    continue;
+                }
+                /* from a new convertor, and after a first call that stops
+                 * either before or after the position */
+                for (size_t f = 0; f < NB_FIRSTS; f++) {
+                    errors += collect(dtype, count, buf - true_lb, iov_nums[n], firsts[f],
+                                      positions[p], &list, &start, &stackless);
+                    if (start > positions[p]) {
+                        printf("  %s: set_position(%" PRIsize_t ") moved to %" PRIsize_t "\n",
+                               what, positions[p], start);
+                        errors++;
+                        continue;
+                    }
+                    errors += compare(what, &ref, &list, start, iov_nums[n], firsts[f]);
+                }
+            }
+        }
+    }
+
+    free(buf);
+    free(ref.iov);
+    free(list.iov);
+    return errors;
+}
+
+int main(int argc, char *argv[])
+{
+    ompi_datatype_t *dtype, *dup, *base, *types[3];
+    const size_t *max_segments;
+    ptrdiff_t disps[3];
+    int blens[3], errors = 0;
+    size_t few = 4;
+    bool stackless;
+    iov_list_t list;
+    size_t start;
+    char *buf;
+
+    opal_init(NULL, NULL);
+    ompi_datatype_init();
+
+    cache_var = mca_base_var_find("opal", "mpi", NULL, "ddt_raw_cache_max_segments");
+    if (0 > cache_var) {
+        printf("mpi_ddt_raw_cache_max_segments is not registered\n");
+        return 1;
+    }
+    mca_base_var_get_value(cache_var, &max_segments, NULL, NULL);
+    default_max_segments = *max_segments;
+    if (0 == default_max_segments) {
+        default_max_segments = 4096;
+    }
+
+    ompi_datatype_create_vector(10, 3, 5, MPI_INT, &dtype);
+    errors += test_datatype("vector of 3 int", dtype, 1);
+    errors += test_datatype("vector of 3 int", dtype, 7);
+    ompi_datatype_destroy(&dtype);
+
+    blens[0] = 1;
+    blens[1] = 2;
+    blens[2] = 3;
+    disps[0] = 0;
+    disps[1] = 8;
+    disps[2] = 28;
+    types[0] = MPI_INT;
+    types[1] = MPI_DOUBLE;
+    types[2] = MPI_SHORT;
+    ompi_datatype_create_struct(3, blens, disps, types, &base);
+    errors += test_datatype("struct int, 2 double, 3 short", base, 5);
+    ompi_datatype_create_vector(100, 1, 2, base, &dtype);
+    errors += test_datatype("vector of struct int, 2 double, 3 short", dtype, 3);
+    ompi_datatype_destroy(&dtype);
+
+    /* a negative lower bound */
+    ompi_datatype_create_resized(base, -16, 48, &dtype);
+    errors += test_datatype("resized struct", dtype, 4);
+    ompi_datatype_destroy(&dtype);
+    ompi_datatype_destroy(&base);
+
+    dtype = upper_matrix(50);
+    errors += test_datatype("upper matrix", dtype, 2);
+
+    /* the duplicate does not share the template of the original */
+    ompi_datatype_duplicate(dtype, &dup);
+    ompi_datatype_destroy(&dtype);
+    errors += test_datatype("duplicated upper matrix", dup, 1);
+    ompi_datatype_destroy(&dup);
+
+    dtype = create_strange_dt();
+    errors += test_datatype("strange datatype", dtype, 3);
+    ompi_datatype_destroy(&dtype);
+
+    /* more segments than allowed: the description is used */
+    set_max_segments(few);
+    ompi_datatype_create_vector(10, 3, 5, MPI_INT, &dtype);
+    ompi_datatype_commit(&dtype);
+    buf = (char *) malloc(50 * sizeof(int));
+    list.iov = (struct iovec *) malloc(10 * sizeof(struct iovec));
+    errors += collect(dtype, 1, buf, 3, 0, 0, &list, &start, &stackless);
+    if (stackless || (10 != list.count)) {
+        printf("vector of 10 segments with at most %" PRIsize_t " cached: %" PRIsize_t
+               " iovecs%s\n", few, list.count, stackless ? ", cached" : "");
+        errors++;
+    }
+    free(buf);
+    free(list.iov);
+    ompi_datatype_destroy(&dtype);
+
+    /* clean-ups all data allocations */
+    opal_finalize_util();
+
+    if (0 != errors) {
+        printf("%d errors\n", errors);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,431 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+#include "ompi/datatype/ompi_datatype.h"
+#include "opal/datatype/opal_convertor.h"
+#include "opal/mca/base/mca_base_var.h"
+#include "opal/runtime/opal.h"
+#include "opal/util/arch.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Compare the pack and unpack functions specialized for strided datatypes
+ * (mpi_ddt_strided) with the generic ones. Each datatype is converted in
+ * fragments of various sizes, split over two iovecs, so that the basic
+ * elements are cut between two calls, and from positions set with
+ * opal_convertor_set_position. The heterogeneous and checksum convertors
+ * do not use the strided functions and must give the same results whatever
+ * the value of the parameter.
+ */
+
+static int strided_var = -1;
+
+static const size_t fragment_sizes[] = {1, 3, 7, 8, 13, 64, 113, 1000, 4096};
+#define NB_FRAGMENT_SIZES (sizeof(fragment_sizes) / sizeof(fragment_sizes[0]))
+
+#define USER_PATTERN 0xa5
+
+static void set_strided(bool value)
+{
+    mca_base_var_set_value(strided_var, &value, sizeof(value), MCA_BASE_VAR_SOURCE_SET, NULL);
+}
+
+/**
+ * Pack (send) or unpack count datatypes between user and packed, starting at
+ * position, fragment bytes at a time. Returns the position reached, or 0 if
+ * the convertor could not be moved to the requested position. stackless is
+ * set when the strided functions were selected.
+ */
+static size_t convert(ompi_datatype_t *dtype, int count, char *user, char *packed, uint32_t arch,
+                      uint32_t flags, bool send, size_t position, size_t fragment,
+                      bool *stackless, uint32_t *checksum)
+{
+    opal_convertor_t *convertor;
+    struct iovec iov[2];
+    uint32_t iov_count;
+    size_t max_data, length = position;
+    int done = 0;
+
+    convertor = opal_convertor_create(arch, 0);
+    if (0 != flags) {
+        opal_convertor_personalize(convertor, flags, NULL);
+    }
+    if (send) {
+        opal_convertor_prepare_for_send(convertor, &dtype->super, count, user);
+    } else {
+        opal_convertor_prepare_for_recv(convertor, &dtype->super, count, user);
+    }
+    *stackless = (0 != (convertor->flags & CONVERTOR_STACKLESS));
+
+    if (0 != position) {
+        opal_convertor_set_position(convertor, &length);
+        if (length != position) {
+            printf("  set_position(%" PRIsize_t ") moved to %" PRIsize_t "\n", position, length);
+            OBJ_RELEASE(convertor);
+            return 0;
+        }
+    }
+
+    while (!done) {
+        /* two iovecs of different lengths; the first one is never empty */
+        iov[0].iov_base = packed + length;
+        iov[0].iov_len = (fragment + 1) / 2;
+        iov[1].iov_base = packed + length + iov[0].iov_len;
+        iov[1].iov_len = fragment - iov[0].iov_len;
+        iov_count = (0 == iov[1].iov_len) ? 1 : 2;
+        max_data = fragment;
+
+        if (send) {
+            done = opal_convertor_pack(convertor, iov, &iov_count, &max_data);
+        } else {
+            done = opal_convertor_unpack(convertor, iov, &iov_count, &max_data);
+        }
+        if ((0 == max_data) && !done) {
+            printf("  the convertor is stuck at %" PRIsize_t "\n", length);
+            break;
+        }
+        length += max_data;
+    }
+    if (NULL != checksum) {
+        *checksum = opal_convertor_get_checksum(convertor);
+    }
+    OBJ_RELEASE(convertor);
+    return length;
+}
+
+static int check_packed(const char *what, const char *packed, const char *expected, size_t from,
+                        size_t size, size_t fragment)
+{
+    for (size_t i = from; i < size; i++) {
+        if (packed[i] != expected[i]) {
+            printf("  %s (fragment %" PRIsize_t ", from %" PRIsize_t "): packed byte %" PRIsize_t
+                   " is %02x instead of %02x\n",
+                   what, fragment, from, i, (unsigned char) packed[i],
+                   (unsigned char) expected[i]);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int check_user(const char *what, const char *user, const char *expected, size_t length,
+                      size_t fragment, size_t from)
+{
+    for (size_t i = 0; i < length; i++) {
+        if (user[i] != expected[i]) {
+            printf("  %s (fragment %" PRIsize_t ", from %" PRIsize_t "): user byte %" PRIsize_t
+                   " is %02x instead of %02x\n",
+                   what, fragment, from, i, (unsigned char) user[i], (unsigned char) expected[i]);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int test_datatype(const char *name, ompi_datatype_t *dtype, int count)
+{
+    ptrdiff_t lb, extent, true_lb, true_extent;
+    char *src, *dst, *dst_ref, *packed, *packed_ref;
+    size_t size, length, positions[16], nb_positions = 0, plane, done;
+    uint32_t checksum, checksum_ref;
+    bool stackless;
+    int errors = 0;
+
+    ompi_datatype_commit(&dtype);
+    ompi_datatype_type_size(dtype, &size);
+    size *= count;
+    ompi_datatype_get_extent(dtype, &lb, &extent);
+    ompi_datatype_get_true_extent(dtype, &true_lb, &true_extent);
+    length = (count - 1) * extent + true_extent;
+
+    printf("%s: count %d size %" PRIsize_t " extent %" PRIsize_t "\n", name, count, size,
+           (size_t) extent);
+    if (0 == dtype->super.strided.count) {
+        printf("  the strided shape was not detected\n");
+        return 1;
+    }
+
+    src = (char *) malloc(length);
+    dst = (char *) malloc(length);
+    dst_ref = (char *) malloc(length);
+    packed = (char *) malloc(size);
+    packed_ref = (char *) malloc(size);
+    for (size_t i = 0; i < length; i++) {
+        src[i] = (char) (i * 7 + 1);
+    }
+
+    /* reference: the generic functions, in a single fragment */
+    set_strided(false);
+    convert(dtype, count, src - true_lb, packed_ref, opal_local_arch, 0, true, 0, size, &stackless,
+            NULL);
+    memset(dst_ref, USER_PATTERN, length);
+    convert(dtype, count, dst_ref - true_lb, packed_ref, opal_local_arch, 0, false, 0, size,
+            &stackless, NULL);
+    if (stackless) {
+        printf("  the strided functions are used while mpi_ddt_strided is false\n");
+        errors++;
+    }
+
+    set_strided(true);
+    for (size_t f = 0; f < NB_FRAGMENT_SIZES; f++) {
+        size_t fragment = fragment_sizes[f];
+
+        memset(packed, 0, size);
+        done = convert(dtype, count, src - true_lb, packed, opal_local_arch, 0, true, 0, fragment,
+                       &stackless, NULL);
+        if (!stackless) {
+            printf("  the strided functions are not used for pack\n");
+            errors++;
+        }
+        if (done != size) {
+            printf("  pack (fragment %" PRIsize_t ") stopped at %" PRIsize_t "\n", fragment, done);
+            errors++;
+        }
+        errors += check_packed("pack", packed, packed_ref, 0, size, fragment);
+
+        memset(dst, USER_PATTERN, length);
+        done = convert(dtype, count, dst - true_lb, packed_ref, opal_local_arch, 0, false, 0,
+                       fragment, &stackless, NULL);
+        if (!stackless) {
+            printf("  the strided functions are not used for unpack\n");
+            errors++;
+        }
+        if (done != size) {
+            printf("  unpack (fragment %" PRIsize_t ") stopped at %" PRIsize_t "\n", fragment,
+                   done);
+            errors++;
+        }
+        errors += check_user("unpack", dst, dst_ref, length, fragment, 0);
+    }
+
+    /* restart from positions that are not on element boundaries, and on
+     * both sides of the end of the rows and planes of N-D shapes */
+    positions[nb_positions++] = 1;
+    positions[nb_positions++] = 5;
+    positions[nb_positions++] = 8;
+    positions[nb_positions++] = 13;
+    positions[nb_positions++] = size / 3 + 1;
+    positions[nb_positions++] = size / 2;
+    positions[nb_positions++] = size - 3;
+    positions[nb_positions++] = size - 1;
+    plane = dtype->super.strided.seg[0].len;
+    for (int d = 0; d <= dtype->super.strided.ndim; d++) {
+        positions[nb_positions++] = plane - 1;
+        positions[nb_positions++] = plane + 1;
+        if (d < dtype->super.strided.ndim) {
+            plane *= dtype->super.strided.seg[1 + d].len;
+        }
+    }
+    for (size_t p = 0; p < nb_positions; p++) {
+        size_t position = positions[p];
+
+        if ((0 == position) || (position >= size)) {
+            continue;
+        }
+        memset(packed, 0, size);
+        set_strided(true);
+        if (size != convert(dtype, count, src - true_lb, packed, opal_local_arch, 0, true,
+                            position, 13, &stackless, NULL)) {
+            printf("  pack from %" PRIsize_t " failed\n", position);
+            errors++;
+        }
+        errors += check_packed("pack", packed, packed_ref, position, size, 13);
+
+        memset(dst, USER_PATTERN, length);
+        if (size != convert(dtype, count, dst - true_lb, packed_ref, opal_local_arch, 0, false,
+                            position, 13, &stackless, NULL)) {
+            printf("  unpack from %" PRIsize_t " failed\n", position);
+            errors++;
+        }
+        set_strided(false);
+        memset(dst_ref, USER_PATTERN, length);
+        convert(dtype, count, dst_ref - true_lb, packed_ref, opal_local_arch, 0, false, position,
+                13, &stackless, NULL);
+        errors += check_user("unpack", dst, dst_ref, length, 13, position);
+    }
+
+    /* convertors with checksum: the specialized functions do not compute it */
+    set_strided(false);
+    convert(dtype, count, src - true_lb, packed_ref, opal_local_arch, CONVERTOR_WITH_CHECKSUM,
+            true, 0, 13, &stackless, &checksum_ref);
+    set_strided(true);
+    memset(packed, 0, size);
+    convert(dtype, count, src - true_lb, packed, opal_local_arch, CONVERTOR_WITH_CHECKSUM, true, 0,
+            13, &stackless, &checksum);
+#if defined(CHECKSUM)
+    if (stackless) {
+        printf("  the strided functions are used with a checksum\n");
+        errors++;
+    }
+    if (checksum != checksum_ref) {
+        printf("  checksum %x instead of %x\n", checksum, checksum_ref);
+        errors++;
+    }
+#endif /* defined(CHECKSUM) */
+    errors += check_packed("checksum pack", packed, packed_ref, 0, size, 13);
+
+    /* heterogeneous unpack: the data is converted by the generic functions */
+    set_strided(false);
+    memset(dst_ref, USER_PATTERN, length);
+    convert(dtype, count, dst_ref - true_lb, packed_ref, opal_local_arch ^ OPAL_ARCH_ISBIGENDIAN,
+            0, false, 0, 13, &stackless, NULL);
+    set_strided(true);
+    memset(dst, USER_PATTERN, length);
+    convert(dtype, count, dst - true_lb, packed_ref, opal_local_arch ^ OPAL_ARCH_ISBIGENDIAN, 0,
+            false, 0, 13, &stackless, NULL);
+    if (stackless) {
+        printf("  the strided functions are used for a heterogeneous unpack\n");
+        errors++;
+    }
+    errors += check_user("heterogeneous unpack", dst, dst_ref, length, 13, 0);
+
+    free(src);
+    free(dst);
+    free(dst_ref);
+    free(packed);
+    free(packed_ref);
+    return errors;
+}
+
+int main(int argc, char *argv[])
+{
+    ompi_datatype_t *dtype, *base, *types[3];
+    ptrdiff_t disps[3];
+    int blens[3];
+    int errors = 0;
+
+    opal_init(NULL, NULL);
+    ompi_datatype_init();
+
+    strided_var = mca_base_var_find("opal", "mpi", NULL, "ddt_strided");
+    if (0 > strided_var) {
+        printf("mpi_ddt_strided is not registered\n");
+        return 1;
+    }
+
+    ompi_datatype_create_vector(100, 1, 3, MPI_DOUBLE, &dtype);
+    errors += test_datatype("vector of 1 double", dtype, 2);
+    ompi_datatype_destroy(&dtype);
+
+    ompi_datatype_create_vector(64, 2, 5, MPI_INT, &dtype);
+    errors += test_datatype("vector of 2 int", dtype, 3);
+    ompi_datatype_destroy(&dtype);
+
+    ompi_datatype_create_vector(33, 7, 9, MPI_FLOAT, &dtype);
+    errors += test_datatype("vector of 7 float", dtype, 1);
+    ompi_datatype_destroy(&dtype);
+
+    ompi_datatype_create_vector(10, 16, 20, MPI_DOUBLE, &dtype);
+    errors += test_datatype("vector of 16 double", dtype, 2);
+    ompi_datatype_destroy(&dtype);
+
+    ompi_datatype_create_hvector(50, 3, 17, MPI_CHAR, &dtype);
+    errors += test_datatype("hvector of 3 char", dtype, 2);
+    ompi_datatype_destroy(&dtype);
+
+    ompi_datatype_create_hvector(40, 2, 28, MPI_INT, &dtype);
+    errors += test_datatype("hvector of 2 int", dtype, 2);
+    ompi_datatype_destroy(&dtype);
+
+    /* structures with gaps, alone and in a vector */
+    blens[0] = 1;
+    blens[1] = 1;
+    disps[0] = 0;
+    disps[1] = 8;
+    types[0] = MPI_INT;
+    types[1] = MPI_DOUBLE;
+    ompi_datatype_create_struct(2, blens, disps, types, &base);
+    errors += test_datatype("struct int, double", base, 25);
+
+    ompi_datatype_create_vector(20, 1, 2, base, &dtype);
+    errors += test_datatype("vector of struct int, double", dtype, 2);
+    ompi_datatype_destroy(&dtype);
+    ompi_datatype_destroy(&base);
+
+    blens[0] = 1;
+    blens[1] = 2;
+    blens[2] = 1;
+    disps[0] = 0;
+    disps[1] = 4;
+    disps[2] = 24;
+    types[0] = MPI_CHAR;
+    types[1] = MPI_INT;
+    types[2] = MPI_DOUBLE;
+    ompi_datatype_create_struct(3, blens, disps, types, &dtype);
+    errors += test_datatype("struct char, 2 int, double", dtype, 17);
+    ompi_datatype_destroy(&dtype);
+
+    /* N-dimensional shapes: subarrays and nested vectors */
+    {
+        int sizes[4] = {40, 50}, subsizes[4] = {20, 30}, starts[4] = {5, 7};
+        ompi_datatype_create_subarray(2, sizes, subsizes, starts, MPI_ORDER_C, MPI_DOUBLE, &dtype);
+        errors += test_datatype("2-D subarray of double", dtype, 2);
+        ompi_datatype_destroy(&dtype);
+    }
+    {
+        int sizes[4] = {12, 10, 14}, subsizes[4] = {5, 4, 6}, starts[4] = {2, 3, 1};
+        ompi_datatype_create_subarray(3, sizes, subsizes, starts, MPI_ORDER_C, MPI_INT, &dtype);
+        errors += test_datatype("3-D subarray of int", dtype, 2);
+        ompi_datatype_destroy(&dtype);
+    }
+    {
+        int sizes[4] = {9, 7, 11}, subsizes[4] = {4, 3, 5}, starts[4] = {1, 2, 3};
+        ompi_datatype_create_subarray(3, sizes, subsizes, starts, MPI_ORDER_FORTRAN, MPI_CHAR,
+                                      &dtype);
+        errors += test_datatype("3-D Fortran subarray of char", dtype, 3);
+        ompi_datatype_destroy(&dtype);
+    }
+    {
+        /* the two inner dimensions are merged with the row */
+        int sizes[4] = {8, 9, 10}, subsizes[4] = {3, 4, 10}, starts[4] = {1, 2, 0};
+        ompi_datatype_create_subarray(3, sizes, subsizes, starts, MPI_ORDER_C, MPI_INT, &dtype);
+        errors += test_datatype("3-D subarray of full rows", dtype, 2);
+        ompi_datatype_destroy(&dtype);
+    }
+    {
+        int sizes[4] = {6, 5, 7, 9}, subsizes[4] = {3, 2, 4, 5}, starts[4] = {1, 2, 3, 4};
+        ompi_datatype_create_subarray(4, sizes, subsizes, starts, MPI_ORDER_C, MPI_FLOAT, &dtype);
+        errors += test_datatype("4-D subarray of float", dtype, 2);
+        ompi_datatype_destroy(&dtype);
+    }
+    {
+        ompi_datatype_t *inner, *middle;
+
+        ompi_datatype_create_vector(4, 3, 7, MPI_DOUBLE, &inner);
+        ompi_datatype_create_hvector(5, 1, 7 * 4 * sizeof(double) + 24, inner, &middle);
+        ompi_datatype_create_hvector(3, 1, 5 * (7 * 4 * sizeof(double) + 24) + 40, middle,
+                                     &dtype);
+        errors += test_datatype("3 nested vectors of double", dtype, 2);
+        ompi_datatype_destroy(&dtype);
+        ompi_datatype_destroy(&middle);
+        ompi_datatype_destroy(&inner);
+
+        ompi_datatype_create_hvector(6, 5, 11, MPI_CHAR, &inner);
+        ompi_datatype_create_hvector(7, 1, 71, inner, &dtype);
+        errors += test_datatype("2 nested hvectors of char", dtype, 3);
+        ompi_datatype_destroy(&dtype);
+        ompi_datatype_destroy(&inner);
+    }
+
+    /* clean-ups all data allocations */
+    opal_finalize_util();
+
+    if (0 != errors) {
+        printf("%d errors\n", errors);
+        return 1;
+    }
+    return 0;
+}
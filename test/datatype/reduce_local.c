@@ -21,6 +21,8 @@
 #define _POSIX_C_SOURCE 200809L
 
 #include "ompi_config.h"
+#include <limits.h>
+#include <math.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -30,6 +32,7 @@
 #include <unistd.h>
 
 #include "mpi.h"
+#include "ompi/mpiext/bfloat16/c/mpiext_bfloat16_c.h"
 #include "ompi/communicator/communicator.h"
 #include "ompi/datatype/ompi_datatype.h"
 #include "ompi/runtime/mpiruntime.h"
@@ -51,17 +54,97 @@ static op_name_t array_of_ops[] = {
     {"lxor", "MPI_LXOR", MPI_LXOR},
     {"bxor", "MPI_BXOR", MPI_BXOR},
     {"replace", "MPI_REPLACE", MPI_REPLACE},
+    {"maxloc", "MPI_MAXLOC", MPI_MAXLOC},
+    {"minloc", "MPI_MINLOC", MPI_MINLOC},
     {NULL, "MPI_OP_NULL", MPI_OP_NULL},
 };
-static int do_ops[12] = {
+static int do_ops[14] = {
     -1,
 }; /* index of the ops to do. Size +1 larger than the array_of_ops */
 static int verbose = 0;
 static int total_errors = 0;
 
-#define max(a, b) (a) > (b) ? (a) : (b)
+#define max(a, b) ((a) > (b) ? (a) : (b))
 
-#define min(a, b) (a) < (b) ? (a) : (b)
+#define min(a, b) ((a) < (b) ? (a) : (b))
+
+#define lxor(a, b) (((a) ? 1 : 0) ^ ((b) ? 1 : 0))
+
+/* For the logical ops, clear every third input element and every other
+ * output one, so that each combination of zero and non-zero operands
+ * occurs, in the vector loops as well as in the tails. */
+#define LOGICAL_OPERANDS(INBUF, INOUT_BUF, CHECK_BUF, COUNT)                       \
+    do {                                                                           \
+        if ((0 == strcmp(op, "land")) || (0 == strcmp(op, "lor"))                  \
+            || (0 == strcmp(op, "lxor"))) {                                        \
+            for (int _j = 0; _j < (COUNT); _j++) {                                 \
+                if (0 == _j % 3) {                                                 \
+                    (INBUF)[_j] = 0;                                               \
+                }                                                                  \
+                if (0 == _j % 2) {                                                 \
+                    (INOUT_BUF)[_j] = (CHECK_BUF)[_j] = 0;                         \
+                }                                                                  \
+            }                                                                      \
+        }                                                                          \
+    } while (0)
+
+/* layouts of the pair types of MPI_MAXLOC and MPI_MINLOC */
+typedef struct {
+    int v;
+    int k;
+} loc_2int_t;
+typedef struct {
+    float v;
+    int k;
+} loc_float_int_t;
+typedef struct {
+    double v;
+    int k;
+} loc_double_int_t;
+
+/* bfloat16 is the upper half of a float. The reference conversion rounds
+ * to nearest-even on the discarded bits, independently from op/base. */
+static float bf16_to_float(uint16_t v)
+{
+    uint32_t u = (uint32_t) v << 16;
+    float f;
+
+    memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+static uint16_t float_to_bf16(float f)
+{
+    uint32_t u, low;
+    uint16_t v;
+
+    if (isnan(f)) {
+        return 0x7fc0;
+    }
+    memcpy(&u, &f, sizeof(u));
+    v = (uint16_t) (u >> 16);
+    low = u & 0xffff;
+    if ((low > 0x8000) || ((0x8000 == low) && (v & 1))) {
+        v++;
+    }
+    return v;
+}
+
+/* the 2-byte short float (IEEE fp16), when the compiler provides one */
+#if (defined(HAVE_SHORT_FLOAT) && SIZEOF_SHORT_FLOAT == 2) \
+    || (!defined(HAVE_SHORT_FLOAT) && defined(HAVE_OPAL_SHORT_FLOAT_T) \
+        && SIZEOF_OPAL_SHORT_FLOAT_T == 2)
+#define HAVE_HALF_SHORT_FLOAT 1
+#if defined(HAVE_SHORT_FLOAT)
+typedef short float half_t;
+#else
+typedef opal_short_float_t half_t;
+#endif
+OMPI_DECLSPEC extern struct ompi_predefined_datatype_t ompi_mpi_short_float;
+#define MPIX_SHORT_FLOAT OMPI_PREDEFINED_GLOBAL(MPI_Datatype, ompi_mpi_short_float)
+#define HALF_TO_FLOAT(v) ((float) (v))
+#define FLOAT_TO_HALF(f) ((half_t) (f))
+#endif
 
 static void print_status(char *op, char *type, int type_size, int count, int max_shift,
                          double *duration, int repeats, int correct)
@@ -164,8 +247,8 @@ do { \
             tend = MPI_Wtime(); \
             duration[_k] += (tend - tstart); \
             if( check ) { \
-                for( i = 0; i < (COUNT); i++ ) { \
-                    TYPE _v1 = *(_p1+_k), _v2 = *(_p2+_k), _v3 = *(_p3+_k); \
+                for( i = 0; i < (COUNT)-_k; i++ ) { \
+                    TYPE _v1 = (_p1+_k)[i], _v2 = (_p2+_k)[i], _v3 = (_p3+_k)[i]; \
                     if(_v2 == OPNAME(_v1, _v3)) \
                         continue; \
                     printf("First error at alignment %d position %d (%" TYPE_PREFIX " !=  %s(%" TYPE_PREFIX ", %" TYPE_PREFIX ")\n", \
@@ -178,6 +261,134 @@ do { \
     } \
     goto check_and_continue; \
 } while (0)
+/* The result of MAXLOC (OPNAME >) or MINLOC (OPNAME <) is computed as in
+ * op/base: the value of the first operand when it compares better, the
+ * lowest index on equal values, and the second operand otherwise (including
+ * when one of the values is a NaN). */
+#define MPI_OP_LOC_TEST(OPNAME, MPIOP, MPITYPE, TYPE, INBUF, INOUT_BUF, CHECK_BUF, COUNT, TYPE_PREFIX) \
+do { \
+    const TYPE *_p1 = ((TYPE*)(INBUF)), *_p3 = ((TYPE*)(CHECK_BUF)); \
+    TYPE *_p2 = ((TYPE*)(INOUT_BUF)); \
+    skip_op_type = 0; \
+    for(int _k = 0; (_k < (COUNT)) && (_k < max_shift); _k++ ) { \
+        duration[_k] = 0.0; \
+        for(int _r = repeats; _r > 0; _r--) { \
+            memcpy(_p2, _p3, sizeof(TYPE) * (COUNT)); \
+            tstart = MPI_Wtime(); \
+            MPI_Reduce_local(_p1+_k, _p2+_k, (COUNT)-_k, (MPITYPE), (MPIOP)); \
+            tend = MPI_Wtime(); \
+            duration[_k] += (tend - tstart); \
+            if( check ) { \
+                for( i = 0; i < (COUNT)-_k; i++ ) { \
+                    TYPE _v1 = (_p1+_k)[i], _v2 = (_p2+_k)[i], _v3 = (_p3+_k)[i], _e = _v3; \
+                    if (_v1.v OPNAME _v3.v) { \
+                        _e = _v1; \
+                    } else if (_v1.v == _v3.v) { \
+                        _e.k = (_v1.k < _v3.k) ? _v1.k : _v3.k; \
+                    } \
+                    if ((0 == memcmp(&_v2.v, &_e.v, sizeof(_e.v))) && (_v2.k == _e.k)) \
+                        continue; \
+                    printf("First error at alignment %d position %d (%s((%" TYPE_PREFIX ", %d), (%" TYPE_PREFIX ", %d)) != (%" TYPE_PREFIX ", %d))\n", \
+                           _k, i, (#MPIOP), _v1.v, _v1.k, _v3.v, _v3.k, _v2.v, _v2.k); \
+                    correctness = 0; \
+                    break; \
+                } \
+            } \
+        } \
+    } \
+    goto check_and_continue; \
+} while (0)
+
+/* Pairs covering all the cases of MAXLOC and MINLOC: either value better,
+ * equal values with the lowest index on either side, EXTRA1 (a NaN or an
+ * extreme value) in either or both operands, and values that only differ
+ * by their sign (-0.0 and +0.0 for the floating point types). */
+#define LOC_FILL(TYPE, VTYPE, INBUF, INOUT_BUF, CHECK_BUF, COUNT, EXTRA1, EXTRA2, ZERO) \
+do { \
+    TYPE *_a = (TYPE *) (INBUF), *_b = (TYPE *) (INOUT_BUF), *_c = (TYPE *) (CHECK_BUF); \
+    for (i = 0; i < (COUNT); i++) { \
+        VTYPE _x = (VTYPE) (i % 13) + 1; \
+        _a[i].k = 2 * i; \
+        _b[i].k = 2 * i + 1; \
+        switch (i % 8) { \
+        case 0: _a[i].v = _x; _b[i].v = _x - 1; break; \
+        case 1: _a[i].v = _x - 1; _b[i].v = _x; break; \
+        case 2: _a[i].v = _b[i].v = _x; break; \
+        case 3: _a[i].v = _b[i].v = _x; _a[i].k = 2 * i + 2; break; \
+        case 4: _a[i].v = (EXTRA1); _b[i].v = _x; break; \
+        case 5: _a[i].v = _x; _b[i].v = (EXTRA1); break; \
+        case 6: _a[i].v = (EXTRA1); _b[i].v = (EXTRA2); _a[i].k = 2 * i + 2; break; \
+        case 7: _a[i].v = -(ZERO); _b[i].v = (ZERO); _a[i].k = 2 * i + 2; break; \
+        } \
+        _c[i] = _b[i]; \
+    } \
+} while (0)
+
+/* The result on the 2-byte floating point types is computed in float from
+ * the widened operands and rounded once. MAX and MIN keep out only when it
+ * compares better, and return in otherwise (including on NaNs and on
+ * -0.0/+0.0), as op/base. Any NaN is accepted where a NaN is expected. */
+#define HALF_SUM(FROM_FLOAT, O, I, FO, FI)  FROM_FLOAT((FO) + (FI))
+#define HALF_PROD(FROM_FLOAT, O, I, FO, FI) FROM_FLOAT((FO) * (FI))
+#define HALF_MAX(FROM_FLOAT, O, I, FO, FI)  (((FO) > (FI)) ? (O) : (I))
+#define HALF_MIN(FROM_FLOAT, O, I, FO, FI)  (((FO) < (FI)) ? (O) : (I))
+
+#define MPI_OP_HALF_TEST(OPNAME, MPIOP, MPITYPE, TYPE, TO_FLOAT, FROM_FLOAT, INBUF, INOUT_BUF, CHECK_BUF, COUNT) \
+do { \
+    const TYPE *_p1 = ((TYPE*)(INBUF)), *_p3 = ((TYPE*)(CHECK_BUF)); \
+    TYPE *_p2 = ((TYPE*)(INOUT_BUF)); \
+    skip_op_type = 0; \
+    for(int _k = 0; (_k < (COUNT)) && (_k < max_shift); _k++ ) { \
+        duration[_k] = 0.0; \
+        for(int _r = repeats; _r > 0; _r--) { \
+            memcpy(_p2, _p3, sizeof(TYPE) * (COUNT)); \
+            tstart = MPI_Wtime(); \
+            MPI_Reduce_local(_p1+_k, _p2+_k, (COUNT)-_k, (MPITYPE), (MPIOP)); \
+            tend = MPI_Wtime(); \
+            duration[_k] += (tend - tstart); \
+            if( check ) { \
+                for( i = 0; i < (COUNT)-_k; i++ ) { \
+                    TYPE _v1 = (_p1+_k)[i], _v2 = (_p2+_k)[i], _v3 = (_p3+_k)[i]; \
+                    TYPE _e = OPNAME(FROM_FLOAT, _v3, _v1, TO_FLOAT(_v3), TO_FLOAT(_v1)); \
+                    if ((0 == memcmp(&_v2, &_e, sizeof(TYPE))) \
+                        || (isnan(TO_FLOAT(_v2)) && isnan(TO_FLOAT(_e)))) \
+                        continue; \
+                    printf("First error at alignment %d position %d (%s(%g, %g) = %g != %g)\n", \
+                           _k, i, (#MPIOP), TO_FLOAT(_v3), TO_FLOAT(_v1), TO_FLOAT(_v2), TO_FLOAT(_e)); \
+                    correctness = 0; \
+                    break; \
+                } \
+            } \
+        } \
+    } \
+    goto check_and_continue; \
+} while (0)
+
+/* Operands covering regular values, sums on a tie that round to even
+ * downwards and upwards, a sum just above a tie, a product on a tie, a NaN
+ * in either operand, -0.0 against +0.0 and an overflow to infinity. The
+ * period is not a multiple of the vector widths, so that all the cases
+ * also land in the scalar tails. HALF_ULP is half the ulp of 1.0. */
+#define HALF_FILL(TYPE, FROM_FLOAT, INBUF, INOUT_BUF, CHECK_BUF, COUNT, HALF_ULP, MAXV) \
+do { \
+    TYPE *_a = (TYPE *) (INBUF), *_b = (TYPE *) (INOUT_BUF), *_c = (TYPE *) (CHECK_BUF); \
+    for (i = 0; i < (COUNT); i++) { \
+        float _x = (float) (i % 13) + 1, _in, _out; \
+        switch (i % 9) { \
+        case 0: _out = _x; _in = _x / 2; break; \
+        case 1: _out = 1.0f; _in = (HALF_ULP); break; \
+        case 2: _out = 1.0f + 2 * (HALF_ULP); _in = (HALF_ULP); break; \
+        case 3: _out = 1.0f; _in = (HALF_ULP) + (HALF_ULP) / 64; break; \
+        case 4: _out = 3.0f; _in = 1.0f + 2 * (HALF_ULP); break; \
+        case 5: _out = _x; _in = NAN; break; \
+        case 6: _out = NAN; _in = -_x; break; \
+        case 7: _out = 0.0f; _in = -0.0f; break; \
+        default: _out = (MAXV); _in = (MAXV); break; \
+        } \
+        _a[i] = FROM_FLOAT(_in); \
+        _b[i] = _c[i] = FROM_FLOAT(_out); \
+    } \
+} while (0)
 /* clang-format on */
 
 int main(int argc, char **argv)
@@ -231,10 +442,9 @@ int main(int argc, char **argv)
         case 't':
             for (i = 0; i < (int) strlen(optarg); i++) {
                 if (!(('i' == optarg[i]) || ('u' == optarg[i]) || ('f' == optarg[i])
-                      || ('d' == optarg[i]))) {
-                    fprintf(
-                        stderr,
-                        "type must be i (signed int), u (unsigned int), f (float) or d (double)\n");
+                      || ('d' == optarg[i]) || ('b' == optarg[i]))) {
+                    fprintf(stderr, "type must be i (signed int), u (unsigned int), f (float), "
+                                    "d (double) or b (bfloat16)\n");
                     exit(-1);
                 }
             }
@@ -272,10 +482,13 @@ int main(int argc, char **argv)
                     " -l <number> : lower number of elements\n"
                     " -u <number> : upper number of elements\n"
                     " -s <type_size> : 8, 16, 32 or 64 bits elements\n"
-                    " -t [i,u,f,d] : type of the elements to apply the operations on\n"
+                    " -t [i,u,f,d,b] : type of the elements to apply the operations on\n"
+                    "           (b is MPIX_BFLOAT16, -t f -s 16 the 2-byte short float)\n"
                     " -r <number> : number of repetitions for each test\n"
                     " -o <op> : comma separated list of operations to execute among\n"
-                    "           sum, min, max, prod, bor, bxor, band\n"
+                    "           sum, min, max, prod, bor, bxor, band, land, lor, lxor,\n"
+                    "           maxloc, minloc (on MPI_2INT for -t i -s 32, MPI_FLOAT_INT\n"
+                    "           for -t f and MPI_DOUBLE_INT for -t d)\n"
                     " -i <number> : shift on all buffers to check alignment\n"
                     " -1 <number> : (mis)alignment in elements for the first op\n"
                     " -2 <number> : (mis)alignment in elements for the result\n"
@@ -290,9 +503,10 @@ int main(int argc, char **argv)
     if (!do_ops_built) { /* not yet done, take the default */
         build_do_ops("all", do_ops);
     }
-    posix_memalign(&in_buf, 64, (upper + op1_alignment) * sizeof(double));
-    posix_memalign(&inout_buf, 64, (upper + res_alignment) * sizeof(double));
-    posix_memalign(&inout_check_buf, 64, upper * sizeof(double));
+    /* the largest elements are the MPI_DOUBLE_INT pairs */
+    posix_memalign(&in_buf, 64, (upper + op1_alignment) * sizeof(loc_double_int_t));
+    posix_memalign(&inout_buf, 64, (upper + res_alignment) * sizeof(loc_double_int_t));
+    posix_memalign(&inout_check_buf, 64, upper * sizeof(loc_double_int_t));
     duration = (double *) malloc(max_shift * sizeof(double));
 
     ompi_mpi_init(argc, argv, MPI_THREAD_SERIALIZED, &provided, false);
@@ -311,6 +525,137 @@ int main(int argc, char **argv)
             for (count = lower; count <= upper; count += count) {
                 mpi_type = NULL;
                 correctness = 1;
+                if ((0 == strcmp(op, "maxloc")) || (0 == strcmp(op, "minloc"))) {
+                    if (('i' == type[type_idx]) && (32 == type_size)) {
+                        loc_2int_t *in_2int = (loc_2int_t *) ((char *) in_buf
+                                                              + op1_alignment * sizeof(loc_2int_t)),
+                                   *inout_2int = (loc_2int_t *) ((char *) inout_buf
+                                                                 + res_alignment
+                                                                       * sizeof(loc_2int_t)),
+                                   *inout_2int_for_check = (loc_2int_t *) inout_check_buf;
+                        LOC_FILL(loc_2int_t, int, in_2int, inout_2int, inout_2int_for_check, count,
+                                 INT_MIN, INT_MAX, 0);
+                        mpi_type = "MPI_2INT";
+
+                        if (0 == strcmp(op, "maxloc")) {
+                            MPI_OP_LOC_TEST(>, mpi_op, MPI_2INT, loc_2int_t, in_2int, inout_2int,
+                                            inout_2int_for_check, count, "d");
+                        }
+                        if (0 == strcmp(op, "minloc")) {
+                            MPI_OP_LOC_TEST(<, mpi_op, MPI_2INT, loc_2int_t, in_2int, inout_2int,
+                                            inout_2int_for_check, count, "d");
+                        }
+                    }
+                    if ('f' == type[type_idx]) {
+                        loc_float_int_t *in_float_int = (loc_float_int_t *) ((char *) in_buf
+                                                                             + op1_alignment
+                                                                                   * sizeof(loc_float_int_t)),
+                                        *inout_float_int = (loc_float_int_t *) ((char *) inout_buf
+                                                                                + res_alignment
+                                                                                      * sizeof(loc_float_int_t)),
+                                        *inout_float_int_for_check = (loc_float_int_t *) inout_check_buf;
+                        LOC_FILL(loc_float_int_t, float, in_float_int, inout_float_int,
+                                 inout_float_int_for_check, count, NAN, NAN, 0.0f);
+                        mpi_type = "MPI_FLOAT_INT";
+
+                        if (0 == strcmp(op, "maxloc")) {
+                            MPI_OP_LOC_TEST(>, mpi_op, MPI_FLOAT_INT, loc_float_int_t, in_float_int,
+                                            inout_float_int, inout_float_int_for_check, count, "g");
+                        }
+                        if (0 == strcmp(op, "minloc")) {
+                            MPI_OP_LOC_TEST(<, mpi_op, MPI_FLOAT_INT, loc_float_int_t, in_float_int,
+                                            inout_float_int, inout_float_int_for_check, count, "g");
+                        }
+                    }
+                    if ('d' == type[type_idx]) {
+                        loc_double_int_t *in_double_int = (loc_double_int_t *) ((char *) in_buf
+                                                                                + op1_alignment
+                                                                                      * sizeof(loc_double_int_t)),
+                                         *inout_double_int = (loc_double_int_t *) ((char *) inout_buf
+                                                                                   + res_alignment
+                                                                                         * sizeof(loc_double_int_t)),
+                                         *inout_double_int_for_check = (loc_double_int_t *) inout_check_buf;
+                        LOC_FILL(loc_double_int_t, double, in_double_int, inout_double_int,
+                                 inout_double_int_for_check, count, NAN, -NAN, 0.0);
+                        mpi_type = "MPI_DOUBLE_INT";
+
+                        if (0 == strcmp(op, "maxloc")) {
+                            MPI_OP_LOC_TEST(>, mpi_op, MPI_DOUBLE_INT, loc_double_int_t, in_double_int,
+                                            inout_double_int, inout_double_int_for_check, count, "g");
+                        }
+                        if (0 == strcmp(op, "minloc")) {
+                            MPI_OP_LOC_TEST(<, mpi_op, MPI_DOUBLE_INT, loc_double_int_t, in_double_int,
+                                            inout_double_int, inout_double_int_for_check, count, "g");
+                        }
+                    }
+                    goto check_and_continue;
+                }
+                if ('b' == type[type_idx]) {
+                    uint16_t *in_bf16 = (uint16_t *) ((char *) in_buf
+                                                      + op1_alignment * sizeof(uint16_t)),
+                             *inout_bf16 = (uint16_t *) ((char *) inout_buf
+                                                         + res_alignment * sizeof(uint16_t)),
+                             *inout_bf16_for_check = (uint16_t *) inout_check_buf;
+                    HALF_FILL(uint16_t, float_to_bf16, in_bf16, inout_bf16, inout_bf16_for_check,
+                              count, 0x1p-8f, 0x1.fep127f);
+                    mpi_type = "MPIX_BFLOAT16";
+
+                    if (0 == strcmp(op, "sum")) {
+                        MPI_OP_HALF_TEST(HALF_SUM, mpi_op, MPIX_BFLOAT16, uint16_t, bf16_to_float,
+                                         float_to_bf16, in_bf16, inout_bf16, inout_bf16_for_check,
+                                         count);
+                    }
+                    if (0 == strcmp(op, "prod")) {
+                        MPI_OP_HALF_TEST(HALF_PROD, mpi_op, MPIX_BFLOAT16, uint16_t, bf16_to_float,
+                                         float_to_bf16, in_bf16, inout_bf16, inout_bf16_for_check,
+                                         count);
+                    }
+                    if (0 == strcmp(op, "max")) {
+                        MPI_OP_HALF_TEST(HALF_MAX, mpi_op, MPIX_BFLOAT16, uint16_t, bf16_to_float,
+                                         float_to_bf16, in_bf16, inout_bf16, inout_bf16_for_check,
+                                         count);
+                    }
+                    if (0 == strcmp(op, "min")) {
+                        MPI_OP_HALF_TEST(HALF_MIN, mpi_op, MPIX_BFLOAT16, uint16_t, bf16_to_float,
+                                         float_to_bf16, in_bf16, inout_bf16, inout_bf16_for_check,
+                                         count);
+                    }
+                    goto check_and_continue;
+                }
+                if (('f' == type[type_idx]) && (16 == type_size)) {
+#if defined(HAVE_HALF_SHORT_FLOAT)
+                    half_t *in_half = (half_t *) ((char *) in_buf
+                                                  + op1_alignment * sizeof(half_t)),
+                           *inout_half = (half_t *) ((char *) inout_buf
+                                                     + res_alignment * sizeof(half_t)),
+                           *inout_half_for_check = (half_t *) inout_check_buf;
+                    HALF_FILL(half_t, FLOAT_TO_HALF, in_half, inout_half, inout_half_for_check,
+                              count, 0x1p-11f, 65504.0f);
+                    mpi_type = "MPIX_SHORT_FLOAT";
+
+                    if (0 == strcmp(op, "sum")) {
+                        MPI_OP_HALF_TEST(HALF_SUM, mpi_op, MPIX_SHORT_FLOAT, half_t, HALF_TO_FLOAT,
+                                         FLOAT_TO_HALF, in_half, inout_half, inout_half_for_check,
+                                         count);
+                    }
+                    if (0 == strcmp(op, "prod")) {
+                        MPI_OP_HALF_TEST(HALF_PROD, mpi_op, MPIX_SHORT_FLOAT, half_t, HALF_TO_FLOAT,
+                                         FLOAT_TO_HALF, in_half, inout_half, inout_half_for_check,
+                                         count);
+                    }
+                    if (0 == strcmp(op, "max")) {
+                        MPI_OP_HALF_TEST(HALF_MAX, mpi_op, MPIX_SHORT_FLOAT, half_t, HALF_TO_FLOAT,
+                                         FLOAT_TO_HALF, in_half, inout_half, inout_half_for_check,
+                                         count);
+                    }
+                    if (0 == strcmp(op, "min")) {
+                        MPI_OP_HALF_TEST(HALF_MIN, mpi_op, MPIX_SHORT_FLOAT, half_t, HALF_TO_FLOAT,
+                                         FLOAT_TO_HALF, in_half, inout_half, inout_half_for_check,
+                                         count);
+                    }
+#endif  /* defined(HAVE_HALF_SHORT_FLOAT) */
+                    goto check_and_continue;
+                }
                 if ('i' == type[type_idx]) {
                     if (8 == type_size) {
                         int8_t *in_int8 = (int8_t *) ((char *) in_buf
@@ -322,6 +667,7 @@ int main(int argc, char **argv)
                             in_int8[i] = 5;
                             inout_int8[i] = inout_int8_for_check[i] = -3;
                         }
+                        LOGICAL_OPERANDS(in_int8, inout_int8, inout_int8_for_check, count);
                         mpi_type = "MPI_INT8_T";
 
                         if (0 == strcmp(op, "sum")) {
@@ -344,6 +690,18 @@ int main(int argc, char **argv)
                             MPI_OP_TEST(&, mpi_op, MPI_INT8_T, int8_t, in_int8, inout_int8,
                                         inout_int8_for_check, count, PRId8);
                         }
+                        if (0 == strcmp(op, "land")) {
+                            MPI_OP_TEST(&&, mpi_op, MPI_INT8_T, int8_t, in_int8, inout_int8,
+                                        inout_int8_for_check, count, PRId8);
+                        }
+                        if (0 == strcmp(op, "lor")) {
+                            MPI_OP_TEST(||, mpi_op, MPI_INT8_T, int8_t, in_int8, inout_int8,
+                                        inout_int8_for_check, count, PRId8);
+                        }
+                        if (0 == strcmp(op, "lxor")) {
+                            MPI_OP_MINMAX_TEST(lxor, mpi_op, MPI_INT8_T, int8_t, in_int8, inout_int8,
+                                               inout_int8_for_check, count, PRId8);
+                        }
                         if (0 == strcmp(op, "max")) {
                             MPI_OP_MINMAX_TEST(max, mpi_op, MPI_INT8_T, int8_t, in_int8, inout_int8,
                                                inout_int8_for_check, count, PRId8);
@@ -363,6 +721,7 @@ int main(int argc, char **argv)
                             in_int16[i] = 5;
                             inout_int16[i] = inout_int16_for_check[i] = -3;
                         }
+                        LOGICAL_OPERANDS(in_int16, inout_int16, inout_int16_for_check, count);
                         mpi_type = "MPI_INT16_T";
 
                         if (0 == strcmp(op, "sum")) {
@@ -385,6 +744,18 @@ int main(int argc, char **argv)
                             MPI_OP_TEST(&, mpi_op, MPI_INT16_T, int16_t, in_int16, inout_int16,
                                         inout_int16_for_check, count, PRId16);
                         }
+                        if (0 == strcmp(op, "land")) {
+                            MPI_OP_TEST(&&, mpi_op, MPI_INT16_T, int16_t, in_int16, inout_int16,
+                                        inout_int16_for_check, count, PRId16);
+                        }
+                        if (0 == strcmp(op, "lor")) {
+                            MPI_OP_TEST(||, mpi_op, MPI_INT16_T, int16_t, in_int16, inout_int16,
+                                        inout_int16_for_check, count, PRId16);
+                        }
+                        if (0 == strcmp(op, "lxor")) {
+                            MPI_OP_MINMAX_TEST(lxor, mpi_op, MPI_INT16_T, int16_t, in_int16, inout_int16,
+                                               inout_int16_for_check, count, PRId16);
+                        }
                         if (0 == strcmp(op, "max")) {
                             MPI_OP_MINMAX_TEST(max, mpi_op, MPI_INT16_T, int16_t, in_int16,
                                                inout_int16, inout_int16_for_check, count, PRId16);
@@ -404,6 +775,7 @@ int main(int argc, char **argv)
                             in_int32[i] = 5;
                             inout_int32[i] = inout_int32_for_check[i] = 3;
                         }
+                        LOGICAL_OPERANDS(in_int32, inout_int32, inout_int32_for_check, count);
                         mpi_type = "MPI_INT32_T";
 
                         if (0 == strcmp(op, "sum")) {
@@ -426,6 +798,18 @@ int main(int argc, char **argv)
                             MPI_OP_TEST(&, mpi_op, MPI_INT32_T, int32_t, in_int32, inout_int32,
                                         inout_int32_for_check, count, PRId32);
                         }
+                        if (0 == strcmp(op, "land")) {
+                            MPI_OP_TEST(&&, mpi_op, MPI_INT32_T, int32_t, in_int32, inout_int32,
+                                        inout_int32_for_check, count, PRId32);
+                        }
+                        if (0 == strcmp(op, "lor")) {
+                            MPI_OP_TEST(||, mpi_op, MPI_INT32_T, int32_t, in_int32, inout_int32,
+                                        inout_int32_for_check, count, PRId32);
+                        }
+                        if (0 == strcmp(op, "lxor")) {
+                            MPI_OP_MINMAX_TEST(lxor, mpi_op, MPI_INT32_T, int32_t, in_int32, inout_int32,
+                                               inout_int32_for_check, count, PRId32);
+                        }
                         if (0 == strcmp(op, "max")) {
                             MPI_OP_MINMAX_TEST(max, mpi_op, MPI_INT32_T, int32_t, in_int32,
                                                inout_int32, inout_int32_for_check, count, PRId32);
@@ -445,6 +829,7 @@ int main(int argc, char **argv)
                             in_int64[i] = 5;
                             inout_int64[i] = inout_int64_for_check[i] = 3;
                         }
+                        LOGICAL_OPERANDS(in_int64, inout_int64, inout_int64_for_check, count);
                         mpi_type = "MPI_INT64_T";
 
                         if (0 == strcmp(op, "sum")) {
@@ -467,6 +852,18 @@ int main(int argc, char **argv)
                             MPI_OP_TEST(&, mpi_op, MPI_INT64_T, int64_t, in_int64, inout_int64,
                                         inout_int64_for_check, count, PRId64);
                         }
+                        if (0 == strcmp(op, "land")) {
+                            MPI_OP_TEST(&&, mpi_op, MPI_INT64_T, int64_t, in_int64, inout_int64,
+                                        inout_int64_for_check, count, PRId64);
+                        }
+                        if (0 == strcmp(op, "lor")) {
+                            MPI_OP_TEST(||, mpi_op, MPI_INT64_T, int64_t, in_int64, inout_int64,
+                                        inout_int64_for_check, count, PRId64);
+                        }
+                        if (0 == strcmp(op, "lxor")) {
+                            MPI_OP_MINMAX_TEST(lxor, mpi_op, MPI_INT64_T, int64_t, in_int64, inout_int64,
+                                               inout_int64_for_check, count, PRId64);
+                        }
                         if (0 == strcmp(op, "max")) {
                             MPI_OP_MINMAX_TEST(max, mpi_op, MPI_INT64_T, int64_t, in_int64,
                                                inout_int64, inout_int64_for_check, count, PRId64);
@@ -489,6 +886,7 @@ int main(int argc, char **argv)
                             in_uint8[i] = 5;
                             inout_uint8[i] = inout_uint8_for_check[i] = 2;
                         }
+                        LOGICAL_OPERANDS(in_uint8, inout_uint8, inout_uint8_for_check, count);
                         mpi_type = "MPI_UINT8_T";
 
                         if (0 == strcmp(op, "sum")) {
@@ -511,6 +909,18 @@ int main(int argc, char **argv)
                             MPI_OP_TEST(&, mpi_op, MPI_UINT8_T, uint8_t, in_uint8, inout_uint8,
                                         inout_uint8_for_check, count, PRIu8);
                         }
+                        if (0 == strcmp(op, "land")) {
+                            MPI_OP_TEST(&&, mpi_op, MPI_UINT8_T, uint8_t, in_uint8, inout_uint8,
+                                        inout_uint8_for_check, count, PRIu8);
+                        }
+                        if (0 == strcmp(op, "lor")) {
+                            MPI_OP_TEST(||, mpi_op, MPI_UINT8_T, uint8_t, in_uint8, inout_uint8,
+                                        inout_uint8_for_check, count, PRIu8);
+                        }
+                        if (0 == strcmp(op, "lxor")) {
+                            MPI_OP_MINMAX_TEST(lxor, mpi_op, MPI_UINT8_T, uint8_t, in_uint8, inout_uint8,
+                                               inout_uint8_for_check, count, PRIu8);
+                        }
                         if (0 == strcmp(op, "max")) {
                             MPI_OP_MINMAX_TEST(max, mpi_op, MPI_UINT8_T, uint8_t, in_uint8,
                                                inout_uint8, inout_uint8_for_check, count, PRIu8);
@@ -530,6 +940,7 @@ int main(int argc, char **argv)
                             in_uint16[i] = 5;
                             inout_uint16[i] = inout_uint16_for_check[i] = 1234;
                         }
+                        LOGICAL_OPERANDS(in_uint16, inout_uint16, inout_uint16_for_check, count);
                         mpi_type = "MPI_UINT16_T";
 
                         if (0 == strcmp(op, "sum")) {
@@ -552,6 +963,18 @@ int main(int argc, char **argv)
                             MPI_OP_TEST(&, mpi_op, MPI_UINT16_T, uint16_t, in_uint16, inout_uint16,
                                         inout_uint16_for_check, count, PRIu16);
                         }
+                        if (0 == strcmp(op, "land")) {
+                            MPI_OP_TEST(&&, mpi_op, MPI_UINT16_T, uint16_t, in_uint16, inout_uint16,
+                                        inout_uint16_for_check, count, PRIu16);
+                        }
+                        if (0 == strcmp(op, "lor")) {
+                            MPI_OP_TEST(||, mpi_op, MPI_UINT16_T, uint16_t, in_uint16, inout_uint16,
+                                        inout_uint16_for_check, count, PRIu16);
+                        }
+                        if (0 == strcmp(op, "lxor")) {
+                            MPI_OP_MINMAX_TEST(lxor, mpi_op, MPI_UINT16_T, uint16_t, in_uint16, inout_uint16,
+                                               inout_uint16_for_check, count, PRIu16);
+                        }
                         if (0 == strcmp(op, "max")) {
                             MPI_OP_MINMAX_TEST(max, mpi_op, MPI_UINT16_T, uint16_t, in_uint16,
                                                inout_uint16, inout_uint16_for_check, count, PRIu16);
@@ -571,6 +994,7 @@ int main(int argc, char **argv)
                             in_uint32[i] = 5;
                             inout_uint32[i] = inout_uint32_for_check[i] = 3;
                         }
+                        LOGICAL_OPERANDS(in_uint32, inout_uint32, inout_uint32_for_check, count);
                         mpi_type = "MPI_UINT32_T";
 
                         if (0 == strcmp(op, "sum")) {
@@ -593,6 +1017,18 @@ int main(int argc, char **argv)
                             MPI_OP_TEST(&, mpi_op, MPI_UINT32_T, uint32_t, in_uint32, inout_uint32,
                                         inout_uint32_for_check, count, PRIu32);
                         }
+                        if (0 == strcmp(op, "land")) {
+                            MPI_OP_TEST(&&, mpi_op, MPI_UINT32_T, uint32_t, in_uint32, inout_uint32,
+                                        inout_uint32_for_check, count, PRIu32);
+                        }
+                        if (0 == strcmp(op, "lor")) {
+                            MPI_OP_TEST(||, mpi_op, MPI_UINT32_T, uint32_t, in_uint32, inout_uint32,
+                                        inout_uint32_for_check, count, PRIu32);
+                        }
+                        if (0 == strcmp(op, "lxor")) {
+                            MPI_OP_MINMAX_TEST(lxor, mpi_op, MPI_UINT32_T, uint32_t, in_uint32, inout_uint32,
+                                               inout_uint32_for_check, count, PRIu32);
+                        }
                         if (0 == strcmp(op, "max")) {
                             MPI_OP_MINMAX_TEST(max, mpi_op, MPI_UINT32_T, uint32_t, in_uint32,
                                                inout_uint32, inout_uint32_for_check, count, PRIu32);
@@ -612,6 +1048,7 @@ int main(int argc, char **argv)
                             in_uint64[i] = 5;
                             inout_uint64[i] = inout_uint64_for_check[i] = 32433;
                         }
+                        LOGICAL_OPERANDS(in_uint64, inout_uint64, inout_uint64_for_check, count);
                         mpi_type = "MPI_UINT64_T";
 
                         if (0 == strcmp(op, "sum")) {
@@ -634,6 +1071,18 @@ int main(int argc, char **argv)
                             MPI_OP_TEST(&, mpi_op, MPI_UINT64_T, uint64_t, in_uint64, inout_uint64,
                                         inout_uint64_for_check, count, PRIu64);
                         }
+                        if (0 == strcmp(op, "land")) {
+                            MPI_OP_TEST(&&, mpi_op, MPI_UINT64_T, uint64_t, in_uint64, inout_uint64,
+                                        inout_uint64_for_check, count, PRIu64);
+                        }
+                        if (0 == strcmp(op, "lor")) {
+                            MPI_OP_TEST(||, mpi_op, MPI_UINT64_T, uint64_t, in_uint64, inout_uint64,
+                                        inout_uint64_for_check, count, PRIu64);
+                        }
+                        if (0 == strcmp(op, "lxor")) {
+                            MPI_OP_MINMAX_TEST(lxor, mpi_op, MPI_UINT64_T, uint64_t, in_uint64, inout_uint64,
+                                               inout_uint64_for_check, count, PRIu64);
+                        }
                         if (0 == strcmp(op, "max")) {
                             MPI_OP_MINMAX_TEST(max, mpi_op, MPI_UINT64_T, uint64_t, in_uint64,
                                                inout_uint64, inout_uint64_for_check, count, PRIu64);
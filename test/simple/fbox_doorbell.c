@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+ * Many senders to one receiver through the shared memory fast boxes.
+ *
+ * Every rank but 0 sends small messages to rank 0 and waits for an
+ * acknowledgment after each burst, so no unrelated message can ring the
+ * doorbell of rank 0 again while a burst is outstanding. A lost doorbell
+ * notification therefore hangs the test, which is then stopped by the
+ * alarm.
+ *
+ *   mpirun -np 16 --mca btl sm,self ./fbox_doorbell [iterations] [burst]
+ *
+ * With a receiver that blocks when idle while the senders do not set
+ * btl_sm_idle_wait, a sender that does not wake the receiver leaves it
+ * asleep until the idle timeout, and the test runs much slower:
+ *
+ *   mpirun --mca btl sm,self --mca opal_progress_idle_spins 10 \
+ *       -np 1 -x OMPI_MCA_btl_sm_idle_wait=1 ./fbox_doorbell : -np 15 ./fbox_doorbell
+ */
+
+#include <mpi.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+static void timeout(int sig)
+{
+    (void) sig;
+    fprintf(stderr, "fbox_doorbell: timed out, a message was not noticed by the receiver\n");
+    abort();
+}
+
+int main(int argc, char *argv[])
+{
+    int rank, size, iterations = 20000, burst = 4;
+    int buf[4] = {0}, ack = 0;
+
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    if (argc > 1) {
+        iterations = atoi(argv[1]);
+    }
+    if (argc > 2) {
+        burst = atoi(argv[2]);
+    }
+
+    signal(SIGALRM, timeout);
+    alarm(600);
+
+    if (0 == rank) {
+        int *received = calloc(size, sizeof(int));
+        long total = (long) iterations * burst * (size - 1);
+        MPI_Status status;
+
+        for (long i = 0; i < total; i++) {
+            MPI_Recv(buf, 4, MPI_INT, MPI_ANY_SOURCE, 0, MPI_COMM_WORLD, &status);
+            if (buf[0] != status.MPI_SOURCE || buf[1] != received[status.MPI_SOURCE] / burst) {
+                fprintf(stderr, "fbox_doorbell: bad message from %d\n", status.MPI_SOURCE);
+                MPI_Abort(MPI_COMM_WORLD, 1);
+            }
+            if (0 == (++received[status.MPI_SOURCE] % burst)) {
+                MPI_Send(&ack, 1, MPI_INT, status.MPI_SOURCE, 1, MPI_COMM_WORLD);
+            }
+        }
+        free(received);
+        printf("fbox_doorbell: %d senders, %d iterations of %d messages: ok\n", size - 1,
+               iterations, burst);
+    } else {
+        buf[0] = rank;
+        for (int i = 0; i < iterations; i++) {
+            buf[1] = i;
+            for (int j = 0; j < burst; j++) {
+                MPI_Send(buf, 4, MPI_INT, 0, 0, MPI_COMM_WORLD);
+            }
+            MPI_Recv(&ack, 1, MPI_INT, 0, 1, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+        }
+    }
+
+    MPI_Finalize();
+    return 0;
+}
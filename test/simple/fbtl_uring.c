@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+ * Reads and writes through an fbtl, blocking and nonblocking: empty
+ * transfers, contiguous ones up to a few MB, and transfers through an
+ * interleaved file view that hand many io entries to the fbtl at once.
+ * The collective calls go through the aggregation buffers, which fbtl/uring
+ * registers as fixed buffers. Each read is checked against the data that
+ * was written.
+ *
+ * A small submission queue makes fbtl/uring queue and resubmit entries:
+ *
+ *   mpirun -np 4 --mca io ompio --mca fbtl uring --mca fbtl_uring_entries 4 ./fbtl_uring [dir]
+ *
+ * The file is created in dir (default: the current directory), which has
+ * to be on a local file system for fbtl/uring to be selected.
+ */
+
+#include <mpi.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* file view: blocks of BLOCK ints, interleaved across the ranks */
+#define BLOCK 10
+
+static int rank, size, errors = 0;
+
+static void timeout(int sig)
+{
+    (void) sig;
+    fprintf(stderr, "fbtl_uring: timed out\n");
+    abort();
+}
+
+static int value(int pass, int i)
+{
+    return (pass * 7919 + rank) * 1000003 + i;
+}
+
+static void fill(int *buf, int count, int pass)
+{
+    for (int i = 0; i < count; i++) {
+        buf[i] = value(pass, i);
+    }
+}
+
+static void check(const char *what, const int *buf, int count, int pass, MPI_Status *status)
+{
+    int received;
+
+    MPI_Get_count(status, MPI_INT, &received);
+    if (received != count) {
+        fprintf(stderr, "%s (count %d, rank %d): %d elements transferred\n", what, count, rank,
+                received);
+        errors++;
+        return;
+    }
+    for (int i = 0; i < count; i++) {
+        if (buf[i] != value(pass, i)) {
+            fprintf(stderr, "%s (count %d, rank %d): element %d is %d\n", what, count, rank, i,
+                    buf[i]);
+            errors++;
+            return;
+        }
+    }
+}
+
+/* write count ints at offset, then read them back; pass changes the data */
+static void transfer(MPI_File fh, MPI_Offset offset, int count, int pass, int nonblocking,
+                     int collective)
+{
+    int *wbuf = malloc((count + 1) * sizeof(int)), *rbuf = malloc((count + 1) * sizeof(int));
+    const char *what = (collective ? (nonblocking ? "iwrite_at_all/iread_at_all"
+                                                  : "write_at_all/read_at_all")
+                                   : (nonblocking ? "iwrite_at/iread_at" : "write_at/read_at"));
+    MPI_Request req;
+    MPI_Status status;
+
+    fill(wbuf, count, pass);
+    memset(rbuf, 0xff, (count + 1) * sizeof(int));
+
+    if (nonblocking) {
+        if (collective) {
+            MPI_File_iwrite_at_all(fh, offset, wbuf, count, MPI_INT, &req);
+        } else {
+            MPI_File_iwrite_at(fh, offset, wbuf, count, MPI_INT, &req);
+        }
+        MPI_Wait(&req, &status);
+    } else if (collective) {
+        MPI_File_write_at_all(fh, offset, wbuf, count, MPI_INT, &status);
+    } else {
+        MPI_File_write_at(fh, offset, wbuf, count, MPI_INT, &status);
+    }
+    check(what, wbuf, count, pass, &status);
+
+    MPI_File_sync(fh);
+    MPI_Barrier(MPI_COMM_WORLD);
+    MPI_File_sync(fh);
+
+    if (nonblocking) {
+        if (collective) {
+            MPI_File_iread_at_all(fh, offset, rbuf, count, MPI_INT, &req);
+        } else {
+            MPI_File_iread_at(fh, offset, rbuf, count, MPI_INT, &req);
+        }
+        MPI_Wait(&req, &status);
+    } else if (collective) {
+        MPI_File_read_at_all(fh, offset, rbuf, count, MPI_INT, &status);
+    } else {
+        MPI_File_read_at(fh, offset, rbuf, count, MPI_INT, &status);
+    }
+    check(what, rbuf, count, pass, &status);
+    if (-1 != rbuf[count]) {
+        fprintf(stderr, "%s (count %d, rank %d): read past the end of the buffer\n", what, count,
+                rank);
+        errors++;
+    }
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    free(wbuf);
+    free(rbuf);
+}
+
+int main(int argc, char *argv[])
+{
+    const int counts[] = {0, 1, 1000, 1000 * 1000};
+    MPI_Datatype filetype, blocktype;
+    char path[4096];
+    MPI_File fh;
+    int all_errors, pass = 0;
+
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    signal(SIGALRM, timeout);
+    alarm(300);
+
+    snprintf(path, sizeof(path), "%s/fbtl_uring.dat", (1 < argc ? argv[1] : "."));
+    if (MPI_SUCCESS != MPI_File_open(MPI_COMM_WORLD, path,
+                                     MPI_MODE_CREATE | MPI_MODE_RDWR | MPI_MODE_DELETE_ON_CLOSE,
+                                     MPI_INFO_NULL, &fh)) {
+        fprintf(stderr, "fbtl_uring: cannot open %s\n", path);
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+
+    /* contiguous, each rank in its own part of the file */
+    for (int c = 0; c < 4; c++) {
+        MPI_Offset offset = (MPI_Offset) rank * counts[c] * sizeof(int);
+
+        for (int nonblocking = 0; nonblocking < 2; nonblocking++) {
+            for (int collective = 0; collective < 2; collective++) {
+                transfer(fh, offset, counts[c], pass++, nonblocking, collective);
+            }
+        }
+    }
+
+    /* interleaved blocks: one io entry per block */
+    MPI_Type_contiguous(BLOCK, MPI_INT, &blocktype);
+    MPI_Type_create_resized(blocktype, 0, (MPI_Aint) size * BLOCK * sizeof(int), &filetype);
+    MPI_Type_commit(&filetype);
+    MPI_File_set_view(fh, (MPI_Offset) rank * BLOCK * sizeof(int), MPI_INT, filetype, "native",
+                      MPI_INFO_NULL);
+    for (int c = 0; c < 4; c++) {
+        for (int nonblocking = 0; nonblocking < 2; nonblocking++) {
+            for (int collective = 0; collective < 2; collective++) {
+                transfer(fh, 0, counts[c], pass++, nonblocking, collective);
+            }
+        }
+    }
+    MPI_Type_free(&blocktype);
+    MPI_Type_free(&filetype);
+
+    MPI_File_close(&fh);
+
+    MPI_Allreduce(&errors, &all_errors, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+    if (0 == rank) {
+        printf("fbtl_uring: %s\n", (0 == all_errors ? "ok" : "FAILED"));
+    }
+
+    MPI_Finalize();
+    return (0 == all_errors ? 0 : 1);
+}
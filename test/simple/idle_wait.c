@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+ * Waits that go idle: rank 0 waits for a message that the other ranks
+ * send after a delay, long enough for the waiting thread to block once
+ * opal_progress_idle_spins idle calls are made. The wait must complete
+ * soon after the message is sent, whatever the transport: a thread
+ * blocked on one component must not sleep up to opal_progress_idle_timeout
+ * while the message arrives through another one. The waits go through
+ * MPI_Recv, MPI_Wait, MPI_Waitany and MPI_Waitall, each from one and from
+ * all the senders, and the ranks exchange the roles.
+ *
+ * With a 2 s idle timeout, a wait that is not woken up is easily told
+ * from one that is:
+ *
+ *   mpirun -np 2 --mca btl self,sm,tcp --mca opal_progress_idle_spins 100 \
+ *          --mca opal_progress_idle_timeout 2000000 ./idle_wait
+ *   mpirun -np 2 --mca btl self,sm,tcp --mca btl_sm_idle_wait 1 \
+ *          --mca opal_progress_idle_spins 100 --mca opal_progress_idle_timeout 2000000 ./idle_wait
+ *   mpirun -np 2 --mca btl self,tcp --mca opal_progress_idle_spins 100 \
+ *          --mca opal_progress_idle_timeout 2000000 ./idle_wait
+ *   mpirun -np 4 --mca opal_progress_idle_spins 100 --mca opal_progress_idle_timeout 2000000 \
+ *          ./idle_wait
+ */
+
+#include <mpi.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/* delay before sending, and the longest a wait may take after it */
+#define DELAY 0.05
+#define LATE 0.5
+#define NROUNDS 4
+
+enum { RECV, WAIT, WAITANY, WAITALL, NKINDS };
+
+static const char *kinds[] = {"MPI_Recv", "MPI_Wait", "MPI_Waitany", "MPI_Waitall"};
+static int rank, size, errors = 0;
+
+static void timeout(int sig)
+{
+    (void) sig;
+    fprintf(stderr, "idle_wait: timed out\n");
+    abort();
+}
+
+/* the waiter receives from the senders, one or all of them, which send
+ * after the delay */
+static void idle_wait(int waiter, int kind, int all)
+{
+    MPI_Request *reqs = malloc(size * sizeof(MPI_Request));
+    int *bufs = malloc(size * sizeof(int)), n = 0, index;
+    double start, elapsed;
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    if (rank != waiter) {
+        if (all || rank == (waiter + 1) % size) {
+            double now = MPI_Wtime();
+
+            while (MPI_Wtime() - now < DELAY) {
+                usleep(1000);
+            }
+            MPI_Send(&rank, 1, MPI_INT, waiter, kind, MPI_COMM_WORLD);
+        }
+        goto done;
+    }
+
+    start = MPI_Wtime();
+    for (int r = 0; r < size; r++) {
+        if (r == waiter || (!all && r != (waiter + 1) % size)) {
+            continue;
+        }
+        if (RECV == kind) {
+            MPI_Recv(&bufs[n++], 1, MPI_INT, r, kind, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+        } else {
+            MPI_Irecv(&bufs[n], 1, MPI_INT, r, kind, MPI_COMM_WORLD, &reqs[n]);
+            n++;
+        }
+    }
+    if (WAIT == kind) {
+        for (int i = 0; i < n; i++) {
+            MPI_Wait(&reqs[i], MPI_STATUS_IGNORE);
+        }
+    } else if (WAITANY == kind) {
+        for (int i = 0; i < n; i++) {
+            MPI_Waitany(n, reqs, &index, MPI_STATUS_IGNORE);
+        }
+    } else if (WAITALL == kind) {
+        MPI_Waitall(n, reqs, MPI_STATUSES_IGNORE);
+    }
+    elapsed = MPI_Wtime() - start;
+
+    if (elapsed > DELAY + LATE) {
+        fprintf(stderr, "idle_wait: %s from %s on rank %d took %.3f s for a message sent after "
+                "%.3f s\n", kinds[kind], (all ? "all the ranks" : "one rank"), rank, elapsed,
+                DELAY);
+        errors++;
+    }
+
+done:
+    free(reqs);
+    free(bufs);
+}
+
+int main(int argc, char *argv[])
+{
+    int all_errors;
+
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    if (size < 2) {
+        fprintf(stderr, "idle_wait: needs at least 2 processes\n");
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+
+    signal(SIGALRM, timeout);
+    alarm(300);
+
+    for (int round = 0; round < NROUNDS; round++) {
+        for (int kind = RECV; kind < NKINDS; kind++) {
+            for (int all = 0; all < 2; all++) {
+                idle_wait(round % size, kind, all);
+            }
+        }
+    }
+
+    MPI_Allreduce(&errors, &all_errors, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+    if (0 == rank) {
+        printf("idle_wait: %s\n", (0 == all_errors ? "ok" : "FAILED"));
+    }
+
+    MPI_Finalize();
+    return (0 == all_errors ? 0 : 1);
+}
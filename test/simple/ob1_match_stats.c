@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+ * The matching statistics of pml/ob1, read through MPI_T on a communicator
+ * where rank 0 receives from rank 1:
+ *
+ *  - NPOSTED receives are posted, then matched by messages sent in the
+ *    reverse order of their tags: pml_ob1_posted_recvq_hwm must be NPOSTED,
+ *    and pml_ob1_match_search_length must have recorded a search for each
+ *    message (the first one examining all the receives when the queues are
+ *    not sharded).
+ *  - NUNEXPECTED messages are queued as unexpected, then received:
+ *    pml_ob1_unexpected_msgq_hwm must be NUNEXPECTED, and
+ *    pml_ob1_unexpected_bytes must count at least their data while they
+ *    are queued, and go back to 0 once they are received.
+ *
+ * The performance variables only exist when Open MPI is configured with
+ * --enable-pml-ob1-match-stats; the test fails without them.
+ *
+ *   mpirun -np 2 --mca pml ob1 ./ob1_match_stats
+ *   mpirun -np 2 --mca pml ob1 --mca pml_ob1_matching_shards 4 ./ob1_match_stats
+ */
+
+#include <mpi.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#define NPOSTED 40
+#define NUNEXPECTED 6
+#define LENGTH 100
+#define SEARCH_BINS 8
+
+static MPI_T_pvar_session session;
+static int rank, errors = 0;
+
+static void timeout(int sig)
+{
+    (void) sig;
+    fprintf(stderr, "ob1_match_stats: timed out\n");
+    abort();
+}
+
+static MPI_T_pvar_handle pvar_alloc(const char *name, int var_class, MPI_Comm *comm, int count)
+{
+    MPI_T_pvar_handle handle;
+    int index, n;
+
+    if (MPI_SUCCESS != MPI_T_pvar_get_index(name, var_class, &index)) {
+        fprintf(stderr, "ob1_match_stats: %s not found, configure with "
+                "--enable-pml-ob1-match-stats\n", name);
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+    MPI_T_pvar_handle_alloc(session, index, comm, &handle, &n);
+    if (n != count) {
+        fprintf(stderr, "ob1_match_stats: %s has %d values instead of %d\n", name, n, count);
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+    return handle;
+}
+
+static uint64_t pvar_read(MPI_T_pvar_handle handle)
+{
+    unsigned long long value;
+
+    MPI_T_pvar_read(session, handle, &value);
+    return value;
+}
+
+static void expect(const char *what, uint64_t value, uint64_t min, uint64_t max)
+{
+    if (value < min || value > max) {
+        fprintf(stderr, "ob1_match_stats: %s is %llu, expected [%llu, %llu]\n", what,
+                (unsigned long long) value, (unsigned long long) min, (unsigned long long) max);
+        errors++;
+    }
+}
+
+/* the bin of the search histogram for a search of length receives */
+static int search_bin(int length)
+{
+    int bin = 0;
+
+    while (length && bin < SEARCH_BINS - 1) {
+        length >>= 1;
+        ++bin;
+    }
+    return bin;
+}
+
+/* number of matching shards, from the control variable */
+static int matching_shards(void)
+{
+    MPI_T_cvar_handle handle;
+    int index, count, shards = 0;
+
+    if (MPI_SUCCESS == MPI_T_cvar_get_index("pml_ob1_matching_shards", &index)) {
+        MPI_T_cvar_handle_alloc(index, NULL, &handle, &count);
+        MPI_T_cvar_read(handle, &shards);
+        MPI_T_cvar_handle_free(&handle);
+    }
+    return shards;
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned long long search[SEARCH_BINS], before[SEARCH_BINS];
+    MPI_T_pvar_handle posted_hwm, unexpected_hwm, unexpected_bytes, search_length;
+    MPI_Request reqs[NPOSTED];
+    int buf[NUNEXPECTED][LENGTH] = {{0}}, values[NPOSTED], provided, size, all_errors;
+    int bin = search_bin(NPOSTED);
+    uint64_t searches = 0;
+    MPI_Comm comm;
+
+    MPI_Init(&argc, &argv);
+    MPI_T_init_thread(MPI_THREAD_SINGLE, &provided);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    if (size < 2) {
+        fprintf(stderr, "ob1_match_stats: needs at least 2 processes\n");
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+
+    signal(SIGALRM, timeout);
+    alarm(120);
+
+    /* a new communicator, whose statistics start from 0 */
+    MPI_Comm_dup(MPI_COMM_WORLD, &comm);
+    MPI_T_pvar_session_create(&session);
+    posted_hwm = pvar_alloc("pml_ob1_posted_recvq_hwm", MPI_T_PVAR_CLASS_HIGHWATERMARK, &comm, 1);
+    unexpected_hwm = pvar_alloc("pml_ob1_unexpected_msgq_hwm", MPI_T_PVAR_CLASS_HIGHWATERMARK,
+                                &comm, 1);
+    unexpected_bytes = pvar_alloc("pml_ob1_unexpected_bytes", MPI_T_PVAR_CLASS_SIZE, &comm, 1);
+    search_length = pvar_alloc("pml_ob1_match_search_length", MPI_T_PVAR_CLASS_COUNTER, &comm,
+                               SEARCH_BINS);
+
+    /* posted receives, matched in the reverse order */
+    if (0 == rank) {
+        MPI_T_pvar_read(session, search_length, before);
+        for (int i = 0; i < NPOSTED; i++) {
+            MPI_Irecv(&values[i], 1, MPI_INT, 1, i, comm, &reqs[i]);
+        }
+        expect("posted_recvq_hwm with the receives posted", pvar_read(posted_hwm), NPOSTED,
+               NPOSTED);
+    }
+    MPI_Barrier(MPI_COMM_WORLD);
+    if (0 == rank) {
+        MPI_Waitall(NPOSTED, reqs, MPI_STATUSES_IGNORE);
+        expect("posted_recvq_hwm once matched", pvar_read(posted_hwm), NPOSTED, NPOSTED);
+
+        MPI_T_pvar_read(session, search_length, search);
+        for (int b = 0; b < SEARCH_BINS; b++) {
+            searches += search[b] - before[b];
+        }
+        /* the unexpected messages that follow may be searched already */
+        expect("match_search_length searches", searches, NPOSTED, NPOSTED + NUNEXPECTED);
+        /* with a single queue per peer, the first message examines all
+         * the receives */
+        if (0 == matching_shards() && search[bin] == before[bin]) {
+            fprintf(stderr, "ob1_match_stats: no search of the %d posted receives recorded\n",
+                    NPOSTED);
+            errors++;
+        }
+    } else if (1 == rank) {
+        for (int i = NPOSTED - 1; i >= 0; i--) {
+            MPI_Send(&i, 1, MPI_INT, 0, i, comm);
+        }
+    }
+
+    /* unexpected messages, all queued before the first one is received */
+    if (1 == rank) {
+        for (int i = 0; i < NUNEXPECTED; i++) {
+            MPI_Send(buf[i], LENGTH, MPI_INT, 0, i, comm);
+        }
+    }
+    MPI_Barrier(MPI_COMM_WORLD);
+    if (0 == rank) {
+        /* the messages are matched in order: once the last one is there,
+         * all of them are */
+        MPI_Probe(1, NUNEXPECTED - 1, comm, MPI_STATUS_IGNORE);
+        expect("unexpected_msgq_hwm with the messages queued", pvar_read(unexpected_hwm),
+               NUNEXPECTED, NUNEXPECTED);
+        expect("unexpected_bytes with the messages queued", pvar_read(unexpected_bytes),
+               NUNEXPECTED * LENGTH * sizeof(int), UINT64_MAX);
+        for (int i = 0; i < NUNEXPECTED; i++) {
+            MPI_Recv(buf[i], LENGTH, MPI_INT, 1, i, comm, MPI_STATUS_IGNORE);
+        }
+        expect("unexpected_msgq_hwm once received", pvar_read(unexpected_hwm), NUNEXPECTED,
+               NUNEXPECTED);
+        expect("unexpected_bytes once received", pvar_read(unexpected_bytes), 0, 0);
+    }
+
+    MPI_T_pvar_handle_free(session, &posted_hwm);
+    MPI_T_pvar_handle_free(session, &unexpected_hwm);
+    MPI_T_pvar_handle_free(session, &unexpected_bytes);
+    MPI_T_pvar_handle_free(session, &search_length);
+    MPI_T_pvar_session_free(&session);
+    MPI_Comm_free(&comm);
+
+    MPI_Allreduce(&errors, &all_errors, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+    if (0 == rank) {
+        printf("ob1_match_stats: %s\n", (0 == all_errors ? "ok" : "FAILED"));
+    }
+
+    MPI_T_finalize();
+    MPI_Finalize();
+    return (0 == all_errors ? 0 : 1);
+}
@@ -0,0 +1,483 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+ * Message matching: receives with a specific source and tag, MPI_ANY_SOURCE,
+ * MPI_ANY_TAG and both, posted before the messages arrive or after they
+ * were queued as unexpected, checking that the messages of each sender are
+ * matched in the order they were sent (non-overtaking). Rank 0 receives,
+ * the other ranks send; every 16th message is large enough to go through
+ * the rendezvous protocol.
+ *
+ *  - single sender: receive i is built to match message i, so the order
+ *    in which receives and messages are matched is fully determined, for
+ *    all the combinations of wildcards.
+ *  - all the senders, posted receives: the receives name their source,
+ *    so the order is determined per source, and the sources land in
+ *    different matching shards.
+ *  - all the senders, unexpected messages: each receive, or MPI_Probe
+ *    followed by a receive for the probed envelope, or MPI_Improbe followed
+ *    by MPI_Mrecv, must get the earliest message it can match from the
+ *    source it matched.
+ *  - single sender, cancelled receives: receives that never match are
+ *    posted in between the others, and cancelled before the messages
+ *    arrive or once they were all matched.
+ *
+ * Each test runs on a communicator without assertions, and on ones
+ * asserting mpi_assert_no_any_source or mpi_assert_no_any_tag (with the
+ * receives restricted accordingly), which select how ob1 keys the shards.
+ * All of them run once more with the ompi_pml_ob1_matching info key set to
+ * "hash", which selects the hash matching engine on the communicators that
+ * are not sharded. With the automatic engine selection and a low threshold,
+ * the communicators switch to hash matching while receives are posted and
+ * messages are queued as unexpected. The ranks synchronize on
+ * MPI_COMM_WORLD, so that the tested communicator only carries the
+ * messages that are matched.
+ *
+ *   mpirun -np 4 --mca pml ob1 --mca pml_ob1_matching_shards 8 ./ob1_matching
+ *   mpirun -np 4 --mca pml ob1 --mca pml_ob1_matching_engine hash ./ob1_matching
+ *   mpirun -np 4 --mca pml ob1 --mca pml_ob1_matching_engine auto \
+ *          --mca pml_ob1_hash_matching_threshold 4 ./ob1_matching
+ *   mpirun -np 4 --mca pml ob1 ./ob1_matching
+ */
+
+#include <mpi.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define NMSGS 400
+#define NTAGS 8
+#define LARGE (64 * 1024)
+
+/* restrictions of the communicator, and so of the receives */
+enum { ASSERT_NONE, ASSERT_NO_ANY_SOURCE, ASSERT_NO_ANY_TAG };
+
+/* how the unexpected messages are received */
+enum { RECV, PROBE_RECV, IMPROBE_MRECV };
+
+static int rank, size, errors = 0;
+
+static void timeout(int sig)
+{
+    (void) sig;
+    fprintf(stderr, "ob1_matching: timed out, a message was not matched\n");
+    abort();
+}
+
+static int tag_of(int source, int seq)
+{
+    return (seq * 7 + source) % NTAGS;
+}
+
+static int len_of(int seq)
+{
+    return (5 == seq % 16) ? (int) (LARGE / sizeof(int)) : 2;
+}
+
+/* the patterns of the receives: pick source and tag, or wildcards, for a
+ * receive that can match the message seq of source */
+static void pattern(unsigned *seed, int restrict_to, int source, int seq, int *rsource,
+                    int *rtag)
+{
+    int p = rand_r(seed) % 4;
+
+    *rsource = ((p & 1) && ASSERT_NO_ANY_SOURCE != restrict_to) ? MPI_ANY_SOURCE : source;
+    *rtag = ((p & 2) && ASSERT_NO_ANY_TAG != restrict_to) ? MPI_ANY_TAG : tag_of(source, seq);
+}
+
+/* a buffer for each of the n messages of the sequence numbers seqs */
+static int **alloc_bufs(int n, int (*seq)(int))
+{
+    int **bufs = malloc(n * sizeof(int *));
+
+    for (int k = 0; k < n; k++) {
+        bufs[k] = calloc(len_of(seq(k)), sizeof(int));
+    }
+    return bufs;
+}
+
+static void free_bufs(int **bufs, int n)
+{
+    for (int k = 0; k < n; k++) {
+        free(bufs[k]);
+    }
+    free(bufs);
+}
+
+static int seq_single(int k)
+{
+    return k;
+}
+
+static int seq_interleaved(int k)
+{
+    return k / (size - 1);
+}
+
+/* with nonblocking, all the messages are queued as unexpected at the
+ * receiver by the time the barrier completes there */
+static void send_all(MPI_Comm comm, int nonblocking)
+{
+    MPI_Request *reqs = malloc(NMSGS * sizeof(MPI_Request));
+    int **bufs = alloc_bufs(NMSGS, seq_single);
+
+    for (int j = 0; j < NMSGS; j++) {
+        bufs[j][0] = rank;
+        bufs[j][1] = j;
+        if (nonblocking) {
+            MPI_Isend(bufs[j], len_of(j), MPI_INT, 0, tag_of(rank, j), comm, &reqs[j]);
+        } else {
+            MPI_Send(bufs[j], len_of(j), MPI_INT, 0, tag_of(rank, j), comm);
+        }
+    }
+    if (nonblocking) {
+        MPI_Barrier(MPI_COMM_WORLD);
+        MPI_Waitall(NMSGS, reqs, MPI_STATUSES_IGNORE);
+    }
+    free(reqs);
+    free_bufs(bufs, NMSGS);
+}
+
+static int check_status(const char *test, int *data, MPI_Status *status, int rsource, int rtag)
+{
+    int count;
+
+    MPI_Get_count(status, MPI_INT, &count);
+    if (data[0] != status->MPI_SOURCE || data[1] < 0 || data[1] >= NMSGS
+        || status->MPI_TAG != tag_of(data[0], data[1]) || count != len_of(data[1])
+        || (MPI_ANY_SOURCE != rsource && rsource != data[0])
+        || (MPI_ANY_TAG != rtag && rtag != status->MPI_TAG)) {
+        fprintf(stderr, "%s: message %d of %d (tag %d, %d ints) does not fit the receive "
+                "(source %d, tag %d)\n", test, data[1], data[0], status->MPI_TAG, count, rsource,
+                rtag);
+        errors++;
+        return 0;
+    }
+    return 1;
+}
+
+/* one sender, receive i matches message i */
+static void single_sender(MPI_Comm comm, int restrict_to, int unexpected, unsigned seed)
+{
+    const char *test = unexpected ? "single sender, unexpected" : "single sender, posted";
+    int *rsources = malloc(NMSGS * sizeof(int)), *rtags = malloc(NMSGS * sizeof(int));
+    MPI_Request *reqs = malloc(NMSGS * sizeof(MPI_Request));
+    MPI_Status *statuses = malloc(NMSGS * sizeof(MPI_Status));
+    int **bufs = alloc_bufs(NMSGS, seq_single);
+
+    if (0 != rank) {
+        if (!unexpected) {
+            MPI_Barrier(MPI_COMM_WORLD);
+        }
+        if (1 == rank) {
+            send_all(comm, unexpected);
+        } else if (unexpected) {
+            MPI_Barrier(MPI_COMM_WORLD);
+        }
+        goto done;
+    }
+
+    if (unexpected) {
+        MPI_Barrier(MPI_COMM_WORLD);
+    }
+    for (int j = 0; j < NMSGS; j++) {
+        pattern(&seed, restrict_to, 1, j, &rsources[j], &rtags[j]);
+        MPI_Irecv(bufs[j], len_of(j), MPI_INT, rsources[j], rtags[j], comm, &reqs[j]);
+    }
+    if (!unexpected) {
+        /* the sender starts once all the receives are posted */
+        MPI_Barrier(MPI_COMM_WORLD);
+    }
+    MPI_Waitall(NMSGS, reqs, statuses);
+
+    for (int j = 0; j < NMSGS; j++) {
+        if (check_status(test, bufs[j], &statuses[j], rsources[j], rtags[j]) && bufs[j][1] != j) {
+            fprintf(stderr, "%s: receive %d (source %d, tag %d) got message %d\n", test, j,
+                    rsources[j], rtags[j], bufs[j][1]);
+            errors++;
+        }
+    }
+
+done:
+    free(rsources);
+    free(rtags);
+    free(reqs);
+    free(statuses);
+    free_bufs(bufs, NMSGS);
+}
+
+/* all the senders, receives naming their source posted in advance */
+static void posted_by_source(MPI_Comm comm, int restrict_to, unsigned seed)
+{
+    const char *test = "all senders, posted";
+    int n = (size - 1) * NMSGS;
+    int *rtags = malloc(n * sizeof(int));
+    MPI_Request *reqs = malloc(n * sizeof(MPI_Request));
+    MPI_Status *statuses = malloc(n * sizeof(MPI_Status));
+    int **bufs = alloc_bufs(n, seq_interleaved);
+
+    if (0 != rank) {
+        MPI_Barrier(MPI_COMM_WORLD);
+        send_all(comm, 0);
+        goto done;
+    }
+
+    /* the receives of the senders interleaved, in order for each of them */
+    for (int k = 0; k < n; k++) {
+        int s = 1 + k % (size - 1), j = k / (size - 1), rsource;
+
+        pattern(&seed, ASSERT_NO_ANY_SOURCE, s, j, &rsource, &rtags[k]);
+        if (ASSERT_NO_ANY_TAG == restrict_to) {
+            rtags[k] = tag_of(s, j);
+        }
+        MPI_Irecv(bufs[k], len_of(j), MPI_INT, s, rtags[k], comm, &reqs[k]);
+    }
+    MPI_Barrier(MPI_COMM_WORLD);
+    MPI_Waitall(n, reqs, statuses);
+
+    for (int k = 0; k < n; k++) {
+        int s = 1 + k % (size - 1), j = k / (size - 1);
+
+        if (check_status(test, bufs[k], &statuses[k], s, rtags[k]) && bufs[k][1] != j) {
+            fprintf(stderr, "%s: receive %d for %d (tag %d) got message %d\n", test, j, s,
+                    rtags[k], bufs[k][1]);
+            errors++;
+        }
+    }
+
+done:
+    free(rtags);
+    free(reqs);
+    free(statuses);
+    free_bufs(bufs, n);
+}
+
+/* all the senders, blocking receives of the unexpected messages */
+static void unexpected_any(MPI_Comm comm, int restrict_to, int how, unsigned seed)
+{
+    const char *tests[] = {"all senders, unexpected", "all senders, probe",
+                           "all senders, improbe"};
+    const char *test = tests[how];
+    char *received = calloc((size_t) size * NMSGS, 1);
+    int *buf = malloc(LARGE), remaining = (size - 1) * NMSGS;
+
+    if (0 != rank) {
+        send_all(comm, 1);
+        goto done;
+    }
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    while (remaining > 0) {
+        int s, j, rsource, rtag, first, flag = 0, pcount, count;
+        MPI_Status status, pstatus;
+        MPI_Message message;
+
+        /* build the receive from a message not received yet */
+        do {
+            s = 1 + rand_r(&seed) % (size - 1);
+            j = rand_r(&seed) % NMSGS;
+        } while (received[s * NMSGS + j]);
+        pattern(&seed, restrict_to, s, j, &rsource, &rtag);
+
+        if (PROBE_RECV == how) {
+            /* the earliest message with the probed envelope is the probed one */
+            MPI_Probe(rsource, rtag, comm, &pstatus);
+            MPI_Recv(buf, LARGE / sizeof(int), MPI_INT, pstatus.MPI_SOURCE, pstatus.MPI_TAG, comm,
+                     &status);
+        } else if (IMPROBE_MRECV == how) {
+            while (!flag) {
+                MPI_Improbe(rsource, rtag, comm, &flag, &message, &pstatus);
+            }
+            MPI_Mrecv(buf, LARGE / sizeof(int), MPI_INT, &message, &status);
+        } else {
+            MPI_Recv(buf, LARGE / sizeof(int), MPI_INT, rsource, rtag, comm, &status);
+        }
+        if (!check_status(test, buf, &status, rsource, rtag)) {
+            break;
+        }
+        if (RECV != how) {
+            MPI_Get_count(&pstatus, MPI_INT, &pcount);
+            MPI_Get_count(&status, MPI_INT, &count);
+            if (pstatus.MPI_SOURCE != status.MPI_SOURCE || pstatus.MPI_TAG != status.MPI_TAG
+                || pcount != count) {
+                fprintf(stderr, "%s: probed (source %d, tag %d, %d ints), received message %d "
+                        "of %d\n", test, pstatus.MPI_SOURCE, pstatus.MPI_TAG, pcount, buf[1],
+                        buf[0]);
+                errors++;
+            }
+        }
+
+        /* the earliest message of that source the receive could match */
+        s = buf[0];
+        for (first = 0; first < NMSGS; first++) {
+            if (!received[s * NMSGS + first]
+                && (MPI_ANY_TAG == rtag || rtag == tag_of(s, first))) {
+                break;
+            }
+        }
+        if (first != buf[1]) {
+            fprintf(stderr, "%s: receive (source %d, tag %d) got message %d of %d instead of %d\n",
+                    test, rsource, rtag, buf[1], s, first);
+            errors++;
+        }
+        if (received[s * NMSGS + buf[1]]) {
+            fprintf(stderr, "%s: message %d of %d received twice\n", test, buf[1], s);
+            errors++;
+            break;
+        }
+        received[s * NMSGS + buf[1]] = 1;
+        remaining--;
+    }
+
+done:
+    free(received);
+    free(buf);
+}
+
+/* one sender, receive i matches message i; receives for tags that are not
+ * sent are posted in between, and cancelled before the first message is
+ * sent (the even ones) or once all the messages are matched (the odd ones) */
+static void cancelled(MPI_Comm comm, int restrict_to, unsigned seed)
+{
+    const char *test = "single sender, cancelled";
+    int *rsources = malloc(NMSGS * sizeof(int)), *rtags = malloc(NMSGS * sizeof(int));
+    MPI_Request *reqs = malloc(NMSGS * sizeof(MPI_Request));
+    MPI_Request *decoys = malloc(NMSGS * sizeof(MPI_Request));
+    MPI_Status *statuses = malloc(NMSGS * sizeof(MPI_Status));
+    int **bufs = alloc_bufs(NMSGS, seq_single), last[2] = {-1, -1};
+    MPI_Status status;
+
+    if (0 != rank) {
+        MPI_Barrier(MPI_COMM_WORLD);
+        if (1 == rank) {
+            send_all(comm, 0);
+        }
+        /* then a message for the tag of the cancelled receives */
+        MPI_Barrier(MPI_COMM_WORLD);
+        if (1 == rank) {
+            last[0] = rank;
+            last[1] = NMSGS;
+            MPI_Send(last, 2, MPI_INT, 0, NTAGS, comm);
+        }
+        goto done;
+    }
+
+    for (int j = 0; j < NMSGS; j++) {
+        int dsource = (ASSERT_NO_ANY_SOURCE != restrict_to && (rand_r(&seed) & 1)) ? MPI_ANY_SOURCE
+                                                                                    : 1;
+
+        MPI_Irecv(&last[j % 2], 1, MPI_INT, dsource, NTAGS + j % 3, comm, &decoys[j]);
+        pattern(&seed, restrict_to, 1, j, &rsources[j], &rtags[j]);
+        MPI_Irecv(bufs[j], len_of(j), MPI_INT, rsources[j], rtags[j], comm, &reqs[j]);
+    }
+    for (int j = 0; j < NMSGS; j += 2) {
+        MPI_Cancel(&decoys[j]);
+    }
+    MPI_Barrier(MPI_COMM_WORLD);
+    MPI_Waitall(NMSGS, reqs, statuses);
+    for (int j = 1; j < NMSGS; j += 2) {
+        MPI_Cancel(&decoys[j]);
+    }
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    for (int j = 0; j < NMSGS; j++) {
+        int flag;
+
+        MPI_Wait(&decoys[j], &status);
+        MPI_Test_cancelled(&status, &flag);
+        if (!flag) {
+            fprintf(stderr, "%s: receive for tag %d not cancelled\n", test, NTAGS + j % 3);
+            errors++;
+        }
+        if (check_status(test, bufs[j], &statuses[j], rsources[j], rtags[j]) && bufs[j][1] != j) {
+            fprintf(stderr, "%s: receive %d (source %d, tag %d) got message %d\n", test, j,
+                    rsources[j], rtags[j], bufs[j][1]);
+            errors++;
+        }
+    }
+
+    MPI_Recv(last, 2, MPI_INT, 1, NTAGS, comm, &status);
+    if (1 != last[0] || NMSGS != last[1]) {
+        fprintf(stderr, "%s: the message for the cancelled receives holds %d %d\n", test,
+                last[0], last[1]);
+        errors++;
+    }
+
+done:
+    free(rsources);
+    free(rtags);
+    free(reqs);
+    free(decoys);
+    free(statuses);
+    free_bufs(bufs, NMSGS);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *names[] = {"no assertion", "mpi_assert_no_any_source", "mpi_assert_no_any_tag"};
+    int all_errors;
+
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    if (size < 2) {
+        fprintf(stderr, "ob1_matching: needs at least 2 processes\n");
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+
+    signal(SIGALRM, timeout);
+    alarm(600);
+
+    for (int hash = 0; hash < 2; hash++) {
+        for (int a = ASSERT_NONE; a <= ASSERT_NO_ANY_TAG; a++) {
+            MPI_Info info;
+            MPI_Comm comm;
+            int before = errors;
+
+            MPI_Info_create(&info);
+            if (ASSERT_NONE != a) {
+                MPI_Info_set(info, names[a], "true");
+            }
+            if (hash) {
+                MPI_Info_set(info, "ompi_pml_ob1_matching", "hash");
+            }
+            MPI_Comm_dup_with_info(MPI_COMM_WORLD, info, &comm);
+            MPI_Info_free(&info);
+
+            for (unsigned seed = 1; seed <= 3; seed++) {
+                single_sender(comm, a, 0, seed);
+                single_sender(comm, a, 1, seed);
+                posted_by_source(comm, a, seed);
+                for (int how = RECV; how <= IMPROBE_MRECV; how++) {
+                    unexpected_any(comm, a, how, seed);
+                }
+                cancelled(comm, a, seed);
+            }
+
+            MPI_Comm_free(&comm);
+            if (errors != before) {
+                fprintf(stderr, "ob1_matching: rank %d: errors with %s%s\n", rank, names[a],
+                        hash ? ", hash matching" : "");
+            }
+        }
+    }
+
+    MPI_Allreduce(&errors, &all_errors, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+    if (0 == rank) {
+        printf("ob1_matching: %s\n", (0 == all_errors ? "ok" : "FAILED"));
+    }
+
+    MPI_Finalize();
+    return (0 == all_errors ? 0 : 1);
+}
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+ * Persistent collectives: MPI_Allreduce_init (out of place and in place)
+ * and MPI_Bcast_init, each started several times with new data, and two
+ * requests started together with MPI_Startall. Small messages, and
+ * messages large enough to be split in several steps, are used.
+ *
+ * The started requests are advanced from the progress engine by the
+ * component that provides them; run the test through each of them:
+ *
+ *   mpirun -np 4 --mca coll basic,libnbc,tuned ./persistent_coll
+ *   mpirun -np 4 --mca coll basic,libnbc,tuned,han --mca coll_han_priority 100 ./persistent_coll
+ *   mpirun -np 4 --mca coll basic,libnbc,xhc --mca coll_xhc_priority 100 ./persistent_coll
+ */
+
+#include <mpi.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#define NSTARTS 5
+
+static int rank, size, errors = 0;
+
+static void timeout(int sig)
+{
+    (void) sig;
+    fprintf(stderr, "persistent_coll: timed out\n");
+    abort();
+}
+
+static int value(int r, int start, int i)
+{
+    return (r + 1) * (start + 1) + i % 1000;
+}
+
+/* the sum of value() over all the ranks */
+static int sum(int start, int i)
+{
+    return (size * (size + 1) / 2) * (start + 1) + size * (i % 1000);
+}
+
+static void check(const char *coll, const int *buf, int count, int start, int root)
+{
+    for (int i = 0; i < count; i++) {
+        int expected = (root < 0 ? sum(start, i) : value(root, start, i));
+
+        if (buf[i] != expected) {
+            fprintf(stderr, "%s (count %d, rank %d, start %d): element %d is %d instead of %d\n",
+                    coll, count, rank, start, i, buf[i], expected);
+            errors++;
+            return;
+        }
+    }
+}
+
+static void allreduce(int count)
+{
+    int *sbuf = calloc(count, sizeof(int)), *rbuf = calloc(count, sizeof(int));
+    MPI_Request req;
+
+    MPI_Allreduce_init(sbuf, rbuf, count, MPI_INT, MPI_SUM, MPI_COMM_WORLD, MPI_INFO_NULL, &req);
+    for (int s = 0; s < NSTARTS; s++) {
+        for (int i = 0; i < count; i++) {
+            sbuf[i] = value(rank, s, i);
+            rbuf[i] = -1;
+        }
+        MPI_Start(&req);
+        MPI_Wait(&req, MPI_STATUS_IGNORE);
+        check("allreduce_init", rbuf, count, s, -1);
+    }
+    MPI_Request_free(&req);
+
+    MPI_Allreduce_init(MPI_IN_PLACE, rbuf, count, MPI_INT, MPI_SUM, MPI_COMM_WORLD,
+                       MPI_INFO_NULL, &req);
+    for (int s = 0; s < NSTARTS; s++) {
+        for (int i = 0; i < count; i++) {
+            rbuf[i] = value(rank, s, i);
+        }
+        MPI_Start(&req);
+        MPI_Wait(&req, MPI_STATUS_IGNORE);
+        check("allreduce_init in place", rbuf, count, s, -1);
+    }
+    MPI_Request_free(&req);
+
+    free(sbuf);
+    free(rbuf);
+}
+
+static void bcast(int count)
+{
+    int *buf = calloc(count, sizeof(int));
+    MPI_Request req;
+
+    for (int root = 0; root < size; root += (size > 2 ? size - 1 : 1)) {
+        MPI_Bcast_init(buf, count, MPI_INT, root, MPI_COMM_WORLD, MPI_INFO_NULL, &req);
+        for (int s = 0; s < NSTARTS; s++) {
+            for (int i = 0; i < count; i++) {
+                buf[i] = (rank == root ? value(root, s, i) : -1);
+            }
+            MPI_Start(&req);
+            MPI_Wait(&req, MPI_STATUS_IGNORE);
+            check("bcast_init", buf, count, s, root);
+        }
+        MPI_Request_free(&req);
+    }
+
+    free(buf);
+}
+
+/* an allreduce and a bcast in flight at the same time */
+static void startall(int count)
+{
+    int *sbuf = calloc(count, sizeof(int)), *rbuf = calloc(count, sizeof(int));
+    int *buf = calloc(count, sizeof(int));
+    MPI_Request reqs[2];
+
+    MPI_Allreduce_init(sbuf, rbuf, count, MPI_INT, MPI_SUM, MPI_COMM_WORLD, MPI_INFO_NULL,
+                       &reqs[0]);
+    MPI_Bcast_init(buf, count, MPI_INT, 0, MPI_COMM_WORLD, MPI_INFO_NULL, &reqs[1]);
+    for (int s = 0; s < NSTARTS; s++) {
+        for (int i = 0; i < count; i++) {
+            sbuf[i] = value(rank, s, i);
+            rbuf[i] = -1;
+            buf[i] = (0 == rank ? value(0, s, i) : -1);
+        }
+        MPI_Startall(2, reqs);
+        MPI_Waitall(2, reqs, MPI_STATUSES_IGNORE);
+        check("startall allreduce_init", rbuf, count, s, -1);
+        check("startall bcast_init", buf, count, s, 0);
+    }
+    MPI_Request_free(&reqs[0]);
+    MPI_Request_free(&reqs[1]);
+
+    free(sbuf);
+    free(rbuf);
+    free(buf);
+}
+
+int main(int argc, char *argv[])
+{
+    const int counts[] = {1, 7, 1000, 300000};
+    int all_errors;
+
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    signal(SIGALRM, timeout);
+    alarm(300);
+
+    for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++) {
+        allreduce(counts[c]);
+        bcast(counts[c]);
+        startall(counts[c]);
+    }
+
+    MPI_Allreduce(&errors, &all_errors, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+    if (0 == rank) {
+        printf("persistent_coll: %s\n", (0 == all_errors ? "ok" : "FAILED"));
+    }
+
+    MPI_Finalize();
+    return (0 == all_errors ? 0 : 1);
+}
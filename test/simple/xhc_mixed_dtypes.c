@@ -0,0 +1,277 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+ * Data exchange collectives where the ranks pass different datatypes with
+ * the same type signature: MPI_INT on some ranks, an MPI_INT resized to
+ * twice its extent on the others. In the rooted collectives either the
+ * root alone, or all the ranks but the root, use the resized type. Both
+ * small messages and messages above coll_xhc_cico_max are exchanged.
+ *
+ * The ranks that use different datatypes must still agree on the
+ * algorithm; if they do not, the test hangs and is stopped by the alarm.
+ *
+ *   mpirun -np 8 --mca coll basic,libnbc,xhc --mca coll_xhc_priority 100 ./xhc_mixed_dtypes
+ */
+
+#include <mpi.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+static MPI_Datatype resized;
+static int rank, size, errors = 0;
+
+static void timeout(int sig)
+{
+    (void) sig;
+    fprintf(stderr, "xhc_mixed_dtypes: timed out, the ranks did not agree on the algorithm\n");
+    abort();
+}
+
+static int value(int block, int i)
+{
+    return block * 100003 + i;
+}
+
+/* the buffers of a stride of 2 are described by the resized type */
+static MPI_Datatype dtype_of(int stride)
+{
+    return (1 == stride ? MPI_INT : resized);
+}
+
+static int *alloc_buf(int n, int stride)
+{
+    int *buf = malloc((n * stride + 1) * sizeof(int));
+
+    for (int i = 0; i < n * stride + 1; i++) {
+        buf[i] = -1;
+    }
+    return buf;
+}
+
+static void fill(int *buf, int stride, int first, int n, int block)
+{
+    for (int i = 0; i < n; i++) {
+        buf[(first + i) * stride] = value(block, i);
+    }
+}
+
+static void check(const char *coll, const int *buf, int stride, int first, int n, int block,
+                  int count)
+{
+    for (int i = 0; i < n; i++) {
+        if (buf[(first + i) * stride] != value(block, i)) {
+            fprintf(stderr, "%s (count %d, rank %d, stride %d): element %d of block %d is %d\n",
+                    coll, count, rank, stride, i, block, buf[(first + i) * stride]);
+            errors++;
+            return;
+        }
+    }
+    /* the gaps of the resized type are not written */
+    for (int i = 0; 2 == stride && i < n; i++) {
+        if (-1 != buf[(first + i) * stride + 1]) {
+            fprintf(stderr, "%s (count %d, rank %d): gap after element %d of block %d written\n",
+                    coll, count, rank, i, block);
+            errors++;
+            return;
+        }
+    }
+}
+
+/* counts and displacements of the v variants, with a gap between blocks */
+static int vcount(int count, int a, int b)
+{
+    return count + (a + b) % 3;
+}
+
+static void rooted(int count, int root, int root_stride, int leaf_stride)
+{
+    int stride = (rank == root ? root_stride : leaf_stride);
+    int *counts = malloc(size * sizeof(int)), *displs = malloc(size * sizeof(int));
+    int *sbuf, *rbuf, total = 0;
+
+    for (int r = 0; r < size; r++) {
+        counts[r] = vcount(count, r, 0);
+        displs[r] = total;
+        total += counts[r] + 1;
+    }
+
+    /* gather, and gather with MPI_IN_PLACE at the root */
+    for (int in_place = 0; in_place < 2; in_place++) {
+        sbuf = alloc_buf(count, stride);
+        rbuf = alloc_buf(size * count, stride);
+        fill(sbuf, stride, 0, count, rank);
+        if (in_place && rank == root) {
+            fill(rbuf, stride, root * count, count, root);
+        }
+        MPI_Gather((in_place && rank == root) ? MPI_IN_PLACE : sbuf, count, dtype_of(stride),
+                   rbuf, count, dtype_of(stride), root, MPI_COMM_WORLD);
+        for (int r = 0; rank == root && r < size; r++) {
+            check(in_place ? "gather in place" : "gather", rbuf, stride, r * count, count, r,
+                  count);
+        }
+        free(sbuf);
+        free(rbuf);
+    }
+
+    sbuf = alloc_buf(counts[rank], stride);
+    rbuf = alloc_buf(total, stride);
+    fill(sbuf, stride, 0, counts[rank], rank);
+    MPI_Gatherv(sbuf, counts[rank], dtype_of(stride), rbuf, counts, displs, dtype_of(stride),
+                root, MPI_COMM_WORLD);
+    for (int r = 0; rank == root && r < size; r++) {
+        check("gatherv", rbuf, stride, displs[r], counts[r], r, count);
+    }
+    free(sbuf);
+    free(rbuf);
+
+    sbuf = alloc_buf(size * count, stride);
+    rbuf = alloc_buf(count, stride);
+    for (int r = 0; rank == root && r < size; r++) {
+        fill(sbuf, stride, r * count, count, r);
+    }
+    MPI_Scatter(sbuf, count, dtype_of(stride), rbuf, count, dtype_of(stride), root,
+                MPI_COMM_WORLD);
+    check("scatter", rbuf, stride, 0, count, rank, count);
+    free(sbuf);
+    free(rbuf);
+
+    sbuf = alloc_buf(total, stride);
+    rbuf = alloc_buf(counts[rank], stride);
+    for (int r = 0; rank == root && r < size; r++) {
+        fill(sbuf, stride, displs[r], counts[r], r);
+    }
+    MPI_Scatterv(sbuf, counts, displs, dtype_of(stride), rbuf, counts[rank], dtype_of(stride),
+                 root, MPI_COMM_WORLD);
+    check("scatterv", rbuf, stride, 0, counts[rank], rank, count);
+    free(sbuf);
+    free(rbuf);
+
+    free(counts);
+    free(displs);
+}
+
+static void unrooted(int count, int stride)
+{
+    int *scounts = malloc(size * sizeof(int)), *sdispls = malloc(size * sizeof(int));
+    int *rcounts = malloc(size * sizeof(int)), *rdispls = malloc(size * sizeof(int));
+    int *sbuf, *rbuf, stotal = 0, rtotal = 0;
+
+    /* allgather, and allgather with MPI_IN_PLACE */
+    for (int in_place = 0; in_place < 2; in_place++) {
+        sbuf = alloc_buf(count, stride);
+        rbuf = alloc_buf(size * count, stride);
+        fill(sbuf, stride, 0, count, rank);
+        if (in_place) {
+            fill(rbuf, stride, rank * count, count, rank);
+        }
+        MPI_Allgather(in_place ? MPI_IN_PLACE : sbuf, count, dtype_of(stride), rbuf, count,
+                      dtype_of(stride), MPI_COMM_WORLD);
+        for (int r = 0; r < size; r++) {
+            check(in_place ? "allgather in place" : "allgather", rbuf, stride, r * count, count,
+                  r, count);
+        }
+        free(sbuf);
+        free(rbuf);
+    }
+
+    for (int r = 0; r < size; r++) {
+        rcounts[r] = vcount(count, r, 0);
+        rdispls[r] = rtotal;
+        rtotal += rcounts[r] + 1;
+    }
+    sbuf = alloc_buf(rcounts[rank], stride);
+    rbuf = alloc_buf(rtotal, stride);
+    fill(sbuf, stride, 0, rcounts[rank], rank);
+    MPI_Allgatherv(sbuf, rcounts[rank], dtype_of(stride), rbuf, rcounts, rdispls,
+                   dtype_of(stride), MPI_COMM_WORLD);
+    for (int r = 0; r < size; r++) {
+        check("allgatherv", rbuf, stride, rdispls[r], rcounts[r], r, count);
+    }
+    free(sbuf);
+    free(rbuf);
+
+    sbuf = alloc_buf(size * count, stride);
+    rbuf = alloc_buf(size * count, stride);
+    for (int r = 0; r < size; r++) {
+        fill(sbuf, stride, r * count, count, rank * size + r);
+    }
+    MPI_Alltoall(sbuf, count, dtype_of(stride), rbuf, count, dtype_of(stride), MPI_COMM_WORLD);
+    for (int r = 0; r < size; r++) {
+        check("alltoall", rbuf, stride, r * count, count, r * size + rank, count);
+    }
+    free(sbuf);
+    free(rbuf);
+
+    rtotal = 0;
+    for (int r = 0; r < size; r++) {
+        scounts[r] = vcount(count, rank, r);
+        sdispls[r] = stotal;
+        stotal += scounts[r] + 1;
+        rcounts[r] = vcount(count, r, rank);
+        rdispls[r] = rtotal;
+        rtotal += rcounts[r] + 1;
+    }
+    sbuf = alloc_buf(stotal, stride);
+    rbuf = alloc_buf(rtotal, stride);
+    for (int r = 0; r < size; r++) {
+        fill(sbuf, stride, sdispls[r], scounts[r], rank * size + r);
+    }
+    MPI_Alltoallv(sbuf, scounts, sdispls, dtype_of(stride), rbuf, rcounts, rdispls,
+                  dtype_of(stride), MPI_COMM_WORLD);
+    for (int r = 0; r < size; r++) {
+        check("alltoallv", rbuf, stride, rdispls[r], rcounts[r], r * size + rank, count);
+    }
+    free(sbuf);
+    free(rbuf);
+
+    free(scounts);
+    free(sdispls);
+    free(rcounts);
+    free(rdispls);
+}
+
+int main(int argc, char *argv[])
+{
+    const int counts[] = {3, 50000};
+    int all_errors;
+
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    MPI_Type_create_resized(MPI_INT, 0, 2 * sizeof(int), &resized);
+    MPI_Type_commit(&resized);
+
+    signal(SIGALRM, timeout);
+    alarm(300);
+
+    for (int c = 0; c < 2; c++) {
+        /* the resized type at the root only, then everywhere but at the root */
+        rooted(counts[c], 0, 2, 1);
+        rooted(counts[c], size - 1, 1, 2);
+        /* the resized type on the odd ranks, then on the even ones */
+        unrooted(counts[c], 1 + rank % 2);
+        unrooted(counts[c], 2 - rank % 2);
+    }
+
+    MPI_Type_free(&resized);
+
+    MPI_Allreduce(&errors, &all_errors, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+    if (0 == rank) {
+        printf("xhc_mixed_dtypes: %s\n", (0 == all_errors ? "ok" : "FAILED"));
+    }
+
+    MPI_Finalize();
+    return (0 == all_errors ? 0 : 1);
+}
@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2025      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+ * Compare opal_memcpy, opal_memcpy_chunk and opal_memcpy_strided with the C
+ * library memcpy, with a low memcpy_base_nt_threshold so that the selected
+ * memcpy component does most of the copies, for lengths around the vector
+ * sizes and the threshold and misaligned sources and destinations. The
+ * bytes around the destination must not be written. Each variant of
+ * memcpy/avx is tested in its own process; the ones the processor does not
+ * support fall back to the C library.
+ */
+
+#include "opal_config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "opal/mca/memcpy/base/base.h"
+#include "opal/runtime/opal.h"
+#include "support.h"
+
+#define THRESHOLD 4096
+#define GUARD 128
+#define MAX_LEN (16 * THRESHOLD + 300)
+#define COUNT 5
+
+static const size_t lengths[] = {0, 1, 7, 31, 32, 33, 63, 64, 65, 255, 257, THRESHOLD - 1,
+                                 THRESHOLD, THRESHOLD + 1, THRESHOLD + 63, 3 * THRESHOLD + 17,
+                                 MAX_LEN};
+#define NB_LENGTHS (sizeof(lengths) / sizeof(lengths[0]))
+
+static const size_t offsets[] = {0, 1, 3, 8, 31, 32, 63};
+#define NB_OFFSETS (sizeof(offsets) / sizeof(offsets[0]))
+
+/* memcpy_avx_variant of each process, NULL for the default */
+static const char *variants[] = {NULL, "avx2", "avx512", "auto"};
+#define NB_VARIANTS (sizeof(variants) / sizeof(variants[0]))
+
+static unsigned char *src, *dst, *expected;
+static size_t buf_size;
+
+static void reset(void)
+{
+    for (size_t i = 0; i < buf_size; i++) {
+        dst[i] = expected[i] = (unsigned char) (0xa5 ^ i);
+    }
+}
+
+static void check(const char *what, size_t len, size_t soff, size_t doff)
+{
+    char msg[256] = "";
+
+    if (0 == memcmp(dst, expected, buf_size)) {
+        test_success();
+        return;
+    }
+    for (size_t i = 0; i < buf_size; i++) {
+        if (dst[i] != expected[i]) {
+            snprintf(msg, sizeof(msg),
+                     "%s of %" PRIsize_t " bytes, source offset %" PRIsize_t ", destination "
+                     "offset %" PRIsize_t ": byte %ld differs", what, len, soff, doff,
+                     (long) i - (long) (GUARD + doff));
+            break;
+        }
+    }
+    test_failure(msg);
+}
+
+static void test_contiguous(void)
+{
+    for (size_t l = 0; l < NB_LENGTHS; l++) {
+        for (size_t s = 0; s < NB_OFFSETS; s++) {
+            for (size_t d = 0; d < NB_OFFSETS; d++) {
+                size_t len = lengths[l], soff = offsets[s], doff = offsets[d];
+
+                reset();
+                memcpy(expected + GUARD + doff, src + soff, len);
+                opal_memcpy(dst + GUARD + doff, src + soff, len);
+                check("opal_memcpy", len, soff, doff);
+
+                /* a chunk of a large transfer goes to the component, a
+                 * chunk of a small one to the C library */
+                reset();
+                memcpy(expected + GUARD + doff, src + soff, len);
+                opal_memcpy_chunk(dst + GUARD + doff, src + soff, len, 2 * THRESHOLD);
+                check("opal_memcpy_chunk of a large transfer", len, soff, doff);
+
+                reset();
+                memcpy(expected + GUARD + doff, src + soff, len);
+                opal_memcpy_chunk(dst + GUARD + doff, src + soff, len, len);
+                check("opal_memcpy_chunk", len, soff, doff);
+            }
+        }
+    }
+}
+
+static void test_strided(void)
+{
+    /* the gaps between the blocks must not be written */
+    static const size_t gaps[] = {0, 1, 64};
+
+    for (size_t l = 0; l < NB_LENGTHS; l++) {
+        size_t len = lengths[l];
+
+        if (COUNT * (len + 64) > MAX_LEN) {
+            continue;
+        }
+        for (size_t s = 0; s < sizeof(gaps) / sizeof(gaps[0]); s++) {
+            for (size_t d = 0; d < sizeof(gaps) / sizeof(gaps[0]); d++) {
+                size_t soff = offsets[(l + s) % NB_OFFSETS], doff = offsets[(l + d) % NB_OFFSETS];
+                ptrdiff_t sstride = len + gaps[s], dstride = len + gaps[d];
+
+                reset();
+                for (size_t i = 0; i < COUNT; i++) {
+                    memcpy(expected + GUARD + doff + i * dstride, src + soff + i * sstride, len);
+                }
+                opal_memcpy_strided(dst + GUARD + doff, dstride, src + soff, sstride, len, COUNT);
+                check("opal_memcpy_strided", len, soff, doff);
+            }
+        }
+    }
+}
+
+static int run(const char *variant)
+{
+    char name[128], threshold[32];
+
+    snprintf(threshold, sizeof(threshold), "%d", THRESHOLD);
+    setenv(OPAL_MCA_PREFIX "memcpy_base_nt_threshold", threshold, 1);
+    if (NULL != variant) {
+        setenv(OPAL_MCA_PREFIX "memcpy_avx_variant", variant, 1);
+    }
+    opal_init(NULL, NULL);
+
+    snprintf(name, sizeof(name), "opal_memcpy (avx variant %s, %s)",
+             (NULL == variant ? "default" : variant),
+             (opal_memcpy_base_module.copy == opal_memcpy_base_copy ? "C library"
+                                                                     : "memcpy component"));
+    test_init(name);
+    test_verify_size_t(THRESHOLD, opal_memcpy_base_nt_threshold);
+
+    buf_size = MAX_LEN + 64 + 2 * GUARD;
+    src = (unsigned char *) malloc(MAX_LEN + 64);
+    dst = (unsigned char *) malloc(buf_size);
+    expected = (unsigned char *) malloc(buf_size);
+    for (size_t i = 0; i < MAX_LEN + 64; i++) {
+        src[i] = (unsigned char) (i * 131 + 7);
+    }
+
+    test_contiguous();
+    test_strided();
+
+    free(src);
+    free(dst);
+    free(expected);
+    opal_finalize();
+    return test_finalize();
+}
+
+int main(int argc, char *argv[])
+{
+    int status, failed = 0;
+
+    /* the component is selected once per process */
+    for (size_t v = 0; v < NB_VARIANTS; v++) {
+        pid_t pid = fork();
+
+        if (0 == pid) {
+            exit(run(variants[v]));
+        }
+        if (0 > pid || pid != waitpid(pid, &status, 0) || !WIFEXITED(status)
+            || 0 != WEXITSTATUS(status)) {
+            failed = 1;
+        }
+    }
+    return failed;
+}